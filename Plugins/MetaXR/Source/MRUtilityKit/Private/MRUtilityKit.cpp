@@ -1,8 +1,10 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "MRUtilityKit.h"
+#include "MRUtilityKitLabelRegistryTestScope.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/Paths.h"
+#include "Misc/ScopeRWLock.h"
 #include "ShaderCore.h"
 
 #if WITH_EDITOR
@@ -30,6 +32,221 @@ const FString FMRUKLabels::WallArt("WALL_ART");
 const FString FMRUKLabels::GlobalMesh("GLOBAL_MESH");
 const FString FMRUKLabels::Other("OTHER");
 
+namespace
+{
+	class FMRUKLabelRegistry
+	{
+	public:
+		static FMRUKLabelRegistry& Get()
+		{
+			static FMRUKLabelRegistry Instance;
+			return Instance;
+		}
+
+		uint64 Find(const FString& Label)
+		{
+			FReadScopeLock ReadLock(Lock);
+			const uint64* Bit = LabelBits.Find(Label);
+			return Bit ? *Bit : 0;
+		}
+
+		uint64 FindOrAdd(const FString& Label)
+		{
+			{
+				FReadScopeLock ReadLock(Lock);
+				if (const uint64* Bit = LabelBits.Find(Label))
+				{
+					return *Bit;
+				}
+			}
+
+			FWriteScopeLock WriteLock(Lock);
+			if (const uint64* Bit = LabelBits.Find(Label))
+			{
+				return *Bit;
+			}
+			if (NextBit >= MaxBits)
+			{
+				// Don't remember the label, otherwise the registry could grow without limits
+				return FMRUKLabelMask::OverflowBit;
+			}
+			const uint64 Bit = 1ull << NextBit++;
+			LabelBits.Add(Label, Bit);
+			return Bit;
+		}
+
+		int32 GetNumBits()
+		{
+			FReadScopeLock ReadLock(Lock);
+			return NextBit;
+		}
+
+		// Forget all labels that got a bit at or after the given one
+		void Truncate(int32 NumBits)
+		{
+			FWriteScopeLock WriteLock(Lock);
+			const uint64 FirstRemovedBit = 1ull << NumBits;
+			for (auto It = LabelBits.CreateIterator(); It; ++It)
+			{
+				if (It.Value() >= FirstRemovedBit)
+				{
+					It.RemoveCurrent();
+				}
+			}
+			NextBit = NumBits;
+		}
+
+	private:
+		// The last bit is reserved for the overflow
+		static constexpr int32 MaxBits = 63;
+
+		FMRUKLabelRegistry()
+		{
+			// Register the known labels first so that they always get the bits of FMRUKLabelMasks
+			const TPair<const FString*, FMRUKLabelMask> KnownLabels[] = {
+				{ &FMRUKLabels::Floor, FMRUKLabelMasks::Floor },
+				{ &FMRUKLabels::WallFace, FMRUKLabelMasks::WallFace },
+				{ &FMRUKLabels::InvisibleWallFace, FMRUKLabelMasks::InvisibleWallFace },
+				{ &FMRUKLabels::Ceiling, FMRUKLabelMasks::Ceiling },
+				{ &FMRUKLabels::DoorFrame, FMRUKLabelMasks::DoorFrame },
+				{ &FMRUKLabels::WindowFrame, FMRUKLabelMasks::WindowFrame },
+				{ &FMRUKLabels::Couch, FMRUKLabelMasks::Couch },
+				{ &FMRUKLabels::Table, FMRUKLabelMasks::Table },
+				{ &FMRUKLabels::Screen, FMRUKLabelMasks::Screen },
+				{ &FMRUKLabels::Bed, FMRUKLabelMasks::Bed },
+				{ &FMRUKLabels::Lamp, FMRUKLabelMasks::Lamp },
+				{ &FMRUKLabels::Plant, FMRUKLabelMasks::Plant },
+				{ &FMRUKLabels::Storage, FMRUKLabelMasks::Storage },
+				{ &FMRUKLabels::WallArt, FMRUKLabelMasks::WallArt },
+				{ &FMRUKLabels::GlobalMesh, FMRUKLabelMasks::GlobalMesh },
+				{ &FMRUKLabels::Other, FMRUKLabelMasks::Other },
+			};
+			for (const auto& KnownLabel : KnownLabels)
+			{
+				check(KnownLabel.Value.Bits == 1ull << NextBit);
+				LabelBits.Add(*KnownLabel.Key, KnownLabel.Value.Bits);
+				++NextBit;
+			}
+		}
+
+		// FString keys compare case insensitive, the same way the labels have always been compared
+		TMap<FString, uint64> LabelBits;
+		int32 NextBit = 0;
+		FRWLock Lock;
+	};
+} // namespace
+
+#if WITH_DEV_AUTOMATION_TESTS
+FMRUKLabelRegistryTestScope::FMRUKLabelRegistryTestScope()
+	: NumBits(FMRUKLabelRegistry::Get().GetNumBits())
+{
+}
+
+FMRUKLabelRegistryTestScope::~FMRUKLabelRegistryTestScope()
+{
+	FMRUKLabelRegistry::Get().Truncate(NumBits);
+}
+#endif // WITH_DEV_AUTOMATION_TESTS
+
+FMRUKLabelMask FMRUKLabelMask::FromLabel(const FString& Label)
+{
+	return FMRUKLabelMask{ FMRUKLabelRegistry::Get().FindOrAdd(Label) };
+}
+
+FMRUKLabelMask FMRUKLabelMask::FromLabels(const TArray<FString>& Labels)
+{
+	FMRUKLabelMask Mask;
+	for (const auto& Label : Labels)
+	{
+		Mask |= FromLabel(Label);
+	}
+	return Mask;
+}
+
+FMRUKLabelMask FMRUKLabelMask::FindLabel(const FString& Label)
+{
+	return FMRUKLabelMask{ FMRUKLabelRegistry::Get().Find(Label) };
+}
+
+namespace
+{
+	// Compile a label of a filter without interning it. A label that didn't get a bit yet can only be on anchors
+	// whose labels overflowed, so it is compared as a string on those.
+	FMRUKLabelMask CompileFilterLabel(const FString& Label, TArray<FString>& OverflowLabels)
+	{
+		FMRUKLabelMask Mask = FMRUKLabelMask::FindLabel(Label);
+		if (Mask.IsEmpty())
+		{
+			Mask.Bits = FMRUKLabelMask::OverflowBit;
+			OverflowLabels.Add(Label);
+		}
+		return Mask;
+	}
+} // namespace
+
+bool FMRUKCompiledLabelFilter::PassesFilter(FMRUKLabelMask Mask, const TArray<FString>& Labels) const
+{
+	const uint64 Excluded = Mask.Bits & ExcludedMask.Bits;
+	if (Excluded & ~FMRUKLabelMask::OverflowBit)
+	{
+		return false;
+	}
+	if (Excluded & FMRUKLabelMask::OverflowBit)
+	{
+		for (const auto& ExcludedLabel : OverflowExcludedLabels)
+		{
+			if (Labels.Contains(ExcludedLabel))
+			{
+				return false;
+			}
+		}
+	}
+
+	if (!bHasIncludedLabels)
+	{
+		return true;
+	}
+	const uint64 Included = Mask.Bits & IncludedMask.Bits;
+	if (Included & ~FMRUKLabelMask::OverflowBit)
+	{
+		return true;
+	}
+	if (Included & FMRUKLabelMask::OverflowBit)
+	{
+		for (const auto& IncludedLabel : OverflowIncludedLabels)
+		{
+			if (Labels.Contains(IncludedLabel))
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+FMRUKCompiledLabelFilter FMRUKCompiledLabelFilter::FromLabel(const FString& Label)
+{
+	FMRUKCompiledLabelFilter Compiled;
+	Compiled.bHasIncludedLabels = true;
+	Compiled.IncludedMask = CompileFilterLabel(Label, Compiled.OverflowIncludedLabels);
+	return Compiled;
+}
+
+FMRUKCompiledLabelFilter FMRUKLabelFilter::Compile() const
+{
+	FMRUKCompiledLabelFilter Compiled;
+	Compiled.bHasIncludedLabels = !IncludedLabels.IsEmpty();
+	for (const auto& Label : IncludedLabels)
+	{
+		Compiled.IncludedMask |= CompileFilterLabel(Label, Compiled.OverflowIncludedLabels);
+	}
+	for (const auto& Label : ExcludedLabels)
+	{
+		Compiled.ExcludedMask |= CompileFilterLabel(Label, Compiled.OverflowExcludedLabels);
+	}
+	return Compiled;
+}
+
 bool FMRUKLabelFilter::PassesFilter(const TArray<FString>& Labels) const
 {
 	for (const auto& ExcludedLabel : ExcludedLabels)
@@ -0,0 +1,74 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitAliasTable.h"
+#include "Math/RandomStream.h"
+
+void FMRUKAliasTable::Build(TConstArrayView<float> Weights)
+{
+	Reset();
+
+	for (const float Weight : Weights)
+	{
+		TotalWeight += FMath::Max(Weight, 0.0f);
+	}
+	if (TotalWeight <= 0.0)
+	{
+		TotalWeight = 0.0;
+		return;
+	}
+
+	const int32 N = Weights.Num();
+	Probabilities.SetNumUninitialized(N);
+	Aliases.SetNumUninitialized(N);
+
+	// Scale the weights so that their average is 1 and split them into the ones below and above the average
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(N);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 I = 0; I < N; ++I)
+	{
+		Scaled[I] = FMath::Max(Weights[I], 0.0f) * N / TotalWeight;
+		(Scaled[I] < 1.0 ? Small : Large).Push(I);
+	}
+
+	// Fill up every small bucket with the remainder of a large one
+	while (!Small.IsEmpty() && !Large.IsEmpty())
+	{
+		const int32 Less = Small.Pop(EAllowShrinking::No);
+		const int32 More = Large.Pop(EAllowShrinking::No);
+		Probabilities[Less] = static_cast<float>(Scaled[Less]);
+		Aliases[Less] = More;
+		Scaled[More] = (Scaled[More] + Scaled[Less]) - 1.0;
+		(Scaled[More] < 1.0 ? Small : Large).Push(More);
+	}
+
+	// Whatever is left is 1 up to rounding errors
+	for (const int32 I : Large)
+	{
+		Probabilities[I] = 1.0f;
+		Aliases[I] = I;
+	}
+	for (const int32 I : Small)
+	{
+		Probabilities[I] = 1.0f;
+		Aliases[I] = I;
+	}
+}
+
+void FMRUKAliasTable::Reset()
+{
+	Probabilities.Empty();
+	Aliases.Empty();
+	TotalWeight = 0.0;
+}
+
+int32 FMRUKAliasTable::Sample(const FRandomStream& RandomStream) const
+{
+	if (Probabilities.IsEmpty())
+	{
+		return INDEX_NONE;
+	}
+	const int32 Index = RandomStream.RandHelper(Probabilities.Num());
+	return RandomStream.GetFraction() < Probabilities[Index] ? Index : Aliases[Index];
+}
@@ -8,6 +8,7 @@
 #include "MRUtilityKitSerializationHelpers.h"
 #include "MRUtilityKitSeatsComponent.h"
 #include "MRUtilityKitRoom.h"
+#include "MRUtilityKitSceneSnapshot.h"
 #include "OculusXRAnchorTypes.h"
 #include "Engine/World.h"
 
@@ -28,7 +29,7 @@ bool AMRUKAnchor::LoadFromData(UMRUKAnchorData* AnchorData)
 
 	bool Changed = false;
 
-	if (const auto Seat = GetComponentByClass<UMRUKSeatsComponent>(); Seat && !HasLabel(FMRUKLabels::Couch))
+	if (const auto Seat = GetComponentByClass<UMRUKSeatsComponent>(); Seat && !HasLabelMask(FMRUKLabelMasks::Couch))
 	{
 		Seat->UnregisterComponent();
 		Seat->DestroyComponent();
@@ -45,6 +46,7 @@ bool AMRUKAnchor::LoadFromData(UMRUKAnchorData* AnchorData)
 		Changed = true;
 	}
 	SemanticClassifications = NewSemanticClassifications;
+	LabelMask = FMRUKLabelMask::FromLabels(SemanticClassifications);
 
 	const FString Semantics = FString::Join(SemanticClassifications, TEXT("-"));
 	UE_LOG(LogMRUK, Log, TEXT("SpatialAnchor label is %s"), *Semantics);
@@ -71,10 +73,8 @@ bool AMRUKAnchor::LoadFromData(UMRUKAnchorData* AnchorData)
 			ProceduralMeshComponent = nullptr;
 		}
 
-		if (CachedMesh.IsSet())
-		{
-			CachedMesh.GetValue().Clear();
-		}
+		// Reset rather than clear so that degenerate planes without triangles can still be cached
+		CachedMesh.Reset();
 	}
 
 	return Changed;
@@ -125,53 +125,15 @@ FVector AMRUKAnchor::GenerateRandomPositionOnPlaneFromStream(const FRandomStream
 		return FVector::ZeroVector;
 	}
 
-	// Cache the mesh so that if the function is called multiple times it will re-use the previously triangulated mesh.
-	if (!CachedMesh.IsSet())
+	const auto& [Vertices, Triangles, AreaTable] = GetOrCreateCachedMesh();
+	if (AreaTable.IsEmpty())
 	{
-		TriangulatedMeshCache Mesh;
-
-		TArray<FVector2f> PlaneBoundary;
-		PlaneBoundary.Reserve(PlaneBoundary2D.Num());
-		for (const auto Point : PlaneBoundary2D)
-		{
-			PlaneBoundary.Push(FVector2f(Point));
-		}
-
-		MRUKTriangulatePolygon({ PlaneBoundary }, Mesh.Vertices, Mesh.Triangles);
-
-		// Compute the area of each triangle and the total surface area of the mesh
-		Mesh.Areas.Reserve(Mesh.Triangles.Num() / 3);
-		Mesh.TotalArea = 0.0f;
-		for (int i = 0; i < Mesh.Triangles.Num(); i += 3)
-		{
-			const auto I0 = Mesh.Triangles[i];
-			const auto I1 = Mesh.Triangles[i + 1];
-			const auto I2 = Mesh.Triangles[i + 2];
-			auto V0 = Mesh.Vertices[I0];
-			auto V1 = Mesh.Vertices[I1];
-			auto V2 = Mesh.Vertices[I2];
-			const auto Cross = FVector2D::CrossProduct(V1 - V0, V2 - V0);
-			float Area = Cross * 0.5f;
-			Mesh.TotalArea += Area;
-			Mesh.Areas.Add(Area);
-		}
-		CachedMesh.Emplace(MoveTemp(Mesh));
+		return FVector::ZeroVector;
 	}
 
-	const auto& [Vertices, Triangles, Areas, TotalArea] = CachedMesh.GetValue();
-
 	// Pick a random triangle weighted by surface area (triangles with larger surface
 	// area have more chance of being chosen)
-	auto Rand = RandomStream.FRandRange(0.0f, TotalArea);
-	int TriangleIndex = 0;
-	for (; TriangleIndex < Areas.Num() - 1; ++TriangleIndex)
-	{
-		Rand -= Areas[TriangleIndex];
-		if (Rand <= 0.0f)
-		{
-			break;
-		}
-	}
+	const int32 TriangleIndex = AreaTable.Sample(RandomStream);
 
 	// Get the vertices of the chosen triangle
 	const auto I0 = Triangles[TriangleIndex * 3];
@@ -198,6 +160,47 @@ FVector AMRUKAnchor::GenerateRandomPositionOnPlaneFromStream(const FRandomStream
 	return V0 + U * (V1 - V0) + V * (V2 - V0);
 }
 
+double AMRUKAnchor::GetPlaneArea()
+{
+	if (PlaneBoundary2D.IsEmpty())
+	{
+		return 0.0;
+	}
+	return GetOrCreateCachedMesh().AreaTable.GetTotalWeight();
+}
+
+const AMRUKAnchor::TriangulatedMeshCache& AMRUKAnchor::GetOrCreateCachedMesh()
+{
+	// Cache the mesh so that if the function is called multiple times it will re-use the previously triangulated mesh.
+	if (!CachedMesh.IsSet())
+	{
+		TriangulatedMeshCache Mesh;
+
+		TArray<FVector2f> PlaneBoundary;
+		PlaneBoundary.Reserve(PlaneBoundary2D.Num());
+		for (const auto Point : PlaneBoundary2D)
+		{
+			PlaneBoundary.Push(FVector2f(Point));
+		}
+
+		MRUKTriangulatePolygon({ PlaneBoundary }, Mesh.Vertices, Mesh.Triangles);
+
+		// Build a table to pick triangles proportional to their area in constant time
+		TArray<float> Areas;
+		Areas.Reserve(Mesh.Triangles.Num() / 3);
+		for (int i = 0; i < Mesh.Triangles.Num(); i += 3)
+		{
+			const auto V0 = Mesh.Vertices[Mesh.Triangles[i]];
+			const auto V1 = Mesh.Vertices[Mesh.Triangles[i + 1]];
+			const auto V2 = Mesh.Vertices[Mesh.Triangles[i + 2]];
+			Areas.Add(static_cast<float>(FVector2D::CrossProduct(V1 - V0, V2 - V0) * 0.5));
+		}
+		Mesh.AreaTable.Build(Areas);
+		CachedMesh.Emplace(MoveTemp(Mesh));
+	}
+	return CachedMesh.GetValue();
+}
+
 bool AMRUKAnchor::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, FMRUKHit& OutHit, int32 ComponentTypes)
 {
 	// If this anchor is the global mesh test against it
@@ -506,6 +509,11 @@ bool AMRUKAnchor::HasLabel(const FString& Label) const
 	return SemanticClassifications.Contains(Label);
 }
 
+bool AMRUKAnchor::HasLabelMask(FMRUKLabelMask Mask) const
+{
+	return (LabelMask.Bits & Mask.Bits & ~FMRUKLabelMask::OverflowBit) != 0;
+}
+
 bool AMRUKAnchor::HasAnyLabel(const TArray<FString>& Labels) const
 {
 	for (const auto& Label : Labels)
@@ -523,6 +531,11 @@ bool AMRUKAnchor::PassesLabelFilter(const FMRUKLabelFilter& LabelFilter) const
 	return LabelFilter.PassesFilter(SemanticClassifications);
 }
 
+bool AMRUKAnchor::PassesCompiledLabelFilter(const FMRUKCompiledLabelFilter& LabelFilter) const
+{
+	return LabelFilter.PassesFilter(LabelMask, SemanticClassifications);
+}
+
 double AMRUKAnchor::GetClosestSurfacePosition(const FVector& TestPosition, FVector& OutSurfacePosition)
 {
 	const auto& Transform = GetActorTransform();
@@ -781,12 +794,67 @@ TSharedRef<FJsonObject> AMRUKAnchor::JsonSerialize()
 	return JsonObject;
 }
 
+FMRUKSnapshotAnchor AMRUKAnchor::SnapshotSerialize()
+{
+	FMRUKSnapshotAnchor SnapshotAnchor;
+	SnapshotAnchor.UUID = AnchorUUID;
+	SnapshotAnchor.SemanticClassifications = SemanticClassifications;
+	const FTransform Transform = GetTransform();
+	SnapshotAnchor.Translation = Transform.GetTranslation();
+	SnapshotAnchor.Rotation = Transform.Rotator();
+	SnapshotAnchor.Scale = Transform.GetScale3D();
+	SnapshotAnchor.PlaneBounds = PlaneBounds;
+	SnapshotAnchor.PlaneBoundary2D = PlaneBoundary2D;
+	SnapshotAnchor.VolumeBounds = VolumeBounds;
+
+	if (this == Room->GlobalMeshAnchor)
+	{
+		TArray<UProceduralMeshComponent*> ProcMeshComponents;
+		GetComponents<UProceduralMeshComponent>(ProcMeshComponents);
+		for (const auto& ProcMeshComponent : ProcMeshComponents)
+		{
+			if (ProcMeshComponent && ProcMeshComponent->ComponentHasTag("GlobalMesh"))
+			{
+				ensure(ProcMeshComponent->GetNumSections() == 1);
+
+				const auto ProcMeshSection = ProcMeshComponent->GetProcMeshSection(0);
+
+				TArray<FVector> Positions;
+				Positions.Reserve(ProcMeshSection->ProcVertexBuffer.Num());
+				for (const auto& Vertex : ProcMeshSection->ProcVertexBuffer)
+				{
+					Positions.Add(Vertex.Position);
+				}
+
+				TArray<int32> Indices;
+				Indices.Reserve(ProcMeshSection->ProcIndexBuffer.Num());
+				for (const auto& Index : ProcMeshSection->ProcIndexBuffer)
+				{
+					Indices.Add(Index);
+				}
+
+				FMRUKSnapshotGlobalMesh& GlobalMesh = SnapshotAnchor.GlobalMesh.Emplace();
+				GlobalMesh.UUID = AnchorUUID;
+				GlobalMesh.SetMeshData(MoveTemp(Positions), MoveTemp(Indices));
+			}
+		}
+	}
+
+	return SnapshotAnchor;
+}
+
 void AMRUKAnchor::EndPlay(EEndPlayReason::Type Reason)
 {
 	if (Interior)
 	{
 		Interior->Destroy();
 	}
+	if (Room)
+	{
+		Room->AnchorBVH.Remove(this);
+		Room->AnchorHierarchy.Remove(this);
+		Room->InvalidateSamplers();
+	}
 	Super::EndPlay(Reason);
 }
 
@@ -872,14 +940,6 @@ bool AMRUKAnchor::RayCastVolume(const FRay& LocalRay, float MaxDist, FMRUKHit& O
 	return false;
 }
 
-void AMRUKAnchor::TriangulatedMeshCache::Clear()
-{
-	Vertices.Empty();
-	Triangles.Empty();
-	Areas.Empty();
-	TotalArea = 0.0f;
-}
-
 // #pragma optimize("", on)
 
 #undef LOCTEXT_NAMESPACE
@@ -198,7 +198,7 @@ AActor* AMRUKAnchorActorSpawner::SpawnProceduralMeshForAnchorIfNeeded(AMRUKAncho
 
 	for (const FString& Label : Anchor->SemanticClassifications)
 	{
-		if (Label == FMRUKLabels::WallFace && Anchor->SemanticClassifications.Contains(FMRUKLabels::InvisibleWallFace))
+		if (Label == FMRUKLabels::WallFace && Anchor->HasLabelMask(FMRUKLabelMasks::InvisibleWallFace))
 		{
 			// Treat anchors with WALL_FACE and INVISIBLE_WALL_FACE as anchors that only have INVISIBLE_WALL_FACE
 			continue;
@@ -238,7 +238,7 @@ TArray<AActor*> AMRUKAnchorActorSpawner::SpawnProceduralMeshesInRoom(AMRUKRoom*
 	}
 	for (const auto& Anchor : Room->AllAnchors)
 	{
-		if (Anchor->HasLabel(FMRUKLabels::Floor) || Anchor->HasLabel(FMRUKLabels::Ceiling) || Anchor->HasLabel(FMRUKLabels::WallFace))
+		if (Anchor->HasLabelMask(FMRUKLabelMasks::Floor) || Anchor->HasLabelMask(FMRUKLabelMasks::Ceiling) || Anchor->HasLabelMask(FMRUKLabelMasks::WallFace))
 		{
 			// These have already been spawned above in case it was necessary
 			continue;
@@ -613,7 +613,7 @@ FVector AMRUKAnchorActorSpawner::ComputeCustomAlign_Implementation(AMRUKAnchor*
 
 bool AMRUKAnchorActorSpawner::ShouldSpawnActorForAnchor(AMRUKAnchor* Anchor, const FString& Label, FMRUKSpawnGroup& OutSpawnGroup) const
 {
-	if (Label == FMRUKLabels::WallFace && Anchor->SemanticClassifications.Contains(FMRUKLabels::InvisibleWallFace))
+	if (Label == FMRUKLabels::WallFace && Anchor->HasLabelMask(FMRUKLabelMasks::InvisibleWallFace))
 	{
 		// Treat anchors with WALL_FACE and INVISIBLE_WALL_FACE as anchors that only have INVISIBLE_WALL_FACE
 		return false;
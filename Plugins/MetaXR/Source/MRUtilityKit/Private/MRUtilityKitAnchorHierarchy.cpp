@@ -0,0 +1,383 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitAnchorHierarchy.h"
+#include "MRUtilityKitAnchor.h"
+
+namespace
+{
+	constexpr float HierarchyOffsetTolerance = 4.0f; // 4 cm offset allowed
+
+	// Size of a grid cell in cm and the margin by which footprints get enlarged. The margin covers the offset
+	// tolerance and slightly tilted anchors.
+	constexpr double HierarchyCellSize = 50.0;
+	constexpr double HierarchyFootprintMargin = 2.0 * HierarchyOffsetTolerance;
+
+	// Things that are attached to walls such as doors, windows frames or wall art
+	bool IsAttachedToWall(AMRUKAnchor* WallAnchor, const AMRUKAnchor* ChildAnchor)
+	{
+		const auto& WallTransform = WallAnchor->GetTransform();
+		const auto WallNormal = WallTransform.GetUnitAxis(EAxis::X);
+		const auto& ChildTransform = ChildAnchor->GetTransform();
+		const auto ChildNormal = ChildTransform.GetUnitAxis(EAxis::X);
+		// Check that the two transforms face the same direction
+		if (!FVector::Coincident(WallNormal, ChildNormal))
+		{
+			return false;
+		}
+		// Check that the position is close to the surface (they are a little bit offset
+		// to prevent Z fighting so allow for that).
+		auto LocalPos = WallTransform.InverseTransformPosition(ChildTransform.GetLocation());
+		if (FMath::Abs(LocalPos.X) > HierarchyOffsetTolerance)
+		{
+			return false;
+		}
+		// Check that the anchor is within the wall boundary
+		return WallAnchor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z));
+	}
+
+	// Only interested in scene volumes, the assumption is that all scene volumes have X axis pointing downwards
+	bool IsUprightVolume(const AMRUKAnchor* Anchor)
+	{
+		return Anchor->VolumeBounds.IsValid && FVector::Coincident(Anchor->GetTransform().GetUnitAxis(EAxis::X), FVector::DownVector);
+	}
+
+	// Volumes that stand on the floor
+	bool IsStandingOnFloor(AMRUKAnchor* FloorAnchor, const AMRUKAnchor* ChildAnchor)
+	{
+		if (!IsUprightVolume(ChildAnchor))
+		{
+			return false;
+		}
+		const auto& FloorTransform = FloorAnchor->GetTransform();
+		const auto& ChildTransform = ChildAnchor->GetTransform();
+		auto FloorHeight = FloorTransform.GetLocation().Z;
+		auto ChildBottom = ChildTransform.GetLocation().Z - ChildAnchor->VolumeBounds.Max.X;
+		// Check that the volume is on the floor
+		if (FMath::Abs(FloorHeight - ChildBottom) > HierarchyOffsetTolerance)
+		{
+			return false;
+		}
+		auto LocalPos = FloorTransform.InverseTransformPosition(ChildTransform.GetLocation());
+		// Check that child anchor is within the bounds of the floor
+		return FloorAnchor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z));
+	}
+
+	// Volumes that are stacked on top of another volume
+	bool IsStackedOnVolume(const AMRUKAnchor* ParentAnchor, const AMRUKAnchor* ChildAnchor)
+	{
+		if (!IsUprightVolume(ParentAnchor) || !IsUprightVolume(ChildAnchor))
+		{
+			return false;
+		}
+		const auto& ParentTransform = ParentAnchor->GetTransform();
+		const auto& ParentVolumeBounds = ParentAnchor->VolumeBounds;
+		const auto& ChildTransform = ChildAnchor->GetTransform();
+		const auto& ChildVolumeBounds = ChildAnchor->VolumeBounds;
+		auto ParentTop = ParentTransform.GetLocation().Z - ParentVolumeBounds.Min.X;
+		auto ChildBottom = ChildTransform.GetLocation().Z - ChildVolumeBounds.Max.X;
+		// Check that the two volumes are stack on top of each other
+		if (FMath::Abs(ParentTop - ChildBottom) > HierarchyOffsetTolerance)
+		{
+			return false;
+		}
+		// Check that at least one of the corners of the child volume is inside the bounds of the parent's volume
+		// when projected onto the horizontal plane. This is to match the Scene Capture tool which requires the
+		// user to defined stacked volumes by starting with one corner of the volume which must be on the parent's
+		// volume.
+		for (int i = 0; i < 4; ++i)
+		{
+			// Get a different corner on each iteration of the loop (height is not important here)
+			FVector ChildLocalPos(0.0f, i < 2 ? ChildVolumeBounds.Min.Y : ChildVolumeBounds.Max.Y, i % 2 == 0 ? ChildVolumeBounds.Min.Z : ChildVolumeBounds.Max.Z);
+			auto LocalPos = ParentTransform.InverseTransformPosition(ChildTransform.TransformPosition(ChildLocalPos));
+			// Check that child anchor is within the bounds of the parent on the horizontal plane
+			if (LocalPos.Y >= ParentVolumeBounds.Min.Y && LocalPos.Y <= ParentVolumeBounds.Max.Y && LocalPos.Z >= ParentVolumeBounds.Min.Z && LocalPos.Z <= ParentVolumeBounds.Max.Z)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Bounds on the horizontal plane of everything the tests above look at: the location, the plane boundary and
+	// the volume including the corners that get projected to the height of the anchor.
+	FIntRect ComputeHierarchyCells(const AMRUKAnchor* Anchor)
+	{
+		const FTransform& Transform = Anchor->GetTransform();
+		FBox2D Footprint(ForceInit);
+		const auto AddPoint = [&Transform, &Footprint](const FVector& LocalPosition) {
+			const FVector WorldPosition = Transform.TransformPosition(LocalPosition);
+			Footprint += FVector2D(WorldPosition.X, WorldPosition.Y);
+		};
+
+		AddPoint(FVector::ZeroVector);
+		for (const FVector2D& Point : Anchor->PlaneBoundary2D)
+		{
+			AddPoint(FVector(0.0, Point.X, Point.Y));
+		}
+		if (Anchor->PlaneBounds.bIsValid)
+		{
+			const FBox2D& PlaneBounds = Anchor->PlaneBounds;
+			AddPoint(FVector(0.0, PlaneBounds.Min.X, PlaneBounds.Min.Y));
+			AddPoint(FVector(0.0, PlaneBounds.Max.X, PlaneBounds.Max.Y));
+			AddPoint(FVector(0.0, PlaneBounds.Min.X, PlaneBounds.Max.Y));
+			AddPoint(FVector(0.0, PlaneBounds.Max.X, PlaneBounds.Min.Y));
+		}
+		if (Anchor->VolumeBounds.IsValid)
+		{
+			const FBox& VolumeBounds = Anchor->VolumeBounds;
+			for (const double X : { 0.0, VolumeBounds.Min.X, VolumeBounds.Max.X })
+			{
+				AddPoint(FVector(X, VolumeBounds.Min.Y, VolumeBounds.Min.Z));
+				AddPoint(FVector(X, VolumeBounds.Max.Y, VolumeBounds.Max.Z));
+				AddPoint(FVector(X, VolumeBounds.Min.Y, VolumeBounds.Max.Z));
+				AddPoint(FVector(X, VolumeBounds.Max.Y, VolumeBounds.Min.Z));
+			}
+		}
+
+		Footprint = Footprint.ExpandBy(HierarchyFootprintMargin);
+		return FIntRect(
+			FMath::FloorToInt32(Footprint.Min.X / HierarchyCellSize), FMath::FloorToInt32(Footprint.Min.Y / HierarchyCellSize),
+			FMath::FloorToInt32(Footprint.Max.X / HierarchyCellSize), FMath::FloorToInt32(Footprint.Max.Y / HierarchyCellSize));
+	}
+} // namespace
+
+void FMRUKAnchorHierarchy::Reset()
+{
+	Nodes.Empty();
+	Grid.Empty();
+}
+
+void FMRUKAnchorHierarchy::Remove(const AMRUKAnchor* Anchor)
+{
+	if (FNode* Node = Nodes.Find(Anchor))
+	{
+		Unlink(*Node);
+		RemoveFromGrid(*Node);
+		Nodes.Remove(Anchor);
+	}
+}
+
+int32 FMRUKAnchorHierarchy::Update(TConstArrayView<TObjectPtr<AMRUKAnchor>> AllAnchors, TConstArrayView<TObjectPtr<AMRUKAnchor>> WallAnchors, AMRUKAnchor* FloorAnchor)
+{
+	++UpdateStamp;
+
+	TMap<const AMRUKAnchor*, int32> WallOrder;
+	WallOrder.Reserve(WallAnchors.Num());
+	for (int32 I = 0; I < WallAnchors.Num(); ++I)
+	{
+		if (WallAnchors[I])
+		{
+			WallOrder.Add(WallAnchors[I], I);
+		}
+	}
+
+	// Find the anchors that are new or changed since the last update
+	TMap<const AMRUKAnchor*, int32> AnchorOrder;
+	AnchorOrder.Reserve(AllAnchors.Num());
+	TArray<AMRUKAnchor*> DirtyAnchors;
+	for (int32 I = 0; I < AllAnchors.Num(); ++I)
+	{
+		AMRUKAnchor* Anchor = AllAnchors[I];
+		if (!Anchor)
+		{
+			continue;
+		}
+		AnchorOrder.Add(Anchor, I);
+
+		FNode& Node = Nodes.FindOrAdd(Anchor);
+		Node.UpdateStamp = UpdateStamp;
+		if (Node.bDirty)
+		{
+			continue;
+		}
+		const bool bIsWall = WallOrder.Contains(Anchor);
+		const bool bIsFloor = Anchor == FloorAnchor;
+		if (!Node.Anchor || Node.bIsWall != bIsWall || Node.bIsFloor != bIsFloor || !Node.Transform.Equals(Anchor->GetTransform(), 0.0)
+			|| Node.PlaneBounds.bIsValid != Anchor->PlaneBounds.bIsValid || Node.PlaneBounds != Anchor->PlaneBounds
+			|| Node.VolumeBounds.IsValid != Anchor->VolumeBounds.IsValid || Node.VolumeBounds != Anchor->VolumeBounds
+			|| Node.PlaneBoundary != Anchor->PlaneBoundary2D)
+		{
+			Node.Anchor = Anchor;
+			Node.bIsWall = bIsWall;
+			Node.bIsFloor = bIsFloor;
+			Node.Transform = Anchor->GetTransform();
+			Node.PlaneBounds = Anchor->PlaneBounds;
+			Node.VolumeBounds = Anchor->VolumeBounds;
+			Node.PlaneBoundary = Anchor->PlaneBoundary2D;
+			Node.bDirty = true;
+			DirtyAnchors.Push(Anchor);
+		}
+	}
+
+	// Drop anchors that are no longer part of the room
+	for (auto It = Nodes.CreateIterator(); It; ++It)
+	{
+		if (It.Value().UpdateStamp != UpdateStamp)
+		{
+			Unlink(It.Value());
+			RemoveFromGrid(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+
+	// Forget everything that is known about the changed anchors before evaluating them again,
+	// otherwise a pair of changed anchors could see stale state of each other
+	for (AMRUKAnchor* Anchor : DirtyAnchors)
+	{
+		FNode& Node = Nodes[Anchor];
+		Unlink(Node);
+		RemoveFromGrid(Node);
+		Node.Cells = ComputeHierarchyCells(Anchor);
+		AddToGrid(Node);
+	}
+
+	// Test the changed anchors against the anchors in the cells they cover. A pair of changed anchors is
+	// skipped by whichever of the two comes first and tested by the other one once the first is no longer dirty.
+	for (AMRUKAnchor* Anchor : DirtyAnchors)
+	{
+		FNode& Node = Nodes[Anchor];
+		const uint32 Visit = ++VisitStamp;
+		Node.VisitStamp = Visit;
+		for (int32 Y = Node.Cells.Min.Y; Y <= Node.Cells.Max.Y; ++Y)
+		{
+			for (int32 X = Node.Cells.Min.X; X <= Node.Cells.Max.X; ++X)
+			{
+				const TArray<AMRUKAnchor*>* Cell = Grid.Find(FIntPoint(X, Y));
+				if (!Cell)
+				{
+					continue;
+				}
+				for (AMRUKAnchor* Other : *Cell)
+				{
+					FNode& OtherNode = Nodes[Other];
+					if (OtherNode.VisitStamp == Visit || OtherNode.bDirty)
+					{
+						continue;
+					}
+					OtherNode.VisitStamp = Visit;
+					Evaluate(Node, OtherNode);
+					Evaluate(OtherNode, Node);
+				}
+			}
+		}
+		Node.bDirty = false;
+	}
+
+	// Write the relationships to the anchors. If an anchor matches several parents the full pairwise algorithm keeps
+	// the one it finds last: walls in the order of WallAnchors, then the floor, then volumes in the order of AllAnchors.
+	// Children are listed in the order of AllAnchors, grouped by the role of the parent.
+	const auto GetParentOrder = [&WallOrder, &AnchorOrder](const FLink& Link) {
+		const int32 Order = Link.Role == ERole::Wall ? WallOrder.FindRef(Link.Anchor) : Link.Role == ERole::Volume ? AnchorOrder.FindRef(Link.Anchor) : 0;
+		return (static_cast<int64>(Link.Role) << 32) | Order;
+	};
+	const auto GetChildOrder = [&AnchorOrder](const FLink& Link) {
+		return (static_cast<int64>(Link.Role) << 32) | AnchorOrder.FindRef(Link.Anchor);
+	};
+	for (AMRUKAnchor* Anchor : AllAnchors)
+	{
+		if (!Anchor)
+		{
+			continue;
+		}
+		FNode& Node = Nodes[Anchor];
+
+		AMRUKAnchor* Parent = nullptr;
+		int64 ParentOrder = -1;
+		for (const FLink& Link : Node.Parents)
+		{
+			const int64 Order = GetParentOrder(Link);
+			if (Order > ParentOrder)
+			{
+				ParentOrder = Order;
+				Parent = Link.Anchor;
+			}
+		}
+		Anchor->ParentAnchor = Parent;
+
+		Node.Children.Sort([&GetChildOrder](const FLink& A, const FLink& B) { return GetChildOrder(A) < GetChildOrder(B); });
+		Anchor->ChildAnchors.Reset(Node.Children.Num());
+		for (const FLink& Link : Node.Children)
+		{
+			Anchor->ChildAnchors.Push(Link.Anchor);
+		}
+	}
+
+	return DirtyAnchors.Num();
+}
+
+void FMRUKAnchorHierarchy::Unlink(FNode& Node)
+{
+	for (const FLink& Link : Node.Parents)
+	{
+		if (FNode* Parent = Nodes.Find(Link.Anchor))
+		{
+			Parent->Children.RemoveAllSwap([&Node](const FLink& Other) { return Other.Anchor == Node.Anchor; }, EAllowShrinking::No);
+		}
+	}
+	for (const FLink& Link : Node.Children)
+	{
+		if (FNode* Child = Nodes.Find(Link.Anchor))
+		{
+			Child->Parents.RemoveAllSwap([&Node](const FLink& Other) { return Other.Anchor == Node.Anchor; }, EAllowShrinking::No);
+		}
+	}
+	Node.Parents.Reset();
+	Node.Children.Reset();
+}
+
+void FMRUKAnchorHierarchy::AddToGrid(FNode& Node)
+{
+	for (int32 Y = Node.Cells.Min.Y; Y <= Node.Cells.Max.Y; ++Y)
+	{
+		for (int32 X = Node.Cells.Min.X; X <= Node.Cells.Max.X; ++X)
+		{
+			Grid.FindOrAdd(FIntPoint(X, Y)).Push(Node.Anchor);
+		}
+	}
+	Node.bInGrid = true;
+}
+
+void FMRUKAnchorHierarchy::RemoveFromGrid(FNode& Node)
+{
+	if (!Node.bInGrid)
+	{
+		return;
+	}
+	for (int32 Y = Node.Cells.Min.Y; Y <= Node.Cells.Max.Y; ++Y)
+	{
+		for (int32 X = Node.Cells.Min.X; X <= Node.Cells.Max.X; ++X)
+		{
+			const FIntPoint Key(X, Y);
+			if (TArray<AMRUKAnchor*>* Cell = Grid.Find(Key))
+			{
+				Cell->RemoveSingleSwap(Node.Anchor, EAllowShrinking::No);
+				if (Cell->IsEmpty())
+				{
+					Grid.Remove(Key);
+				}
+			}
+		}
+	}
+	Node.bInGrid = false;
+}
+
+void FMRUKAnchorHierarchy::Evaluate(FNode& Parent, FNode& Child)
+{
+	const auto Link = [&Parent, &Child](ERole Role) {
+		Parent.Children.Push({ Child.Anchor, Role });
+		Child.Parents.Push({ Parent.Anchor, Role });
+	};
+
+	if (Parent.bIsWall && IsAttachedToWall(Parent.Anchor, Child.Anchor))
+	{
+		Link(ERole::Wall);
+	}
+	if (Parent.bIsFloor && IsStandingOnFloor(Parent.Anchor, Child.Anchor))
+	{
+		Link(ERole::Floor);
+	}
+	if (IsStackedOnVolume(Parent.Anchor, Child.Anchor))
+	{
+		Link(ERole::Volume);
+	}
+}
@@ -7,6 +7,8 @@
 #include "MRUtilityKitAnchor.h"
 #include "MRUtilityKitSubsystem.h"
 #include "MRUtilityKitSerializationHelpers.h"
+#include "MRUtilityKitSceneSnapshot.h"
+#include "MRUtilityKitGlobalMeshJsonReader.h"
 #include "ProceduralMeshComponent.h"
 #include "VectorUtil.h"
 #include "Engine/World.h"
@@ -16,8 +18,6 @@
 #include "Engine/TextureRenderTarget2D.h"
 
 #include "Engine/Texture2D.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
 
 namespace
 {
@@ -255,53 +255,57 @@ bool UMRUKBPLibrary::LoadGlobalMeshFromJsonString(const FString& JsonString, FOc
 {
 	ensure(OutProceduralMesh);
 
-	TSharedPtr<FJsonValue> JsonValue;
-	auto JsonReader = TJsonReaderFactory<>::Create(JsonString);
-	if (!FJsonSerializer::Deserialize(JsonReader, JsonValue))
+	// Stream the global mesh straight into the vertex and index arrays instead of building a DOM of the whole scene
+	TArray<FVector> Positions;
+	TArray<int32> Indices;
+	FMRUKJsonReadError Error;
+	if (!MRUKReadGlobalMeshFromJson(JsonString, AnchorUUID, Positions, Indices, &Error))
 	{
-		UE_LOG(LogMRUK, Warning, TEXT("Could not deserialize global mesh JSON data"));
+		if (Error.Offset != INDEX_NONE)
+		{
+			UE_LOG(LogMRUK, Warning, TEXT("Could not deserialize global mesh JSON data: %s at offset %lld"), *Error.Message, Error.Offset);
+		}
+		else
+		{
+			UE_LOG(LogMRUK, Warning, TEXT("Could not find global mesh in room"));
+		}
 		return false;
 	}
 
-	auto JsonObject = JsonValue->AsObject();
+	TArray<FVector> EmptyNormals;
+	TArray<FVector2D> EmptyUV;
+	TArray<FColor> EmptyVertexColors;
+	TArray<FProcMeshTangent> EmptyTangents;
+	OutProceduralMesh->CreateMeshSection(0, Positions, Indices, EmptyNormals, EmptyUV, EmptyVertexColors, EmptyTangents, LoadCollision);
+
+	return true;
+}
+
+bool UMRUKBPLibrary::LoadGlobalMeshFromSnapshot(const TArray<uint8>& Snapshot, FOculusXRUUID AnchorUUID, UProceduralMeshComponent* OutProceduralMesh, bool LoadCollision)
+{
+	ensure(OutProceduralMesh);
+
+	FMRUKSceneSnapshot Scene;
+	if (!MRUKReadSceneSnapshot(Snapshot, Scene))
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Could not read global mesh scene snapshot"));
+		return false;
+	}
 
 	// Find room
-	auto RoomsJson = JsonObject->GetArrayField(TEXT("Rooms"));
-	for (const auto& RoomJson : RoomsJson)
+	for (const FMRUKSnapshotRoom& Room : Scene.Rooms)
 	{
-		auto RoomObject = RoomJson->AsObject();
-		FOculusXRUUID RoomUUID;
-		MRUKDeserialize(*RoomObject->GetField<EJson::None>(TEXT("UUID")), RoomUUID);
-		if (RoomUUID == AnchorUUID)
+		if (Room.UUID == AnchorUUID)
 		{
 			// Find global mesh anchor
-			auto AnchorsJson = RoomObject->GetArrayField(TEXT("Anchors"));
-			for (const auto& AnchorJson : AnchorsJson)
+			for (const FMRUKSnapshotAnchor& Anchor : Room.Anchors)
 			{
-				auto AnchorObject = AnchorJson->AsObject();
-				if (AnchorObject->HasField(TEXT("GlobalMesh")))
+				if (Anchor.GlobalMesh.IsSet())
 				{
-					auto GlobalMeshObject = AnchorObject->GetField<EJson::Object>(TEXT("GlobalMesh"))->AsObject();
-
-					auto PositionsJson = GlobalMeshObject->GetArrayField(TEXT("Positions"));
-					TArray<FVector> Positions;
-					Positions.Reserve(PositionsJson.Num());
-					for (const auto& PositionJson : PositionsJson)
-					{
-						FVector Position;
-						MRUKDeserialize(*PositionJson, Position);
-						Positions.Push(Position);
-					}
-
-					auto IndicesJson = GlobalMeshObject->GetArrayField(TEXT("Indices"));
-					TArray<int32> Indices;
-					Indices.Reserve(IndicesJson.Num());
-					for (const auto& IndexJson : IndicesJson)
-					{
-						double Index;
-						MRUKDeserialize(*IndexJson, Index);
-						Indices.Push((int32)Index);
-					}
+					// The snapshot references the mesh data in place, the procedural mesh needs its own copy
+					const FMRUKSnapshotGlobalMesh& GlobalMesh = Anchor.GlobalMesh.GetValue();
+					const TArray<FVector> Positions(GlobalMesh.GetPositions());
+					const TArray<int32> Indices(GlobalMesh.GetIndices());
 
 					TArray<FVector> EmptyNormals;
 					TArray<FVector2D> EmptyUV;
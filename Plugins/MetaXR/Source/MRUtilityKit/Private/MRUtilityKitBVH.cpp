@@ -0,0 +1,320 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitBVH.h"
+
+namespace
+{
+	// Leaf bounds get enlarged by this margin (in cm). Planes have no thickness, so this also ensures that
+	// their bounds have some volume.
+	constexpr double LeafMargin = 2.0;
+
+	double SurfaceArea(const FBox& Box)
+	{
+		const FVector Size = Box.GetSize();
+		return 2.0 * (Size.X * Size.Y + Size.Y * Size.Z + Size.Z * Size.X);
+	}
+} // namespace
+
+void FMRUKAnchorBVH::Reset()
+{
+	Nodes.Empty();
+	AnchorToLeaf.Empty();
+	Root = INDEX_NONE;
+	FreeList = INDEX_NONE;
+}
+
+void FMRUKAnchorBVH::InsertOrUpdate(AMRUKAnchor* Anchor, const FBox& Bounds)
+{
+	if (!Bounds.IsValid)
+	{
+		Remove(Anchor);
+		return;
+	}
+
+	if (const int32* ExistingLeaf = AnchorToLeaf.Find(Anchor))
+	{
+		const int32 Leaf = *ExistingLeaf;
+		if (Nodes[Leaf].Bounds.IsInsideOrOn(Bounds.Min) && Nodes[Leaf].Bounds.IsInsideOrOn(Bounds.Max)
+			&& Nodes[Leaf].Bounds.ExpandBy(-2.0 * LeafMargin).GetVolume() <= Bounds.GetVolume())
+		{
+			// The enlarged bounds still contain the new bounds and have not become much bigger, no need to reinsert
+			return;
+		}
+		RemoveLeaf(Leaf);
+		Nodes[Leaf].Bounds = Bounds.ExpandBy(LeafMargin);
+		InsertLeaf(Leaf);
+		return;
+	}
+
+	const int32 Leaf = AllocateNode();
+	Nodes[Leaf].Bounds = Bounds.ExpandBy(LeafMargin);
+	Nodes[Leaf].Anchor = Anchor;
+	Nodes[Leaf].Height = 0;
+	InsertLeaf(Leaf);
+	AnchorToLeaf.Add(Anchor, Leaf);
+}
+
+void FMRUKAnchorBVH::Remove(const AMRUKAnchor* Anchor)
+{
+	int32 Leaf = INDEX_NONE;
+	if (!AnchorToLeaf.RemoveAndCopyValue(Anchor, Leaf))
+	{
+		return;
+	}
+	RemoveLeaf(Leaf);
+	FreeNode(Leaf);
+}
+
+int32 FMRUKAnchorBVH::AllocateNode()
+{
+	if (FreeList == INDEX_NONE)
+	{
+		return Nodes.AddDefaulted();
+	}
+	const int32 NodeIndex = FreeList;
+	FreeList = Nodes[NodeIndex].Parent;
+	Nodes[NodeIndex] = FNode();
+	return NodeIndex;
+}
+
+void FMRUKAnchorBVH::FreeNode(int32 NodeIndex)
+{
+	FNode& Node = Nodes[NodeIndex];
+	Node.Anchor = nullptr;
+	Node.Child1 = INDEX_NONE;
+	Node.Child2 = INDEX_NONE;
+	Node.Height = -1;
+	// Free nodes are chained through their parent index
+	Node.Parent = FreeList;
+	FreeList = NodeIndex;
+}
+
+void FMRUKAnchorBVH::InsertLeaf(int32 Leaf)
+{
+	if (Root == INDEX_NONE)
+	{
+		Root = Leaf;
+		Nodes[Root].Parent = INDEX_NONE;
+		return;
+	}
+
+	// Find the best sibling for the new leaf using the surface area heuristic
+	const FBox LeafBounds = Nodes[Leaf].Bounds;
+	int32 Index = Root;
+	while (!Nodes[Index].IsLeaf())
+	{
+		const FNode& Node = Nodes[Index];
+		const double Area = SurfaceArea(Node.Bounds);
+		const double CombinedArea = SurfaceArea(Node.Bounds + LeafBounds);
+
+		// Cost of creating a new parent for this node and the new leaf
+		const double Cost = 2.0 * CombinedArea;
+		// Minimum cost of pushing the leaf further down the tree
+		const double InheritanceCost = 2.0 * (CombinedArea - Area);
+
+		const auto ChildCost = [this, &LeafBounds, InheritanceCost](int32 Child) {
+			const FNode& ChildNode = Nodes[Child];
+			const double NewArea = SurfaceArea(ChildNode.Bounds + LeafBounds);
+			return ChildNode.IsLeaf() ? NewArea + InheritanceCost : (NewArea - SurfaceArea(ChildNode.Bounds)) + InheritanceCost;
+		};
+		const double Cost1 = ChildCost(Node.Child1);
+		const double Cost2 = ChildCost(Node.Child2);
+
+		// Descend according to the minimum cost
+		if (Cost < Cost1 && Cost < Cost2)
+		{
+			break;
+		}
+		Index = Cost1 < Cost2 ? Node.Child1 : Node.Child2;
+	}
+	const int32 Sibling = Index;
+
+	// Create a new parent
+	const int32 OldParent = Nodes[Sibling].Parent;
+	const int32 NewParent = AllocateNode();
+	Nodes[NewParent].Parent = OldParent;
+	Nodes[NewParent].Bounds = LeafBounds + Nodes[Sibling].Bounds;
+	Nodes[NewParent].Height = Nodes[Sibling].Height + 1;
+	Nodes[NewParent].Child1 = Sibling;
+	Nodes[NewParent].Child2 = Leaf;
+	Nodes[Sibling].Parent = NewParent;
+	Nodes[Leaf].Parent = NewParent;
+
+	if (OldParent != INDEX_NONE)
+	{
+		// The sibling was not the root
+		if (Nodes[OldParent].Child1 == Sibling)
+		{
+			Nodes[OldParent].Child1 = NewParent;
+		}
+		else
+		{
+			Nodes[OldParent].Child2 = NewParent;
+		}
+	}
+	else
+	{
+		// The sibling was the root
+		Root = NewParent;
+	}
+
+	RefitAncestors(Nodes[Leaf].Parent);
+}
+
+void FMRUKAnchorBVH::RemoveLeaf(int32 Leaf)
+{
+	if (Leaf == Root)
+	{
+		Root = INDEX_NONE;
+		return;
+	}
+
+	const int32 Parent = Nodes[Leaf].Parent;
+	const int32 GrandParent = Nodes[Parent].Parent;
+	const int32 Sibling = Nodes[Parent].Child1 == Leaf ? Nodes[Parent].Child2 : Nodes[Parent].Child1;
+
+	if (GrandParent != INDEX_NONE)
+	{
+		// Destroy the parent and connect the sibling to the grand parent
+		if (Nodes[GrandParent].Child1 == Parent)
+		{
+			Nodes[GrandParent].Child1 = Sibling;
+		}
+		else
+		{
+			Nodes[GrandParent].Child2 = Sibling;
+		}
+		Nodes[Sibling].Parent = GrandParent;
+		FreeNode(Parent);
+
+		RefitAncestors(GrandParent);
+	}
+	else
+	{
+		Root = Sibling;
+		Nodes[Sibling].Parent = INDEX_NONE;
+		FreeNode(Parent);
+	}
+}
+
+void FMRUKAnchorBVH::RefitAncestors(int32 NodeIndex)
+{
+	// Walk back up the tree fixing heights and bounds
+	while (NodeIndex != INDEX_NONE)
+	{
+		NodeIndex = Balance(NodeIndex);
+
+		FNode& Node = Nodes[NodeIndex];
+		const FNode& Child1 = Nodes[Node.Child1];
+		const FNode& Child2 = Nodes[Node.Child2];
+		Node.Height = 1 + FMath::Max(Child1.Height, Child2.Height);
+		Node.Bounds = Child1.Bounds + Child2.Bounds;
+
+		NodeIndex = Node.Parent;
+	}
+}
+
+int32 FMRUKAnchorBVH::Balance(int32 IndexA)
+{
+	// Perform a left or right rotation if node A is imbalanced. Returns the new root index of the subtree.
+	FNode& A = Nodes[IndexA];
+	if (A.IsLeaf() || A.Height < 2)
+	{
+		return IndexA;
+	}
+
+	const int32 IndexB = A.Child1;
+	const int32 IndexC = A.Child2;
+	FNode& B = Nodes[IndexB];
+	FNode& C = Nodes[IndexC];
+
+	const int32 BalanceFactor = C.Height - B.Height;
+
+	const auto Rotate = [this, IndexA](int32 IndexUp, int32 IndexOther, bool bUpIsChild2) {
+		// Node "Up" gets promoted to replace A, its taller child stays below it and the shorter one moves to A
+		FNode& NodeA = Nodes[IndexA];
+		FNode& Up = Nodes[IndexUp];
+		const int32 IndexF = Up.Child1;
+		const int32 IndexG = Up.Child2;
+		FNode& F = Nodes[IndexF];
+		FNode& G = Nodes[IndexG];
+
+		Up.Child1 = IndexA;
+		Up.Parent = NodeA.Parent;
+		NodeA.Parent = IndexUp;
+
+		if (Up.Parent != INDEX_NONE)
+		{
+			if (Nodes[Up.Parent].Child1 == IndexA)
+			{
+				Nodes[Up.Parent].Child1 = IndexUp;
+			}
+			else
+			{
+				Nodes[Up.Parent].Child2 = IndexUp;
+			}
+		}
+		else
+		{
+			Root = IndexUp;
+		}
+
+		const FNode& Other = Nodes[IndexOther];
+		const int32 IndexTall = F.Height > G.Height ? IndexF : IndexG;
+		const int32 IndexShort = F.Height > G.Height ? IndexG : IndexF;
+		FNode& Tall = Nodes[IndexTall];
+		FNode& Short = Nodes[IndexShort];
+
+		Up.Child2 = IndexTall;
+		if (bUpIsChild2)
+		{
+			NodeA.Child2 = IndexShort;
+		}
+		else
+		{
+			NodeA.Child1 = IndexShort;
+		}
+		Short.Parent = IndexA;
+		NodeA.Bounds = Other.Bounds + Short.Bounds;
+		Up.Bounds = NodeA.Bounds + Tall.Bounds;
+		NodeA.Height = 1 + FMath::Max(Other.Height, Short.Height);
+		Up.Height = 1 + FMath::Max(NodeA.Height, Tall.Height);
+
+		return IndexUp;
+	};
+
+	if (BalanceFactor > 1)
+	{
+		// Rotate C up
+		return Rotate(IndexC, IndexB, true);
+	}
+	if (BalanceFactor < -1)
+	{
+		// Rotate B up
+		return Rotate(IndexB, IndexC, false);
+	}
+	return IndexA;
+}
+
+bool FMRUKAnchorBVH::RayIntersectsBox(const FBox& Box, const FVector& Origin, const FVector& InvDirection, double MaxDist)
+{
+	// Slab test, distances are in multiples of the ray direction
+	double DistNear = 0.0;
+	double DistFar = MaxDist;
+	for (int32 I = 0; I < 3; ++I)
+	{
+		double Dist1 = (Box.Min[I] - Origin[I]) * InvDirection[I];
+		double Dist2 = (Box.Max[I] - Origin[I]) * InvDirection[I];
+		if (Dist1 > Dist2)
+		{
+			Swap(Dist1, Dist2);
+		}
+		DistNear = FMath::Max(DistNear, Dist1);
+		DistFar = FMath::Min(DistFar, Dist2);
+		if (DistNear > DistFar)
+		{
+			return false;
+		}
+	}
+	return true;
+}
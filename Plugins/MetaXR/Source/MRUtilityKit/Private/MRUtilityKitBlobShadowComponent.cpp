@@ -1,6 +1,7 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "MRUtilityKitBlobShadowComponent.h"
+#include "MRUtilityKitBlobShadowSubsystem.h"
 #include "MRUtilityKitTelemetry.h"
 #include "MRUtilityKit.h"
 #include "Kismet/KismetSystemLibrary.h"
@@ -64,6 +65,22 @@ void UMRUKBlobShadowComponent::BeginPlay()
 
 	// Compute size and position once
 	UpdatePlaneSizeAndPosition();
+
+	// From now on the subsystem keeps the blob shadow up to date
+	if (UMRUKBlobShadowSubsystem* Subsystem = GetWorld()->GetSubsystem<UMRUKBlobShadowSubsystem>())
+	{
+		Subsystem->Register(this);
+		SetComponentTickEnabled(false);
+	}
+}
+
+void UMRUKBlobShadowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UMRUKBlobShadowSubsystem* Subsystem = GetWorld()->GetSubsystem<UMRUKBlobShadowSubsystem>())
+	{
+		Subsystem->Unregister(this);
+	}
+	Super::EndPlay(EndPlayReason);
 }
 
 void UMRUKBlobShadowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -77,13 +94,7 @@ void UMRUKBlobShadowComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 void UMRUKBlobShadowComponent::UpdatePlaneSizeAndPosition()
 {
 	FVector Origin;
-	FVector2D Extent;
-	double Yaw;
-	ComputeOwner2DBounds(Origin, Extent, Yaw);
-
-	Extent += FVector2D::UnitVector * ExtraExtent; // Additional extent
-	SetWorldScale3D(FVector(Extent * 0.02f, 1.f)); // Plane mesh is 100x100, multiplying by 0.02f to match the correct size when scaling
-	SetWorldRotation(FRotator(0.f, Yaw, 0.f));
+	const FVector2D Extent = UpdatePlaneSizeAndRotation(Origin);
 
 	// Sphere trace to the ground
 	FHitResult Hit;
@@ -91,34 +102,71 @@ void UMRUKBlobShadowComponent::UpdatePlaneSizeAndPosition()
 	ActorsToIgnore.Add(GetOwner());
 	const bool bHasHit = UKismetSystemLibrary::SphereTraceSingle(this, Origin, Origin + FVector::DownVector * MaxVerticalDistance, Extent.Length() * 0.5f, TraceTypeQuery1,
 		true, ActorsToIgnore, EDrawDebugTrace::None, Hit, true);
+	ApplyGroundHit(Extent, bHasHit ? &Hit : nullptr);
+}
+
+FVector2D UMRUKBlobShadowComponent::UpdatePlaneSizeAndRotation(FVector& OutOrigin)
+{
+	FVector2D Extent;
+	double Yaw;
+	ComputeOwner2DBounds(OutOrigin, Extent, Yaw);
+
+	Extent += FVector2D::UnitVector * ExtraExtent; // Additional extent
+	SetWorldScale3D(FVector(Extent * 0.02f, 1.f)); // Plane mesh is 100x100, multiplying by 0.02f to match the correct size when scaling
+	SetWorldRotation(FRotator(0.f, Yaw, 0.f));
+	return Extent;
+}
+
+void UMRUKBlobShadowComponent::ApplyGroundHit(const FVector2D& Extent, const FHitResult* Hit)
+{
+	ShadowExtent = Extent;
+	if (Hit)
+	{
+		SetHiddenInGame(false);											// Make plane visible
+		SetWorldLocation(Hit->ImpactPoint + FVector::UpVector * 0.02f); // Impact + some offset to avoid Z-fighting
+		GroundDistance = Hit->Distance;
+	}
+	else
+	{
+		SetHiddenInGame(true); // Hide plane
+		GroundDistance = -1.0f;
+	}
+	UpdateMaterialParameters();
+}
+
+void UMRUKBlobShadowComponent::UpdateMaterialParameters()
+{
+	static const FName ParameterNames[] = { TEXT("CornerWorldSize"), TEXT("Gradient"), TEXT("GradientPower"), TEXT("Opacity") };
+	constexpr float ParameterTolerance = 1e-3f;
+
 	float Opacity = 0.f;
-	if (bHasHit)
+	if (GroundDistance >= 0.0f)
 	{
-		SetHiddenInGame(false);										   // Make plane visible
-		SetWorldLocation(Hit.ImpactPoint + FVector::UpVector * 0.02f); // Impact + some offset to avoid Z-fighting
 		Opacity = FMath::GetMappedRangeValueClamped(
 			FVector2D(MaxVerticalDistance - FadeDistance, MaxVerticalDistance),
 			FVector2D(1.f, 0.f),
-			Hit.Distance); // Set opacity based on distance to ground
+			GroundDistance); // Set opacity based on distance to ground
 	}
-	else
-		SetHiddenInGame(true); // Hide plane
+	const float Values[] = { static_cast<float>(FMath::Min(ShadowExtent.X, ShadowExtent.Y) * Roundness), Gradient, GradientPower, Opacity };
 
 	// Update material's parameters
-	if (DynMaterial)
+	for (int32 i = 0; i < UE_ARRAY_COUNT(Values); ++i)
 	{
-		DynMaterial->SetScalarParameterValue("CornerWorldSize", FMath::Min(Extent.X, Extent.Y) * Roundness);
-		DynMaterial->SetScalarParameterValue("Gradient", Gradient);
-		DynMaterial->SetScalarParameterValue("GradientPower", GradientPower);
-		DynMaterial->SetScalarParameterValue("Opacity", Opacity);
-	}
-	else // In case DynMaterial doesn't exist (e.g. in editor), update values directly on the mesh
-	{
-		SetScalarParameterValueOnMaterials("CornerWorldSize", FMath::Min(Extent.X, Extent.Y) * Roundness);
-		SetScalarParameterValueOnMaterials("Gradient", Gradient);
-		SetScalarParameterValueOnMaterials("GradientPower", GradientPower);
-		SetScalarParameterValueOnMaterials("Opacity", Opacity);
+		if (bMaterialParametersPushed && FMath::Abs(Values[i] - MaterialParameters[i]) <= ParameterTolerance)
+		{
+			continue;
+		}
+		MaterialParameters[i] = Values[i];
+		if (DynMaterial)
+		{
+			DynMaterial->SetScalarParameterValue(ParameterNames[i], Values[i]);
+		}
+		else // In case DynMaterial doesn't exist (e.g. in editor), update values directly on the mesh
+		{
+			SetScalarParameterValueOnMaterials(ParameterNames[i], Values[i]);
+		}
 	}
+	bMaterialParametersPushed = true;
 }
 
 void UMRUKBlobShadowComponent::ComputeOwner2DBounds(FVector& Origin, FVector2D& Extent, double& Yaw) const
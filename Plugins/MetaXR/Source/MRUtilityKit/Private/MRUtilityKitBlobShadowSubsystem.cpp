@@ -0,0 +1,111 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitBlobShadowSubsystem.h"
+#include "MRUtilityKitBlobShadowComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+DECLARE_CYCLE_STAT(TEXT("MRUK Blob Shadow Subsystem Tick"), STAT_MRUKBlobShadowSubsystemTick, STATGROUP_Game);
+
+void UMRUKBlobShadowSubsystem::Register(UMRUKBlobShadowComponent* BlobShadow)
+{
+	if (!BlobShadow || !BlobShadow->GetOwner())
+	{
+		return;
+	}
+	Unregister(BlobShadow);
+
+	FShadow& Shadow = Shadows.AddDefaulted_GetRef();
+	Shadow.Component = BlobShadow;
+	Shadow.OwnerTransform = BlobShadow->GetOwner()->GetActorTransform();
+	Shadow.ExtraExtent = BlobShadow->ExtraExtent;
+	Shadow.MaxVerticalDistance = BlobShadow->MaxVerticalDistance;
+}
+
+void UMRUKBlobShadowSubsystem::Unregister(UMRUKBlobShadowComponent* BlobShadow)
+{
+	Shadows.RemoveAllSwap([BlobShadow](const FShadow& Shadow) { return Shadow.Component == BlobShadow; }, EAllowShrinking::No);
+}
+
+void UMRUKBlobShadowSubsystem::Invalidate(UMRUKBlobShadowComponent* BlobShadow)
+{
+	for (FShadow& Shadow : Shadows)
+	{
+		if (Shadow.Component == BlobShadow)
+		{
+			Shadow.bDirty = true;
+		}
+	}
+}
+
+void UMRUKBlobShadowSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MRUKBlobShadowSubsystemTick);
+	Super::Tick(DeltaTime);
+
+	const double StartTime = FPlatformTime::Seconds();
+	UWorld* World = GetWorld();
+	Stats = {};
+
+	for (int32 i = Shadows.Num() - 1; i >= 0; --i)
+	{
+		FShadow& Shadow = Shadows[i];
+		UMRUKBlobShadowComponent* BlobShadow = Shadow.Component.Get();
+		const AActor* Owner = BlobShadow ? BlobShadow->GetOwner() : nullptr;
+		if (!Owner)
+		{
+			Shadows.RemoveAtSwap(i, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// Distribute the results of the traces that have been started in the previous frame
+		if (Shadow.PendingTrace.IsValid())
+		{
+			FTraceDatum Datum;
+			if (World->QueryTraceData(Shadow.PendingTrace, Datum))
+			{
+				const FHitResult* Hit = Datum.OutHits.FindByPredicate([](const FHitResult& Result) { return Result.bBlockingHit; });
+				BlobShadow->ApplyGroundHit(Shadow.PendingExtent, Hit);
+				++Stats.ResultsApplied;
+			}
+			else
+			{
+				// The result is gone, e.g. because the world didn't tick in between. Trace again.
+				Shadow.bDirty = true;
+			}
+			Shadow.PendingTrace = FTraceHandle();
+		}
+
+		const FTransform& OwnerTransform = Owner->GetActorTransform();
+		if (!Shadow.bDirty && Shadow.ExtraExtent == BlobShadow->ExtraExtent && Shadow.MaxVerticalDistance == BlobShadow->MaxVerticalDistance
+			&& OwnerTransform.Equals(Shadow.OwnerTransform, TransformTolerance))
+		{
+			// Settings that only affect the material can still change without the owner moving
+			BlobShadow->UpdateMaterialParameters();
+			++Stats.TracesSkipped;
+			continue;
+		}
+
+		Shadow.OwnerTransform = OwnerTransform;
+		Shadow.ExtraExtent = BlobShadow->ExtraExtent;
+		Shadow.MaxVerticalDistance = BlobShadow->MaxVerticalDistance;
+		Shadow.bDirty = false;
+
+		// Same query as UMRUKBlobShadowComponent::UpdatePlaneSizeAndPosition()
+		FVector Origin;
+		Shadow.PendingExtent = BlobShadow->UpdatePlaneSizeAndRotation(Origin);
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(MRUKBlobShadow), true, Owner);
+		Params.bReturnPhysicalMaterial = true;
+		Shadow.PendingTrace = World->AsyncSweepByChannel(EAsyncTraceType::Single, Origin, Origin + FVector::DownVector * BlobShadow->MaxVerticalDistance, FQuat::Identity,
+			UEngineTypes::ConvertToCollisionChannel(TraceTypeQuery1), FCollisionShape::MakeSphere(Shadow.PendingExtent.Length() * 0.5f), Params);
+		++Stats.TracesIssued;
+	}
+
+	Stats.Shadows = Shadows.Num();
+	Stats.UpdateTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+TStatId UMRUKBlobShadowSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UMRUKBlobShadowSubsystem, STATGROUP_Tickables);
+}
@@ -119,6 +119,17 @@ void UMRUKAnchorData::LoadFromJson(const FJsonValue& Value)
 	NeedAnchorLocalization = false;
 }
 
+void UMRUKAnchorData::LoadFromSnapshot(const FMRUKSnapshotAnchor& Anchor)
+{
+	SpaceQuery.UUID = Anchor.UUID;
+	SemanticClassifications = Anchor.SemanticClassifications;
+	Transform.SetComponents(FQuat(Anchor.Rotation), Anchor.Translation, Anchor.Scale);
+	PlaneBounds = Anchor.PlaneBounds;
+	PlaneBoundary2D = Anchor.PlaneBoundary2D;
+	VolumeBounds = Anchor.VolumeBounds;
+	NeedAnchorLocalization = false;
+}
+
 void UMRUKRoomData::LoadFromDevice(const FOculusXRAnchorsDiscoverResult& AnchorsDiscoverResult)
 {
 	SpaceQuery = AnchorsDiscoverResult;
@@ -163,6 +174,24 @@ void UMRUKRoomData::LoadFromJson(const FJsonValue& Value)
 	FinishQuery(true);
 }
 
+void UMRUKRoomData::LoadFromSnapshot(const FMRUKSnapshotRoom& Room)
+{
+	SpaceQuery.UUID = Room.UUID;
+	RoomLayout.FloorUuid = Room.FloorUuid;
+	RoomLayout.CeilingUuid = Room.CeilingUuid;
+	RoomLayout.WallsUuid = Room.WallsUuid;
+	AnchorsData.Reserve(Room.Anchors.Num());
+	RoomLayout.RoomObjectUUIDs.Reserve(Room.Anchors.Num());
+	for (const FMRUKSnapshotAnchor& Anchor : Room.Anchors)
+	{
+		auto AnchorQuery = NewObject<UMRUKAnchorData>(this);
+		AnchorsData.Push(AnchorQuery);
+		AnchorQuery->LoadFromSnapshot(Anchor);
+		RoomLayout.RoomObjectUUIDs.Add(AnchorQuery->SpaceQuery.UUID);
+	}
+	FinishQuery(true);
+}
+
 void UMRUKRoomData::FinishQuery(bool Success)
 {
 	OnComplete.Broadcast(Success);
@@ -288,6 +317,32 @@ void UMRUKSceneData::LoadFromJson(const FString& Json)
 	}
 }
 
+void UMRUKSceneData::LoadFromSnapshot(TConstArrayView<uint8> Snapshot)
+{
+	FMRUKSceneSnapshot Scene;
+	if (!MRUKReadSceneSnapshot(Snapshot, Scene))
+	{
+		FinishQuery(false);
+		return;
+	}
+
+	if (Scene.Rooms.IsEmpty())
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Could not find rooms in scene snapshot"));
+		FinishQuery(false);
+		return;
+	}
+	NumRoomsLeftToInitialize = Scene.Rooms.Num();
+	UE_LOG(LogMRUK, Log, TEXT("Found %d rooms in scene snapshot"), NumRoomsLeftToInitialize);
+	for (const FMRUKSnapshotRoom& Room : Scene.Rooms)
+	{
+		auto RoomQuery = NewObject<UMRUKRoomData>(this);
+		RoomsData.Push(RoomQuery);
+		RoomQuery->OnComplete.AddDynamic(this, &UMRUKSceneData::RoomQueryComplete);
+		RoomQuery->LoadFromSnapshot(Room);
+	}
+}
+
 void UMRUKSceneData::FinishQuery(bool Success)
 {
 	if (!Success)
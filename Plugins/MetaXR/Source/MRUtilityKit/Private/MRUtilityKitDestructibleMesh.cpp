@@ -7,8 +7,12 @@
 #include "MRUtilityKitSubsystem.h"
 #include "MRUtilityKitAnchor.h"
 #include "MRUtilityKitRoom.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
 #include "Tasks/Task.h"
 
+DECLARE_CYCLE_STAT(TEXT("MRUK Spawn Destructible Mesh Segments"), STAT_MRUKSpawnDestructibleMeshSegments, STATGROUP_Game);
+
 constexpr const char* RESERVED_MESH_SEGMENT_TAG = "ReservedMeshSegment";
 
 UMRUKDestructibleMeshComponent::UMRUKDestructibleMeshComponent(const FObjectInitializer& ObjectInitializer)
@@ -19,15 +23,23 @@ UMRUKDestructibleMeshComponent::UMRUKDestructibleMeshComponent(const FObjectInit
 
 void UMRUKDestructibleMeshComponent::SegmentMesh(const TArray<FVector>& MeshPositions, const TArray<uint32>& MeshIndices, const TArray<FVector>& SegmentationPoints)
 {
+	PendingSegments.Empty();
 	TaskResult = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, MeshPositions, MeshIndices, SegmentationPoints]() {
-		TArray<FMRUKMeshSegment> Segments;
-		FMRUKMeshSegment ReservedMeshSegment;
+		FSegmentationResult Result;
 
 		const FVector ReservedMin(ReservedTop, -1.0, -1.0);
 		const FVector ReservedMax(ReservedBottom, -1.0, -1.0);
 
-		UMRUKBPLibrary::CreateMeshSegmentation(MeshPositions, MeshIndices, SegmentationPoints, ReservedMin, ReservedMax, Segments, ReservedMeshSegment);
-		return TPair<TArray<FMRUKMeshSegment>, FMRUKMeshSegment>{ MoveTemp(Segments), MoveTemp(ReservedMeshSegment) };
+		UMRUKBPLibrary::CreateMeshSegmentation(MeshPositions, MeshIndices, SegmentationPoints, ReservedMin, ReservedMax, Result.Segments, Result.ReservedSegment);
+
+		// Compute the centers here already so that prioritizing the segments doesn't need to touch the vertices on the game thread
+		Result.Centers.Reserve(Result.Segments.Num() + 1);
+		for (const FMRUKMeshSegment& Segment : Result.Segments)
+		{
+			Result.Centers.Add(FBox(Segment.Positions).GetCenter());
+		}
+		Result.Centers.Add(FBox(Result.ReservedSegment.Positions).GetCenter());
+		return Result;
 	});
 	SetComponentTickEnabled(true);
 }
@@ -42,47 +54,112 @@ void UMRUKDestructibleMeshComponent::TickComponent(float DeltaTime, ELevelTick T
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (!TaskResult.IsCompleted())
+	if (TaskResult.IsValid())
+	{
+		if (!TaskResult.IsCompleted())
+		{
+			return;
+		}
+		StartSpawningSegments(MoveTemp(TaskResult.GetResult()));
+		TaskResult = {};
+	}
+
+	if (!SpawnPendingSegments(SpawnBudgetMs))
 	{
 		return;
 	}
 
-	const auto& [MeshSegments, ReservedMeshSegment] = TaskResult.GetResult();
+	// Keep the positions of the segments around no longer than needed
+	Segmentation = {};
+	SetComponentTickEnabled(false);
 
-	for (int32 i = 0; i < MeshSegments.Num(); ++i)
+	OnMeshesGenerated.Broadcast();
+}
+
+void UMRUKDestructibleMeshComponent::StartSpawningSegments(FSegmentationResult&& Result)
+{
+	Segmentation = MoveTemp(Result);
+	SpawnStats = {};
+
+	// Without a viewer the segments get spawned in order, the reserved segment last
+	PendingSegments.Reset();
+	if (Segmentation.ReservedSegment.Indices.Num() > 0)
 	{
-		const auto& [Positions, Indices] = MeshSegments[i];
-		const FString ProcMeshName = FString::Printf(TEXT("DestructibleMeshSegment%d"), i);
-		const auto ProcMesh = NewObject<UProceduralMeshComponent>(GetOwner(), *ProcMeshName);
-		const FAttachmentTransformRules TransformRules{ EAttachmentRule::KeepRelative, false };
-		ProcMesh->AttachToComponent(GetOwner()->GetRootComponent(), TransformRules);
-		ProcMesh->RegisterComponent();
-		ProcMesh->ComponentTags.AddUnique(TEXT("DestructibleMeshSegment"));
-		GetOwner()->AddInstanceComponent(ProcMesh);
-		ProcMesh->CreateMeshSection(0, Positions, Indices, {}, {}, {}, {}, true);
-		if (GlobalMeshMaterial)
-		{
-			ProcMesh->SetMaterial(0, GlobalMeshMaterial);
-		}
+		PendingSegments.Add(Segmentation.Segments.Num());
 	}
-	if (ReservedMeshSegment.Indices.Num() > 0)
+	for (int32 i = Segmentation.Segments.Num() - 1; i >= 0; --i)
 	{
-		const auto ProcMesh = NewObject<UProceduralMeshComponent>(GetOwner(), TEXT("ReservedMeshSegment"));
-		const FAttachmentTransformRules TransformRules{ EAttachmentRule::KeepRelative, false };
-		ProcMesh->AttachToComponent(GetOwner()->GetRootComponent(), TransformRules);
-		ProcMesh->RegisterComponent();
-		ProcMesh->ComponentTags.AddUnique(RESERVED_MESH_SEGMENT_TAG);
-		GetOwner()->AddInstanceComponent(ProcMesh);
-		ProcMesh->CreateMeshSection(0, ReservedMeshSegment.Positions, ReservedMeshSegment.Indices, {}, {}, {}, {}, true);
-		if (GlobalMeshMaterial)
+		PendingSegments.Add(i);
+	}
+}
+
+bool UMRUKDestructibleMeshComponent::SpawnPendingSegments(float BudgetMs)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MRUKSpawnDestructibleMeshSegments);
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + BudgetMs / 1000.0;
+
+	if (BudgetMs > 0.0f)
+	{
+		SortPendingSegmentsByViewerDistance();
+	}
+
+	int32 NumSpawned = 0;
+	while (!PendingSegments.IsEmpty())
+	{
+		SpawnSegment(PendingSegments.Pop(EAllowShrinking::No));
+		++NumSpawned;
+		if (BudgetMs > 0.0f && FPlatformTime::Seconds() >= EndTime)
 		{
-			ProcMesh->SetMaterial(0, GlobalMeshMaterial);
+			break;
 		}
 	}
 
-	SetComponentTickEnabled(false);
+	const float SpawnTimeMs = static_cast<float>((FPlatformTime::Seconds() - StartTime) * 1000.0);
+	SpawnStats.SegmentsSpawnedLastFrame = NumSpawned;
+	SpawnStats.SpawnTimeLastFrameMs = SpawnTimeMs;
+	SpawnStats.MaxSpawnTimePerFrameMs = FMath::Max(SpawnStats.MaxSpawnTimePerFrameMs, SpawnTimeMs);
+	SpawnStats.SegmentsSpawned += NumSpawned;
+	SpawnStats.SegmentsPending = PendingSegments.Num();
+	++SpawnStats.Frames;
+	UE_LOG(LogMRUK, Verbose, TEXT("Spawned %d destructible mesh segments in %.2f ms, %d pending"), NumSpawned, SpawnTimeMs, PendingSegments.Num());
 
-	OnMeshesGenerated.Broadcast();
+	return PendingSegments.IsEmpty();
+}
+
+void UMRUKDestructibleMeshComponent::SpawnSegment(int32 Index)
+{
+	const bool bIsReserved = Index == Segmentation.Segments.Num();
+	const auto& [Positions, Indices] = bIsReserved ? Segmentation.ReservedSegment : Segmentation.Segments[Index];
+	const FString ProcMeshName = bIsReserved ? FString(TEXT("ReservedMeshSegment")) : FString::Printf(TEXT("DestructibleMeshSegment%d"), Index);
+	const auto ProcMesh = NewObject<UProceduralMeshComponent>(GetOwner(), *ProcMeshName);
+	const FAttachmentTransformRules TransformRules{ EAttachmentRule::KeepRelative, false };
+	ProcMesh->AttachToComponent(GetOwner()->GetRootComponent(), TransformRules);
+	ProcMesh->RegisterComponent();
+	ProcMesh->ComponentTags.AddUnique(bIsReserved ? FName(RESERVED_MESH_SEGMENT_TAG) : FName(TEXT("DestructibleMeshSegment")));
+	GetOwner()->AddInstanceComponent(ProcMesh);
+	ProcMesh->bUseAsyncCooking = bUseAsyncCollisionCooking;
+	ProcMesh->CreateMeshSection(0, Positions, Indices, {}, {}, {}, {}, true);
+	if (GlobalMeshMaterial)
+	{
+		ProcMesh->SetMaterial(0, GlobalMeshMaterial);
+	}
+}
+
+void UMRUKDestructibleMeshComponent::SortPendingSegmentsByViewerDistance()
+{
+	const APlayerController* PlayerController = GetWorld() ? GetWorld()->GetFirstPlayerController() : nullptr;
+	if (!PlayerController || !PlayerController->PlayerCameraManager || PendingSegments.Num() < 2)
+	{
+		return;
+	}
+	// Segments are attached to the root component of the owner, bring the viewer into that space
+	const FVector ViewerLocation = GetOwner()->GetRootComponent()->GetComponentTransform().InverseTransformPosition(PlayerController->PlayerCameraManager->GetCameraLocation());
+	const TArray<FVector>& Centers = Segmentation.Centers;
+	PendingSegments.Sort([&Centers, &ViewerLocation](int32 A, int32 B) {
+		return FVector::DistSquared(Centers[A], ViewerLocation) > FVector::DistSquared(Centers[B], ViewerLocation);
+	});
 }
 
 AMRUKDestructibleGlobalMesh::AMRUKDestructibleGlobalMesh()
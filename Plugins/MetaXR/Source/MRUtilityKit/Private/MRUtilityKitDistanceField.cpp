@@ -0,0 +1,390 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitDistanceField.h"
+#include "MRUtilityKit.h"
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitRoom.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	// Number of columns or rows that are processed by a single task
+	constexpr int32 DistanceFieldBlockSize = 64;
+
+	struct FDistanceFieldPolygon
+	{
+		TArray<FVector2D> Points;
+		double MinY;
+		double MaxY;
+		bool bFree;
+	};
+
+	FDistanceFieldPolygon MakeDistanceFieldPolygon(TArray<FVector2D>&& Points, bool bFree)
+	{
+		FDistanceFieldPolygon Polygon{ MoveTemp(Points), UE_BIG_NUMBER, -UE_BIG_NUMBER, bFree };
+		for (const FVector2D& Point : Polygon.Points)
+		{
+			Polygon.MinY = FMath::Min(Polygon.MinY, Point.Y);
+			Polygon.MaxY = FMath::Max(Polygon.MaxY, Point.Y);
+		}
+		return Polygon;
+	}
+
+	// Andrew's monotone chain. The footprint of a box can have up to 6 corners, depending on its orientation.
+	TArray<FVector2D> ConvexHull2D(TArray<FVector2D> Points)
+	{
+		Points.Sort([](const FVector2D& A, const FVector2D& B) { return A.X < B.X || (A.X == B.X && A.Y < B.Y); });
+
+		TArray<FVector2D> Hull;
+		Hull.SetNumUninitialized(2 * Points.Num());
+		int32 K = 0;
+		for (int32 I = 0; I < Points.Num(); ++I)
+		{
+			while (K >= 2 && FVector2D::CrossProduct(Hull[K - 1] - Hull[K - 2], Points[I] - Hull[K - 2]) <= 0.0)
+			{
+				--K;
+			}
+			Hull[K++] = Points[I];
+		}
+		for (int32 I = Points.Num() - 2, T = K + 1; I >= 0; --I)
+		{
+			while (K >= T && FVector2D::CrossProduct(Hull[K - 1] - Hull[K - 2], Points[I] - Hull[K - 2]) <= 0.0)
+			{
+				--K;
+			}
+			Hull[K++] = Points[I];
+		}
+		Hull.SetNum(FMath::Max(K - 1, 0));
+		return Hull;
+	}
+
+	// Exact 1D squared distance transform of a sampled function (Felzenszwalb & Huttenlocher).
+	// Values is transformed in place. F, V and Z are scratch buffers of size N, N and N + 1.
+	void DistanceTransform1D(float* Values, int32 N, float* F, int32* V, double* Z)
+	{
+		for (int32 Q = 0; Q < N; ++Q)
+		{
+			F[Q] = Values[Q];
+		}
+
+		int32 K = 0;
+		V[0] = 0;
+		Z[0] = -UE_BIG_NUMBER;
+		Z[1] = UE_BIG_NUMBER;
+		const auto Intersect = [F](int32 Q, int32 P) {
+			return ((static_cast<double>(F[Q]) + static_cast<double>(Q) * Q) - (static_cast<double>(F[P]) + static_cast<double>(P) * P)) / (2.0 * (Q - P));
+		};
+		for (int32 Q = 1; Q < N; ++Q)
+		{
+			double S = Intersect(Q, V[K]);
+			while (S <= Z[K])
+			{
+				--K;
+				S = Intersect(Q, V[K]);
+			}
+			++K;
+			V[K] = Q;
+			Z[K] = S;
+			Z[K + 1] = UE_BIG_NUMBER;
+		}
+
+		K = 0;
+		for (int32 Q = 0; Q < N; ++Q)
+		{
+			while (Z[K + 1] < Q)
+			{
+				++K;
+			}
+			const float Delta = static_cast<float>(Q - V[K]);
+			Values[Q] = Delta * Delta + F[V[K]];
+		}
+	}
+
+	// Distance to the closest seed along each column. Seed texels hold 0 and all others Infinity.
+	// Rows are swept top down and bottom up so that the inner loop runs over adjacent columns which vectorizes well.
+	void ColumnDistancePass(float* Values, int32 N, int32 X0, int32 X1)
+	{
+		const VectorRegister4Float One = VectorSetFloat1(1.0f);
+		const int32 VectorEnd = X0 + ((X1 - X0) & ~3);
+
+		for (int32 Y = 1; Y < N; ++Y)
+		{
+			float* Row = Values + Y * N;
+			const float* Prev = Row - N;
+			int32 X = X0;
+			for (; X < VectorEnd; X += 4)
+			{
+				VectorStore(VectorMin(VectorLoad(Row + X), VectorAdd(VectorLoad(Prev + X), One)), Row + X);
+			}
+			for (; X < X1; ++X)
+			{
+				Row[X] = FMath::Min(Row[X], Prev[X] + 1.0f);
+			}
+		}
+		for (int32 Y = N - 2; Y >= 0; --Y)
+		{
+			float* Row = Values + Y * N;
+			const float* Next = Row + N;
+			int32 X = X0;
+			for (; X < VectorEnd; X += 4)
+			{
+				VectorStore(VectorMin(VectorLoad(Row + X), VectorAdd(VectorLoad(Next + X), One)), Row + X);
+			}
+			for (; X < X1; ++X)
+			{
+				Row[X] = FMath::Min(Row[X], Next[X] + 1.0f);
+			}
+		}
+		for (int32 Y = 0; Y < N; ++Y)
+		{
+			float* Row = Values + Y * N;
+			int32 X = X0;
+			for (; X < VectorEnd; X += 4)
+			{
+				const VectorRegister4Float D = VectorLoad(Row + X);
+				VectorStore(VectorMultiply(D, D), Row + X);
+			}
+			for (; X < X1; ++X)
+			{
+				Row[X] *= Row[X];
+			}
+		}
+	}
+
+	// Squared euclidean distance transform of a square grid where seed texels hold 0 and all others Infinity.
+	void SquaredDistanceTransform2D(TArray<float>& Values, int32 N)
+	{
+		const int32 NumBlocks = FMath::DivideAndRoundUp(N, DistanceFieldBlockSize);
+
+		ParallelFor(NumBlocks, [&Values, N](int32 Block) {
+			const int32 X0 = Block * DistanceFieldBlockSize;
+			ColumnDistancePass(Values.GetData(), N, X0, FMath::Min(X0 + DistanceFieldBlockSize, N));
+		});
+
+		ParallelFor(NumBlocks, [&Values, N](int32 Block) {
+			TArray<float> F;
+			TArray<int32> V;
+			TArray<double> Z;
+			F.SetNumUninitialized(N);
+			V.SetNumUninitialized(N);
+			Z.SetNumUninitialized(N + 1);
+
+			const int32 Y0 = Block * DistanceFieldBlockSize;
+			const int32 Y1 = FMath::Min(Y0 + DistanceFieldBlockSize, N);
+			for (int32 Y = Y0; Y < Y1; ++Y)
+			{
+				DistanceTransform1D(Values.GetData() + Y * N, N, F.GetData(), V.GetData(), Z.GetData());
+			}
+		});
+	}
+} // namespace
+
+void FMRUKDistanceField::Build(TConstArrayView<const AMRUKRoom*> Rooms, const FTransform& InCaptureView, double InWidth, int32 InResolution)
+{
+	Reset();
+
+	if (InResolution <= 0 || InWidth <= 0.0)
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Can not build a distance field with a resolution of %d and a width of %f"), InResolution, InWidth);
+		return;
+	}
+
+	CaptureView = InCaptureView;
+	CaptureView.RemoveScaling();
+	Width = InWidth;
+	Resolution = InResolution;
+	TexelSize = Width / Resolution;
+
+	const int32 NumTexels = Resolution * Resolution;
+
+	// 1 for free space, 0 for occupied space
+	TArray<float> Free;
+	Rasterize(Rooms, Free);
+
+	// Seed the distance transforms. One computes the distance of each texel to the closest free texel,
+	// the other the distance to the closest occupied texel.
+	const float Infinity = 2.0f * Resolution;
+	TArray<float> ToFree;
+	TArray<float> ToOccupied;
+	ToFree.SetNumUninitialized(NumTexels);
+	ToOccupied.SetNumUninitialized(NumTexels);
+	{
+		const VectorRegister4Float One = VectorSetFloat1(1.0f);
+		const VectorRegister4Float Inf = VectorSetFloat1(Infinity);
+		int32 I = 0;
+		for (; I + 4 <= NumTexels; I += 4)
+		{
+			const VectorRegister4Float F = VectorLoad(Free.GetData() + I);
+			VectorStore(VectorMultiply(VectorSubtract(One, F), Inf), ToFree.GetData() + I);
+			VectorStore(VectorMultiply(F, Inf), ToOccupied.GetData() + I);
+		}
+		for (; I < NumTexels; ++I)
+		{
+			ToFree[I] = (1.0f - Free[I]) * Infinity;
+			ToOccupied[I] = Free[I] * Infinity;
+		}
+	}
+
+	SquaredDistanceTransform2D(ToFree, Resolution);
+	SquaredDistanceTransform2D(ToOccupied, Resolution);
+
+	// Every texel is either free or occupied, so one of the two distances is always 0 and the signed distance is
+	// simply their difference.
+	Distances.SetNumUninitialized(NumTexels);
+	{
+		const VectorRegister4Float Scale = VectorSetFloat1(static_cast<float>(TexelSize));
+		int32 I = 0;
+		for (; I + 4 <= NumTexels; I += 4)
+		{
+			const VectorRegister4Float Inside = VectorSqrt(VectorLoad(ToOccupied.GetData() + I));
+			const VectorRegister4Float Outside = VectorSqrt(VectorLoad(ToFree.GetData() + I));
+			VectorStore(VectorMultiply(VectorSubtract(Inside, Outside), Scale), Distances.GetData() + I);
+		}
+		for (; I < NumTexels; ++I)
+		{
+			Distances[I] = (FMath::Sqrt(ToOccupied[I]) - FMath::Sqrt(ToFree[I])) * static_cast<float>(TexelSize);
+		}
+	}
+}
+
+void FMRUKDistanceField::Reset()
+{
+	Distances.Empty();
+	CaptureView = FTransform::Identity;
+	Width = 0.0;
+	TexelSize = 0.0;
+	Resolution = 0;
+}
+
+void FMRUKDistanceField::Rasterize(TConstArrayView<const AMRUKRoom*> Rooms, TArray<float>& OutFree) const
+{
+	// Collect the same geometry that AMRUKDistanceMapGenerator::CreateMaskMeshesForRoom() renders into the mask.
+	// Floors are free space and volumes are occupied space. Volumes are drawn on top of the floors.
+
+	TArray<FDistanceFieldPolygon> Polygons;
+	for (const AMRUKRoom* Room : Rooms)
+	{
+		if (!Room)
+		{
+			continue;
+		}
+
+		if (const AMRUKAnchor* Floor = Room->FloorAnchor; Floor && Floor->PlaneBounds.bIsValid && !Floor->VolumeBounds.IsValid)
+		{
+			const FTransform& FloorTransform = Floor->GetActorTransform();
+			TArray<FVector2D> Points;
+			Points.Reserve(Floor->PlaneBoundary2D.Num());
+			for (const FVector2D& Point : Floor->PlaneBoundary2D)
+			{
+				Points.Push(WorldToTexel(FloorTransform.TransformPosition(FVector(0.0, Point.X, Point.Y))));
+			}
+			Polygons.Push(MakeDistanceFieldPolygon(MoveTemp(Points), true));
+		}
+	}
+	for (const AMRUKRoom* Room : Rooms)
+	{
+		if (!Room)
+		{
+			continue;
+		}
+
+		for (const AMRUKAnchor* Anchor : Room->AllAnchors)
+		{
+			if (!Anchor || !Anchor->VolumeBounds.IsValid)
+			{
+				continue;
+			}
+
+			const FTransform& AnchorTransform = Anchor->GetActorTransform();
+			FVector Corners[8];
+			Anchor->VolumeBounds.GetVertices(Corners);
+			TArray<FVector2D> Points;
+			Points.Reserve(8);
+			for (const FVector& Corner : Corners)
+			{
+				Points.Push(WorldToTexel(AnchorTransform.TransformPosition(Corner)));
+			}
+			Polygons.Push(MakeDistanceFieldPolygon(ConvexHull2D(MoveTemp(Points)), false));
+		}
+	}
+
+	OutFree.SetNumZeroed(Resolution * Resolution);
+
+	// Scanline fill with the even-odd rule. Texels are filled if their center lies inside the polygon.
+	ParallelFor(Resolution, [this, &Polygons, &OutFree](int32 Y) {
+		const double CenterY = Y + 0.5;
+		float* Row = OutFree.GetData() + Y * Resolution;
+		TArray<double, TInlineAllocator<16>> Crossings;
+		for (const FDistanceFieldPolygon& Polygon : Polygons)
+		{
+			if (CenterY < Polygon.MinY || CenterY > Polygon.MaxY)
+			{
+				continue;
+			}
+
+			Crossings.Reset();
+			const int32 NumPoints = Polygon.Points.Num();
+			for (int32 I = 0, J = NumPoints - 1; I < NumPoints; J = I++)
+			{
+				const FVector2D& A = Polygon.Points[J];
+				const FVector2D& B = Polygon.Points[I];
+				if ((A.Y <= CenterY) != (B.Y <= CenterY))
+				{
+					Crossings.Push(A.X + (CenterY - A.Y) * (B.X - A.X) / (B.Y - A.Y));
+				}
+			}
+			Crossings.Sort();
+
+			const float Value = Polygon.bFree ? 1.0f : 0.0f;
+			for (int32 I = 0; I + 1 < Crossings.Num(); I += 2)
+			{
+				const int32 X0 = FMath::Max(FMath::CeilToInt32(Crossings[I] - 0.5), 0);
+				const int32 X1 = FMath::Min(FMath::CeilToInt32(Crossings[I + 1] - 0.5), Resolution);
+				for (int32 X = X0; X < X1; ++X)
+				{
+					Row[X] = Value;
+				}
+			}
+		}
+	});
+}
+
+float FMRUKDistanceField::SampleDistance(const FVector& WorldPosition) const
+{
+	if (!IsValid())
+	{
+		return 0.0f;
+	}
+
+	const FVector2D Texel = WorldToTexel(WorldPosition) - FVector2D(0.5, 0.5);
+	const double X = FMath::Clamp(Texel.X, 0.0, static_cast<double>(Resolution - 1));
+	const double Y = FMath::Clamp(Texel.Y, 0.0, static_cast<double>(Resolution - 1));
+	const int32 X0 = FMath::Min(FMath::FloorToInt32(X), Resolution - 2);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt32(Y), Resolution - 2);
+	if (X0 < 0 || Y0 < 0)
+	{
+		// Resolution of 1
+		return Distances[0];
+	}
+	const float Alpha = static_cast<float>(X - X0);
+	const float Beta = static_cast<float>(Y - Y0);
+
+	const float Top = FMath::Lerp(GetDistanceAtTexel(X0, Y0), GetDistanceAtTexel(X0 + 1, Y0), Alpha);
+	const float Bottom = FMath::Lerp(GetDistanceAtTexel(X0, Y0 + 1), GetDistanceAtTexel(X0 + 1, Y0 + 1), Alpha);
+	return FMath::Lerp(Top, Bottom, Beta);
+}
+
+FVector2D FMRUKDistanceField::WorldToTexel(const FVector& WorldPosition) const
+{
+	// Same projection as an orthographic camera: Y maps to the right and Z to the top of the image
+	const FVector Local = CaptureView.InverseTransformPositionNoScale(WorldPosition);
+	return FVector2D((Local.Y / Width + 0.5) * Resolution, (0.5 - Local.Z / Width) * Resolution);
+}
+
+FVector FMRUKDistanceField::TexelToWorld(int32 X, int32 Y) const
+{
+	const double LocalY = ((X + 0.5) / Resolution - 0.5) * Width;
+	const double LocalZ = (0.5 - (Y + 0.5) / Resolution) * Width;
+	return CaptureView.TransformPositionNoScale(FVector(0.0, LocalY, LocalZ));
+}
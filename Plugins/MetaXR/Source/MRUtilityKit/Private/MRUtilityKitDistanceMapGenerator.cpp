@@ -9,10 +9,12 @@
 #include "Engine/CanvasRenderTarget2D.h"
 #include "Engine/Canvas.h"
 #include "Engine/GameInstance.h"
+#include "Engine/Texture2D.h"
 #include "Engine/World.h"
 #include "Kismet/KismetRenderingLibrary.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Materials/MaterialInterface.h"
+#include "Misc/App.h"
 #include "UObject/ConstructorHelpers.h"
 
 AMRUKDistanceMapGenerator::AMRUKDistanceMapGenerator()
@@ -400,6 +402,96 @@ UCanvasRenderTarget2D* AMRUKDistanceMapGenerator::GetDistanceMapRenderTarget() c
 	return RTs[DistanceMapRT];
 }
 
+void AMRUKDistanceMapGenerator::ComputeDistanceFieldCPU()
+{
+	TArray<const AMRUKRoom*> Rooms;
+	if (SpawnMode == EMRUKSpawnMode::CurrentRoomOnly)
+	{
+		const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+		if (const AMRUKRoom* CurrentRoom = Subsystem->GetCurrentRoom())
+		{
+			Rooms.Push(CurrentRoom);
+		}
+	}
+	else if (SpawnMode == EMRUKSpawnMode::AllRooms)
+	{
+		const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+		Rooms.Reserve(Subsystem->Rooms.Num());
+		for (const auto& Room : Subsystem->Rooms)
+		{
+			Rooms.Push(Room);
+		}
+	}
+	else
+	{
+		// Without a spawn mode the rooms are picked by calling CreateMaskMeshesForRoom()
+		Rooms.Reserve(SpawnedMaskMeshes.Num());
+		for (const auto& Pair : SpawnedMaskMeshes)
+		{
+			Rooms.Push(Pair.Key);
+		}
+	}
+
+	const int32 Resolution = SceneCapture2D->TextureTarget ? SceneCapture2D->TextureTarget->SizeX : DistanceFieldResolution;
+	DistanceField.Build(Rooms, SceneCapture2D->GetComponentTransform(), SceneCapture2D->OrthoWidth, Resolution);
+}
+
+float AMRUKDistanceMapGenerator::GetDistanceAtLocation(const FVector& WorldLocation) const
+{
+	if (!DistanceField.IsValid())
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Make sure to first compute the distance field by calling ComputeDistanceFieldCPU()"));
+		return 0.0f;
+	}
+	return DistanceField.SampleDistance(WorldLocation);
+}
+
+UTexture* AMRUKDistanceMapGenerator::UploadDistanceFieldToRenderTarget()
+{
+	if (!DistanceField.IsValid())
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Make sure to first compute the distance field by calling ComputeDistanceFieldCPU()"));
+		return nullptr;
+	}
+	if (!DistanceMapRenderTarget || !FApp::CanEverRender())
+	{
+		return nullptr;
+	}
+
+	const int32 Resolution = DistanceField.GetResolution();
+	if (!DistanceFieldTexture || DistanceFieldTexture->GetSizeX() != Resolution)
+	{
+		DistanceFieldTexture = UTexture2D::CreateTransient(Resolution, Resolution, PF_R32_FLOAT);
+		DistanceFieldTexture->SRGB = false;
+		DistanceFieldTexture->Filter = TF_Nearest;
+		DistanceFieldTexture->AddressX = TA_Clamp;
+		DistanceFieldTexture->AddressY = TA_Clamp;
+		DistanceFieldTexture->UpdateResource();
+	}
+
+	// The render thread reads the data later, so hand it a copy that it frees once the upload is done
+	const TArray<float>& Distances = DistanceField.GetDistances();
+	const SIZE_T NumBytes = Distances.Num() * sizeof(float);
+	uint8* Data = static_cast<uint8*>(FMemory::Malloc(NumBytes));
+	FMemory::Memcpy(Data, Distances.GetData(), NumBytes);
+	const FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, Resolution, Resolution);
+	DistanceFieldTexture->UpdateTextureRegions(0, 1, Region, Resolution * sizeof(float), sizeof(float), Data,
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions) {
+			FMemory::Free(SrcData);
+			delete Regions;
+		});
+
+	UKismetRenderingLibrary::ClearRenderTarget2D(GetWorld(), DistanceMapRenderTarget);
+	UCanvas* Canvas{};
+	FVector2D Size{};
+	FDrawToRenderTargetContext RenderTargetContext{};
+	UKismetRenderingLibrary::BeginDrawCanvasToRenderTarget(GetWorld(), DistanceMapRenderTarget, Canvas, Size, RenderTargetContext);
+	Canvas->K2_DrawTexture(DistanceFieldTexture, FVector2D::ZeroVector, Size, FVector2D::ZeroVector, FVector2D::UnitVector, FLinearColor::White, BLEND_Opaque);
+	UKismetRenderingLibrary::EndDrawCanvasToRenderTarget(GetWorld(), RenderTargetContext);
+
+	return DistanceMapRenderTarget;
+}
+
 FMinimalViewInfo AMRUKDistanceMapGenerator::GetSceneCaptureView() const
 {
 	FMinimalViewInfo Info = {};
@@ -5,38 +5,907 @@
 #include "MRUtilityKit.h"
 #include "Generated/MRUtilityKitShared.h"
 
-void MRUKTriangulatePolygon(const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices)
+DECLARE_CYCLE_STAT(TEXT("MRUK Triangulate Polygon Native"), STAT_MRUKTriangulatePolygonNative, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("MRUK Triangulate Polygon Shared"), STAT_MRUKTriangulatePolygonShared, STATGROUP_Game);
+
+namespace
 {
-	Vertices.Empty();
-	Indices.Empty();
+	/**
+	 * Ear clipping triangulator with support for holes. Holes are merged into the outline by cutting bridges from the
+	 * leftmost hole vertex to a visible outline vertex. Afterwards ears get clipped. For larger polygons the candidate
+	 * points for the ear test are looked up along a z-order curve to avoid the quadratic scan over all vertices.
+	 * When no more ears can be found, collinear points get removed, local self intersections get cured and as a last
+	 * resort the polygon gets split in two along a valid diagonal.
+	 *
+	 * The nodes of the doubly linked vertex list are stored in a flat array and reference each other by index so the
+	 * whole triangulation only allocates a single array that is sized up front.
+	 */
+	class FMRUKEarClipper
+	{
+	public:
+		void Triangulate(const TArray<TArray<FVector2f>>& Polygons, TArray<int32>& Indices)
+		{
+			int32 NumPoints = 0;
+			for (const auto& Polygon : Polygons)
+			{
+				NumPoints += Polygon.Num();
+			}
+			// Every bridge and every split adds two nodes
+			Nodes.Reset();
+			Nodes.Reserve(NumPoints + 4 * Polygons.Num() + 16);
+			Indices.Reserve(3 * (NumPoints + 2 * Polygons.Num()));
 
-	auto MRUKShared = MRUKShared::GetInstance();
-	if (!MRUKShared)
+			int32 OuterNode = LinkedList(Polygons[0], 0, true);
+			if (OuterNode == INDEX_NONE || Nodes[OuterNode].Next == Nodes[OuterNode].Prev)
+			{
+				return;
+			}
+
+			if (Polygons.Num() > 1)
+			{
+				OuterNode = EliminateHoles(Polygons, OuterNode);
+			}
+
+			// Use z-order curve hashing only for larger polygons, for small ones the overhead is not worth it
+			if (NumPoints > 80)
+			{
+				const FVector2f& First = Polygons[0][0];
+				MinX = First.X;
+				MinY = First.Y;
+				double MaxX = First.X;
+				double MaxY = First.Y;
+				for (const auto& Point : Polygons[0])
+				{
+					MinX = FMath::Min<double>(MinX, Point.X);
+					MinY = FMath::Min<double>(MinY, Point.Y);
+					MaxX = FMath::Max<double>(MaxX, Point.X);
+					MaxY = FMath::Max<double>(MaxY, Point.Y);
+				}
+				InvSize = FMath::Max(MaxX - MinX, MaxY - MinY);
+				InvSize = InvSize != 0.0 ? 32767.0 / InvSize : 0.0;
+			}
+			else
+			{
+				InvSize = 0.0;
+			}
+
+			EarcutLinked(OuterNode, Indices, 0);
+		}
+
+	private:
+		struct FNode
+		{
+			FNode(int32 InVertex, double InX, double InY)
+				: Vertex(InVertex), X(InX), Y(InY) {}
+
+			int32 Vertex;
+			double X;
+			double Y;
+			int32 Prev = INDEX_NONE;
+			int32 Next = INDEX_NONE;
+			int32 Z = 0;
+			int32 PrevZ = INDEX_NONE;
+			int32 NextZ = INDEX_NONE;
+			bool bSteiner = false;
+		};
+
+		TArray<FNode> Nodes;
+		double MinX = 0.0;
+		double MinY = 0.0;
+		double InvSize = 0.0;
+
+		FNode& N(int32 Index) { return Nodes[Index]; }
+
+		int32 InsertNode(int32 Vertex, const FVector2f& Point, int32 Last)
+		{
+			const int32 P = Nodes.Emplace(Vertex, Point.X, Point.Y);
+			if (Last == INDEX_NONE)
+			{
+				N(P).Prev = P;
+				N(P).Next = P;
+			}
+			else
+			{
+				N(P).Next = N(Last).Next;
+				N(P).Prev = Last;
+				N(N(Last).Next).Prev = P;
+				N(Last).Next = P;
+			}
+			return P;
+		}
+
+		void RemoveNode(int32 P)
+		{
+			FNode& Node = N(P);
+			N(Node.Next).Prev = Node.Prev;
+			N(Node.Prev).Next = Node.Next;
+			if (Node.PrevZ != INDEX_NONE)
+			{
+				N(Node.PrevZ).NextZ = Node.NextZ;
+			}
+			if (Node.NextZ != INDEX_NONE)
+			{
+				N(Node.NextZ).PrevZ = Node.PrevZ;
+			}
+		}
+
+		static double SignedArea(const TArray<FVector2f>& Polygon)
+		{
+			double Sum = 0.0;
+			for (int32 I = 0, J = Polygon.Num() - 1; I < Polygon.Num(); J = I++)
+			{
+				Sum += (static_cast<double>(Polygon[J].X) - Polygon[I].X) * (static_cast<double>(Polygon[I].Y) + Polygon[J].Y);
+			}
+			return Sum;
+		}
+
+		// Create a circular doubly linked list from the polygon points in the specified winding order
+		int32 LinkedList(const TArray<FVector2f>& Polygon, int32 FirstVertex, bool bClockwise)
+		{
+			int32 Last = INDEX_NONE;
+			if (bClockwise == (SignedArea(Polygon) > 0.0))
+			{
+				for (int32 I = 0; I < Polygon.Num(); ++I)
+				{
+					Last = InsertNode(FirstVertex + I, Polygon[I], Last);
+				}
+			}
+			else
+			{
+				for (int32 I = Polygon.Num() - 1; I >= 0; --I)
+				{
+					Last = InsertNode(FirstVertex + I, Polygon[I], Last);
+				}
+			}
+
+			if (Last != INDEX_NONE && Equals(Last, N(Last).Next))
+			{
+				RemoveNode(Last);
+				Last = N(Last).Next;
+			}
+			return Last;
+		}
+
+		// Signed area of a triangle
+		double Area(int32 P, int32 Q, int32 R)
+		{
+			const FNode& A = N(P);
+			const FNode& B = N(Q);
+			const FNode& C = N(R);
+			return (B.Y - A.Y) * (C.X - B.X) - (B.X - A.X) * (C.Y - B.Y);
+		}
+
+		bool Equals(int32 P1, int32 P2)
+		{
+			return N(P1).X == N(P2).X && N(P1).Y == N(P2).Y;
+		}
+
+		static bool PointInTriangle(double Ax, double Ay, double Bx, double By, double Cx, double Cy, double Px, double Py)
+		{
+			return (Cx - Px) * (Ay - Py) >= (Ax - Px) * (Cy - Py) && (Ax - Px) * (By - Py) >= (Bx - Px) * (Ay - Py) && (Bx - Px) * (Cy - Py) >= (Cx - Px) * (By - Py);
+		}
+
+		// Eliminate colinear or duplicate points
+		int32 FilterPoints(int32 Start, int32 End = INDEX_NONE)
+		{
+			if (Start == INDEX_NONE)
+			{
+				return Start;
+			}
+			if (End == INDEX_NONE)
+			{
+				End = Start;
+			}
+
+			int32 P = Start;
+			bool bAgain;
+			do
+			{
+				bAgain = false;
+				if (!N(P).bSteiner && (Equals(P, N(P).Next) || Area(N(P).Prev, P, N(P).Next) == 0.0))
+				{
+					RemoveNode(P);
+					P = End = N(P).Prev;
+					if (P == N(P).Next)
+					{
+						break;
+					}
+					bAgain = true;
+				}
+				else
+				{
+					P = N(P).Next;
+				}
+			}
+			while (bAgain || P != End);
+
+			return End;
+		}
+
+		void EmitTriangle(TArray<int32>& Indices, int32 A, int32 B, int32 C)
+		{
+			Indices.Add(N(A).Vertex);
+			Indices.Add(N(B).Vertex);
+			Indices.Add(N(C).Vertex);
+		}
+
+		// Main ear slicing loop which triangulates a polygon (given as a linked list)
+		void EarcutLinked(int32 Ear, TArray<int32>& Indices, int32 Pass)
+		{
+			if (Ear == INDEX_NONE)
+			{
+				return;
+			}
+
+			if (Pass == 0 && InvSize != 0.0)
+			{
+				IndexCurve(Ear);
+			}
+
+			int32 Stop = Ear;
+			while (N(Ear).Prev != N(Ear).Next)
+			{
+				const int32 Prev = N(Ear).Prev;
+				const int32 Next = N(Ear).Next;
+
+				if (InvSize != 0.0 ? IsEarHashed(Ear) : IsEar(Ear))
+				{
+					EmitTriangle(Indices, Prev, Ear, Next);
+					RemoveNode(Ear);
+
+					// Skipping the next vertex leads to less sliver triangles
+					Ear = N(Next).Next;
+					Stop = N(Next).Next;
+					continue;
+				}
+
+				Ear = Next;
+
+				// If we looped through the whole remaining polygon and can't find any more ears
+				if (Ear == Stop)
+				{
+					if (Pass == 0)
+					{
+						// Try filtering points and slicing again
+						EarcutLinked(FilterPoints(Ear), Indices, 1);
+					}
+					else if (Pass == 1)
+					{
+						// If this didn't work, try curing all small self-intersections locally
+						Ear = CureLocalIntersections(FilterPoints(Ear), Indices);
+						EarcutLinked(Ear, Indices, 2);
+					}
+					else if (Pass == 2)
+					{
+						// As a last resort, try splitting the remaining polygon into two
+						SplitEarcut(Ear, Indices);
+					}
+					break;
+				}
+			}
+		}
+
+		// Check whether a polygon node forms a valid ear with adjacent nodes
+		bool IsEar(int32 Ear)
+		{
+			const int32 A = N(Ear).Prev;
+			const int32 B = Ear;
+			const int32 C = N(Ear).Next;
+
+			if (Area(A, B, C) >= 0.0)
+			{
+				// Reflex, can't be an ear
+				return false;
+			}
+
+			const double Ax = N(A).X, Bx = N(B).X, Cx = N(C).X;
+			const double Ay = N(A).Y, By = N(B).Y, Cy = N(C).Y;
+			const double X0 = FMath::Min3(Ax, Bx, Cx), Y0 = FMath::Min3(Ay, By, Cy);
+			const double X1 = FMath::Max3(Ax, Bx, Cx), Y1 = FMath::Max3(Ay, By, Cy);
+
+			// Now make sure we don't have other points inside the potential ear
+			int32 P = N(C).Next;
+			while (P != A)
+			{
+				const FNode& Node = N(P);
+				if (Node.X >= X0 && Node.X <= X1 && Node.Y >= Y0 && Node.Y <= Y1 && PointInTriangle(Ax, Ay, Bx, By, Cx, Cy, Node.X, Node.Y) && Area(Node.Prev, P, Node.Next) >= 0.0)
+				{
+					return false;
+				}
+				P = Node.Next;
+			}
+			return true;
+		}
+
+		bool IsEarHashed(int32 Ear)
+		{
+			const int32 A = N(Ear).Prev;
+			const int32 B = Ear;
+			const int32 C = N(Ear).Next;
+
+			if (Area(A, B, C) >= 0.0)
+			{
+				return false;
+			}
+
+			const double Ax = N(A).X, Bx = N(B).X, Cx = N(C).X;
+			const double Ay = N(A).Y, By = N(B).Y, Cy = N(C).Y;
+			const double X0 = FMath::Min3(Ax, Bx, Cx), Y0 = FMath::Min3(Ay, By, Cy);
+			const double X1 = FMath::Max3(Ax, Bx, Cx), Y1 = FMath::Max3(Ay, By, Cy);
+
+			// Z-order range for the current triangle bbox
+			const int32 MinZ = ZOrder(X0, Y0);
+			const int32 MaxZ = ZOrder(X1, Y1);
+
+			const auto Blocks = [&](int32 P) {
+				const FNode& Node = N(P);
+				return Node.X >= X0 && Node.X <= X1 && Node.Y >= Y0 && Node.Y <= Y1 && P != A && P != C && PointInTriangle(Ax, Ay, Bx, By, Cx, Cy, Node.X, Node.Y) && Area(Node.Prev, P, Node.Next) >= 0.0;
+			};
+
+			int32 P = N(Ear).PrevZ;
+			int32 Q = N(Ear).NextZ;
+
+			// Look for points inside the triangle in both directions
+			while (P != INDEX_NONE && N(P).Z >= MinZ && Q != INDEX_NONE && N(Q).Z <= MaxZ)
+			{
+				if (Blocks(P))
+				{
+					return false;
+				}
+				P = N(P).PrevZ;
+				if (Blocks(Q))
+				{
+					return false;
+				}
+				Q = N(Q).NextZ;
+			}
+
+			// Look for remaining points in decreasing z-order
+			while (P != INDEX_NONE && N(P).Z >= MinZ)
+			{
+				if (Blocks(P))
+				{
+					return false;
+				}
+				P = N(P).PrevZ;
+			}
+
+			// Look for remaining points in increasing z-order
+			while (Q != INDEX_NONE && N(Q).Z <= MaxZ)
+			{
+				if (Blocks(Q))
+				{
+					return false;
+				}
+				Q = N(Q).NextZ;
+			}
+
+			return true;
+		}
+
+		// Go through all polygon nodes and cure small local self-intersections
+		int32 CureLocalIntersections(int32 Start, TArray<int32>& Indices)
+		{
+			int32 P = Start;
+			do
+			{
+				const int32 A = N(P).Prev;
+				const int32 B = N(N(P).Next).Next;
+
+				if (!Equals(A, B) && Intersects(A, P, N(P).Next, B) && LocallyInside(A, B) && LocallyInside(B, A))
+				{
+					EmitTriangle(Indices, A, P, B);
+
+					// Remove two nodes involved
+					RemoveNode(P);
+					RemoveNode(N(P).Next);
+
+					P = Start = B;
+				}
+				P = N(P).Next;
+			}
+			while (P != Start);
+
+			return FilterPoints(P);
+		}
+
+		// Try splitting polygon into two and triangulate them independently
+		void SplitEarcut(int32 Start, TArray<int32>& Indices)
+		{
+			// Look for a valid diagonal that divides the polygon into two
+			int32 A = Start;
+			do
+			{
+				int32 B = N(N(A).Next).Next;
+				while (B != N(A).Prev)
+				{
+					if (N(A).Vertex != N(B).Vertex && IsValidDiagonal(A, B))
+					{
+						// Split the polygon in two by the diagonal
+						int32 C = SplitPolygon(A, B);
+
+						// Filter colinear points around the cuts
+						A = FilterPoints(A, N(A).Next);
+						C = FilterPoints(C, N(C).Next);
+
+						// Run earcut on each half
+						EarcutLinked(A, Indices, 0);
+						EarcutLinked(C, Indices, 0);
+						return;
+					}
+					B = N(B).Next;
+				}
+				A = N(A).Next;
+			}
+			while (A != Start);
+		}
+
+		// Link every hole into the outer loop, producing a single-ring polygon without holes
+		int32 EliminateHoles(const TArray<TArray<FVector2f>>& Polygons, int32 OuterNode)
+		{
+			TArray<int32> Queue;
+			Queue.Reserve(Polygons.Num() - 1);
+
+			int32 FirstVertex = Polygons[0].Num();
+			for (int32 I = 1; I < Polygons.Num(); ++I)
+			{
+				const int32 List = LinkedList(Polygons[I], FirstVertex, false);
+				FirstVertex += Polygons[I].Num();
+				if (List == INDEX_NONE)
+				{
+					continue;
+				}
+				if (List == N(List).Next)
+				{
+					N(List).bSteiner = true;
+				}
+				Queue.Add(GetLeftmost(List));
+			}
+
+			Queue.Sort([this](int32 A, int32 B) { return Nodes[A].X < Nodes[B].X; });
+
+			// Process holes from left to right
+			for (const int32 Hole : Queue)
+			{
+				OuterNode = EliminateHole(Hole, OuterNode);
+			}
+
+			return OuterNode;
+		}
+
+		// Find a bridge between vertices that connects hole with an outer ring and link it
+		int32 EliminateHole(int32 Hole, int32 OuterNode)
+		{
+			const int32 Bridge = FindHoleBridge(Hole, OuterNode);
+			if (Bridge == INDEX_NONE)
+			{
+				return OuterNode;
+			}
+
+			const int32 BridgeReverse = SplitPolygon(Bridge, Hole);
+
+			// Filter collinear points around the cuts
+			FilterPoints(BridgeReverse, N(BridgeReverse).Next);
+			return FilterPoints(Bridge, N(Bridge).Next);
+		}
+
+		// David Eberly's algorithm for finding a bridge between hole and outer polygon
+		int32 FindHoleBridge(int32 Hole, int32 OuterNode)
+		{
+			int32 P = OuterNode;
+			const double Hx = N(Hole).X;
+			const double Hy = N(Hole).Y;
+			double Qx = -TNumericLimits<double>::Max();
+			int32 M = INDEX_NONE;
+
+			// Find a segment intersected by a ray from the hole's leftmost point to the left;
+			// segment's endpoint with lesser x will be potential connection point
+			do
+			{
+				const FNode& Node = N(P);
+				const FNode& NextNode = N(Node.Next);
+				if (Hy <= Node.Y && Hy >= NextNode.Y && NextNode.Y != Node.Y)
+				{
+					const double X = Node.X + (Hy - Node.Y) * (NextNode.X - Node.X) / (NextNode.Y - Node.Y);
+					if (X <= Hx && X > Qx)
+					{
+						Qx = X;
+						M = Node.X < NextNode.X ? P : Node.Next;
+						if (X == Hx)
+						{
+							// Hole touches outer segment; pick leftmost endpoint
+							return M;
+						}
+					}
+				}
+				P = Node.Next;
+			}
+			while (P != OuterNode);
+
+			if (M == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+
+			// Look for points inside the triangle of hole point, segment intersection and endpoint;
+			// if there are no points found, we have a valid connection;
+			// otherwise choose the point of the minimum angle with the ray as connection point
+			const int32 Stop = M;
+			const double Mx = N(M).X;
+			const double My = N(M).Y;
+			double TanMin = TNumericLimits<double>::Max();
+
+			P = M;
+			do
+			{
+				const double Px = N(P).X;
+				const double Py = N(P).Y;
+				if (Hx >= Px && Px >= Mx && Hx != Px && PointInTriangle(Hy < My ? Hx : Qx, Hy, Mx, My, Hy < My ? Qx : Hx, Hy, Px, Py))
+				{
+					const double Tan = FMath::Abs(Hy - Py) / (Hx - Px);
+					if (LocallyInside(P, Hole) && (Tan < TanMin || (Tan == TanMin && (Px > N(M).X || (Px == N(M).X && SectorContainsSector(M, P))))))
+					{
+						M = P;
+						TanMin = Tan;
+					}
+				}
+				P = N(P).Next;
+			}
+			while (P != Stop);
+
+			return M;
+		}
+
+		// Whether sector in vertex M contains sector in vertex P in the same coordinates
+		bool SectorContainsSector(int32 M, int32 P)
+		{
+			return Area(N(M).Prev, M, N(P).Prev) < 0.0 && Area(N(P).Next, M, N(M).Next) < 0.0;
+		}
+
+		// Interlink polygon nodes in z-order
+		void IndexCurve(int32 Start)
+		{
+			int32 P = Start;
+			do
+			{
+				FNode& Node = N(P);
+				if (Node.Z == 0)
+				{
+					Node.Z = ZOrder(Node.X, Node.Y);
+				}
+				Node.PrevZ = Node.Prev;
+				Node.NextZ = Node.Next;
+				P = Node.Next;
+			}
+			while (P != Start);
+
+			N(N(P).PrevZ).NextZ = INDEX_NONE;
+			N(P).PrevZ = INDEX_NONE;
+
+			SortLinked(P);
+		}
+
+		// Simon Tatham's linked list merge sort algorithm
+		void SortLinked(int32 List)
+		{
+			int32 InSize = 1;
+			int32 NumMerges;
+			do
+			{
+				int32 P = List;
+				int32 Tail = INDEX_NONE;
+				List = INDEX_NONE;
+				NumMerges = 0;
+
+				while (P != INDEX_NONE)
+				{
+					++NumMerges;
+					int32 Q = P;
+					int32 PSize = 0;
+					for (int32 I = 0; I < InSize; ++I)
+					{
+						++PSize;
+						Q = N(Q).NextZ;
+						if (Q == INDEX_NONE)
+						{
+							break;
+						}
+					}
+					int32 QSize = InSize;
+
+					while (PSize > 0 || (QSize > 0 && Q != INDEX_NONE))
+					{
+						int32 E;
+						if (PSize != 0 && (QSize == 0 || Q == INDEX_NONE || N(P).Z <= N(Q).Z))
+						{
+							E = P;
+							P = N(P).NextZ;
+							--PSize;
+						}
+						else
+						{
+							E = Q;
+							Q = N(Q).NextZ;
+							--QSize;
+						}
+
+						if (Tail != INDEX_NONE)
+						{
+							N(Tail).NextZ = E;
+						}
+						else
+						{
+							List = E;
+						}
+
+						N(E).PrevZ = Tail;
+						Tail = E;
+					}
+
+					P = Q;
+				}
+
+				N(Tail).NextZ = INDEX_NONE;
+				InSize *= 2;
+			}
+			while (NumMerges > 1);
+		}
+
+		// Z-order of a point given coords and inverse of the longer side of data bbox
+		int32 ZOrder(double InX, double InY) const
+		{
+			// Coords are transformed into non-negative 15-bit integer range
+			uint32 X = static_cast<uint32>((InX - MinX) * InvSize);
+			uint32 Y = static_cast<uint32>((InY - MinY) * InvSize);
+
+			X = (X | (X << 8)) & 0x00FF00FF;
+			X = (X | (X << 4)) & 0x0F0F0F0F;
+			X = (X | (X << 2)) & 0x33333333;
+			X = (X | (X << 1)) & 0x55555555;
+
+			Y = (Y | (Y << 8)) & 0x00FF00FF;
+			Y = (Y | (Y << 4)) & 0x0F0F0F0F;
+			Y = (Y | (Y << 2)) & 0x33333333;
+			Y = (Y | (Y << 1)) & 0x55555555;
+
+			return static_cast<int32>(X | (Y << 1));
+		}
+
+		// Find the leftmost node of a polygon ring
+		int32 GetLeftmost(int32 Start)
+		{
+			int32 P = Start;
+			int32 Leftmost = Start;
+			do
+			{
+				if (N(P).X < N(Leftmost).X || (N(P).X == N(Leftmost).X && N(P).Y < N(Leftmost).Y))
+				{
+					Leftmost = P;
+				}
+				P = N(P).Next;
+			}
+			while (P != Start);
+			return Leftmost;
+		}
+
+		// Check if a diagonal between two polygon nodes is valid (lies in polygon interior)
+		bool IsValidDiagonal(int32 A, int32 B)
+		{
+			// Doesn't intersect other edges
+			if (N(N(A).Next).Vertex == N(B).Vertex || N(N(A).Prev).Vertex == N(B).Vertex || IntersectsPolygon(A, B))
+			{
+				return false;
+			}
+			// Locally visible and does not create opposite-facing sectors
+			if (LocallyInside(A, B) && LocallyInside(B, A) && MiddleInside(A, B) && (Area(N(A).Prev, A, N(B).Prev) != 0.0 || Area(A, N(B).Prev, B) != 0.0))
+			{
+				return true;
+			}
+			// Special zero-length case
+			return Equals(A, B) && Area(N(A).Prev, A, N(A).Next) > 0.0 && Area(N(B).Prev, B, N(B).Next) > 0.0;
+		}
+
+		static int32 Sign(double Value)
+		{
+			return Value > 0.0 ? 1 : (Value < 0.0 ? -1 : 0);
+		}
+
+		// For collinear points P, Q, R, check if point Q lies on segment PR
+		bool OnSegment(int32 P, int32 Q, int32 R)
+		{
+			return N(Q).X <= FMath::Max(N(P).X, N(R).X) && N(Q).X >= FMath::Min(N(P).X, N(R).X) && N(Q).Y <= FMath::Max(N(P).Y, N(R).Y) && N(Q).Y >= FMath::Min(N(P).Y, N(R).Y);
+		}
+
+		// Check if two segments intersect
+		bool Intersects(int32 P1, int32 Q1, int32 P2, int32 Q2)
+		{
+			const int32 O1 = Sign(Area(P1, Q1, P2));
+			const int32 O2 = Sign(Area(P1, Q1, Q2));
+			const int32 O3 = Sign(Area(P2, Q2, P1));
+			const int32 O4 = Sign(Area(P2, Q2, Q1));
+
+			if (O1 != O2 && O3 != O4)
+			{
+				return true;
+			}
+
+			return (O1 == 0 && OnSegment(P1, P2, Q1)) || (O2 == 0 && OnSegment(P1, Q2, Q1)) || (O3 == 0 && OnSegment(P2, P1, Q2)) || (O4 == 0 && OnSegment(P2, Q1, Q2));
+		}
+
+		// Check if a polygon diagonal intersects any polygon segments
+		bool IntersectsPolygon(int32 A, int32 B)
+		{
+			const int32 VertexA = N(A).Vertex;
+			const int32 VertexB = N(B).Vertex;
+			int32 P = A;
+			do
+			{
+				const int32 Next = N(P).Next;
+				if (N(P).Vertex != VertexA && N(Next).Vertex != VertexA && N(P).Vertex != VertexB && N(Next).Vertex != VertexB && Intersects(P, Next, A, B))
+				{
+					return true;
+				}
+				P = Next;
+			}
+			while (P != A);
+			return false;
+		}
+
+		// Check if a polygon diagonal is locally inside the polygon
+		bool LocallyInside(int32 A, int32 B)
+		{
+			return Area(N(A).Prev, A, N(A).Next) < 0.0 ? Area(A, B, N(A).Next) >= 0.0 && Area(A, N(A).Prev, B) >= 0.0 : Area(A, B, N(A).Prev) < 0.0 || Area(A, N(A).Next, B) < 0.0;
+		}
+
+		// Check if the middle point of a polygon diagonal is inside the polygon
+		bool MiddleInside(int32 A, int32 B)
+		{
+			int32 P = A;
+			bool bInside = false;
+			const double Px = (N(A).X + N(B).X) / 2.0;
+			const double Py = (N(A).Y + N(B).Y) / 2.0;
+			do
+			{
+				const FNode& Node = N(P);
+				const FNode& NextNode = N(Node.Next);
+				if (((Node.Y > Py) != (NextNode.Y > Py)) && NextNode.Y != Node.Y && (Px < (NextNode.X - Node.X) * (Py - Node.Y) / (NextNode.Y - Node.Y) + Node.X))
+				{
+					bInside = !bInside;
+				}
+				P = Node.Next;
+			}
+			while (P != A);
+			return bInside;
+		}
+
+		// Link two polygon vertices with a bridge; if the vertices belong to the same ring, it splits polygon into two;
+		// if one belongs to the outer ring and another to a hole, it merges it into a single ring
+		int32 SplitPolygon(int32 A, int32 B)
+		{
+			// Copy out before emplacing, recursive splits can outgrow the reserve and reallocate the nodes
+			const FNode NodeA = N(A);
+			const FNode NodeB = N(B);
+			const int32 A2 = Nodes.Emplace(NodeA.Vertex, NodeA.X, NodeA.Y);
+			const int32 B2 = Nodes.Emplace(NodeB.Vertex, NodeB.X, NodeB.Y);
+			const int32 An = N(A).Next;
+			const int32 Bp = N(B).Prev;
+
+			N(A).Next = B;
+			N(B).Prev = A;
+
+			N(A2).Next = An;
+			N(An).Prev = A2;
+
+			N(B2).Next = A2;
+			N(A2).Prev = B2;
+
+			N(Bp).Next = B2;
+			N(B2).Prev = Bp;
+
+			return B2;
+		}
+	};
+
+	void TriangulatePolygonNative(const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices)
 	{
-		UE_LOG(LogMRUK, Error, TEXT("MRUK shared library is not available. To use this functionality make sure the library is included"));
-		return;
+		SCOPE_CYCLE_COUNTER(STAT_MRUKTriangulatePolygonNative);
+
+		if (Polygons.IsEmpty() || Polygons[0].Num() < 3)
+		{
+			return;
+		}
+
+		int32 NumVertices = 0;
+		for (const auto& Polygon : Polygons)
+		{
+			NumVertices += Polygon.Num();
+		}
+		Vertices.Reserve(NumVertices);
+		for (const auto& Polygon : Polygons)
+		{
+			for (const auto& Point : Polygon)
+			{
+				Vertices.Push(FVector2D(Point));
+			}
+		}
+
+		FMRUKEarClipper EarClipper;
+		EarClipper.Triangulate(Polygons, Indices);
+
+		// Make the winding order of the output consistent with the shared library which always emits counter clockwise triangles
+		for (int32 I = 0; I < Indices.Num(); I += 3)
+		{
+			const FVector2D& P1 = Vertices[Indices[I]];
+			const FVector2D& P2 = Vertices[Indices[I + 1]];
+			const FVector2D& P3 = Vertices[Indices[I + 2]];
+			if (FVector2D::CrossProduct(P2 - P1, P3 - P1) < 0.0)
+			{
+				Swap(Indices[I + 1], Indices[I + 2]);
+			}
+		}
 	}
 
-	TArray<MRUKShared::MrukPolygon2f> ConvertedPolygons;
-	ConvertedPolygons.Reserve(Polygons.Num());
-	for (const auto& Polygon : Polygons)
+	void TriangulatePolygonShared(MRUKShared* MRUKShared, const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices)
 	{
-		ConvertedPolygons.Push({ Polygon.GetData(), static_cast<uint32_t>(Polygon.Num()) });
+		SCOPE_CYCLE_COUNTER(STAT_MRUKTriangulatePolygonShared);
+
+		TArray<MRUKShared::MrukPolygon2f> ConvertedPolygons;
+		ConvertedPolygons.Reserve(Polygons.Num());
+		for (const auto& Polygon : Polygons)
+		{
+			ConvertedPolygons.Push({ Polygon.GetData(), static_cast<uint32_t>(Polygon.Num()) });
+		}
+
+		auto Mesh = MRUKShared->TriangulatePolygon(ConvertedPolygons.GetData(), ConvertedPolygons.Num());
+
+		Vertices.Reserve(Mesh.numVertices);
+		Indices.Reserve(Mesh.numIndices);
+
+		for (uint32_t i = 0; i < Mesh.numVertices; ++i)
+		{
+			Vertices.Push(FVector2D(Mesh.vertices[i]));
+		}
+		for (uint32_t i = 0; i < Mesh.numIndices; ++i)
+		{
+			Indices.Push(Mesh.indices[i]);
+		}
+
+		MRUKShared->FreeMesh(&Mesh);
 	}
+} // namespace
 
-	auto Mesh = MRUKShared->TriangulatePolygon(ConvertedPolygons.GetData(), ConvertedPolygons.Num());
+bool MRUKIsTriangulationBackendAvailable(EMRUKTriangulationBackend Backend)
+{
+	return Backend != EMRUKTriangulationBackend::SharedLibrary || MRUKShared::GetInstance() != nullptr;
+}
 
-	Vertices.Reserve(Mesh.numVertices);
-	Indices.Reserve(Mesh.numIndices);
+void MRUKTriangulatePolygon(const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices)
+{
+	MRUKTriangulatePolygon(Polygons, Vertices, Indices, GetDefault<UMRUKSettings>()->TriangulationBackend);
+}
 
-	for (uint32_t i = 0; i < Mesh.numVertices; ++i)
+void MRUKTriangulatePolygon(const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices, EMRUKTriangulationBackend Backend)
+{
+	Vertices.Empty();
+	Indices.Empty();
+
+	if (Backend == EMRUKTriangulationBackend::Native)
 	{
-		Vertices.Push(FVector2D(Mesh.vertices[i]));
+		TriangulatePolygonNative(Polygons, Vertices, Indices);
+		return;
 	}
-	for (uint32_t i = 0; i < Mesh.numIndices; ++i)
+
+	auto MRUKShared = MRUKShared::GetInstance();
+	if (!MRUKShared)
 	{
-		Indices.Push(Mesh.indices[i]);
+		if (Backend == EMRUKTriangulationBackend::Auto)
+		{
+			TriangulatePolygonNative(Polygons, Vertices, Indices);
+			return;
+		}
+		UE_LOG(LogMRUK, Error, TEXT("MRUK shared library is not available. To use this functionality make sure the library is included"));
+		return;
 	}
 
-	MRUKShared->FreeMesh(&Mesh);
+	TriangulatePolygonShared(MRUKShared, Polygons, Vertices, Indices);
 }
@@ -0,0 +1,625 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitGlobalMeshJsonReader.h"
+#include "Misc/Parse.h"
+#include "Misc/StringBuilder.h"
+
+namespace
+{
+	constexpr int32 MaxJsonDepth = 256;
+
+	// Powers of ten which are exactly representable as double. Multiplying or dividing a mantissa of at most 2^53 by
+	// one of them gives the correctly rounded result, the same as strtod() would return.
+	constexpr double ExactPowersOfTen[] = {
+		1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	bool IsJsonWhitespace(uint32 Char)
+	{
+		return Char == ' ' || Char == '\t' || Char == '\n' || Char == '\r';
+	}
+
+	bool IsJsonDigit(uint32 Char)
+	{
+		return Char >= '0' && Char <= '9';
+	}
+
+	/**
+	 * Recursive descent reader that only looks for the global mesh of a single room and skips everything else.
+	 * Nothing is allocated except for the output arrays and a few small strings for keys and UUIDs.
+	 */
+	template <typename CharType>
+	class TGlobalMeshJsonReader
+	{
+	public:
+		TGlobalMeshJsonReader(TStringView<CharType> Json, const FOculusXRUUID& InRoomUUID, TArray<FVector>& InPositions, TArray<int32>& InIndices)
+			: Begin(Json.GetData())
+			, Cursor(Json.GetData())
+			, End(Json.GetData() + Json.Len())
+			, RoomUUID(InRoomUUID)
+			, Positions(InPositions)
+			, Indices(InIndices)
+		{
+		}
+
+		bool Read(FMRUKJsonReadError& OutError)
+		{
+			Positions.Reset();
+			Indices.Reset();
+
+			const bool bSuccess = ReadObject([this](FStringView Key) {
+				if (Key.Equals(TEXT("Rooms"), ESearchCase::IgnoreCase))
+				{
+					return ReadArray([this]() { return ReadRoom(); });
+				}
+				return SkipValue(1);
+			});
+
+			if (bSuccess && !bDone)
+			{
+				SkipWhitespace();
+				if (Cursor != End)
+				{
+					Fail(TEXT("Unexpected data after the end of the JSON document"));
+				}
+				else
+				{
+					Error.Message = TEXT("Could not find global mesh in room");
+				}
+			}
+
+			if (!bDone)
+			{
+				Positions.Reset();
+				Indices.Reset();
+				OutError = MoveTemp(Error);
+				return false;
+			}
+			return true;
+		}
+
+	private:
+		enum class ERoomMatch
+		{
+			Unknown,
+			Match,
+			NoMatch,
+		};
+
+		bool ReadRoom()
+		{
+			CurrentRoomMatch = ERoomMatch::Unknown;
+			bFoundMeshInRoom = false;
+			const bool bSuccess = ReadObject([this](FStringView Key) {
+				if (Key.Equals(TEXT("UUID"), ESearchCase::IgnoreCase))
+				{
+					TStringBuilder<2 * OCULUSXR_UUID_SIZE + 1> Hex;
+					if (!ReadString(Hex))
+					{
+						return false;
+					}
+					FOculusXRUUID UUID;
+					if (Hex.Len() == 2 * OCULUSXR_UUID_SIZE)
+					{
+						HexToBytes(FString(Hex.ToView()), UUID.UUIDBytes);
+					}
+					CurrentRoomMatch = UUID == RoomUUID ? ERoomMatch::Match : ERoomMatch::NoMatch;
+					// The global mesh may have been read before the UUID of the room was known
+					bDone = bFoundMeshInRoom && CurrentRoomMatch == ERoomMatch::Match;
+					return true;
+				}
+				if (Key.Equals(TEXT("Anchors"), ESearchCase::IgnoreCase) && CurrentRoomMatch != ERoomMatch::NoMatch && !bFoundMeshInRoom)
+				{
+					return ReadArray([this]() { return ReadAnchor(); });
+				}
+				return SkipValue(2);
+			});
+
+			if (bSuccess && !bDone && bFoundMeshInRoom)
+			{
+				// Global mesh of a different room
+				Positions.Reset();
+				Indices.Reset();
+			}
+			return bSuccess;
+		}
+
+		bool ReadAnchor()
+		{
+			return ReadObject([this](FStringView Key) {
+				if (Key.Equals(TEXT("GlobalMesh"), ESearchCase::IgnoreCase) && !bFoundMeshInRoom)
+				{
+					if (!ReadGlobalMesh())
+					{
+						return false;
+					}
+					bFoundMeshInRoom = true;
+					bDone = CurrentRoomMatch == ERoomMatch::Match;
+					return true;
+				}
+				return SkipValue(4);
+			});
+		}
+
+		bool ReadGlobalMesh()
+		{
+			Positions.Reset();
+			Indices.Reset();
+			return ReadObject([this](FStringView Key) {
+				if (Key.Equals(TEXT("Positions"), ESearchCase::IgnoreCase))
+				{
+					return ReadPositions();
+				}
+				if (Key.Equals(TEXT("Indices"), ESearchCase::IgnoreCase))
+				{
+					return ReadIndices();
+				}
+				return SkipValue(5);
+			});
+		}
+
+		bool ReadPositions()
+		{
+			Positions.Reserve(Positions.Num() + CountArrayElements());
+			return ReadArray([this]() {
+				FVector Position;
+				int32 NumComponents = 0;
+				const bool bSuccess = ReadArray([this, &Position, &NumComponents]() {
+					if (NumComponents == 3)
+					{
+						return Fail(TEXT("Position has more than 3 components"));
+					}
+					return ReadNumber(Position[NumComponents++]);
+				});
+				if (!bSuccess)
+				{
+					return false;
+				}
+				if (NumComponents != 3)
+				{
+					return Fail(TEXT("Position has less than 3 components"));
+				}
+				Positions.Add(Position);
+				return true;
+			});
+		}
+
+		bool ReadIndices()
+		{
+			Indices.Reserve(Indices.Num() + CountArrayElements());
+			return ReadArray([this]() {
+				double Index = 0.0;
+				if (!ReadNumber(Index))
+				{
+					return false;
+				}
+				Indices.Add(static_cast<int32>(Index));
+				return true;
+			});
+		}
+
+		/**
+		 * Read an object and call the callback with the key of every member. The callback has to consume the value.
+		 */
+		template <typename CallbackType>
+		bool ReadObject(CallbackType&& Callback)
+		{
+			if (!Consume('{', TEXT("Expected '{'")))
+			{
+				return false;
+			}
+			SkipWhitespace();
+			if (Peek() == '}')
+			{
+				++Cursor;
+				return true;
+			}
+
+			TStringBuilder<64> Key;
+			while (true)
+			{
+				Key.Reset();
+				SkipWhitespace();
+				if (!ReadString(Key) || !Consume(':', TEXT("Expected ':'")) || !Callback(Key.ToView()))
+				{
+					return false;
+				}
+				if (bDone)
+				{
+					return true;
+				}
+				SkipWhitespace();
+				const uint32 Next = Peek();
+				++Cursor;
+				if (Next == '}')
+				{
+					return true;
+				}
+				if (Next != ',')
+				{
+					--Cursor;
+					return Fail(TEXT("Expected ',' or '}'"));
+				}
+			}
+		}
+
+		/**
+		 * Read an array and call the callback for every element. The callback has to consume the element.
+		 */
+		template <typename CallbackType>
+		bool ReadArray(CallbackType&& Callback)
+		{
+			if (!Consume('[', TEXT("Expected '['")))
+			{
+				return false;
+			}
+			SkipWhitespace();
+			if (Peek() == ']')
+			{
+				++Cursor;
+				return true;
+			}
+
+			while (true)
+			{
+				if (!Callback())
+				{
+					return false;
+				}
+				if (bDone)
+				{
+					return true;
+				}
+				SkipWhitespace();
+				const uint32 Next = Peek();
+				++Cursor;
+				if (Next == ']')
+				{
+					return true;
+				}
+				if (Next != ',')
+				{
+					--Cursor;
+					return Fail(TEXT("Expected ',' or ']'"));
+				}
+			}
+		}
+
+		/**
+		 * Read a string and unescape it. Keys and UUIDs are plain ASCII, so UTF-8 sequences are not decoded.
+		 */
+		bool ReadString(FStringBuilderBase& OutString)
+		{
+			if (!Consume('"', TEXT("Expected '\"'")))
+			{
+				return false;
+			}
+			while (Cursor < End)
+			{
+				const uint32 Char = *Cursor;
+				if (Char == '"')
+				{
+					++Cursor;
+					return true;
+				}
+				if (Char < 0x20)
+				{
+					return Fail(TEXT("Control character in string"));
+				}
+				++Cursor;
+				if (Char != '\\')
+				{
+					OutString.AppendChar(static_cast<TCHAR>(Char));
+					continue;
+				}
+
+				switch (Peek())
+				{
+					case '"':
+						OutString.AppendChar(TEXT('"'));
+						break;
+					case '\\':
+						OutString.AppendChar(TEXT('\\'));
+						break;
+					case '/':
+						OutString.AppendChar(TEXT('/'));
+						break;
+					case 'b':
+						OutString.AppendChar(TEXT('\b'));
+						break;
+					case 'f':
+						OutString.AppendChar(TEXT('\f'));
+						break;
+					case 'n':
+						OutString.AppendChar(TEXT('\n'));
+						break;
+					case 'r':
+						OutString.AppendChar(TEXT('\r'));
+						break;
+					case 't':
+						OutString.AppendChar(TEXT('\t'));
+						break;
+					case 'u':
+					{
+						uint32 CodeUnit = 0;
+						for (int32 I = 0; I < 4; ++I)
+						{
+							++Cursor;
+							const uint32 HexChar = Peek();
+							if (!FChar::IsHexDigit(static_cast<TCHAR>(HexChar)))
+							{
+								return Fail(TEXT("Invalid unicode escape sequence"));
+							}
+							CodeUnit = (CodeUnit << 4) | FParse::HexDigit(static_cast<TCHAR>(HexChar));
+						}
+						OutString.AppendChar(static_cast<TCHAR>(CodeUnit));
+						break;
+					}
+					default:
+						return Fail(TEXT("Invalid escape sequence"));
+				}
+				++Cursor;
+			}
+			return Fail(TEXT("Unterminated string"));
+		}
+
+		bool ReadNumber(double& OutNumber)
+		{
+			SkipWhitespace();
+			const CharType* Start = Cursor;
+			const bool bNegative = Peek() == '-';
+			if (bNegative)
+			{
+				++Cursor;
+			}
+			if (!IsJsonDigit(Peek()))
+			{
+				return Fail(TEXT("Expected a number"));
+			}
+
+			// Collect up to 19 significant digits, which always fit into an uint64
+			uint64 Mantissa = 0;
+			int32 NumSignificantDigits = 0;
+			int32 Exponent = 0;
+			bool bExact = true;
+			const auto AddDigit = [&](uint32 Digit, bool bFraction) {
+				if (NumSignificantDigits < 19)
+				{
+					Mantissa = Mantissa * 10 + Digit;
+					NumSignificantDigits += Mantissa != 0 ? 1 : 0;
+					Exponent -= bFraction ? 1 : 0;
+				}
+				else
+				{
+					Exponent += bFraction ? 0 : 1;
+					bExact &= Digit == 0;
+				}
+			};
+
+			if (Peek() == '0')
+			{
+				++Cursor;
+			}
+			else
+			{
+				while (IsJsonDigit(Peek()))
+				{
+					AddDigit(Peek() - '0', false);
+					++Cursor;
+				}
+			}
+			if (Peek() == '.')
+			{
+				++Cursor;
+				if (!IsJsonDigit(Peek()))
+				{
+					return Fail(TEXT("Expected a digit after the decimal point"));
+				}
+				while (IsJsonDigit(Peek()))
+				{
+					AddDigit(Peek() - '0', true);
+					++Cursor;
+				}
+			}
+			if (Peek() == 'e' || Peek() == 'E')
+			{
+				++Cursor;
+				const bool bNegativeExponent = Peek() == '-';
+				if (Peek() == '-' || Peek() == '+')
+				{
+					++Cursor;
+				}
+				if (!IsJsonDigit(Peek()))
+				{
+					return Fail(TEXT("Expected a digit in the exponent"));
+				}
+				int32 ExplicitExponent = 0;
+				while (IsJsonDigit(Peek()))
+				{
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + static_cast<int32>(Peek() - '0'), 100000);
+					++Cursor;
+				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			}
+
+			if (bExact && Mantissa <= (1ull << 53) && Exponent >= -22 && Exponent <= 22)
+			{
+				const double Value = static_cast<double>(Mantissa);
+				OutNumber = Exponent < 0 ? Value / ExactPowersOfTen[-Exponent] : Value * ExactPowersOfTen[Exponent];
+				OutNumber = bNegative ? -OutNumber : OutNumber;
+				return true;
+			}
+
+			// Rare case, let the C runtime do the correct rounding
+			TStringBuilder<64> Number;
+			for (const CharType* It = Start; It < Cursor; ++It)
+			{
+				Number.AppendChar(static_cast<TCHAR>(*It));
+			}
+			OutNumber = FCString::Atod(*Number);
+			return true;
+		}
+
+		bool ReadLiteral(const ANSICHAR* Literal)
+		{
+			for (; *Literal; ++Literal, ++Cursor)
+			{
+				if (Peek() != static_cast<uint32>(*Literal))
+				{
+					return Fail(TEXT("Invalid literal"));
+				}
+			}
+			return true;
+		}
+
+		bool SkipValue(int32 Depth)
+		{
+			if (Depth > MaxJsonDepth)
+			{
+				return Fail(TEXT("JSON is nested too deeply"));
+			}
+			SkipWhitespace();
+			switch (Peek())
+			{
+				case '{':
+					return ReadObject([this, Depth](FStringView) { return SkipValue(Depth + 1); });
+				case '[':
+					return ReadArray([this, Depth]() { return SkipValue(Depth + 1); });
+				case '"':
+				{
+					TStringBuilder<64> Ignored;
+					return ReadString(Ignored);
+				}
+				case 't':
+					return ReadLiteral("true");
+				case 'f':
+					return ReadLiteral("false");
+				case 'n':
+					return ReadLiteral("null");
+				default:
+				{
+					double Ignored = 0.0;
+					return ReadNumber(Ignored);
+				}
+			}
+		}
+
+		/**
+		 * Count the elements of the array at the cursor without parsing them. Used to reserve the output arrays up front.
+		 * Malformed arrays are not detected here, the actual parsing reports them.
+		 */
+		int32 CountArrayElements()
+		{
+			SkipWhitespace();
+			int32 NumCommas = 0;
+			int32 Depth = 0;
+			bool bEmpty = true;
+			for (const CharType* It = Cursor; It < End; ++It)
+			{
+				const uint32 Char = *It;
+				if (IsJsonWhitespace(Char))
+				{
+					continue;
+				}
+				if (Depth == 1 && Char != ']' && Char != ',')
+				{
+					bEmpty = false;
+				}
+				if (Char == '"')
+				{
+					for (++It; It < End && *It != '"'; ++It)
+					{
+						It += *It == '\\' ? 1 : 0;
+					}
+				}
+				else if (Char == '[' || Char == '{')
+				{
+					++Depth;
+				}
+				else if (Char == ']' || Char == '}')
+				{
+					if (--Depth <= 0)
+					{
+						return bEmpty ? 0 : NumCommas + 1;
+					}
+				}
+				else if (Char == ',' && Depth == 1)
+				{
+					++NumCommas;
+				}
+			}
+			return 0;
+		}
+
+		uint32 Peek() const
+		{
+			return Cursor < End ? static_cast<uint32>(*Cursor) : 0;
+		}
+
+		void SkipWhitespace()
+		{
+			while (Cursor < End && IsJsonWhitespace(*Cursor))
+			{
+				++Cursor;
+			}
+		}
+
+		bool Consume(uint32 Expected, const TCHAR* Message)
+		{
+			SkipWhitespace();
+			if (Peek() != Expected)
+			{
+				return Fail(Message);
+			}
+			++Cursor;
+			return true;
+		}
+
+		bool Fail(const TCHAR* Message)
+		{
+			// Only keep the first error, callers unwinding the stack don't overwrite it
+			if (Error.Message.IsEmpty())
+			{
+				Error.Offset = FMath::Min(Cursor, End) - Begin;
+				Error.Message = Cursor < End ? Message : TEXT("Unexpected end of JSON");
+			}
+			return false;
+		}
+
+		const CharType* Begin;
+		const CharType* Cursor;
+		const CharType* End;
+		const FOculusXRUUID& RoomUUID;
+		TArray<FVector>& Positions;
+		TArray<int32>& Indices;
+
+		ERoomMatch CurrentRoomMatch = ERoomMatch::Unknown;
+		bool bFoundMeshInRoom = false;
+		bool bDone = false;
+		FMRUKJsonReadError Error;
+	};
+
+	template <typename CharType>
+	bool ReadGlobalMeshJson(TStringView<CharType> Json, const FOculusXRUUID& RoomUUID, TArray<FVector>& OutPositions, TArray<int32>& OutIndices, FMRUKJsonReadError* OutError)
+	{
+		FMRUKJsonReadError Error;
+		TGlobalMeshJsonReader<CharType> Reader(Json, RoomUUID, OutPositions, OutIndices);
+		const bool bSuccess = Reader.Read(Error);
+		if (OutError)
+		{
+			*OutError = MoveTemp(Error);
+		}
+		return bSuccess;
+	}
+} // namespace
+
+bool MRUKReadGlobalMeshFromJson(FStringView Json, const FOculusXRUUID& RoomUUID, TArray<FVector>& OutPositions, TArray<int32>& OutIndices, FMRUKJsonReadError* OutError)
+{
+	return ReadGlobalMeshJson(Json, RoomUUID, OutPositions, OutIndices, OutError);
+}
+
+bool MRUKReadGlobalMeshFromJson(FUtf8StringView Json, const FOculusXRUUID& RoomUUID, TArray<FVector>& OutPositions, TArray<int32>& OutIndices, FMRUKJsonReadError* OutError)
+{
+	return ReadGlobalMeshJson(Json, RoomUUID, OutPositions, OutIndices, OutError);
+}
@@ -71,216 +71,403 @@ void UMRUKGridSliceResizerComponent::PostEditChangeProperty(FPropertyChangedEven
 }
 #endif
 
-void UMRUKGridSliceResizerComponent::SliceMesh()
+namespace
 {
-	if (!Mesh)
+	// Slice the positions of the mesh data with the settings of the key
+	void ComputeGridSlicePositions(const FMRUKGridSliceMeshData& MeshData, const FMRUKGridSliceKey& Key, TArray<double>& OutPositions)
 	{
-		return;
-	}
+		const FVector& ActorScale = Key.Scale;
+		const FVector ActorScaleInv = FVector(1.0 / ActorScale.X, 1.0 / ActorScale.Y, 1.0 / ActorScale.Z);
+		const FVector Size = ActorScale;
+		const FVector& SlicerPivotOffset = Key.SlicerPivotOffset;
 
-	if (!Mesh->bAllowCPUAccess)
-	{
-		UE_LOG(LogMRUK, Error, TEXT("Can not slice a mesh that has no CPU access. Make sure you enable CPU access on the static mesh asset."));
-		return;
-	}
+		// Slicing
 
-	TArray<FVector> Positions;
-	TArray<FVector> Normals;
-	TArray<FVector2D> UVs;
-	TArray<FColor> Colors;
-	TArray<int32> Triangles;
+		FTransform PivotTransform;
+		PivotTransform.SetLocation(-SlicerPivotOffset);
 
-	const FStaticMeshLODResources& LODResources = Mesh->GetRenderData()->LODResources[0];
-	const FStaticMeshVertexBuffers& VertexBuffers = LODResources.VertexBuffers;
-	const FRawStaticIndexBuffer& IndexBuffer = LODResources.IndexBuffer;
+		FTransform ScaledInvPivotTransform;
+		ScaledInvPivotTransform.SetLocation(Size * SlicerPivotOffset);
 
-	Positions.SetNum(LODResources.GetNumVertices());
-	Normals.SetNum(LODResources.GetNumVertices());
-	UVs.SetNum(LODResources.GetNumVertices());
-	Colors.SetNum(LODResources.GetNumVertices());
+		// The bounding box of the mesh to resize
+		FBox BBox = MeshData.Bounds;
+		BBox = FBox(PivotTransform.TransformPosition(BBox.Min), PivotTransform.TransformPosition(BBox.Max));
 
-	const FVector ActorScale = GetOwner() ? GetOwner()->GetActorScale() : FVector::OneVector;
-	const FVector ActorScaleInv = FVector(1.0 / ActorScale.X, 1.0 / ActorScale.Y, 1.0 / ActorScale.Z);
-	const FVector Size = ActorScale;
+		// The bounding box of the mesh to resize scaled by the size
+		const FBox BBoxScaled = FBox(BBox.Min * Size, BBox.Max * Size);
 
-	// Slicing
+		// The bounding box of the mesh to resize scaled including the pivot point
+		// This may be a bigger box as ScaledBBox in case the pivot is outside of the scaled bounding box.
+		const FBox BBoxScaledPivot = FBox(
+			FVector(FMath::Min(BBox.Min.X, SlicerPivotOffset.X), FMath::Min(BBox.Min.Y, SlicerPivotOffset.Y), FMath::Min(BBox.Min.Z, SlicerPivotOffset.Z)),
+			FVector(FMath::Max(BBox.Max.X, SlicerPivotOffset.X), FMath::Max(BBox.Max.Y, SlicerPivotOffset.Y), FMath::Max(BBox.Max.Z, SlicerPivotOffset.Z)));
 
-	FTransform PivotTransform;
-	PivotTransform.SetLocation(-SlicerPivotOffset);
+		// Locations of the border slices between 0 - 1
+		FVector BorderPos = Key.BorderPositive;
+		FVector BorderNeg = Key.BorderNegative;
 
-	FTransform ScaledInvPivotTransform;
-	ScaledInvPivotTransform.SetLocation(Size * SlicerPivotOffset);
+		// Locations of the border slices for the X,Y,Z axis in local space
+		FVector BorderPosLS;
+		FVector BorderNegLS;
 
-	// The bounding box of the mesh to resize
-	FBox BBox = Mesh->GetBoundingBox();
-	BBox = FBox(PivotTransform.TransformPosition(BBox.Min), PivotTransform.TransformPosition(BBox.Max));
+		// Distance from the Border[Pos|Neg]LS to the outer maximum/minimum of the BBox
+		FVector StubPos;
+		FVector StubNeg;
 
-	// The bounding box of the mesh to resize scaled by the size
-	const FBox BBoxScaled = FBox(BBox.Min * Size, BBox.Max * Size);
+		// The inner bounding box that should be stretched in all directions
+		FVector BBoxInnerMax;
+		FVector BBoxInnerMin;
 
-	// The bounding box of the mesh to resize scaled including the pivot point
-	// This may be a bigger box as ScaledBBox in case the pivot is outside of the scaled bounding box.
-	const FBox BBoxScaledPivot = FBox(
-		FVector(FMath::Min(BBox.Min.X, SlicerPivotOffset.X), FMath::Min(BBox.Min.Y, SlicerPivotOffset.Y), FMath::Min(BBox.Min.Z, SlicerPivotOffset.Z)),
-		FVector(FMath::Max(BBox.Max.X, SlicerPivotOffset.X), FMath::Max(BBox.Max.Y, SlicerPivotOffset.Y), FMath::Max(BBox.Max.Z, SlicerPivotOffset.Z)));
+		// The expected bounding box of the inner bounding box when its scaled up by the size
+		FVector BBoxInnerScaledMax;
+		FVector BBoxInnerScaledMin;
 
-	// Locations of the border slices between 0 - 1
-	FVector BorderPos = FVector(BorderXPositive, BorderYPositive, BorderZPositive);
-	FVector BorderNeg = FVector(BorderXNegative, BorderYNegative, BorderZNegative);
+		// The ratio between the inner bounding box and the scaled bounding box
+		FVector InnerBoxScaleRatioMax;
+		FVector InnerBoxScaleRatioMin;
 
-	// Locations of the border slices for the X,Y,Z axis in local space
-	FVector BorderPosLS;
-	FVector BorderNegLS;
+		// The ratio to use for downscaling in case it's needed
+		FVector DownscaleMax;
+		FVector DownscaleMin;
 
-	// Distance from the Border[Pos|Neg]LS to the outer maximum/minimum of the BBox
-	FVector StubPos;
-	FVector StubNeg;
+		for (int32 I = 0; I < 3; ++I)
+		{
+			// We don't want to have division by zero further down the line
+			BorderPos[I] = FMath::Clamp(BorderPos[I], DBL_EPSILON, 1.0);
+			BorderNeg[I] = FMath::Clamp(BorderNeg[I], DBL_EPSILON, 1.0);
+
+			BorderPosLS[I] = BBoxScaledPivot.Max[I] - (1.0 - BorderPos[I]) * FMath::Abs(BBoxScaledPivot.Max[I]);
+			BorderNegLS[I] = BBoxScaledPivot.Min[I] + (1.0 - BorderNeg[I]) * FMath::Abs(BBoxScaledPivot.Min[I]);
+
+			StubPos[I] = FMath::Abs(BBox.Max[I] - BorderPosLS[I]);
+			StubNeg[I] = FMath::Abs(BBox.Min[I] - BorderNegLS[I]);
+
+			BBoxInnerMax[I] = BBox.Max[I] - StubPos[I];
+			BBoxInnerMin[I] = BBox.Min[I] + StubNeg[I];
+
+			// Max may be negative and Min may be positive in case the stubs are greater than
+			// the scaled down bounding box and therefore don't fit the scaled bounding box.
+			// This case gets treated special down below.
+			BBoxInnerScaledMax[I] = BBoxScaled.Max[I] - StubPos[I];
+			BBoxInnerScaledMin[I] = BBoxScaled.Min[I] + StubNeg[I];
+
+			InnerBoxScaleRatioMax[I] = FMath::Max(0.0, BBoxInnerScaledMax[I] / BBoxInnerMax[I]);
+			InnerBoxScaleRatioMin[I] = FMath::Max(0.0, BBoxInnerScaledMin[I] / BBoxInnerMin[I]);
+
+			// When Downscale[Min/Max] needs to be applied the temporary bounding box is
+			// Max == StubPos, Min == StubNeg. Therefore get the ratio between it and the
+			// expected scaled down bounding box to calculate the scale that needs
+			// to be applied
+			DownscaleMax[I] = BBoxScaled.Max[I] / StubPos[I];
+			DownscaleMin[I] = BBoxScaled.Min[I] / StubNeg[I];
+		}
 
-	// The inner bounding box that should be stretched in all directions
-	FVector BBoxInnerMax;
-	FVector BBoxInnerMin;
+		// Process vertices
+
+		// If the center shouldn't be scaled we need to take care of the case when the original
+		// center vertices would be outside of the expected downscaled bounding box. Therefore, iterate
+		// through all vertices and check if the center vertices are outside. If they are outside we need
+		// to scale down the center part as usually.
+		// This unfortunately has to be done in a separate first pass.
+		bool ScaleDownCenter[3] = { false, false, false };
+
+		const int32 VertexCount = MeshData.NumVertices;
+		const float* SourceX = MeshData.Positions.GetData();
+		const float* SourceY = SourceX + VertexCount;
+		const float* SourceZ = SourceY + VertexCount;
+		TArray<FVector> Positions;
+		Positions.SetNumUninitialized(VertexCount);
+		for (int32 I = 0; I < VertexCount; ++I)
+		{
+			// Apply pivot offset
+			Positions[I] = PivotTransform.TransformPosition(FVector(SourceX[I], SourceY[I], SourceZ[I]));
+			const FVector& Position = Positions[I];
 
-	// The expected bounding box of the inner bounding box when its scaled up by the size
-	FVector BBoxInnerScaledMax;
-	FVector BBoxInnerScaledMin;
+			for (int32 A = 0; A < 3; ++A)
+			{
+				if ((0.0 <= Position[A] && Position[A] <= BorderPosLS[A]) && (Position[A] > BBoxInnerScaledMax[A]))
+				{
+					ScaleDownCenter[A] = true;
+				}
+				else if ((BorderNegLS[A] <= Position[A] && Position[A] <= 0.0) && (Position[A] < BBoxInnerScaledMin[A]))
+				{
+					ScaleDownCenter[A] = true;
+				}
+			}
+		}
 
-	// The ratio between the inner bounding box and the scaled bounding box
-	FVector InnerBoxScaleRatioMax;
-	FVector InnerBoxScaleRatioMin;
+		bool bScaleCenter[3] = {};
+		bScaleCenter[0] = Key.ScaleCenterMode & static_cast<uint8>(EMRUKScaleCenterMode::XAxis) ? true : false;
+		bScaleCenter[1] = Key.ScaleCenterMode & static_cast<uint8>(EMRUKScaleCenterMode::YAxis) ? true : false;
+		bScaleCenter[2] = Key.ScaleCenterMode & static_cast<uint8>(EMRUKScaleCenterMode::ZAxis) ? true : false;
 
-	// The ratio to use for downscaling in case it's needed
-	FVector DownscaleMax;
-	FVector DownscaleMin;
+		for (FVector& Position : Positions)
+		{
+			// Apply computations on each axis
 
-	for (int32 I = 0; I < 3; ++I)
+			for (int32 A = 0; A < 3; ++A)
+			{
+				if ((bScaleCenter[A] || ScaleDownCenter[A]) && (0.0 <= Position[A] && Position[A] <= BorderPosLS[A]))
+				{
+					// Vertex is inside the inner distance and should be stretched
+					Position[A] *= InnerBoxScaleRatioMax[A];
+				}
+				else if ((bScaleCenter[A] || ScaleDownCenter[A]) && (BorderNegLS[A] <= Position[A] && Position[A] <= 0.0))
+				{
+					// Vertex is inside the inner distance and should be stretched
+					Position[A] *= InnerBoxScaleRatioMin[A];
+				}
+				else if (BorderPosLS[A] < Position[A])
+				{
+					// Vertex is inside the outer stub and should not be stretched
+					// Perform linear transform of vertices into their expect position
+					Position[A] = BorderPosLS[A] * InnerBoxScaleRatioMax[A] + (Position[A] - BorderPosLS[A]);
+					if (BBoxInnerScaledMax[A] < 0.0)
+					{
+						// The mesh that would result from the linear transform above is still not small enough to
+						// fit into the expected scaled down bounding box. This means the stubs need to be scaled down
+						// to make them fit.
+						Position[A] *= DownscaleMax[A];
+					}
+				}
+				else if (Position[A] < BorderNegLS[A])
+				{
+					// Vertex is inside the outer stub and should not be stretched
+					// Perform linear transform of vertices into their expect position
+					Position[A] = BorderNegLS[A] * InnerBoxScaleRatioMin[A] - (BorderNegLS[A] - Position[A]);
+					if (BBoxInnerScaledMin[A] > 0.0)
+					{
+						// The mesh that would result from the linear transform above is still not small enough to
+						// fit into the expected scaled down bounding box. This means the stubs need to be scaled down
+						// to make them fit.
+						Position[A] *= -DownscaleMin[A];
+					}
+				}
+			}
+
+			// Undo pivot offset
+			Position = ActorScaleInv * ScaledInvPivotTransform.TransformPosition(Position);
+		}
+
+		// Store the result in SoA layout
+		OutPositions.SetNumUninitialized(3 * VertexCount);
+		double* OutX = OutPositions.GetData();
+		double* OutY = OutX + VertexCount;
+		double* OutZ = OutY + VertexCount;
+		for (int32 I = 0; I < VertexCount; ++I)
+		{
+			OutX[I] = Positions[I].X;
+			OutY[I] = Positions[I].Y;
+			OutZ[I] = Positions[I].Z;
+		}
+	}
+} // namespace
+
+SIZE_T FMRUKGridSliceMeshData::GetAllocatedSize() const
+{
+	return Positions.GetAllocatedSize() + Normals.GetAllocatedSize() + UVs.GetAllocatedSize() + Colors.GetAllocatedSize() + Triangles.GetAllocatedSize();
+}
+
+FMRUKGridSliceCache& FMRUKGridSliceCache::Get()
+{
+	static FMRUKGridSliceCache Instance;
+	return Instance;
+}
+
+TSharedPtr<const FMRUKGridSlice> FMRUKGridSliceCache::Find(const FMRUKGridSliceKey& Key)
+{
+	check(IsInGameThread());
+	FCachedSlice* Cached = Slices.Find(Key);
+	if (!Cached)
+	{
+		++Stats.Misses;
+		return nullptr;
+	}
+	++Stats.Hits;
+	Cached->LastUse = ++UseCounter;
+	return Cached->Slice;
+}
+
+void FMRUKGridSliceCache::Add(const FMRUKGridSliceKey& Key, TSharedRef<const FMRUKGridSlice> Slice)
+{
+	check(IsInGameThread());
+	if (const FCachedSlice* Existing = Slices.Find(Key))
 	{
-		// We don't want to have division by zero further down the line
-		BorderPos[I] = FMath::Clamp(BorderPos[I], DBL_EPSILON, 1.0);
-		BorderNeg[I] = FMath::Clamp(BorderNeg[I], DBL_EPSILON, 1.0);
-
-		BorderPosLS[I] = BBoxScaledPivot.Max[I] - (1.0 - BorderPos[I]) * FMath::Abs(BBoxScaledPivot.Max[I]);
-		BorderNegLS[I] = BBoxScaledPivot.Min[I] + (1.0 - BorderNeg[I]) * FMath::Abs(BBoxScaledPivot.Min[I]);
-
-		StubPos[I] = FMath::Abs(BBox.Max[I] - BorderPosLS[I]);
-		StubNeg[I] = FMath::Abs(BBox.Min[I] - BorderNegLS[I]);
-
-		BBoxInnerMax[I] = BBox.Max[I] - StubPos[I];
-		BBoxInnerMin[I] = BBox.Min[I] + StubNeg[I];
-
-		// Max may be negative and Min may be positive in case the stubs are greater than
-		// the scaled down bounding box and therefore don't fit the scaled bounding box.
-		// This case gets treated special down below.
-		BBoxInnerScaledMax[I] = BBoxScaled.Max[I] - StubPos[I];
-		BBoxInnerScaledMin[I] = BBoxScaled.Min[I] + StubNeg[I];
-
-		InnerBoxScaleRatioMax[I] = FMath::Max(0.0, BBoxInnerScaledMax[I] / BBoxInnerMax[I]);
-		InnerBoxScaleRatioMin[I] = FMath::Max(0.0, BBoxInnerScaledMin[I] / BBoxInnerMin[I]);
-
-		// When Downscale[Min/Max] needs to be applied the temporary bounding box is
-		// Max == StubPos, Min == StubNeg. Therefore get the ratio between it and the
-		// expected scaled down bounding box to calculate the scale that needs
-		// to be applied
-		DownscaleMax[I] = BBoxScaled.Max[I] / StubPos[I];
-		DownscaleMin[I] = BBoxScaled.Min[I] / StubNeg[I];
+		AllocatedBytes -= Existing->Slice->GetAllocatedSize();
 	}
+	AllocatedBytes += Slice->GetAllocatedSize();
+	Slices.Add(Key, FCachedSlice{ MoveTemp(Slice), ++UseCounter });
+	Evict();
+}
 
-	// Process vertices
+TSharedRef<const FMRUKGridSliceMeshData> FMRUKGridSliceCache::FindOrAddMeshData(const UStaticMesh* Mesh)
+{
+	check(IsInGameThread());
+	const FObjectKey Key(Mesh);
+	if (const TSharedRef<const FMRUKGridSliceMeshData>* Found = MeshData.Find(Key))
+	{
+		if ((*Found)->RenderData == Mesh->GetRenderData())
+		{
+			return *Found;
+		}
+
+		// The mesh has been rebuilt, everything that has been computed from the old vertices is out of date
+		AllocatedBytes -= (*Found)->GetAllocatedSize();
+		MeshData.Remove(Key);
+		for (auto It = Slices.CreateIterator(); It; ++It)
+		{
+			if (It->Key.Mesh == Key)
+			{
+				AllocatedBytes -= It->Value.Slice->GetAllocatedSize();
+				It.RemoveCurrent();
+			}
+		}
+	}
 
-	// If the center shouldn't be scaled we need to take care of the case when the original
-	// center vertices would be outside of the expected downscaled bounding box. Therefore, iterate
-	// through all vertices and check if the center vertices are outside. If they are outside we need
-	// to scale down the center part as usually.
-	// This unfortunately has to be done in a separate first pass.
-	bool ScaleDownCenter[3] = { false, false, false };
+	const TSharedRef<FMRUKGridSliceMeshData> Data = MakeShared<FMRUKGridSliceMeshData>();
+	const FStaticMeshLODResources& LODResources = Mesh->GetRenderData()->LODResources[0];
+	const FStaticMeshVertexBuffers& VertexBuffers = LODResources.VertexBuffers;
+	const FRawStaticIndexBuffer& IndexBuffer = LODResources.IndexBuffer;
 
 	const int32 VertexCount = LODResources.GetNumVertices();
+	Data->NumVertices = VertexCount;
+	Data->Positions.SetNumUninitialized(3 * VertexCount);
+	Data->Normals.SetNum(VertexCount);
+	Data->UVs.SetNum(VertexCount);
+	Data->Colors.SetNum(VertexCount);
 	for (int32 I = 0; I < VertexCount; ++I)
 	{
 		const FVector3f& Normal = VertexBuffers.StaticMeshVertexBuffer.VertexTangentZ(I);
-		Normals[I] = FVector(Normal.X, Normal.Y, Normal.Z);
+		Data->Normals[I] = FVector(Normal.X, Normal.Y, Normal.Z);
 
 		const FVector2f& UV = VertexBuffers.StaticMeshVertexBuffer.GetVertexUV(I, 0);
-		UVs[I] = FVector2D(UV.X, UV.Y);
+		Data->UVs[I] = FVector2D(UV.X, UV.Y);
 
 		const FVector3f& P = VertexBuffers.PositionVertexBuffer.VertexPosition(I);
+		Data->Positions[I] = P.X;
+		Data->Positions[VertexCount + I] = P.Y;
+		Data->Positions[2 * VertexCount + I] = P.Z;
+	}
+
+	Data->Triangles.SetNum(IndexBuffer.GetNumIndices());
+	for (int32 I = 0; I < IndexBuffer.GetNumIndices(); ++I)
+	{
+		Data->Triangles[I] = IndexBuffer.GetIndex(I);
+	}
+
+	Data->Bounds = Mesh->GetBoundingBox();
+	Data->RenderData = Mesh->GetRenderData();
+
+	AllocatedBytes += Data->GetAllocatedSize();
+	MeshData.Add(Key, Data);
+	Evict();
+	return Data;
+}
+
+void FMRUKGridSliceCache::SetMaxBytes(SIZE_T InMaxBytes)
+{
+	MaxBytes = InMaxBytes;
+	Evict();
+}
 
-		// Apply pivot offset
-		Positions[I] = PivotTransform.TransformPosition(FVector(P.X, P.Y, P.Z));
-		const FVector& Position = Positions[I];
+void FMRUKGridSliceCache::Reset()
+{
+	Slices.Empty();
+	MeshData.Empty();
+	AllocatedBytes = 0;
+	Stats = {};
+}
 
-		for (int32 A = 0; A < 3; ++A)
+void FMRUKGridSliceCache::Evict()
+{
+	while (AllocatedBytes > MaxBytes && !Slices.IsEmpty())
+	{
+		auto LeastRecentlyUsed = Slices.CreateIterator();
+		for (auto It = Slices.CreateIterator(); It; ++It)
 		{
-			if ((0.0 <= Position[A] && Position[A] <= BorderPosLS[A]) && (Position[A] > BBoxInnerScaledMax[A]))
+			if (It->Value.LastUse < LeastRecentlyUsed->Value.LastUse)
 			{
-				ScaleDownCenter[A] = true;
-			}
-			else if ((BorderNegLS[A] <= Position[A] && Position[A] <= 0.0) && (Position[A] < BBoxInnerScaledMin[A]))
-			{
-				ScaleDownCenter[A] = true;
+				LeastRecentlyUsed = It;
 			}
 		}
+		AllocatedBytes -= LeastRecentlyUsed->Value.Slice->GetAllocatedSize();
+		LeastRecentlyUsed.RemoveCurrent();
+		++Stats.Evictions;
 	}
 
-	bool bScaleCenter[3] = {};
-	bScaleCenter[0] = ScaleCenterMode & static_cast<uint8>(EMRUKScaleCenterMode::XAxis) ? true : false;
-	bScaleCenter[1] = ScaleCenterMode & static_cast<uint8>(EMRUKScaleCenterMode::YAxis) ? true : false;
-	bScaleCenter[2] = ScaleCenterMode & static_cast<uint8>(EMRUKScaleCenterMode::ZAxis) ? true : false;
-
-	for (FVector& Position : Positions)
+	// Mesh data that is still referenced by a slice or a caller has to stay
+	for (auto It = MeshData.CreateIterator(); It && AllocatedBytes > MaxBytes; ++It)
 	{
-		// Apply computations on each axis
-
-		for (int32 A = 0; A < 3; ++A)
+		if (It->Value.GetSharedReferenceCount() == 1)
 		{
-			if ((bScaleCenter[A] || ScaleDownCenter[A]) && (0.0 <= Position[A] && Position[A] <= BorderPosLS[A]))
-			{
-				// Vertex is inside the inner distance and should be stretched
-				Position[A] *= InnerBoxScaleRatioMax[A];
-			}
-			else if ((bScaleCenter[A] || ScaleDownCenter[A]) && (BorderNegLS[A] <= Position[A] && Position[A] <= 0.0))
-			{
-				// Vertex is inside the inner distance and should be stretched
-				Position[A] *= InnerBoxScaleRatioMin[A];
-			}
-			else if (BorderPosLS[A] < Position[A])
-			{
-				// Vertex is inside the outer stub and should not be stretched
-				// Perform linear transform of vertices into their expect position
-				Position[A] = BorderPosLS[A] * InnerBoxScaleRatioMax[A] + (Position[A] - BorderPosLS[A]);
-				if (BBoxInnerScaledMax[A] < 0.0)
-				{
-					// The mesh that would result from the linear transform above is still not small enough to
-					// fit into the expected scaled down bounding box. This means the stubs need to be scaled down
-					// to make them fit.
-					Position[A] *= DownscaleMax[A];
-				}
-			}
-			else if (Position[A] < BorderNegLS[A])
-			{
-				// Vertex is inside the outer stub and should not be stretched
-				// Perform linear transform of vertices into their expect position
-				Position[A] = BorderNegLS[A] * InnerBoxScaleRatioMin[A] - (BorderNegLS[A] - Position[A]);
-				if (BBoxInnerScaledMin[A] > 0.0)
-				{
-					// The mesh that would result from the linear transform above is still not small enough to
-					// fit into the expected scaled down bounding box. This means the stubs need to be scaled down
-					// to make them fit.
-					Position[A] *= -DownscaleMin[A];
-				}
-			}
+			AllocatedBytes -= It->Value->GetAllocatedSize();
+			It.RemoveCurrent();
 		}
+	}
+}
+
+FMRUKGridSliceKey UMRUKGridSliceResizerComponent::MakeSliceKey() const
+{
+	FMRUKGridSliceKey Key;
+	Key.Mesh = FObjectKey(Mesh);
+	Key.Scale = GetOwner() ? GetOwner()->GetActorScale() : FVector::OneVector;
+	Key.BorderPositive = FVector(BorderXPositive, BorderYPositive, BorderZPositive);
+	Key.BorderNegative = FVector(BorderXNegative, BorderYNegative, BorderZNegative);
+	Key.SlicerPivotOffset = SlicerPivotOffset;
+	Key.ScaleCenterMode = ScaleCenterMode;
+	return Key;
+}
 
-		// Undo pivot offset
-		Position = ActorScaleInv * ScaledInvPivotTransform.TransformPosition(Position);
+void UMRUKGridSliceResizerComponent::SliceMesh()
+{
+	if (!Mesh)
+	{
+		return;
 	}
 
-	Triangles.SetNum(IndexBuffer.GetNumIndices());
-	for (int32 I = 0; I < IndexBuffer.GetNumIndices(); ++I)
+	if (!Mesh->bAllowCPUAccess)
 	{
-		Triangles[I] = IndexBuffer.GetIndex(I);
+		UE_LOG(LogMRUK, Error, TEXT("Can not slice a mesh that has no CPU access. Make sure you enable CPU access on the static mesh asset."));
+		return;
+	}
+
+	const FMRUKGridSliceKey Key = MakeSliceKey();
+	if (AppliedRenderData == Mesh->GetRenderData() && AppliedSliceKey == Key && bAppliedSliceCollision == bGenerateCollision && ProcMesh->GetNumSections() > 0)
+	{
+		// The procedural mesh shows this slice already
+		ProcMesh->SetMaterial(0, Mesh->GetMaterial(0));
+		return;
+	}
+
+	FMRUKGridSliceCache& Cache = FMRUKGridSliceCache::Get();
+	const TSharedRef<const FMRUKGridSliceMeshData> MeshData = Cache.FindOrAddMeshData(Mesh);
+	TSharedPtr<const FMRUKGridSlice> Slice = Cache.Find(Key);
+	if (!Slice)
+	{
+		const TSharedRef<FMRUKGridSlice> NewSlice = MakeShared<FMRUKGridSlice>();
+		NewSlice->MeshData = MeshData;
+		ComputeGridSlicePositions(*MeshData, Key, NewSlice->Positions);
+		Cache.Add(Key, NewSlice);
+		Slice = NewSlice;
+	}
+
+	const int32 VertexCount = MeshData->NumVertices;
+	const double* SliceX = Slice->Positions.GetData();
+	const double* SliceY = SliceX + VertexCount;
+	const double* SliceZ = SliceY + VertexCount;
+	TArray<FVector> Positions;
+	Positions.SetNumUninitialized(VertexCount);
+	for (int32 I = 0; I < VertexCount; ++I)
+	{
+		Positions[I] = FVector(SliceX[I], SliceY[I], SliceZ[I]);
 	}
 
 	ProcMesh->ClearMeshSection(0);
-	ProcMesh->CreateMeshSection(0, Positions, Triangles, Normals, UVs, Colors, {}, bGenerateCollision);
+	ProcMesh->CreateMeshSection(0, Positions, MeshData->Triangles, MeshData->Normals, MeshData->UVs, MeshData->Colors, {}, bGenerateCollision);
 	ProcMesh->SetMaterial(0, Mesh->GetMaterial(0));
+
+	AppliedSliceKey = Key;
+	AppliedRenderData = Mesh->GetRenderData();
+	bAppliedSliceCollision = bGenerateCollision;
+	++MeshSectionUpdates;
 }
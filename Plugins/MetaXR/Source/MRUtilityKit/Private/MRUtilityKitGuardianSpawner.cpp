@@ -126,16 +126,36 @@ void AMRUKGuardianSpawner::Tick(float DeltaSeconds)
 		FVector HeadsetPosition(0.f);
 		GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, HeadsetOrientation, HeadsetPosition);
 
-		FVector SurfacePosition = FVector::ZeroVector;
-		double SurfaceDistance = 0.0;
-		FMRUKLabelFilter LabelFilter;
-		LabelFilter.ExcludedLabels = { FMRUKLabels::Ceiling, FMRUKLabels::Floor };
-		CurrentRoom->TryGetClosestSurfacePosition(HeadsetPosition, SurfacePosition, SurfaceDistance, LabelFilter);
+		DynamicGuardianMaterial->SetScalarParameterValue(TEXT("Fade"), ComputeGuardianFade(CurrentRoom, HeadsetPosition));
+	}
+}
 
-		const auto WorldToMeters = GetWorldSettings()->WorldToMeters;
-		const auto GuardianFade = FMath::Clamp(1.0 - ((SurfaceDistance / WorldToMeters) / GuardianDistance), 0.0, 1.0);
-		DynamicGuardianMaterial->SetScalarParameterValue(TEXT("Fade"), GuardianFade);
+double AMRUKGuardianSpawner::ComputeGuardianFade(AMRUKRoom* Room, const FVector& HeadsetPosition)
+{
+	FMRUKLabelFilter LabelFilter;
+	LabelFilter.ExcludedLabels = { FMRUKLabels::Ceiling, FMRUKLabels::Floor };
+	const auto WorldToMeters = GetWorldSettings()->WorldToMeters;
+
+	double SurfaceDistance = 0.0;
+	if (UseDistanceVolume)
+	{
+		// Nothing further away than the guardian distance contributes to the fade
+		const double MaxDistance = GuardianDistance * WorldToMeters;
+		if (DistanceVolumeRoom != Room || !DistanceVolume.IsValid() || DistanceVolume.GetMaxDistance() != MaxDistance
+			|| !DistanceVolume.GetRoomTransform().Equals(Room->GetActorTransform()))
+		{
+			DistanceVolume.Build(Room, LabelFilter, DistanceVolumeVoxelSize * WorldToMeters, MaxDistance);
+			DistanceVolumeRoom = Room;
+		}
+		SurfaceDistance = DistanceVolume.SampleDistance(HeadsetPosition);
+	}
+	else
+	{
+		FVector SurfacePosition = FVector::ZeroVector;
+		Room->TryGetClosestSurfacePosition(HeadsetPosition, SurfacePosition, SurfaceDistance, LabelFilter);
 	}
+
+	return FMath::Clamp(1.0 - ((SurfaceDistance / WorldToMeters) / GuardianDistance), 0.0, 1.0);
 }
 
 void AMRUKGuardianSpawner::BeginPlay()
@@ -144,6 +164,14 @@ void AMRUKGuardianSpawner::BeginPlay()
 
 	SetGuardianMaterial(GuardianMaterial);
 
+	if (UseDistanceVolume)
+	{
+		// The distance volume has to be built again when the anchors of the room change
+		const auto Subsystem = GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+		Subsystem->OnRoomUpdated.AddUniqueDynamic(this, &AMRUKGuardianSpawner::OnRoomUpdated);
+		Subsystem->OnRoomRemoved.AddUniqueDynamic(this, &AMRUKGuardianSpawner::OnRoomRemoved);
+	}
+
 #if WITH_EDITOR
 	if (OculusXRTelemetry::IsActive())
 	{
@@ -192,6 +220,10 @@ void AMRUKGuardianSpawner::PostEditChangeProperty(FPropertyChangedEvent& Propert
 	{
 		SetGuardianMaterial(GuardianMaterial);
 	}
+	else if (PropertyName == GET_MEMBER_NAME_CHECKED(AMRUKGuardianSpawner, DistanceVolumeVoxelSize))
+	{
+		DistanceVolume.Reset();
+	}
 	Super::PostEditChangeProperty(PropertyChangedEvent);
 }
 #endif
@@ -209,6 +241,11 @@ void AMRUKGuardianSpawner::OnRoomCreated(AMRUKRoom* Room)
 
 void AMRUKGuardianSpawner::OnRoomUpdated(AMRUKRoom* Room)
 {
+	if (DistanceVolumeRoom == Room)
+	{
+		DistanceVolume.Reset();
+	}
+
 	if (!SpawnedGuardians.Find(Room))
 	{
 		// A room was updated that we don't care about. If we are in current room only mode
@@ -220,6 +257,11 @@ void AMRUKGuardianSpawner::OnRoomUpdated(AMRUKRoom* Room)
 
 void AMRUKGuardianSpawner::OnRoomRemoved(AMRUKRoom* Room)
 {
+	if (DistanceVolumeRoom == Room)
+	{
+		DistanceVolume.Reset();
+		DistanceVolumeRoom.Reset();
+	}
 	DestroyGuardians(Room);
 }
 
@@ -40,9 +40,34 @@ void AMRUKLightDispatcher::FillParameterCollection()
 		return;
 	}
 
-	UMaterialParameterCollectionInstance* Instance = GetWorld()->GetParameterCollectionInstance(Collection);
+	if (CachedCollection != Collection)
+	{
+		InvalidateParameterCache();
+		CachedCollection = Collection;
+	}
+
+	// It's not possible to expand the amount of parameters in collection at runtime,
+	// lights that exceed the count of existing parameters are ignored
+	const int32 NumLights = FMath::Min(PointLightComponents.Num(), Collection->VectorParameters.Num() / 3);
+	while (LightParameters.Num() < NumLights)
+	{
+		const int32 i = LightParameters.Num();
+		FLightParameters& Parameters = LightParameters.AddDefaulted_GetRef();
+		Parameters.PositionName = FName(*FString::Printf(TEXT("PointLightPosition%d"), i));
+		Parameters.DataName = FName(*FString::Printf(TEXT("PointLightData%d"), i));
+		Parameters.ColorName = FName(*FString::Printf(TEXT("PointLightColor%d"), i));
+	}
+
+	const auto WriteVectorParameter = [this](int32 Index, FName Name, const FLinearColor& Value, FLinearColor& WrittenValue) {
+		FCollectionVectorParameter& Parameter = Collection->VectorParameters[Index];
+		Parameter.ParameterName = Name;
+		Parameter.DefaultValue = Value;
+		WrittenValue = Value;
+		++ParameterWrites;
+	};
 
-	for (int i = 0; i < PointLightComponents.Num(); i++)
+	bool bChanged = false;
+	for (int i = 0; i < NumLights; i++)
 	{
 		const UPointLightComponent* Light = PointLightComponents[i];
 		if (!IsValid(Light))
@@ -50,38 +75,66 @@ void AMRUKLightDispatcher::FillParameterCollection()
 			continue;
 		}
 
-		const int Step = i * 3;
+		const FLinearColor Position(Light->GetComponentLocation());
+		const FLinearColor Data(1.f / Light->AttenuationRadius, Light->ComputeLightBrightness(), Light->LightFalloffExponent, Light->bUseInverseSquaredFalloff);
+		const FLinearColor Color = Light->GetLightColor();
 
-		// It's not possible to expand the amount of parameters in collection at runtime,
-		// in case we exceed the count of existing parameters break the loop
-		if (Collection->VectorParameters.Num() < Step + 3)
+		// Only touch the parameters of lights that moved or changed
+		const int Step = i * 3;
+		FLightParameters& Parameters = LightParameters[i];
+		if (!Parameters.bWritten || Parameters.Position != Position)
 		{
-			break;
+			WriteVectorParameter(Step, Parameters.PositionName, Position, Parameters.Position);
+			bChanged = true;
 		}
+		if (!Parameters.bWritten || Parameters.Data != Data)
+		{
+			WriteVectorParameter(Step + 1, Parameters.DataName, Data, Parameters.Data);
+			bChanged = true;
+		}
+		if (!Parameters.bWritten || Parameters.Color != Color)
+		{
+			WriteVectorParameter(Step + 2, Parameters.ColorName, Color, Parameters.Color);
+			bChanged = true;
+		}
+		Parameters.bWritten = true;
+	}
 
-		// Prepare parameters
-		FCollectionVectorParameter PositionParam, DataParam, ColorParam;
-
-		PositionParam.ParameterName = FName("PointLightPosition" + FString::FromInt(i));
-		DataParam.ParameterName = FName("PointLightData" + FString::FromInt(i));
-		ColorParam.ParameterName = FName("PointLightColor" + FString::FromInt(i));
-
-		PositionParam.DefaultValue = FLinearColor(Light->GetComponentLocation());
-		DataParam.DefaultValue = FLinearColor(1.f / Light->AttenuationRadius, Light->ComputeLightBrightness(), Light->LightFalloffExponent, Light->bUseInverseSquaredFalloff);
-		ColorParam.DefaultValue = Light->GetLightColor();
+	// Send count of lights
+	if (WrittenLightCount != PointLightComponents.Num())
+	{
+		static const FName TotalLightsName(TEXT("TotalLights"));
+		if (!Collection->ScalarParameters.IsEmpty())
+		{
+			Collection->ScalarParameters[0].DefaultValue = PointLightComponents.Num();
+		}
+		UKismetMaterialLibrary::SetScalarParameterValue(GetWorld(), Collection, TotalLightsName, PointLightComponents.Num());
+		WrittenLightCount = PointLightComponents.Num();
+		++ParameterWrites;
+		bChanged = true;
+	}
 
-		// Fill collection's vector parameters
-		Collection->VectorParameters[Step] = PositionParam;
-		Collection->VectorParameters[Step + 1] = DataParam;
-		Collection->VectorParameters[Step + 2] = ColorParam;
+	if (!bChanged)
+	{
+		++SkippedCollectionUpdates;
+		return;
 	}
 
-	// Send count of lights
-	Collection->ScalarParameters[0].DefaultValue = PointLightComponents.Num();
-	UKismetMaterialLibrary::SetScalarParameterValue(GetWorld(), Collection, "TotalLights", PointLightComponents.Num());
+	// Update instance once for all parameters that changed
+	if (UMaterialParameterCollectionInstance* Instance = GetWorld()->GetParameterCollectionInstance(Collection))
+	{
+		Instance->UpdateRenderState(false);
+	}
+	++AppliedCollectionUpdates;
+}
 
-	// Update instance
-	Instance->UpdateRenderState(false);
+void AMRUKLightDispatcher::InvalidateParameterCache()
+{
+	for (FLightParameters& Parameters : LightParameters)
+	{
+		Parameters.bWritten = false;
+	}
+	WrittenLightCount = INDEX_NONE;
 }
 
 void AMRUKLightDispatcher::AddAdditionalPointLightActor(AActor* Actor)
@@ -113,6 +166,7 @@ void AMRUKLightDispatcher::FillPointLights()
 {
 	// Make sure we don't have duplicates in the array
 	PointLightComponents.Empty();
+	InvalidateParameterCache();
 
 	if (ShouldFetchPointLightsAtBeginPlay)
 	{
@@ -163,4 +217,5 @@ void AMRUKLightDispatcher::AddPointLightsFromActor(const AActor* Actor)
 	TArray<UPointLightComponent*> LightComponents;
 	Actor->GetComponents(LightComponents, false);
 	PointLightComponents.Append(LightComponents);
+	InvalidateParameterCache();
 }
@@ -3,6 +3,7 @@
 #include "MRUtilityKitRoom.h"
 #include "MRUtilityKitAnchor.h"
 #include "MRUtilityKitSerializationHelpers.h"
+#include "MRUtilityKitSceneSnapshot.h"
 #include "MRUtilityKitSeatsComponent.h"
 #include "MRUtilityKitSubsystem.h"
 #include "MRUtilityKitBPLibrary.h"
@@ -89,6 +90,17 @@ namespace
 		return ParentAnchor->ActorToWorld().TransformPosition(LocalPos);
 	}
 
+	double SquaredDistanceToPolygonEdges(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+	{
+		double MinDistanceSquared = UE_BIG_NUMBER;
+		for (int32 I = 0, J = Polygon.Num() - 1; I < Polygon.Num(); J = I++)
+		{
+			const FVector2D Closest = FMath::ClosestPointOnSegment2D(Point, Polygon[J], Polygon[I]);
+			MinDistanceSquared = FMath::Min(MinDistanceSquared, FVector2D::DistSquared(Point, Closest));
+		}
+		return MinDistanceSquared;
+	}
+
 	const float InvSqrt2 = 1.0f / FMath::Sqrt(2.0f);
 
 	bool IsActorOrientationHorizontal(const AActor* Actor)
@@ -118,6 +130,9 @@ void AMRUKRoom::EndPlay(EEndPlayReason::Type Reason)
 		OnAnchorRemoved.Broadcast(Anchor);
 		Anchor->Destroy();
 	}
+	AnchorBVH.Reset();
+	AnchorHierarchy.Reset();
+	InvalidateSamplers();
 
 	GetGameInstance()->GetSubsystem<UMRUKSubsystem>()->UnregisterRoom(this);
 	Super::EndPlay(Reason);
@@ -172,9 +187,17 @@ void AMRUKRoom::LoadFromData(UMRUKRoomData* RoomData)
 	for (auto& OldAnchor : AnchorsToRemove)
 	{
 		OnAnchorRemoved.Broadcast(OldAnchor);
+		AnchorBVH.Remove(OldAnchor);
+		AnchorHierarchy.Remove(OldAnchor);
 		OldAnchor->Destroy();
 	}
 
+	// Refit the anchors that changed, anchors that still fit into their enlarged bounds are left untouched
+	for (const auto& Anchor : AllAnchors)
+	{
+		UpdateAnchorInBVH(Anchor);
+	}
+
 	InitializeRoom();
 
 	for (auto& Anchor : AnchorsUpdated)
@@ -204,6 +227,24 @@ TSharedRef<FJsonObject> AMRUKRoom::JsonSerialize()
 	return JsonObject;
 }
 
+FMRUKSnapshotRoom AMRUKRoom::SnapshotSerialize()
+{
+	FMRUKSnapshotRoom SnapshotRoom;
+	SnapshotRoom.UUID = AnchorUUID;
+	SnapshotRoom.FloorUuid = RoomLayout.FloorUuid;
+	SnapshotRoom.CeilingUuid = RoomLayout.CeilingUuid;
+	SnapshotRoom.WallsUuid = RoomLayout.WallsUuid;
+	SnapshotRoom.Anchors.Reserve(AllAnchors.Num());
+	for (const auto& Anchor : AllAnchors)
+	{
+		if (Anchor)
+		{
+			SnapshotRoom.Anchors.Add(Anchor->SnapshotSerialize());
+		}
+	}
+	return SnapshotRoom;
+}
+
 bool AMRUKRoom::Corresponds(UMRUKRoomData* RoomData) const
 {
 	if (!RoomData)
@@ -270,20 +311,61 @@ void AMRUKRoom::AddAnchorToRoom(AMRUKAnchor* Anchor)
 	{
 		WallAnchors.Push(Anchor);
 	}
-	if (Anchor->HasLabel(FMRUKLabels::GlobalMesh))
+	if (Anchor->HasLabelMask(FMRUKLabelMasks::GlobalMesh))
 	{
 		GlobalMeshAnchor = Anchor;
 	}
-	if (Anchor->HasLabel(FMRUKLabels::Couch))
+	if (Anchor->HasLabelMask(FMRUKLabelMasks::Couch))
 	{
 		SeatAnchors.Push(Anchor);
 	}
 
 	AllAnchors.Push(Anchor);
+	InvalidateSamplers();
+}
+
+FBox AMRUKRoom::ComputeAnchorBoundsInRoomSpace(const AMRUKAnchor* Anchor) const
+{
+	FBox Bounds(ForceInit);
+	if (!Anchor)
+	{
+		return Bounds;
+	}
+
+	const FTransform AnchorToRoom = Anchor->GetActorTransform().GetRelativeTransform(GetActorTransform());
+	if (Anchor->PlaneBounds.bIsValid)
+	{
+		const FBox2D& PlaneBounds = Anchor->PlaneBounds;
+		Bounds += AnchorToRoom.TransformPosition(FVector(0.0, PlaneBounds.Min.X, PlaneBounds.Min.Y));
+		Bounds += AnchorToRoom.TransformPosition(FVector(0.0, PlaneBounds.Min.X, PlaneBounds.Max.Y));
+		Bounds += AnchorToRoom.TransformPosition(FVector(0.0, PlaneBounds.Max.X, PlaneBounds.Min.Y));
+		Bounds += AnchorToRoom.TransformPosition(FVector(0.0, PlaneBounds.Max.X, PlaneBounds.Max.Y));
+	}
+	if (Anchor->VolumeBounds.IsValid)
+	{
+		Bounds += Anchor->VolumeBounds.TransformBy(AnchorToRoom);
+	}
+	return Bounds;
+}
+
+void AMRUKRoom::UpdateAnchorInBVH(AMRUKAnchor* Anchor)
+{
+	if (!Anchor)
+	{
+		return;
+	}
+	if (Anchor == GlobalMeshAnchor)
+	{
+		// The global mesh is raycasted through physics and therefore not part of the hierarchy
+		AnchorBVH.Remove(Anchor);
+		return;
+	}
+	AnchorBVH.InsertOrUpdate(Anchor, ComputeAnchorBoundsInRoomSpace(Anchor));
 }
 
 void AMRUKRoom::InitializeRoom()
 {
+	InvalidateSamplers();
 	ComputeRoomBounds();
 	ComputeAnchorHierarchy();
 	ComputeSeats();
@@ -311,161 +393,15 @@ void AMRUKRoom::ComputeRoomBounds()
 
 void AMRUKRoom::ComputeAnchorHierarchy()
 {
-	// Reset anchor hierarchy
-	for (auto& Anchor : AllAnchors)
-	{
-		Anchor->ParentAnchor = nullptr;
-		Anchor->ChildAnchors.Empty();
-	}
-
-	constexpr float OffsetTolerance = 4.0f; // 4 cm offset allowed
-	// Find things where are attached to walls such as doors, windows frames or wall art
-	for (const auto& WallAnchor : WallAnchors)
-	{
-		if (!WallAnchor)
-		{
-			continue;
-		}
-		const auto& WallTransform = WallAnchor->GetTransform();
-		const auto WallNormal = WallTransform.GetUnitAxis(EAxis::X);
-		for (const auto& ChildAnchor : AllAnchors)
-		{
-			// Don't parent walls to themselves
-			if (ChildAnchor == WallAnchor)
-			{
-				continue;
-			}
-			const auto& ChildTransform = ChildAnchor->GetTransform();
-			const auto ChildNormal = ChildTransform.GetUnitAxis(EAxis::X);
-			// Check that the two transforms face the same direction
-			if (!FVector::Coincident(WallNormal, ChildNormal))
-			{
-				continue;
-			}
-			// Check that the position is close to the surface (they are a little bit offset
-			// to prevent Z fighting so allow for that).
-			auto LocalPos = WallTransform.InverseTransformPosition(ChildTransform.GetLocation());
-			if (FMath::Abs(LocalPos.X) > OffsetTolerance)
-			{
-				continue;
-			}
-			// Check that the anchor is within the wall boundary
-			if (!WallAnchor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z)))
-			{
-				continue;
-			}
-			// We have a match
-			ensureMsgf(!ChildAnchor->ParentAnchor, TEXT("This anchor already has a parent"));
-			ChildAnchor->ParentAnchor = WallAnchor;
-			WallAnchor->ChildAnchors.Push(ChildAnchor);
-		}
-	}
-
-	// Find volumes on the floor
 	if (FloorAnchor)
 	{
-		const auto& FloorTransform = FloorAnchor->GetTransform();
-		const auto FloorNormal = FloorTransform.GetUnitAxis(EAxis::X);
+		const auto FloorNormal = FloorAnchor->GetTransform().GetUnitAxis(EAxis::X);
 		ensureMsgf(FVector::Coincident(FloorNormal, FVector::DownVector), TEXT("Floor normal should be pointing downwards"));
-		auto FloorHeight = FloorTransform.GetLocation().Z;
-		for (const auto& ChildAnchor : AllAnchors)
-		{
-			// Don't parent the floor to itself
-			if (ChildAnchor == FloorAnchor)
-			{
-				continue;
-			}
-			const auto& ChildTransform = ChildAnchor->GetTransform();
-			const auto ChildXAxis = ChildTransform.GetUnitAxis(EAxis::X);
-			const auto& ChildVolumeBounds = ChildAnchor->VolumeBounds;
-			// Only interested in scene volumes, the assumption is that all scene volumes have X axis pointing downwards
-			if (!ChildVolumeBounds.IsValid || !FVector::Coincident(ChildXAxis, FVector::DownVector))
-			{
-				continue;
-			}
-			auto ChildBottom = ChildTransform.GetLocation().Z - ChildVolumeBounds.Max.X;
-			// Check that the volume is on the floor
-			if (FMath::Abs(FloorHeight - ChildBottom) > OffsetTolerance)
-			{
-				continue;
-			}
-			auto LocalPos = FloorTransform.InverseTransformPosition(ChildTransform.GetLocation());
-			// Check that child anchor is within the bounds of the floor
-			if (!FloorAnchor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z)))
-			{
-				continue;
-			}
-			// We have a match
-			ensureMsgf(!ChildAnchor->ParentAnchor, TEXT("This anchor already has a parent"));
-			ChildAnchor->ParentAnchor = FloorAnchor;
-			FloorAnchor->ChildAnchors.Push(ChildAnchor);
-		}
 	}
 
-	// Find relationship between scene volumes
-	for (const auto& ParentAnchor : AllAnchors)
-	{
-		if (!ParentAnchor)
-		{
-			continue;
-		}
-		const auto& ParentTransform = ParentAnchor->GetTransform();
-		const auto ParentXAxis = ParentTransform.GetUnitAxis(EAxis::X);
-		const auto& ParentVolumeBounds = ParentAnchor->VolumeBounds;
-		// Only interested in scene volumes, the assumption is that all scene volumes have X axis pointing downwards
-		if (!ParentVolumeBounds.IsValid || !FVector::Coincident(ParentXAxis, FVector::DownVector))
-		{
-			continue;
-		}
-		auto ParentTop = ParentTransform.GetLocation().Z - ParentVolumeBounds.Min.X;
-		for (const auto& ChildAnchor : AllAnchors)
-		{
-			// Don't parent anchors to themselves
-			if (ChildAnchor == ParentAnchor)
-			{
-				continue;
-			}
-			const auto& ChildTransform = ChildAnchor->GetTransform();
-			const auto ChildXAxis = ChildTransform.GetUnitAxis(EAxis::X);
-			const auto& ChildVolumeBounds = ChildAnchor->VolumeBounds;
-			// Only interested in scene volumes, the assumption is that all scene volumes have X axis pointing downwards
-			if (!ChildVolumeBounds.IsValid || !FVector::Coincident(ChildXAxis, FVector::DownVector))
-			{
-				continue;
-			}
-			auto ChildBottom = ChildTransform.GetLocation().Z - ChildVolumeBounds.Max.X;
-			// Check that the two volumes are stack on top of each other
-			if (FMath::Abs(ParentTop - ChildBottom) > OffsetTolerance)
-			{
-				continue;
-			}
-			// Check that at least one of the corners of the child volume is inside the bounds of the parent's volume
-			// when projected onto the horizontal plane. This is to match the Scene Capture tool which requires the
-			// user to defined stacked volumes by starting with one corner of the volume which must be on the parent's
-			// volume.
-			bool AnyCornerInside = false;
-			for (int i = 0; i < 4; ++i)
-			{
-				// Get a different corner on each iteration of the loop (height is not important here)
-				FVector ChildLocalPos(0.0f, i < 2 ? ChildVolumeBounds.Min.Y : ChildVolumeBounds.Max.Y, i % 2 == 0 ? ChildVolumeBounds.Min.Z : ChildVolumeBounds.Max.Z);
-				auto LocalPos = ParentTransform.InverseTransformPosition(ChildTransform.TransformPosition(ChildLocalPos));
-				// Check that child anchor is within the bounds of the parent on the horizontal plane
-				if (LocalPos.Y >= ParentVolumeBounds.Min.Y && LocalPos.Y <= ParentVolumeBounds.Max.Y && LocalPos.Z >= ParentVolumeBounds.Min.Z && LocalPos.Z <= ParentVolumeBounds.Max.Z)
-				{
-					AnyCornerInside = true;
-					break;
-				}
-			}
-			if (!AnyCornerInside)
-			{
-				continue;
-			}
-			// We have a match
-			ensureMsgf(!ChildAnchor->ParentAnchor, TEXT("This anchor already has a parent"));
-			ChildAnchor->ParentAnchor = ParentAnchor;
-			ParentAnchor->ChildAnchors.Push(ChildAnchor);
-		}
-	}
+	// Only anchors that were added or changed since the last call get tested against their neighbours
+	const int32 NumEvaluated = AnchorHierarchy.Update(AllAnchors, WallAnchors, FloorAnchor);
+	UE_LOG(LogMRUK, Verbose, TEXT("Updated anchor hierarchy, %d of %d anchors re-evaluated"), NumEvaluated, AllAnchors.Num());
 }
 
 void AMRUKRoom::ComputeSeats()
@@ -541,40 +477,29 @@ bool AMRUKRoom::GenerateRandomPositionInRoomFromStream(FVector& OutPosition, con
 		// the MinDistanceToSurface requirement
 		return false;
 	}
-	FVector Position;
+
+	// The room is the floor polygon extruded up to the ceiling. Sampling the floor triangles by area and the height
+	// uniformly gives uniform positions in the room without having to reject positions outside of it.
+	// The walls stand on the edges of the floor, so the distance to the closest wall is the distance to the closest
+	// edge of the floor polygon.
+	const FTransform& FloorTransform = FloorAnchor->GetTransform();
+	const double MinDistanceToWallSquared = FMath::Square(MinDistanceToSurface / FloorTransform.GetMaximumAxisScale());
+	const double MinZ = RoomBounds.Min.Z + MinDistanceToSurface;
+	const double MaxZ = RoomBounds.Max.Z - MinDistanceToSurface;
+
 	constexpr int MaxIterations = 1000;
 	// Bail after MaxIteration tries to avoid infinite loop in case MinDistanceToSurface is too large
 	// and we can't find a position which does not intersect with the walls and volumes
 	for (int i = 0; i < MaxIterations; ++i)
 	{
-		if (MinDistanceToSurface > 0.0f)
+		const FVector LocalPosition = FloorAnchor->GenerateRandomPositionOnPlaneFromStream(RandomStream);
+		if (MinDistanceToSurface > 0.0f && SquaredDistanceToPolygonEdges(FloorAnchor->PlaneBoundary2D, FVector2D(LocalPosition.Y, LocalPosition.Z)) < MinDistanceToWallSquared)
 		{
-			// If MinDistanceToSurface is large then it can be more efficient to randomly generate points within
-			// the shrunken bounds of the room
-			Position.X = RandomStream.FRandRange(RoomBounds.Min.X + MinDistanceToSurface, RoomBounds.Max.X - MinDistanceToSurface);
-			Position.Y = RandomStream.FRandRange(RoomBounds.Min.Y + MinDistanceToSurface, RoomBounds.Max.Y - MinDistanceToSurface);
-			Position.Z = RandomStream.FRandRange(RoomBounds.Min.Z + MinDistanceToSurface, RoomBounds.Max.Z - MinDistanceToSurface);
-			if (!IsPositionInRoom(Position))
-			{
-				// Reject points that are outside the room
-				continue;
-			}
-			FVector SurfacePos;
-			double SurfaceDistance;
-			FMRUKLabelFilter Filter;
-			Filter.IncludedLabels = { FMRUKLabels::WallFace };
-			if (TryGetClosestSurfacePosition(Position, SurfacePos, SurfaceDistance, Filter, MinDistanceToSurface))
-			{
-				// Reject points that are too close to the walls
-				continue;
-			}
-		}
-		else
-		{
-			Position = FloorAnchor->GenerateRandomPositionOnPlaneFromStream(RandomStream);
-			Position = FloorAnchor->GetTransform().TransformPosition(Position);
-			Position.Z = RandomStream.FRandRange(RoomBounds.Min.Z + MinDistanceToSurface, RoomBounds.Max.Z - MinDistanceToSurface);
+			// Reject points that are too close to the walls
+			continue;
 		}
+		FVector Position = FloorTransform.TransformPosition(LocalPosition);
+		Position.Z = RandomStream.FRandRange(MinZ, MaxZ);
 		if (AvoidVolumes && IsPositionInSceneVolume(Position, true, MinDistanceToSurface))
 		{
 			// Reject points inside volumes if avoid volumes has been enabled
@@ -589,15 +514,101 @@ bool AMRUKRoom::GenerateRandomPositionInRoomFromStream(FVector& OutPosition, con
 bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge,
 	FMRUKLabelFilter LabelFilter, FVector& OutPosition, FVector& OutNormal)
 {
-	TArray<Surface> Surfaces;
-	float TotalUsableSurfaceArea = 0.0f;
-	const float MinWidth = 2.0f * MinDistanceToEdge;
+	return GenerateRandomPositionOnSurfaceFromStream(SpawnLocation, MinDistanceToEdge, LabelFilter, FRandomStream(FMath::Rand()), OutPosition, OutNormal);
+}
 
+bool AMRUKRoom::GenerateRandomPositionOnSurfaceFromStream(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge,
+	FMRUKLabelFilter LabelFilter, const FRandomStream& RandomStream, FVector& OutPosition, FVector& OutNormal)
+{
 	OutPosition = FVector::ZeroVector;
 	OutNormal = FVector::ForwardVector;
+
+	FSurfaceSampler TemporarySampler;
+	const FSurfaceSampler& Sampler = GetOrCreateSurfaceSampler(SpawnLocation, MinDistanceToEdge, LabelFilter.Compile(), TemporarySampler);
+	if (Sampler.SurfaceTable.IsEmpty())
+	{
+		return false;
+	}
+
+	constexpr int MaxIterations = 1000;
+	for (int i = 0; i < MaxIterations; ++i)
+	{
+		// Pick a random surface weighted by surface area (surfaces with a larger
+		// area have more chance of being chosen)
+		const auto& [Anchor, UsableArea, IsPlane, Bounds, BoxSide] = Sampler.Surfaces[Sampler.SurfaceTable.Sample(RandomStream)];
+
+		if (IsPlane)
+		{
+			// Positions on the plane are always inside its boundary. They only need to be rejected if they are
+			// too close to the edge of the bounds.
+			const FVector LocalPosition = Anchor->GenerateRandomPositionOnPlaneFromStream(RandomStream);
+			if (MinDistanceToEdge > 0.0f && !Bounds.IsInside(FVector2D(LocalPosition.Y, LocalPosition.Z)))
+			{
+				continue;
+			}
+			OutPosition = Anchor->ActorToWorld().TransformPosition(LocalPosition);
+			OutNormal = Anchor->ActorToWorld().TransformVector(FVector::BackwardVector);
+			return true;
+		}
+
+		const FVector2D Pos = FVector2D(
+			RandomStream.FRandRange(Bounds.Min.X, Bounds.Max.X),
+			RandomStream.FRandRange(Bounds.Min.Y, Bounds.Max.Y));
+		OutPosition = GetWorldPos(Pos, Anchor, BoxSide);
+		OutNormal = Anchor->ActorToWorld().TransformVector(GetNormalBoxSide(BoxSide));
+		return true;
+	}
+	return false;
+}
+
+const AMRUKRoom::FSurfaceSampler& AMRUKRoom::GetOrCreateSurfaceSampler(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge,
+	const FMRUKCompiledLabelFilter& LabelFilter, FSurfaceSampler& TemporarySampler)
+{
+	constexpr int32 MaxCachedSamplers = 8;
+
+	const bool bCacheable = LabelFilter.OverflowIncludedLabels.IsEmpty() && LabelFilter.OverflowExcludedLabels.IsEmpty();
+	if (bCacheable)
+	{
+		for (const FSurfaceSampler& Sampler : SurfaceSamplers)
+		{
+			if (Sampler.SpawnLocation == SpawnLocation && Sampler.MinDistanceToEdge == MinDistanceToEdge
+				&& Sampler.IncludedMask == LabelFilter.IncludedMask && Sampler.ExcludedMask == LabelFilter.ExcludedMask
+				&& Sampler.bHasIncludedLabels == LabelFilter.bHasIncludedLabels)
+			{
+				return Sampler;
+			}
+		}
+	}
+
+	// Filters with labels that don't have a bit of their own can't be compared cheaply, so they don't get cached
+	FSurfaceSampler* Sampler = &TemporarySampler;
+	if (bCacheable)
+	{
+		if (SurfaceSamplers.Num() >= MaxCachedSamplers)
+		{
+			SurfaceSamplers.RemoveAt(0);
+		}
+		Sampler = &SurfaceSamplers.AddDefaulted_GetRef();
+	}
+	Sampler->SpawnLocation = SpawnLocation;
+	Sampler->MinDistanceToEdge = MinDistanceToEdge;
+	Sampler->IncludedMask = LabelFilter.IncludedMask;
+	Sampler->ExcludedMask = LabelFilter.ExcludedMask;
+	Sampler->bHasIncludedLabels = LabelFilter.bHasIncludedLabels;
+	BuildSurfaceSampler(*Sampler, LabelFilter);
+	return *Sampler;
+}
+
+void AMRUKRoom::BuildSurfaceSampler(FSurfaceSampler& Sampler, const FMRUKCompiledLabelFilter& LabelFilter)
+{
+	const EMRUKSpawnLocation SpawnLocation = Sampler.SpawnLocation;
+	const float MinDistanceToEdge = Sampler.MinDistanceToEdge;
+	const float MinWidth = 2.0f * MinDistanceToEdge;
+	TArray<Surface>& Surfaces = Sampler.Surfaces;
+
 	for (auto& Anchor : AllAnchors)
 	{
-		if (!LabelFilter.PassesFilter(Anchor->SemanticClassifications))
+		if (!Anchor->PassesCompiledLabelFilter(LabelFilter))
 		{
 			continue;
 		}
@@ -616,7 +627,7 @@ bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation
 			else if (SpawnLocation == EMRUKSpawnLocation::OnTopOfSurface)
 			{
 				bSkipPlane = !bIsHorizontal;
-				if (Anchor->SemanticClassifications.Contains(FMRUKLabels::Ceiling))
+				if (Anchor->HasLabelMask(FMRUKLabelMasks::Ceiling))
 					bSkipPlane = true;
 			}
 			else if (SpawnLocation == EMRUKSpawnLocation::AnySurface)
@@ -625,7 +636,7 @@ bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation
 			}
 			else if (SpawnLocation == EMRUKSpawnLocation::HangingDown)
 			{
-				bSkipPlane = !Anchor->SemanticClassifications.Contains(FMRUKLabels::Ceiling);
+				bSkipPlane = !Anchor->HasLabelMask(FMRUKLabelMasks::Ceiling);
 			}
 
 			if (!bSkipPlane)
@@ -633,9 +644,12 @@ bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation
 				const auto Size = Anchor->PlaneBounds.GetSize();
 				if (Size.X > MinWidth && Size.Y > MinWidth)
 				{
-					const float UsableArea = (Size.X - MinWidth) * (Size.Y - MinWidth);
-					TotalUsableSurfaceArea += UsableArea;
-					Surfaces.Add({ Anchor, UsableArea, true, Anchor->PlaneBounds, EMRUKBoxSide{} });
+					// Positions are sampled from the triangulated plane, so weight the plane by the area of its
+					// polygon. The part that is too close to the edges is estimated from the bounds.
+					const FBox2D UsableBounds = Anchor->PlaneBounds.ExpandBy(-MinDistanceToEdge);
+					const double UsableFraction = UsableBounds.GetArea() / Anchor->PlaneBounds.GetArea();
+					const float UsableArea = static_cast<float>(Anchor->GetPlaneArea() * UsableFraction);
+					Surfaces.Add({ Anchor, UsableArea, true, UsableBounds, EMRUKBoxSide{} });
 				}
 			}
 		}
@@ -663,87 +677,69 @@ bool AMRUKRoom::GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation
 				if (const auto Size = Bound.GetSize(); Size.X > MinWidth && Size.Y > MinWidth)
 				{
 					const float UsableArea = (Size.X - MinWidth) * (Size.Y - MinWidth);
-					TotalUsableSurfaceArea += UsableArea;
-					Surfaces.Add({ Anchor, UsableArea, false, Bound, BoxSide });
+					Surfaces.Add({ Anchor, UsableArea, false, Bound.ExpandBy(-MinDistanceToEdge), BoxSide });
 				}
 			}
 		}
 	}
-	if (Surfaces.Num() == 0)
-	{
-		return false;
-	}
 
-	constexpr int MaxIterations = 1000;
-	for (int i = 0; i < MaxIterations; ++i)
+	TArray<float> Areas;
+	Areas.Reserve(Surfaces.Num());
+	for (const Surface& Entry : Surfaces)
 	{
-		// Pick a random surface weighted by surface area (surfaces with a larger
-		// area have more chance of being chosen)
-		float Rand = FMath::RandRange(0.f, TotalUsableSurfaceArea);
-		int Index = 0;
-		for (; Index < Surfaces.Num() - 1; ++Index)
-		{
-			Rand -= Surfaces[Index].UsableArea;
-			if (Rand <= 0.0f)
-			{
-				break;
-			}
-		}
-		auto& [Anchor, UsableArea, IsPlane, Bounds, BoxSide] = Surfaces[Index];
-
-		FVector2D Pos = FVector2D(
-			FMath::RandRange(Bounds.Min.X + MinDistanceToEdge, Bounds.Max.X - MinDistanceToEdge),
-			FMath::RandRange(Bounds.Min.Y + MinDistanceToEdge, Bounds.Max.Y - MinDistanceToEdge));
-
-		if (IsPlane && !Anchor->IsPositionInBoundary(Pos))
-			continue;
-
-		if (IsPlane)
-		{
-			const FVector Pos3DPlane = Anchor->ActorToWorld().TransformPosition(FVector(0.f, Pos.X, Pos.Y));
-			OutPosition = Pos3DPlane;
-			OutNormal = Anchor->ActorToWorld().TransformVector(FVector::BackwardVector);
-			return true;
-		}
-
-		OutPosition = GetWorldPos(Pos, Anchor, BoxSide);
-		OutNormal = Anchor->ActorToWorld().TransformVector(GetNormalBoxSide(BoxSide));
-		return true;
+		Areas.Push(Entry.UsableArea);
 	}
-	return false;
+	Sampler.SurfaceTable.Build(Areas);
+}
+
+void AMRUKRoom::InvalidateSamplers()
+{
+	SurfaceSamplers.Empty();
 }
 
 AMRUKAnchor* AMRUKRoom::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, FMRUKHit& OutHit)
 {
 	AMRUKAnchor* HitComponent = nullptr;
-	for (const auto& Anchor : AllAnchors)
-	{
-		if (!Anchor || !Anchor->PassesLabelFilter(LabelFilter))
+
+	const FMRUKCompiledLabelFilter CompiledFilter = LabelFilter.Compile();
+	const auto RaycastAnchor = [&](AMRUKAnchor* Anchor, float& CurrentMaxDist) {
+		if (!Anchor || !Anchor->PassesCompiledLabelFilter(CompiledFilter))
 		{
-			continue;
+			return;
 		}
 		FMRUKHit HitResult;
-		if (Anchor->Raycast(Origin, Direction, MaxDist, HitResult, LabelFilter.ComponentTypes))
+		if (Anchor->Raycast(Origin, Direction, CurrentMaxDist, HitResult, LabelFilter.ComponentTypes))
 		{
 			// Prevent further hits which are further away from being found
-			MaxDist = HitResult.HitDistance;
+			CurrentMaxDist = HitResult.HitDistance;
 			OutHit = HitResult;
 			HitComponent = Anchor;
 		}
+	};
+
+	// The global mesh is not part of the hierarchy since it's raycasted through physics
+	if (GlobalMeshAnchor && AllAnchors.Contains(GlobalMeshAnchor))
+	{
+		RaycastAnchor(GlobalMeshAnchor, MaxDist);
 	}
+
+	const FTransform& RoomTransform = GetActorTransform();
+	AnchorBVH.Raycast(RoomTransform.InverseTransformPosition(Origin), RoomTransform.InverseTransformVector(Direction), MaxDist, RaycastAnchor);
+
 	return HitComponent;
 }
 
 bool AMRUKRoom::RaycastAll(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, TArray<FMRUKHit>& OutHits, TArray<AMRUKAnchor*>& OutAnchors)
 {
 	bool HitAnything = false;
-	for (const auto& Anchor : AllAnchors)
-	{
-		if (!Anchor || !Anchor->PassesLabelFilter(LabelFilter))
+
+	const FMRUKCompiledLabelFilter CompiledFilter = LabelFilter.Compile();
+	const auto RaycastAnchor = [&](AMRUKAnchor* Anchor, float& CurrentMaxDist) {
+		if (!Anchor || !Anchor->PassesCompiledLabelFilter(CompiledFilter))
 		{
-			continue;
+			return;
 		}
-		if (Anchor->RaycastAll(Origin, Direction, MaxDist, OutHits, LabelFilter.ComponentTypes))
+		if (Anchor->RaycastAll(Origin, Direction, CurrentMaxDist, OutHits, LabelFilter.ComponentTypes))
 		{
 			HitAnything = true;
 			// For each element in OutHits we want an equivalent entry in OutAnchors with the same index
@@ -753,7 +749,17 @@ bool AMRUKRoom::RaycastAll(const FVector& Origin, const FVector& Direction, floa
 				OutAnchors.Push(Anchor);
 			}
 		}
+	};
+
+	// The global mesh is not part of the hierarchy since it's raycasted through physics
+	if (GlobalMeshAnchor && AllAnchors.Contains(GlobalMeshAnchor))
+	{
+		RaycastAnchor(GlobalMeshAnchor, MaxDist);
 	}
+
+	const FTransform& RoomTransform = GetActorTransform();
+	AnchorBVH.Raycast(RoomTransform.InverseTransformPosition(Origin), RoomTransform.InverseTransformVector(Direction), MaxDist, RaycastAnchor);
+
 	return HitAnything;
 }
 
@@ -771,6 +777,9 @@ void AMRUKRoom::ClearRoom()
 		}
 	}
 	AllAnchors.Empty();
+	AnchorBVH.Reset();
+	AnchorHierarchy.Reset();
+	InvalidateSamplers();
 	WallAnchors.Empty();
 	SeatAnchors.Empty();
 	FloorAnchor = nullptr;
@@ -785,22 +794,59 @@ bool AMRUKRoom::DoesRoomHave(const TArray<FString>& Labels)
 		return true;
 	}
 
-	TArray<FString> RemainingLabels = Labels;
+	// Compile the labels into a mask once. Labels without a bit of their own can only be on anchors whose labels
+	// overflowed, they are compared as strings on those. A label that is listed more than once has to be found as
+	// often as it is listed, which only the strings can count.
+	FMRUKLabelMask RequiredMask;
+	TArray<FString, TInlineAllocator<4>> RemainingLabels;
+	bool bHasRepeatedLabels = false;
+	for (const auto& Label : Labels)
+	{
+		const FMRUKLabelMask Mask = FMRUKLabelMask::FindLabel(Label);
+		if (Mask.IsEmpty())
+		{
+			RemainingLabels.Add(Label);
+		}
+		else if ((RequiredMask.Bits & Mask.Bits) != 0)
+		{
+			bHasRepeatedLabels = true;
+			break;
+		}
+		else
+		{
+			RequiredMask |= Mask;
+		}
+	}
 
+	if (bHasRepeatedLabels)
+	{
+		RequiredMask = FMRUKLabelMask();
+		RemainingLabels.Reset();
+		RemainingLabels.Append(Labels);
+	}
+
+	FMRUKLabelMask FoundMask;
 	for (const auto& Anchor : AllAnchors)
 	{
-		for (const auto& AnchorLabel : Anchor->SemanticClassifications)
+		const FMRUKLabelMask AnchorMask = Anchor->GetLabelMask();
+		FoundMask.Bits |= AnchorMask.Bits & RequiredMask.Bits;
+
+		if (!RemainingLabels.IsEmpty() && (bHasRepeatedLabels || AnchorMask.HasOverflow()))
 		{
-			const auto AnchorLabelIndex = RemainingLabels.Find(AnchorLabel);
-			if (AnchorLabelIndex != INDEX_NONE)
+			for (const auto& AnchorLabel : Anchor->SemanticClassifications)
 			{
-				RemainingLabels.RemoveAt(AnchorLabelIndex);
-				if (RemainingLabels.IsEmpty())
+				const auto AnchorLabelIndex = RemainingLabels.Find(AnchorLabel);
+				if (AnchorLabelIndex != INDEX_NONE)
 				{
-					return true;
+					RemainingLabels.RemoveAtSwap(AnchorLabelIndex);
 				}
 			}
 		}
+
+		if (FoundMask == RequiredMask && RemainingLabels.IsEmpty())
+		{
+			return true;
+		}
 	}
 
 	return false;
@@ -815,29 +861,70 @@ AMRUKAnchor* AMRUKRoom::TryGetClosestSurfacePosition(const FVector& WorldPositio
 	OutSurfacePosition = FVector::Zero();
 	AMRUKAnchor* ClosestAnchor = nullptr;
 
-	for (const auto& Anchor : AllAnchors)
-	{
-		if (!Anchor || !Anchor->PassesLabelFilter(LabelFilter))
+	const FMRUKCompiledLabelFilter CompiledFilter = LabelFilter.Compile();
+	const auto TestAnchor = [&](AMRUKAnchor* Anchor, double& CurrentMaxDistance) {
+		if (!Anchor || !Anchor->PassesCompiledLabelFilter(CompiledFilter))
 		{
-			continue;
+			return;
 		}
 
 		FVector SurfacePos{};
 		const auto Distance = Anchor->GetClosestSurfacePosition(WorldPosition, SurfacePos);
-		if (Distance < MaxDistance)
+		if (Distance < CurrentMaxDistance)
 		{
-			MaxDistance = Distance;
+			CurrentMaxDistance = Distance;
 			OutSurfacePosition = SurfacePos;
 			ClosestAnchor = Anchor;
 		}
+	};
+
+	if (GlobalMeshAnchor && AllAnchors.Contains(GlobalMeshAnchor))
+	{
+		TestAnchor(GlobalMeshAnchor, MaxDistance);
 	}
 
+	const FTransform& RoomTransform = GetActorTransform();
+	AnchorBVH.QueryClosest(RoomTransform.InverseTransformPosition(WorldPosition), RoomTransform.GetMinimumAxisScale(), MaxDistance, TestAnchor);
+
 	OutSurfaceDistance = MaxDistance;
 	return ClosestAnchor;
 }
 
 AMRUKAnchor* AMRUKRoom::IsPositionInSceneVolume(const FVector& WorldPosition, bool TestVerticalBounds, double Tolerance)
 {
+	if (TestVerticalBounds)
+	{
+		// Collect all volumes that contain the position and return the first one in the order of AllAnchors to
+		// return the same anchor as the linear search would in case volumes overlap
+		AMRUKAnchor* Result = nullptr;
+		int32 ResultIndex = MAX_int32;
+		const auto TestAnchor = [&](AMRUKAnchor* Anchor) {
+			if (!Anchor || !Anchor->IsPositionInVolumeBounds(WorldPosition, TestVerticalBounds, Tolerance))
+			{
+				return;
+			}
+			const int32 Index = AllAnchors.IndexOfByKey(Anchor);
+			if (Index != INDEX_NONE && Index < ResultIndex)
+			{
+				ResultIndex = Index;
+				Result = Anchor;
+			}
+		};
+
+		if (GlobalMeshAnchor && AllAnchors.Contains(GlobalMeshAnchor))
+		{
+			TestAnchor(GlobalMeshAnchor);
+		}
+
+		const FTransform& RoomTransform = GetActorTransform();
+		const double LocalTolerance = FMath::Max(Tolerance, 0.0) / RoomTransform.GetMinimumAxisScale();
+		AnchorBVH.QueryOverlap(FBox(FVector(RoomTransform.InverseTransformPosition(WorldPosition))).ExpandBy(LocalTolerance), TestAnchor);
+
+		return Result;
+	}
+
+	// Without vertical bounds the volumes are unbounded along their local X axis which can't be
+	// represented in the hierarchy, fall back to testing every anchor
 	for (const auto& Anchor : AllAnchors)
 	{
 		if (!Anchor)
@@ -894,9 +981,10 @@ TArray<AMRUKAnchor*> AMRUKRoom::GetAnchorsByLabel(const FString& Label) const
 {
 	TArray<TObjectPtr<AMRUKAnchor>> Anchors;
 
+	const FMRUKCompiledLabelFilter LabelFilter = FMRUKCompiledLabelFilter::FromLabel(Label);
 	for (const auto& Anchor : AllAnchors)
 	{
-		if (Anchor && Anchor->HasLabel(Label))
+		if (Anchor && Anchor->PassesCompiledLabelFilter(LabelFilter))
 		{
 			Anchors.Push(Anchor);
 		}
@@ -1087,9 +1175,10 @@ AMRUKAnchor* AMRUKRoom::GetLargestSurface(const FString& Label)
 	double LargestSurfaceArea = 0.0;
 	const auto LabelUpper = Label.ToUpper();
 
+	const FMRUKCompiledLabelFilter LabelFilter = FMRUKCompiledLabelFilter::FromLabel(Label);
 	for (const auto& Anchor : AllAnchors)
 	{
-		if (!Anchor || !Anchor->HasLabel(Label))
+		if (!Anchor || !Anchor->PassesCompiledLabelFilter(LabelFilter))
 		{
 			continue;
 		}
@@ -1183,7 +1272,7 @@ void AMRUKRoom::ComputeWallMeshUVAdjustments(const TArray<FMRUKTexCoordModes>& W
 			const FVector2D Scale(WallWidth / DenominatorX, WallHeight / DenominatorY);
 			PlaneUVAdjustments.Push({ Offset, Scale });
 		}
-		if (!WallAnchor->HasLabel(FMRUKLabels::InvisibleWallFace))
+		if (!WallAnchor->HasLabelMask(FMRUKLabelMasks::InvisibleWallFace))
 		{
 			OutAnchorsWithPlaneUVs.Push({ WallAnchor, PlaneUVAdjustments });
 		}
@@ -1272,6 +1361,29 @@ bool AMRUKRoom::LoadGlobalMeshFromJsonString(const FString& JsonString, UMateria
 	return true;
 }
 
+bool AMRUKRoom::LoadGlobalMeshFromSnapshot(const TArray<uint8>& Snapshot, UMaterialInterface* Material)
+{
+	if (!GlobalMeshAnchor)
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("A global mesh can only be loaded from a scene snapshot if it has a global mesh anchor. Please make sure you provide one."));
+		return false;
+	}
+
+	bool ProcMeshExisted = false;
+	UProceduralMeshComponent* ProcMesh = GetOrCreateGlobalMeshProceduralMeshComponent(ProcMeshExisted);
+
+	if (!UMRUKBPLibrary::LoadGlobalMeshFromSnapshot(Snapshot, AnchorUUID, ProcMesh, true))
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Failed reading global mesh from scene snapshot"));
+		ProcMesh->DestroyComponent();
+		return false;
+	}
+
+	SetupGlobalMeshProceduralMeshComponent(*ProcMesh, ProcMeshExisted, Material);
+
+	return true;
+}
+
 FVector AMRUKRoom::ComputeCentroid(double Z)
 {
 	if (!FloorAnchor || !CeilingAnchor)
@@ -1409,7 +1521,7 @@ TArray<AActor*> AMRUKRoom::SpawnInteriorFromStream(const TMap<FString, FMRUKSpaw
 		bool SpawnProceduralMesh = true;
 		for (const auto& SemanticClassification : Anchor->SemanticClassifications)
 		{
-			if (SemanticClassification == FMRUKLabels::WallFace && Anchor->SemanticClassifications.Contains(FMRUKLabels::InvisibleWallFace))
+			if (SemanticClassification == FMRUKLabels::WallFace && Anchor->HasLabelMask(FMRUKLabelMasks::InvisibleWallFace))
 			{
 				// Treat anchors with WALL_FACE and INVISIBLE_WALL_FACE as anchors that only have INVISIBLE_WALL_FACE
 				continue;
@@ -0,0 +1,696 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitSceneSnapshot.h"
+#include "MRUtilityKit.h"
+#include "MRUtilityKitSerializationHelpers.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+static_assert(sizeof(FVector) == 3 * sizeof(double), "Global mesh positions are read directly as FVector");
+static_assert(sizeof(FOculusXRUUID) == OCULUSXR_UUID_SIZE, "UUIDs are stored as raw bytes");
+
+namespace
+{
+	constexpr uint8 SnapshotMagic[4] = { 'M', 'R', 'U', 'K' };
+	constexpr int32 SnapshotAlignment = 8;
+
+	enum EAnchorFlags : uint32
+	{
+		HasPlaneBounds = 1 << 0,
+		HasPlaneBoundary = 1 << 1,
+		HasVolumeBounds = 1 << 2,
+		HasGlobalMesh = 1 << 3,
+	};
+
+	template <typename T>
+	void SwapBytesIfBigEndian(T& Value)
+	{
+#if !PLATFORM_LITTLE_ENDIAN
+		uint8* Bytes = reinterpret_cast<uint8*>(&Value);
+		for (int32 I = 0; I < sizeof(T) / 2; ++I)
+		{
+			Swap(Bytes[I], Bytes[sizeof(T) - 1 - I]);
+		}
+#endif
+	}
+
+	class FSnapshotWriter
+	{
+	public:
+		explicit FSnapshotWriter(TArray<uint8>& InData)
+			: Data(InData)
+		{
+		}
+
+		void WriteBytes(const void* Bytes, int32 Num)
+		{
+			Data.Append(static_cast<const uint8*>(Bytes), Num);
+		}
+
+		template <typename T>
+		void Write(T Value)
+		{
+			SwapBytesIfBigEndian(Value);
+			WriteBytes(&Value, sizeof(T));
+		}
+
+		void Write(const FOculusXRUUID& UUID)
+		{
+			WriteBytes(UUID.UUIDBytes, OCULUSXR_UUID_SIZE);
+		}
+
+		void Write(const FString& String)
+		{
+			const FTCHARToUTF8 Utf8(*String);
+			Write<uint32>(Utf8.Length());
+			WriteBytes(Utf8.Get(), Utf8.Length());
+		}
+
+		void Write(const FVector& Vector)
+		{
+			Write(Vector.X);
+			Write(Vector.Y);
+			Write(Vector.Z);
+		}
+
+		void Write(const FVector2D& Vector)
+		{
+			Write(Vector.X);
+			Write(Vector.Y);
+		}
+
+		void Pad()
+		{
+			Data.AddZeroed(::Align(Data.Num(), SnapshotAlignment) - Data.Num());
+		}
+
+		/**
+		 * Append an array of plain numbers in one go. The data has to be aligned already.
+		 */
+		template <typename T>
+		void WriteArray(TConstArrayView<T> Array)
+		{
+#if PLATFORM_LITTLE_ENDIAN
+			WriteBytes(Array.GetData(), Array.Num() * sizeof(T));
+#else
+			for (const T& Item : Array)
+			{
+				Write(Item);
+			}
+#endif
+		}
+
+	private:
+		TArray<uint8>& Data;
+	};
+
+	class FSnapshotReader
+	{
+	public:
+		explicit FSnapshotReader(TConstArrayView<uint8> InData)
+			: Data(InData)
+		{
+		}
+
+		bool HasError() const { return bError; }
+
+		bool ReadBytes(void* Bytes, int64 Num)
+		{
+			if (!Ensure(Num))
+			{
+				return false;
+			}
+			FMemory::Memcpy(Bytes, Data.GetData() + Offset, Num);
+			Offset += Num;
+			return true;
+		}
+
+		template <typename T>
+		bool Read(T& Value)
+		{
+			if (!ReadBytes(&Value, sizeof(T)))
+			{
+				return false;
+			}
+			SwapBytesIfBigEndian(Value);
+			return true;
+		}
+
+		bool Read(FOculusXRUUID& UUID)
+		{
+			return ReadBytes(UUID.UUIDBytes, OCULUSXR_UUID_SIZE);
+		}
+
+		bool Read(FString& String)
+		{
+			uint32 Length = 0;
+			if (!Read(Length) || !Ensure(Length))
+			{
+				return false;
+			}
+			const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data.GetData() + Offset), Length);
+			String = FString(Converter.Length(), Converter.Get());
+			Offset += Length;
+			return true;
+		}
+
+		bool Read(FVector& Vector)
+		{
+			return Read(Vector.X) && Read(Vector.Y) && Read(Vector.Z);
+		}
+
+		bool Read(FVector2D& Vector)
+		{
+			return Read(Vector.X) && Read(Vector.Y);
+		}
+
+		bool Read(FRotator& Rotator)
+		{
+			return Read(Rotator.Pitch) && Read(Rotator.Yaw) && Read(Rotator.Roll);
+		}
+
+		bool SkipPadding()
+		{
+			const int64 Aligned = ::Align(Offset, SnapshotAlignment);
+			if (!Ensure(Aligned - Offset))
+			{
+				return false;
+			}
+			Offset = Aligned;
+			return true;
+		}
+
+		/**
+		 * Read an array of plain numbers. If the memory is suitably aligned the returned view points into the snapshot,
+		 * otherwise the data gets copied into the given storage.
+		 */
+		template <typename T, typename ElementType>
+		bool ReadArray(uint32 Num, TConstArrayView<T>& OutView, TArray<T>& OutStorage)
+		{
+			static_assert(sizeof(T) % sizeof(ElementType) == 0);
+			const int64 NumBytes = static_cast<int64>(Num) * sizeof(T);
+			if (!Ensure(NumBytes))
+			{
+				return false;
+			}
+			const uint8* Begin = Data.GetData() + Offset;
+#if PLATFORM_LITTLE_ENDIAN
+			if (IsAligned(Begin, alignof(T)))
+			{
+				OutView = TConstArrayView<T>(reinterpret_cast<const T*>(Begin), Num);
+				Offset += NumBytes;
+				return true;
+			}
+#endif
+			OutStorage.SetNumUninitialized(Num);
+			FMemory::Memcpy(OutStorage.GetData(), Begin, NumBytes);
+#if !PLATFORM_LITTLE_ENDIAN
+			ElementType* Elements = reinterpret_cast<ElementType*>(OutStorage.GetData());
+			for (int64 I = 0; I < NumBytes / static_cast<int64>(sizeof(ElementType)); ++I)
+			{
+				SwapBytesIfBigEndian(Elements[I]);
+			}
+#endif
+			OutView = OutStorage;
+			Offset += NumBytes;
+			return true;
+		}
+
+		/**
+		 * Check that a count read from the snapshot can be satisfied by the remaining data, where every element
+		 * needs at least MinElementSize bytes. Protects against huge allocations from corrupt data.
+		 */
+		bool CheckCount(uint32 Num, int64 MinElementSize)
+		{
+			return Ensure(static_cast<int64>(Num) * MinElementSize);
+		}
+
+		int64 GetOffset() const { return Offset; }
+
+	private:
+		bool Ensure(int64 Num)
+		{
+			if (bError || Num < 0 || Offset + Num > Data.Num())
+			{
+				bError = true;
+				return false;
+			}
+			return true;
+		}
+
+		TConstArrayView<uint8> Data;
+		int64 Offset = 0;
+		bool bError = false;
+	};
+
+	bool ReadAnchor(FSnapshotReader& Reader, FMRUKSnapshotAnchor& Anchor)
+	{
+		uint32 NumLabels = 0;
+		if (!Reader.Read(Anchor.UUID) || !Reader.Read(NumLabels) || !Reader.CheckCount(NumLabels, sizeof(uint32)))
+		{
+			return false;
+		}
+		Anchor.SemanticClassifications.SetNum(NumLabels);
+		for (FString& Label : Anchor.SemanticClassifications)
+		{
+			if (!Reader.Read(Label))
+			{
+				return false;
+			}
+		}
+
+		uint32 Flags = 0;
+		if (!Reader.Read(Flags) || !Reader.SkipPadding()
+			|| !Reader.Read(Anchor.Translation) || !Reader.Read(Anchor.Rotation) || !Reader.Read(Anchor.Scale))
+		{
+			return false;
+		}
+
+		if (Flags & HasPlaneBounds)
+		{
+			if (!Reader.Read(Anchor.PlaneBounds.Min) || !Reader.Read(Anchor.PlaneBounds.Max))
+			{
+				return false;
+			}
+			Anchor.PlaneBounds.bIsValid = true;
+		}
+		if (Flags & HasPlaneBoundary)
+		{
+			uint32 NumBoundary = 0;
+			if (!Reader.Read(NumBoundary) || !Reader.SkipPadding() || !Reader.CheckCount(NumBoundary, sizeof(FVector2D)))
+			{
+				return false;
+			}
+			Anchor.PlaneBoundary2D.SetNumUninitialized(NumBoundary);
+			for (FVector2D& Point : Anchor.PlaneBoundary2D)
+			{
+				Reader.Read(Point);
+			}
+		}
+		if (Flags & HasVolumeBounds)
+		{
+			if (!Reader.Read(Anchor.VolumeBounds.Min) || !Reader.Read(Anchor.VolumeBounds.Max))
+			{
+				return false;
+			}
+			Anchor.VolumeBounds.IsValid = true;
+		}
+		if (Flags & HasGlobalMesh)
+		{
+			FMRUKSnapshotGlobalMesh& GlobalMesh = Anchor.GlobalMesh.Emplace();
+			uint32 NumPositions = 0;
+			uint32 NumIndices = 0;
+			if (!Reader.Read(GlobalMesh.UUID) || !Reader.Read(NumPositions) || !Reader.Read(NumIndices) || !Reader.SkipPadding())
+			{
+				return false;
+			}
+			TConstArrayView<FVector> Positions;
+			TConstArrayView<int32> Indices;
+			TArray<FVector> PositionStorage;
+			TArray<int32> IndexStorage;
+			if (!Reader.ReadArray<FVector, double>(NumPositions, Positions, PositionStorage)
+				|| !Reader.ReadArray<int32, int32>(NumIndices, Indices, IndexStorage) || !Reader.SkipPadding())
+			{
+				return false;
+			}
+			if (PositionStorage.IsEmpty() && IndexStorage.IsEmpty())
+			{
+				GlobalMesh.SetMappedMeshData(Positions, Indices);
+			}
+			else
+			{
+				// Don't mix referenced and owned data
+				GlobalMesh.SetMeshData(TArray<FVector>(Positions), TArray<int32>(Indices));
+			}
+		}
+		return !Reader.HasError();
+	}
+
+	void WriteAnchor(FSnapshotWriter& Writer, const FMRUKSnapshotAnchor& Anchor)
+	{
+		Writer.Write(Anchor.UUID);
+		Writer.Write<uint32>(Anchor.SemanticClassifications.Num());
+		for (const FString& Label : Anchor.SemanticClassifications)
+		{
+			Writer.Write(Label);
+		}
+
+		uint32 Flags = 0;
+		Flags |= Anchor.PlaneBounds.bIsValid ? HasPlaneBounds : 0;
+		Flags |= !Anchor.PlaneBoundary2D.IsEmpty() ? HasPlaneBoundary : 0;
+		Flags |= Anchor.VolumeBounds.IsValid ? HasVolumeBounds : 0;
+		Flags |= Anchor.GlobalMesh.IsSet() ? HasGlobalMesh : 0;
+		Writer.Write(Flags);
+		Writer.Pad();
+
+		Writer.Write(Anchor.Translation);
+		Writer.Write(Anchor.Rotation.Pitch);
+		Writer.Write(Anchor.Rotation.Yaw);
+		Writer.Write(Anchor.Rotation.Roll);
+		Writer.Write(Anchor.Scale);
+
+		if (Flags & HasPlaneBounds)
+		{
+			Writer.Write(Anchor.PlaneBounds.Min);
+			Writer.Write(Anchor.PlaneBounds.Max);
+		}
+		if (Flags & HasPlaneBoundary)
+		{
+			Writer.Write<uint32>(Anchor.PlaneBoundary2D.Num());
+			Writer.Pad();
+			for (const FVector2D& Point : Anchor.PlaneBoundary2D)
+			{
+				Writer.Write(Point);
+			}
+		}
+		if (Flags & HasVolumeBounds)
+		{
+			Writer.Write(Anchor.VolumeBounds.Min);
+			Writer.Write(Anchor.VolumeBounds.Max);
+		}
+		if (Flags & HasGlobalMesh)
+		{
+			const FMRUKSnapshotGlobalMesh& GlobalMesh = Anchor.GlobalMesh.GetValue();
+			const TConstArrayView<FVector> Positions = GlobalMesh.GetPositions();
+			const TConstArrayView<int32> Indices = GlobalMesh.GetIndices();
+			Writer.Write(GlobalMesh.UUID);
+			Writer.Write<uint32>(Positions.Num());
+			Writer.Write<uint32>(Indices.Num());
+			Writer.Pad();
+			Writer.WriteArray(TConstArrayView<double>(reinterpret_cast<const double*>(Positions.GetData()), Positions.Num() * 3));
+			Writer.WriteArray(Indices);
+			// Keep the next anchor aligned
+			Writer.Pad();
+		}
+	}
+
+	TSharedRef<FJsonObject> AnchorToJson(const FMRUKSnapshotAnchor& Anchor)
+	{
+		// Same fields in the same order as AMRUKAnchor::JsonSerialize()
+		const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+		JsonObject->SetField(TEXT("UUID"), MRUKSerialize(Anchor.UUID));
+		JsonObject->SetField(TEXT("SemanticClassifications"), MRUKSerialize(Anchor.SemanticClassifications));
+
+		const TSharedRef<FJsonObject> TransformJson = MakeShared<FJsonObject>();
+		TransformJson->SetField(TEXT("Translation"), MRUKSerialize(Anchor.Translation));
+		TransformJson->SetField(TEXT("Rotation"), MRUKSerialize(Anchor.Rotation));
+		TransformJson->SetField(TEXT("Scale"), MRUKSerialize(Anchor.Scale));
+		JsonObject->SetObjectField(TEXT("Transform"), TransformJson);
+
+		if (Anchor.PlaneBounds.bIsValid)
+		{
+			JsonObject->SetField(TEXT("PlaneBounds"), MRUKSerialize(Anchor.PlaneBounds));
+		}
+		if (!Anchor.PlaneBoundary2D.IsEmpty())
+		{
+			JsonObject->SetField(TEXT("PlaneBoundary2D"), MRUKSerialize(Anchor.PlaneBoundary2D));
+		}
+		if (Anchor.VolumeBounds.IsValid)
+		{
+			JsonObject->SetField(TEXT("VolumeBounds"), MRUKSerialize(Anchor.VolumeBounds));
+		}
+		if (Anchor.GlobalMesh.IsSet())
+		{
+			const FMRUKSnapshotGlobalMesh& GlobalMesh = Anchor.GlobalMesh.GetValue();
+			const TSharedRef<FJsonObject> GlobalMeshJson = MakeShared<FJsonObject>();
+			GlobalMeshJson->SetField(TEXT("UUID"), MRUKSerialize(GlobalMesh.UUID));
+
+			TArray<TSharedPtr<FJsonValue>> PositionsJson;
+			PositionsJson.Reserve(GlobalMesh.GetPositions().Num());
+			for (const FVector& Position : GlobalMesh.GetPositions())
+			{
+				PositionsJson.Add(MRUKSerialize(Position));
+			}
+			GlobalMeshJson->SetArrayField(TEXT("Positions"), PositionsJson);
+
+			TArray<TSharedPtr<FJsonValue>> IndicesJson;
+			IndicesJson.Reserve(GlobalMesh.GetIndices().Num());
+			for (const int32 Index : GlobalMesh.GetIndices())
+			{
+				IndicesJson.Add(MakeShared<FJsonValueNumber>(Index));
+			}
+			GlobalMeshJson->SetArrayField(TEXT("Indices"), IndicesJson);
+
+			JsonObject->SetObjectField(TEXT("GlobalMesh"), GlobalMeshJson);
+		}
+		return JsonObject;
+	}
+
+	void AnchorFromJson(const FJsonObject& Object, FMRUKSnapshotAnchor& Anchor)
+	{
+		MRUKDeserialize(*Object.GetField<EJson::None>(TEXT("UUID")), Anchor.UUID);
+		MRUKDeserialize(*Object.GetField<EJson::None>(TEXT("SemanticClassifications")), Anchor.SemanticClassifications);
+
+		// Keep the rotator as it is instead of going through FTransform, otherwise the conversion would not be lossless
+		const auto TransformJson = Object.GetObjectField(TEXT("Transform"));
+		MRUKDeserialize(*TransformJson->GetField<EJson::None>(TEXT("Translation")), Anchor.Translation);
+		MRUKDeserialize(*TransformJson->GetField<EJson::None>(TEXT("Rotation")), Anchor.Rotation);
+		MRUKDeserialize(*TransformJson->GetField<EJson::None>(TEXT("Scale")), Anchor.Scale);
+
+		if (const auto JsonValue = Object.TryGetField(TEXT("PlaneBounds")))
+		{
+			MRUKDeserialize(*JsonValue, Anchor.PlaneBounds);
+		}
+		if (const auto JsonValue = Object.TryGetField(TEXT("PlaneBoundary2D")))
+		{
+			MRUKDeserialize(*JsonValue, Anchor.PlaneBoundary2D);
+		}
+		if (const auto JsonValue = Object.TryGetField(TEXT("VolumeBounds")))
+		{
+			MRUKDeserialize(*JsonValue, Anchor.VolumeBounds);
+		}
+		if (const auto JsonValue = Object.TryGetField(TEXT("GlobalMesh")))
+		{
+			const auto GlobalMeshObject = JsonValue->AsObject();
+			FMRUKSnapshotGlobalMesh& GlobalMesh = Anchor.GlobalMesh.Emplace();
+			MRUKDeserialize(*GlobalMeshObject->GetField<EJson::None>(TEXT("UUID")), GlobalMesh.UUID);
+
+			const auto& PositionsJson = GlobalMeshObject->GetArrayField(TEXT("Positions"));
+			TArray<FVector> Positions;
+			Positions.SetNumUninitialized(PositionsJson.Num());
+			for (int32 I = 0; I < PositionsJson.Num(); ++I)
+			{
+				MRUKDeserialize(*PositionsJson[I], Positions[I]);
+			}
+
+			const auto& IndicesJson = GlobalMeshObject->GetArrayField(TEXT("Indices"));
+			TArray<int32> Indices;
+			Indices.SetNumUninitialized(IndicesJson.Num());
+			for (int32 I = 0; I < IndicesJson.Num(); ++I)
+			{
+				Indices[I] = static_cast<int32>(IndicesJson[I]->AsNumber());
+			}
+
+			GlobalMesh.SetMeshData(MoveTemp(Positions), MoveTemp(Indices));
+		}
+	}
+} // namespace
+
+void FMRUKSnapshotGlobalMesh::SetMeshData(TArray<FVector>&& Positions, TArray<int32>&& Indices)
+{
+	MappedPositions = {};
+	MappedIndices = {};
+	OwnedPositions = MoveTemp(Positions);
+	OwnedIndices = MoveTemp(Indices);
+}
+
+void FMRUKSnapshotGlobalMesh::SetMappedMeshData(TConstArrayView<FVector> Positions, TConstArrayView<int32> Indices)
+{
+	OwnedPositions.Empty();
+	OwnedIndices.Empty();
+	MappedPositions = Positions;
+	MappedIndices = Indices;
+}
+
+void MRUKWriteSceneSnapshot(const FMRUKSceneSnapshot& Scene, TArray<uint8>& OutSnapshot)
+{
+	OutSnapshot.Reset();
+	FSnapshotWriter Writer(OutSnapshot);
+	Writer.WriteBytes(SnapshotMagic, sizeof(SnapshotMagic));
+	Writer.Write<uint32>(FMRUKSceneSnapshot::CurrentVersion);
+	Writer.Write<uint32>(0);
+	Writer.Write<uint32>(Scene.Rooms.Num());
+	for (const FMRUKSnapshotRoom& Room : Scene.Rooms)
+	{
+		Writer.Write(Room.UUID);
+		Writer.Write(Room.FloorUuid);
+		Writer.Write(Room.CeilingUuid);
+		Writer.Write<uint32>(Room.WallsUuid.Num());
+		for (const FOculusXRUUID& WallUuid : Room.WallsUuid)
+		{
+			Writer.Write(WallUuid);
+		}
+		Writer.Write<uint32>(Room.Anchors.Num());
+		for (const FMRUKSnapshotAnchor& Anchor : Room.Anchors)
+		{
+			WriteAnchor(Writer, Anchor);
+		}
+	}
+}
+
+bool MRUKReadSceneSnapshot(TConstArrayView<uint8> Snapshot, FMRUKSceneSnapshot& OutScene)
+{
+	OutScene.Rooms.Empty();
+
+	FSnapshotReader Reader(Snapshot);
+	uint8 Magic[4];
+	uint32 Version = 0;
+	uint32 Flags = 0;
+	uint32 NumRooms = 0;
+	if (!Reader.ReadBytes(Magic, sizeof(Magic)) || FMemory::Memcmp(Magic, SnapshotMagic, sizeof(Magic)) != 0)
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Data is not a MRUK scene snapshot"));
+		return false;
+	}
+	if (!Reader.Read(Version) || Version == 0 || Version > FMRUKSceneSnapshot::CurrentVersion)
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Unsupported MRUK scene snapshot version %u (supported up to %u)"), Version, FMRUKSceneSnapshot::CurrentVersion);
+		return false;
+	}
+	if (!Reader.Read(Flags) || !Reader.Read(NumRooms) || !Reader.CheckCount(NumRooms, 3 * OCULUSXR_UUID_SIZE))
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("MRUK scene snapshot header is corrupt"));
+		return false;
+	}
+
+	OutScene.Rooms.SetNum(NumRooms);
+	for (FMRUKSnapshotRoom& Room : OutScene.Rooms)
+	{
+		uint32 NumWalls = 0;
+		if (!Reader.Read(Room.UUID) || !Reader.Read(Room.FloorUuid) || !Reader.Read(Room.CeilingUuid)
+			|| !Reader.Read(NumWalls) || !Reader.CheckCount(NumWalls, OCULUSXR_UUID_SIZE))
+		{
+			break;
+		}
+		Room.WallsUuid.SetNum(NumWalls);
+		for (FOculusXRUUID& WallUuid : Room.WallsUuid)
+		{
+			Reader.Read(WallUuid);
+		}
+
+		uint32 NumAnchors = 0;
+		if (!Reader.Read(NumAnchors) || !Reader.CheckCount(NumAnchors, OCULUSXR_UUID_SIZE))
+		{
+			break;
+		}
+		Room.Anchors.SetNum(NumAnchors);
+		for (FMRUKSnapshotAnchor& Anchor : Room.Anchors)
+		{
+			if (!ReadAnchor(Reader, Anchor))
+			{
+				break;
+			}
+		}
+	}
+
+	if (Reader.HasError())
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("MRUK scene snapshot is truncated or corrupt at byte offset %lld"), Reader.GetOffset());
+		OutScene.Rooms.Empty();
+		return false;
+	}
+	return true;
+}
+
+bool MRUKReadSceneJson(const FString& Json, FMRUKSceneSnapshot& OutScene)
+{
+	OutScene.Rooms.Empty();
+
+	TSharedPtr<FJsonValue> Value;
+	const TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Json);
+	if (!FJsonSerializer::Deserialize(JsonReader, Value) || !Value.IsValid())
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Could not deserialize JSON scene data: %s"), *JsonReader->GetErrorMessage());
+		return false;
+	}
+
+	const auto Object = Value->AsObject();
+	if (!Object.IsValid())
+	{
+		return false;
+	}
+	const TArray<TSharedPtr<FJsonValue>>* RoomsJson = nullptr;
+	if (!Object->TryGetArrayField(TEXT("Rooms"), RoomsJson))
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Could not find Rooms in JSON"));
+		return false;
+	}
+
+	OutScene.Rooms.SetNum(RoomsJson->Num());
+	for (int32 I = 0; I < RoomsJson->Num(); ++I)
+	{
+		const auto RoomObject = (*RoomsJson)[I]->AsObject();
+		FMRUKSnapshotRoom& Room = OutScene.Rooms[I];
+		MRUKDeserialize(*RoomObject->GetField<EJson::None>(TEXT("UUID")), Room.UUID);
+
+		FOculusXRRoomLayout RoomLayout;
+		MRUKDeserialize(*RoomObject->GetField<EJson::None>(TEXT("RoomLayout")), RoomLayout);
+		Room.FloorUuid = RoomLayout.FloorUuid;
+		Room.CeilingUuid = RoomLayout.CeilingUuid;
+		Room.WallsUuid = MoveTemp(RoomLayout.WallsUuid);
+
+		const auto& AnchorsJson = RoomObject->GetArrayField(TEXT("Anchors"));
+		Room.Anchors.SetNum(AnchorsJson.Num());
+		for (int32 J = 0; J < AnchorsJson.Num(); ++J)
+		{
+			AnchorFromJson(*AnchorsJson[J]->AsObject(), Room.Anchors[J]);
+		}
+	}
+	return true;
+}
+
+FString MRUKWriteSceneJson(const FMRUKSceneSnapshot& Scene)
+{
+	// Same layout as UMRUKSubsystem::JsonSerialize() and AMRUKRoom::JsonSerialize()
+	const TSharedRef<FJsonObject> JsonObject = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> RoomsArray;
+	RoomsArray.Reserve(Scene.Rooms.Num());
+	for (const FMRUKSnapshotRoom& Room : Scene.Rooms)
+	{
+		TArray<TSharedPtr<FJsonValue>> AnchorsArray;
+		AnchorsArray.Reserve(Room.Anchors.Num());
+		for (const FMRUKSnapshotAnchor& Anchor : Room.Anchors)
+		{
+			AnchorsArray.Add(MakeShared<FJsonValueObject>(AnchorToJson(Anchor)));
+		}
+
+		FOculusXRRoomLayout RoomLayout;
+		RoomLayout.FloorUuid = Room.FloorUuid;
+		RoomLayout.CeilingUuid = Room.CeilingUuid;
+		RoomLayout.WallsUuid = Room.WallsUuid;
+
+		const TSharedRef<FJsonObject> RoomJson = MakeShared<FJsonObject>();
+		RoomJson->SetField(TEXT("UUID"), MRUKSerialize(Room.UUID));
+		RoomJson->SetField(TEXT("RoomLayout"), MRUKSerialize(RoomLayout));
+		RoomJson->SetArrayField(TEXT("Anchors"), AnchorsArray);
+		RoomsArray.Add(MakeShared<FJsonValueObject>(RoomJson));
+	}
+	JsonObject->SetArrayField(TEXT("Rooms"), RoomsArray);
+
+	FString Json;
+	const TSharedRef<TJsonWriter<>> JsonWriter = TJsonWriterFactory<>::Create(&Json, 0);
+	FJsonSerializer::Serialize(JsonObject, JsonWriter);
+	return Json;
+}
+
+bool MRUKConvertSceneJsonToSnapshot(const FString& Json, TArray<uint8>& OutSnapshot)
+{
+	FMRUKSceneSnapshot Scene;
+	if (!MRUKReadSceneJson(Json, Scene))
+	{
+		return false;
+	}
+	MRUKWriteSceneSnapshot(Scene, OutSnapshot);
+	return true;
+}
+
+bool MRUKConvertSceneSnapshotToJson(TConstArrayView<uint8> Snapshot, FString& OutJson)
+{
+	FMRUKSceneSnapshot Scene;
+	if (!MRUKReadSceneSnapshot(Snapshot, Scene))
+	{
+		return false;
+	}
+	OutJson = MRUKWriteSceneJson(Scene);
+	return true;
+}
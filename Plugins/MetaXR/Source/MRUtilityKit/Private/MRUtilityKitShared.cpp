@@ -38,6 +38,9 @@ void MRUKShared::LoadMRUKSharedLibrary()
 	FPlatformProcess::PopDllDirectory(*BinariesPath);
 #elif PLATFORM_ANDROID
 	void* handle = FPlatformProcess::GetDllHandle(TEXT("libmrutilitykitshared.so"));
+#else
+	UE_LOG(LogMRUK, Log, TEXT("MR Utility Kit Shared library is not available on this platform, falling back to native implementations where possible"));
+	return;
 #endif // PLATFORM_ANDROID
 
 	if (handle == nullptr)
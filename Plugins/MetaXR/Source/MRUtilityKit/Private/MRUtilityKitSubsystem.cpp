@@ -13,6 +13,9 @@
 #include "OculusXRSceneFunctionLibrary.h"
 #include "Engine/Engine.h"
 #include "Generated/MRUtilityKitShared.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
 
 AMRUKAnchor* UMRUKSubsystem::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, const FMRUKLabelFilter& LabelFilter, FMRUKHit& OutHit)
 {
@@ -83,6 +86,19 @@ TSharedRef<FJsonObject> UMRUKSubsystem::JsonSerialize()
 	return JsonObject;
 }
 
+FMRUKSceneSnapshot UMRUKSubsystem::SnapshotSerialize()
+{
+	FMRUKSceneSnapshot Scene;
+	for (const auto& Room : Rooms)
+	{
+		if (Room)
+		{
+			Scene.Rooms.Add(Room->SnapshotSerialize());
+		}
+	}
+	return Scene;
+}
+
 void UMRUKSubsystem::UnregisterRoom(AMRUKRoom* Room)
 {
 	Rooms.Remove(Room);
@@ -168,6 +184,69 @@ void UMRUKSubsystem::LoadSceneFromJsonString(const FString& String)
 	SceneData->LoadFromJson(String);
 }
 
+TArray<uint8> UMRUKSubsystem::SaveSceneToSnapshot()
+{
+	TArray<uint8> Snapshot;
+	MRUKWriteSceneSnapshot(SnapshotSerialize(), Snapshot);
+	return Snapshot;
+}
+
+void UMRUKSubsystem::LoadSceneFromSnapshot(const TArray<uint8>& Snapshot)
+{
+	LoadSceneFromSnapshotView(Snapshot);
+}
+
+bool UMRUKSubsystem::LoadSceneFromSnapshotFile(const FString& Path)
+{
+	// Scene data is fully loaded once LoadSceneFromSnapshotView() returns, so the mapping only needs to live until then
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*Path));
+	if (MappedFile)
+	{
+		const TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (MappedRegion)
+		{
+			LoadSceneFromSnapshotView(TConstArrayView<uint8>(MappedRegion->GetMappedPtr(), MappedRegion->GetMappedSize()));
+			return true;
+		}
+	}
+
+	// Memory mapping is not supported on every platform
+	TArray<uint8> Snapshot;
+	if (!FFileHelper::LoadFileToArray(Snapshot, *Path))
+	{
+		UE_LOG(LogMRUK, Error, TEXT("Could not read scene snapshot file %s"), *Path);
+		return false;
+	}
+	LoadSceneFromSnapshotView(Snapshot);
+	return true;
+}
+
+void UMRUKSubsystem::LoadSceneFromSnapshotView(TConstArrayView<uint8> Snapshot)
+{
+	if (SceneData || SceneLoadStatus == EMRUKInitStatus::Busy)
+	{
+		UE_LOG(LogMRUK, Error, TEXT("Can't start loading a scene from a snapshot while the scene is already loading"));
+		return;
+	}
+
+	SceneData = NewObject<UMRUKSceneData>(this);
+
+	if (SceneLoadStatus == EMRUKInitStatus::Complete)
+	{
+		// Update the scene
+		UE_LOG(LogMRUK, Log, TEXT("Update scene from snapshot"));
+		SceneData->OnComplete.AddDynamic(this, &UMRUKSubsystem::UpdatedSceneDataLoadedComplete);
+	}
+	else
+	{
+		UE_LOG(LogMRUK, Log, TEXT("Load scene from snapshot"));
+		SceneData->OnComplete.AddDynamic(this, &UMRUKSubsystem::SceneDataLoadedComplete);
+	}
+	SceneLoadStatus = EMRUKInitStatus::Busy;
+	SceneData->LoadFromSnapshot(Snapshot);
+}
+
 void UMRUKSubsystem::LoadSceneFromDevice()
 {
 	if (SceneData || SceneLoadStatus == EMRUKInitStatus::Busy)
@@ -0,0 +1,119 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitSurfaceDistanceVolume.h"
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitRoom.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_CYCLE_STAT(TEXT("MRUK Build Surface Distance Volume"), STAT_MRUKBuildSurfaceDistanceVolume, STATGROUP_Game);
+
+namespace
+{
+	// Upper limit of samples in a volume, the voxel size grows for rooms that would need more samples than this
+	constexpr int64 SurfaceDistanceVolumeMaxSamples = 4 * 1024 * 1024;
+} // namespace
+
+void FMRUKSurfaceDistanceVolume::Build(AMRUKRoom* Room, const FMRUKLabelFilter& LabelFilter, double InVoxelSize, double InMaxDistance)
+{
+	SCOPE_CYCLE_COUNTER(STAT_MRUKBuildSurfaceDistanceVolume);
+
+	Reset();
+	if (!Room || InVoxelSize <= 0.0 || InMaxDistance <= 0.0)
+	{
+		UE_LOG(LogMRUK, Warning, TEXT("Can not build a surface distance volume with a voxel size of %f and a maximum distance of %f"), InVoxelSize, InMaxDistance);
+		return;
+	}
+
+	// Everything further away from the anchors than the maximum distance is reported at the maximum distance, so the
+	// volume doesn't need to extend further than that
+	const FMRUKCompiledLabelFilter CompiledFilter = LabelFilter.Compile();
+	FBox Bounds(ForceInit);
+	for (const AMRUKAnchor* Anchor : Room->AllAnchors)
+	{
+		if (Anchor && Anchor != Room->GlobalMeshAnchor && Anchor->PassesCompiledLabelFilter(CompiledFilter))
+		{
+			Bounds += Room->ComputeAnchorBoundsInRoomSpace(Anchor);
+		}
+	}
+	if (!Bounds.IsValid)
+	{
+		return;
+	}
+	Bounds = Bounds.ExpandBy(InMaxDistance);
+
+	VoxelSize = InVoxelSize;
+	const FVector Size = Bounds.GetSize();
+	const auto ComputeResolution = [&Size](double Spacing) {
+		return FIntVector(FMath::CeilToInt32(Size.X / Spacing) + 1, FMath::CeilToInt32(Size.Y / Spacing) + 1, FMath::CeilToInt32(Size.Z / Spacing) + 1);
+	};
+	Resolution = ComputeResolution(VoxelSize);
+	const int64 NumSamples = static_cast<int64>(Resolution.X) * Resolution.Y * Resolution.Z;
+	if (NumSamples > SurfaceDistanceVolumeMaxSamples)
+	{
+		VoxelSize *= FMath::Pow(static_cast<double>(NumSamples) / SurfaceDistanceVolumeMaxSamples, 1.0 / 3.0);
+		Resolution = ComputeResolution(VoxelSize);
+		UE_LOG(LogMRUK, Log, TEXT("Room %s is too large for a surface distance volume with a voxel size of %f, using %f instead"), *Room->GetName(), InVoxelSize, VoxelSize);
+	}
+
+	RoomTransform = Room->GetActorTransform();
+	Origin = Bounds.Min;
+	MaxDistance = InMaxDistance;
+	Distances.SetNumUninitialized(Resolution.X * Resolution.Y * Resolution.Z);
+
+	// Each slice only reads from the room, so they can be sampled in parallel
+	ParallelFor(Resolution.Z, [this, Room, &LabelFilter](int32 Z) {
+		float* Slice = Distances.GetData() + Z * Resolution.X * Resolution.Y;
+		for (int32 Y = 0; Y < Resolution.Y; ++Y)
+		{
+			for (int32 X = 0; X < Resolution.X; ++X)
+			{
+				const FVector WorldPosition = RoomTransform.TransformPosition(Origin + FVector(X, Y, Z) * VoxelSize);
+				FVector SurfacePosition;
+				double SurfaceDistance = MaxDistance;
+				Room->TryGetClosestSurfacePosition(WorldPosition, SurfacePosition, SurfaceDistance, LabelFilter, MaxDistance);
+				Slice[Y * Resolution.X + X] = static_cast<float>(FMath::Min(SurfaceDistance, MaxDistance));
+			}
+		}
+	});
+}
+
+void FMRUKSurfaceDistanceVolume::Reset()
+{
+	Distances.Empty();
+	RoomTransform = FTransform::Identity;
+	Origin = FVector::ZeroVector;
+	Resolution = FIntVector::ZeroValue;
+	VoxelSize = 0.0;
+	MaxDistance = 0.0;
+}
+
+float FMRUKSurfaceDistanceVolume::SampleDistance(const FVector& WorldPosition) const
+{
+	if (!IsValid())
+	{
+		return static_cast<float>(MaxDistance);
+	}
+
+	const FVector Texel = (RoomTransform.InverseTransformPosition(WorldPosition) - Origin) / VoxelSize;
+	if (Texel.X < 0.0 || Texel.Y < 0.0 || Texel.Z < 0.0 || Texel.X > Resolution.X - 1 || Texel.Y > Resolution.Y - 1 || Texel.Z > Resolution.Z - 1)
+	{
+		// The volume covers everything that is closer than the maximum distance
+		return static_cast<float>(MaxDistance);
+	}
+
+	const int32 X0 = FMath::Min(FMath::FloorToInt32(Texel.X), Resolution.X - 2);
+	const int32 Y0 = FMath::Min(FMath::FloorToInt32(Texel.Y), Resolution.Y - 2);
+	const int32 Z0 = FMath::Min(FMath::FloorToInt32(Texel.Z), Resolution.Z - 2);
+	const float FX = static_cast<float>(Texel.X - X0);
+	const float FY = static_cast<float>(Texel.Y - Y0);
+	const float FZ = static_cast<float>(Texel.Z - Z0);
+
+	const int32 StrideY = Resolution.X;
+	const int32 StrideZ = Resolution.X * Resolution.Y;
+	const float* Corner = Distances.GetData() + Z0 * StrideZ + Y0 * StrideY + X0;
+	const float D00 = FMath::Lerp(Corner[0], Corner[1], FX);
+	const float D10 = FMath::Lerp(Corner[StrideY], Corner[StrideY + 1], FX);
+	const float D01 = FMath::Lerp(Corner[StrideZ], Corner[StrideZ + 1], FX);
+	const float D11 = FMath::Lerp(Corner[StrideZ + StrideY], Corner[StrideZ + StrideY + 1], FX);
+	return FMath::Lerp(FMath::Lerp(D00, D10, FY), FMath::Lerp(D01, D11, FY), FZ);
+}
@@ -157,6 +157,111 @@ struct MRUTILITYKIT_API FMRUKHit
 	float HitDistance = 0.0f;
 };
 
+/**
+ * Compact representation of a set of semantic labels. Every label gets interned into a process wide registry
+ * that assigns it a bit. The labels in FMRUKLabels always get the same bits, other labels get the next free bit
+ * when they are seen for the first time. Once all bits are taken, further labels share the overflow bit and
+ * have to be compared as strings.
+ */
+struct MRUTILITYKIT_API FMRUKLabelMask
+{
+	static constexpr uint64 OverflowBit = 1ull << 63;
+
+	uint64 Bits = 0;
+
+	/**
+	 * Intern the label and return its mask.
+	 * @param Label The label.
+	 * @return The mask with the bit of the label set or the overflow bit if no more bits are available.
+	 */
+	static FMRUKLabelMask FromLabel(const FString& Label);
+
+	/**
+	 * Intern all labels and return the combined mask.
+	 * @param Labels The labels.
+	 * @return The mask with the bits of all labels set.
+	 */
+	static FMRUKLabelMask FromLabels(const TArray<FString>& Labels);
+
+	/**
+	 * Look up the mask of a label without interning it.
+	 * @param Label The label.
+	 * @return The mask with the bit of the label set or an empty mask if the label didn't get a bit yet. Such a label
+	 *         can only be on anchors whose mask has the overflow bit set.
+	 */
+	static FMRUKLabelMask FindLabel(const FString& Label);
+
+	bool IsEmpty() const { return Bits == 0; }
+	bool HasOverflow() const { return (Bits & OverflowBit) != 0; }
+
+	FMRUKLabelMask& operator|=(FMRUKLabelMask Other)
+	{
+		Bits |= Other.Bits;
+		return *this;
+	}
+	bool operator==(const FMRUKLabelMask& Other) const { return Bits == Other.Bits; }
+	bool operator!=(const FMRUKLabelMask& Other) const { return Bits != Other.Bits; }
+};
+
+/**
+ * Precomputed masks of the labels in FMRUKLabels. The registry always assigns these bits to them, so they
+ * can be used without interning the label string first.
+ */
+struct MRUTILITYKIT_API FMRUKLabelMasks
+{
+	static constexpr FMRUKLabelMask Floor{ 1ull << 0 };
+	static constexpr FMRUKLabelMask WallFace{ 1ull << 1 };
+	static constexpr FMRUKLabelMask InvisibleWallFace{ 1ull << 2 };
+	static constexpr FMRUKLabelMask Ceiling{ 1ull << 3 };
+	static constexpr FMRUKLabelMask DoorFrame{ 1ull << 4 };
+	static constexpr FMRUKLabelMask WindowFrame{ 1ull << 5 };
+	static constexpr FMRUKLabelMask Couch{ 1ull << 6 };
+	static constexpr FMRUKLabelMask Table{ 1ull << 7 };
+	static constexpr FMRUKLabelMask Screen{ 1ull << 8 };
+	static constexpr FMRUKLabelMask Bed{ 1ull << 9 };
+	static constexpr FMRUKLabelMask Lamp{ 1ull << 10 };
+	static constexpr FMRUKLabelMask Plant{ 1ull << 11 };
+	static constexpr FMRUKLabelMask Storage{ 1ull << 12 };
+	static constexpr FMRUKLabelMask WallArt{ 1ull << 13 };
+	static constexpr FMRUKLabelMask GlobalMesh{ 1ull << 14 };
+	static constexpr FMRUKLabelMask Other{ 1ull << 15 };
+};
+
+/**
+ * Label filter compiled into include and exclude masks. Checking an anchor against it costs a few bit operations
+ * instead of comparing strings. Obtain it with FMRUKLabelFilter::Compile() once per query and then use it
+ * for every anchor.
+ */
+struct MRUTILITYKIT_API FMRUKCompiledLabelFilter
+{
+	FMRUKLabelMask IncludedMask;
+	FMRUKLabelMask ExcludedMask;
+	bool bHasIncludedLabels = false;
+
+	/**
+	 * Labels of the filter that didn't get a bit of their own, either because no anchor had them when the filter
+	 * was compiled or because all bits were taken. They are only used if the overflow bit of the checked labels
+	 * is set as well.
+	 */
+	TArray<FString> OverflowIncludedLabels;
+	TArray<FString> OverflowExcludedLabels;
+
+	/**
+	 * Check if the labels pass the filter.
+	 * @param Mask   The mask of the labels.
+	 * @param Labels The labels as strings. Only used in case the overflow bit is set.
+	 * @return Whether the filter passes or not.
+	 */
+	bool PassesFilter(FMRUKLabelMask Mask, const TArray<FString>& Labels) const;
+
+	/**
+	 * Create a filter that only lets labels pass that contain the given label.
+	 * @param Label The label.
+	 * @return The compiled filter.
+	 */
+	static FMRUKCompiledLabelFilter FromLabel(const FString& Label);
+};
+
 /**
  * Label filter to use in MRUK (Mixed Reality Utility Kit). You can use this to filter anchors by their labels.
  * use the IncludedLabels and ExcludedLabels list to specify which labels to include and exclude.
@@ -192,6 +297,14 @@ struct MRUTILITYKIT_API FMRUKLabelFilter
 	 * @return Whether the filter passes or not.
 	 */
 	bool PassesFilter(const TArray<FString>& Labels) const;
+
+	/**
+	 * Compile the filter into label masks. Use this when the same filter gets applied to many anchors.
+	 * The labels don't get interned, so the compiled filter only matches anchors that existed when it got
+	 * compiled. Compile it again for every query.
+	 * @return The compiled filter.
+	 */
+	FMRUKCompiledLabelFilter Compile() const;
 };
 
 /**
@@ -337,6 +450,20 @@ struct MRUTILITYKIT_API FMRUKSpawnGroup
 	EMRUKFallbackToProceduralOverwrite FallbackToProcedural = EMRUKFallbackToProceduralOverwrite::Default;
 };
 
+/**
+ * This enum is used to select which implementation is used to triangulate polygons, e.g. for the plane meshes of anchors.
+ */
+UENUM(BlueprintType)
+enum class EMRUKTriangulationBackend : uint8
+{
+	/// Use the MRUK shared library if it is available and fall back to the native implementation otherwise.
+	Auto,
+	/// Always use the native ear clipping implementation that is part of this plugin. Available on all platforms.
+	Native,
+	/// Always use the MRUK shared library. Only available on platforms where the library is shipped.
+	SharedLibrary,
+};
+
 /**
  * Implements the settings for the MRUtilityKit plugin. This is Unreal specific and not part of the MR Utility Kit library.
  */
@@ -355,6 +482,13 @@ public:
 	 */
 	UPROPERTY(config, EditAnywhere, Category = "MR Utility Kit")
 	bool EnableWorldLock = true;
+
+	/**
+	 * Select the implementation that is used to triangulate polygons with holes. The MRUK shared library
+	 * is only shipped for Windows and Android, on other platforms the native implementation is used.
+	 */
+	UPROPERTY(config, EditAnywhere, Category = "MR Utility Kit")
+	EMRUKTriangulationBackend TriangulationBackend = EMRUKTriangulationBackend::Auto;
 };
 
 /**
@@ -0,0 +1,55 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+
+struct FRandomStream;
+
+/**
+ * Samples indices proportional to a set of weights in constant time with Vose's alias method.
+ * Building the table is linear in the number of weights. Sampling draws exactly two numbers from the random stream,
+ * so the same seed always yields the same sequence of indices for the same weights.
+ */
+class MRUTILITYKIT_API FMRUKAliasTable
+{
+public:
+	/**
+	 * Build the table. Negative weights are treated as 0.
+	 * @param Weights The weights. If all of them are 0 the table will be empty.
+	 */
+	void Build(TConstArrayView<float> Weights);
+
+	/**
+	 * Remove all entries from the table.
+	 */
+	void Reset();
+
+	/**
+	 * Whether there is anything to sample.
+	 */
+	bool IsEmpty() const { return Probabilities.IsEmpty(); }
+
+	/**
+	 * Number of weights the table has been built with.
+	 */
+	int32 Num() const { return Probabilities.Num(); }
+
+	/**
+	 * Sum of all weights the table has been built with.
+	 */
+	double GetTotalWeight() const { return TotalWeight; }
+
+	/**
+	 * Pick a random index with a probability proportional to its weight.
+	 * @param RandomStream The random stream to draw from.
+	 * @return The index or INDEX_NONE if the table is empty.
+	 */
+	int32 Sample(const FRandomStream& RandomStream) const;
+
+private:
+	TArray<float> Probabilities;
+	TArray<int32> Aliases;
+	double TotalWeight = 0.0;
+};
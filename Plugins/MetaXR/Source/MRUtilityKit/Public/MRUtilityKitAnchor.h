@@ -4,6 +4,7 @@
 
 #include "GameFramework/Actor.h"
 #include "Dom/JsonObject.h"
+#include "MRUtilityKitAliasTable.h"
 #include "MRUtilityKitAnchorActorSpawner.h"
 
 #include "OculusXRAnchorTypes.h"
@@ -12,6 +13,7 @@
 
 class AMRUKRoom;
 class UMRUKAnchorData;
+struct FMRUKSnapshotAnchor;
 
 /**
  * Represents an anchor in the Mixed Reality Utility Kit. This combines an Unreal actor with the scene anchor.
@@ -115,6 +117,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	FVector GenerateRandomPositionOnPlaneFromStream(const FRandomStream& RandomStream);
 
+	/**
+	 * Area enclosed by the boundary of the plane. The triangulation that is needed for this is cached and
+	 * shared with GenerateRandomPositionOnPlaneFromStream().
+	 * @return The area in square world units or 0 if the anchor doesn't have a plane.
+	 */
+	double GetPlaneArea();
+
 	/**
 	 * Cast a ray and return the closest hit against the volume and plane bounds.
 	 * @param Origin         Origin The origin of the ray.
@@ -256,6 +265,28 @@ public:
 	void AttachProceduralMesh(const TArray<FString>& CutHoleLabels = {}, bool GenerateCollision = true, UMaterialInterface* ProceduralMaterial = nullptr);
 
 	TSharedRef<FJsonObject> JsonSerialize();
+	FMRUKSnapshotAnchor SnapshotSerialize();
+
+	/**
+	 * Check if the anchor passes the given compiled label filter. Prefer this over the FMRUKLabelFilter
+	 * overload when testing many anchors against the same filter.
+	 * @param LabelFilter The compiled filter.
+	 * @return Whether the anchor passes the filter.
+	 */
+	bool PassesCompiledLabelFilter(const FMRUKCompiledLabelFilter& LabelFilter) const;
+
+	/**
+	 * Check if the anchor has any of the labels in the mask. Use this with FMRUKLabelMasks to check for the known
+	 * labels without comparing strings. Labels that share the overflow bit are not considered.
+	 * @param Mask The label mask.
+	 * @return Whether the anchor has any of the labels.
+	 */
+	bool HasLabelMask(FMRUKLabelMask Mask) const;
+
+	/**
+	 * The semantic classifications as label mask. This is updated together with SemanticClassifications in LoadFromData().
+	 */
+	FMRUKLabelMask GetLabelMask() const { return LabelMask; }
 
 protected:
 	void EndPlay(EEndPlayReason::Type Reason) override;
@@ -268,14 +299,15 @@ private:
 	{
 		TArray<FVector2D> Vertices;
 		TArray<int32> Triangles;
-		TArray<float> Areas;
-		float TotalArea;
-
-		void Clear();
+		FMRUKAliasTable AreaTable;
 	};
 
+	const TriangulatedMeshCache& GetOrCreateCachedMesh();
+
 	UPROPERTY()
 	AActor* Interior = nullptr;
 
 	TOptional<TriangulatedMeshCache> CachedMesh;
+
+	FMRUKLabelMask LabelMask;
 };
@@ -0,0 +1,102 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/Map.h"
+#include "Math/Box.h"
+#include "Math/Box2D.h"
+#include "Math/IntRect.h"
+#include "Math/Transform.h"
+#include "UObject/ObjectPtr.h"
+
+class AMRUKAnchor;
+
+/**
+ * Maintains the parent/child relationships between the anchors of a room, e.g. a window frame on a wall, a table on
+ * the floor or a screen on a table, and writes them into AMRUKAnchor::ParentAnchor and AMRUKAnchor::ChildAnchors.
+ * Only anchors that have been added or whose transform, bounds or role changed since the last update get re-evaluated
+ * and only against anchors whose footprints share a cell of a uniform grid on the horizontal plane. The result is the
+ * same as testing every pair of anchors, including the order of the children and which parent wins if an anchor
+ * matches more than one.
+ */
+class MRUTILITYKIT_API FMRUKAnchorHierarchy
+{
+public:
+	/**
+	 * Forget all anchors. The next update re-evaluates everything.
+	 */
+	void Reset();
+
+	/**
+	 * Remove the anchor and all relationships it's part of. The anchors it was related to get their parent and
+	 * children updated on the next call to Update().
+	 * @param Anchor The anchor to remove. Does nothing if the anchor isn't known.
+	 */
+	void Remove(const AMRUKAnchor* Anchor);
+
+	/**
+	 * Bring the hierarchy up to date with the current state of the anchors. Anchors that are no longer in AllAnchors
+	 * are removed.
+	 * @param AllAnchors   All anchors of the room.
+	 * @param WallAnchors  The wall anchors of the room.
+	 * @param FloorAnchor  The floor anchor of the room, can be nullptr.
+	 * @return Number of anchors that had to be re-evaluated.
+	 */
+	int32 Update(TConstArrayView<TObjectPtr<AMRUKAnchor>> AllAnchors, TConstArrayView<TObjectPtr<AMRUKAnchor>> WallAnchors, AMRUKAnchor* FloorAnchor);
+
+	/**
+	 * Number of anchors that are part of the hierarchy.
+	 */
+	int32 Num() const { return Nodes.Num(); }
+
+private:
+	// Roles in the order in which the full pairwise algorithm assigns them. Later roles win.
+	enum class ERole : uint8
+	{
+		Wall,
+		Floor,
+		Volume,
+	};
+
+	struct FLink
+	{
+		AMRUKAnchor* Anchor;
+		ERole Role;
+	};
+
+	struct FNode
+	{
+		AMRUKAnchor* Anchor = nullptr;
+
+		// State the relationships have been evaluated with
+		FTransform Transform;
+		FBox2D PlaneBounds{ ForceInit };
+		FBox VolumeBounds{ ForceInit };
+		TArray<FVector2D> PlaneBoundary;
+		bool bIsWall = false;
+		bool bIsFloor = false;
+
+		// Grid cells covered by the footprint, inclusive
+		FIntRect Cells;
+		bool bInGrid = false;
+
+		TArray<FLink> Parents;
+		TArray<FLink> Children;
+
+		uint32 UpdateStamp = 0;
+		uint32 VisitStamp = 0;
+		bool bDirty = false;
+	};
+
+	void Unlink(FNode& Node);
+	void AddToGrid(FNode& Node);
+	void RemoveFromGrid(FNode& Node);
+	void Evaluate(FNode& Parent, FNode& Child);
+
+	TMap<const AMRUKAnchor*, FNode> Nodes;
+	TMap<FIntPoint, TArray<AMRUKAnchor*>> Grid;
+	uint32 UpdateStamp = 0;
+	uint32 VisitStamp = 0;
+};
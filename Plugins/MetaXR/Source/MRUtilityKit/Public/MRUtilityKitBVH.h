@@ -0,0 +1,219 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/Map.h"
+#include "Math/Box.h"
+
+class AMRUKAnchor;
+
+/**
+ * Bounding volume hierarchy over the planes and volumes of the anchors in a room.
+ * This is implemented as a dynamic AABB tree so that anchors can be inserted, moved and removed
+ * without rebuilding the whole hierarchy. Leaf bounds are enlarged by a small margin so that
+ * minor changes of an anchor's transform don't require the leaf to be reinserted.
+ * The bounds are expected to be in the local coordinate space of the room.
+ */
+class MRUTILITYKIT_API FMRUKAnchorBVH
+{
+public:
+	/**
+	 * Remove all anchors from the hierarchy.
+	 */
+	void Reset();
+
+	/**
+	 * Insert the anchor into the hierarchy or update its bounds if it's already part of it.
+	 * @param Anchor The anchor to insert or update.
+	 * @param Bounds The bounds of the anchor in room space. If the bounds are invalid the anchor will be removed.
+	 */
+	void InsertOrUpdate(AMRUKAnchor* Anchor, const FBox& Bounds);
+
+	/**
+	 * Remove the anchor from the hierarchy. Does nothing if the anchor isn't part of it.
+	 * @param Anchor The anchor to remove.
+	 */
+	void Remove(const AMRUKAnchor* Anchor);
+
+	/**
+	 * Check if the anchor is part of the hierarchy.
+	 */
+	bool Contains(const AMRUKAnchor* Anchor) const { return AnchorToLeaf.Contains(Anchor); }
+
+	/**
+	 * Number of anchors in the hierarchy.
+	 */
+	int32 Num() const { return AnchorToLeaf.Num(); }
+
+	/**
+	 * Height of the tree. Useful for debugging and testing the balancing.
+	 */
+	int32 GetHeight() const { return Root == INDEX_NONE ? 0 : Nodes[Root].Height; }
+
+	/**
+	 * Visit all anchors whose bounds are intersected by the ray. The callback receives the anchor and the current
+	 * maximum distance and may lower the maximum distance to prune the remaining traversal, e.g. for closest hit queries.
+	 * @param Origin    Origin of the ray in room space.
+	 * @param Direction Direction of the ray in room space. Distances are measured in multiples of this vector.
+	 * @param MaxDist   The maximum distance the ray should travel. Everything below or equal to zero is treated as infinity.
+	 * @param Callback  Callable with the signature void(AMRUKAnchor*, float& MaxDist).
+	 */
+	template <typename CallbackType>
+	void Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, CallbackType&& Callback) const;
+
+	/**
+	 * Visit anchors ordered roughly by distance to the position. Subtrees whose bounds are further away than the
+	 * current maximum distance are skipped.
+	 * @param Position    The position in room space.
+	 * @param DistanceScale Scale applied to room space distances to get the distances the callback measures in.
+	 * @param MaxDistance The maximum distance. Can be lowered by the callback.
+	 * @param Callback    Callable with the signature void(AMRUKAnchor*, double& MaxDistance).
+	 */
+	template <typename CallbackType>
+	void QueryClosest(const FVector& Position, double DistanceScale, double& MaxDistance, CallbackType&& Callback) const;
+
+	/**
+	 * Visit all anchors whose bounds overlap with the given box.
+	 * @param Box      The box in room space.
+	 * @param Callback Callable with the signature void(AMRUKAnchor*).
+	 */
+	template <typename CallbackType>
+	void QueryOverlap(const FBox& Box, CallbackType&& Callback) const;
+
+private:
+	struct FNode
+	{
+		FBox Bounds{ ForceInit };
+		AMRUKAnchor* Anchor = nullptr;
+		int32 Parent = INDEX_NONE;
+		int32 Child1 = INDEX_NONE;
+		int32 Child2 = INDEX_NONE;
+		// Leaf = 0, free node = -1
+		int32 Height = 0;
+
+		bool IsLeaf() const { return Child1 == INDEX_NONE; }
+	};
+
+	int32 AllocateNode();
+	void FreeNode(int32 NodeIndex);
+	void InsertLeaf(int32 Leaf);
+	void RemoveLeaf(int32 Leaf);
+	int32 Balance(int32 NodeIndex);
+	void RefitAncestors(int32 NodeIndex);
+
+	static bool RayIntersectsBox(const FBox& Box, const FVector& Origin, const FVector& InvDirection, double MaxDist);
+
+	TArray<FNode> Nodes;
+	TMap<const AMRUKAnchor*, int32> AnchorToLeaf;
+	int32 Root = INDEX_NONE;
+	int32 FreeList = INDEX_NONE;
+};
+
+template <typename CallbackType>
+void FMRUKAnchorBVH::Raycast(const FVector& Origin, const FVector& Direction, float MaxDist, CallbackType&& Callback) const
+{
+	if (Root == INDEX_NONE)
+	{
+		return;
+	}
+
+	const FVector InvDirection(
+		Direction.X != 0.0 ? 1.0 / Direction.X : UE_BIG_NUMBER,
+		Direction.Y != 0.0 ? 1.0 / Direction.Y : UE_BIG_NUMBER,
+		Direction.Z != 0.0 ? 1.0 / Direction.Z : UE_BIG_NUMBER);
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(Root);
+	while (!Stack.IsEmpty())
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!RayIntersectsBox(Node.Bounds, Origin, InvDirection, MaxDist <= 0.0f ? UE_BIG_NUMBER : MaxDist))
+		{
+			continue;
+		}
+		if (Node.IsLeaf())
+		{
+			Callback(Node.Anchor, MaxDist);
+		}
+		else
+		{
+			Stack.Push(Node.Child1);
+			Stack.Push(Node.Child2);
+		}
+	}
+}
+
+template <typename CallbackType>
+void FMRUKAnchorBVH::QueryClosest(const FVector& Position, double DistanceScale, double& MaxDistance, CallbackType&& Callback) const
+{
+	if (Root == INDEX_NONE)
+	{
+		return;
+	}
+
+	struct FEntry
+	{
+		int32 Node;
+		double Distance;
+	};
+	TArray<FEntry, TInlineAllocator<64>> Stack;
+	Stack.Push({ Root, FMath::Sqrt(Nodes[Root].Bounds.ComputeSquaredDistanceToPoint(Position)) * DistanceScale });
+	while (!Stack.IsEmpty())
+	{
+		const FEntry Entry = Stack.Pop(EAllowShrinking::No);
+		if (Entry.Distance >= MaxDistance)
+		{
+			continue;
+		}
+		const FNode& Node = Nodes[Entry.Node];
+		if (Node.IsLeaf())
+		{
+			Callback(Node.Anchor, MaxDistance);
+			continue;
+		}
+
+		const double Distance1 = FMath::Sqrt(Nodes[Node.Child1].Bounds.ComputeSquaredDistanceToPoint(Position)) * DistanceScale;
+		const double Distance2 = FMath::Sqrt(Nodes[Node.Child2].Bounds.ComputeSquaredDistanceToPoint(Position)) * DistanceScale;
+		// Push the closer child last so it gets visited first which tightens MaxDistance as early as possible
+		if (Distance1 < Distance2)
+		{
+			Stack.Push({ Node.Child2, Distance2 });
+			Stack.Push({ Node.Child1, Distance1 });
+		}
+		else
+		{
+			Stack.Push({ Node.Child1, Distance1 });
+			Stack.Push({ Node.Child2, Distance2 });
+		}
+	}
+}
+
+template <typename CallbackType>
+void FMRUKAnchorBVH::QueryOverlap(const FBox& Box, CallbackType&& Callback) const
+{
+	if (Root == INDEX_NONE)
+	{
+		return;
+	}
+
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Push(Root);
+	while (!Stack.IsEmpty())
+	{
+		const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+		if (!Node.Bounds.Intersect(Box))
+		{
+			continue;
+		}
+		if (Node.IsLeaf())
+		{
+			Callback(Node.Anchor);
+		}
+		else
+		{
+			Stack.Push(Node.Child1);
+			Stack.Push(Node.Child2);
+		}
+	}
+}
@@ -9,6 +9,8 @@
 /**
  * Adds a blob shadow below the actor.
  * The blob shadow will position and resize itself automatically during runtime.
+ * During play the blob shadow is updated by UMRUKBlobShadowSubsystem which only traces the ground again once the
+ * owner moved.
  */
 UCLASS(ClassGroup = MRUtilityKit, Blueprintable, BlueprintType, meta = (BlueprintSpawnableComponent, DisplayName = "MR Utility Kit Blob Shadow Component"))
 class MRUTILITYKIT_API UMRUKBlobShadowComponent : public UStaticMeshComponent
@@ -63,10 +65,28 @@ public:
 	UMRUKBlobShadowComponent();
 
 	void BeginPlay() override;
+	void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	void ComputeOwner2DBounds(FVector& Origin, FVector2D& Extent, double& Yaw) const;
 
 protected:
 	UPROPERTY()
 	UMaterialInstanceDynamic* DynMaterial;
+
+private:
+	friend class UMRUKBlobShadowSubsystem;
+
+	// Scale and rotate the plane to the bounds of the owner. Returns the extent and the origin for the ground trace.
+	FVector2D UpdatePlaneSizeAndRotation(FVector& OutOrigin);
+	// Place the plane on the ground or hide it if no ground has been hit
+	void ApplyGroundHit(const FVector2D& Extent, const FHitResult* Hit);
+	// Push the material parameters that changed more than a small tolerance since they were pushed last time
+	void UpdateMaterialParameters();
+
+	FVector2D ShadowExtent = FVector2D::ZeroVector;
+	// Distance to the ground or a negative value if no ground has been hit
+	float GroundDistance = -1.0f;
+	// Values that have been pushed to the material: CornerWorldSize, Gradient, GradientPower and Opacity
+	float MaterialParameters[4] = {};
+	bool bMaterialParametersPushed = false;
 };
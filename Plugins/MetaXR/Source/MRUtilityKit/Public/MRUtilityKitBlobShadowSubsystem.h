@@ -0,0 +1,109 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WorldCollision.h"
+#include "MRUtilityKitBlobShadowSubsystem.generated.h"
+
+class UMRUKBlobShadowComponent;
+
+/**
+ * Statistics about the last update of the blob shadows.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKBlobShadowStats
+{
+	GENERATED_BODY()
+
+	/**
+	 * Number of blob shadows that are updated by the subsystem.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 Shadows = 0;
+
+	/**
+	 * Number of traces that have been started in the last frame.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 TracesIssued = 0;
+
+	/**
+	 * Number of blob shadows whose owner didn't move in the last frame and therefore didn't need a trace.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 TracesSkipped = 0;
+
+	/**
+	 * Number of trace results from the previous frame that have been applied to blob shadows in the last frame.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 ResultsApplied = 0;
+
+	/**
+	 * Time in milliseconds the last update took on the game thread.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	float UpdateTimeMs = 0.0f;
+};
+
+/**
+ * Updates all blob shadows of a world at once. Instead of every blob shadow tracing the ground on its own each tick,
+ * the subsystem starts async sweeps for the blob shadows whose owner moved and applies the results in the next frame.
+ * Blob shadows register themselves at BeginPlay.
+ */
+UCLASS()
+class MRUTILITYKIT_API UMRUKBlobShadowSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Statistics about the last update.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	FMRUKBlobShadowStats Stats;
+
+	/**
+	 * Distance in cm and angle in radians the owner of a blob shadow has to move before the ground is traced again.
+	 */
+	UPROPERTY(BlueprintReadWrite, Category = "MR Utility Kit")
+	float TransformTolerance = 0.01f;
+
+	/**
+	 * Start updating the given blob shadow. The blob shadow is expected to be up to date at this point.
+	 */
+	void Register(UMRUKBlobShadowComponent* BlobShadow);
+
+	/**
+	 * Stop updating the given blob shadow.
+	 */
+	void Unregister(UMRUKBlobShadowComponent* BlobShadow);
+
+	/**
+	 * Trace the ground for the given blob shadow in the next update even if its owner didn't move,
+	 * e.g. because the bounds of the owner or the ground below it changed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void Invalidate(UMRUKBlobShadowComponent* BlobShadow);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FShadow
+	{
+		TWeakObjectPtr<UMRUKBlobShadowComponent> Component;
+		// State the last trace has been started with
+		FTransform OwnerTransform;
+		float ExtraExtent = 0.0f;
+		float MaxVerticalDistance = 0.0f;
+		bool bDirty = false;
+
+		FTraceHandle PendingTrace;
+		FVector2D PendingExtent = FVector2D::ZeroVector;
+	};
+
+	TArray<FShadow> Shadows;
+};
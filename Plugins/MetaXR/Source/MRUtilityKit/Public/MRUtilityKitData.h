@@ -5,6 +5,7 @@
 #include "GameFramework/Actor.h"
 #include "OculusXRRoomLayoutManagerComponent.h"
 #include "Dom/JsonValue.h"
+#include "MRUtilityKitSceneSnapshot.h"
 #include "MRUtilityKitData.generated.h"
 
 /**
@@ -59,6 +60,7 @@ public:
 
 	void LoadFromDevice(const FOculusXRAnchorsDiscoverResult& AnchorsDiscoverResult);
 	void LoadFromJson(const FJsonValue& Value);
+	void LoadFromSnapshot(const FMRUKSnapshotAnchor& Anchor);
 };
 
 /**
@@ -90,6 +92,7 @@ public:
 
 	void LoadFromDevice(const FOculusXRAnchorsDiscoverResult& AnchorsDiscoverResult);
 	void LoadFromJson(const FJsonValue& Value);
+	void LoadFromSnapshot(const FMRUKSnapshotRoom& Room);
 
 private:
 	void FinishQuery(bool Success);
@@ -122,6 +125,7 @@ public:
 
 	void LoadFromDevice();
 	void LoadFromJson(const FString& Json);
+	void LoadFromSnapshot(TConstArrayView<uint8> Snapshot);
 
 private:
 	int32 NumRoomsLeftToInitialize = 0;
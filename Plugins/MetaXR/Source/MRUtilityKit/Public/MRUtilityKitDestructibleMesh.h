@@ -9,6 +9,51 @@
 #include "Tasks/Task.h"
 #include "MRUtilityKitDestructibleMesh.generated.h"
 
+/**
+ * Statistics about spawning the segments of a destructible mesh.
+ */
+USTRUCT(BlueprintType)
+struct MRUTILITYKIT_API FMRUKDestructibleMeshSpawnStats
+{
+	GENERATED_BODY()
+
+	/**
+	 * Number of segments that have been spawned in the last frame.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 SegmentsSpawnedLastFrame = 0;
+
+	/**
+	 * Time in milliseconds spent spawning segments in the last frame.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	float SpawnTimeLastFrameMs = 0.0f;
+
+	/**
+	 * Longest time in milliseconds that was spent spawning segments in a single frame.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	float MaxSpawnTimePerFrameMs = 0.0f;
+
+	/**
+	 * Total number of segments that have been spawned, including the reserved segment.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 SegmentsSpawned = 0;
+
+	/**
+	 * Number of segments that are waiting to be spawned.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 SegmentsPending = 0;
+
+	/**
+	 * Number of frames in which segments have been spawned.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	int32 Frames = 0;
+};
+
 /**
  * Destructible mesh component. Creates mesh segments for the given geometry.
  * The segments will be created async.
@@ -49,6 +94,29 @@ public:
 	UPROPERTY(EditAnywhere, Category = "MR Utility Kit")
 	double ReservedBottom = 30.0;
 
+	/**
+	 * Time in milliseconds that may be spent per frame on spawning mesh segments. Segments that don't fit into
+	 * the budget are spawned in the following frames, closest to the viewer first. At least one segment is spawned
+	 * per frame. 0 or less spawns all segments in the frame in which the segmentation finished.
+	 * OnMeshesGenerated is broadcast once every segment has been spawned.
+	 */
+	UPROPERTY(EditAnywhere, Category = "MR Utility Kit")
+	float SpawnBudgetMs = 0.0f;
+
+	/**
+	 * Cook the collision of the mesh segments on a background thread. The collision of a segment may become
+	 * available a few frames after it has been spawned, which means also after OnMeshesGenerated has been broadcast.
+	 * Only enable this if nothing relies on the collision being there right away.
+	 */
+	UPROPERTY(EditAnywhere, Category = "MR Utility Kit")
+	bool bUseAsyncCollisionCooking = false;
+
+	/**
+	 * Statistics about spawning the mesh segments. Updated every frame while segments are being spawned.
+	 */
+	UPROPERTY(BlueprintReadOnly, Category = "MR Utility Kit")
+	FMRUKDestructibleMeshSpawnStats SpawnStats;
+
 	/**
 	 * Segment the given geometry into smaller chunks. For each chunk a procedural mesh component will be spawned and attached to the owning actor.
 	 * @param MeshPositions Positions of the mesh to segment
@@ -61,7 +129,26 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 private:
-	UE::Tasks::TTask<TPair<TArray<FMRUKMeshSegment>, FMRUKMeshSegment>> TaskResult;
+	friend class FMRUKDestructibleMeshSpec;
+
+	struct FSegmentationResult
+	{
+		TArray<FMRUKMeshSegment> Segments;
+		FMRUKMeshSegment ReservedSegment;
+		// Centers of the segments in component space. The center of the reserved segment comes last.
+		TArray<FVector> Centers;
+	};
+
+	void StartSpawningSegments(FSegmentationResult&& Result);
+	bool SpawnPendingSegments(float BudgetMs);
+	void SpawnSegment(int32 Index);
+	void SortPendingSegmentsByViewerDistance();
+
+	UE::Tasks::TTask<FSegmentationResult> TaskResult;
+	FSegmentationResult Segmentation;
+	// Indices into Segmentation.Segments that still have to be spawned, the closest segment comes last.
+	// Segmentation.Segments.Num() stands for the reserved segment.
+	TArray<int32> PendingSegments;
 };
 
 /**
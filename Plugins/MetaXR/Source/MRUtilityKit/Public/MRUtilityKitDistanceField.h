@@ -0,0 +1,91 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Transform.h"
+
+class AMRUKRoom;
+
+/**
+ * Signed distance field of the free space in one or more rooms computed on the CPU.
+ * The field is the CPU counterpart of the distance map that AMRUKDistanceMapGenerator renders with the jump flood
+ * algorithm on the GPU. It is built from the same geometry as the mask meshes of the generator: the floor polygon of a
+ * room marks free space and the footprint of every volume anchor marks occupied space. Everything outside of the
+ * floor is occupied space as well.
+ * The grid is laid out exactly like the orthographic scene capture of the generator, so texel (X, Y) of the field
+ * corresponds to pixel (X, Y) of the distance map render target.
+ * Distances are exact euclidean distances between texel centers (Felzenszwalb & Huttenlocher) which makes them
+ * suitable for gameplay queries without a GPU.
+ */
+class MRUTILITYKIT_API FMRUKDistanceField
+{
+public:
+	/**
+	 * Build the distance field for the given rooms.
+	 * @param Rooms        The rooms that should be rasterized into the field.
+	 * @param CaptureView  Transform of the capture. Like a camera it looks along its X axis, Y points right and Z up.
+	 * @param Width        Width and height of the captured area in world units.
+	 * @param Resolution   Number of texels along each side of the field.
+	 */
+	void Build(TConstArrayView<const AMRUKRoom*> Rooms, const FTransform& CaptureView, double Width, int32 Resolution);
+
+	/**
+	 * Free all memory held by the field.
+	 */
+	void Reset();
+
+	/**
+	 * Whether the field has been built.
+	 */
+	bool IsValid() const { return Resolution > 0; }
+
+	/**
+	 * Sample the signed distance at the given world position with bilinear filtering. The position gets projected
+	 * onto the capture plane first. Positions outside of the captured area are clamped to the border of the field.
+	 * @param WorldPosition The position in world space.
+	 * @return The distance in world units to the closest boundary between free and occupied space. Positive in free
+	 * space and negative in occupied space. 0 if the field hasn't been built.
+	 */
+	float SampleDistance(const FVector& WorldPosition) const;
+
+	/**
+	 * Signed distance of a texel in world units. Positive in free space and negative in occupied space.
+	 */
+	float GetDistanceAtTexel(int32 X, int32 Y) const { return Distances[Y * Resolution + X]; }
+
+	/**
+	 * Convert a world position into continuous texel coordinates. Texel (X, Y) covers the range [X, X + 1) x [Y, Y + 1).
+	 */
+	FVector2D WorldToTexel(const FVector& WorldPosition) const;
+
+	/**
+	 * World position of the center of the given texel on the capture plane.
+	 */
+	FVector TexelToWorld(int32 X, int32 Y) const;
+
+	/**
+	 * Number of texels along each side of the field.
+	 */
+	int32 GetResolution() const { return Resolution; }
+
+	/**
+	 * Size of a texel in world units.
+	 */
+	double GetTexelSize() const { return TexelSize; }
+
+	/**
+	 * All signed distances in row major order starting at the top left texel.
+	 */
+	const TArray<float>& GetDistances() const { return Distances; }
+
+private:
+	void Rasterize(TConstArrayView<const AMRUKRoom*> Rooms, TArray<float>& OutFree) const;
+
+	TArray<float> Distances;
+	FTransform CaptureView;
+	double Width = 0.0;
+	double TexelSize = 0.0;
+	int32 Resolution = 0;
+};
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "MRUtilityKit.h"
+#include "MRUtilityKitDistanceField.h"
 #include "GameFramework/Actor.h"
 #include "MRUtilityKitDistanceMapGenerator.generated.h"
 
@@ -39,6 +40,9 @@ enum class EMRUKDistanceMapGenerationMode : uint8
  * attached are tagged with GMRUK_DISTANCE_MAP_ACTOR_TAG. In case you don't want them to show up in your
  * scene capture you can hide them by receiving all these actors with the tag GMRUK_DISTANCE_MAP_ACTOR_TAG
  * and add these to the scene captures hidden actors.
+ *
+ * Alternatively the distance map can be computed on the CPU with ComputeDistanceFieldCPU(). This works without a GPU
+ * and the result can be sampled by game logic with GetDistanceAtLocation().
  */
 UCLASS(ClassGroup = MRUtilityKit, meta = (DisplayName = "MR Utility Kit Distance Map Generator"))
 class MRUTILITYKIT_API AMRUKDistanceMapGenerator : public AActor
@@ -108,6 +112,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
 	class UMaterialInterface* DistanceMapAllSpaceMaterial;
 
+	/**
+	 * Resolution of the distance field that is computed on the CPU. Only used if the scene capture doesn't have a
+	 * texture target, otherwise the resolution of the texture target is used so that texels line up with the GPU result.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MR Utility Kit")
+	int32 DistanceFieldResolution = 512;
+
 	/**
 	 * Capture the distance map.
 	 * @return The captured distance map.
@@ -145,6 +156,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	UCanvasRenderTarget2D* GetDistanceMapRenderTarget() const;
 
+	/**
+	 * Compute the distance field on the CPU from the same geometry that is used for the mask meshes.
+	 * The field covers the same area as the scene capture. No GPU is required for this and the mask meshes
+	 * don't need to exist. The rooms are taken from the MRUK subsystem according to SpawnMode. If SpawnMode is
+	 * None the rooms passed to CreateMaskMeshesForRoom() are used.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void ComputeDistanceFieldCPU();
+
+	/**
+	 * Sample the distance field that has been computed with ComputeDistanceFieldCPU().
+	 * @param WorldLocation The location in world space. It gets projected onto the capture plane.
+	 * @return Distance in world units to the closest boundary between free and occupied space. Positive in free space
+	 * and negative in occupied space.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	float GetDistanceAtLocation(const FVector& WorldLocation) const;
+
+	/**
+	 * Upload the distance field that has been computed with ComputeDistanceFieldCPU() to DistanceMapRenderTarget.
+	 * The red channel receives the signed distance in world units, so the render target should have a floating point format.
+	 * @return The render target or nullptr if there is nothing to upload or rendering isn't available.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	UTexture* UploadDistanceFieldToRenderTarget();
+
+	/**
+	 * The distance field that has been computed with ComputeDistanceFieldCPU().
+	 */
+	const FMRUKDistanceField& GetDistanceField() const { return DistanceField; }
+
 	/**
 	 * Retrieve the view info from the scene capture. This is useful for re projection of
 	 * the distance map in a material.
@@ -164,6 +206,11 @@ private:
 
 	int32 DistanceMapRT = -1;
 
+	FMRUKDistanceField DistanceField;
+
+	UPROPERTY()
+	class UTexture2D* DistanceFieldTexture = nullptr;
+
 	UPROPERTY()
 	class UMaterialInstanceDynamic* JFPassMaterialInstance = nullptr;
 
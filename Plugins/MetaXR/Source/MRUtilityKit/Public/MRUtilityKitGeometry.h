@@ -5,4 +5,31 @@
 #include "Containers/Array.h"
 #include "Math/Vector2D.h"
 
+enum class EMRUKTriangulationBackend : uint8;
+
+/**
+ * Triangulate a polygon with holes. The first polygon defines the outline, following polygons define holes.
+ * Any winding order works for both the outline and the holes. The resulting triangles are counter clockwise and
+ * the resulting vertices are the input points in the order they were passed in.
+ * The backend that is used is the one configured in the MRUK project settings.
+ * @param Polygons  The outline followed by the holes.
+ * @param Vertices  The vertices of the triangulated mesh.
+ * @param Indices   The triangle indices of the triangulated mesh.
+ */
 MRUTILITYKIT_API void MRUKTriangulatePolygon(const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices);
+
+/**
+ * Same as MRUKTriangulatePolygon() but explicitly selects the triangulation backend.
+ * @param Polygons  The outline followed by the holes.
+ * @param Vertices  The vertices of the triangulated mesh.
+ * @param Indices   The triangle indices of the triangulated mesh.
+ * @param Backend   The backend to use for triangulation.
+ */
+MRUTILITYKIT_API void MRUKTriangulatePolygon(const TArray<TArray<FVector2f>>& Polygons, TArray<FVector2D>& Vertices, TArray<int32>& Indices, EMRUKTriangulationBackend Backend);
+
+/**
+ * Check if a triangulation backend can be used on this platform. The native backend is always available.
+ * @param Backend   The backend to check.
+ * @return Whether the backend is available.
+ */
+MRUTILITYKIT_API bool MRUKIsTriangulationBackendAvailable(EMRUKTriangulationBackend Backend);
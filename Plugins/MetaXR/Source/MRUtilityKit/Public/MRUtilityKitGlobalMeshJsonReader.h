@@ -0,0 +1,43 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/StringView.h"
+#include "OculusXRAnchorTypes.h"
+
+/**
+ * Describes why reading JSON failed.
+ */
+struct MRUTILITYKIT_API FMRUKJsonReadError
+{
+	/**
+	 * Offset in code units from the start of the input where the error was detected. For UTF-8 input this is the
+	 * byte offset. INDEX_NONE if the input was well formed but didn't contain the requested data.
+	 */
+	int64 Offset = INDEX_NONE;
+
+	/**
+	 * Human readable description of the error.
+	 */
+	FString Message;
+};
+
+/**
+ * Read the global mesh of a room from the MRUK JSON scene format without building a JSON DOM.
+ * The input is scanned once, everything except the global mesh of the requested room is skipped and the positions and
+ * indices are written directly into the output arrays which get reserved to their exact size up front.
+ * Reading stops as soon as the global mesh of the room has been read, so malformed data after it is not detected.
+ * @param Json         The JSON scene.
+ * @param RoomUUID     UUID of the room whose global mesh should be read.
+ * @param OutPositions The vertex positions of the global mesh.
+ * @param OutIndices   The triangle indices of the global mesh.
+ * @param OutError     Optional, receives the reason and location of a failure.
+ * @return Whether the global mesh was found and read successfully.
+ */
+MRUTILITYKIT_API bool MRUKReadGlobalMeshFromJson(FStringView Json, const FOculusXRUUID& RoomUUID, TArray<FVector>& OutPositions, TArray<int32>& OutIndices, FMRUKJsonReadError* OutError = nullptr);
+
+/**
+ * Same as above but reads UTF-8 encoded JSON, e.g. a file that has been loaded into memory as is.
+ */
+MRUTILITYKIT_API bool MRUKReadGlobalMeshFromJson(FUtf8StringView Json, const FOculusXRUUID& RoomUUID, TArray<FVector>& OutPositions, TArray<int32>& OutIndices, FMRUKJsonReadError* OutError = nullptr);
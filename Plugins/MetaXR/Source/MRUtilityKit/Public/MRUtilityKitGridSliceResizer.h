@@ -4,8 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
+#include "UObject/ObjectKey.h"
 #include "MRUtilityKitGridSliceResizer.generated.h"
 
+class FStaticMeshRenderData;
+
 UENUM(BlueprintType, Meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
 enum class EMRUKScaleCenterMode : uint8
 {
@@ -15,6 +18,135 @@ enum class EMRUKScaleCenterMode : uint8
 	ZAxis = 4,
 };
 
+/**
+ * Everything that determines the positions of a sliced mesh.
+ */
+struct MRUTILITYKIT_API FMRUKGridSliceKey
+{
+	FObjectKey Mesh;
+	FVector Scale = FVector::OneVector;
+	FVector BorderPositive = FVector::OneVector;
+	FVector BorderNegative = FVector::OneVector;
+	FVector SlicerPivotOffset = FVector::ZeroVector;
+	uint8 ScaleCenterMode = 0;
+
+	bool operator==(const FMRUKGridSliceKey& Other) const
+	{
+		return Mesh == Other.Mesh && Scale == Other.Scale && BorderPositive == Other.BorderPositive && BorderNegative == Other.BorderNegative
+			&& SlicerPivotOffset == Other.SlicerPivotOffset && ScaleCenterMode == Other.ScaleCenterMode;
+	}
+
+	friend uint32 GetTypeHash(const FMRUKGridSliceKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.Scale));
+		Hash = HashCombine(Hash, GetTypeHash(Key.BorderPositive));
+		Hash = HashCombine(Hash, GetTypeHash(Key.BorderNegative));
+		Hash = HashCombine(Hash, GetTypeHash(Key.SlicerPivotOffset));
+		return HashCombine(Hash, GetTypeHash(Key.ScaleCenterMode));
+	}
+};
+
+/**
+ * The vertex data of LOD0 of a static mesh that doesn't change when the mesh gets sliced.
+ */
+struct MRUTILITYKIT_API FMRUKGridSliceMeshData
+{
+	// Positions in a packed SoA layout: all X coordinates, followed by all Y and all Z coordinates
+	TArray<float> Positions;
+	TArray<FVector> Normals;
+	TArray<FVector2D> UVs;
+	TArray<FColor> Colors;
+	TArray<int32> Triangles;
+	FBox Bounds{ ForceInit };
+	int32 NumVertices = 0;
+
+	// Render data the vertices have been read from. The mesh data is out of date once the mesh has been rebuilt.
+	const FStaticMeshRenderData* RenderData = nullptr;
+
+	SIZE_T GetAllocatedSize() const;
+};
+
+/**
+ * Positions of a sliced mesh.
+ */
+struct MRUTILITYKIT_API FMRUKGridSlice
+{
+	TSharedPtr<const FMRUKGridSliceMeshData> MeshData;
+
+	// Positions in a packed SoA layout: all X coordinates, followed by all Y and all Z coordinates
+	TArray<double> Positions;
+
+	SIZE_T GetAllocatedSize() const { return Positions.GetAllocatedSize(); }
+};
+
+/**
+ * Slices that have been computed by any grid slice resizer, so that components with the same mesh and settings don't
+ * have to read the mesh and slice it again. The cache holds on to the least recently used slices until it exceeds
+ * its memory budget. It must only be used from the game thread.
+ */
+class MRUTILITYKIT_API FMRUKGridSliceCache
+{
+public:
+	struct FStats
+	{
+		int32 Hits = 0;
+		int32 Misses = 0;
+		int32 Evictions = 0;
+	};
+
+	static FMRUKGridSliceCache& Get();
+
+	/**
+	 * Find a slice that has been computed before.
+	 */
+	TSharedPtr<const FMRUKGridSlice> Find(const FMRUKGridSliceKey& Key);
+
+	/**
+	 * Add a slice and evict the least recently used ones in case the cache exceeds its memory budget.
+	 */
+	void Add(const FMRUKGridSliceKey& Key, TSharedRef<const FMRUKGridSlice> Slice);
+
+	/**
+	 * Get the vertex data of the given mesh. The mesh gets only read in case it hasn't been read before or has been
+	 * rebuilt since then.
+	 */
+	TSharedRef<const FMRUKGridSliceMeshData> FindOrAddMeshData(const class UStaticMesh* Mesh);
+
+	/**
+	 * Set the memory budget in bytes.
+	 */
+	void SetMaxBytes(SIZE_T InMaxBytes);
+	SIZE_T GetMaxBytes() const { return MaxBytes; }
+
+	/**
+	 * Memory held by the slices and mesh data in the cache.
+	 */
+	SIZE_T GetAllocatedBytes() const { return AllocatedBytes; }
+
+	const FStats& GetStats() const { return Stats; }
+
+	/**
+	 * Remove all slices and mesh data and reset the statistics.
+	 */
+	void Reset();
+
+private:
+	struct FCachedSlice
+	{
+		TSharedRef<const FMRUKGridSlice> Slice;
+		uint64 LastUse;
+	};
+
+	void Evict();
+
+	TMap<FMRUKGridSliceKey, FCachedSlice> Slices;
+	TMap<FObjectKey, TSharedRef<const FMRUKGridSliceMeshData>> MeshData;
+	SIZE_T MaxBytes = 32 * 1024 * 1024;
+	SIZE_T AllocatedBytes = 0;
+	uint64 UseCounter = 0;
+	FStats Stats;
+};
+
 /**
  * The GridSliceResizerComponent is a versatile tool designed to maintain the proportions of
  * specific areas of 3D meshes while allowing others to stretch during scaling. This component
@@ -59,6 +191,8 @@ enum class EMRUKScaleCenterMode : uint8
  *
  * This component is only compatible with static meshes that have CPU access enabled. Ensure you enable CPU
  * access in the static mesh editor.
+ *
+ * Slices are shared through FMRUKGridSliceCache between all components that use the same mesh, scale and settings.
  */
 UCLASS(ClassGroup = MRUtilityKit, Blueprintable, BlueprintType, meta = (BlueprintSpawnableComponent, DisplayName = "MR Utility Kit Grid Slice Resizer Component"))
 class MRUTILITYKIT_API UMRUKGridSliceResizerComponent : public USceneComponent
@@ -188,4 +322,13 @@ private:
 	class UProceduralMeshComponent* ProcMesh;
 
 	FVector ResizerScale = FVector::OneVector;
+
+	// The slice that is currently shown by the procedural mesh
+	FMRUKGridSliceKey AppliedSliceKey;
+	const FStaticMeshRenderData* AppliedRenderData = nullptr;
+	bool bAppliedSliceCollision = false;
+	// Number of times the procedural mesh has been updated
+	int32 MeshSectionUpdates = 0;
+
+	FMRUKGridSliceKey MakeSliceKey() const;
 };
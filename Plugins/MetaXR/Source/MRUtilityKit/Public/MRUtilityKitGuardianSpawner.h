@@ -5,6 +5,7 @@
 #include "MRUtilityKit.h"
 #include "GameFramework/Actor.h"
 #include "MRUtilityKitGuardian.h"
+#include "MRUtilityKitSurfaceDistanceVolume.h"
 #include "MRUtilityKitGuardianSpawner.generated.h"
 
 class AMRUKRoom;
@@ -42,6 +43,20 @@ public:
 	UPROPERTY(EditAnywhere, Category = "MR Utility Kit")
 	bool EnableFade = true;
 
+	/**
+	 * Whether the fading value should be looked up in a distance volume of the current room instead of searching
+	 * for the closest surface every frame. The volume is built once whenever the room changes and the lookup doesn't
+	 * depend on the number of anchors in the room. The distance is off by at most half the diagonal of a voxel.
+	 */
+	UPROPERTY(EditAnywhere, Category = "MR Utility Kit", meta = (EditCondition = "EnableFade"))
+	bool UseDistanceVolume = false;
+
+	/**
+	 * Size of the voxels of the distance volume in meters.
+	 */
+	UPROPERTY(EditAnywhere, Category = "MR Utility Kit", meta = (EditCondition = "EnableFade && UseDistanceVolume", ClampMin = "0.01"))
+	double DistanceVolumeVoxelSize = 0.1;
+
 	/**
 	 * Spawn the guardian. This will get called automatically after the mixed reality utility kit has
 	 * been initialized if SpawnMode is set to something other than None.
@@ -87,9 +102,20 @@ protected:
 #endif
 
 private:
+	friend class FMRUKGuardianSpawnerSpec;
+
 	// Room UUID to spawned actors in this room
 	TMap<AMRUKRoom*, TArray<AMRUKGuardian*>> SpawnedGuardians;
 
+	// Distance volume of the room the fade has been computed for last
+	FMRUKSurfaceDistanceVolume DistanceVolume;
+	TWeakObjectPtr<AMRUKRoom> DistanceVolumeRoom;
+
+	/**
+	 * Compute the fading value for the given headset position in the given room.
+	 */
+	double ComputeGuardianFade(AMRUKRoom* Room, const FVector& HeadsetPosition);
+
 	UPROPERTY()
 	TObjectPtr<UMaterialInstanceDynamic> DynamicGuardianMaterial = nullptr;
 
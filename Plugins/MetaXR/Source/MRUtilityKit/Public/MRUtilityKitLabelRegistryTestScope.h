@@ -0,0 +1,24 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+/**
+ * Restores the label registry when it goes out of scope. Labels that got interned during the lifetime of the
+ * scope are forgotten again, so tests can intern arbitrary labels without affecting the rest of the process.
+ * Only meant for automation tests.
+ */
+struct MRUTILITYKIT_API FMRUKLabelRegistryTestScope
+{
+	FMRUKLabelRegistryTestScope();
+	~FMRUKLabelRegistryTestScope();
+
+	FMRUKLabelRegistryTestScope(const FMRUKLabelRegistryTestScope&) = delete;
+	FMRUKLabelRegistryTestScope& operator=(const FMRUKLabelRegistryTestScope&) = delete;
+
+private:
+	int32 NumBits = 0;
+};
+#endif // WITH_DEV_AUTOMATION_TESTS
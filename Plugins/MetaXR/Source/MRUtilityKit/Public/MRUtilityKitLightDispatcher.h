@@ -62,6 +62,24 @@ public:
 	UFUNCTION(CallInEditor, Category = "MR Utility Kit")
 	void ForceUpdateCollection();
 
+	/**
+	 * Number of times FillParameterCollection() changed the parameter collection and updated its render state.
+	 */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "MR Utility Kit")
+	int32 AppliedCollectionUpdates = 0;
+
+	/**
+	 * Number of times FillParameterCollection() left the parameter collection untouched because no light changed.
+	 */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "MR Utility Kit")
+	int32 SkippedCollectionUpdates = 0;
+
+	/**
+	 * Number of parameters of the parameter collection that have been written.
+	 */
+	UPROPERTY(BlueprintReadOnly, Transient, Category = "MR Utility Kit")
+	int32 ParameterWrites = 0;
+
 public:
 	AMRUKLightDispatcher();
 
@@ -77,4 +95,26 @@ protected:
 
 	void FillPointLights();
 	void AddPointLightsFromActor(const AActor* Actor);
+
+private:
+	struct FLightParameters
+	{
+		FName PositionName;
+		FName DataName;
+		FName ColorName;
+
+		// Values that have been written to the collection
+		FLinearColor Position;
+		FLinearColor Data;
+		FLinearColor Color;
+		bool bWritten = false;
+	};
+
+	void InvalidateParameterCache();
+
+	// One entry per light that fits into the collection
+	TArray<FLightParameters> LightParameters;
+	UPROPERTY(Transient)
+	class UMaterialParameterCollection* CachedCollection = nullptr;
+	int32 WrittenLightCount = INDEX_NONE;
 };
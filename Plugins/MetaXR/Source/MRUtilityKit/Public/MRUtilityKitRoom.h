@@ -5,10 +5,14 @@
 #include "GameFramework/Actor.h"
 #include "Dom/JsonObject.h"
 #include "MRUtilityKit.h"
+#include "MRUtilityKitAliasTable.h"
+#include "MRUtilityKitAnchorHierarchy.h"
+#include "MRUtilityKitBVH.h"
 #include "OculusXRAnchorTypes.h"
 #include "MRUtilityKitRoom.generated.h"
 
 class UMRUKRoomData;
+struct FMRUKSnapshotRoom;
 
 UENUM(BlueprintType)
 enum class EMRUKSpawnLocation : uint8
@@ -224,6 +228,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	bool GenerateRandomPositionOnSurface(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge, FMRUKLabelFilter LabelFilter, FVector& OutPosition, FVector& OutNormal);
 
+	/**
+	 * Same as GenerateRandomPositionOnSurface() but draws from the given random stream. The same seed yields the same
+	 * positions as long as the anchors of the room don't change.
+	 *
+	 * @param SpawnLocation			The location where the random position should be generated.
+	 * @param MinDistanceToEdge		The minimum distance from the edge that the generated position must have.
+	 * @param LabelFilter			A filter that specifies which types of surfaces should be considered for generating the random position.
+	 * @param RandomStream			A random generator used to generate the position.
+	 * @param OutPosition			The generated position.
+	 * @param OutNormal				The normal vector of the generated position.
+	 * @return						A boolean value indicating whether a valid position was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool GenerateRandomPositionOnSurfaceFromStream(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge, FMRUKLabelFilter LabelFilter, const FRandomStream& RandomStream, FVector& OutPosition, FVector& OutNormal);
+
 	/**
 	 * Cast a ray and return the closest hit anchor
 	 * @param Origin      Origin The origin of the ray.
@@ -415,6 +434,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	bool LoadGlobalMeshFromJsonString(const FString& JsonString, UMaterialInterface* Material = nullptr);
 
+	/**
+	 * Load the triangle mesh of the global mesh anchor from a binary scene snapshot.
+	 * @param Snapshot The binary scene snapshot, e.g. from UMRUKSubsystem::SaveSceneToSnapshot().
+	 * @param Material Material to apply on the global mesh.
+	 * @return         On Success true, otherwise false.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	bool LoadGlobalMeshFromSnapshot(const TArray<uint8>& Snapshot, UMaterialInterface* Material = nullptr);
+
 	/**
 	 * Compute the centroid of the room by taking the points of the floor boundary.
 	 * The centroid may be outside of the room for non convex rooms.
@@ -441,11 +469,14 @@ public:
 	void UpdateWorldLock(APawn* Pawn, const FVector& HeadWorldPosition) const;
 
 	TSharedRef<FJsonObject> JsonSerialize();
+	FMRUKSnapshotRoom SnapshotSerialize();
 
 	bool Corresponds(UMRUKRoomData* RoomQuery) const;
 
 private:
 	friend class FMRUKSpec;
+	friend class AMRUKAnchor;
+	friend class FMRUKSurfaceDistanceVolume;
 
 	AMRUKAnchor* SpawnAnchor();
 
@@ -458,6 +489,12 @@ private:
 	UFUNCTION(CallInEditor)
 	void AddAnchorToRoom(AMRUKAnchor* Anchor);
 
+	/**
+	 * Insert the anchor into the bounding volume hierarchy or refit it after its plane, volume or transform changed.
+	 */
+	void UpdateAnchorInBVH(AMRUKAnchor* Anchor);
+	FBox ComputeAnchorBoundsInRoomSpace(const AMRUKAnchor* Anchor) const;
+
 	class UProceduralMeshComponent* GetOrCreateGlobalMeshProceduralMeshComponent(bool& OutExistedAlready) const;
 	void SetupGlobalMeshProceduralMeshComponent(UProceduralMeshComponent& ProcMeshComponent, bool ExistedAlready, UMaterialInterface* Material) const;
 
@@ -471,6 +508,18 @@ private:
 	UPROPERTY()
 	AMRUKAnchor* KeyWallAnchor = nullptr;
 
+	/**
+	 * Acceleration structure for raycasts and closest surface queries. Holds all anchors with a plane or a volume
+	 * except for the global mesh anchor which is queried through physics.
+	 */
+	FMRUKAnchorBVH AnchorBVH;
+
+	/**
+	 * Parent/child relationships of the anchors. Kept between updates so that only anchors that changed need to be
+	 * evaluated again.
+	 */
+	FMRUKAnchorHierarchy AnchorHierarchy;
+
 	struct Surface
 	{
 		AMRUKAnchor* Anchor;
@@ -479,4 +528,28 @@ private:
 		FBox2D Bounds;
 		EMRUKBoxSide Side;
 	};
+
+	/**
+	 * Surfaces that pass a specific set of arguments of GenerateRandomPositionOnSurfaceFromStream() together with a
+	 * table to pick them by area in constant time.
+	 */
+	struct FSurfaceSampler
+	{
+		EMRUKSpawnLocation SpawnLocation;
+		float MinDistanceToEdge;
+		FMRUKLabelMask IncludedMask;
+		FMRUKLabelMask ExcludedMask;
+		bool bHasIncludedLabels;
+		TArray<Surface> Surfaces;
+		FMRUKAliasTable SurfaceTable;
+	};
+
+	/**
+	 * Samplers of the most recently used argument combinations. Cleared whenever the anchors change.
+	 */
+	TArray<FSurfaceSampler> SurfaceSamplers;
+
+	const FSurfaceSampler& GetOrCreateSurfaceSampler(EMRUKSpawnLocation SpawnLocation, float MinDistanceToEdge, const FMRUKCompiledLabelFilter& LabelFilter, FSurfaceSampler& TemporarySampler);
+	void BuildSurfaceSampler(FSurfaceSampler& Sampler, const FMRUKCompiledLabelFilter& LabelFilter);
+	void InvalidateSamplers();
 };
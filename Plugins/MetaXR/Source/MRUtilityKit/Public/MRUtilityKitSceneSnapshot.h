@@ -0,0 +1,149 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Math/Box.h"
+#include "Math/Box2D.h"
+#include "Misc/Optional.h"
+#include "OculusXRAnchorTypes.h"
+
+/**
+ * Binary scene snapshots are an alternative to the JSON scene format. They contain exactly the same
+ * information as the JSON format and can be converted from and to it without loss.
+ *
+ * All values are stored little endian. Arrays of numbers are aligned to 8 bytes relative to the start
+ * of the snapshot so that the global mesh can be read directly from the snapshot buffer, e.g. from a
+ * memory mapped file, without parsing or copying it.
+ *
+ * Layout of version 1:
+ *   Header:   char[4] "MRUK", uint32 Version, uint32 Flags (0), uint32 NumRooms
+ *   Room:     UUID, FloorUuid, CeilingUuid, uint32 NumWalls, UUID[NumWalls], uint32 NumAnchors, Anchor[NumAnchors]
+ *   Anchor:   UUID, uint32 NumLabels, (uint32 Length, UTF-8 bytes)[NumLabels], uint32 AnchorFlags,
+ *             padding, double Translation[3], double Rotation[3] (pitch, yaw, roll), double Scale[3],
+ *             double PlaneBounds[4] (if flag 1), uint32 NumBoundary + padding + double[2 * NumBoundary] (if flag 2),
+ *             double VolumeBounds[6] (if flag 4), GlobalMesh (if flag 8)
+ *   GlobalMesh: UUID, uint32 NumPositions, uint32 NumIndices, padding, double[3 * NumPositions], int32[NumIndices]
+ * UUIDs are stored as their 16 raw bytes.
+ */
+
+/**
+ * Triangle mesh of a global mesh anchor in a scene snapshot.
+ */
+struct MRUTILITYKIT_API FMRUKSnapshotGlobalMesh
+{
+	FOculusXRUUID UUID;
+
+	/**
+	 * Vertex positions. Points into the snapshot buffer if possible, in that case the buffer needs to stay alive
+	 * as long as the positions are used.
+	 */
+	TConstArrayView<FVector> GetPositions() const { return OwnedPositions.IsEmpty() ? MappedPositions : TConstArrayView<FVector>(OwnedPositions); }
+
+	/**
+	 * Triangle indices. Points into the snapshot buffer if possible, in that case the buffer needs to stay alive
+	 * as long as the indices are used.
+	 */
+	TConstArrayView<int32> GetIndices() const { return OwnedIndices.IsEmpty() ? MappedIndices : TConstArrayView<int32>(OwnedIndices); }
+
+	/**
+	 * Take ownership of the positions and indices.
+	 */
+	void SetMeshData(TArray<FVector>&& Positions, TArray<int32>&& Indices);
+
+	/**
+	 * Reference positions and indices that are owned by someone else, e.g. the snapshot buffer.
+	 */
+	void SetMappedMeshData(TConstArrayView<FVector> Positions, TConstArrayView<int32> Indices);
+
+private:
+	TConstArrayView<FVector> MappedPositions;
+	TConstArrayView<int32> MappedIndices;
+	TArray<FVector> OwnedPositions;
+	TArray<int32> OwnedIndices;
+};
+
+/**
+ * Anchor as it is stored in the JSON and binary scene formats.
+ */
+struct MRUTILITYKIT_API FMRUKSnapshotAnchor
+{
+	FOculusXRUUID UUID;
+	TArray<FString> SemanticClassifications;
+	FVector Translation = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FVector Scale = FVector::OneVector;
+	FBox2D PlaneBounds{ ForceInit };
+	TArray<FVector2D> PlaneBoundary2D;
+	FBox VolumeBounds{ ForceInit };
+	TOptional<FMRUKSnapshotGlobalMesh> GlobalMesh;
+};
+
+/**
+ * Room as it is stored in the JSON and binary scene formats.
+ */
+struct MRUTILITYKIT_API FMRUKSnapshotRoom
+{
+	FOculusXRUUID UUID;
+	FOculusXRUUID FloorUuid;
+	FOculusXRUUID CeilingUuid;
+	TArray<FOculusXRUUID> WallsUuid;
+	TArray<FMRUKSnapshotAnchor> Anchors;
+};
+
+/**
+ * Scene as it is stored in the JSON and binary scene formats.
+ */
+struct MRUTILITYKIT_API FMRUKSceneSnapshot
+{
+	static constexpr uint32 CurrentVersion = 1;
+
+	TArray<FMRUKSnapshotRoom> Rooms;
+};
+
+/**
+ * Write the scene into the binary snapshot format.
+ * @param Scene       The scene to write.
+ * @param OutSnapshot The binary snapshot.
+ */
+MRUTILITYKIT_API void MRUKWriteSceneSnapshot(const FMRUKSceneSnapshot& Scene, TArray<uint8>& OutSnapshot);
+
+/**
+ * Read a binary snapshot. The global mesh references the snapshot memory directly if it is suitably aligned.
+ * @param Snapshot The binary snapshot.
+ * @param OutScene The scene that has been read.
+ * @return Whether the snapshot could be read. On failure the reason is logged.
+ */
+MRUTILITYKIT_API bool MRUKReadSceneSnapshot(TConstArrayView<uint8> Snapshot, FMRUKSceneSnapshot& OutScene);
+
+/**
+ * Read a scene from the JSON format.
+ * @param Json     The JSON string.
+ * @param OutScene The scene that has been read.
+ * @return Whether the JSON could be read.
+ */
+MRUTILITYKIT_API bool MRUKReadSceneJson(const FString& Json, FMRUKSceneSnapshot& OutScene);
+
+/**
+ * Write a scene into the JSON format. The result is the same as UMRUKSubsystem::SaveSceneToJsonString() would produce for this scene.
+ * @param Scene The scene to write.
+ * @return The JSON string.
+ */
+MRUTILITYKIT_API FString MRUKWriteSceneJson(const FMRUKSceneSnapshot& Scene);
+
+/**
+ * Convert a scene in the JSON format into a binary snapshot.
+ * @param Json        The JSON string.
+ * @param OutSnapshot The binary snapshot.
+ * @return Whether the conversion succeeded.
+ */
+MRUTILITYKIT_API bool MRUKConvertSceneJsonToSnapshot(const FString& Json, TArray<uint8>& OutSnapshot);
+
+/**
+ * Convert a binary snapshot into the JSON format.
+ * @param Snapshot The binary snapshot.
+ * @param OutJson  The JSON string.
+ * @return Whether the conversion succeeded.
+ */
+MRUTILITYKIT_API bool MRUKConvertSceneSnapshotToJson(TConstArrayView<uint8> Snapshot, FString& OutJson);
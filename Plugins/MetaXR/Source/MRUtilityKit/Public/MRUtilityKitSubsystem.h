@@ -8,6 +8,7 @@
 #include "MRUtilityKitRoom.h"
 #include "MRUtilityKit.h"
 #include "MRUtilityKitData.h"
+#include "MRUtilityKitSceneSnapshot.h"
 #include "OculusXRSceneTypes.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "Tickable.h"
@@ -150,6 +151,30 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
 	void LoadSceneFromJsonString(const FString& String);
 
+	/**
+	 * Save all rooms and anchors to a binary scene snapshot. The snapshot contains the same data as
+	 * the JSON representation but is a lot faster to load. It can later be used by LoadSceneFromSnapshot()
+	 * to load the scene again.
+	 * @return the binary snapshot.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	TArray<uint8> SaveSceneToSnapshot();
+
+	/**
+	 * Load rooms and anchors from a binary scene snapshot.
+	 * If the scene is already loaded the scene will be updated with the changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "MR Utility Kit")
+	void LoadSceneFromSnapshot(const TArray<uint8>& Snapshot);
+
+	/**
+	 * Load rooms and anchors from a binary scene snapshot file. The file gets memory mapped if the platform supports it.
+	 * If the scene is already loaded the scene will be updated with the changes.
+	 * @param Path Path to the snapshot file.
+	 * @return Whether the file could be read. Completion of the scene load is reported through OnSceneLoaded.
+	 */
+	bool LoadSceneFromSnapshotFile(const FString& Path);
+
 	/**
 	 * Load rooms and anchors from the device.
 	 * If the scene is already loaded the scene will be updated with the changes.
@@ -267,6 +292,7 @@ public:
 	void Deinitialize() override;
 
 	TSharedRef<FJsonObject> JsonSerialize();
+	FMRUKSceneSnapshot SnapshotSerialize();
 	void UnregisterRoom(AMRUKRoom* Room);
 	// Calculate the bounds of an Actor class and return it, the result is saved in a cache for faster lookup.
 	FBox GetActorClassBounds(TSubclassOf<AActor> Actor);
@@ -275,6 +301,8 @@ public:
 private:
 	AMRUKRoom* SpawnRoom();
 
+	void LoadSceneFromSnapshotView(TConstArrayView<uint8> Snapshot);
+
 	void FinishedLoading(bool Success);
 
 	// FTickableGameObject interface
@@ -0,0 +1,83 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "Containers/Array.h"
+#include "Math/Transform.h"
+#include "MRUtilityKit.h"
+
+class AMRUKRoom;
+
+/**
+ * Distance to the closest anchor surface of a room, sampled on a regular 3D grid in room space and computed on the CPU.
+ * The samples are exact results of AMRUKRoom::TryGetClosestSurfacePosition() and lookups interpolate them
+ * trilinearly, which turns a query that walks the anchors of the room into a constant time lookup. Since the distance
+ * to the closest surface changes by at most the distance travelled, the interpolated distance differs from the exact
+ * one by at most GetMaxError().
+ * Distances are clamped to the maximum distance the volume has been built with. The volume only follows the
+ * transform the room had during Build(), it has to be built again once the anchors of the room changed.
+ */
+class MRUTILITYKIT_API FMRUKSurfaceDistanceVolume
+{
+public:
+	/**
+	 * Build the volume for the given room.
+	 * @param Room         The room whose anchors should be sampled.
+	 * @param LabelFilter  Only anchors that pass this filter are taken into account.
+	 * @param InVoxelSize  Distance between two samples in world units.
+	 * @param InMaxDistance Distances are only exact up to this distance in world units. Everything further away is
+	 * reported at this distance.
+	 */
+	void Build(AMRUKRoom* Room, const FMRUKLabelFilter& LabelFilter, double InVoxelSize, double InMaxDistance);
+
+	/**
+	 * Free all memory held by the volume.
+	 */
+	void Reset();
+
+	/**
+	 * Whether the volume has been built.
+	 */
+	bool IsValid() const { return !Distances.IsEmpty(); }
+
+	/**
+	 * Sample the distance to the closest surface at the given world position with trilinear filtering.
+	 * @param WorldPosition The position in world space.
+	 * @return The distance in world units, clamped to the maximum distance. The maximum distance outside of the volume
+	 * and if the volume hasn't been built.
+	 */
+	float SampleDistance(const FVector& WorldPosition) const;
+
+	/**
+	 * Upper bound of the difference between a sampled distance and the exact distance in world units.
+	 */
+	double GetMaxError() const { return VoxelSize * UE_HALF_SQRT_3; }
+
+	/**
+	 * Distance between two samples in world units.
+	 */
+	double GetVoxelSize() const { return VoxelSize; }
+
+	/**
+	 * Distance in world units the volume has been built with.
+	 */
+	double GetMaxDistance() const { return MaxDistance; }
+
+	/**
+	 * Number of samples along each axis.
+	 */
+	FIntVector GetResolution() const { return Resolution; }
+
+	/**
+	 * Transform of the room at the time the volume has been built.
+	 */
+	const FTransform& GetRoomTransform() const { return RoomTransform; }
+
+private:
+	TArray<float> Distances;
+	FTransform RoomTransform;
+	FVector Origin = FVector::ZeroVector;
+	FIntVector Resolution = FIntVector::ZeroValue;
+	double VoxelSize = 0.0;
+	double MaxDistance = 0.0;
+};
@@ -4,6 +4,7 @@
 #include "MRUtilityKitSubsystem.h"
 #include "MRUtilityKitAnchor.h"
 #include "MRUtilityKitAnchorActorSpawner.h"
+#include "MRUtilityKitLabelRegistryTestScope.h"
 #include "Misc/AutomationTest.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "Editor/UnrealEdEngine.h"
@@ -83,6 +84,98 @@ bool FMRUKSpec::TestEqual(const TCHAR* What, const FVector2D Actual, const FVect
 	return true;
 }
 
+namespace
+{
+	struct FReferenceAnchorHierarchy
+	{
+		TMap<AMRUKAnchor*, AMRUKAnchor*> Parents;
+		TMap<AMRUKAnchor*, TArray<AMRUKAnchor*>> Children;
+	};
+
+	// Straightforward version of the anchor hierarchy that tests every pair of anchors
+	FReferenceAnchorHierarchy ComputeReferenceAnchorHierarchy(const AMRUKRoom* Room)
+	{
+		constexpr float OffsetTolerance = 4.0f;
+		FReferenceAnchorHierarchy Result;
+		const auto Link = [&Result](AMRUKAnchor* Parent, AMRUKAnchor* Child) {
+			Result.Parents.Add(Child, Parent);
+			Result.Children.FindOrAdd(Parent).Push(Child);
+		};
+		const auto IsUprightVolume = [](const AMRUKAnchor* Anchor) {
+			return Anchor->VolumeBounds.IsValid && FVector::Coincident(Anchor->GetTransform().GetUnitAxis(EAxis::X), FVector::DownVector);
+		};
+
+		for (AMRUKAnchor* WallAnchor : Room->WallAnchors)
+		{
+			const FTransform& WallTransform = WallAnchor->GetTransform();
+			for (AMRUKAnchor* ChildAnchor : Room->AllAnchors)
+			{
+				if (ChildAnchor == WallAnchor || !FVector::Coincident(WallTransform.GetUnitAxis(EAxis::X), ChildAnchor->GetTransform().GetUnitAxis(EAxis::X)))
+				{
+					continue;
+				}
+				const FVector LocalPos = WallTransform.InverseTransformPosition(ChildAnchor->GetActorLocation());
+				if (FMath::Abs(LocalPos.X) <= OffsetTolerance && WallAnchor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z)))
+				{
+					Link(WallAnchor, ChildAnchor);
+				}
+			}
+		}
+
+		if (AMRUKAnchor* FloorAnchor = Room->FloorAnchor)
+		{
+			const FTransform& FloorTransform = FloorAnchor->GetTransform();
+			for (AMRUKAnchor* ChildAnchor : Room->AllAnchors)
+			{
+				if (ChildAnchor == FloorAnchor || !IsUprightVolume(ChildAnchor))
+				{
+					continue;
+				}
+				const double ChildBottom = ChildAnchor->GetActorLocation().Z - ChildAnchor->VolumeBounds.Max.X;
+				const FVector LocalPos = FloorTransform.InverseTransformPosition(ChildAnchor->GetActorLocation());
+				if (FMath::Abs(FloorTransform.GetLocation().Z - ChildBottom) <= OffsetTolerance && FloorAnchor->IsPositionInBoundary(FVector2D(LocalPos.Y, LocalPos.Z)))
+				{
+					Link(FloorAnchor, ChildAnchor);
+				}
+			}
+		}
+
+		for (AMRUKAnchor* ParentAnchor : Room->AllAnchors)
+		{
+			if (!IsUprightVolume(ParentAnchor))
+			{
+				continue;
+			}
+			const FTransform& ParentTransform = ParentAnchor->GetTransform();
+			const FBox& ParentVolumeBounds = ParentAnchor->VolumeBounds;
+			const double ParentTop = ParentTransform.GetLocation().Z - ParentVolumeBounds.Min.X;
+			for (AMRUKAnchor* ChildAnchor : Room->AllAnchors)
+			{
+				if (ChildAnchor == ParentAnchor || !IsUprightVolume(ChildAnchor))
+				{
+					continue;
+				}
+				const FBox& ChildVolumeBounds = ChildAnchor->VolumeBounds;
+				if (FMath::Abs(ParentTop - (ChildAnchor->GetActorLocation().Z - ChildVolumeBounds.Max.X)) > OffsetTolerance)
+				{
+					continue;
+				}
+				for (int i = 0; i < 4; ++i)
+				{
+					const FVector ChildLocalPos(0.0f, i < 2 ? ChildVolumeBounds.Min.Y : ChildVolumeBounds.Max.Y, i % 2 == 0 ? ChildVolumeBounds.Min.Z : ChildVolumeBounds.Max.Z);
+					const FVector LocalPos = ParentTransform.InverseTransformPosition(ChildAnchor->GetTransform().TransformPosition(ChildLocalPos));
+					if (LocalPos.Y >= ParentVolumeBounds.Min.Y && LocalPos.Y <= ParentVolumeBounds.Max.Y && LocalPos.Z >= ParentVolumeBounds.Min.Z && LocalPos.Z <= ParentVolumeBounds.Max.Z)
+					{
+						Link(ParentAnchor, ChildAnchor);
+						break;
+					}
+				}
+			}
+		}
+		return Result;
+	}
+} // namespace
+
 void FMRUKSpec::Define()
 {
 	Describe(TEXT("Interior spawner"), [this] {
@@ -416,6 +509,16 @@ void FMRUKSpec::Define()
 
 			TArray<FString> EmptyLabels;
 			TestTrue(TEXT("Room contains empty labels"), Room->DoesRoomHave(EmptyLabels));
+
+			TArray<FString> RepeatedLabels = { FMRUKLabels::WallFace, FMRUKLabels::WallFace };
+			TestTrue(TEXT("Room contains several walls"), Room->DoesRoomHave(RepeatedLabels));
+
+			TArray<FString> RepeatedFloorLabels = { FMRUKLabels::Floor, FMRUKLabels::Floor };
+			TestFalse(TEXT("Room contains only one floor"), Room->DoesRoomHave(RepeatedFloorLabels));
+
+			TArray<FString> UnknownLabels = { FMRUKLabels::Floor, TEXT("MRUK_TEST_LABEL_NOT_IN_ROOM") };
+			TestFalse(TEXT("Room doesn't contain an unknown label"), Room->DoesRoomHave(UnknownLabels));
+			TestTrue(TEXT("Unknown label is not interned"), FMRUKLabelMask::FindLabel(TEXT("MRUK_TEST_LABEL_NOT_IN_ROOM")).IsEmpty());
 		});
 
 		It(TEXT("Get forward facing direction"), [this]() {
@@ -832,6 +935,83 @@ void FMRUKSpec::Define()
 			TestFalse(TEXT("No valid positions"), Room->GenerateRandomPositionInRoomFromStream(Position, RandomStream, LargeMinDistance));
 		});
 
+		It(TEXT("Random positions are deterministic"), [this]() {
+			auto Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room"), Room))
+			{
+				return;
+			}
+			const FRandomStream StreamA(42);
+			const FRandomStream StreamB(42);
+			for (int i = 0; i < 100; ++i)
+			{
+				FVector PositionA, PositionB;
+				TestTrue(TEXT("Generated position A"), Room->GenerateRandomPositionInRoomFromStream(PositionA, StreamA, 10.0f, true));
+				TestTrue(TEXT("Generated position B"), Room->GenerateRandomPositionInRoomFromStream(PositionB, StreamB, 10.0f, true));
+				TestEqual(TEXT("Same position in room"), PositionA, PositionB);
+			}
+
+			const EMRUKSpawnLocation SpawnLocations[] = { EMRUKSpawnLocation::AnySurface, EMRUKSpawnLocation::OnTopOfSurface, EMRUKSpawnLocation::VerticalSurfaces, EMRUKSpawnLocation::HangingDown };
+			for (const EMRUKSpawnLocation SpawnLocation : SpawnLocations)
+			{
+				for (int i = 0; i < 100; ++i)
+				{
+					FVector PositionA, NormalA, PositionB, NormalB;
+					const bool bSuccessA = Room->GenerateRandomPositionOnSurfaceFromStream(SpawnLocation, 5.0f, {}, StreamA, PositionA, NormalA);
+					const bool bSuccessB = Room->GenerateRandomPositionOnSurfaceFromStream(SpawnLocation, 5.0f, {}, StreamB, PositionB, NormalB);
+					TestEqual(TEXT("Same result"), bSuccessA, bSuccessB);
+					TestEqual(TEXT("Same position on surface"), PositionA, PositionB);
+					TestEqual(TEXT("Same normal"), NormalA, NormalB);
+				}
+			}
+
+			// Positions on surfaces lie on the surface of an anchor that passes the filter
+			FMRUKLabelFilter LabelFilter;
+			LabelFilter.IncludedLabels = { FMRUKLabels::Table };
+			for (int i = 0; i < 100; ++i)
+			{
+				FVector Position, Normal;
+				if (TestTrue(TEXT("Generated position on table"), Room->GenerateRandomPositionOnSurfaceFromStream(EMRUKSpawnLocation::OnTopOfSurface, 0.0f, LabelFilter, StreamA, Position, Normal)))
+				{
+					FVector SurfacePosition;
+					double SurfaceDistance = 0.0;
+					TestNotNull(TEXT("Position is on a table"), Room->TryGetClosestSurfacePosition(Position, SurfacePosition, SurfaceDistance, LabelFilter, 0.1));
+					TestTrue(TEXT("Normal points up"), Normal.Z > 0.99);
+				}
+			}
+		});
+
+		It(TEXT("Random position throughput"), [this]() {
+			auto Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room"), Room))
+			{
+				return;
+			}
+			constexpr int32 NumSamples = 100000;
+			const FRandomStream RandomStream(7);
+			FVector Position, Normal;
+			FVector Sum = FVector::ZeroVector;
+
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 I = 0; I < NumSamples; ++I)
+			{
+				Room->GenerateRandomPositionInRoomFromStream(Position, RandomStream);
+				Sum += Position;
+			}
+			const double RoomSeconds = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (int32 I = 0; I < NumSamples; ++I)
+			{
+				Room->GenerateRandomPositionOnSurfaceFromStream(EMRUKSpawnLocation::AnySurface, 0.0f, {}, RandomStream, Position, Normal);
+				Sum += Position;
+			}
+			const double SurfaceSeconds = FPlatformTime::Seconds() - StartTime;
+
+			AddInfo(FString::Printf(TEXT("%d samples: in room %.1f ns/sample, on surface %.1f ns/sample (checksum %f)"),
+				NumSamples, RoomSeconds * 1e9 / NumSamples, SurfaceSeconds * 1e9 / NumSamples, Sum.Size()));
+		});
+
 		It(TEXT("Ray cast"), [this]() {
 			auto Room = ToolkitSubsystem->GetCurrentRoom();
 			if (!TestNotNull(TEXT("Current room"), Room))
@@ -1035,6 +1215,102 @@ void FMRUKSpec::Define()
 		TeardownMRUKSubsystem();
 	});
 
+	Describe(TEXT("Anchor hierarchy"), [this] {
+		SetupMRUKSubsystem();
+
+		It(TEXT("Incremental updates match the full computation"), [this]() {
+			constexpr int32 NumAnchors = 300;
+			ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(NumAnchors, 11));
+			auto Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Current room"), Room) || !TestEqual(TEXT("Number of anchors"), Room->AllAnchors.Num(), NumAnchors))
+			{
+				return;
+			}
+
+			const auto CompareWithReference = [this, Room](const TCHAR* What) {
+				const FReferenceAnchorHierarchy Reference = ComputeReferenceAnchorHierarchy(Room);
+				int32 NumMismatches = 0;
+				for (AMRUKAnchor* Anchor : Room->AllAnchors)
+				{
+					const TArray<AMRUKAnchor*>* ExpectedChildren = Reference.Children.Find(Anchor);
+					const TArray<TObjectPtr<AMRUKAnchor>> Expected = ExpectedChildren ? TArray<TObjectPtr<AMRUKAnchor>>(*ExpectedChildren) : TArray<TObjectPtr<AMRUKAnchor>>();
+					if (Anchor->ParentAnchor != Reference.Parents.FindRef(Anchor) || Anchor->ChildAnchors != Expected)
+					{
+						++NumMismatches;
+					}
+				}
+				TestEqual(FString::Printf(TEXT("Anchors with a different parent or children (%s)"), What), NumMismatches, 0);
+			};
+			CompareWithReference(TEXT("initial load"));
+
+			// Move furniture around: stack it on other furniture, attach it to walls or drop it somewhere on the floor
+			TArray<AMRUKAnchor*> Furniture;
+			for (AMRUKAnchor* Anchor : Room->AllAnchors)
+			{
+				if (Anchor->VolumeBounds.IsValid)
+				{
+					Furniture.Push(Anchor);
+				}
+			}
+			FRandomStream RandomStream(3);
+			double IncrementalSeconds = 0.0;
+			double ReferenceSeconds = 0.0;
+			for (int32 Iteration = 0; Iteration < 50; ++Iteration)
+			{
+				const int32 NumMoves = RandomStream.RandRange(1, 5);
+				for (int32 Move = 0; Move < NumMoves; ++Move)
+				{
+					AMRUKAnchor* Anchor = Furniture[RandomStream.RandHelper(Furniture.Num())];
+					const int32 Kind = RandomStream.RandHelper(3);
+					if (Kind == 0)
+					{
+						AMRUKAnchor* Parent = Furniture[RandomStream.RandHelper(Furniture.Num())];
+						if (Parent == Anchor)
+						{
+							continue;
+						}
+						const double ParentTop = Parent->GetActorLocation().Z - Parent->VolumeBounds.Min.X;
+						const FVector Offset(RandomStream.FRandRange(-20.0, 20.0), RandomStream.FRandRange(-20.0, 20.0), ParentTop + Anchor->VolumeBounds.Max.X - Parent->GetActorLocation().Z);
+						Anchor->SetActorLocationAndRotation(Parent->GetActorLocation() + Offset, FRotator(-90.0, 0.0, RandomStream.FRandRange(-180.0, 180.0)));
+					}
+					else if (Kind == 1)
+					{
+						const AMRUKAnchor* Wall = Room->WallAnchors[RandomStream.RandHelper(Room->WallAnchors.Num())];
+						const FVector LocalPos(RandomStream.FRandRange(-2.0, 2.0), RandomStream.FRandRange(-200.0, 200.0), RandomStream.FRandRange(-100.0, 100.0));
+						Anchor->SetActorLocationAndRotation(Wall->GetActorTransform().TransformPosition(LocalPos), Wall->GetActorRotation());
+					}
+					else
+					{
+						const FVector Location(RandomStream.FRandRange(-150.0, 150.0), RandomStream.FRandRange(-150.0, 150.0), Room->FloorAnchor->GetActorLocation().Z + Anchor->VolumeBounds.Max.X);
+						Anchor->SetActorLocationAndRotation(Location, FRotator(-90.0, 0.0, RandomStream.FRandRange(-180.0, 180.0)));
+					}
+				}
+
+				double StartTime = FPlatformTime::Seconds();
+				Room->ComputeAnchorHierarchy();
+				IncrementalSeconds += FPlatformTime::Seconds() - StartTime;
+
+				StartTime = FPlatformTime::Seconds();
+				ComputeReferenceAnchorHierarchy(Room);
+				ReferenceSeconds += FPlatformTime::Seconds() - StartTime;
+
+				CompareWithReference(TEXT("after moving furniture"));
+			}
+			AddInfo(FString::Printf(TEXT("%d anchors, 50 updates: incremental %.3f ms, all pairs %.3f ms"), NumAnchors, IncrementalSeconds * 1000.0, ReferenceSeconds * 1000.0));
+
+			// Update the room through the regular path, this changes the walls and removes anchors
+			ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(NumAnchors - 50, 11));
+			if (TestEqual(TEXT("Same room"), ToolkitSubsystem->GetCurrentRoom(), Room))
+			{
+				TestEqual(TEXT("Number of anchors"), Room->AllAnchors.Num(), NumAnchors - 50);
+				TestEqual(TEXT("Anchors in hierarchy"), Room->AnchorHierarchy.Num(), NumAnchors - 50);
+				CompareWithReference(TEXT("after updating the room"));
+			}
+		});
+
+		TeardownMRUKSubsystem();
+	});
+
 	Describe(TEXT("Toolkit"), [this] {
 		SetupMRUKSubsystem();
 		LoadSceneFromJson();
@@ -1284,5 +1560,115 @@ void FMRUKSpec::Define()
 			Filter.IncludedLabels.Empty();
 			TestTrue(TEXT("BAM Passes Filter"), Filter.PassesFilter({ { TEXT("BAM") } }));
 		});
+
+		It(TEXT("Alias Table"), [this]() {
+			FMRUKAliasTable Table;
+			TestTrue(TEXT("Empty by default"), Table.IsEmpty());
+			Table.Build(TArray<float>{ 0.0f, 0.0f });
+			TestTrue(TEXT("Empty with zero weights"), Table.IsEmpty());
+			TestEqual(TEXT("Sample from empty table"), Table.Sample(FRandomStream(1)), INDEX_NONE);
+
+			const TArray<float> Weights = { 1.0f, 2.0f, 0.0f, 3.0f, 4.0f, -1.0f };
+			Table.Build(Weights);
+			TestEqual(TEXT("Total weight"), Table.GetTotalWeight(), 10.0);
+
+			constexpr int32 NumSamples = 200000;
+			TArray<int32> Counts;
+			Counts.SetNumZeroed(Weights.Num());
+			const FRandomStream RandomStream(1234);
+			for (int32 I = 0; I < NumSamples; ++I)
+			{
+				++Counts[Table.Sample(RandomStream)];
+			}
+			for (int32 I = 0; I < Weights.Num(); ++I)
+			{
+				const double Expected = FMath::Max(Weights[I], 0.0f) / Table.GetTotalWeight();
+				TestNearlyEqual(FString::Printf(TEXT("Frequency of %d"), I), static_cast<double>(Counts[I]) / NumSamples, Expected, 0.01);
+			}
+			TestEqual(TEXT("Zero weight never sampled"), Counts[2], 0);
+			TestEqual(TEXT("Negative weight never sampled"), Counts[5], 0);
+
+			// Same seed yields the same sequence
+			const FRandomStream StreamA(99);
+			const FRandomStream StreamB(99);
+			for (int32 I = 0; I < 100; ++I)
+			{
+				TestEqual(TEXT("Same index"), Table.Sample(StreamA), Table.Sample(StreamB));
+			}
+		});
+
+		It(TEXT("Compiled Label Filter"), [this]() {
+			TArray<TArray<FString>> Filters = {
+				{},
+				{ FMRUKLabels::Floor },
+				{ FMRUKLabels::Couch, TEXT("FOO") },
+				{ TEXT("bar"), FMRUKLabels::Table },
+			};
+			TArray<TArray<FString>> Labels = {
+				{},
+				{ FMRUKLabels::Floor },
+				{ TEXT("floor") },
+				{ FMRUKLabels::Couch, FMRUKLabels::Table },
+				{ TEXT("FOO") },
+				{ TEXT("BAR"), TEXT("BAM") },
+				{ TEXT("BAM") },
+			};
+
+			const auto TestAllCombinations = [this, &Filters, &Labels](const TCHAR* What) {
+				// The anchors intern their labels when they are created, before any filter gets compiled
+				TArray<FMRUKLabelMask> Masks;
+				for (const auto& AnchorLabels : Labels)
+				{
+					Masks.Add(FMRUKLabelMask::FromLabels(AnchorLabels));
+				}
+
+				for (const auto& Included : Filters)
+				{
+					for (const auto& Excluded : Filters)
+					{
+						FMRUKLabelFilter Filter;
+						Filter.IncludedLabels = Included;
+						Filter.ExcludedLabels = Excluded;
+						const FMRUKCompiledLabelFilter Compiled = Filter.Compile();
+						for (int32 I = 0; I < Labels.Num(); ++I)
+						{
+							const FString Description = FString::Printf(TEXT("%s: [%s] passes include [%s] exclude [%s]"), What,
+								*FString::Join(Labels[I], TEXT(",")), *FString::Join(Included, TEXT(",")), *FString::Join(Excluded, TEXT(",")));
+							TestEqual(*Description, Compiled.PassesFilter(Masks[I], Labels[I]), Filter.PassesFilter(Labels[I]));
+						}
+					}
+				}
+			};
+
+			// Labels interned by the test must not leak into the rest of the process
+			const FMRUKLabelRegistryTestScope RegistryScope;
+
+			// A label no anchor has takes the string path instead of growing the registry
+			Filters.Add({ TEXT("MRUK_TEST_LABEL_UNSEEN"), FMRUKLabels::Bed });
+			TestAllCombinations(TEXT("Interned labels"));
+			TestTrue(TEXT("Compiling doesn't intern labels"), FMRUKLabelMask::FindLabel(TEXT("MRUK_TEST_LABEL_UNSEEN")).IsEmpty());
+			TestTrue(TEXT("Precomputed mask"), FMRUKLabelMask::FromLabel(FMRUKLabels::Couch) == FMRUKLabelMasks::Couch);
+
+			{
+				const FMRUKLabelRegistryTestScope ExhaustedScope;
+
+				// Exhaust the label bits so that further labels have to be compared as strings
+				for (int32 I = 0; I < 64; ++I)
+				{
+					FMRUKLabelMask::FromLabel(FString::Printf(TEXT("MRUK_TEST_LABEL_%d"), I));
+				}
+				const FMRUKLabelMask OverflowMask = FMRUKLabelMask::FromLabel(TEXT("MRUK_TEST_LABEL_OVERFLOW"));
+				TestTrue(TEXT("Label without a free bit overflows"), OverflowMask.HasOverflow());
+				TestFalse(TEXT("Known label does not overflow"), FMRUKLabelMask::FromLabel(FMRUKLabels::WallArt).HasOverflow());
+
+				Filters.Last().Add(TEXT("MRUK_TEST_LABEL_OVERFLOW"));
+				Labels.Last().Add(TEXT("MRUK_TEST_LABEL_OVERFLOW"));
+				Labels.Add({ TEXT("MRUK_TEST_LABEL_OVERFLOW_OTHER") });
+				Labels.Add({ TEXT("MRUK_TEST_LABEL_UNSEEN") });
+				TestAllCombinations(TEXT("Overflowing labels"));
+			}
+
+			TestFalse(TEXT("Bits are free again after the scope"), FMRUKLabelMask::FromLabel(TEXT("MRUK_TEST_LABEL_AFTER_SCOPE")).HasOverflow());
+		});
 	});
 }
@@ -0,0 +1,262 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "TestHelper.h"
+#include "Editor.h"
+
+namespace
+{
+	// Reference implementations that test every anchor in the room like the room queries did before the BVH was introduced
+
+	AMRUKAnchor* LinearRaycast(AMRUKRoom* Room, const FVector& Origin, const FVector& Direction, float MaxDist, FMRUKHit& OutHit)
+	{
+		AMRUKAnchor* HitAnchor = nullptr;
+		for (const auto& Anchor : Room->AllAnchors)
+		{
+			FMRUKHit HitResult;
+			if (Anchor->Raycast(Origin, Direction, MaxDist, HitResult))
+			{
+				MaxDist = HitResult.HitDistance;
+				OutHit = HitResult;
+				HitAnchor = Anchor;
+			}
+		}
+		return HitAnchor;
+	}
+
+	int32 LinearRaycastAllCount(AMRUKRoom* Room, const FVector& Origin, const FVector& Direction, float MaxDist)
+	{
+		TArray<FMRUKHit> Hits;
+		for (const auto& Anchor : Room->AllAnchors)
+		{
+			Anchor->RaycastAll(Origin, Direction, MaxDist, Hits);
+		}
+		return Hits.Num();
+	}
+
+	double LinearClosestSurfaceDistance(AMRUKRoom* Room, const FVector& Position)
+	{
+		double MinDistance = DBL_MAX;
+		for (const auto& Anchor : Room->AllAnchors)
+		{
+			FVector SurfacePosition;
+			MinDistance = FMath::Min(MinDistance, Anchor->GetClosestSurfacePosition(Position, SurfacePosition));
+		}
+		return MinDistance;
+	}
+
+	AMRUKAnchor* LinearPositionInSceneVolume(AMRUKRoom* Room, const FVector& Position)
+	{
+		for (const auto& Anchor : Room->AllAnchors)
+		{
+			if (Anchor->IsPositionInVolumeBounds(Position))
+			{
+				return Anchor;
+			}
+		}
+		return nullptr;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKBVHSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UMRUKSubsystem* ToolkitSubsystem;
+
+void SetupMRUKSubsystem();
+void TeardownMRUKSubsystem();
+void CompareWithLinearSearch(AMRUKRoom* Room, int32 NumQueries, int32 Seed);
+END_DEFINE_SPEC(FMRUKBVHSpec)
+
+void FMRUKBVHSpec::SetupMRUKSubsystem()
+{
+	BeforeEach([this]() {
+		// Load map and start play in editor
+		const auto ContentDir = FPaths::ProjectContentDir();
+		FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+		StartPIE(true);
+	});
+
+	BeforeEach(EAsyncExecution::ThreadPool, []() {
+		while (!GEditor->IsPlayingSessionInEditor())
+		{
+			// Wait until play session starts
+			FGenericPlatformProcess::Yield();
+		}
+	});
+
+	BeforeEach([this]() {
+		// Get a reference to the subsystem
+		const auto World = GEditor->GetPIEWorldContext()->World();
+		const auto GameInstance = World->GetGameInstance();
+		ToolkitSubsystem = GameInstance->GetSubsystem<UMRUKSubsystem>();
+	});
+}
+
+void FMRUKBVHSpec::TeardownMRUKSubsystem()
+{
+	// Caution: Order of these statements is important
+
+	AfterEach(EAsyncExecution::ThreadPool, []() {
+		while (GEditor->IsPlayingSessionInEditor())
+		{
+			// Wait until play session ends
+			FGenericPlatformProcess::Yield();
+		}
+	});
+
+	AfterEach([]() {
+		// Request end of play session
+		GUnrealEd->RequestEndPlayMap();
+	});
+}
+
+void FMRUKBVHSpec::CompareWithLinearSearch(AMRUKRoom* Room, int32 NumQueries, int32 Seed)
+{
+	FRandomStream RandomStream(Seed);
+	const FBox RoomBounds = Room->RoomBounds;
+
+	TArray<FVector> Positions;
+	TArray<FVector> Directions;
+	Positions.Reserve(NumQueries);
+	Directions.Reserve(NumQueries);
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		Positions.Add(RandomStream.RandPointInBox(RoomBounds));
+		Directions.Add(RandomStream.GetUnitVector());
+	}
+
+	double LinearSeconds = 0.0;
+	double BVHSeconds = 0.0;
+	int32 Mismatches = 0;
+
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		FMRUKHit ExpectedHit;
+		double StartTime = FPlatformTime::Seconds();
+		AMRUKAnchor* ExpectedAnchor = LinearRaycast(Room, Positions[I], Directions[I], 0.0f, ExpectedHit);
+		LinearSeconds += FPlatformTime::Seconds() - StartTime;
+
+		FMRUKHit ActualHit;
+		StartTime = FPlatformTime::Seconds();
+		AMRUKAnchor* ActualAnchor = Room->Raycast(Positions[I], Directions[I], 0.0f, {}, ActualHit);
+		BVHSeconds += FPlatformTime::Seconds() - StartTime;
+
+		if ((ExpectedAnchor == nullptr) != (ActualAnchor == nullptr)
+			|| (ExpectedAnchor && !FMath::IsNearlyEqual(ExpectedHit.HitDistance, ActualHit.HitDistance, 0.01f)))
+		{
+			++Mismatches;
+		}
+	}
+	TestEqual(TEXT("Raycast results match the linear search"), Mismatches, 0);
+	AddInfo(FString::Printf(TEXT("Raycast %d anchors: linear %.3f ms, BVH %.3f ms"), Room->AllAnchors.Num(), LinearSeconds * 1000.0, BVHSeconds * 1000.0));
+
+	Mismatches = 0;
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		TArray<FMRUKHit> Hits;
+		TArray<AMRUKAnchor*> Anchors;
+		Room->RaycastAll(Positions[I], Directions[I], 0.0f, {}, Hits, Anchors);
+		if (Hits.Num() != LinearRaycastAllCount(Room, Positions[I], Directions[I], 0.0f) || Hits.Num() != Anchors.Num())
+		{
+			++Mismatches;
+		}
+	}
+	TestEqual(TEXT("RaycastAll results match the linear search"), Mismatches, 0);
+
+	LinearSeconds = 0.0;
+	BVHSeconds = 0.0;
+	Mismatches = 0;
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		const double ExpectedDistance = LinearClosestSurfaceDistance(Room, Positions[I]);
+		LinearSeconds += FPlatformTime::Seconds() - StartTime;
+
+		FVector SurfacePosition;
+		double ActualDistance = 0.0;
+		StartTime = FPlatformTime::Seconds();
+		Room->TryGetClosestSurfacePosition(Positions[I], SurfacePosition, ActualDistance, {});
+		BVHSeconds += FPlatformTime::Seconds() - StartTime;
+
+		if (!FMath::IsNearlyEqual(ExpectedDistance, ActualDistance, 0.01))
+		{
+			++Mismatches;
+		}
+	}
+	TestEqual(TEXT("Closest surface results match the linear search"), Mismatches, 0);
+	AddInfo(FString::Printf(TEXT("Closest surface %d anchors: linear %.3f ms, BVH %.3f ms"), Room->AllAnchors.Num(), LinearSeconds * 1000.0, BVHSeconds * 1000.0));
+
+	LinearSeconds = 0.0;
+	BVHSeconds = 0.0;
+	Mismatches = 0;
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		double StartTime = FPlatformTime::Seconds();
+		const AMRUKAnchor* ExpectedAnchor = LinearPositionInSceneVolume(Room, Positions[I]);
+		LinearSeconds += FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		const AMRUKAnchor* ActualAnchor = Room->IsPositionInSceneVolume(Positions[I]);
+		BVHSeconds += FPlatformTime::Seconds() - StartTime;
+
+		if (ExpectedAnchor != ActualAnchor)
+		{
+			++Mismatches;
+		}
+	}
+	TestEqual(TEXT("Scene volume results match the linear search"), Mismatches, 0);
+	AddInfo(FString::Printf(TEXT("Scene volume %d anchors: linear %.3f ms, BVH %.3f ms"), Room->AllAnchors.Num(), LinearSeconds * 1000.0, BVHSeconds * 1000.0));
+}
+
+void FMRUKBVHSpec::Define()
+{
+	Describe(TEXT("Room BVH"), [this] {
+		SetupMRUKSubsystem();
+
+		It(TEXT("Matches linear search in example room"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(ExampleRoomJson);
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+			TestNotNull(TEXT("Room"), Room);
+			CompareWithLinearSearch(Room, 1000, 42);
+		});
+
+		for (const int32 NumAnchors : { 10, 100, 500, 2000 })
+		{
+			It(FString::Printf(TEXT("Matches linear search with %d anchors"), NumAnchors), [this, NumAnchors] {
+				ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(NumAnchors, 1));
+				AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+				TestNotNull(TEXT("Room"), Room);
+				TestEqual(TEXT("Number of anchors"), Room->AllAnchors.Num(), NumAnchors);
+				CompareWithLinearSearch(Room, 1000, NumAnchors);
+			});
+		}
+
+		It(TEXT("Updates incrementally when anchors change"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(200, 1));
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+			TestNotNull(TEXT("Room"), Room);
+			CompareWithLinearSearch(Room, 200, 1);
+
+			// Same anchors at different locations
+			ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(200, 2));
+			TestTrue(TEXT("Room was updated in place"), ToolkitSubsystem->GetCurrentRoom() == Room);
+			CompareWithLinearSearch(Room, 200, 2);
+
+			// Less anchors
+			ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(50, 2));
+			TestEqual(TEXT("Number of anchors"), Room->AllAnchors.Num(), 50);
+			CompareWithLinearSearch(Room, 200, 3);
+
+			// Moving the room moves all anchors with it
+			Room->SetActorLocationAndRotation(FVector(100.0, -50.0, 20.0), FRotator(0.0, 35.0, 0.0));
+			CompareWithLinearSearch(Room, 200, 4);
+		});
+
+		TeardownMRUKSubsystem();
+	});
+}
@@ -0,0 +1,171 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitBlobShadowComponent.h"
+#include "MRUtilityKitBlobShadowSubsystem.h"
+#include "Containers/Ticker.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "Editor.h"
+
+namespace
+{
+	AStaticMeshActor* SpawnCube(UWorld* World, const FVector& Location, const FVector& Scale)
+	{
+		AStaticMeshActor* Actor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+		Actor->GetStaticMeshComponent()->SetMobility(EComponentMobility::Movable);
+		Actor->GetStaticMeshComponent()->SetStaticMesh(LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube")));
+		Actor->SetActorScale3D(Scale);
+		return Actor;
+	}
+
+	// Steps through the frames of a latent test until every step reported that it's done
+	struct FBlobShadowBenchmark
+	{
+		TArray<TFunction<bool()>> Steps;
+		int32 Step = 0;
+		int32 Frames = 0;
+	};
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKBlobShadowSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UWorld* World;
+END_DEFINE_SPEC(FMRUKBlobShadowSpec)
+
+void FMRUKBlobShadowSpec::Define()
+{
+	Describe(TEXT("Blob shadow subsystem"), [this] {
+		BeforeEach([this]() {
+			// Load map and start play in editor
+			const auto ContentDir = FPaths::ProjectContentDir();
+			FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+			StartPIE(true);
+		});
+
+		BeforeEach(EAsyncExecution::ThreadPool, []() {
+			while (!GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session starts
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		BeforeEach([this]() {
+			World = GEditor->GetPIEWorldContext()->World();
+		});
+
+		LatentIt(TEXT("Batches traces of 500 blob shadows"), [this](const FDoneDelegate& Done) {
+			constexpr int32 NumShadows = 500;
+			constexpr int32 NumMoved = 10;
+			UMRUKBlobShadowSubsystem* Subsystem = World->GetSubsystem<UMRUKBlobShadowSubsystem>();
+			if (!TestNotNull(TEXT("Blob shadow subsystem"), Subsystem))
+			{
+				Done.Execute();
+				return;
+			}
+
+			// Ground far away from anything else in the level with props floating above it
+			const FVector GroundOrigin(0.0, 0.0, -100000.0);
+			SpawnCube(World, GroundOrigin - FVector(0.0, 0.0, 50.0), FVector(100.0, 100.0, 1.0));
+			TArray<AStaticMeshActor*> Props;
+			TArray<UMRUKBlobShadowComponent*> Shadows;
+			for (int32 i = 0; i < NumShadows; ++i)
+			{
+				AStaticMeshActor* Prop = SpawnCube(World, GroundOrigin + FVector((i % 25) * 150.0 - 1800.0, (i / 25) * 150.0 - 1500.0, 50.0), FVector(0.3));
+				UMRUKBlobShadowComponent* Shadow = NewObject<UMRUKBlobShadowComponent>(Prop);
+				Shadow->SetupAttachment(Prop->GetRootComponent());
+				Shadow->RegisterComponent();
+				Props.Add(Prop);
+				Shadows.Add(Shadow);
+			}
+			TestFalse(TEXT("Blob shadows don't tick themselves"), Shadows[0]->IsComponentTickEnabled());
+
+			// Cost of every blob shadow tracing on its own like before
+			const double StartTime = FPlatformTime::Seconds();
+			for (UMRUKBlobShadowComponent* Shadow : Shadows)
+			{
+				Shadow->UpdatePlaneSizeAndPosition();
+			}
+			const double SyncMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			TArray<FVector> SyncLocations;
+			for (UMRUKBlobShadowComponent* Shadow : Shadows)
+			{
+				SyncLocations.Add(Shadow->GetComponentLocation());
+				TestFalse(TEXT("Blob shadow found the ground"), Shadow->bHiddenInGame);
+				Shadow->SetWorldLocation(FVector::ZeroVector);
+				Subsystem->Invalidate(Shadow);
+			}
+
+			const TSharedRef<FBlobShadowBenchmark> Benchmark = MakeShared<FBlobShadowBenchmark>();
+			Benchmark->Steps.Add([Subsystem]() {
+				return Subsystem->Stats.TracesIssued == NumShadows;
+			});
+			Benchmark->Steps.Add([this, Subsystem, Shadows, SyncLocations]() {
+				if (Subsystem->Stats.ResultsApplied != NumShadows)
+				{
+					return false;
+				}
+				int32 NumMismatches = 0;
+				for (int32 i = 0; i < Shadows.Num(); ++i)
+				{
+					NumMismatches += Shadows[i]->GetComponentLocation().Equals(SyncLocations[i], 0.1) ? 0 : 1;
+				}
+				TestEqual(TEXT("Async traces place the shadows like sync traces"), NumMismatches, 0);
+				return true;
+			});
+			Benchmark->Steps.Add([this, Subsystem, Props, SyncMs]() {
+				if (Subsystem->Stats.TracesIssued != 0)
+				{
+					return false;
+				}
+				TestEqual(TEXT("Static props skip their traces"), Subsystem->Stats.TracesSkipped, Subsystem->Stats.Shadows);
+				AddInfo(FString::Printf(TEXT("%d blob shadows: sync traces %.3f ms, subsystem with static props %.3f ms"), NumShadows, SyncMs, Subsystem->Stats.UpdateTimeMs));
+				for (int32 i = 0; i < NumMoved; ++i)
+				{
+					Props[i]->AddActorWorldOffset(FVector(10.0, 0.0, 5.0));
+				}
+				return true;
+			});
+			Benchmark->Steps.Add([this, Subsystem]() {
+				if (Subsystem->Stats.TracesIssued == 0)
+				{
+					return false;
+				}
+				TestEqual(TEXT("Only moved props trace"), Subsystem->Stats.TracesIssued, NumMoved);
+				return true;
+			});
+
+			FTSTicker::GetCoreTicker().AddTicker(TEXT("MRUKBlobShadowSpec"), 0.0f, [this, Benchmark, Done](float) {
+				constexpr int32 MaxFrames = 300;
+				if (++Benchmark->Frames > MaxFrames)
+				{
+					AddError(FString::Printf(TEXT("Step %d didn't finish within %d frames"), Benchmark->Step, MaxFrames));
+					Done.Execute();
+					return false;
+				}
+				if (Benchmark->Steps[Benchmark->Step]() && ++Benchmark->Step == Benchmark->Steps.Num())
+				{
+					Done.Execute();
+					return false;
+				}
+				return true;
+			});
+		});
+
+		AfterEach(EAsyncExecution::ThreadPool, []() {
+			while (GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session ends
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		AfterEach([]() {
+			// Request end of play session
+			GUnrealEd->RequestEndPlayMap();
+		});
+	});
+}
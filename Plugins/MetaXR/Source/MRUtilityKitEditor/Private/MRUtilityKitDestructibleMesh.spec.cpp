@@ -0,0 +1,181 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitDestructibleMesh.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "Editor.h"
+
+namespace
+{
+	// A row of small grid patches, one per segment, that stands in for the output of the mesh segmentation
+	FMRUKMeshSegment MakeGridPatch(const FVector& Origin, int32 Resolution)
+	{
+		FMRUKMeshSegment Segment;
+		for (int32 Y = 0; Y <= Resolution; ++Y)
+		{
+			for (int32 X = 0; X <= Resolution; ++X)
+			{
+				Segment.Positions.Add(Origin + FVector(0.0, X * 2.0, Y * 2.0));
+			}
+		}
+		for (int32 Y = 0; Y < Resolution; ++Y)
+		{
+			for (int32 X = 0; X < Resolution; ++X)
+			{
+				const int32 I = Y * (Resolution + 1) + X;
+				Segment.Indices.Append({ I, I + Resolution + 1, I + 1, I + 1, I + Resolution + 1, I + Resolution + 2 });
+			}
+		}
+		return Segment;
+	}
+
+	TMap<FString, UProceduralMeshComponent*> GetSpawnedSegments(AMRUKDestructibleGlobalMesh* Mesh)
+	{
+		TArray<UProceduralMeshComponent*> Components;
+		Mesh->GetComponents<UProceduralMeshComponent>(Components);
+		TMap<FString, UProceduralMeshComponent*> Segments;
+		for (UProceduralMeshComponent* Component : Components)
+		{
+			if (Component != Mesh->DestructibleMeshComponent)
+			{
+				Segments.Add(Component->GetName(), Component);
+			}
+		}
+		return Segments;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKDestructibleMeshSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UWorld* World;
+
+UMRUKDestructibleMeshComponent::FSegmentationResult MakeSegmentation(int32 NumSegments);
+END_DEFINE_SPEC(FMRUKDestructibleMeshSpec)
+
+UMRUKDestructibleMeshComponent::FSegmentationResult FMRUKDestructibleMeshSpec::MakeSegmentation(int32 NumSegments)
+{
+	UMRUKDestructibleMeshComponent::FSegmentationResult Result;
+	for (int32 I = 0; I < NumSegments; ++I)
+	{
+		Result.Segments.Add(MakeGridPatch(FVector(100.0, (I % 8) * 20.0 - 80.0, (I / 8) * 20.0), 8));
+		Result.Centers.Add(FBox(Result.Segments.Last().Positions).GetCenter());
+	}
+	Result.ReservedSegment = MakeGridPatch(FVector(100.0, -80.0, -40.0), 16);
+	Result.Centers.Add(FBox(Result.ReservedSegment.Positions).GetCenter());
+	return Result;
+}
+
+void FMRUKDestructibleMeshSpec::Define()
+{
+	Describe(TEXT("Destructible mesh"), [this] {
+		BeforeEach([this]() {
+			// Load map and start play in editor
+			const auto ContentDir = FPaths::ProjectContentDir();
+			FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+			StartPIE(true);
+		});
+
+		BeforeEach(EAsyncExecution::ThreadPool, []() {
+			while (!GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session starts
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		BeforeEach([this]() {
+			World = GEditor->GetPIEWorldContext()->World();
+		});
+
+		It(TEXT("Budgeted spawning creates the same segments as eager spawning"), [this]() {
+			constexpr int32 NumSegments = 64;
+
+			AMRUKDestructibleGlobalMesh* EagerMesh = World->SpawnActor<AMRUKDestructibleGlobalMesh>();
+			UMRUKDestructibleMeshComponent* Eager = EagerMesh->DestructibleMeshComponent;
+			Eager->StartSpawningSegments(MakeSegmentation(NumSegments));
+			TestTrue(TEXT("Eager spawning finishes in one frame"), Eager->SpawnPendingSegments(0.0f));
+			TestEqual(TEXT("Eager segments spawned"), Eager->SpawnStats.SegmentsSpawned, NumSegments + 1);
+
+			AMRUKDestructibleGlobalMesh* BudgetedMesh = World->SpawnActor<AMRUKDestructibleGlobalMesh>();
+			UMRUKDestructibleMeshComponent* Budgeted = BudgetedMesh->DestructibleMeshComponent;
+			Budgeted->StartSpawningSegments(MakeSegmentation(NumSegments));
+
+			// With a tiny budget every frame spawns exactly one segment. The first one is the closest to the viewer.
+			const APlayerController* PlayerController = World->GetFirstPlayerController();
+			const bool bHasViewer = PlayerController && PlayerController->PlayerCameraManager;
+			TestFalse(TEXT("Budgeted spawning takes more than one frame"), Budgeted->SpawnPendingSegments(0.0001f));
+			TestEqual(TEXT("Segments spawned in first frame"), Budgeted->SpawnStats.SegmentsSpawnedLastFrame, 1);
+			if (bHasViewer)
+			{
+				const FVector ViewerLocation = BudgetedMesh->GetActorTransform().InverseTransformPosition(PlayerController->PlayerCameraManager->GetCameraLocation());
+				const auto Segmentation = MakeSegmentation(NumSegments);
+				int32 Closest = 0;
+				for (int32 I = 1; I < Segmentation.Centers.Num(); ++I)
+				{
+					if (FVector::DistSquared(Segmentation.Centers[I], ViewerLocation) < FVector::DistSquared(Segmentation.Centers[Closest], ViewerLocation))
+					{
+						Closest = I;
+					}
+				}
+				const FString ClosestName = Closest == NumSegments ? FString(TEXT("ReservedMeshSegment")) : FString::Printf(TEXT("DestructibleMeshSegment%d"), Closest);
+				TestTrue(TEXT("Closest segment is spawned first"), GetSpawnedSegments(BudgetedMesh).Contains(ClosestName));
+			}
+			else
+			{
+				AddInfo(TEXT("No viewer available, spawn order is not tested"));
+			}
+
+			int32 Frames = 1;
+			while (!Budgeted->SpawnPendingSegments(0.0001f) && Frames <= NumSegments + 1)
+			{
+				TestEqual(TEXT("Segments spawned per frame"), Budgeted->SpawnStats.SegmentsSpawnedLastFrame, 1);
+				++Frames;
+			}
+			TestEqual(TEXT("Frames spent spawning"), Budgeted->SpawnStats.Frames, NumSegments + 1);
+			TestEqual(TEXT("Budgeted segments spawned"), Budgeted->SpawnStats.SegmentsSpawned, NumSegments + 1);
+			TestEqual(TEXT("No segments pending"), Budgeted->SpawnStats.SegmentsPending, 0);
+
+			const TMap<FString, UProceduralMeshComponent*> EagerSegments = GetSpawnedSegments(EagerMesh);
+			const TMap<FString, UProceduralMeshComponent*> BudgetedSegments = GetSpawnedSegments(BudgetedMesh);
+			TestEqual(TEXT("Same number of segments"), BudgetedSegments.Num(), EagerSegments.Num());
+			for (const auto& [Name, EagerSegment] : EagerSegments)
+			{
+				UProceduralMeshComponent* const* BudgetedSegment = BudgetedSegments.Find(Name);
+				if (!TestNotNull(*FString::Printf(TEXT("Segment %s"), *Name), BudgetedSegment))
+				{
+					continue;
+				}
+				TestTrue(TEXT("Same tags"), (*BudgetedSegment)->ComponentTags == EagerSegment->ComponentTags);
+				TestEqual(TEXT("Same parent"), (*BudgetedSegment)->GetAttachParent(), BudgetedMesh->GetRootComponent());
+				const FProcMeshSection* EagerSection = EagerSegment->GetProcMeshSection(0);
+				const FProcMeshSection* BudgetedSection = (*BudgetedSegment)->GetProcMeshSection(0);
+				if (TestNotNull(TEXT("Eager section"), EagerSection) && TestNotNull(TEXT("Budgeted section"), BudgetedSection))
+				{
+					TestTrue(TEXT("Same indices"), BudgetedSection->ProcIndexBuffer == EagerSection->ProcIndexBuffer);
+					bool bSamePositions = BudgetedSection->ProcVertexBuffer.Num() == EagerSection->ProcVertexBuffer.Num();
+					for (int32 I = 0; bSamePositions && I < EagerSection->ProcVertexBuffer.Num(); ++I)
+					{
+						bSamePositions = BudgetedSection->ProcVertexBuffer[I].Position == EagerSection->ProcVertexBuffer[I].Position;
+					}
+					TestTrue(TEXT("Same positions"), bSamePositions);
+				}
+			}
+		});
+
+		AfterEach(EAsyncExecution::ThreadPool, []() {
+			while (GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session ends
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		AfterEach([]() {
+			// Request end of play session
+			GUnrealEd->RequestEndPlayMap();
+		});
+	});
+}
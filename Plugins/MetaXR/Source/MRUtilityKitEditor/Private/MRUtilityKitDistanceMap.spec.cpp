@@ -2,6 +2,8 @@
 
 #include "DistanceMapTestData.h"
 #include "MRUtilityKitDistanceMapGenerator.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitAnchor.h"
 #include "MRUtilityKitSubsystem.h"
 #include "TestHelper.h"
 #include "UnrealEdGlobals.h"
@@ -191,6 +193,146 @@ void FMRUKDistanceMapSpec::Define()
 			}
 		});
 
+		It(TEXT("CPU distance field is exact"), [this] {
+			const auto World = GEditor->GetPIEWorldContext()->World();
+			const auto GameInstance = World->GetGameInstance();
+			UMRUKSubsystem* Subsystem = GameInstance->GetSubsystem<UMRUKSubsystem>();
+			Subsystem->LoadSceneFromJsonString(ExampleRoomJson);
+
+			const FActorSpawnParameters Params{};
+			AMRUKDistanceMapGenerator* DistanceMapGenerator = World->SpawnActor<AMRUKDistanceMapGenerator>(Params);
+			DistanceMapGenerator->SetActorLocation(FVector(0.0, 0.0, 200.0));
+			DistanceMapGenerator->SetActorRotation(FRotator::MakeFromEuler(FVector(0.0, -90.0, 0.0)));
+
+			constexpr int32 NumIterations = 10;
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 I = 0; I < NumIterations; ++I)
+			{
+				DistanceMapGenerator->ComputeDistanceFieldCPU();
+			}
+			const double CPUTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+			const FMRUKDistanceField& DistanceField = DistanceMapGenerator->GetDistanceField();
+			const int32 Resolution = DistanceField.GetResolution();
+			AddInfo(FString::Printf(TEXT("CPU distance field with %dx%d texels took %.3f ms"), Resolution, Resolution, CPUTime * 1000.0));
+
+			TArray<FIntPoint> FreeTexels;
+			TArray<FIntPoint> OccupiedTexels;
+			for (int32 Y = 0; Y < Resolution; ++Y)
+			{
+				for (int32 X = 0; X < Resolution; ++X)
+				{
+					(DistanceField.GetDistanceAtTexel(X, Y) > 0.0f ? FreeTexels : OccupiedTexels).Push(FIntPoint(X, Y));
+				}
+			}
+			if (!TestTrue(TEXT("Field contains free space"), FreeTexels.Num() > 0) || !TestTrue(TEXT("Field contains occupied space"), OccupiedTexels.Num() > 0))
+			{
+				return;
+			}
+
+			// Compare a random subset of texels with a brute force search for the closest texel of the other kind
+			FRandomStream RandomStream(1234);
+			const float Tolerance = static_cast<float>(1e-3 * DistanceField.GetTexelSize());
+			for (int32 I = 0; I < 256; ++I)
+			{
+				const FIntPoint Texel(RandomStream.RandHelper(Resolution), RandomStream.RandHelper(Resolution));
+				const float Distance = DistanceField.GetDistanceAtTexel(Texel.X, Texel.Y);
+				const TArray<FIntPoint>& Others = Distance > 0.0f ? OccupiedTexels : FreeTexels;
+				int64 MinDistanceSquared = TNumericLimits<int64>::Max();
+				for (const FIntPoint& Other : Others)
+				{
+					const int64 DX = Other.X - Texel.X;
+					const int64 DY = Other.Y - Texel.Y;
+					MinDistanceSquared = FMath::Min(MinDistanceSquared, DX * DX + DY * DY);
+				}
+				const float Expected = static_cast<float>(FMath::Sqrt(static_cast<double>(MinDistanceSquared)) * DistanceField.GetTexelSize());
+				if (!TestNearlyEqual(FString::Printf(TEXT("Distance of texel %d,%d"), Texel.X, Texel.Y), FMath::Abs(Distance), Expected, Tolerance))
+				{
+					break;
+				}
+			}
+
+			// Point samples at texel centers return the texel value and the sign matches the room geometry
+			const FIntPoint Center(Resolution / 2, Resolution / 2);
+			TestNearlyEqual(TEXT("Sample at texel center"), DistanceMapGenerator->GetDistanceAtLocation(DistanceField.TexelToWorld(Center.X, Center.Y)),
+				DistanceField.GetDistanceAtTexel(Center.X, Center.Y), Tolerance);
+			AMRUKRoom* Room = Subsystem->GetCurrentRoom();
+			for (int32 I = 0; I < 64; ++I)
+			{
+				const FIntPoint Texel(RandomStream.RandHelper(Resolution), RandomStream.RandHelper(Resolution));
+				const float Distance = DistanceField.GetDistanceAtTexel(Texel.X, Texel.Y);
+				if (FMath::Abs(Distance) < 2.0f * DistanceField.GetTexelSize())
+				{
+					// Too close to a boundary to be sure about rasterization
+					continue;
+				}
+				FVector Position = DistanceField.TexelToWorld(Texel.X, Texel.Y);
+				Position.Z = Room->FloorAnchor->GetActorLocation().Z + 1.0;
+				const bool bInsideRoom = Room->IsPositionInRoom(Position, false);
+				const bool bInsideVolume = Room->IsPositionInSceneVolume(Position, false) != nullptr;
+				TestEqual(FString::Printf(TEXT("Texel %d,%d is free"), Texel.X, Texel.Y), Distance > 0.0f, bInsideRoom && !bInsideVolume);
+			}
+		});
+
+		It(TEXT("CPU distance field matches GPU distance map"), [this] {
+			const auto World = GEditor->GetPIEWorldContext()->World();
+			const auto GameInstance = World->GetGameInstance();
+			UMRUKSubsystem* Subsystem = GameInstance->GetSubsystem<UMRUKSubsystem>();
+			Subsystem->LoadSceneFromJsonString(ExampleRoomJson);
+
+			const FActorSpawnParameters Params{};
+			AMRUKDistanceMapGenerator* DistanceMapGenerator = World->SpawnActor<AMRUKDistanceMapGenerator>(Params);
+			DistanceMapGenerator->SetActorLocation(FVector(0.0, 0.0, 200.0));
+			DistanceMapGenerator->SetActorRotation(FRotator::MakeFromEuler(FVector(0.0, -90.0, 0.0)));
+
+			double StartTime = FPlatformTime::Seconds();
+			UCanvasRenderTarget2D* RenderTarget = Cast<UCanvasRenderTarget2D>(DistanceMapGenerator->CaptureDistanceMap());
+			FlushRenderingCommands();
+			const double GPUTime = FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			DistanceMapGenerator->ComputeDistanceFieldCPU();
+			const double CPUTime = FPlatformTime::Seconds() - StartTime;
+			AddInfo(FString::Printf(TEXT("GPU distance map took %.3f ms, CPU distance field took %.3f ms"), GPUTime * 1000.0, CPUTime * 1000.0));
+
+			TArray<FLinearColor> PixelData;
+			RenderTarget->GameThread_GetRenderTargetResource()->ReadLinearColorPixels(PixelData);
+
+			const FMRUKDistanceField& DistanceField = DistanceMapGenerator->GetDistanceField();
+			const int32 Resolution = DistanceField.GetResolution();
+			if (!TestEqual(TEXT("Pixel count matches"), PixelData.Num(), Resolution * Resolution))
+			{
+				return;
+			}
+
+			// The jump flood result stores the UV of the closest seed of each kind in RG and BA. A texel is its own
+			// closest seed of its kind, so the larger of the two distances is the distance to the other kind.
+			double ErrorSum = 0.0;
+			int32 NumWithinTolerance = 0;
+			for (int32 Y = 0; Y < Resolution; ++Y)
+			{
+				for (int32 X = 0; X < Resolution; ++X)
+				{
+					const FLinearColor& Pixel = PixelData[Y * Resolution + X];
+					const FVector2D UV((X + 0.5) / Resolution, (Y + 0.5) / Resolution);
+					const double DistanceRG = FVector2D::Distance(UV, FVector2D(Pixel.R, Pixel.G)) * Resolution;
+					const double DistanceBA = FVector2D::Distance(UV, FVector2D(Pixel.B, Pixel.A)) * Resolution;
+					const double GPUDistance = FMath::Max(DistanceRG, DistanceBA);
+					const double CPUDistance = FMath::Abs(DistanceField.GetDistanceAtTexel(X, Y)) / DistanceField.GetTexelSize();
+					const double Error = FMath::Abs(GPUDistance - CPUDistance);
+					ErrorSum += Error;
+					NumWithinTolerance += Error <= 2.0 ? 1 : 0;
+				}
+			}
+
+			// Jump flooding is approximate and the rasterization differs slightly at the edges, hence the tolerance
+			const double MeanError = ErrorSum / PixelData.Num();
+			const double FractionWithinTolerance = static_cast<double>(NumWithinTolerance) / PixelData.Num();
+			AddInfo(FString::Printf(TEXT("Mean error %.3f texels, %.2f%% of the texels within 2 texels"), MeanError, FractionWithinTolerance * 100.0));
+			TestTrue(TEXT("Mean error is below one texel"), MeanError < 1.0);
+			TestTrue(TEXT("Almost all texels are within tolerance"), FractionWithinTolerance > 0.98);
+		});
+
 		// Caution: Order of these statements is important
 
 		AfterEach(EAsyncExecution::ThreadPool, []() {
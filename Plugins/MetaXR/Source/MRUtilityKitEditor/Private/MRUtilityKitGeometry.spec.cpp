@@ -1,7 +1,11 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "MRUtilityKitGeometry.h"
+#include "MRUtilityKit.h"
+#include "Dom/JsonObject.h"
 #include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
 #include "Tests/AutomationEditorCommon.h"
 #include "Editor/UnrealEdEngine.h"
 #include "TestHelper.h"
@@ -30,11 +34,87 @@ namespace
 
 		return Area;
 	}
+
+	// Collect all plane boundaries from a scene JSON string. Walls and the floor of the example rooms are used as polygons
+	// for the benchmark. To emulate walls with many doors and windows a grid of holes gets cut into every boundary.
+	TArray<TArray<TArray<FVector2f>>> CollectBenchmarkPolygons(const TCHAR* Json, int32 HolesPerAxis)
+	{
+		TArray<TArray<TArray<FVector2f>>> Result;
+
+		TSharedPtr<FJsonObject> JsonObject;
+		const auto JsonReader = TJsonReaderFactory<>::Create(Json);
+		if (!FJsonSerializer::Deserialize(JsonReader, JsonObject) || !JsonObject.IsValid())
+		{
+			return Result;
+		}
+
+		for (const auto& RoomValue : JsonObject->GetArrayField(TEXT("Rooms")))
+		{
+			for (const auto& AnchorValue : RoomValue->AsObject()->GetArrayField(TEXT("Anchors")))
+			{
+				const TArray<TSharedPtr<FJsonValue>>* BoundaryValues = nullptr;
+				if (!AnchorValue->AsObject()->TryGetArrayField(TEXT("PlaneBoundary2D"), BoundaryValues))
+				{
+					continue;
+				}
+
+				TArray<FVector2f> Boundary;
+				FBox2f Bounds(ForceInit);
+				for (const auto& PointValue : *BoundaryValues)
+				{
+					const auto& Coords = PointValue->AsArray();
+					const FVector2f Point(Coords[0]->AsNumber(), Coords[1]->AsNumber());
+					Boundary.Push(Point);
+					Bounds += Point;
+				}
+
+				TArray<TArray<FVector2f>> Polygons = { Boundary };
+				const FVector2f CellSize = Bounds.GetSize() / (HolesPerAxis + 1);
+				const FVector2f HoleSize = CellSize * 0.5f;
+				for (int32 X = 0; X < HolesPerAxis; ++X)
+				{
+					for (int32 Y = 0; Y < HolesPerAxis; ++Y)
+					{
+						const FVector2f Min = Bounds.Min + CellSize * FVector2f(X + 1, Y + 1) - HoleSize * 0.5f;
+						Polygons.Push({ Min, Min + FVector2f(0.0f, HoleSize.Y), Min + HoleSize, Min + FVector2f(HoleSize.X, 0.0f) });
+					}
+				}
+				Result.Push(MoveTemp(Polygons));
+			}
+		}
+
+		return Result;
+	}
+
+	// Returns the average time per triangulation in microseconds
+	double BenchmarkTriangulation(const TArray<TArray<TArray<FVector2f>>>& PolygonSets, EMRUKTriangulationBackend Backend, int32 Iterations, double& OutArea)
+	{
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		OutArea = 0.0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 I = 0; I < Iterations; ++I)
+		{
+			for (const auto& Polygons : PolygonSets)
+			{
+				MRUKTriangulatePolygon(Polygons, Vertices, Indices, Backend);
+				if (I == 0)
+				{
+					OutArea += CalculateTriangulatedArea(Vertices, Indices);
+				}
+			}
+		}
+		const double EndTime = FPlatformTime::Seconds();
+
+		return (EndTime - StartTime) * 1e6 / (static_cast<double>(Iterations) * FMath::Max(1, PolygonSets.Num()));
+	}
 } // namespace
 
 BEGIN_DEFINE_SPEC(FMRUKGeometrySpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
 void SetupMRUKSubsystem();
 void TeardownMRUKSubsystem();
+void DefineTriangulationTests(EMRUKTriangulationBackend Backend);
 END_DEFINE_SPEC(FMRUKGeometrySpec)
 
 void FMRUKGeometrySpec::SetupMRUKSubsystem()
@@ -73,84 +153,173 @@ void FMRUKGeometrySpec::TeardownMRUKSubsystem()
 	});
 }
 
+void FMRUKGeometrySpec::DefineTriangulationTests(EMRUKTriangulationBackend Backend)
+{
+	It(TEXT("Triangulate quad"), [this, Backend] {
+		const TArray<FVector2f> TestPolygon = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices, Backend);
+		TestEqual(TEXT("Correct number of indices"), 6, Indices.Num());
+		TestEqual(TEXT("Correct area triangulated"), 1.0, CalculateTriangulatedArea(Vertices, Indices));
+	});
+
+	It(TEXT("Triangulate quad with hole"), [this, Backend] {
+		const TArray<TArray<FVector2f>> Polygons = { { { 0.0f, 0.0f }, { 2.0f, 0.0f }, { 2.0f, 2.0f }, { 0.0f, 2.0f } }, { { 0.5f, 0.5f }, { 0.5f, 1.5f }, { 1.5f, 1.5f }, { 1.5f, 0.5f } } };
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		MRUKTriangulatePolygon(Polygons, Vertices, Indices, Backend);
+
+		TestEqual(TEXT("Correct number of indices"), Indices.Num(), 24);
+		TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 3.0);
+	});
+
+	It(TEXT("Triangulate quad with four holes"), [this, Backend] {
+		TArray<TArray<FVector2f>> Polygons = { { { 0.0f, 0.0f }, { 4.0f, 0.0f }, { 4.0f, 4.0f }, { 0.0f, 4.0f } } };
+		for (int32 I = 0; I < 4; ++I)
+		{
+			const FVector2f Offset(0.5 + 2.0 * (I / 2), 0.5 + 2.0 * (I % 2));
+			Polygons.Push({ Offset + FVector2f(0.0, 0.0), Offset + FVector2f(0.0, 1.0), Offset + FVector2f(1.0, 1.0), Offset + FVector2f(1.0, 0.0) });
+		}
+
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		MRUKTriangulatePolygon(Polygons, Vertices, Indices, Backend);
+
+		TestEqual(TEXT("Correct number of indices"), Indices.Num(), 66);
+		TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 12.0);
+	});
+
+	It(TEXT("Triangulate quad with two close holes"), [this, Backend] {
+		const TArray<TArray<FVector2f>> Polygons = {
+			{
+				{ 101.985214, 113.8258 },
+				{ -101.985214, 113.8258 },
+				{ -101.985214, -113.8258 },
+				{ 101.985214, -113.8258 },
+			},
+			{ { 18.395055731633885, 9.0596833 }, { -72.518264268366110, 9.0596833 }, { -72.518264268366110, 67.2252527 }, { 18.395055731633885, 67.2252527 } },
+			{ { 18.395055731633885, -53.4203167 }, { -72.518264268366110, -53.4203167 }, { -72.518264268366110, 4.7452569 }, { 18.395055731633885, 4.7452569 } },
+		};
+
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		MRUKTriangulatePolygon(Polygons, Vertices, Indices, Backend);
+
+		TestEqual(TEXT("Correct number of indices"), Indices.Num(), 42);
+		TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 35858.143857, 0.001);
+	});
+
+	It(TEXT("Triangulate LShape"), [this, Backend] {
+		const TArray<FVector2f> TestPolygon = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 2.0 }, { 1.0, 2.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices, Backend);
+
+		TestEqual(TEXT("Correct number of indices"), Indices.Num(), 12);
+		TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 3.0);
+	});
+
+	It(TEXT("Triangulate CShape"), [this, Backend] {
+		const TArray<FVector2f> TestPolygon = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 1.0 }, { 1.0, 1.0 }, { 1.0, 2.0 }, { 2.0, 2.0 }, { 2.0, 3.0 }, { 0.0, 3.0 } };
+		TArray<FVector2D> Vertices;
+		TArray<int32> Indices;
+		MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices, Backend);
+
+		TestEqual(TEXT("Correct number of indices"), Indices.Num(), 18);
+		TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 5.0);
+	});
+
+}
+
 void FMRUKGeometrySpec::Define()
 {
 	Describe(TEXT("Triangulation"), [this] {
 		SetupMRUKSubsystem();
 
-		It(TEXT("Triangulate quad"), [this] {
-			const TArray<FVector2f> TestPolygon = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+		DefineTriangulationTests(EMRUKTriangulationBackend::Auto);
+
+		TeardownMRUKSubsystem();
+	});
+
+	Describe(TEXT("Native Triangulation"), [this] {
+		DefineTriangulationTests(EMRUKTriangulationBackend::Native);
+
+		It(TEXT("Triangulate clockwise outline"), [this] {
+			const TArray<FVector2f> TestPolygon = { { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 0.0f } };
 			TArray<FVector2D> Vertices;
 			TArray<int32> Indices;
-			MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices);
-			TestEqual(TEXT("Correct number of indices"), 6, Indices.Num());
-			TestEqual(TEXT("Correct area triangulated"), 1.0, CalculateTriangulatedArea(Vertices, Indices));
+			MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices, EMRUKTriangulationBackend::Native);
+			TestEqual(TEXT("Correct number of vertices"), Vertices.Num(), 4);
+			TestEqual(TEXT("Correct number of indices"), Indices.Num(), 6);
+			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 1.0);
 		});
 
-		It(TEXT("Triangulate quad with hole"), [this] {
-			const TArray<TArray<FVector2f>> Polygons = { { { 0.0f, 0.0f }, { 2.0f, 0.0f }, { 2.0f, 2.0f }, { 0.0f, 2.0f } }, { { 0.5f, 0.5f }, { 0.5f, 1.5f }, { 1.5f, 1.5f }, { 1.5f, 0.5f } } };
+		It(TEXT("Triangulate degenerate polygon"), [this] {
+			const TArray<FVector2f> TestPolygon = { { 0.0f, 0.0f }, { 1.0f, 0.0f } };
 			TArray<FVector2D> Vertices;
 			TArray<int32> Indices;
-			MRUKTriangulatePolygon(Polygons, Vertices, Indices);
-
-			TestEqual(TEXT("Correct number of indices"), Indices.Num(), 24);
-			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 3.0);
+			MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices, EMRUKTriangulationBackend::Native);
+			TestEqual(TEXT("No indices"), Indices.Num(), 0);
 		});
 
-		It(TEXT("Triangulate quad with four holes"), [this] {
-			TArray<TArray<FVector2f>> Polygons = { { { 0.0f, 0.0f }, { 4.0f, 0.0f }, { 4.0f, 4.0f }, { 0.0f, 4.0f } } };
-			for (int32 I = 0; I < 4; ++I)
+		It(TEXT("Triangulate circle with many holes"), [this] {
+			// Large enough to use the z-order hashed ear test
+			TArray<TArray<FVector2f>> Polygons;
+			TArray<FVector2f>& Outline = Polygons.AddDefaulted_GetRef();
+			constexpr int32 NumSegments = 400;
+			for (int32 I = 0; I < NumSegments; ++I)
 			{
-				const FVector2f Offset(0.5 + 2.0 * (I / 2), 0.5 + 2.0 * (I % 2));
-				Polygons.Push({ Offset + FVector2f(0.0, 0.0), Offset + FVector2f(0.0, 1.0), Offset + FVector2f(1.0, 1.0), Offset + FVector2f(1.0, 0.0) });
+				const float Angle = 2.0f * PI * I / NumSegments;
+				Outline.Push(FVector2f(FMath::Cos(Angle), FMath::Sin(Angle)) * 100.0f);
 			}
-
-			TArray<FVector2D> Vertices;
-			TArray<int32> Indices;
-			MRUKTriangulatePolygon(Polygons, Vertices, Indices);
-
-			TestEqual(TEXT("Correct number of indices"), Indices.Num(), 66);
-			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 12.0);
-		});
-
-		It(TEXT("Triangulate quad with two close holes"), [this] {
-			const TArray<TArray<FVector2f>> Polygons = {
+			double ExpectedArea = 0.5 * NumSegments * 100.0 * 100.0 * FMath::Sin(2.0 * UE_DOUBLE_PI / NumSegments);
+			for (int32 X = -5; X < 5; ++X)
+			{
+				for (int32 Y = -5; Y < 5; ++Y)
 				{
-					{ 101.985214, 113.8258 },
-					{ -101.985214, 113.8258 },
-					{ -101.985214, -113.8258 },
-					{ 101.985214, -113.8258 },
-				},
-				{ { 18.395055731633885, 9.0596833 }, { -72.518264268366110, 9.0596833 }, { -72.518264268366110, 67.2252527 }, { 18.395055731633885, 67.2252527 } },
-				{ { 18.395055731633885, -53.4203167 }, { -72.518264268366110, -53.4203167 }, { -72.518264268366110, 4.7452569 }, { 18.395055731633885, 4.7452569 } },
-			};
+					if (X * X + Y * Y > 16)
+					{
+						continue;
+					}
+					const FVector2f Offset(X * 12.0f + 1.0f, Y * 12.0f + 1.0f);
+					Polygons.Push({ Offset, Offset + FVector2f(0.0f, 8.0f), Offset + FVector2f(8.0f, 8.0f), Offset + FVector2f(8.0f, 0.0f) });
+					ExpectedArea -= 64.0;
+				}
+			}
 
 			TArray<FVector2D> Vertices;
 			TArray<int32> Indices;
-			MRUKTriangulatePolygon(Polygons, Vertices, Indices);
-
-			TestEqual(TEXT("Correct number of indices"), Indices.Num(), 42);
-			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 35858.143857, 0.001);
+			MRUKTriangulatePolygon(Polygons, Vertices, Indices, EMRUKTriangulationBackend::Native);
+			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), ExpectedArea, 0.1);
 		});
+	});
 
-		It(TEXT("Triangulate LShape"), [this] {
-			const TArray<FVector2f> TestPolygon = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 2.0 }, { 1.0, 2.0 }, { 1.0, 1.0 }, { 0.0, 1.0 } };
-			TArray<FVector2D> Vertices;
-			TArray<int32> Indices;
-			MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices);
+	Describe(TEXT("Triangulation Benchmark"), [this] {
+		SetupMRUKSubsystem();
 
-			TestEqual(TEXT("Correct number of indices"), Indices.Num(), 12);
-			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 3.0);
-		});
+		It(TEXT("Native triangulation matches the shared library on the example room"), [this] {
+			for (const int32 HolesPerAxis : { 0, 2, 8 })
+			{
+				const auto PolygonSets = CollectBenchmarkPolygons(ExampleRoomJson, HolesPerAxis);
+				TestTrue(TEXT("Example room has plane boundaries"), PolygonSets.Num() > 0);
 
-		It(TEXT("Triangulate CShape"), [this] {
-			const TArray<FVector2f> TestPolygon = { { 0.0, 0.0 }, { 2.0, 0.0 }, { 2.0, 1.0 }, { 1.0, 1.0 }, { 1.0, 2.0 }, { 2.0, 2.0 }, { 2.0, 3.0 }, { 0.0, 3.0 } };
-			TArray<FVector2D> Vertices;
-			TArray<int32> Indices;
-			MRUKTriangulatePolygon({ TestPolygon }, Vertices, Indices);
+				constexpr int32 Iterations = 20;
+				double NativeArea = 0.0;
+				const double NativeTime = BenchmarkTriangulation(PolygonSets, EMRUKTriangulationBackend::Native, Iterations, NativeArea);
+				AddInfo(FString::Printf(TEXT("Native triangulation with %d holes: %.2f us per polygon"), HolesPerAxis * HolesPerAxis, NativeTime));
+
+				if (!MRUKIsTriangulationBackendAvailable(EMRUKTriangulationBackend::SharedLibrary))
+				{
+					AddInfo(TEXT("MRUK shared library is not available, skipping comparison"));
+					continue;
+				}
 
-			TestEqual(TEXT("Correct number of indices"), Indices.Num(), 18);
-			TestEqual(TEXT("Correct area triangulated"), CalculateTriangulatedArea(Vertices, Indices), 5.0);
+				double SharedArea = 0.0;
+				const double SharedTime = BenchmarkTriangulation(PolygonSets, EMRUKTriangulationBackend::SharedLibrary, Iterations, SharedArea);
+				AddInfo(FString::Printf(TEXT("Shared library triangulation with %d holes: %.2f us per polygon"), HolesPerAxis * HolesPerAxis, SharedTime));
+				TestEqual(TEXT("Native and shared library triangulate the same area"), NativeArea, SharedArea, 0.01);
+			}
 		});
 
 		TeardownMRUKSubsystem();
@@ -0,0 +1,196 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitSubsystem.h"
+#include "OculusXRRoomLayoutManagerComponent.h"
+#include "ProceduralMeshComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "Editor.h"
+
+namespace
+{
+	constexpr double CollisionTestRoomSize = 4.0;
+	constexpr double CollisionTestRoomHeight = 2.5;
+
+	// Closed box in meters like the global mesh of a room with a bit of noise on the surface, tessellated like a scanned mesh
+	void MakeScannedRoomMesh(double Spacing, int32 Seed, TArray<FVector>& OutVertices, TArray<int32>& OutTriangles)
+	{
+		FRandomStream RandomStream(Seed);
+		const FVector Extent(CollisionTestRoomSize * 0.5, CollisionTestRoomSize * 0.5, CollisionTestRoomHeight * 0.5);
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const int32 U = (Axis + 1) % 3;
+			const int32 V = (Axis + 2) % 3;
+			const int32 NumU = FMath::CeilToInt32(2.0 * Extent[U] / Spacing);
+			const int32 NumV = FMath::CeilToInt32(2.0 * Extent[V] / Spacing);
+			for (const double Side : { -1.0, 1.0 })
+			{
+				const int32 First = OutVertices.Num();
+				for (int32 J = 0; J <= NumV; ++J)
+				{
+					for (int32 I = 0; I <= NumU; ++I)
+					{
+						FVector Vertex;
+						Vertex[Axis] = Side * Extent[Axis] + RandomStream.FRandRange(-0.005, 0.005);
+						Vertex[U] = -Extent[U] + 2.0 * Extent[U] * I / NumU;
+						Vertex[V] = -Extent[V] + 2.0 * Extent[V] * J / NumV;
+						OutVertices.Add(Vertex);
+					}
+				}
+				for (int32 J = 0; J < NumV; ++J)
+				{
+					for (int32 I = 0; I < NumU; ++I)
+					{
+						const int32 Corner = First + J * (NumU + 1) + I;
+						OutTriangles.Append({ Corner, Corner + 1, Corner + NumU + 1, Corner + 1, Corner + NumU + 2, Corner + NumU + 1 });
+					}
+				}
+			}
+		}
+	}
+
+	UProceduralMeshComponent* MakeGlobalMeshComponent(AActor* Owner)
+	{
+		UProceduralMeshComponent* Mesh = NewObject<UProceduralMeshComponent>(Owner);
+		Mesh->SetupAttachment(Owner->GetRootComponent());
+		Mesh->RegisterComponent();
+		Mesh->SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+		// Global meshes are in meters, scale them like UOculusXRSceneGlobalMeshComponent does
+		Mesh->SetRelativeScale3D(FVector(100.0));
+		return Mesh;
+	}
+
+	bool TraceGlobalMesh(UProceduralMeshComponent* Mesh, const FVector& Start, const FVector& End, FHitResult& OutHit)
+	{
+		return Mesh->LineTraceComponent(OutHit, Start, End, FCollisionQueryParams(TEXT("GlobalMeshCollisionTest"), true));
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKGlobalMeshCollisionSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UWorld* World;
+UOculusXRRoomLayoutManagerComponent* RoomLayoutManager;
+AActor* MeshOwner;
+TArray<FVector> Vertices;
+TArray<int32> Triangles;
+END_DEFINE_SPEC(FMRUKGlobalMeshCollisionSpec)
+
+void FMRUKGlobalMeshCollisionSpec::Define()
+{
+	Describe(TEXT("Global mesh collision"), [this] {
+		BeforeEach([this]() {
+			// Load map and start play in editor
+			const auto ContentDir = FPaths::ProjectContentDir();
+			FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+			StartPIE(true);
+		});
+
+		BeforeEach(EAsyncExecution::ThreadPool, []() {
+			while (!GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session starts
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		BeforeEach([this]() {
+			World = GEditor->GetPIEWorldContext()->World();
+			RoomLayoutManager = World->GetGameInstance()->GetSubsystem<UMRUKSubsystem>()->GetRoomLayoutManager();
+			MeshOwner = World->SpawnActor<AActor>();
+			MeshOwner->SetRootComponent(NewObject<USceneComponent>(MeshOwner, TEXT("Root")));
+			MeshOwner->GetRootComponent()->RegisterComponent();
+			Vertices.Reset();
+			Triangles.Reset();
+			MakeScannedRoomMesh(0.05, 5, Vertices, Triangles);
+		});
+
+		It(TEXT("Simplified collision traces like the full mesh"), [this]() {
+			RoomLayoutManager->bAsyncCollisionCooking = false;
+
+			RoomLayoutManager->bSimplifiedCollision = false;
+			UProceduralMeshComponent* Complex = MakeGlobalMeshComponent(MeshOwner);
+			RoomLayoutManager->CreateTriangleMeshSections(Complex, Vertices, Triangles, true);
+
+			RoomLayoutManager->bSimplifiedCollision = true;
+			RoomLayoutManager->SimplifiedCollisionCellSize = 0.2f;
+			UProceduralMeshComponent* Simplified = MakeGlobalMeshComponent(MeshOwner);
+			RoomLayoutManager->CreateTriangleMeshSections(Simplified, Vertices, Triangles, true);
+
+			// The full mesh is still rendered, the collision proxy is not
+			const FProcMeshSection* RenderSection = Simplified->GetProcMeshSection(0);
+			const FProcMeshSection* CollisionSection = Simplified->GetProcMeshSection(1);
+			if (!TestNotNull(TEXT("Render section"), RenderSection) || !TestNotNull(TEXT("Collision section"), CollisionSection))
+			{
+				return;
+			}
+			TestEqual(TEXT("Render section has all triangles"), RenderSection->ProcIndexBuffer.Num(), Triangles.Num());
+			TestFalse(TEXT("Render section has no collision"), RenderSection->bEnableCollision);
+			TestFalse(TEXT("Collision section is hidden"), CollisionSection->bSectionVisible);
+			TestTrue(TEXT("Collision section has a fraction of the triangles"), CollisionSection->ProcIndexBuffer.Num() * 10 < Triangles.Num());
+			AddInfo(FString::Printf(TEXT("Collision reduced from %d to %d triangles"), Triangles.Num() / 3, CollisionSection->ProcIndexBuffer.Num() / 3));
+
+			// Vertices move by at most half a cell diagonal, allow for a bit more since rays can hit at grazing angles
+			const double Tolerance = 100.0 * RoomLayoutManager->SimplifiedCollisionCellSize * 1.5;
+			FRandomStream RandomStream(17);
+			int32 NumComplexHits = 0;
+			int32 NumSimplifiedHits = 0;
+			double MaxError = 0.0;
+			constexpr int32 NumRays = 500;
+			for (int32 I = 0; I < NumRays; ++I)
+			{
+				const FVector Start = MeshOwner->GetActorLocation() + 100.0 * FVector(
+					RandomStream.FRandRange(-1.5, 1.5), RandomStream.FRandRange(-1.5, 1.5), RandomStream.FRandRange(-1.0, 1.0));
+				const FVector End = Start + RandomStream.GetUnitVector() * 1000.0;
+				FHitResult ComplexHit, SimplifiedHit;
+				const bool bComplexHit = TraceGlobalMesh(Complex, Start, End, ComplexHit);
+				const bool bSimplifiedHit = TraceGlobalMesh(Simplified, Start, End, SimplifiedHit);
+				NumComplexHits += bComplexHit ? 1 : 0;
+				NumSimplifiedHits += bSimplifiedHit ? 1 : 0;
+				if (bComplexHit && bSimplifiedHit)
+				{
+					MaxError = FMath::Max(MaxError, FMath::Abs(ComplexHit.Distance - SimplifiedHit.Distance));
+				}
+			}
+			TestEqual(TEXT("All rays hit the full mesh"), NumComplexHits, NumRays);
+			TestEqual(TEXT("All rays hit the simplified mesh"), NumSimplifiedHits, NumRays);
+			TestTrue(FString::Printf(TEXT("Hit distances differ by %f cm at most"), MaxError), MaxError <= Tolerance);
+		});
+
+		LatentIt(TEXT("Async cooking reports when collision is ready"), [this](const FDoneDelegate& Done) {
+			RoomLayoutManager->bAsyncCollisionCooking = true;
+			RoomLayoutManager->bSimplifiedCollision = true;
+			RoomLayoutManager->SimplifiedCollisionCellSize = 0.1f;
+			UProceduralMeshComponent* Mesh = MakeGlobalMeshComponent(MeshOwner);
+
+			const TSharedRef<FDelegateHandle> Handle = MakeShared<FDelegateHandle>();
+			*Handle = RoomLayoutManager->OculusXRTriangleMeshCollisionReadyNative.AddLambda([this, Mesh, Handle, Done](UProceduralMeshComponent* ReadyMesh, bool bSuccess) {
+				if (ReadyMesh != Mesh)
+				{
+					return;
+				}
+				RoomLayoutManager->OculusXRTriangleMeshCollisionReadyNative.Remove(*Handle);
+				TestTrue(TEXT("Collision cooked"), bSuccess);
+				FHitResult Hit;
+				const FVector Start = MeshOwner->GetActorLocation();
+				TestTrue(TEXT("Trace hits the floor"), TraceGlobalMesh(Mesh, Start, Start - FVector(0.0, 0.0, 1000.0), Hit));
+				TestEqual(TEXT("Distance to the floor"), Hit.Distance, static_cast<float>(100.0 * CollisionTestRoomHeight * 0.5), 15.0f);
+				Done.Execute();
+			});
+			RoomLayoutManager->CreateTriangleMeshSections(Mesh, Vertices, Triangles, true);
+		});
+
+		AfterEach(EAsyncExecution::ThreadPool, []() {
+			while (GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session ends
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		AfterEach([]() {
+			// Request end of play session
+			GUnrealEd->RequestEndPlayMap();
+		});
+	});
+}
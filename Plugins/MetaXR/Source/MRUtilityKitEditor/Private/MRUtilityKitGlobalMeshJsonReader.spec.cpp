@@ -0,0 +1,217 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKit.h"
+#include "MRUtilityKitGlobalMeshJsonReader.h"
+#include "MRUtilityKitSceneSnapshot.h"
+#include "MRUtilityKitSerializationHelpers.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "TestHelper.h"
+
+namespace
+{
+	FOculusXRUUID MakeMeshTestUUID(uint8 Index)
+	{
+		FOculusXRUUID UUID;
+		FMemory::Memset(UUID.UUIDBytes, 0x3C, OCULUSXR_UUID_SIZE);
+		UUID.UUIDBytes[0] = Index;
+		return UUID;
+	}
+
+	/**
+	 * Scene with two rooms that both have a global mesh with random triangles. The second room is the bigger one.
+	 */
+	FString MakeGlobalMeshSceneJson(int32 NumTriangles, int32 Seed)
+	{
+		FMRUKSceneSnapshot Scene;
+		MRUKReadSceneJson(ExampleRoomJson, Scene);
+		FRandomStream RandomStream(Seed);
+		for (int32 RoomIndex = 0; RoomIndex < 2; ++RoomIndex)
+		{
+			FMRUKSnapshotRoom& Room = RoomIndex == 0 ? Scene.Rooms[0] : Scene.Rooms.Add_GetRef(Scene.Rooms[0]);
+			Room.UUID = MakeMeshTestUUID(RoomIndex);
+
+			const int32 NumRoomTriangles = RoomIndex == 0 ? NumTriangles / 10 + 1 : NumTriangles;
+			TArray<FVector> Positions;
+			TArray<int32> Indices;
+			Positions.Reserve(NumRoomTriangles / 2 + 3);
+			for (int32 I = 0; I < NumRoomTriangles / 2 + 3; ++I)
+			{
+				Positions.Add(RandomStream.GetUnitVector() * RandomStream.FRandRange(1.0, 500.0));
+			}
+			Indices.Reserve(NumRoomTriangles * 3);
+			for (int32 I = 0; I < NumRoomTriangles * 3; ++I)
+			{
+				Indices.Add(RandomStream.RandHelper(Positions.Num()));
+			}
+
+			FMRUKSnapshotAnchor& Anchor = Room.Anchors.AddDefaulted_GetRef();
+			Anchor.UUID = MakeMeshTestUUID(100 + RoomIndex);
+			Anchor.SemanticClassifications.Add(FMRUKLabels::GlobalMesh);
+			FMRUKSnapshotGlobalMesh& GlobalMesh = Anchor.GlobalMesh.Emplace();
+			GlobalMesh.UUID = Anchor.UUID;
+			GlobalMesh.SetMeshData(MoveTemp(Positions), MoveTemp(Indices));
+		}
+		return MRUKWriteSceneJson(Scene);
+	}
+
+	// Reference implementation that builds the JSON DOM like UMRUKBPLibrary::LoadGlobalMeshFromJsonString() did before
+	bool ReadGlobalMeshWithDom(const FString& JsonString, const FOculusXRUUID& RoomUUID, TArray<FVector>& OutPositions, TArray<int32>& OutIndices)
+	{
+		TSharedPtr<FJsonValue> JsonValue;
+		auto JsonReader = TJsonReaderFactory<>::Create(JsonString);
+		if (!FJsonSerializer::Deserialize(JsonReader, JsonValue))
+		{
+			return false;
+		}
+
+		for (const auto& RoomJson : JsonValue->AsObject()->GetArrayField(TEXT("Rooms")))
+		{
+			auto RoomObject = RoomJson->AsObject();
+			FOculusXRUUID UUID;
+			MRUKDeserialize(*RoomObject->GetField<EJson::None>(TEXT("UUID")), UUID);
+			if (UUID != RoomUUID)
+			{
+				continue;
+			}
+			for (const auto& AnchorJson : RoomObject->GetArrayField(TEXT("Anchors")))
+			{
+				auto AnchorObject = AnchorJson->AsObject();
+				if (AnchorObject->HasField(TEXT("GlobalMesh")))
+				{
+					auto GlobalMeshObject = AnchorObject->GetField<EJson::Object>(TEXT("GlobalMesh"))->AsObject();
+					for (const auto& PositionJson : GlobalMeshObject->GetArrayField(TEXT("Positions")))
+					{
+						MRUKDeserialize(*PositionJson, OutPositions.AddDefaulted_GetRef());
+					}
+					for (const auto& IndexJson : GlobalMeshObject->GetArrayField(TEXT("Indices")))
+					{
+						OutIndices.Add(static_cast<int32>(IndexJson->AsNumber()));
+					}
+					return true;
+				}
+			}
+			break;
+		}
+		return false;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKGlobalMeshJsonReaderSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+void ExpectError(const TCHAR* Json, int64 ExpectedOffset);
+END_DEFINE_SPEC(FMRUKGlobalMeshJsonReaderSpec)
+
+void FMRUKGlobalMeshJsonReaderSpec::ExpectError(const TCHAR* Json, int64 ExpectedOffset)
+{
+	TArray<FVector> Positions;
+	TArray<int32> Indices;
+	FMRUKJsonReadError Error;
+	TestFalse(FString::Printf(TEXT("Read '%s'"), Json), MRUKReadGlobalMeshFromJson(Json, MakeMeshTestUUID(0), Positions, Indices, &Error));
+	TestEqual(FString::Printf(TEXT("Error offset in '%s' (%s)"), Json, *Error.Message), Error.Offset, ExpectedOffset);
+	TestTrue(TEXT("No partial mesh"), Positions.IsEmpty() && Indices.IsEmpty());
+}
+
+void FMRUKGlobalMeshJsonReaderSpec::Define()
+{
+	Describe(TEXT("Global mesh JSON reader"), [this] {
+		It(TEXT("Reads the same mesh as the JSON DOM"), [this] {
+			const FString Json = MakeGlobalMeshSceneJson(1000, 7);
+			for (uint8 RoomIndex = 0; RoomIndex < 2; ++RoomIndex)
+			{
+				TArray<FVector> ExpectedPositions;
+				TArray<int32> ExpectedIndices;
+				TestTrue(TEXT("Read with DOM"), ReadGlobalMeshWithDom(Json, MakeMeshTestUUID(RoomIndex), ExpectedPositions, ExpectedIndices));
+
+				TArray<FVector> Positions;
+				TArray<int32> Indices;
+				TestTrue(TEXT("Read streaming"), MRUKReadGlobalMeshFromJson(Json, MakeMeshTestUUID(RoomIndex), Positions, Indices));
+				// The numbers have to be bit identical to what the JSON DOM parses
+				TestTrue(TEXT("Positions match"), Positions == ExpectedPositions);
+				TestTrue(TEXT("Indices match"), Indices == ExpectedIndices);
+				TestEqual(TEXT("Positions reserved exactly"), Positions.Max(), Positions.Num());
+				TestEqual(TEXT("Indices reserved exactly"), Indices.Max(), Indices.Num());
+
+				const FTCHARToUTF8 Utf8Json(*Json);
+				TArray<FVector> Utf8Positions;
+				TArray<int32> Utf8Indices;
+				TestTrue(TEXT("Read UTF-8"), MRUKReadGlobalMeshFromJson(FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Utf8Json.Get()), Utf8Json.Length()), MakeMeshTestUUID(RoomIndex), Utf8Positions, Utf8Indices));
+				TestTrue(TEXT("UTF-8 positions match"), Utf8Positions == ExpectedPositions);
+				TestTrue(TEXT("UTF-8 indices match"), Utf8Indices == ExpectedIndices);
+			}
+		});
+
+		It(TEXT("Parses numbers like the JSON DOM"), [this] {
+			const TCHAR* Numbers[] = {
+				TEXT("0"), TEXT("-0"), TEXT("1.5"), TEXT("-123.456"), TEXT("1e3"), TEXT("1E-3"), TEXT("2.5e+10"),
+				TEXT("0.1"), TEXT("0.30000000000000004"), TEXT("123456789012345678901234"), TEXT("1.7976931348623157e308"),
+				TEXT("4.9406564584124654e-324"), TEXT("3.14159265358979323846264338327950288"), TEXT("0.000000000000000000000001"),
+			};
+			for (const TCHAR* Number : Numbers)
+			{
+				const FString Json = FString::Printf(TEXT("{\"Rooms\":[{\"UUID\":\"%s\",\"Anchors\":[{\"GlobalMesh\":{\"Positions\":[[%s,%s,%s]],\"Indices\":[]}}]}]}"),
+					*MakeMeshTestUUID(0).ToString(), Number, Number, Number);
+				TArray<FVector> ExpectedPositions;
+				TArray<int32> ExpectedIndices;
+				ReadGlobalMeshWithDom(Json, MakeMeshTestUUID(0), ExpectedPositions, ExpectedIndices);
+
+				TArray<FVector> Positions;
+				TArray<int32> Indices;
+				TestTrue(FString::Printf(TEXT("Read %s"), Number), MRUKReadGlobalMeshFromJson(Json, MakeMeshTestUUID(0), Positions, Indices));
+				TestTrue(FString::Printf(TEXT("Number %s matches"), Number), Positions == ExpectedPositions);
+			}
+		});
+
+		It(TEXT("Reports malformed JSON with offsets"), [this] {
+			ExpectError(TEXT(""), 0);
+			ExpectError(TEXT("[]"), 0);
+			ExpectError(TEXT("{\"Rooms\":[{\"UUID\" \"\"}]}"), 18);
+			ExpectError(TEXT("{\"Rooms\":[{\"Anchors\":[{\"GlobalMesh\":{\"Positions\":[[1,2]]}}]}]}"), 55);
+			ExpectError(TEXT("{\"Rooms\":[{\"Anchors\":[{\"GlobalMesh\":{\"Positions\":[[1,2,3,4]]}}]}]}"), 57);
+			ExpectError(TEXT("{\"Rooms\":[{\"Anchors\":[{\"GlobalMesh\":{\"Indices\":[1,x]}}]}]}"), 50);
+			ExpectError(TEXT("{\"Rooms\":[{\"Anchors\":[{\"GlobalMesh\":{\"Indices\":[1,2"), 51);
+			ExpectError(TEXT("{\"Rooms\":[{\"Other\":[1.,2]}]}"), 22);
+			ExpectError(TEXT("{\"Rooms\":[{\"Other\":tru}]}"), 22);
+			ExpectError(TEXT("{\"Rooms\":[]} x"), 13);
+
+			// Well formed but without the room
+			ExpectError(TEXT("{\"Rooms\":[]}"), INDEX_NONE);
+			ExpectError(*MakeGlobalMeshSceneJson(10, 1).Replace(*MakeMeshTestUUID(0).ToString(), TEXT("00")), INDEX_NONE);
+		});
+
+		It(TEXT("Finds the mesh if the room UUID comes after the anchors"), [this] {
+			const FString Json = FString::Printf(TEXT("{\"Rooms\":[{\"Anchors\":[{\"GlobalMesh\":{\"Positions\":[[1,2,3]],\"Indices\":[0,0,0]}}],\"UUID\":\"%s\"},")
+												 TEXT("{\"Anchors\":[{\"GlobalMesh\":{\"Positions\":[[4,5,6]],\"Indices\":[0]}}],\"UUID\":\"%s\"}]}"),
+				*MakeMeshTestUUID(1).ToString(), *MakeMeshTestUUID(0).ToString());
+			TArray<FVector> Positions;
+			TArray<int32> Indices;
+			TestTrue(TEXT("Read"), MRUKReadGlobalMeshFromJson(Json, MakeMeshTestUUID(0), Positions, Indices));
+			TestTrue(TEXT("Positions of the right room"), Positions == TArray<FVector>{ FVector(4.0, 5.0, 6.0) });
+			TestEqual(TEXT("Indices of the right room"), Indices.Num(), 1);
+		});
+
+		It(TEXT("Matches the JSON DOM on a large mesh and reports timings"), [this] {
+			constexpr int32 NumTriangles = 200000;
+			const FString Json = MakeGlobalMeshSceneJson(NumTriangles, 3);
+			const FOculusXRUUID RoomUUID = MakeMeshTestUUID(1);
+
+			TArray<FVector> ExpectedPositions;
+			TArray<int32> ExpectedIndices;
+			double StartTime = FPlatformTime::Seconds();
+			ReadGlobalMeshWithDom(Json, RoomUUID, ExpectedPositions, ExpectedIndices);
+			const double DomSeconds = FPlatformTime::Seconds() - StartTime;
+
+			TArray<FVector> Positions;
+			TArray<int32> Indices;
+			StartTime = FPlatformTime::Seconds();
+			TestTrue(TEXT("Read streaming"), MRUKReadGlobalMeshFromJson(Json, RoomUUID, Positions, Indices));
+			const double StreamingSeconds = FPlatformTime::Seconds() - StartTime;
+			// The streaming reader holds nothing but the output arrays
+			const int64 StreamingBytes = Positions.GetAllocatedSize() + Indices.GetAllocatedSize();
+
+			TestTrue(TEXT("Mesh matches"), Positions == ExpectedPositions && Indices == ExpectedIndices);
+			AddInfo(FString::Printf(TEXT("%d triangles, %d characters: DOM %.1f ms, streaming %.1f ms with %lld KB of output"),
+				NumTriangles, Json.Len(), DomSeconds * 1000.0, StreamingSeconds * 1000.0, StreamingBytes / 1024));
+		});
+	});
+}
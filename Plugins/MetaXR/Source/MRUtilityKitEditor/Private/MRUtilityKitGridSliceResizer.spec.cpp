@@ -9,6 +9,43 @@
 #include "Editor/UnrealEdEngine.h"
 #include "Editor.h"
 
+namespace
+{
+	// Compares the fields that the grid slice resizer fills in bit by bit. The vertices have padding, so they can't be compared as a whole.
+	bool GridSliceSectionsAreIdentical(const FProcMeshSection& A, const FProcMeshSection& B)
+	{
+		if (A.ProcVertexBuffer.Num() != B.ProcVertexBuffer.Num() || A.ProcIndexBuffer.Num() != B.ProcIndexBuffer.Num())
+		{
+			return false;
+		}
+		for (int32 I = 0; I < A.ProcVertexBuffer.Num(); ++I)
+		{
+			const FProcMeshVertex& VertexA = A.ProcVertexBuffer[I];
+			const FProcMeshVertex& VertexB = B.ProcVertexBuffer[I];
+			if (FMemory::Memcmp(&VertexA.Position, &VertexB.Position, sizeof(FVector)) != 0
+				|| FMemory::Memcmp(&VertexA.Normal, &VertexB.Normal, sizeof(FVector)) != 0
+				|| FMemory::Memcmp(&VertexA.UV0, &VertexB.UV0, sizeof(FVector2D)) != 0
+				|| VertexA.Color != VertexB.Color)
+			{
+				return false;
+			}
+		}
+		return FMemory::Memcmp(A.ProcIndexBuffer.GetData(), B.ProcIndexBuffer.GetData(), A.ProcIndexBuffer.Num() * sizeof(uint32)) == 0;
+	}
+
+	void SetupGridSliceResizer(UMRUKGridSliceResizerComponent* ResizerComponent)
+	{
+		ResizerComponent->ScaleCenterMode = (uint8)EMRUKScaleCenterMode::XAxis | (uint8)EMRUKScaleCenterMode::YAxis | (uint8)EMRUKScaleCenterMode::ZAxis;
+		ResizerComponent->BorderXNegative = 0.8;
+		ResizerComponent->BorderXPositive = 0.8;
+		ResizerComponent->BorderYNegative = 0.8;
+		ResizerComponent->BorderYPositive = 0.8;
+		ResizerComponent->BorderZNegative = 0.8;
+		ResizerComponent->BorderZPositive = 0.8;
+		ResizerComponent->SlicerPivotOffset = FVector(0.0, 0.0, -40.0);
+	}
+} // namespace
+
 BEGIN_DEFINE_SPEC(FMRUKGridSliceResizerSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
 END_DEFINE_SPEC(FMRUKGridSliceResizerSpec)
 
@@ -171,6 +208,117 @@ void FMRUKGridSliceResizerSpec::Define()
 			}
 		});
 
+		It(TEXT("Cached slices are identical to computed slices"), [this] {
+			const auto World = GEditor->GetPIEWorldContext()->World();
+			const FActorSpawnParameters Params{};
+			AMeshResizer* First = World->SpawnActor<AMeshResizer>(Params);
+			AMeshResizer* Second = World->SpawnActor<AMeshResizer>(Params);
+			SetupGridSliceResizer(First->GridSliceResizerComponent);
+			SetupGridSliceResizer(Second->GridSliceResizerComponent);
+			FMRUKGridSliceCache& Cache = FMRUKGridSliceCache::Get();
+
+			for (const FVector& Scale : { FVector(2.0, 1.0, 0.5), FVector(0.2, 0.2, 0.2), FVector(3.0, 3.0, 1.0) })
+			{
+				Cache.Reset();
+
+				// The first component computes the slice, the second one gets it from the cache
+				First->SetActorScale3D(Scale);
+				First->GridSliceResizerComponent->SliceMesh();
+				Second->SetActorScale3D(Scale);
+				Second->GridSliceResizerComponent->SliceMesh();
+				TestEqual(TEXT("Slice has been computed once"), Cache.GetStats().Misses, 1);
+				TestEqual(TEXT("Slice has been shared"), Cache.GetStats().Hits, 1);
+
+				const FProcMeshSection* Computed = First->GridSliceResizerComponent->ProcMesh->GetProcMeshSection(0);
+				const FProcMeshSection* Cached = Second->GridSliceResizerComponent->ProcMesh->GetProcMeshSection(0);
+				if (TestNotNull(TEXT("Computed section"), Computed) && TestNotNull(TEXT("Cached section"), Cached))
+				{
+					TestTrue(FString::Printf(TEXT("Sections are identical with scale %s"), *Scale.ToString()), GridSliceSectionsAreIdentical(*Computed, *Cached));
+				}
+			}
+		});
+
+		It(TEXT("Static actors are not sliced again"), [this] {
+			const auto World = GEditor->GetPIEWorldContext()->World();
+			const FActorSpawnParameters Params{};
+			AMeshResizer* Resizer = World->SpawnActor<AMeshResizer>(Params);
+			UMRUKGridSliceResizerComponent* ResizerComponent = Resizer->GridSliceResizerComponent;
+			SetupGridSliceResizer(ResizerComponent);
+			FMRUKGridSliceCache& Cache = FMRUKGridSliceCache::Get();
+			Cache.Reset();
+
+			Resizer->SetActorScale3D(FVector(2.0, 1.5, 1.0));
+			double StartTime = FPlatformTime::Seconds();
+			ResizerComponent->TickComponent(0.016f, LEVELTICK_All, &ResizerComponent->PrimaryComponentTick);
+			const double SliceSeconds = FPlatformTime::Seconds() - StartTime;
+
+			const int32 Updates = ResizerComponent->MeshSectionUpdates;
+			const int32 Lookups = Cache.GetStats().Hits + Cache.GetStats().Misses;
+			constexpr int32 NumFrames = 1000;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 I = 0; I < NumFrames; ++I)
+			{
+				ResizerComponent->TickComponent(0.016f, LEVELTICK_All, &ResizerComponent->PrimaryComponentTick);
+			}
+			const double TickSeconds = FPlatformTime::Seconds() - StartTime;
+
+			// Registering the component again or changing unrelated properties in the editor slices the mesh explicitly
+			StartTime = FPlatformTime::Seconds();
+			for (int32 I = 0; I < NumFrames; ++I)
+			{
+				ResizerComponent->SliceMesh();
+			}
+			const double SliceAgainSeconds = FPlatformTime::Seconds() - StartTime;
+
+			TestEqual(TEXT("Mesh section has not been updated"), ResizerComponent->MeshSectionUpdates, Updates);
+			TestEqual(TEXT("Cache has not been queried"), Cache.GetStats().Hits + Cache.GetStats().Misses, Lookups);
+			AddInfo(FString::Printf(TEXT("Grid slice: first slice %.3f ms, per frame when static: tick %.5f ms, SliceMesh() %.5f ms"),
+				SliceSeconds * 1000.0, TickSeconds * 1000.0 / NumFrames, SliceAgainSeconds * 1000.0 / NumFrames));
+
+			Resizer->SetActorScale3D(FVector(2.0, 2.0, 1.0));
+			ResizerComponent->TickComponent(0.016f, LEVELTICK_All, &ResizerComponent->PrimaryComponentTick);
+			TestEqual(TEXT("Scaling updates the mesh section"), ResizerComponent->MeshSectionUpdates, Updates + 1);
+		});
+
+		It(TEXT("Cache stays within its memory budget"), [this] {
+			const auto World = GEditor->GetPIEWorldContext()->World();
+			const FActorSpawnParameters Params{};
+			AMeshResizer* Resizer = World->SpawnActor<AMeshResizer>(Params);
+			UMRUKGridSliceResizerComponent* ResizerComponent = Resizer->GridSliceResizerComponent;
+			SetupGridSliceResizer(ResizerComponent);
+			FMRUKGridSliceCache& Cache = FMRUKGridSliceCache::Get();
+			Cache.Reset();
+			const SIZE_T PreviousMaxBytes = Cache.GetMaxBytes();
+
+			ResizerComponent->SliceMesh();
+			const FProcMeshSection* Section = ResizerComponent->ProcMesh->GetProcMeshSection(0);
+			if (!TestNotNull(TEXT("Mesh section"), Section))
+			{
+				return;
+			}
+
+			// Room for the mesh data and three slices
+			const SIZE_T SliceBytes = 3 * Section->ProcVertexBuffer.Num() * sizeof(double);
+			Cache.SetMaxBytes(Cache.GetAllocatedBytes() + 3 * SliceBytes);
+			for (int32 I = 1; I <= 20; ++I)
+			{
+				Resizer->SetActorScale3D(FVector(1.0 + I * 0.1));
+				ResizerComponent->SliceMesh();
+				TestTrue(TEXT("Cache is within its budget"), Cache.GetAllocatedBytes() <= Cache.GetMaxBytes());
+			}
+			TestTrue(TEXT("Least recently used slices have been evicted"), Cache.GetStats().Evictions > 0);
+
+			// The last slice is still cached
+			AMeshResizer* Other = World->SpawnActor<AMeshResizer>(Params);
+			SetupGridSliceResizer(Other->GridSliceResizerComponent);
+			Other->SetActorScale3D(Resizer->GetActorScale3D());
+			const int32 Hits = Cache.GetStats().Hits;
+			Other->GridSliceResizerComponent->SliceMesh();
+			TestEqual(TEXT("Most recently used slice is still cached"), Cache.GetStats().Hits, Hits + 1);
+
+			Cache.SetMaxBytes(PreviousMaxBytes);
+		});
+
 		// Caution: Order of these statements is important
 
 		AfterEach(EAsyncExecution::ThreadPool, []() {
@@ -0,0 +1,153 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitGuardianSpawner.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitSubsystem.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "TestHelper.h"
+#include "Editor.h"
+
+BEGIN_DEFINE_SPEC(FMRUKGuardianSpawnerSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UWorld* World;
+UMRUKSubsystem* ToolkitSubsystem;
+AMRUKGuardianSpawner* Spawner;
+
+void CompareFadeWithExactQuery(AMRUKRoom* Room, int32 NumQueries, int32 Seed);
+END_DEFINE_SPEC(FMRUKGuardianSpawnerSpec)
+
+void FMRUKGuardianSpawnerSpec::CompareFadeWithExactQuery(AMRUKRoom* Room, int32 NumQueries, int32 Seed)
+{
+	FRandomStream RandomStream(Seed);
+	TArray<FVector> Positions;
+	Positions.Reserve(NumQueries);
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		Positions.Add(RandomStream.RandPointInBox(Room->RoomBounds));
+	}
+
+	// The first lookup builds the volume in case it doesn't exist yet or is out of date
+	Spawner->UseDistanceVolume = true;
+	double StartTime = FPlatformTime::Seconds();
+	Spawner->ComputeGuardianFade(Room, Positions[0]);
+	const double BuildSeconds = FPlatformTime::Seconds() - StartTime;
+	if (!TestTrue(TEXT("Distance volume has been built"), Spawner->DistanceVolume.IsValid()))
+	{
+		return;
+	}
+
+	TArray<double> VolumeFades;
+	VolumeFades.SetNumUninitialized(NumQueries);
+	StartTime = FPlatformTime::Seconds();
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		VolumeFades[I] = Spawner->ComputeGuardianFade(Room, Positions[I]);
+	}
+	const double VolumeSeconds = FPlatformTime::Seconds() - StartTime;
+
+	Spawner->UseDistanceVolume = false;
+	TArray<double> ExactFades;
+	ExactFades.SetNumUninitialized(NumQueries);
+	StartTime = FPlatformTime::Seconds();
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		ExactFades[I] = Spawner->ComputeGuardianFade(Room, Positions[I]);
+	}
+	const double ExactSeconds = FPlatformTime::Seconds() - StartTime;
+
+	// The fade changes by one over the guardian distance, so the error of the distance carries over scaled by that
+	const double Tolerance = Spawner->DistanceVolume.GetMaxError() / (Spawner->GuardianDistance * World->GetWorldSettings()->WorldToMeters) + UE_KINDA_SMALL_NUMBER;
+	double MaxError = 0.0;
+	int32 NumFading = 0;
+	for (int32 I = 0; I < NumQueries; ++I)
+	{
+		MaxError = FMath::Max(MaxError, FMath::Abs(VolumeFades[I] - ExactFades[I]));
+		NumFading += ExactFades[I] > 0.0 ? 1 : 0;
+	}
+	TestTrue(TEXT("Some positions are close enough to a surface for the guardian to fade in"), NumFading > 0);
+	TestTrue(FString::Printf(TEXT("Fade differs by %f at most, tolerance is %f"), MaxError, Tolerance), MaxError <= Tolerance);
+	AddInfo(FString::Printf(TEXT("Guardian fade %d anchors: volume with %d samples built in %.3f ms, per tick exact %.4f ms, volume %.4f ms"),
+		Room->AllAnchors.Num(), Spawner->DistanceVolume.GetResolution().X * Spawner->DistanceVolume.GetResolution().Y * Spawner->DistanceVolume.GetResolution().Z,
+		BuildSeconds * 1000.0, ExactSeconds * 1000.0 / NumQueries, VolumeSeconds * 1000.0 / NumQueries));
+}
+
+void FMRUKGuardianSpawnerSpec::Define()
+{
+	Describe(TEXT("Guardian spawner"), [this] {
+		BeforeEach([this]() {
+			// Load map and start play in editor
+			const auto ContentDir = FPaths::ProjectContentDir();
+			FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+			StartPIE(true);
+		});
+
+		BeforeEach(EAsyncExecution::ThreadPool, []() {
+			while (!GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session starts
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		BeforeEach([this]() {
+			World = GEditor->GetPIEWorldContext()->World();
+			ToolkitSubsystem = World->GetGameInstance()->GetSubsystem<UMRUKSubsystem>();
+
+			Spawner = World->SpawnActorDeferred<AMRUKGuardianSpawner>(AMRUKGuardianSpawner::StaticClass(), FTransform::Identity);
+			Spawner->SpawnMode = EMRUKSpawnMode::None;
+			Spawner->UseDistanceVolume = true;
+			Spawner->FinishSpawning(FTransform::Identity);
+		});
+
+		It(TEXT("Distance volume fade matches the exact query in example room"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(ExampleRoomJson);
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+			if (TestNotNull(TEXT("Room"), Room))
+			{
+				CompareFadeWithExactQuery(Room, 1000, 7);
+			}
+		});
+
+		It(TEXT("Distance volume fade matches the exact query with 500 anchors"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(MakeSyntheticRoomJson(500, 3));
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+			if (TestNotNull(TEXT("Room"), Room))
+			{
+				CompareFadeWithExactQuery(Room, 1000, 11);
+			}
+		});
+
+		It(TEXT("Distance volume follows the room"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(ExampleRoomJson);
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Room"), Room))
+			{
+				return;
+			}
+			Room->SetActorLocationAndRotation(FVector(100.0, -50.0, 20.0), FRotator(0.0, 35.0, 0.0));
+			CompareFadeWithExactQuery(Room, 200, 13);
+
+			// Updating the room in place with different anchors
+			ToolkitSubsystem->LoadSceneFromJsonString(ExampleRoomFurnitureAddedJson);
+			TestTrue(TEXT("Room was updated in place"), ToolkitSubsystem->GetCurrentRoom() == Room);
+			TestFalse(TEXT("Room update throws the distance volume away"), Spawner->DistanceVolume.IsValid());
+			CompareFadeWithExactQuery(Room, 200, 17);
+		});
+
+		AfterEach(EAsyncExecution::ThreadPool, []() {
+			while (GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session ends
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		AfterEach([]() {
+			// Request end of play session
+			GUnrealEd->RequestEndPlayMap();
+		});
+	});
+}
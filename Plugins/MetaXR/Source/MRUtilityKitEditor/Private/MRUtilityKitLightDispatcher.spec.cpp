@@ -0,0 +1,103 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitLightDispatcher.h"
+#include "Components/PointLightComponent.h"
+#include "Engine/PointLight.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "Editor.h"
+
+BEGIN_DEFINE_SPEC(FMRUKLightDispatcherSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UWorld* World;
+END_DEFINE_SPEC(FMRUKLightDispatcherSpec)
+
+void FMRUKLightDispatcherSpec::Define()
+{
+	Describe(TEXT("Light dispatcher"), [this] {
+		BeforeEach([this]() {
+			// Load map and start play in editor
+			const auto ContentDir = FPaths::ProjectContentDir();
+			FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+			StartPIE(true);
+		});
+
+		BeforeEach(EAsyncExecution::ThreadPool, []() {
+			while (!GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session starts
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		BeforeEach([this]() {
+			World = GEditor->GetPIEWorldContext()->World();
+		});
+
+		It(TEXT("Only writes parameters of lights that changed"), [this]() {
+			APointLight* FirstLight = World->SpawnActor<APointLight>(FVector(100.0, 0.0, 100.0), FRotator::ZeroRotator);
+			APointLight* SecondLight = World->SpawnActor<APointLight>(FVector(-100.0, 0.0, 100.0), FRotator::ZeroRotator);
+
+			AMRUKLightDispatcher* Dispatcher = World->SpawnActorDeferred<AMRUKLightDispatcher>(AMRUKLightDispatcher::StaticClass(), FTransform::Identity);
+			Dispatcher->ShouldFetchPointLightsAtBeginPlay = false;
+			Dispatcher->ManualPointLights = { FirstLight, SecondLight };
+			Dispatcher->SetActorTickEnabled(false);
+			Dispatcher->FinishSpawning(FTransform::Identity);
+			if (!Dispatcher->Collection)
+			{
+				AddWarning(TEXT("Material parameter collection /OculusXR/Materials/MPC_Highlights is not available"));
+				return;
+			}
+			if (!TestTrue(TEXT("Collection has room for two lights"), Dispatcher->Collection->VectorParameters.Num() >= 6))
+			{
+				return;
+			}
+
+			Dispatcher->FillParameterCollection();
+			TestEqual(TEXT("First fill applies"), Dispatcher->AppliedCollectionUpdates, 1);
+			// Three vectors per light and the number of lights
+			TestEqual(TEXT("First fill writes everything"), Dispatcher->ParameterWrites, 7);
+			TestTrue(TEXT("Position of first light"), Dispatcher->Collection->VectorParameters[0].DefaultValue.Equals(FLinearColor(FirstLight->GetActorLocation())));
+			TestEqual(TEXT("Name of second light color"), Dispatcher->Collection->VectorParameters[5].ParameterName, FName(TEXT("PointLightColor1")));
+
+			// Nothing moves
+			for (int32 i = 0; i < 10; ++i)
+			{
+				Dispatcher->FillParameterCollection();
+			}
+			TestEqual(TEXT("Static scene applies nothing"), Dispatcher->AppliedCollectionUpdates, 1);
+			TestEqual(TEXT("Static scene skips every update"), Dispatcher->SkippedCollectionUpdates, 10);
+			TestEqual(TEXT("Static scene writes nothing"), Dispatcher->ParameterWrites, 7);
+
+			FirstLight->SetActorLocation(FVector(100.0, 50.0, 100.0));
+			Dispatcher->FillParameterCollection();
+			TestEqual(TEXT("Moved light applies"), Dispatcher->AppliedCollectionUpdates, 2);
+			TestEqual(TEXT("Moved light writes its position"), Dispatcher->ParameterWrites, 8);
+			TestTrue(TEXT("Position of moved light"), Dispatcher->Collection->VectorParameters[0].DefaultValue.Equals(FLinearColor(FirstLight->GetActorLocation())));
+
+			SecondLight->PointLightComponent->SetLightColor(FLinearColor::Red);
+			SecondLight->PointLightComponent->SetAttenuationRadius(321.0f);
+			Dispatcher->FillParameterCollection();
+			TestEqual(TEXT("Changed light applies once"), Dispatcher->AppliedCollectionUpdates, 3);
+			TestEqual(TEXT("Changed light writes its data and color"), Dispatcher->ParameterWrites, 10);
+			TestEqual(TEXT("Radius of changed light"), Dispatcher->Collection->VectorParameters[4].DefaultValue.R, 1.0f / 321.0f);
+
+			Dispatcher->FillParameterCollection();
+			TestEqual(TEXT("Static again"), Dispatcher->ParameterWrites, 10);
+		});
+
+		AfterEach(EAsyncExecution::ThreadPool, []() {
+			while (GEditor->IsPlayingSessionInEditor())
+			{
+				// Wait until play session ends
+				FGenericPlatformProcess::Yield();
+			}
+		});
+
+		AfterEach([]() {
+			// Request end of play session
+			GUnrealEd->RequestEndPlayMap();
+		});
+	});
+}
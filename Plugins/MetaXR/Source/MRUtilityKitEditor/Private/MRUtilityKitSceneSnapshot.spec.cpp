@@ -0,0 +1,308 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "MRUtilityKitAnchor.h"
+#include "MRUtilityKitRoom.h"
+#include "MRUtilityKitSceneSnapshot.h"
+#include "MRUtilityKitSubsystem.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "HAL/FileManager.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Editor/UnrealEdEngine.h"
+#include "UnrealEdGlobals.h"
+#include "TestHelper.h"
+#include "Editor.h"
+
+namespace
+{
+	FOculusXRUUID MakeUUID(uint8 Index)
+	{
+		FOculusXRUUID UUID;
+		FMemory::Memset(UUID.UUIDBytes, 0x6B, OCULUSXR_UUID_SIZE);
+		UUID.UUIDBytes[0] = Index;
+		return UUID;
+	}
+
+	FMRUKSnapshotGlobalMesh MakeGlobalMesh(const FOculusXRUUID& UUID, int32 NumTriangles)
+	{
+		TArray<FVector> Positions;
+		TArray<int32> Indices;
+		for (int32 I = 0; I < NumTriangles; ++I)
+		{
+			const FVector Offset(I * 10.0, 0.0, 0.0);
+			Indices.Add(Positions.Add(Offset));
+			Indices.Add(Positions.Add(Offset + FVector(0.0, 10.0, 0.0)));
+			Indices.Add(Positions.Add(Offset + FVector(0.0, 0.0, 10.0)));
+		}
+		FMRUKSnapshotGlobalMesh GlobalMesh;
+		GlobalMesh.UUID = UUID;
+		GlobalMesh.SetMeshData(MoveTemp(Positions), MoveTemp(Indices));
+		return GlobalMesh;
+	}
+
+	FMRUKSnapshotAnchor MakeGlobalMeshAnchor(uint8 Index, int32 NumTriangles)
+	{
+		FMRUKSnapshotAnchor Anchor;
+		Anchor.UUID = MakeUUID(Index);
+		Anchor.SemanticClassifications.Add(FMRUKLabels::GlobalMesh);
+		Anchor.GlobalMesh = MakeGlobalMesh(Anchor.UUID, NumTriangles);
+		return Anchor;
+	}
+
+	const TArray<const TCHAR*>& GetExampleScenes()
+	{
+		static const TArray<const TCHAR*> Scenes = {
+			ExampleRoomJson,
+			ExampleRoomFurnitureAddedJson,
+			ExampleRoomMoreFurnitureAddedJson,
+			ExampleRoomFurnitureModifiedJson,
+			ExampleOtherRoomJson,
+		};
+		return Scenes;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FMRUKSceneSnapshotSpec, TEXT("MR Utility Kit"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UMRUKSubsystem* ToolkitSubsystem;
+
+void SetupMRUKSubsystem();
+void TeardownMRUKSubsystem();
+END_DEFINE_SPEC(FMRUKSceneSnapshotSpec)
+
+void FMRUKSceneSnapshotSpec::SetupMRUKSubsystem()
+{
+	BeforeEach([this]() {
+		// Load map and start play in editor
+		const auto ContentDir = FPaths::ProjectContentDir();
+		FAutomationEditorCommonUtils::LoadMap(ContentDir + "/Common/Maps/TestLevel.umap");
+		StartPIE(true);
+	});
+
+	BeforeEach(EAsyncExecution::ThreadPool, []() {
+		while (!GEditor->IsPlayingSessionInEditor())
+		{
+			// Wait until play session starts
+			FGenericPlatformProcess::Yield();
+		}
+	});
+
+	BeforeEach([this]() {
+		// Get a reference to the subsystem
+		const auto World = GEditor->GetPIEWorldContext()->World();
+		const auto GameInstance = World->GetGameInstance();
+		ToolkitSubsystem = GameInstance->GetSubsystem<UMRUKSubsystem>();
+	});
+}
+
+void FMRUKSceneSnapshotSpec::TeardownMRUKSubsystem()
+{
+	// Caution: Order of these statements is important
+
+	AfterEach(EAsyncExecution::ThreadPool, []() {
+		while (GEditor->IsPlayingSessionInEditor())
+		{
+			// Wait until play session ends
+			FGenericPlatformProcess::Yield();
+		}
+	});
+
+	AfterEach([]() {
+		// Request end of play session
+		GUnrealEd->RequestEndPlayMap();
+	});
+}
+
+void FMRUKSceneSnapshotSpec::Define()
+{
+	Describe(TEXT("Scene snapshot format"), [this] {
+		It(TEXT("Converts losslessly between JSON and snapshot"), [this] {
+			for (const TCHAR* SceneJson : GetExampleScenes())
+			{
+				TArray<uint8> Snapshot;
+				TestTrue(TEXT("JSON to snapshot"), MRUKConvertSceneJsonToSnapshot(SceneJson, Snapshot));
+
+				FString Json;
+				TestTrue(TEXT("Snapshot to JSON"), MRUKConvertSceneSnapshotToJson(Snapshot, Json));
+
+				TArray<uint8> SecondSnapshot;
+				TestTrue(TEXT("JSON to snapshot again"), MRUKConvertSceneJsonToSnapshot(Json, SecondSnapshot));
+				TestTrue(TEXT("Snapshots are identical"), Snapshot == SecondSnapshot);
+
+				FString SecondJson;
+				MRUKConvertSceneSnapshotToJson(SecondSnapshot, SecondJson);
+				TestEqual(TEXT("JSON is identical"), SecondJson, Json);
+			}
+		});
+
+		It(TEXT("References the global mesh without copying"), [this] {
+			FMRUKSceneSnapshot Scene;
+			FMRUKSnapshotRoom& Room = Scene.Rooms.AddDefaulted_GetRef();
+			Room.UUID = MakeUUID(0);
+			Room.Anchors.Add(MakeGlobalMeshAnchor(1, 100));
+			// Anchors after the global mesh need to be read correctly as well
+			Room.Anchors.Add(MakeGlobalMeshAnchor(2, 1));
+
+			TArray<uint8> Snapshot;
+			MRUKWriteSceneSnapshot(Scene, Snapshot);
+
+			FMRUKSceneSnapshot ReadScene;
+			if (!TestTrue(TEXT("Read snapshot"), MRUKReadSceneSnapshot(Snapshot, ReadScene)))
+			{
+				return;
+			}
+			TestEqual(TEXT("Number of anchors"), ReadScene.Rooms[0].Anchors.Num(), 2);
+			for (int32 I = 0; I < 2; ++I)
+			{
+				const FMRUKSnapshotGlobalMesh& Expected = Room.Anchors[I].GlobalMesh.GetValue();
+				const FMRUKSnapshotGlobalMesh& Actual = ReadScene.Rooms[0].Anchors[I].GlobalMesh.GetValue();
+				TestTrue(TEXT("Positions match"), TArray<FVector>(Actual.GetPositions()) == TArray<FVector>(Expected.GetPositions()));
+				TestTrue(TEXT("Indices match"), TArray<int32>(Actual.GetIndices()) == TArray<int32>(Expected.GetIndices()));
+
+				const uint8* Positions = reinterpret_cast<const uint8*>(Actual.GetPositions().GetData());
+				TestTrue(TEXT("Positions point into the snapshot"), Positions >= Snapshot.GetData() && Positions < Snapshot.GetData() + Snapshot.Num());
+			}
+		});
+
+		It(TEXT("Rejects corrupt snapshots"), [this] {
+			TArray<uint8> Snapshot;
+			MRUKConvertSceneJsonToSnapshot(ExampleRoomJson, Snapshot);
+			FMRUKSceneSnapshot Scene;
+
+			AddExpectedError(TEXT("MRUK scene snapshot"), EAutomationExpectedErrorFlags::Contains, 0);
+
+			// Every truncation has to be detected
+			for (int32 Num = 0; Num < Snapshot.Num(); Num += 7)
+			{
+				TestFalse(FString::Printf(TEXT("Truncated to %d bytes"), Num), MRUKReadSceneSnapshot(TConstArrayView<uint8>(Snapshot.GetData(), Num), Scene));
+			}
+
+			TArray<uint8> BadMagic = Snapshot;
+			BadMagic[0] = 'X';
+			TestFalse(TEXT("Wrong magic"), MRUKReadSceneSnapshot(BadMagic, Scene));
+
+			TArray<uint8> BadVersion = Snapshot;
+			BadVersion[4] = FMRUKSceneSnapshot::CurrentVersion + 1;
+			TestFalse(TEXT("Unsupported version"), MRUKReadSceneSnapshot(BadVersion, Scene));
+
+			TArray<uint8> BadCount = Snapshot;
+			// Number of rooms
+			BadCount[12] = 0xFF;
+			BadCount[13] = 0xFF;
+			TestFalse(TEXT("Corrupt room count"), MRUKReadSceneSnapshot(BadCount, Scene));
+			TestTrue(TEXT("No rooms on failure"), Scene.Rooms.IsEmpty());
+		});
+	});
+
+	Describe(TEXT("Scene snapshot loading"), [this] {
+		SetupMRUKSubsystem();
+
+		It(TEXT("Loads the same scene as JSON"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(ExampleRoomJson);
+			const FString ExpectedJson = ToolkitSubsystem->SaveSceneToJsonString();
+			const TArray<uint8> Snapshot = ToolkitSubsystem->SaveSceneToSnapshot();
+
+			ToolkitSubsystem->ClearScene();
+			ToolkitSubsystem->LoadSceneFromSnapshot(Snapshot);
+			TestEqual(TEXT("Number of rooms"), ToolkitSubsystem->Rooms.Num(), 1);
+			TestEqual(TEXT("Serialized scene"), ToolkitSubsystem->SaveSceneToJsonString(), ExpectedJson);
+			TestTrue(TEXT("Serialized snapshot"), ToolkitSubsystem->SaveSceneToSnapshot() == Snapshot);
+		});
+
+		It(TEXT("Updates an existing scene"), [this] {
+			ToolkitSubsystem->LoadSceneFromJsonString(ExampleRoomJson);
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+
+			TArray<uint8> Snapshot;
+			MRUKConvertSceneJsonToSnapshot(ExampleRoomFurnitureAddedJson, Snapshot);
+			ToolkitSubsystem->LoadSceneFromSnapshot(Snapshot);
+			TestTrue(TEXT("Room was updated in place"), ToolkitSubsystem->GetCurrentRoom() == Room);
+
+			TArray<uint8> ExpectedSnapshot;
+			MRUKConvertSceneJsonToSnapshot(ToolkitSubsystem->SaveSceneToJsonString(), ExpectedSnapshot);
+			TestTrue(TEXT("Scene matches"), ToolkitSubsystem->SaveSceneToSnapshot() == ExpectedSnapshot);
+		});
+
+		It(TEXT("Loads the scene from a file"), [this] {
+			TArray<uint8> Snapshot;
+			MRUKConvertSceneJsonToSnapshot(ExampleRoomJson, Snapshot);
+			const FString Path = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("MRUKSceneSnapshot"), TEXT(".bin"));
+			TestTrue(TEXT("Write file"), FFileHelper::SaveArrayToFile(Snapshot, *Path));
+
+			TestTrue(TEXT("Load file"), ToolkitSubsystem->LoadSceneFromSnapshotFile(Path));
+			TestTrue(TEXT("Scene matches"), ToolkitSubsystem->SaveSceneToSnapshot() == Snapshot);
+
+			IFileManager::Get().Delete(*Path);
+		});
+
+		It(TEXT("Loads the global mesh"), [this] {
+			FMRUKSceneSnapshot Scene;
+			MRUKReadSceneJson(ExampleRoomJson, Scene);
+			Scene.Rooms[0].Anchors.Add(MakeGlobalMeshAnchor(1, 50));
+			TArray<uint8> Snapshot;
+			MRUKWriteSceneSnapshot(Scene, Snapshot);
+
+			ToolkitSubsystem->LoadSceneFromSnapshot(Snapshot);
+			AMRUKRoom* Room = ToolkitSubsystem->GetCurrentRoom();
+			if (!TestNotNull(TEXT("Global mesh anchor"), Room->GlobalMeshAnchor.Get()))
+			{
+				return;
+			}
+			TestTrue(TEXT("Load global mesh"), Room->LoadGlobalMeshFromSnapshot(Snapshot));
+
+			// The global mesh is saved again with the scene
+			FMRUKSceneSnapshot SavedScene = ToolkitSubsystem->SnapshotSerialize();
+			const FMRUKSnapshotAnchor* SavedAnchor = SavedScene.Rooms[0].Anchors.FindByPredicate([](const FMRUKSnapshotAnchor& Anchor) { return Anchor.GlobalMesh.IsSet(); });
+			if (TestNotNull(TEXT("Saved global mesh"), SavedAnchor))
+			{
+				TestEqual(TEXT("Number of positions"), SavedAnchor->GlobalMesh->GetPositions().Num(), 150);
+				TestEqual(TEXT("Number of indices"), SavedAnchor->GlobalMesh->GetIndices().Num(), 150);
+			}
+		});
+
+		It(TEXT("Loads faster than JSON"), [this] {
+			for (const FString& SceneJson : { FString(ExampleRoomJson), MakeSyntheticRoomJson(2000, 1) })
+			{
+				TArray<uint8> Snapshot;
+				MRUKConvertSceneJsonToSnapshot(SceneJson, Snapshot);
+
+				constexpr int32 NumIterations = 5;
+				double JsonSeconds = 0.0;
+				double SnapshotSeconds = 0.0;
+				for (int32 I = 0; I < NumIterations; ++I)
+				{
+					ToolkitSubsystem->ClearScene();
+					double StartTime = FPlatformTime::Seconds();
+					ToolkitSubsystem->LoadSceneFromJsonString(SceneJson);
+					JsonSeconds += FPlatformTime::Seconds() - StartTime;
+
+					ToolkitSubsystem->ClearScene();
+					StartTime = FPlatformTime::Seconds();
+					ToolkitSubsystem->LoadSceneFromSnapshot(Snapshot);
+					SnapshotSeconds += FPlatformTime::Seconds() - StartTime;
+				}
+
+				// Parsing alone, without spawning the anchors
+				double JsonParseSeconds = 0.0;
+				double SnapshotParseSeconds = 0.0;
+				for (int32 I = 0; I < NumIterations; ++I)
+				{
+					FMRUKSceneSnapshot Scene;
+					double StartTime = FPlatformTime::Seconds();
+					MRUKReadSceneJson(SceneJson, Scene);
+					JsonParseSeconds += FPlatformTime::Seconds() - StartTime;
+
+					StartTime = FPlatformTime::Seconds();
+					MRUKReadSceneSnapshot(Snapshot, Scene);
+					SnapshotParseSeconds += FPlatformTime::Seconds() - StartTime;
+				}
+
+				AddInfo(FString::Printf(TEXT("%d anchors, JSON %d bytes, snapshot %d bytes: load JSON %.3f ms, load snapshot %.3f ms, parse JSON %.3f ms, parse snapshot %.3f ms"),
+					ToolkitSubsystem->GetCurrentRoom()->AllAnchors.Num(), SceneJson.Len(), Snapshot.Num(),
+					JsonSeconds * 1000.0 / NumIterations, SnapshotSeconds * 1000.0 / NumIterations,
+					JsonParseSeconds * 1000.0 / NumIterations, SnapshotParseSeconds * 1000.0 / NumIterations));
+			}
+		});
+
+		TeardownMRUKSubsystem();
+	});
+}
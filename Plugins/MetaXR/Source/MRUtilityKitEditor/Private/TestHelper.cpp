@@ -2623,6 +2623,114 @@ const TCHAR* ExampleOtherRoomJson = TEXT(R"(
 	]
 })");
 
+namespace
+{
+	FString SyntheticAnchorUuid(int32 Index)
+	{
+		return FGuid(0x5EED0000, 0, 0, Index).ToString(EGuidFormats::Digits);
+	}
+
+	FString SyntheticAnchorJson(int32 Index, const TCHAR* Label, const FVector& Translation, const FRotator& Rotation, const FBox2D& PlaneBounds, const FBox* VolumeBounds)
+	{
+		FString Json = FString::Printf(TEXT(R"(
+				{
+					"UUID": "%s",
+					"SemanticClassifications": [ "%s" ],
+					"Transform":
+					{
+						"Translation": [ %f, %f, %f ],
+						"Rotation": [ %f, %f, %f ],
+						"Scale": [ 1, 1, 1 ]
+					},
+					"PlaneBounds":
+					{
+						"Min": [ %f, %f ],
+						"Max": [ %f, %f ]
+					},
+					"PlaneBoundary2D": [
+						[ %f, %f ],
+						[ %f, %f ],
+						[ %f, %f ],
+						[ %f, %f ]
+					])"),
+			*SyntheticAnchorUuid(Index), Label,
+			Translation.X, Translation.Y, Translation.Z,
+			Rotation.Pitch, Rotation.Yaw, Rotation.Roll,
+			PlaneBounds.Min.X, PlaneBounds.Min.Y, PlaneBounds.Max.X, PlaneBounds.Max.Y,
+			PlaneBounds.Min.X, PlaneBounds.Min.Y, PlaneBounds.Max.X, PlaneBounds.Min.Y,
+			PlaneBounds.Max.X, PlaneBounds.Max.Y, PlaneBounds.Min.X, PlaneBounds.Max.Y);
+		if (VolumeBounds)
+		{
+			Json += FString::Printf(TEXT(R"(,
+					"VolumeBounds":
+					{
+						"Min": [ %f, %f, %f ],
+						"Max": [ %f, %f, %f ]
+					})"),
+				VolumeBounds->Min.X, VolumeBounds->Min.Y, VolumeBounds->Min.Z,
+				VolumeBounds->Max.X, VolumeBounds->Max.Y, VolumeBounds->Max.Z);
+		}
+		Json += TEXT("\n\t\t\t\t}");
+		return Json;
+	}
+} // namespace
+
+FString MakeSyntheticRoomJson(int32 NumAnchors, int32 Seed)
+{
+	static const TCHAR* FurnitureLabels[] = { TEXT("TABLE"), TEXT("COUCH"), TEXT("STORAGE"), TEXT("BED"), TEXT("OTHER") };
+
+	FRandomStream RandomStream(Seed);
+	const int32 NumFurniture = FMath::Max(NumAnchors - 6, 0);
+	const double HalfSize = 150.0 + 30.0 * FMath::Sqrt(static_cast<double>(NumFurniture));
+	const double HalfHeight = 130.0;
+	const FBox2D WallBounds(FVector2D(-HalfSize, -HalfHeight), FVector2D(HalfSize, HalfHeight));
+	const FBox2D FloorBounds(FVector2D(-HalfSize, -HalfSize), FVector2D(HalfSize, HalfSize));
+
+	// The X axis of walls, floor and ceiling points out of the room
+	TArray<FString> Anchors;
+	Anchors.Add(SyntheticAnchorJson(0, TEXT("WALL_FACE"), FVector(HalfSize, 0.0, 0.0), FRotator(0.0, 0.0, 0.0), WallBounds, nullptr));
+	Anchors.Add(SyntheticAnchorJson(1, TEXT("WALL_FACE"), FVector(0.0, HalfSize, 0.0), FRotator(0.0, 90.0, 0.0), WallBounds, nullptr));
+	Anchors.Add(SyntheticAnchorJson(2, TEXT("WALL_FACE"), FVector(-HalfSize, 0.0, 0.0), FRotator(0.0, 180.0, 0.0), WallBounds, nullptr));
+	Anchors.Add(SyntheticAnchorJson(3, TEXT("WALL_FACE"), FVector(0.0, -HalfSize, 0.0), FRotator(0.0, -90.0, 0.0), WallBounds, nullptr));
+	Anchors.Add(SyntheticAnchorJson(4, TEXT("FLOOR"), FVector(0.0, 0.0, -HalfHeight), FRotator(-90.0, 0.0, 0.0), FloorBounds, nullptr));
+	Anchors.Add(SyntheticAnchorJson(5, TEXT("CEILING"), FVector(0.0, 0.0, HalfHeight), FRotator(90.0, 0.0, 0.0), FloorBounds, nullptr));
+
+	for (int32 I = 0; I < NumFurniture; ++I)
+	{
+		// Furniture anchors sit on top of the volume with the X axis pointing down to the floor
+		const FVector2D Extent(RandomStream.FRandRange(10.0, 60.0), RandomStream.FRandRange(10.0, 60.0));
+		const double Height = RandomStream.FRandRange(20.0, 150.0);
+		const FVector Translation(
+			RandomStream.FRandRange(-HalfSize + 60.0, HalfSize - 60.0),
+			RandomStream.FRandRange(-HalfSize + 60.0, HalfSize - 60.0),
+			-HalfHeight + Height);
+		const FRotator Rotation(-90.0, 0.0, RandomStream.FRandRange(-180.0, 180.0));
+		const FBox2D PlaneBounds(-Extent, Extent);
+		const FBox VolumeBounds(FVector(0.0, -Extent.X, -Extent.Y), FVector(Height, Extent.X, Extent.Y));
+		Anchors.Add(SyntheticAnchorJson(6 + I, FurnitureLabels[I % UE_ARRAY_COUNT(FurnitureLabels)], Translation, Rotation, PlaneBounds, &VolumeBounds));
+	}
+
+	return FString::Printf(TEXT(R"(
+{
+	"Rooms": [
+		{
+			"UUID": "5EEDA638E08442FF193FD34FE9E42850",
+			"RoomLayout":
+			{
+				"FloorUuid": "%s",
+				"CeilingUuid": "%s",
+				"WallsUuid": [ "%s", "%s", "%s", "%s" ]
+			},
+			"Anchors": [%s
+			]
+		}
+	]
+})"),
+		*SyntheticAnchorUuid(4), *SyntheticAnchorUuid(5),
+		*SyntheticAnchorUuid(0), *SyntheticAnchorUuid(1), *SyntheticAnchorUuid(2), *SyntheticAnchorUuid(3),
+		*FString::Join(Anchors, TEXT(",")));
+}
+
 void URoomAndAnchorObserver::OnAnchorCreated(AMRUKAnchor* Anchor)
 {
 	AnchorsCreated.Push(Anchor);
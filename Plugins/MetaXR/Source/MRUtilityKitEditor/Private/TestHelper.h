@@ -51,6 +51,17 @@ extern const TCHAR* ExampleRoomMoreFurnitureAddedJson;
 extern const TCHAR* ExampleRoomFurnitureModifiedJson;
 extern const TCHAR* ExampleOtherRoomJson;
 
+/**
+ * Generate a box shaped room with walls, floor, ceiling and randomly placed furniture volumes.
+ * The room grows with the number of anchors so that the furniture density stays roughly the same.
+ * Anchor UUIDs only depend on their index, so rooms generated with different seeds can be used
+ * to test updating anchors of an existing room.
+ * @param NumAnchors Total number of anchors including walls, floor and ceiling. At least 6 anchors are generated.
+ * @param Seed       Seed for the random furniture placement.
+ * @return The room in the MRUK Json format.
+ */
+FString MakeSyntheticRoomJson(int32 NumAnchors, int32 Seed);
+
 UCLASS()
 class AMeshResizer : public AActor
 {
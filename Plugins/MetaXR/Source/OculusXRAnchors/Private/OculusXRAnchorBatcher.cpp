@@ -0,0 +1,813 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "OculusXRAnchorBatcher.h"
+#include "OculusXRAnchorDelegates.h"
+#include "OculusXRAnchorsModule.h"
+#include "HAL/IConsoleManager.h"
+
+#if OCULUS_ANCHORS_SUPPORTED_PLATFORMS
+#include "OculusXRAnchorManager.h"
+#endif
+
+static TAutoConsoleVariable<int32> CVarOculusXRBatchAnchorRequests(
+	TEXT("ovr.OculusXRBatchAnchorRequests"),
+	1,
+	TEXT("Merges anchor save, erase and query requests made in the same frame into bulk calls.\n")
+		TEXT("<=0: disabled (every request is issued right away)\n")
+			TEXT("  1: enabled\n"));
+
+namespace OculusXRAnchors
+{
+	namespace
+	{
+		class FOculusXRPluginAnchorBackend : public IOculusXRAnchorBackend
+		{
+		public:
+#if OCULUS_ANCHORS_SUPPORTED_PLATFORMS
+			virtual EOculusXRAnchorResult::Type SaveSpaces(const TArray<uint64>& Spaces, uint64& OutRequestId) override
+			{
+				return FOculusXRAnchorManager::SaveSpaces(Spaces, OutRequestId);
+			}
+
+			virtual EOculusXRAnchorResult::Type EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, uint64& OutRequestId) override
+			{
+				return FOculusXRAnchorManager::EraseSpaces(Handles, UUIDs, OutRequestId);
+			}
+
+			virtual EOculusXRAnchorResult::Type QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, uint64& OutRequestId) override
+			{
+				return FOculusXRAnchorManager::QuerySpaces(QueryInfo, OutRequestId);
+			}
+#else
+			virtual EOculusXRAnchorResult::Type SaveSpaces(const TArray<uint64>& Spaces, uint64& OutRequestId) override
+			{
+				return EOculusXRAnchorResult::Failure_Unsupported;
+			}
+
+			virtual EOculusXRAnchorResult::Type EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, uint64& OutRequestId) override
+			{
+				return EOculusXRAnchorResult::Failure_Unsupported;
+			}
+
+			virtual EOculusXRAnchorResult::Type QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, uint64& OutRequestId) override
+			{
+				return EOculusXRAnchorResult::Failure_Unsupported;
+			}
+#endif // OCULUS_ANCHORS_SUPPORTED_PLATFORMS
+		};
+
+		bool IsBatchedAnchorResultSuccess(int Result)
+		{
+			return Result >= 0;
+		}
+
+		bool AreAnchorQueriesEqual(const FOculusXRSpaceQueryInfo& A, const FOculusXRSpaceQueryInfo& B)
+		{
+			return A.MaxQuerySpaces == B.MaxQuerySpaces
+				&& A.Timeout == B.Timeout
+				&& A.Location == B.Location
+				&& A.FilterType == B.FilterType
+				&& A.IDFilter == B.IDFilter
+				&& A.ComponentFilter == B.ComponentFilter
+				&& A.GroupUUIDFilter == B.GroupUUIDFilter;
+		}
+
+		bool CanMergeAnchorQuery(const FOculusXRSpaceQueryInfo& QueryInfo)
+		{
+			return QueryInfo.FilterType == EOculusXRSpaceQueryFilterType::FilterByIds && QueryInfo.IDFilter.Num() > 0;
+		}
+	} // namespace
+
+	TSharedRef<IOculusXRAnchorBackend> IOculusXRAnchorBackend::CreatePluginBackend()
+	{
+		return MakeShared<FOculusXRPluginAnchorBackend>();
+	}
+
+	FOculusXRAnchorBatcher::FOculusXRAnchorBatcher()
+		: FOculusXRAnchorBatcher(IOculusXRAnchorBackend::CreatePluginBackend())
+	{
+	}
+
+	FOculusXRAnchorBatcher::FOculusXRAnchorBatcher(const TSharedRef<IOculusXRAnchorBackend>& InBackend)
+		: Backend(InBackend)
+	{
+	}
+
+	FOculusXRAnchorBatcher::~FOculusXRAnchorBatcher()
+	{
+		StopTicking();
+	}
+
+	FOculusXRAnchorBatcher& FOculusXRAnchorBatcher::Get()
+	{
+		static FOculusXRAnchorBatcher Batcher;
+		return Batcher;
+	}
+
+	bool FOculusXRAnchorBatcher::IsBatchingEnabled() const
+	{
+		return bBatchingEnabled.Get(CVarOculusXRBatchAnchorRequests.GetValueOnGameThread() > 0);
+	}
+
+	void FOculusXRAnchorBatcher::SetBackend(const TSharedRef<IOculusXRAnchorBackend>& InBackend)
+	{
+		// Results of the old backend can't be told apart from the ones of the new backend
+		Flush();
+		if (BackendRequests.Num() > 0)
+		{
+			UE_LOG(LogOculusXRAnchors, Warning, TEXT("Switching the anchor backend with %d bulk requests in flight, their results are dropped"), BackendRequests.Num());
+			for (const auto& Pair : BackendRequests)
+			{
+				for (const uint64 RequestId : Pair.Value.RequestIds)
+				{
+					InFlightRequests.Remove(RequestId);
+				}
+			}
+			BackendRequests.Empty();
+		}
+
+		Backend = InBackend;
+	}
+
+	uint64 FOculusXRAnchorBatcher::GenerateRequestId()
+	{
+		static uint64 NextRequestId = 0;
+		return BatchRequestIdFlag | ++NextRequestId;
+	}
+
+	FOculusXRAnchorBatcher::FInFlightRequest& FOculusXRAnchorBatcher::AddInFlightRequest(ERequestKind Kind, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId)
+	{
+		OutRequestId = GenerateRequestId();
+		FInFlightRequest& Request = InFlightRequests.Add(OutRequestId);
+		Request.Kind = Kind;
+		Request.OnComplete = OnComplete;
+		return Request;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::SaveSpaces(const TArray<uint64>& Spaces, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId)
+	{
+		if (Spaces.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Failure_InvalidParameter;
+		}
+
+		// Erases are issued after saves, so erases made before this save go out first to keep their order. Queries see
+		// the saves and erases of their frame.
+		const bool bBatching = IsBatchingEnabled();
+		if (!bBatching || PendingErases.Num() > 0)
+		{
+			Flush();
+		}
+
+		++Stats.NumSaveRequests;
+		AddInFlightRequest(ERequestKind::Save, OnComplete, OutRequestId);
+		PendingSaves.Add({ OutRequestId, Spaces });
+
+		return bBatching ? EOculusXRAnchorResult::Success : IssueSaves(false);
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId)
+	{
+		if (Handles.Num() == 0 && UUIDs.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Failure_InvalidParameter;
+		}
+
+		const bool bBatching = IsBatchingEnabled();
+		if (!bBatching)
+		{
+			Flush();
+		}
+
+		++Stats.NumEraseRequests;
+		AddInFlightRequest(ERequestKind::Erase, OnComplete, OutRequestId);
+		PendingErases.Add({ OutRequestId, Handles, UUIDs });
+
+		return bBatching ? EOculusXRAnchorResult::Success : IssueErases(false);
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, const FOculusXRBatchedQueryResultDelegate& OnResult, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId)
+	{
+		const bool bBatching = IsBatchingEnabled();
+		if (!bBatching)
+		{
+			Flush();
+		}
+
+		++Stats.NumQueryRequests;
+
+		FInFlightRequest& Request = AddInFlightRequest(ERequestKind::Query, OnComplete, OutRequestId);
+		Request.OnResult = OnResult;
+		Request.MaxResults = QueryInfo.MaxQuerySpaces;
+		if (CanMergeAnchorQuery(QueryInfo))
+		{
+			Request.IdFilter.Append(QueryInfo.IDFilter);
+		}
+
+		PendingQueries.Add({ OutRequestId, QueryInfo });
+
+		return bBatching ? EOculusXRAnchorResult::Success : IssueQueries(false);
+	}
+
+	void FOculusXRAnchorBatcher::Flush()
+	{
+		IssueSaves(true);
+		IssueErases(true);
+		IssueQueries(true);
+	}
+
+	void FOculusXRAnchorBatcher::Tick(double Now)
+	{
+		Flush();
+
+		// Keep the backend alive while it delivers results, a result delegate might switch to another one
+		TSharedRef<IOculusXRAnchorBackend> TickedBackend = Backend;
+		TickedBackend->Tick(Now, *this);
+	}
+
+	void FOculusXRAnchorBatcher::StartTicking()
+	{
+		if (TickerHandle.IsValid())
+		{
+			return;
+		}
+
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("OculusXRAnchorBatcher"), 0.0f, [this](float) {
+			Tick(FPlatformTime::Seconds());
+			return true;
+		});
+	}
+
+	void FOculusXRAnchorBatcher::StopTicking()
+	{
+		if (TickerHandle.IsValid())
+		{
+			FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			TickerHandle.Reset();
+		}
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::IssueSaves(bool bReportFailures)
+	{
+		if (PendingSaves.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Success;
+		}
+
+		// Delegates of failed requests might queue new ones
+		TArray<FPendingSave> Saves = MoveTemp(PendingSaves);
+
+		// Every space goes into the first call that got it, calls are split at the per call limit. Each call keeps the
+		// part of every request that went into it.
+		struct FSaveCall
+		{
+			TArray<uint64> Spaces;
+			TArray<FPendingSave> Parts;
+		};
+
+		TArray<FSaveCall> Calls;
+		TMap<uint64, int32> SpaceToCall;
+		for (const FPendingSave& Save : Saves)
+		{
+			int32 NumCalls = 0;
+			for (const uint64 Space : Save.Spaces)
+			{
+				int32 Call = INDEX_NONE;
+				if (const int32* Found = SpaceToCall.Find(Space))
+				{
+					Call = *Found;
+				}
+				else
+				{
+					if (Calls.Num() == 0 || Calls.Last().Spaces.Num() >= MaxSpacesPerCall)
+					{
+						Calls.AddDefaulted();
+					}
+					Call = Calls.Num() - 1;
+					Calls[Call].Spaces.Add(Space);
+					SpaceToCall.Add(Space, Call);
+				}
+
+				TArray<FPendingSave>& Parts = Calls[Call].Parts;
+				if (Parts.Num() == 0 || Parts.Last().RequestId != Save.RequestId)
+				{
+					Parts.Add({ Save.RequestId, {} });
+					++NumCalls;
+				}
+				Parts.Last().Spaces.Add(Space);
+			}
+			InFlightRequests.FindChecked(Save.RequestId).NumOutstandingCalls = NumCalls;
+		}
+
+		EOculusXRAnchorResult::Type Result = EOculusXRAnchorResult::Success;
+		for (FSaveCall& Call : Calls)
+		{
+			const EOculusXRAnchorResult::Type CallResult = IssueSaveCall(Call.Spaces, MoveTemp(Call.Parts), bReportFailures);
+			Result = IsBatchedAnchorResultSuccess(Result) ? CallResult : Result;
+		}
+
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::IssueSaveCall(const TArray<uint64>& Spaces, TArray<FPendingSave>&& Saves, bool bReportFailures)
+	{
+		uint64 BackendRequestId = 0;
+		const EOculusXRAnchorResult::Type Result = Backend->SaveSpaces(Spaces, BackendRequestId);
+		++Stats.NumSaveCalls;
+
+		UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Batched %d save requests into one call -- Spaces: %d  --  Request ID: %llu  --  Result: %d"), Saves.Num(), Spaces.Num(), BackendRequestId, Result);
+
+		if (IsBatchedAnchorResultSuccess(Result))
+		{
+			FBackendRequest& BackendRequest = BackendRequests.Add(BackendRequestId, { ERequestKind::Save });
+			for (const FPendingSave& Save : Saves)
+			{
+				BackendRequest.RequestIds.Add(Save.RequestId);
+			}
+			BackendRequest.Saves = MoveTemp(Saves);
+			return Result;
+		}
+
+		if (Saves.Num() > 1)
+		{
+			return RetrySaves(MoveTemp(Saves), bReportFailures);
+		}
+
+		FailCall({ Saves[0].RequestId }, Result, bReportFailures);
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::RetrySaves(TArray<FPendingSave>&& Saves, bool bReportFailures)
+	{
+		EOculusXRAnchorResult::Type Result = EOculusXRAnchorResult::Success;
+		for (FPendingSave& Save : Saves)
+		{
+			++Stats.NumRetriedRequests;
+			const TArray<uint64> Spaces = Save.Spaces;
+			TArray<FPendingSave> Retry = { MoveTemp(Save) };
+			const EOculusXRAnchorResult::Type CallResult = IssueSaveCall(Spaces, MoveTemp(Retry), bReportFailures);
+			Result = IsBatchedAnchorResultSuccess(Result) ? CallResult : Result;
+		}
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::IssueErases(bool bReportFailures)
+	{
+		if (PendingErases.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Success;
+		}
+
+		TArray<FPendingErase> Erases = MoveTemp(PendingErases);
+
+		// Same as the saves, handles and UUIDs both count towards the per call limit
+		struct FEraseCall
+		{
+			TArray<FOculusXRUInt64> Handles;
+			TArray<FOculusXRUUID> UUIDs;
+			TArray<FPendingErase> Parts;
+
+			int32 Num() const { return Handles.Num() + UUIDs.Num(); }
+		};
+
+		TArray<FEraseCall> Calls;
+		TMap<uint64, int32> HandleToCall;
+		TMap<FOculusXRUUID, int32> UUIDToCall;
+		auto FindOrAddCall = [&Calls](int32* Found) {
+			if (Found)
+			{
+				return *Found;
+			}
+			if (Calls.Num() == 0 || Calls.Last().Num() >= MaxSpacesPerCall)
+			{
+				Calls.AddDefaulted();
+			}
+			return Calls.Num() - 1;
+		};
+
+		for (const FPendingErase& Erase : Erases)
+		{
+			int32 NumCalls = 0;
+			auto FindOrAddPart = [&Calls, &Erase, &NumCalls](int32 Call) -> FPendingErase& {
+				TArray<FPendingErase>& Parts = Calls[Call].Parts;
+				if (Parts.Num() == 0 || Parts.Last().RequestId != Erase.RequestId)
+				{
+					Parts.Add({ Erase.RequestId, {}, {} });
+					++NumCalls;
+				}
+				return Parts.Last();
+			};
+
+			for (const FOculusXRUInt64& Handle : Erase.Handles)
+			{
+				int32* Found = HandleToCall.Find(Handle.GetValue());
+				const int32 Call = FindOrAddCall(Found);
+				if (!Found)
+				{
+					Calls[Call].Handles.Add(Handle);
+					HandleToCall.Add(Handle.GetValue(), Call);
+				}
+				FindOrAddPart(Call).Handles.Add(Handle);
+			}
+			for (const FOculusXRUUID& UUID : Erase.UUIDs)
+			{
+				int32* Found = UUIDToCall.Find(UUID);
+				const int32 Call = FindOrAddCall(Found);
+				if (!Found)
+				{
+					Calls[Call].UUIDs.Add(UUID);
+					UUIDToCall.Add(UUID, Call);
+				}
+				FindOrAddPart(Call).UUIDs.Add(UUID);
+			}
+			InFlightRequests.FindChecked(Erase.RequestId).NumOutstandingCalls = NumCalls;
+		}
+
+		EOculusXRAnchorResult::Type Result = EOculusXRAnchorResult::Success;
+		for (FEraseCall& Call : Calls)
+		{
+			const EOculusXRAnchorResult::Type CallResult = IssueEraseCall(Call.Handles, Call.UUIDs, MoveTemp(Call.Parts), bReportFailures);
+			Result = IsBatchedAnchorResultSuccess(Result) ? CallResult : Result;
+		}
+
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::IssueEraseCall(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, TArray<FPendingErase>&& Erases, bool bReportFailures)
+	{
+		uint64 BackendRequestId = 0;
+		const EOculusXRAnchorResult::Type Result = Backend->EraseSpaces(Handles, UUIDs, BackendRequestId);
+		++Stats.NumEraseCalls;
+
+		UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Batched %d erase requests into one call -- Handles: %d  --  UUIDs: %d  --  Request ID: %llu  --  Result: %d"), Erases.Num(), Handles.Num(), UUIDs.Num(), BackendRequestId, Result);
+
+		if (IsBatchedAnchorResultSuccess(Result))
+		{
+			FBackendRequest& BackendRequest = BackendRequests.Add(BackendRequestId, { ERequestKind::Erase });
+			for (const FPendingErase& Erase : Erases)
+			{
+				BackendRequest.RequestIds.Add(Erase.RequestId);
+			}
+			BackendRequest.Erases = MoveTemp(Erases);
+			return Result;
+		}
+
+		if (Erases.Num() > 1)
+		{
+			return RetryErases(MoveTemp(Erases), bReportFailures);
+		}
+
+		FailCall({ Erases[0].RequestId }, Result, bReportFailures);
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::RetryErases(TArray<FPendingErase>&& Erases, bool bReportFailures)
+	{
+		EOculusXRAnchorResult::Type Result = EOculusXRAnchorResult::Success;
+		for (FPendingErase& Erase : Erases)
+		{
+			++Stats.NumRetriedRequests;
+			const TArray<FOculusXRUInt64> Handles = Erase.Handles;
+			const TArray<FOculusXRUUID> UUIDs = Erase.UUIDs;
+			TArray<FPendingErase> Retry = { MoveTemp(Erase) };
+			const EOculusXRAnchorResult::Type CallResult = IssueEraseCall(Handles, UUIDs, MoveTemp(Retry), bReportFailures);
+			Result = IsBatchedAnchorResultSuccess(Result) ? CallResult : Result;
+		}
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::IssueQueries(bool bReportFailures)
+	{
+		if (PendingQueries.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Success;
+		}
+
+		TArray<FPendingQuery> Queries = MoveTemp(PendingQueries);
+
+		// Queries by id for the same location and timeout become one query over all their ids, split up by the id
+		// filter limit. Any other query is issued once for all identical queries.
+		struct FMergedQuery
+		{
+			FOculusXRSpaceQueryInfo QueryInfo;
+			TArray<TArray<FOculusXRUUID>> Chunks;
+			TArray<TArray<uint64>> ChunkRequestIds;
+			TMap<FOculusXRUUID, int32> IdToChunk;
+		};
+
+		struct FUniqueQuery
+		{
+			FOculusXRSpaceQueryInfo QueryInfo;
+			TArray<uint64> RequestIds;
+		};
+
+		TArray<FMergedQuery> MergedQueries;
+		TArray<FUniqueQuery> UniqueQueries;
+
+		for (int32 Index = 0; Index < Queries.Num(); ++Index)
+		{
+			const FPendingQuery& Query = Queries[Index];
+			FInFlightRequest& Request = InFlightRequests.FindChecked(Query.RequestId);
+
+			for (int32 Previous = 0; Previous < Index; ++Previous)
+			{
+				if (AreAnchorQueriesEqual(Queries[Previous].QueryInfo, Query.QueryInfo))
+				{
+					++Stats.NumDeduplicatedQueries;
+					break;
+				}
+			}
+
+			if (!CanMergeAnchorQuery(Query.QueryInfo))
+			{
+				FUniqueQuery* Unique = UniqueQueries.FindByPredicate([&Query](const FUniqueQuery& Other) {
+					return AreAnchorQueriesEqual(Other.QueryInfo, Query.QueryInfo);
+				});
+
+				if (!Unique)
+				{
+					Unique = &UniqueQueries.Add_GetRef({ Query.QueryInfo, {} });
+				}
+				Unique->RequestIds.Add(Query.RequestId);
+				Request.NumOutstandingCalls = 1;
+				continue;
+			}
+
+			FMergedQuery* Merged = MergedQueries.FindByPredicate([&Query](const FMergedQuery& Other) {
+				return Other.QueryInfo.Location == Query.QueryInfo.Location && Other.QueryInfo.Timeout == Query.QueryInfo.Timeout;
+			});
+
+			if (!Merged)
+			{
+				Merged = &MergedQueries.AddDefaulted_GetRef();
+				Merged->QueryInfo = Query.QueryInfo;
+			}
+
+			TArray<int32, TInlineAllocator<4>> RequestChunks;
+			for (const FOculusXRUUID& UUID : Query.QueryInfo.IDFilter)
+			{
+				int32 Chunk = INDEX_NONE;
+				if (const int32* Found = Merged->IdToChunk.Find(UUID))
+				{
+					Chunk = *Found;
+				}
+				else
+				{
+					if (Merged->Chunks.Num() == 0 || Merged->Chunks.Last().Num() >= MaxIdsPerQuery)
+					{
+						Merged->Chunks.AddDefaulted();
+						Merged->ChunkRequestIds.AddDefaulted();
+					}
+					Chunk = Merged->Chunks.Num() - 1;
+					Merged->Chunks[Chunk].Add(UUID);
+					Merged->IdToChunk.Add(UUID, Chunk);
+				}
+
+				if (!RequestChunks.Contains(Chunk))
+				{
+					RequestChunks.Add(Chunk);
+					Merged->ChunkRequestIds[Chunk].Add(Query.RequestId);
+				}
+			}
+			Request.NumOutstandingCalls = RequestChunks.Num();
+		}
+
+		EOculusXRAnchorResult::Type Result = EOculusXRAnchorResult::Success;
+
+		for (FUniqueQuery& Unique : UniqueQueries)
+		{
+			const EOculusXRAnchorResult::Type QueryResult = IssueQuery(Unique.QueryInfo, MoveTemp(Unique.RequestIds), bReportFailures);
+			Result = IsBatchedAnchorResultSuccess(Result) ? QueryResult : Result;
+		}
+
+		for (FMergedQuery& Merged : MergedQueries)
+		{
+			for (int32 Chunk = 0; Chunk < Merged.Chunks.Num(); ++Chunk)
+			{
+				FOculusXRSpaceQueryInfo QueryInfo = Merged.QueryInfo;
+				QueryInfo.IDFilter = MoveTemp(Merged.Chunks[Chunk]);
+				QueryInfo.MaxQuerySpaces = QueryInfo.IDFilter.Num();
+
+				const EOculusXRAnchorResult::Type QueryResult = IssueQuery(QueryInfo, MoveTemp(Merged.ChunkRequestIds[Chunk]), bReportFailures);
+				Result = IsBatchedAnchorResultSuccess(Result) ? QueryResult : Result;
+			}
+		}
+
+		return Result;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRAnchorBatcher::IssueQuery(const FOculusXRSpaceQueryInfo& QueryInfo, TArray<uint64>&& RequestIds, bool bReportFailures)
+	{
+		uint64 BackendRequestId = 0;
+		const EOculusXRAnchorResult::Type Result = Backend->QuerySpaces(QueryInfo, BackendRequestId);
+		++Stats.NumQueryCalls;
+
+		UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Batched %d query requests into one call -- Filter type: %d  --  Request ID: %llu  --  Result: %d"), RequestIds.Num(), static_cast<int32>(QueryInfo.FilterType), BackendRequestId, Result);
+
+		if (IsBatchedAnchorResultSuccess(Result))
+		{
+			BackendRequests.Add(BackendRequestId, { ERequestKind::Query, MoveTemp(RequestIds) });
+		}
+		else
+		{
+			FailCall(RequestIds, Result, bReportFailures);
+		}
+
+		return Result;
+	}
+
+	void FOculusXRAnchorBatcher::FailCall(const TArray<uint64>& RequestIds, int Result, bool bReportFailures)
+	{
+		// A reported failure counts as one completed call, requests split over several calls wait for the others
+		if (bReportFailures)
+		{
+			for (const uint64 RequestId : RequestIds)
+			{
+				CompleteCall(RequestId, Result);
+			}
+		}
+		else
+		{
+			FailRequests(RequestIds, Result, false);
+		}
+	}
+
+	void FOculusXRAnchorBatcher::FailRequests(const TArray<uint64>& RequestIds, int Result, bool bReportFailures)
+	{
+		for (const uint64 RequestId : RequestIds)
+		{
+			FInFlightRequest Request;
+			if (InFlightRequests.RemoveAndCopyValue(RequestId, Request) && bReportFailures)
+			{
+				CompleteRequest(RequestId, Request, Result);
+			}
+		}
+	}
+
+	void FOculusXRAnchorBatcher::CompleteCall(uint64 RequestId, int Result)
+	{
+		FInFlightRequest* Request = InFlightRequests.Find(RequestId);
+		if (!Request)
+		{
+			return;
+		}
+
+		// The first failing call decides the result of a request that was split over several calls
+		if (IsBatchedAnchorResultSuccess(Request->Result))
+		{
+			Request->Result = Result;
+		}
+
+		if (--Request->NumOutstandingCalls > 0)
+		{
+			return;
+		}
+
+		FInFlightRequest Completed;
+		InFlightRequests.RemoveAndCopyValue(RequestId, Completed);
+		CompleteRequest(RequestId, Completed, Completed.Result);
+	}
+
+	void FOculusXRAnchorBatcher::CompleteRequest(uint64 RequestId, const FInFlightRequest& Request, int Result)
+	{
+		Request.OnComplete.ExecuteIfBound(RequestId, Result);
+
+		// Listeners of the event delegates hear about the request as if it had been issued to OVRPlugin on its own
+		const FOculusXRUInt64 CallerRequestId(RequestId);
+		switch (Request.Kind)
+		{
+			case ERequestKind::Save:
+				FOculusXRAnchorEventDelegates::OculusAnchorsSaveComplete.Broadcast(CallerRequestId, Result);
+				break;
+			case ERequestKind::Erase:
+				FOculusXRAnchorEventDelegates::OculusAnchorsEraseComplete.Broadcast(CallerRequestId, Result);
+				break;
+			case ERequestKind::Query:
+				FOculusXRAnchorEventDelegates::OculusSpaceQueryComplete.Broadcast(CallerRequestId, Result);
+				break;
+		}
+	}
+
+	void FOculusXRAnchorBatcher::CompleteBackendRequest(uint64 BackendRequestId, int Result)
+	{
+		FBackendRequest BackendRequest;
+		BackendRequests.RemoveAndCopyValue(BackendRequestId, BackendRequest);
+
+		for (const uint64 RequestId : BackendRequest.RequestIds)
+		{
+			CompleteCall(RequestId, Result);
+		}
+	}
+
+	bool FOculusXRAnchorBatcher::HandleSpacesSaveResult(uint64 BackendRequestId, int Result)
+	{
+		const FBackendRequest* BackendRequest = BackendRequests.Find(BackendRequestId);
+		if (!BackendRequest || BackendRequest->Kind != ERequestKind::Save)
+		{
+			return false;
+		}
+
+		if (!IsBatchedAnchorResultSuccess(Result) && BackendRequest->Saves.Num() > 1)
+		{
+			FBackendRequest Failed;
+			BackendRequests.RemoveAndCopyValue(BackendRequestId, Failed);
+			UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Batched save call failed, retrying its %d requests one by one -- Request ID: %llu  --  Result: %d"), Failed.Saves.Num(), BackendRequestId, Result);
+			RetrySaves(MoveTemp(Failed.Saves), true);
+			return true;
+		}
+
+		CompleteBackendRequest(BackendRequestId, Result);
+		return true;
+	}
+
+	bool FOculusXRAnchorBatcher::HandleSpacesEraseResult(uint64 BackendRequestId, int Result)
+	{
+		const FBackendRequest* BackendRequest = BackendRequests.Find(BackendRequestId);
+		if (!BackendRequest || BackendRequest->Kind != ERequestKind::Erase)
+		{
+			return false;
+		}
+
+		if (!IsBatchedAnchorResultSuccess(Result) && BackendRequest->Erases.Num() > 1)
+		{
+			FBackendRequest Failed;
+			BackendRequests.RemoveAndCopyValue(BackendRequestId, Failed);
+			UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Batched erase call failed, retrying its %d requests one by one -- Request ID: %llu  --  Result: %d"), Failed.Erases.Num(), BackendRequestId, Result);
+			RetryErases(MoveTemp(Failed.Erases), true);
+			return true;
+		}
+
+		CompleteBackendRequest(BackendRequestId, Result);
+		return true;
+	}
+
+	bool FOculusXRAnchorBatcher::HandleSpaceQueryResults(uint64 BackendRequestId, TConstArrayView<FOculusXRAnchor> Results)
+	{
+		const FBackendRequest* BackendRequest = BackendRequests.Find(BackendRequestId);
+		if (!BackendRequest || BackendRequest->Kind != ERequestKind::Query)
+		{
+			return false;
+		}
+
+		// Result delegates may issue new requests, which can reallocate the request maps
+		const TArray<uint64> RequestIds = BackendRequest->RequestIds;
+		for (const uint64 RequestId : RequestIds)
+		{
+			FInFlightRequest* Request = InFlightRequests.Find(RequestId);
+			if (!Request)
+			{
+				continue;
+			}
+
+			// Callers of a merged query only get the anchors they asked for
+			TArray<const FOculusXRAnchor*, TInlineAllocator<16>> CallerResults;
+			for (const FOculusXRAnchor& Result : Results)
+			{
+				if (Request->NumResults + CallerResults.Num() >= Request->MaxResults)
+				{
+					break;
+				}
+				if (Request->IdFilter.Num() == 0 || Request->IdFilter.Contains(Result.Uuid))
+				{
+					CallerResults.Add(&Result);
+				}
+			}
+
+			if (CallerResults.Num() == 0)
+			{
+				continue;
+			}
+
+			Request->NumResults += CallerResults.Num();
+			const FOculusXRBatchedQueryResultDelegate OnResult = Request->OnResult;
+			const FOculusXRUInt64 CallerRequestId(RequestId);
+
+			FOculusXRAnchorEventDelegates::OculusSpaceQueryResults.Broadcast(CallerRequestId);
+			for (const FOculusXRAnchor* Result : CallerResults)
+			{
+				OnResult.ExecuteIfBound(CallerRequestId, Result->AnchorHandle, Result->Uuid);
+				FOculusXRAnchorEventDelegates::OculusSpaceQueryResult.Broadcast(CallerRequestId, Result->AnchorHandle, Result->Uuid);
+			}
+		}
+
+		return true;
+	}
+
+	bool FOculusXRAnchorBatcher::HandleSpaceQueryComplete(uint64 BackendRequestId, int Result)
+	{
+		const FBackendRequest* BackendRequest = BackendRequests.Find(BackendRequestId);
+		if (!BackendRequest || BackendRequest->Kind != ERequestKind::Query)
+		{
+			return false;
+		}
+
+		FBackendRequest Completed;
+		BackendRequests.RemoveAndCopyValue(BackendRequestId, Completed);
+		for (const uint64 RequestId : Completed.RequestIds)
+		{
+			CompleteCall(RequestId, Result);
+		}
+
+		return true;
+	}
+} // namespace OculusXRAnchors
@@ -9,6 +9,7 @@
 #include "OculusXRAsyncRequestSystem.h"
 #include "OculusXRHMDModule.h"
 #include "OculusXRAnchorManager.h"
+#include "OculusXRAnchorBatcher.h"
 #include "OculusXRAnchorsModule.h"
 #include "OculusXRSpatialAnchorComponent.h"
 #include "OculusXRAnchorBPFunctionLibrary.h"
@@ -30,6 +31,8 @@ namespace OculusXRAnchors
 		DelegateHandleAnchorsErase = FOculusXRAnchorEventDelegates::OculusAnchorsEraseComplete.AddRaw(this, &FOculusXRAnchors::HandleAnchorsEraseComplete);
 		DelegateHandleAnchorsDiscoverResults = FOculusXRAnchorEventDelegates::OculusAnchorsDiscoverResults.AddRaw(this, &FOculusXRAnchors::HandleAnchorsDiscoverResults);
 		DelegateHandleAnchorsDiscoverComplete = FOculusXRAnchorEventDelegates::OculusAnchorsDiscoverComplete.AddRaw(this, &FOculusXRAnchors::HandleAnchorsDiscoverComplete);
+
+		FOculusXRAnchorBatcher::Get().StartTicking();
 	}
 
 	void FOculusXRAnchors::Teardown()
@@ -46,6 +49,8 @@ namespace OculusXRAnchors
 		FOculusXRAnchorEventDelegates::OculusAnchorsEraseComplete.Remove(DelegateHandleAnchorsErase);
 		FOculusXRAnchorEventDelegates::OculusAnchorsDiscoverResults.Remove(DelegateHandleAnchorsDiscoverResults);
 		FOculusXRAnchorEventDelegates::OculusAnchorsDiscoverComplete.Remove(DelegateHandleAnchorsDiscoverComplete);
+
+		FOculusXRAnchorBatcher::Get().StopTicking();
 	}
 
 	FOculusXRAnchors* FOculusXRAnchors::GetInstance()
@@ -413,8 +418,9 @@ namespace OculusXRAnchors
 
 	bool FOculusXRAnchors::QueryAnchorsAdvanced(const FOculusXRSpaceQueryInfo& QueryInfo, const FOculusXRAnchorQueryDelegate& ResultCallback, EOculusXRAnchorResult::Type& OutResult)
 	{
+		// The batcher broadcasts the results through the anchor event delegates, which this listens to
 		uint64 RequestId = 0;
-		OutResult = FOculusXRAnchorManager::QuerySpaces(QueryInfo, RequestId);
+		OutResult = FOculusXRAnchorBatcher::Get().QuerySpaces(QueryInfo, FOculusXRBatchedQueryResultDelegate(), FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
 		bool bAsyncStartSuccess = UOculusXRAnchorBPFunctionLibrary::IsAnchorResultSuccess(OutResult);
 
 		OculusXRTelemetry::Events::FAnchorsQueryRequest Trace(static_cast<int>(GetTypeHash(RequestId)));
@@ -502,7 +508,7 @@ namespace OculusXRAnchors
 		AnchorComponentsToReferences(Anchors, Handles, SavedAnchors);
 
 		uint64 RequestId = 0;
-		OutResult = FOculusXRAnchorManager::SaveSpaces(Handles, RequestId);
+		OutResult = FOculusXRAnchorBatcher::Get().SaveSpaces(Handles, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
 		bool bAsyncStartSuccess = UOculusXRAnchorBPFunctionLibrary::IsAnchorResultSuccess(OutResult);
 
 		if (bAsyncStartSuccess)
@@ -546,7 +552,7 @@ namespace OculusXRAnchors
 		}
 
 		uint64 RequestId = 0;
-		OutResult = FOculusXRAnchorManager::EraseSpaces(TArray<FOculusXRUInt64>(), UUIDs, RequestId);
+		OutResult = FOculusXRAnchorBatcher::Get().EraseSpaces(TArray<FOculusXRUInt64>(), UUIDs, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
 		bool bAsyncStartSuccess = UOculusXRAnchorBPFunctionLibrary::IsAnchorResultSuccess(OutResult);
 
 		if (bAsyncStartSuccess)
@@ -571,7 +577,7 @@ namespace OculusXRAnchors
 	bool FOculusXRAnchors::EraseAnchors(const TArray<FOculusXRUInt64>& AnchorHandles, const TArray<FOculusXRUUID>& AnchorUUIDs, const FOculusXREraseAnchorsDelegate& ResultCallback, EOculusXRAnchorResult::Type& OutResult)
 	{
 		uint64 RequestId = 0;
-		OutResult = FOculusXRAnchorManager::EraseSpaces(AnchorHandles, AnchorUUIDs, RequestId);
+		OutResult = FOculusXRAnchorBatcher::Get().EraseSpaces(AnchorHandles, AnchorUUIDs, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
 		bool bAsyncStartSuccess = UOculusXRAnchorBPFunctionLibrary::IsAnchorResultSuccess(OutResult);
 
 		if (bAsyncStartSuccess)
@@ -965,6 +971,11 @@ namespace OculusXRAnchors
 		SaveAnchorsBinding SaveData;
 		if (!SaveAnchorsBindings.RemoveAndCopyValue(RequestId.GetValue(), SaveData))
 		{
+			// Batched requests of other callers are broadcast as well
+			if (FOculusXRAnchorBatcher::IsBatchRequestId(RequestId.GetValue()))
+			{
+				return;
+			}
 			UE_LOG(LogOculusXRAnchors, Error, TEXT("Couldn't find binding for save anchors! Request: %llu"), RequestId.GetValue());
 			return;
 		}
@@ -1009,7 +1020,7 @@ namespace OculusXRAnchors
 				HandleAnchorsEraseByComponentsComplete(RequestId, Result);
 			}
 		}
-		else
+		else if (!FOculusXRAnchorBatcher::IsBatchRequestId(RequestId.GetValue()))
 		{
 			UE_LOG(LogOculusXRAnchors, Error, TEXT("Couldn't find a binding for erase anchors! Request: %llu"), RequestId.GetValue());
 		}
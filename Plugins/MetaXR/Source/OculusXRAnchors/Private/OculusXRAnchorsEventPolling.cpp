@@ -4,6 +4,7 @@
 #include "OculusXRHMD.h"
 #include "OculusXRAnchorsModule.h"
 #include "OculusXRAnchorManager.h"
+#include "OculusXRAnchorBatcher.h"
 #include "OculusXRAnchorDelegates.h"
 #include "OculusXRAnchorBPFunctionLibrary.h"
 #include "OculusXRAnchorTypesPrivate.h"
@@ -169,6 +170,22 @@ namespace OculusXRAnchors
 					return;
 				}
 
+				// Results of a bulk query go to the requests that were merged into it, the batcher broadcasts them under
+				// their own request ids
+				FOculusXRAnchorBatcher& Batcher = FOculusXRAnchorBatcher::Get();
+				if (Batcher.IsBackendRequest(QueryEvent.requestId))
+				{
+					TArray<FOculusXRAnchor> BatchedResults;
+					BatchedResults.Reserve(spaceQueryResults.size());
+					for (const auto& queryResultElement : spaceQueryResults)
+					{
+						BatchedResults.Add(FOculusXRAnchor(queryResultElement.space, queryResultElement.uuid.data));
+					}
+					Batcher.HandleSpaceQueryResults(QueryEvent.requestId, BatchedResults);
+
+					break;
+				}
+
 				FOculusXRUInt64 RequestId(QueryEvent.requestId);
 				FOculusXRAnchorEventDelegates::OculusSpaceQueryResults.Broadcast(RequestId);
 
@@ -204,6 +221,11 @@ namespace OculusXRAnchors
 					return;
 				}
 
+				if (FOculusXRAnchorBatcher::Get().HandleSpaceQueryComplete(QueryCompleteEvent.requestId, QueryCompleteEvent.result))
+				{
+					break;
+				}
+
 				// translate to BP types
 				const FOculusXRUInt64 RequestId(QueryCompleteEvent.requestId);
 				const bool bSucceeded = QueryCompleteEvent.result >= 0;
@@ -328,6 +350,11 @@ namespace OculusXRAnchors
 				FOculusXRUInt64 Result(SpacesSaveEvent.result);
 
 				UE_LOG(LogOculusXRAnchors, Verbose, TEXT("ovrpEventType_SpacesSaveResult  Request ID: %llu  --  Result: %llu"), RequestId.GetValue(), Result.GetValue());
+				if (FOculusXRAnchorBatcher::Get().HandleSpacesSaveResult(SpacesSaveEvent.requestId, SpacesSaveEvent.result))
+				{
+					break;
+				}
+
 				FOculusXRAnchorEventDelegates::OculusAnchorsSaveComplete.Broadcast(RequestId, Result);
 
 				break;
@@ -341,6 +368,11 @@ namespace OculusXRAnchors
 				FOculusXRUInt64 Result(SpacesEraseEvent.result);
 
 				UE_LOG(LogOculusXRAnchors, Verbose, TEXT("ovrpEventType_SpacesEraseResult  Request ID: %llu  --  Result: %llu"), RequestId.GetValue(), Result.GetValue());
+				if (FOculusXRAnchorBatcher::Get().HandleSpacesEraseResult(SpacesEraseEvent.requestId, SpacesEraseEvent.result))
+				{
+					break;
+				}
+
 				FOculusXRAnchorEventDelegates::OculusAnchorsEraseComplete.Broadcast(RequestId, Result);
 
 				break;
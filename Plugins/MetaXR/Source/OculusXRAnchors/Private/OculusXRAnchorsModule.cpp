@@ -3,6 +3,8 @@
 
 #include "OculusXRAnchorsModule.h"
 
+DEFINE_LOG_CATEGORY(LogOculusXRAnchors);
+
 #if OCULUS_ANCHORS_SUPPORTED_PLATFORMS
 #include "OculusXRHMDModule.h"
 #include "OculusXRHMD.h"
@@ -10,8 +12,6 @@
 #include "OculusXRAnchorsEventPolling.h"
 #include "OculusXRAnchorComponents.h"
 
-DEFINE_LOG_CATEGORY(LogOculusXRAnchors);
-
 #define LOCTEXT_NAMESPACE "OculusXRAnchors"
 
 //-------------------------------------------------------------------------------------------------
@@ -11,10 +11,10 @@
 // FOculusXRAnchorsModule
 //-------------------------------------------------------------------------------------------------
 
-#if OCULUS_ANCHORS_SUPPORTED_PLATFORMS
-
 DECLARE_LOG_CATEGORY_EXTERN(LogOculusXRAnchors, Log, All);
 
+#if OCULUS_ANCHORS_SUPPORTED_PLATFORMS
+
 class FOculusXRAnchorsModule : public IOculusXRAnchorsModule, IOculusXRCreateAnchorComponent
 {
 public:
@@ -0,0 +1,198 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "OculusXRLocalAnchorBackend.h"
+#include "OculusXRAnchorsModule.h"
+
+namespace OculusXRAnchors
+{
+	void FOculusXRLocalAnchorBackend::AddSpace(uint64 Space, const FOculusXRUUID& UUID)
+	{
+		SessionSpaces.Add(Space, UUID);
+	}
+
+	FOculusXRLocalAnchorBackend::FPendingEvent& FOculusXRLocalAnchorBackend::AddEvent(EEventKind Kind, uint64& OutRequestId)
+	{
+		OutRequestId = ++NextRequestId;
+
+		FPendingEvent& Event = PendingEvents.AddDefaulted_GetRef();
+		Event.Kind = Kind;
+		Event.RequestId = OutRequestId;
+		Event.DueTime = CurrentTime + LatencySeconds;
+		return Event;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRLocalAnchorBackend::SaveSpaces(const TArray<uint64>& Spaces, uint64& OutRequestId)
+	{
+		if (Spaces.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Failure_InvalidParameter;
+		}
+
+		if (bRejectUnknownSpaces && Spaces.ContainsByPredicate([this](uint64 Space) { return !SessionSpaces.Contains(Space); }))
+		{
+			return EOculusXRAnchorResult::Failure_InvalidParameter;
+		}
+
+		AddEvent(EEventKind::Save, OutRequestId).Spaces = Spaces;
+		return EOculusXRAnchorResult::Success;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRLocalAnchorBackend::EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, uint64& OutRequestId)
+	{
+		if (Handles.Num() == 0 && UUIDs.Num() == 0)
+		{
+			return EOculusXRAnchorResult::Failure_InvalidParameter;
+		}
+
+		FPendingEvent& Event = AddEvent(EEventKind::Erase, OutRequestId);
+		Event.UUIDs = UUIDs;
+		for (const FOculusXRUInt64& Handle : Handles)
+		{
+			Event.Spaces.Add(Handle.GetValue());
+		}
+		return EOculusXRAnchorResult::Success;
+	}
+
+	EOculusXRAnchorResult::Type FOculusXRLocalAnchorBackend::QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, uint64& OutRequestId)
+	{
+		// Only anchors saved to local storage are simulated, which can't be filtered by component or group
+		if (QueryInfo.FilterType == EOculusXRSpaceQueryFilterType::FilterByComponentType || QueryInfo.FilterType == EOculusXRSpaceQueryFilterType::FilterByGroup)
+		{
+			return EOculusXRAnchorResult::Failure_Unsupported;
+		}
+
+		AddEvent(EEventKind::Query, OutRequestId).QueryInfo = QueryInfo;
+		return EOculusXRAnchorResult::Success;
+	}
+
+	void FOculusXRLocalAnchorBackend::Tick(double Now, FOculusXRAnchorBatcher& Batcher)
+	{
+		CurrentTime = Now;
+
+		// Delivering an event can lead to new calls, which are delivered on a later tick
+		int32 NumDue = 0;
+		while (NumDue < PendingEvents.Num() && PendingEvents[NumDue].DueTime <= Now)
+		{
+			++NumDue;
+		}
+
+		if (NumDue == 0)
+		{
+			return;
+		}
+
+		TArray<FPendingEvent> DueEvents(PendingEvents.GetData(), NumDue);
+		PendingEvents.RemoveAt(0, NumDue);
+
+		for (const FPendingEvent& Event : DueEvents)
+		{
+			switch (Event.Kind)
+			{
+				case EEventKind::Save:
+					DeliverSave(Event, Batcher);
+					break;
+				case EEventKind::Erase:
+					DeliverErase(Event, Batcher);
+					break;
+				case EEventKind::Query:
+					DeliverQuery(Event, Batcher);
+					break;
+			}
+		}
+	}
+
+	void FOculusXRLocalAnchorBackend::DeliverSave(const FPendingEvent& Event, FOculusXRAnchorBatcher& Batcher)
+	{
+		EOculusXRAnchorResult::Type Result = SimulatedFailure.Get(EOculusXRAnchorResult::Success);
+		if (!SimulatedFailure.IsSet())
+		{
+			// Like OVRPlugin, a single unknown space fails the whole call
+			for (const uint64 Space : Event.Spaces)
+			{
+				if (!SessionSpaces.Contains(Space))
+				{
+					Result = EOculusXRAnchorResult::Failure_InvalidParameter;
+					break;
+				}
+			}
+
+			if (Result == EOculusXRAnchorResult::Success)
+			{
+				for (const uint64 Space : Event.Spaces)
+				{
+					StoredSpaces.Add(SessionSpaces[Space], Space);
+				}
+			}
+		}
+
+		UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Local anchor backend saved %d spaces -- Request ID: %llu  --  Result: %d"), Event.Spaces.Num(), Event.RequestId, Result);
+		Batcher.HandleSpacesSaveResult(Event.RequestId, Result);
+	}
+
+	void FOculusXRLocalAnchorBackend::DeliverErase(const FPendingEvent& Event, FOculusXRAnchorBatcher& Batcher)
+	{
+		const EOculusXRAnchorResult::Type Result = SimulatedFailure.Get(EOculusXRAnchorResult::Success);
+		if (!SimulatedFailure.IsSet())
+		{
+			for (const FOculusXRUUID& UUID : Event.UUIDs)
+			{
+				StoredSpaces.Remove(UUID);
+			}
+
+			for (const uint64 Space : Event.Spaces)
+			{
+				if (const FOculusXRUUID* UUID = SessionSpaces.Find(Space))
+				{
+					StoredSpaces.Remove(*UUID);
+				}
+			}
+		}
+
+		UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Local anchor backend erased %d spaces -- Request ID: %llu  --  Result: %d"), Event.Spaces.Num() + Event.UUIDs.Num(), Event.RequestId, Result);
+		Batcher.HandleSpacesEraseResult(Event.RequestId, Result);
+	}
+
+	void FOculusXRLocalAnchorBackend::DeliverQuery(const FPendingEvent& Event, FOculusXRAnchorBatcher& Batcher)
+	{
+		if (SimulatedFailure.IsSet())
+		{
+			Batcher.HandleSpaceQueryComplete(Event.RequestId, SimulatedFailure.GetValue());
+			return;
+		}
+
+		const FOculusXRSpaceQueryInfo& QueryInfo = Event.QueryInfo;
+		TArray<FOculusXRAnchor> Results;
+		if (QueryInfo.Location == EOculusXRSpaceStorageLocation::Local)
+		{
+			if (QueryInfo.FilterType == EOculusXRSpaceQueryFilterType::FilterByIds)
+			{
+				for (const FOculusXRUUID& UUID : QueryInfo.IDFilter)
+				{
+					const uint64* Space = StoredSpaces.Find(UUID);
+					if (Space && Results.Num() < QueryInfo.MaxQuerySpaces)
+					{
+						Results.Add(FOculusXRAnchor(*Space, UUID));
+					}
+				}
+			}
+			else
+			{
+				for (const TPair<FOculusXRUUID, uint64>& Stored : StoredSpaces)
+				{
+					if (Results.Num() >= QueryInfo.MaxQuerySpaces)
+					{
+						break;
+					}
+					Results.Add(FOculusXRAnchor(Stored.Value, Stored.Key));
+				}
+			}
+		}
+
+		UE_LOG(LogOculusXRAnchors, Verbose, TEXT("Local anchor backend found %d spaces -- Request ID: %llu"), Results.Num(), Event.RequestId);
+		if (Results.Num() > 0)
+		{
+			Batcher.HandleSpaceQueryResults(Event.RequestId, Results);
+		}
+		Batcher.HandleSpaceQueryComplete(Event.RequestId, EOculusXRAnchorResult::Success);
+	}
+} // namespace OculusXRAnchors
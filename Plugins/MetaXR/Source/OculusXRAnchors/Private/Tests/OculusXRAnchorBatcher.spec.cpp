@@ -0,0 +1,493 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRAnchorBatcher.h"
+#include "OculusXRAnchorDelegates.h"
+#include "OculusXRLocalAnchorBackend.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FOculusXRUUID MakeBatcherTestUUID(int32 Index)
+	{
+		FOculusXRUUID UUID;
+		FMemory::Memzero(UUID.UUIDBytes);
+		FMemory::Memcpy(UUID.UUIDBytes, &Index, sizeof(Index));
+		UUID.UUIDBytes[OCULUSXR_UUID_SIZE - 1] = 0xA5;
+		return UUID;
+	}
+
+	uint64 MakeBatcherTestSpace(int32 Index)
+	{
+		return 1000 + Index;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRAnchorBatcherSpec, TEXT("OculusXR.Anchors.Batcher"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TSharedPtr<OculusXRAnchors::FOculusXRLocalAnchorBackend> Backend;
+TUniquePtr<OculusXRAnchors::FOculusXRAnchorBatcher> Batcher;
+
+void AddSpaces(int32 NumSpaces);
+void SaveAll(int32 NumSpaces);
+END_DEFINE_SPEC(FOculusXRAnchorBatcherSpec)
+
+void FOculusXRAnchorBatcherSpec::AddSpaces(int32 NumSpaces)
+{
+	for (int32 Index = 0; Index < NumSpaces; ++Index)
+	{
+		Backend->AddSpace(MakeBatcherTestSpace(Index), MakeBatcherTestUUID(Index));
+	}
+}
+
+void FOculusXRAnchorBatcherSpec::SaveAll(int32 NumSpaces)
+{
+	TArray<uint64> Spaces;
+	for (int32 Index = 0; Index < NumSpaces; ++Index)
+	{
+		Spaces.Add(MakeBatcherTestSpace(Index));
+	}
+
+	uint64 RequestId = 0;
+	Batcher->SaveSpaces(Spaces, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
+	Batcher->Tick(0.0);
+}
+
+void FOculusXRAnchorBatcherSpec::Define()
+{
+	using namespace OculusXRAnchors;
+
+	BeforeEach([this]() {
+		Backend = MakeShared<FOculusXRLocalAnchorBackend>();
+		Batcher = MakeUnique<FOculusXRAnchorBatcher>(Backend.ToSharedRef());
+		Batcher->SetBatchingEnabled(true);
+	});
+
+	Describe(TEXT("Saving and erasing"), [this] {
+		It(TEXT("Merges the saves of a frame into one call"), [this] {
+			constexpr int32 NumSpaces = 100;
+			AddSpaces(NumSpaces);
+
+			TArray<int> Results;
+			TSet<uint64> CompletedRequestIds;
+			for (int32 Index = 0; Index < NumSpaces; ++Index)
+			{
+				uint64 RequestId = 0;
+				const EOculusXRAnchorResult::Type Result = Batcher->SaveSpaces({ MakeBatcherTestSpace(Index), MakeBatcherTestSpace(0) },
+					FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&Results, &CompletedRequestIds](FOculusXRUInt64 Id, int CompletionResult) {
+						Results.Add(CompletionResult);
+						CompletedRequestIds.Add(Id.GetValue());
+					}),
+					RequestId);
+				TestTrue(TEXT("Save is queued"), Result == EOculusXRAnchorResult::Success);
+				TestTrue(TEXT("Request id is marked as a batch request id"), FOculusXRAnchorBatcher::IsBatchRequestId(RequestId));
+			}
+
+			TestEqual(TEXT("Nothing is issued before the frame ends"), Batcher->GetStats().NumSaveCalls, 0ull);
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("One save call for the whole frame"), Batcher->GetStats().NumSaveCalls, 1ull);
+			TestEqual(TEXT("Every request completed"), Results.Num(), NumSpaces);
+			TestEqual(TEXT("Every request completed with its own id"), CompletedRequestIds.Num(), NumSpaces);
+			TestFalse(TEXT("Every request succeeded"), Results.ContainsByPredicate([](int CompletionResult) { return CompletionResult != EOculusXRAnchorResult::Success; }));
+			TestEqual(TEXT("Every space is stored"), Backend->GetNumStored(), NumSpaces);
+			TestEqual(TEXT("Nothing in flight"), Batcher->GetNumInFlightRequests(), 0);
+		});
+
+		It(TEXT("Fails every merged request on its own when the storage fails"), [this] {
+			AddSpaces(2);
+
+			int32 NumFailed = 0;
+			const FOculusXRBatchedSpacesCompleteDelegate OnComplete = FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&NumFailed](FOculusXRUInt64, int Result) {
+				NumFailed += Result < 0 ? 1 : 0;
+			});
+
+			uint64 RequestId = 0;
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(0) }, OnComplete, RequestId);
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(1) }, OnComplete, RequestId);
+			Backend->SetSimulatedFailure(EOculusXRAnchorResult::Failure_SpaceInsufficientResources);
+			Batcher->Tick(0.0);
+			TestEqual(TEXT("Nothing failed before the retries completed"), NumFailed, 0);
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("Both requests were retried"), Batcher->GetStats().NumRetriedRequests, 2ull);
+			TestEqual(TEXT("Both requests failed"), NumFailed, 2);
+			TestEqual(TEXT("Nothing is stored"), Backend->GetNumStored(), 0);
+			TestEqual(TEXT("Nothing in flight"), Batcher->GetNumInFlightRequests(), 0);
+		});
+
+		It(TEXT("Doesn't fail unrelated saves for an unknown space"), [this] {
+			AddSpaces(2);
+
+			for (const bool bReject : { false, true })
+			{
+				Backend->SetRejectUnknownSpaces(bReject);
+
+				TMap<uint64, int> Results;
+				const FOculusXRBatchedSpacesCompleteDelegate OnComplete = FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&Results](FOculusXRUInt64 Id, int Result) {
+					Results.Add(Id.GetValue(), Result);
+				});
+
+				uint64 GoodRequestIds[2] = {};
+				uint64 BadRequestId = 0;
+				Batcher->SaveSpaces({ MakeBatcherTestSpace(0) }, OnComplete, GoodRequestIds[0]);
+				Batcher->SaveSpaces({ MakeBatcherTestSpace(1), MakeBatcherTestSpace(0) }, OnComplete, GoodRequestIds[1]);
+				Batcher->SaveSpaces({ MakeBatcherTestSpace(99) }, OnComplete, BadRequestId);
+
+				// A call rejected right away is retried in the same frame, one that fails later on the next one
+				Batcher->Tick(0.0);
+				Batcher->Tick(0.0);
+
+				const TCHAR* Mode = bReject ? TEXT("Rejected call") : TEXT("Failed call");
+				const auto ResultOf = [&Results](uint64 Id) {
+					const int* Result = Results.Find(Id);
+					return Result ? *Result : 1;
+				};
+				TestEqual(FString::Printf(TEXT("%s: every request completed once"), Mode), Results.Num(), 3);
+				TestTrue(FString::Printf(TEXT("%s: first save succeeded"), Mode), ResultOf(GoodRequestIds[0]) == EOculusXRAnchorResult::Success);
+				TestTrue(FString::Printf(TEXT("%s: second save succeeded"), Mode), ResultOf(GoodRequestIds[1]) == EOculusXRAnchorResult::Success);
+				TestTrue(FString::Printf(TEXT("%s: save of the unknown space failed"), Mode), ResultOf(BadRequestId) < 0);
+				TestEqual(FString::Printf(TEXT("%s: known spaces are stored"), Mode), Backend->GetNumStored(), 2);
+				TestEqual(FString::Printf(TEXT("%s: nothing in flight"), Mode), Batcher->GetNumInFlightRequests(), 0);
+			}
+		});
+
+		It(TEXT("Splits saves and erases at the per call limit"), [this] {
+			constexpr int32 NumSpaces = FOculusXRAnchorBatcher::MaxSpacesPerCall + 10;
+			AddSpaces(NumSpaces);
+
+			TArray<uint64> Spaces;
+			TArray<FOculusXRUUID> UUIDs;
+			for (int32 Index = 0; Index < NumSpaces; ++Index)
+			{
+				Spaces.Add(MakeBatcherTestSpace(Index));
+				UUIDs.Add(MakeBatcherTestUUID(Index));
+			}
+
+			TArray<int> Results;
+			const FOculusXRBatchedSpacesCompleteDelegate OnComplete = FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&Results](FOculusXRUInt64, int Result) {
+				Results.Add(Result);
+			});
+
+			uint64 RequestId = 0;
+			Batcher->SaveSpaces(Spaces, OnComplete, RequestId);
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(NumSpaces - 1) }, OnComplete, RequestId);
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("Two save calls"), Batcher->GetStats().NumSaveCalls, 2ull);
+			TestEqual(TEXT("Each save completed once"), Results.Num(), 2);
+			TestEqual(TEXT("Every space is stored"), Backend->GetNumStored(), NumSpaces);
+
+			Results.Reset();
+			Batcher->EraseSpaces({}, UUIDs, OnComplete, RequestId);
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("Two erase calls"), Batcher->GetStats().NumEraseCalls, 2ull);
+			TestEqual(TEXT("Erase completed once"), Results.Num(), 1);
+			TestFalse(TEXT("Every request succeeded"), Results.ContainsByPredicate([](int Result) { return Result != EOculusXRAnchorResult::Success; }));
+			TestEqual(TEXT("Nothing is stored anymore"), Backend->GetNumStored(), 0);
+		});
+
+		It(TEXT("Keeps an erase and a later save of the same anchor in order"), [this] {
+			AddSpaces(1);
+			SaveAll(1);
+
+			uint64 RequestId = 0;
+			Batcher->EraseSpaces({}, { MakeBatcherTestUUID(0) }, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(0) }, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("Erase and save went out as separate calls"), Batcher->GetStats().NumEraseCalls, 1ull);
+			TestTrue(TEXT("Anchor saved after the erase is stored"), Backend->IsStored(MakeBatcherTestUUID(0)));
+		});
+
+		It(TEXT("Merges the erases of a frame into one call"), [this] {
+			constexpr int32 NumSpaces = 64;
+			AddSpaces(NumSpaces);
+			SaveAll(NumSpaces);
+
+			int32 NumCompleted = 0;
+			for (int32 Index = 0; Index < NumSpaces; ++Index)
+			{
+				uint64 RequestId = 0;
+				const TArray<FOculusXRUInt64> Handles = { FOculusXRUInt64(MakeBatcherTestSpace(Index)) };
+				const TArray<FOculusXRUUID> UUIDs = { MakeBatcherTestUUID(Index) };
+				Batcher->EraseSpaces(Index % 2 ? Handles : TArray<FOculusXRUInt64>(), Index % 2 ? TArray<FOculusXRUUID>() : UUIDs,
+					FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&NumCompleted](FOculusXRUInt64, int) { ++NumCompleted; }), RequestId);
+			}
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("One erase call for the whole frame"), Batcher->GetStats().NumEraseCalls, 1ull);
+			TestEqual(TEXT("Every request completed"), NumCompleted, NumSpaces);
+			TestEqual(TEXT("Nothing is stored anymore"), Backend->GetNumStored(), 0);
+		});
+	});
+
+	Describe(TEXT("Querying"), [this] {
+		It(TEXT("Shares one call between identical queries"), [this] {
+			constexpr int32 NumSpaces = 8;
+			AddSpaces(NumSpaces);
+			SaveAll(NumSpaces);
+
+			FOculusXRSpaceQueryInfo QueryInfo;
+			QueryInfo.FilterType = EOculusXRSpaceQueryFilterType::None;
+
+			constexpr int32 NumQueries = 20;
+			TArray<int32> NumResults;
+			NumResults.SetNumZeroed(NumQueries);
+			int32 NumCompleted = 0;
+			for (int32 Query = 0; Query < NumQueries; ++Query)
+			{
+				uint64 RequestId = 0;
+				Batcher->QuerySpaces(QueryInfo,
+					FOculusXRBatchedQueryResultDelegate::CreateLambda([&NumResults, Query](FOculusXRUInt64, FOculusXRUInt64, FOculusXRUUID) { ++NumResults[Query]; }),
+					FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&NumCompleted](FOculusXRUInt64, int) { ++NumCompleted; }),
+					RequestId);
+			}
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("One query call"), Batcher->GetStats().NumQueryCalls, 1ull);
+			TestEqual(TEXT("Deduplicated queries"), Batcher->GetStats().NumDeduplicatedQueries, static_cast<uint64>(NumQueries - 1));
+			TestEqual(TEXT("Every query completed"), NumCompleted, NumQueries);
+			TestFalse(TEXT("Every query got every anchor"), NumResults.ContainsByPredicate([](int32 Num) { return Num != NumSpaces; }));
+		});
+
+		It(TEXT("Merges queries by id and hands each caller only its anchors"), [this] {
+			constexpr int32 NumSpaces = 300;
+			AddSpaces(NumSpaces);
+			SaveAll(NumSpaces);
+
+			// Overlapping windows of ids, some of them never saved
+			constexpr int32 NumQueries = 50;
+			constexpr int32 WindowSize = 20;
+			TArray<TSet<FOculusXRUUID>> Expected;
+			TArray<TArray<FOculusXRUUID>> Received;
+			Expected.SetNum(NumQueries);
+			Received.SetNum(NumQueries);
+			int32 NumCompleted = 0;
+
+			for (int32 Query = 0; Query < NumQueries; ++Query)
+			{
+				FOculusXRSpaceQueryInfo QueryInfo;
+				QueryInfo.FilterType = EOculusXRSpaceQueryFilterType::FilterByIds;
+				for (int32 Index = Query * 7; Index < Query * 7 + WindowSize; ++Index)
+				{
+					QueryInfo.IDFilter.Add(MakeBatcherTestUUID(Index));
+					if (Index < NumSpaces)
+					{
+						Expected[Query].Add(MakeBatcherTestUUID(Index));
+					}
+				}
+				QueryInfo.MaxQuerySpaces = QueryInfo.IDFilter.Num();
+
+				uint64 RequestId = 0;
+				Batcher->QuerySpaces(QueryInfo,
+					FOculusXRBatchedQueryResultDelegate::CreateLambda([&Received, Query](FOculusXRUInt64, FOculusXRUInt64, FOculusXRUUID UUID) { Received[Query].Add(UUID); }),
+					FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&NumCompleted](FOculusXRUInt64, int) { ++NumCompleted; }),
+					RequestId);
+			}
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("One query call"), Batcher->GetStats().NumQueryCalls, 1ull);
+			TestEqual(TEXT("Every query completed"), NumCompleted, NumQueries);
+
+			int32 NumWrong = 0;
+			for (int32 Query = 0; Query < NumQueries; ++Query)
+			{
+				NumWrong += (Received[Query].Num() != Expected[Query].Num() || TSet<FOculusXRUUID>(Received[Query]).Difference(Expected[Query]).Num() > 0) ? 1 : 0;
+			}
+			TestEqual(TEXT("Every query got exactly the saved anchors it asked for"), NumWrong, 0);
+		});
+
+		It(TEXT("Splits merged queries at the id filter limit"), [this] {
+			constexpr int32 NumSpaces = FOculusXRAnchorBatcher::MaxIdsPerQuery + 200;
+			AddSpaces(NumSpaces);
+			SaveAll(NumSpaces);
+
+			constexpr int32 NumQueries = NumSpaces / 100;
+			int32 NumResults = 0;
+			int32 NumCompleted = 0;
+			for (int32 Query = 0; Query < NumQueries; ++Query)
+			{
+				FOculusXRSpaceQueryInfo QueryInfo;
+				QueryInfo.FilterType = EOculusXRSpaceQueryFilterType::FilterByIds;
+				for (int32 Index = Query * 100; Index < (Query + 1) * 100; ++Index)
+				{
+					QueryInfo.IDFilter.Add(MakeBatcherTestUUID(Index));
+				}
+
+				uint64 RequestId = 0;
+				Batcher->QuerySpaces(QueryInfo,
+					FOculusXRBatchedQueryResultDelegate::CreateLambda([&NumResults](FOculusXRUInt64, FOculusXRUInt64, FOculusXRUUID) { ++NumResults; }),
+					FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&NumCompleted](FOculusXRUInt64, int) { ++NumCompleted; }),
+					RequestId);
+			}
+			Batcher->Tick(0.0);
+
+			TestEqual(TEXT("Two query calls"), Batcher->GetStats().NumQueryCalls, 2ull);
+			TestEqual(TEXT("Every query completed"), NumCompleted, NumQueries);
+			TestEqual(TEXT("Every anchor was found once"), NumResults, NumQueries * 100);
+		});
+	});
+
+	Describe(TEXT("Event delegates"), [this] {
+		It(TEXT("Broadcasts the anchor event delegates under each caller's request id"), [this] {
+			constexpr int32 NumSpaces = 4;
+			AddSpaces(NumSpaces);
+
+			TMap<uint64, int32> SaveCompletes;
+			TMap<uint64, int32> EraseCompletes;
+			TMap<uint64, int32> QueryResultsAvailable;
+			TMap<uint64, int32> QueryResults;
+			TMap<uint64, int32> QueryCompletes;
+			const FDelegateHandle SaveHandle = FOculusXRAnchorEventDelegates::OculusAnchorsSaveComplete.AddLambda([&SaveCompletes](FOculusXRUInt64 Id, int Result) {
+				SaveCompletes.FindOrAdd(Id.GetValue()) += Result == EOculusXRAnchorResult::Success ? 1 : 0;
+			});
+			const FDelegateHandle EraseHandle = FOculusXRAnchorEventDelegates::OculusAnchorsEraseComplete.AddLambda([&EraseCompletes](FOculusXRUInt64 Id, int Result) {
+				EraseCompletes.FindOrAdd(Id.GetValue()) += Result == EOculusXRAnchorResult::Success ? 1 : 0;
+			});
+			const FDelegateHandle ResultsHandle = FOculusXRAnchorEventDelegates::OculusSpaceQueryResults.AddLambda([&QueryResultsAvailable](FOculusXRUInt64 Id) {
+				++QueryResultsAvailable.FindOrAdd(Id.GetValue());
+			});
+			const FDelegateHandle ResultHandle = FOculusXRAnchorEventDelegates::OculusSpaceQueryResult.AddLambda([&QueryResults](FOculusXRUInt64 Id, FOculusXRUInt64, FOculusXRUUID) {
+				++QueryResults.FindOrAdd(Id.GetValue());
+			});
+			const FDelegateHandle CompleteHandle = FOculusXRAnchorEventDelegates::OculusSpaceQueryComplete.AddLambda([&QueryCompletes](FOculusXRUInt64 Id, int Result) {
+				QueryCompletes.FindOrAdd(Id.GetValue()) += Result == EOculusXRAnchorResult::Success ? 1 : 0;
+			});
+
+			uint64 SaveRequestIds[2] = {};
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(0), MakeBatcherTestSpace(1) }, FOculusXRBatchedSpacesCompleteDelegate(), SaveRequestIds[0]);
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(2), MakeBatcherTestSpace(3) }, FOculusXRBatchedSpacesCompleteDelegate(), SaveRequestIds[1]);
+			Batcher->Tick(0.0);
+
+			// Two merged queries, the second one asks for an anchor that isn't stored
+			uint64 QueryRequestIds[2] = {};
+			FOculusXRSpaceQueryInfo QueryInfo;
+			QueryInfo.FilterType = EOculusXRSpaceQueryFilterType::FilterByIds;
+			QueryInfo.IDFilter = { MakeBatcherTestUUID(0), MakeBatcherTestUUID(1), MakeBatcherTestUUID(2) };
+			Batcher->QuerySpaces(QueryInfo, FOculusXRBatchedQueryResultDelegate(), FOculusXRBatchedSpacesCompleteDelegate(), QueryRequestIds[0]);
+			QueryInfo.IDFilter = { MakeBatcherTestUUID(3), MakeBatcherTestUUID(99) };
+			Batcher->QuerySpaces(QueryInfo, FOculusXRBatchedQueryResultDelegate(), FOculusXRBatchedSpacesCompleteDelegate(), QueryRequestIds[1]);
+			Batcher->Tick(0.0);
+
+			uint64 EraseRequestId = 0;
+			Batcher->EraseSpaces({}, { MakeBatcherTestUUID(0) }, FOculusXRBatchedSpacesCompleteDelegate(), EraseRequestId);
+			Batcher->Tick(0.0);
+
+			FOculusXRAnchorEventDelegates::OculusAnchorsSaveComplete.Remove(SaveHandle);
+			FOculusXRAnchorEventDelegates::OculusAnchorsEraseComplete.Remove(EraseHandle);
+			FOculusXRAnchorEventDelegates::OculusSpaceQueryResults.Remove(ResultsHandle);
+			FOculusXRAnchorEventDelegates::OculusSpaceQueryResult.Remove(ResultHandle);
+			FOculusXRAnchorEventDelegates::OculusSpaceQueryComplete.Remove(CompleteHandle);
+
+			TestEqual(TEXT("One save call"), Batcher->GetStats().NumSaveCalls, 1ull);
+			TestEqual(TEXT("One query call"), Batcher->GetStats().NumQueryCalls, 1ull);
+			TestEqual(TEXT("Both saves completed once"), SaveCompletes.Num(), 2);
+			TestEqual(TEXT("First save completed under its id"), SaveCompletes.FindRef(SaveRequestIds[0]), 1);
+			TestEqual(TEXT("Second save completed under its id"), SaveCompletes.FindRef(SaveRequestIds[1]), 1);
+			TestEqual(TEXT("Erase completed once"), EraseCompletes.Num(), 1);
+			TestEqual(TEXT("Erase completed under its id"), EraseCompletes.FindRef(EraseRequestId), 1);
+			TestEqual(TEXT("Results are announced to both queries"), QueryResultsAvailable.Num(), 2);
+			TestEqual(TEXT("First query got its results announced once"), QueryResultsAvailable.FindRef(QueryRequestIds[0]), 1);
+			TestEqual(TEXT("Second query got its results announced once"), QueryResultsAvailable.FindRef(QueryRequestIds[1]), 1);
+			TestEqual(TEXT("First query got its anchors"), QueryResults.FindRef(QueryRequestIds[0]), 3);
+			TestEqual(TEXT("Second query got its anchor"), QueryResults.FindRef(QueryRequestIds[1]), 1);
+			TestEqual(TEXT("Results only went to the callers"), QueryResults.Num(), 2);
+			TestEqual(TEXT("Both queries completed once"), QueryCompletes.Num(), 2);
+			TestEqual(TEXT("First query completed under its id"), QueryCompletes.FindRef(QueryRequestIds[0]), 1);
+			TestEqual(TEXT("Second query completed under its id"), QueryCompletes.FindRef(QueryRequestIds[1]), 1);
+		});
+	});
+
+	Describe(TEXT("Latency and pass-through"), [this] {
+		It(TEXT("Completes requests once the backend latency has passed"), [this] {
+			AddSpaces(1);
+			Backend->SetLatency(0.1);
+
+			bool bCompleted = false;
+			uint64 RequestId = 0;
+			Batcher->SaveSpaces({ MakeBatcherTestSpace(0) }, FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&bCompleted](FOculusXRUInt64, int) { bCompleted = true; }), RequestId);
+
+			Batcher->Tick(0.0);
+			Batcher->Tick(0.05);
+			TestFalse(TEXT("Not complete before the latency passed"), bCompleted);
+			TestEqual(TEXT("Request is in flight"), Batcher->GetNumInFlightRequests(), 1);
+
+			Batcher->Tick(0.1);
+			TestTrue(TEXT("Complete after the latency passed"), bCompleted);
+		});
+
+		It(TEXT("Issues every request right away without batching"), [this] {
+			constexpr int32 NumSpaces = 10;
+			AddSpaces(NumSpaces);
+			Batcher->SetBatchingEnabled(false);
+
+			int32 NumCompleted = 0;
+			for (int32 Index = 0; Index < NumSpaces; ++Index)
+			{
+				uint64 RequestId = 0;
+				Batcher->SaveSpaces({ MakeBatcherTestSpace(Index) }, FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&NumCompleted](FOculusXRUInt64, int) { ++NumCompleted; }), RequestId);
+			}
+
+			TestEqual(TEXT("One call per request"), Batcher->GetStats().NumSaveCalls, static_cast<uint64>(NumSpaces));
+			Batcher->Tick(0.0);
+			TestEqual(TEXT("Every request completed"), NumCompleted, NumSpaces);
+
+			// A call that fails to start is reported to the caller only, like a direct OVRPlugin call
+			bool bDelegateCalled = false;
+			FOculusXRSpaceQueryInfo QueryInfo;
+			QueryInfo.FilterType = EOculusXRSpaceQueryFilterType::FilterByGroup;
+			uint64 RequestId = 0;
+			const EOculusXRAnchorResult::Type Result = Batcher->QuerySpaces(QueryInfo, FOculusXRBatchedQueryResultDelegate(),
+				FOculusXRBatchedSpacesCompleteDelegate::CreateLambda([&bDelegateCalled](FOculusXRUInt64, int) { bDelegateCalled = true; }), RequestId);
+			TestTrue(TEXT("Failure is returned"), Result == EOculusXRAnchorResult::Failure_Unsupported);
+			TestFalse(TEXT("Delegate is not called"), bDelegateCalled);
+			TestEqual(TEXT("Nothing in flight"), Batcher->GetNumInFlightRequests(), 0);
+		});
+
+		It(TEXT("Reduces the number of backend calls for a burst of requests"), [this] {
+			constexpr int32 NumSpaces = 2000;
+			AddSpaces(NumSpaces);
+
+			auto RunBurst = [this](bool bBatching, int32 NumRequests) {
+				Batcher->SetBatchingEnabled(bBatching);
+				const FOculusXRAnchorBatcherStats StatsBefore = Batcher->GetStats();
+				const double StartTime = FPlatformTime::Seconds();
+				for (int32 Index = 0; Index < NumRequests; ++Index)
+				{
+					uint64 RequestId = 0;
+					Batcher->SaveSpaces({ MakeBatcherTestSpace(Index) }, FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
+
+					FOculusXRSpaceQueryInfo QueryInfo;
+					QueryInfo.FilterType = EOculusXRSpaceQueryFilterType::FilterByIds;
+					QueryInfo.IDFilter = { MakeBatcherTestUUID(Index) };
+					Batcher->QuerySpaces(QueryInfo, FOculusXRBatchedQueryResultDelegate(), FOculusXRBatchedSpacesCompleteDelegate(), RequestId);
+				}
+				Batcher->Tick(0.0);
+				const double Seconds = FPlatformTime::Seconds() - StartTime;
+
+				const FOculusXRAnchorBatcherStats& Stats = Batcher->GetStats();
+				const uint64 NumCalls = (Stats.NumSaveCalls + Stats.NumQueryCalls) - (StatsBefore.NumSaveCalls + StatsBefore.NumQueryCalls);
+				AddInfo(FString::Printf(TEXT("%s: %d saves and %d queries in %llu backend calls, %.3f ms"),
+					bBatching ? TEXT("Batched") : TEXT("Unbatched"), NumRequests, NumRequests, NumCalls, Seconds * 1000.0));
+				return NumCalls;
+			};
+
+			const uint64 UnbatchedCalls = RunBurst(false, NumSpaces);
+			const uint64 BatchedCalls = RunBurst(true, NumSpaces);
+
+			TestEqual(TEXT("Unbatched issues a call per request"), UnbatchedCalls, static_cast<uint64>(2 * NumSpaces));
+			TestEqual(TEXT("Batched issues as few saves and queries as the per call limits allow"), BatchedCalls,
+				static_cast<uint64>(FMath::DivideAndRoundUp(NumSpaces, FOculusXRAnchorBatcher::MaxSpacesPerCall) + FMath::DivideAndRoundUp(NumSpaces, FOculusXRAnchorBatcher::MaxIdsPerQuery)));
+			TestEqual(TEXT("Nothing in flight"), Batcher->GetNumInFlightRequests(), 0);
+		});
+	});
+
+	AfterEach([this]() {
+		Batcher.Reset();
+		Backend.Reset();
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,207 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "OculusXRAnchorTypes.h"
+
+DECLARE_DELEGATE_TwoParams(FOculusXRBatchedSpacesCompleteDelegate, FOculusXRUInt64 /*RequestId*/, int /*Result*/);
+DECLARE_DELEGATE_ThreeParams(FOculusXRBatchedQueryResultDelegate, FOculusXRUInt64 /*RequestId*/, FOculusXRUInt64 /*Space*/, FOculusXRUUID /*UUID*/);
+
+namespace OculusXRAnchors
+{
+	class FOculusXRAnchorBatcher;
+
+	// Storage the batcher issues its bulk calls to. Request ids returned by a backend are reported back to the batcher
+	// through its Handle* functions once the backend completes them.
+	class OCULUSXRANCHORS_API IOculusXRAnchorBackend
+	{
+	public:
+		virtual ~IOculusXRAnchorBackend() = default;
+
+		virtual EOculusXRAnchorResult::Type SaveSpaces(const TArray<uint64>& Spaces, uint64& OutRequestId) = 0;
+		virtual EOculusXRAnchorResult::Type EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, uint64& OutRequestId) = 0;
+		virtual EOculusXRAnchorResult::Type QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, uint64& OutRequestId) = 0;
+
+		// Called by the batcher every frame after it issued its bulk calls. Backends that don't complete their requests
+		// through the OVRPlugin event polling deliver their results to the batcher here.
+		virtual void Tick(double Now, FOculusXRAnchorBatcher& Batcher) {}
+
+		// The backend that issues its calls to OVRPlugin, its results arrive through the anchors event polling
+		static TSharedRef<IOculusXRAnchorBackend> CreatePluginBackend();
+	};
+
+	struct FOculusXRAnchorBatcherStats
+	{
+		// Requests made by callers
+		uint64 NumSaveRequests = 0;
+		uint64 NumEraseRequests = 0;
+		uint64 NumQueryRequests = 0;
+
+		// Calls issued to the backend
+		uint64 NumSaveCalls = 0;
+		uint64 NumEraseCalls = 0;
+		uint64 NumQueryCalls = 0;
+
+		// Queries that shared the backend call of an identical query issued in the same frame
+		uint64 NumDeduplicatedQueries = 0;
+
+		// Save and erase requests that were issued again on their own after the call they were merged into failed
+		uint64 NumRetriedRequests = 0;
+	};
+
+	// Coalesces anchor storage requests issued in the same frame. The saves of a frame become as few SaveSpaces calls
+	// and the erases as few EraseSpaces calls as the per call limit allows, identical queries share a single QuerySpaces
+	// call and queries by id for the same location are merged into as few calls as the id filter limit allows. Callers
+	// get a request id of their own, which is handed to their completion delegates once the bulk calls it was merged into
+	// complete. If a merged save or erase call fails, every request in it is issued again on its own, so one bad anchor
+	// doesn't fail the requests of unrelated callers.
+	//
+	// Results and completions are also broadcast through FOculusXRAnchorEventDelegates under the caller's request id, the
+	// same way OVRPlugin reports a request issued on its own: OculusSpaceQueryResults, OculusSpaceQueryResult and
+	// OculusSpaceQueryComplete for queries, OculusAnchorsSaveComplete and OculusAnchorsEraseComplete for saves and erases.
+	// Requests that fail right away aren't broadcast, their failure is returned to the caller.
+	class OCULUSXRANCHORS_API FOculusXRAnchorBatcher
+	{
+	public:
+		FOculusXRAnchorBatcher();
+		explicit FOculusXRAnchorBatcher(const TSharedRef<IOculusXRAnchorBackend>& InBackend);
+		~FOculusXRAnchorBatcher();
+
+		// The batcher FOculusXRAnchors and the event polling use
+		static FOculusXRAnchorBatcher& Get();
+
+		// Request ids handed out by the batcher have this bit set, so they never collide with the ones of OVRPlugin. They are
+		// unique across batchers, since all of them broadcast through the same event delegates.
+		static constexpr uint64 BatchRequestIdFlag = 1ull << 63;
+		static bool IsBatchRequestId(uint64 RequestId) { return (RequestId & BatchRequestIdFlag) != 0; }
+
+		// Maximum number of ids OVRPlugin accepts in the filter of a single query
+		static constexpr int32 MaxIdsPerQuery = 1024;
+
+		// Maximum number of spaces the batcher puts into a single save or erase call
+		static constexpr int32 MaxSpacesPerCall = 1024;
+
+		EOculusXRAnchorResult::Type SaveSpaces(const TArray<uint64>& Spaces, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId);
+		EOculusXRAnchorResult::Type EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId);
+		EOculusXRAnchorResult::Type QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, const FOculusXRBatchedQueryResultDelegate& OnResult, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId);
+
+		// Issue everything requested since the last flush to the backend
+		void Flush();
+
+		// Flush and let the backend deliver its results
+		void Tick(double Now);
+
+		// Flush at the end of every frame, until StopTicking() is called
+		void StartTicking();
+		void StopTicking();
+
+		// Without batching every request is issued to the backend right away
+		void SetBatchingEnabled(bool bEnabled) { bBatchingEnabled = bEnabled; }
+		bool IsBatchingEnabled() const;
+
+		void SetBackend(const TSharedRef<IOculusXRAnchorBackend>& InBackend);
+		const TSharedRef<IOculusXRAnchorBackend>& GetBackend() const { return Backend; }
+
+		// Results of backend requests. They return false for request ids the batcher didn't issue.
+		bool HandleSpacesSaveResult(uint64 BackendRequestId, int Result);
+		bool HandleSpacesEraseResult(uint64 BackendRequestId, int Result);
+		bool HandleSpaceQueryResults(uint64 BackendRequestId, TConstArrayView<FOculusXRAnchor> Results);
+		bool HandleSpaceQueryComplete(uint64 BackendRequestId, int Result);
+
+		bool IsBackendRequest(uint64 BackendRequestId) const { return BackendRequests.Contains(BackendRequestId); }
+		int32 GetNumPendingRequests() const { return PendingSaves.Num() + PendingErases.Num() + PendingQueries.Num(); }
+		int32 GetNumInFlightRequests() const { return InFlightRequests.Num(); }
+		const FOculusXRAnchorBatcherStats& GetStats() const { return Stats; }
+
+	private:
+		enum class ERequestKind : uint8
+		{
+			Save,
+			Erase,
+			Query,
+		};
+
+		struct FPendingSave
+		{
+			uint64 RequestId;
+			TArray<uint64> Spaces;
+		};
+
+		struct FPendingErase
+		{
+			uint64 RequestId;
+			TArray<FOculusXRUInt64> Handles;
+			TArray<FOculusXRUUID> UUIDs;
+		};
+
+		struct FPendingQuery
+		{
+			uint64 RequestId;
+			FOculusXRSpaceQueryInfo QueryInfo;
+		};
+
+		// A caller's request from the moment it was queued until its delegate ran
+		struct FInFlightRequest
+		{
+			ERequestKind Kind = ERequestKind::Save;
+			FOculusXRBatchedSpacesCompleteDelegate OnComplete;
+			FOculusXRBatchedQueryResultDelegate OnResult;
+
+			// The backend calls that still have to complete and the first failure among them. Queries only: the ids a
+			// merged query asked for and the number of results handed out so far
+			int32 NumOutstandingCalls = 0;
+			int Result = 0;
+			TSet<FOculusXRUUID> IdFilter;
+			int32 MaxResults = 0;
+			int32 NumResults = 0;
+		};
+
+		// A bulk call issued to the backend and the caller requests that were merged into it
+		struct FBackendRequest
+		{
+			ERequestKind Kind;
+			TArray<uint64> RequestIds;
+
+			// Saves and erases only: the spaces of each merged request that went into this call, to issue them again
+			// one request at a time if the call fails
+			TArray<FPendingSave> Saves;
+			TArray<FPendingErase> Erases;
+		};
+
+		uint64 GenerateRequestId();
+		FInFlightRequest& AddInFlightRequest(ERequestKind Kind, const FOculusXRBatchedSpacesCompleteDelegate& OnComplete, uint64& OutRequestId);
+
+		// Failures of requests issued right away are returned to the caller instead of being reported to their delegates
+		EOculusXRAnchorResult::Type IssueSaves(bool bReportFailures);
+		EOculusXRAnchorResult::Type IssueErases(bool bReportFailures);
+		EOculusXRAnchorResult::Type IssueQueries(bool bReportFailures);
+		EOculusXRAnchorResult::Type IssueSaveCall(const TArray<uint64>& Spaces, TArray<FPendingSave>&& Saves, bool bReportFailures);
+		EOculusXRAnchorResult::Type IssueEraseCall(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, TArray<FPendingErase>&& Erases, bool bReportFailures);
+		EOculusXRAnchorResult::Type IssueQuery(const FOculusXRSpaceQueryInfo& QueryInfo, TArray<uint64>&& RequestIds, bool bReportFailures);
+
+		// Issue every request of a failed merged call again as a call of its own
+		EOculusXRAnchorResult::Type RetrySaves(TArray<FPendingSave>&& Saves, bool bReportFailures);
+		EOculusXRAnchorResult::Type RetryErases(TArray<FPendingErase>&& Erases, bool bReportFailures);
+
+		void FailCall(const TArray<uint64>& RequestIds, int Result, bool bReportFailures);
+		void FailRequests(const TArray<uint64>& RequestIds, int Result, bool bReportFailures);
+		void CompleteBackendRequest(uint64 BackendRequestId, int Result);
+		void CompleteCall(uint64 RequestId, int Result);
+		void CompleteRequest(uint64 RequestId, const FInFlightRequest& Request, int Result);
+
+		TSharedRef<IOculusXRAnchorBackend> Backend;
+		TOptional<bool> bBatchingEnabled;
+
+		TArray<FPendingSave> PendingSaves;
+		TArray<FPendingErase> PendingErases;
+		TArray<FPendingQuery> PendingQueries;
+
+		TMap<uint64, FInFlightRequest> InFlightRequests;
+		TMap<uint64, FBackendRequest> BackendRequests;
+
+		FOculusXRAnchorBatcherStats Stats;
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+} // namespace OculusXRAnchors
@@ -0,0 +1,72 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "OculusXRAnchorBatcher.h"
+
+namespace OculusXRAnchors
+{
+	// In-process anchor storage that stands in for OVRPlugin, so the anchor request pipeline can run without a headset.
+	// Saved anchors are kept in memory and every call completes after a configurable latency, in the order it was made.
+	class OCULUSXRANCHORS_API FOculusXRLocalAnchorBackend : public IOculusXRAnchorBackend
+	{
+	public:
+		// Make a space known to the backend, as if it had been created in this session
+		void AddSpace(uint64 Space, const FOculusXRUUID& UUID);
+
+		// Time between a call and its completion
+		void SetLatency(double Seconds) { LatencySeconds = Seconds; }
+
+		// Complete every following call with this result instead of carrying it out
+		void SetSimulatedFailure(TOptional<EOculusXRAnchorResult::Type> Result) { SimulatedFailure = Result; }
+
+		// Reject save calls with unknown spaces right away, like OVRPlugin does for invalid handles, instead of failing
+		// them once they complete
+		void SetRejectUnknownSpaces(bool bReject) { bRejectUnknownSpaces = bReject; }
+
+		bool IsStored(const FOculusXRUUID& UUID) const { return StoredSpaces.Contains(UUID); }
+		int32 GetNumStored() const { return StoredSpaces.Num(); }
+		int32 GetNumPendingEvents() const { return PendingEvents.Num(); }
+
+		// IOculusXRAnchorBackend
+		virtual EOculusXRAnchorResult::Type SaveSpaces(const TArray<uint64>& Spaces, uint64& OutRequestId) override;
+		virtual EOculusXRAnchorResult::Type EraseSpaces(const TArray<FOculusXRUInt64>& Handles, const TArray<FOculusXRUUID>& UUIDs, uint64& OutRequestId) override;
+		virtual EOculusXRAnchorResult::Type QuerySpaces(const FOculusXRSpaceQueryInfo& QueryInfo, uint64& OutRequestId) override;
+		virtual void Tick(double Now, FOculusXRAnchorBatcher& Batcher) override;
+
+	private:
+		enum class EEventKind : uint8
+		{
+			Save,
+			Erase,
+			Query,
+		};
+
+		struct FPendingEvent
+		{
+			EEventKind Kind;
+			uint64 RequestId;
+			double DueTime;
+			TArray<uint64> Spaces;
+			TArray<FOculusXRUUID> UUIDs;
+			FOculusXRSpaceQueryInfo QueryInfo;
+		};
+
+		FPendingEvent& AddEvent(EEventKind Kind, uint64& OutRequestId);
+		void DeliverSave(const FPendingEvent& Event, FOculusXRAnchorBatcher& Batcher);
+		void DeliverErase(const FPendingEvent& Event, FOculusXRAnchorBatcher& Batcher);
+		void DeliverQuery(const FPendingEvent& Event, FOculusXRAnchorBatcher& Batcher);
+
+		// Spaces of this session and the anchors in storage
+		TMap<uint64, FOculusXRUUID> SessionSpaces;
+		TMap<FOculusXRUUID, uint64> StoredSpaces;
+
+		TArray<FPendingEvent> PendingEvents;
+		double LatencySeconds = 0.0;
+		double CurrentTime = 0.0;
+		uint64 NextRequestId = 0;
+		TOptional<EOculusXRAnchorResult::Type> SimulatedFailure;
+		bool bRejectUnknownSpaces = false;
+	};
+} // namespace OculusXRAnchors
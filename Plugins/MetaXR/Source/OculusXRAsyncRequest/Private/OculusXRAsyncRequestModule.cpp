@@ -3,10 +3,10 @@
 
 #include "OculusXRAsyncRequestModule.h"
 
-#if OCULUS_ASYNC_REQUEST_SUPPORTED_PLATFORMS
-
 DEFINE_LOG_CATEGORY(LogOculusXRAsyncRequest);
 
+#if OCULUS_ASYNC_REQUEST_SUPPORTED_PLATFORMS
+
 #define LOCTEXT_NAMESPACE "OculusXRAsyncRequest"
 
 void FOculusXRAsyncRequestModule::StartupModule()
@@ -20,28 +20,43 @@ UOculusXRAsyncRequestSubsystem* UOculusXRAsyncRequestSubsystem::GetSubsystem()
 			{
 				if (Context.WorldType == EWorldType::PIE)
 				{
-					return Context.World()->GetGameInstance()->GetSubsystem<UOculusXRAsyncRequestSubsystem>();
+					const UWorld* World = Context.World();
+					const UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+					return GameInstance ? GameInstance->GetSubsystem<UOculusXRAsyncRequestSubsystem>() : nullptr;
 				}
 			}
 		}
 #endif // WITH_EDITOR
 
-		return GWorld->GetGameInstance()->GetSubsystem<UOculusXRAsyncRequestSubsystem>();
+		const UGameInstance* GameInstance = GWorld->GetGameInstance();
+		return GameInstance ? GameInstance->GetSubsystem<UOculusXRAsyncRequestSubsystem>() : nullptr;
 	}
 
 	return nullptr;
 }
 
-OculusXR::FAsyncRequestSystem* UOculusXRAsyncRequestSubsystem::GetRequestSystem()
+TSharedPtr<OculusXR::FAsyncRequestSystem> UOculusXRAsyncRequestSubsystem::GetRequestSystem()
 {
-	return (GetSubsystem()->RequestSystem).Get();
+	const UOculusXRAsyncRequestSubsystem* Subsystem = GetSubsystem();
+	return Subsystem ? Subsystem->RequestSystem : nullptr;
 }
 
 void UOculusXRAsyncRequestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	RequestSystem = MakeShared<OculusXR::FAsyncRequestSystem>();
+
+	// Requests with a deadline are completed with their timeout result once it has passed
+	TimeoutTickerHandle = FTSTicker::GetCoreTicker().AddTicker(TEXT("OculusXRAsyncRequestTimeouts"), 0.0f, [System = RequestSystem](float) {
+		System->ProcessTimeouts(FPlatformTime::Seconds());
+		return true;
+	});
 }
 
 void UOculusXRAsyncRequestSubsystem::Deinitialize()
 {
+	FTSTicker::GetCoreTicker().RemoveTicker(TimeoutTickerHandle);
+	TimeoutTickerHandle.Reset();
+
+	// Threads that still hold on to the system keep it alive until they are done with it
+	RequestSystem.Reset();
 }
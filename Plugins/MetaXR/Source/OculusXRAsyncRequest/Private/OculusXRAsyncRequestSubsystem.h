@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "Containers/Ticker.h"
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "OculusXRAsyncRequestSubsystem.generated.h"
 
@@ -16,11 +17,12 @@ class OCULUSXRASYNCREQUEST_API UOculusXRAsyncRequestSubsystem : public UGameInst
 	GENERATED_BODY()
 public:
 	static UOculusXRAsyncRequestSubsystem* GetSubsystem();
-	static OculusXR::FAsyncRequestSystem* GetRequestSystem();
+	static TSharedPtr<OculusXR::FAsyncRequestSystem> GetRequestSystem();
 
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
 private:
 	TSharedPtr<OculusXR::FAsyncRequestSystem> RequestSystem;
+	FTSTicker::FDelegateHandle TimeoutTickerHandle;
 };
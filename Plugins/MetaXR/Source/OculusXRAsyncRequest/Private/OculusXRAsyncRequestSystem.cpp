@@ -1,22 +1,274 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "OculusXRAsyncRequestSystem.h"
+#include "OculusXRAsyncRequestModule.h"
 #include "OculusXRAsyncRequestSubsystem.h"
+#include <HAL/PlatformTime.h>
+
+namespace
+{
+	// Event ids are unique across all request systems, which lets requests be created before they are added to one
+	std::atomic<uint64> AsyncRequestEventIdCounter(0);
+
+	// All systems that are alive, in the order they have been created
+	FRWLock AsyncRequestSystemsLock;
+	TArray<OculusXR::FAsyncRequestSystem*> AsyncRequestSystems;
+
+	int32 GetLatencyBucket(double LatencyMs)
+	{
+		for (int32 Bucket = 0; Bucket < OculusXR::FAsyncRequestSystemStats::NumLatencyBuckets - 1; ++Bucket)
+		{
+			if (LatencyMs <= OculusXR::FAsyncRequestSystemStats::LatencyBucketUpperBoundsMs[Bucket])
+			{
+				return Bucket;
+			}
+		}
+		return OculusXR::FAsyncRequestSystemStats::NumLatencyBuckets - 1;
+	}
+} // namespace
 
 namespace OculusXR
 {
+	const double FAsyncRequestSystemStats::LatencyBucketUpperBoundsMs[NumLatencyBuckets - 1] = {
+		1.0, 2.0, 5.0, 10.0, 25.0, 50.0, 100.0, 250.0, 500.0, 1000.0, 2500.0, 5000.0, 10000.0
+	};
+
 	FAsyncRequestSystem::FAsyncRequestSystem()
-		: EventIdCounter(0)
+		: NumCreated(0)
+		, NumCompleted(0)
+		, NumTimedOut(0)
+		, NumRemoved(0)
+		, NumInFlight(0)
 	{
+		for (std::atomic<uint64>& Count : LatencyHistogram)
+		{
+			Count.store(0, std::memory_order_relaxed);
+		}
+
+		FWriteScopeLock Lock(AsyncRequestSystemsLock);
+		AsyncRequestSystems.Add(this);
+	}
+
+	FAsyncRequestSystem::~FAsyncRequestSystem()
+	{
+		{
+			FWriteScopeLock Lock(AsyncRequestSystemsLock);
+			AsyncRequestSystems.Remove(this);
+		}
+
+		const int64 Leaked = NumInFlight.load();
+		if (Leaked > 0)
+		{
+			UE_LOG(LogOculusXRAsyncRequest, Warning, TEXT("Async request system destroyed with %lld requests that never completed"), Leaked);
+		}
 	}
 
 	FAsyncRequestBase::EventId FAsyncRequestSystem::GenerateEventId()
 	{
-		return FAsyncRequestBase::EventId(++(GetInstance().EventIdCounter));
+		return FAsyncRequestBase::EventId(++AsyncRequestEventIdCounter);
+	}
+
+	FAsyncRequestSystemStats FAsyncRequestSystem::GetStats()
+	{
+		const TSharedPtr<FAsyncRequestSystem> System = GetInstance();
+		return System ? System->GetInstanceStats() : FAsyncRequestSystemStats();
+	}
+
+	TSharedPtr<FAsyncRequestSystem> FAsyncRequestSystem::GetInstance()
+	{
+		if (IsInGameThread())
+		{
+			return UOculusXRAsyncRequestSubsystem::GetRequestSystem();
+		}
+
+		// Looking up the subsystem needs the world, which is only safe on the game thread. The oldest system belongs to
+		// the first game instance, which is the one the game thread resolves to as well. A system that is being destroyed
+		// can't be pinned anymore, but it stays in the list until its destructor got the write lock, so it is safe to try.
+		FReadScopeLock Lock(AsyncRequestSystemsLock);
+		for (FAsyncRequestSystem* System : AsyncRequestSystems)
+		{
+			if (TSharedPtr<FAsyncRequestSystem> Pinned = System->AsWeak().Pin())
+			{
+				return Pinned;
+			}
+		}
+		return nullptr;
+	}
+
+	void FAsyncRequestSystem::ReportMissingInstance()
+	{
+		UE_LOG(LogOculusXRAsyncRequest, Warning, TEXT("No async request system available, the request will not be tracked"));
+	}
+
+	TSharedPtr<FAsyncRequestBase> FAsyncRequestSystem::FindRequest(FAsyncRequestBase::EventId Id) const
+	{
+		const FRequestShard& Shard = GetShard(Id);
+		FReadScopeLock Lock(Shard.Lock);
+		const FRequestEntry* Entry = Shard.Requests.Find(Id);
+		return Entry ? Entry->Request : nullptr;
+	}
+
+	TSharedPtr<FAsyncRequestBase> FAsyncRequestSystem::FindRequest(FAsyncRequestBase::RequestId Id) const
+	{
+		TOptional<FAsyncRequestBase::EventId> EventId;
+		{
+			const FRequestIdShard& Shard = GetShard(Id);
+			FReadScopeLock Lock(Shard.Lock);
+			if (const FAsyncRequestBase::EventId* Found = Shard.RequestIdToEventIdMap.Find(Id))
+			{
+				EventId = *Found;
+			}
+		}
+
+		return EventId.IsSet() ? FindRequest(EventId.GetValue()) : nullptr;
 	}
 
-	FAsyncRequestSystem& FAsyncRequestSystem::GetInstance()
+	void FAsyncRequestSystem::MapRequestId(FAsyncRequestBase::EventId EventId, FAsyncRequestBase::RequestId RequestId)
 	{
-		return *UOculusXRAsyncRequestSubsystem::GetRequestSystem();
+		// The request may complete on another thread before its request id got mapped. Holding the lock of its shard keeps
+		// it from being taken until the mapping is in place, which TakeEntry then removes again.
+		const FRequestShard& Shard = GetShard(EventId);
+		FReadScopeLock Lock(Shard.Lock);
+		if (!Shard.Requests.Contains(EventId))
+		{
+			return;
+		}
+
+		FRequestIdShard& RequestIdShard = GetShard(RequestId);
+		FWriteScopeLock RequestIdLock(RequestIdShard.Lock);
+		RequestIdShard.RequestIdToEventIdMap.Add(RequestId, EventId);
+	}
+
+	void FAsyncRequestSystem::AddRequestInternal(const TSharedPtr<FAsyncRequestBase>& Request)
+	{
+		FRequestEntry Entry;
+		Entry.Request = Request;
+		Entry.CreationTime = FPlatformTime::Seconds();
+
+		FRequestShard& Shard = GetShard(Request->GetEventId());
+		{
+			FWriteScopeLock Lock(Shard.Lock);
+			Shard.Requests.Add(Request->GetEventId(), MoveTemp(Entry));
+		}
+
+		NumCreated.fetch_add(1, std::memory_order_relaxed);
+		NumInFlight.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	TSharedPtr<FAsyncRequestBase> FAsyncRequestSystem::TakeRequest(FAsyncRequestBase::EventId Id, ETakeReason Reason)
+	{
+		TOptional<FRequestEntry> Entry = TakeEntry(Id, Reason, FPlatformTime::Seconds());
+		return Entry.IsSet() ? MoveTemp(Entry->Request) : nullptr;
+	}
+
+	TOptional<FAsyncRequestSystem::FRequestEntry> FAsyncRequestSystem::TakeEntry(FAsyncRequestBase::EventId Id, ETakeReason Reason, double Now)
+	{
+		FRequestEntry Entry;
+		{
+			FRequestShard& Shard = GetShard(Id);
+			FWriteScopeLock Lock(Shard.Lock);
+			if (!Shard.Requests.RemoveAndCopyValue(Id, Entry))
+			{
+				return {};
+			}
+		}
+
+		const FAsyncRequestBase::RequestId RequestId = Entry.Request->GetRequestId();
+		if (RequestId.Id != INVALID_TASK_REQUEST_ID)
+		{
+			FRequestIdShard& Shard = GetShard(RequestId);
+			FWriteScopeLock Lock(Shard.Lock);
+			Shard.RequestIdToEventIdMap.Remove(RequestId);
+		}
+
+		NumInFlight.fetch_sub(1, std::memory_order_relaxed);
+		switch (Reason)
+		{
+			case ETakeReason::Completed:
+				NumCompleted.fetch_add(1, std::memory_order_relaxed);
+				break;
+			case ETakeReason::TimedOut:
+				NumTimedOut.fetch_add(1, std::memory_order_relaxed);
+				break;
+			case ETakeReason::Removed:
+				NumRemoved.fetch_add(1, std::memory_order_relaxed);
+				return Entry;
+		}
+		LatencyHistogram[GetLatencyBucket((Now - Entry.CreationTime) * 1000.0)].fetch_add(1, std::memory_order_relaxed);
+
+		return Entry;
+	}
+
+	void FAsyncRequestSystem::SetDeadline(FAsyncRequestBase::EventId Id, double Deadline, FTimeoutHandler&& TimeoutHandler)
+	{
+		FRequestShard& Shard = GetShard(Id);
+		FWriteScopeLock Lock(Shard.Lock);
+		if (FRequestEntry* Entry = Shard.Requests.Find(Id))
+		{
+			Entry->Deadline = Deadline;
+			Entry->TimeoutHandler = MoveTemp(TimeoutHandler);
+		}
+	}
+
+	int32 FAsyncRequestSystem::ProcessTimeouts(double Now)
+	{
+		TArray<FAsyncRequestBase::EventId, TInlineAllocator<16>> Expired;
+		for (const FRequestShard& Shard : Shards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			for (const auto& Pair : Shard.Requests)
+			{
+				if (Pair.Value.Deadline <= Now)
+				{
+					Expired.Add(Pair.Key);
+				}
+			}
+		}
+
+		// The handlers run without holding any lock, they call into the request which might create new requests. A
+		// request that completed in the meantime is simply not found anymore.
+		int32 NumExpired = 0;
+		for (const FAsyncRequestBase::EventId Id : Expired)
+		{
+			TOptional<FRequestEntry> Entry = TakeEntry(Id, ETakeReason::TimedOut, Now);
+			if (Entry.IsSet())
+			{
+				Entry->TimeoutHandler(Entry->Request);
+				++NumExpired;
+			}
+		}
+
+		return NumExpired;
+	}
+
+	FAsyncRequestSystemStats FAsyncRequestSystem::GetInstanceStats() const
+	{
+		FAsyncRequestSystemStats Stats;
+		Stats.NumCreated = NumCreated.load(std::memory_order_relaxed);
+		Stats.NumCompleted = NumCompleted.load(std::memory_order_relaxed);
+		Stats.NumTimedOut = NumTimedOut.load(std::memory_order_relaxed);
+		Stats.NumRemoved = NumRemoved.load(std::memory_order_relaxed);
+		Stats.NumInFlight = NumInFlight.load(std::memory_order_relaxed);
+		for (int32 Bucket = 0; Bucket < FAsyncRequestSystemStats::NumLatencyBuckets; ++Bucket)
+		{
+			Stats.LatencyHistogram[Bucket] = LatencyHistogram[Bucket].load(std::memory_order_relaxed);
+		}
+
+		const double LeakTime = FPlatformTime::Seconds() - LeakThresholdSeconds;
+		for (const FRequestShard& Shard : Shards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			for (const auto& Pair : Shard.Requests)
+			{
+				Stats.NumLeaked += Pair.Value.CreationTime < LeakTime ? 1 : 0;
+			}
+		}
+		for (const FRequestIdShard& Shard : RequestIdShards)
+		{
+			FReadScopeLock Lock(Shard.Lock);
+			Stats.NumMappedRequestIds += Shard.RequestIdToEventIdMap.Num();
+		}
+
+		return Stats;
 	}
 } // namespace OculusXR
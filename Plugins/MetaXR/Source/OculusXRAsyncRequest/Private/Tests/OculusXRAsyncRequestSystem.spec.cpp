@@ -0,0 +1,200 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Misc/AutomationTest.h"
+#include "OculusXRAsyncRequest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	enum class EStressRequestResult : uint8
+	{
+		Success,
+		Failure,
+		Timeout,
+	};
+
+	struct FStressRequest : public OculusXR::FAsyncRequest<FStressRequest, EStressRequestResult, int32>
+	{
+		FStressRequest(int32 InIndex)
+			: Index(InIndex)
+		{
+		}
+
+		void AssignRequestId(uint64 Id) { SetRequestId(RequestId(Id)); }
+
+		int32 Index;
+	};
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRAsyncRequestSystemSpec, TEXT("Async Request System"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+END_DEFINE_SPEC(FOculusXRAsyncRequestSystemSpec)
+
+void FOculusXRAsyncRequestSystemSpec::Define()
+{
+	Describe(TEXT("Request registry"), [this] {
+		It(TEXT("Completes a request exactly once"), [this] {
+			OculusXR::FAsyncRequestSystem System;
+			int32 NumCompletions = 0;
+			auto Request = System.AddRequest<FStressRequest>(0);
+			Request->BindOnComplete(FStressRequest::FCompleteDelegate::CreateLambda([&NumCompletions](const FStressRequest::FResultType&) { ++NumCompletions; }));
+			Request->AssignRequestId(42);
+			System.MapRequestId(Request->GetEventId(), Request->GetRequestId());
+
+			TestTrue(TEXT("Request is found by its request id"), System.FindRequest(OculusXR::FAsyncRequestBase::RequestId(42)) == Request);
+
+			System.Complete<FStressRequest>(Request->GetEventId(), FStressRequest::FResultType::FromResult(EStressRequestResult::Success, 7));
+			System.Complete<FStressRequest>(Request->GetEventId(), FStressRequest::FResultType::FromError(EStressRequestResult::Failure));
+
+			TestEqual(TEXT("Completion delegate fired once"), NumCompletions, 1);
+			TestTrue(TEXT("First result wins"), Request->GetResult().IsSuccess());
+			TestFalse(TEXT("Request id mapping is gone"), System.FindRequest(OculusXR::FAsyncRequestBase::RequestId(42)).IsValid());
+			TestEqual(TEXT("Nothing in flight"), System.GetInstanceStats().NumInFlight, 0ll);
+		});
+
+		It(TEXT("Doesn't map the request id of a request that already completed"), [this] {
+			OculusXR::FAsyncRequestSystem System;
+			auto Request = System.AddRequest<FStressRequest>(0);
+			Request->AssignRequestId(42);
+			System.Complete<FStressRequest>(Request->GetEventId(), FStressRequest::FResultType::FromResult(EStressRequestResult::Success, 7));
+			System.MapRequestId(Request->GetEventId(), Request->GetRequestId());
+
+			TestFalse(TEXT("Request isn't found by its request id"), System.FindRequest(OculusXR::FAsyncRequestBase::RequestId(42)).IsValid());
+			TestEqual(TEXT("No request id is mapped"), System.GetInstanceStats().NumMappedRequestIds, 0ll);
+		});
+
+		It(TEXT("Times out requests past their deadline"), [this] {
+			OculusXR::FAsyncRequestSystem System;
+			auto Expiring = System.AddRequest<FStressRequest>(0);
+			auto Waiting = System.AddRequest<FStressRequest>(1);
+			System.SetTimeout<FStressRequest>(Expiring->GetEventId(), 0.0, FStressRequest::FResultType::FromError(EStressRequestResult::Timeout));
+			System.SetTimeout<FStressRequest>(Waiting->GetEventId(), 3600.0, FStressRequest::FResultType::FromError(EStressRequestResult::Timeout));
+
+			TestEqual(TEXT("One request timed out"), System.ProcessTimeouts(FPlatformTime::Seconds()), 1);
+			TestTrue(TEXT("Expired request is complete"), Expiring->IsComplete());
+			TestTrue(TEXT("Expired request has the timeout result"), Expiring->GetResult().GetStatus() == EStressRequestResult::Timeout);
+			TestFalse(TEXT("Request with a later deadline is still waiting"), Waiting->IsComplete());
+
+			const OculusXR::FAsyncRequestSystemStats Stats = System.GetInstanceStats();
+			TestEqual(TEXT("Timed out counter"), Stats.NumTimedOut, 1ull);
+			TestEqual(TEXT("In flight counter"), Stats.NumInFlight, 1ll);
+
+			System.SetLeakThreshold(0.0);
+			TestEqual(TEXT("Waiting request is reported as leaked past the leak threshold"), System.GetInstanceStats().NumLeaked, 1ll);
+			System.Remove(Waiting->GetEventId());
+		});
+
+		It(TEXT("Survives creating and completing requests from many threads"), [this] {
+			OculusXR::FAsyncRequestSystem System;
+			constexpr int32 NumWorkers = 16;
+			constexpr int32 NumRequestsPerWorker = 20000;
+			constexpr int32 NumRequests = NumWorkers * NumRequestsPerWorker;
+
+			TUniquePtr<std::atomic<int32>[]> Completions = MakeUnique<std::atomic<int32>[]>(NumRequests);
+			for (int32 Index = 0; Index < NumRequests; ++Index)
+			{
+				Completions[Index].store(0);
+			}
+
+			// Each worker publishes the last request it created, so its neighbour can race it to completion
+			std::atomic<uint64> LastEventIds[NumWorkers];
+			for (std::atomic<uint64>& Id : LastEventIds)
+			{
+				Id.store(0);
+			}
+
+			// Deadlines are processed concurrently to the workers
+			std::atomic<bool> bWorkersDone(false);
+			TFuture<void> TimeoutThread = Async(EAsyncExecution::Thread, [&System, &bWorkersDone]() {
+				while (!bWorkersDone.load())
+				{
+					System.ProcessTimeouts(FPlatformTime::Seconds());
+					FPlatformProcess::Yield();
+				}
+			});
+
+			const double StartTime = FPlatformTime::Seconds();
+			ParallelFor(NumWorkers, [&](int32 Worker) {
+				FRandomStream RandomStream(Worker);
+				for (int32 Local = 0; Local < NumRequestsPerWorker; ++Local)
+				{
+					const int32 Index = Worker * NumRequestsPerWorker + Local;
+					auto Request = System.AddRequest<FStressRequest>(Index);
+					Request->BindOnComplete(FStressRequest::FCompleteDelegate::CreateLambda([&Completions, Index](const FStressRequest::FResultType&) {
+						Completions[Index].fetch_add(1);
+					}));
+					Request->AssignRequestId(static_cast<uint64>(Index) + 1);
+					System.MapRequestId(Request->GetEventId(), Request->GetRequestId());
+					LastEventIds[Worker].store(Request->GetEventId().Id);
+
+					switch (RandomStream.RandRange(0, 3))
+					{
+						case 0:
+							System.Complete<FStressRequest>(Request->GetEventId(), FStressRequest::FResultType::FromResult(EStressRequestResult::Success, Index));
+							break;
+						case 1:
+							// Complete through the request id like the event polling does
+							if (auto Found = System.FindRequest(OculusXR::FAsyncRequestBase::RequestId(static_cast<uint64>(Index) + 1)))
+							{
+								System.Complete<FStressRequest>(Found->GetEventId(), FStressRequest::FResultType::FromResult(EStressRequestResult::Success, Index));
+							}
+							break;
+						case 2:
+							System.SetTimeout<FStressRequest>(Request->GetEventId(), 0.0, FStressRequest::FResultType::FromError(EStressRequestResult::Timeout));
+							break;
+						default:
+							break;
+					}
+
+					// Race the neighbouring worker for its latest request, which may also be timing out right now
+					const uint64 NeighbourEventId = LastEventIds[(Worker + 1) % NumWorkers].load();
+					if (NeighbourEventId != 0)
+					{
+						System.Complete<FStressRequest>(OculusXR::FAsyncRequestBase::EventId(NeighbourEventId), FStressRequest::FResultType::FromError(EStressRequestResult::Failure));
+					}
+				}
+			});
+			const double WorkerSeconds = FPlatformTime::Seconds() - StartTime;
+
+			bWorkersDone.store(true);
+			TimeoutThread.Wait();
+
+			// Whatever is left behind by the random choices is timed out now
+			for (int32 Index = 0; Index < NumRequests; ++Index)
+			{
+				if (auto Found = System.FindRequest(OculusXR::FAsyncRequestBase::RequestId(static_cast<uint64>(Index) + 1)))
+				{
+					System.SetTimeout<FStressRequest>(Found->GetEventId(), 0.0, FStressRequest::FResultType::FromError(EStressRequestResult::Timeout));
+				}
+			}
+			System.ProcessTimeouts(FPlatformTime::Seconds());
+
+			int32 NumWrong = 0;
+			for (int32 Index = 0; Index < NumRequests; ++Index)
+			{
+				NumWrong += Completions[Index].load() != 1 ? 1 : 0;
+			}
+			TestEqual(TEXT("Every request completed exactly once"), NumWrong, 0);
+
+			const OculusXR::FAsyncRequestSystemStats Stats = System.GetInstanceStats();
+			TestEqual(TEXT("Nothing in flight"), Stats.NumInFlight, 0ll);
+			TestEqual(TEXT("No request id mapping is left behind"), Stats.NumMappedRequestIds, 0ll);
+			TestEqual(TEXT("Created counter"), Stats.NumCreated, static_cast<uint64>(NumRequests));
+			TestEqual(TEXT("Every request either completed or timed out"), Stats.NumCompleted + Stats.NumTimedOut, static_cast<uint64>(NumRequests));
+
+			uint64 NumInHistogram = 0;
+			for (const uint64 Count : Stats.LatencyHistogram)
+			{
+				NumInHistogram += Count;
+			}
+			TestEqual(TEXT("Latency histogram covers every finished request"), NumInHistogram, static_cast<uint64>(NumRequests));
+
+			AddInfo(FString::Printf(TEXT("%d requests on %d threads in %.2f ms, %llu completed and %llu timed out"), NumRequests, NumWorkers,
+				WorkerSeconds * 1000.0, Stats.NumCompleted, Stats.NumTimedOut));
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <Templates/TypeHash.h>
+#include <atomic>
 
 namespace OculusXR
 {
@@ -62,7 +63,7 @@ namespace OculusXR
 	public:
 		FAsyncRequestBase()
 			: InternalEventId(EventId(0))
-			, InternalRequestId(RequestId(INVALID_TASK_REQUEST_ID))
+			, InternalRequestId(INVALID_TASK_REQUEST_ID)
 		{
 			// The derived
 		}
@@ -92,14 +93,14 @@ namespace OculusXR
 		virtual ~FAsyncRequestBase() {}
 
 		EventId GetEventId() const { return InternalEventId; }
-		RequestId GetRequestId() const { return InternalRequestId; }
+		RequestId GetRequestId() const { return RequestId(InternalRequestId.load(std::memory_order_acquire)); }
 
 	protected:
 		void SetEventId(EventId InEventId) { InternalEventId = InEventId; }
-		void SetRequestId(RequestId InRequestId) { InternalRequestId = InRequestId; }
+		void SetRequestId(RequestId InRequestId) { InternalRequestId.store(InRequestId.Id, std::memory_order_release); }
 
 	private:
-		EventId InternalEventId;	 // Unique identifier, set regardless of the request ID value
-		RequestId InternalRequestId; // Request id returned from successfully starting an async xr method
+		EventId InternalEventId;				// Unique identifier, set regardless of the request ID value
+		std::atomic<uint64_t> InternalRequestId; // Request id returned from successfully starting an async xr method, read by the thread that completes the request
 	};
 } // namespace OculusXR
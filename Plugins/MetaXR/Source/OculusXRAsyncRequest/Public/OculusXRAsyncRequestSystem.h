@@ -3,92 +3,221 @@
 #pragma once
 
 #include "OculusXRAsyncRequestBase.h"
+#include <Containers/Map.h>
+#include <Containers/StaticArray.h>
+#include <HAL/PlatformTime.h>
+#include <Misc/Optional.h>
+#include <Misc/ScopeRWLock.h>
+#include <Templates/Function.h>
 #include <Templates/SharedPointer.h>
 #include <atomic>
 
 namespace OculusXR
 {
-	class FAsyncRequestSystem
+	// Counters of a request system, see FAsyncRequestSystem::GetStats()
+	struct FAsyncRequestSystemStats
+	{
+		// Upper bounds of the latency histogram buckets in milliseconds, the last bucket holds everything above
+		static constexpr int32 NumLatencyBuckets = 14;
+		static OCULUSXRASYNCREQUEST_API const double LatencyBucketUpperBoundsMs[NumLatencyBuckets - 1];
+
+		uint64 NumCreated = 0;
+		uint64 NumCompleted = 0;
+		uint64 NumTimedOut = 0;
+		uint64 NumRemoved = 0;
+		int64 NumInFlight = 0;
+		// Requests that have been in flight for longer than the leak threshold
+		int64 NumLeaked = 0;
+		// Request ids that can be looked up, one per started request in flight
+		int64 NumMappedRequestIds = 0;
+		// Time from creation to completion or timeout of finished requests
+		TStaticArray<uint64, NumLatencyBuckets> LatencyHistogram{ InPlace, 0 };
+	};
+
+	// Registry of all requests in flight. Requests can be created, looked up and completed from any thread. The
+	// registry is split into shards that each have their own lock, so threads working on different requests rarely
+	// wait for each other. Completion delegates run on the thread that completes the request.
+	//
+	// The static functions work on the system of the current game instance. Before the subsystem has been initialized
+	// and after it has been deinitialized there is none, requests are then neither tracked nor completed.
+	class FAsyncRequestSystem : public TSharedFromThis<FAsyncRequestSystem>
 	{
 	public:
-		FAsyncRequestSystem();
+		OCULUSXRASYNCREQUEST_API FAsyncRequestSystem();
+		OCULUSXRASYNCREQUEST_API ~FAsyncRequestSystem();
 
 		static OCULUSXRASYNCREQUEST_API FAsyncRequestBase::EventId GenerateEventId();
 
 		template <typename RequestType, typename... TArgs>
 		static TSharedPtr<RequestType> CreateRequest(TArgs&&... Args)
 		{
-			auto request = MakeShared<RequestType>(std::forward<TArgs>(Args)...);
-			GetInstance().Requests.Add(request->GetEventId(), request);
-
-			return request;
+			if (const TSharedPtr<FAsyncRequestSystem> System = GetInstance())
+			{
+				return System->AddRequest<RequestType>(std::forward<TArgs>(Args)...);
+			}
+			// Hand out the request anyway so that callers don't have to check, it just won't be tracked
+			ReportMissingInstance();
+			return MakeShared<RequestType>(std::forward<TArgs>(Args)...);
 		}
 
 		static void RemoveRequest(FAsyncRequestBase::EventId Id)
 		{
-			auto& systemInstance = GetInstance();
-			auto foundPtr = systemInstance.Requests.Find(Id);
-			if (foundPtr)
+			if (const TSharedPtr<FAsyncRequestSystem> System = GetInstance())
 			{
-				systemInstance.RequestIdToEventIdMap.Remove((*foundPtr)->GetRequestId());
-				systemInstance.Requests.Remove(Id);
+				System->Remove(Id);
 			}
 		}
 
 		template <typename RequestType>
 		static TSharedPtr<RequestType> GetRequest(FAsyncRequestBase::EventId Id)
 		{
-			auto foundRequestPtr = GetInstance().Requests.Find(Id);
-			if (foundRequestPtr != nullptr)
-			{
-				return StaticCastSharedPtr<RequestType>(*foundRequestPtr);
-			}
-
-			return nullptr;
+			const TSharedPtr<FAsyncRequestSystem> System = GetInstance();
+			return System ? StaticCastSharedPtr<RequestType>(System->FindRequest(Id)) : nullptr;
 		}
 
 		template <typename RequestType>
 		static TSharedPtr<RequestType> GetRequest(FAsyncRequestBase::RequestId Id)
 		{
-			auto& systemInstance = GetInstance();
+			const TSharedPtr<FAsyncRequestSystem> System = GetInstance();
+			return System ? StaticCastSharedPtr<RequestType>(System->FindRequest(Id)) : nullptr;
+		}
 
-			auto foundEventId = systemInstance.RequestIdToEventIdMap.Find(Id);
-			if (foundEventId != nullptr)
+		template <typename RequestType>
+		static void SetRequestId(FAsyncRequestBase::EventId EventId, FAsyncRequestBase::RequestId RequestId)
+		{
+			if (const TSharedPtr<FAsyncRequestSystem> System = GetInstance())
 			{
-				auto foundRequestPtr = systemInstance.Requests.Find(*foundEventId);
-				if (foundRequestPtr)
-				{
-					return StaticCastSharedPtr<RequestType>(*foundRequestPtr);
-				}
+				System->MapRequestId(EventId, RequestId);
 			}
-
-			return nullptr;
 		}
 
 		template <typename RequestType>
-		static void SetRequestId(FAsyncRequestBase::EventId EventId, FAsyncRequestBase::RequestId RequestId)
+		static void CompleteRequest(FAsyncRequestBase::EventId EventId, const typename RequestType::FResultType& Result)
 		{
-			GetInstance().RequestIdToEventIdMap.Add(RequestId, EventId);
+			if (const TSharedPtr<FAsyncRequestSystem> System = GetInstance())
+			{
+				System->Complete<RequestType>(EventId, Result);
+			}
 		}
 
+		// Complete the request with TimeoutResult if it is still in flight after TimeoutSeconds
 		template <typename RequestType>
-		static void CompleteRequest(FAsyncRequestBase::EventId EventId, const typename RequestType::FResultType& Result)
+		static void SetRequestTimeout(FAsyncRequestBase::EventId EventId, double TimeoutSeconds, const typename RequestType::FResultType& TimeoutResult)
 		{
-			auto& systemInstance = GetInstance();
+			if (const TSharedPtr<FAsyncRequestSystem> System = GetInstance())
+			{
+				System->SetTimeout<RequestType>(EventId, TimeoutSeconds, TimeoutResult);
+			}
+		}
 
-			auto request = systemInstance.GetRequest<RequestType>(EventId);
+		static OCULUSXRASYNCREQUEST_API FAsyncRequestSystemStats GetStats();
+
+		// The following work on a specific system instead of the one of the current game instance
+
+		template <typename RequestType, typename... TArgs>
+		TSharedPtr<RequestType> AddRequest(TArgs&&... Args)
+		{
+			auto request = MakeShared<RequestType>(std::forward<TArgs>(Args)...);
+			AddRequestInternal(request);
+			return request;
+		}
+
+		template <typename RequestType>
+		void Complete(FAsyncRequestBase::EventId EventId, const typename RequestType::FResultType& Result)
+		{
+			// Whoever takes the request out of the registry completes it, so a request completes exactly once even if
+			// its result and its timeout arrive on different threads at the same time
+			TSharedPtr<FAsyncRequestBase> request = TakeRequest(EventId, ETakeReason::Completed);
 			if (request.IsValid())
 			{
-				request->RequestCompleted(Result);
-				systemInstance.RemoveRequest(EventId);
+				StaticCastSharedPtr<RequestType>(request)->RequestCompleted(Result);
 			}
 		}
 
+		template <typename RequestType>
+		void SetTimeout(FAsyncRequestBase::EventId EventId, double TimeoutSeconds, const typename RequestType::FResultType& TimeoutResult)
+		{
+			SetDeadline(EventId, FPlatformTime::Seconds() + TimeoutSeconds, [TimeoutResult](const TSharedPtr<FAsyncRequestBase>& Request) {
+				StaticCastSharedPtr<RequestType>(Request)->RequestCompleted(TimeoutResult);
+			});
+		}
+
+		// Drop the request without completing it
+		void Remove(FAsyncRequestBase::EventId Id)
+		{
+			TakeRequest(Id, ETakeReason::Removed);
+		}
+
+		OCULUSXRASYNCREQUEST_API TSharedPtr<FAsyncRequestBase> FindRequest(FAsyncRequestBase::EventId Id) const;
+		OCULUSXRASYNCREQUEST_API TSharedPtr<FAsyncRequestBase> FindRequest(FAsyncRequestBase::RequestId Id) const;
+		// Make the request findable by its request id. Does nothing if the request isn't in flight anymore.
+		OCULUSXRASYNCREQUEST_API void MapRequestId(FAsyncRequestBase::EventId EventId, FAsyncRequestBase::RequestId RequestId);
+
+		// Complete all requests whose deadline is before Now with their timeout result. Returns the number of requests that timed out.
+		OCULUSXRASYNCREQUEST_API int32 ProcessTimeouts(double Now);
+
+		OCULUSXRASYNCREQUEST_API FAsyncRequestSystemStats GetInstanceStats() const;
+
+		// Requests that are in flight for longer than this are reported as leaked
+		void SetLeakThreshold(double Seconds) { LeakThresholdSeconds = Seconds; }
+
 	private:
-		static OCULUSXRASYNCREQUEST_API FAsyncRequestSystem& GetInstance();
+		enum class ETakeReason : uint8
+		{
+			Completed,
+			TimedOut,
+			Removed,
+		};
+
+		typedef TFunction<void(const TSharedPtr<FAsyncRequestBase>&)> FTimeoutHandler;
 
-		TMap<FAsyncRequestBase::EventId, TSharedPtr<FAsyncRequestBase>> Requests;
-		TMap<FAsyncRequestBase::RequestId, FAsyncRequestBase::EventId> RequestIdToEventIdMap;
-		std::atomic<uint64_t> EventIdCounter;
+		struct FRequestEntry
+		{
+			TSharedPtr<FAsyncRequestBase> Request;
+			double CreationTime = 0.0;
+			double Deadline = TNumericLimits<double>::Max();
+			FTimeoutHandler TimeoutHandler;
+		};
+
+		// Event ids are handed out sequentially, so the low bits spread them evenly over the shards
+		static constexpr int32 NumShards = 16;
+
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FRequestShard
+		{
+			mutable FRWLock Lock;
+			TMap<FAsyncRequestBase::EventId, FRequestEntry> Requests;
+		};
+
+		struct alignas(PLATFORM_CACHE_LINE_SIZE) FRequestIdShard
+		{
+			mutable FRWLock Lock;
+			TMap<FAsyncRequestBase::RequestId, FAsyncRequestBase::EventId> RequestIdToEventIdMap;
+		};
+
+		// The system of the current game instance or null if there is none. The returned pointer keeps the system
+		// alive, even if its game instance shuts down in the meantime.
+		static OCULUSXRASYNCREQUEST_API TSharedPtr<FAsyncRequestSystem> GetInstance();
+		static OCULUSXRASYNCREQUEST_API void ReportMissingInstance();
+
+		FRequestShard& GetShard(FAsyncRequestBase::EventId Id) { return Shards[Id.Id & (NumShards - 1)]; }
+		const FRequestShard& GetShard(FAsyncRequestBase::EventId Id) const { return Shards[Id.Id & (NumShards - 1)]; }
+		FRequestIdShard& GetShard(FAsyncRequestBase::RequestId Id) { return RequestIdShards[GetTypeHash(Id) & (NumShards - 1)]; }
+		const FRequestIdShard& GetShard(FAsyncRequestBase::RequestId Id) const { return RequestIdShards[GetTypeHash(Id) & (NumShards - 1)]; }
+
+		OCULUSXRASYNCREQUEST_API void AddRequestInternal(const TSharedPtr<FAsyncRequestBase>& Request);
+		OCULUSXRASYNCREQUEST_API TSharedPtr<FAsyncRequestBase> TakeRequest(FAsyncRequestBase::EventId Id, ETakeReason Reason);
+		TOptional<FRequestEntry> TakeEntry(FAsyncRequestBase::EventId Id, ETakeReason Reason, double Now);
+		OCULUSXRASYNCREQUEST_API void SetDeadline(FAsyncRequestBase::EventId Id, double Deadline, FTimeoutHandler&& TimeoutHandler);
+
+		FRequestShard Shards[NumShards];
+		FRequestIdShard RequestIdShards[NumShards];
+
+		std::atomic<uint64> NumCreated;
+		std::atomic<uint64> NumCompleted;
+		std::atomic<uint64> NumTimedOut;
+		std::atomic<uint64> NumRemoved;
+		std::atomic<int64> NumInFlight;
+		std::atomic<uint64> LatencyHistogram[FAsyncRequestSystemStats::NumLatencyBuckets];
+		double LeakThresholdSeconds = 60.0;
 	};
 } // namespace OculusXR
@@ -22,6 +22,8 @@
 #include "OculusXRInputModule.h"
 #include "OculusXRInputState.h"
 
+#include <atomic>
+
 #define OCULUS_TO_UE4_SCALE 100.0f
 
 namespace OculusXRInput
@@ -41,235 +43,172 @@ namespace OculusXRInput
 		return ((IOculusXRHMDModule::IsAvailable() && FOculusXRHMDModule::GetPluginWrapper().IsInitialized()));
 	}
 
-	FQuat FOculusHandTracking::GetBoneRotation(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const EOculusXRBone BoneId)
+	// Snapshots handed out by GetHandSnapshot() on the game thread. Entries are never removed, so the references stay valid.
+	struct FCachedHandSnapshot
+	{
+		int32 ControllerIndex = 0;
+		EOculusXRHandType DeviceHand = EOculusXRHandType::None;
+		uint64 FrameNumber = MAX_uint64;
+		uint32 UpdateSerial = 0;
+		FOculusXRHandSnapshot Snapshot;
+	};
+	static TArray<TUniquePtr<FCachedHandSnapshot>> CachedHandSnapshots;
+	static std::atomic<uint32> HandStateUpdateSerial{ 0 };
+
+	const FOculusXRHandSnapshot& FOculusHandTracking::GetHandSnapshot(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
 	{
-		FQuat Rotation = FQuat::Identity;
-		if (BoneId <= EOculusXRBone::Invalid && BoneId >= EOculusXRBone::Bone_Max)
+		if (!IsInGameThread())
 		{
-			return Rotation;
+			// The cache belongs to the game thread, other threads get a snapshot of their own
+			static thread_local FOculusXRHandSnapshot ThreadSnapshot;
+			CaptureHandSnapshot(ControllerIndex, DeviceHand, ThreadSnapshot);
+			return ThreadSnapshot;
 		}
 
-#if OCULUS_INPUT_SUPPORTED_PLATFORMS
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
+		FCachedHandSnapshot* Cached = nullptr;
+		for (const TUniquePtr<FCachedHandSnapshot>& Entry : CachedHandSnapshots)
 		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
+			if (Entry->ControllerIndex == ControllerIndex && Entry->DeviceHand == DeviceHand)
 			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							const FOculusHandControllerState& HandState = HandPair.HandControllerStates[Hand];
-							int32 OvrBoneId = ToOvrBone(BoneId);
-							Rotation = HandState.BoneRotations[OvrBoneId];
-							break;
-						}
-					}
-				}
+				Cached = Entry.Get();
+				break;
 			}
 		}
-		else if (OculusXR::IsOpenXRSystem())
+
+		if (Cached == nullptr)
 		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				const EHandBoneId HandBoneId = ToHandBone(BoneId);
-				Rotation = HandState.BoneRotations[static_cast<int32>(HandBoneId)];
-			}
+			Cached = CachedHandSnapshots.Add_GetRef(MakeUnique<FCachedHandSnapshot>()).Get();
+			Cached->ControllerIndex = ControllerIndex;
+			Cached->DeviceHand = DeviceHand;
+		}
+
+		const uint32 UpdateSerial = HandStateUpdateSerial.load(std::memory_order_acquire);
+		if (Cached->FrameNumber != GFrameCounter || Cached->UpdateSerial != UpdateSerial)
+		{
+			CaptureHandSnapshot(ControllerIndex, DeviceHand, Cached->Snapshot);
+			Cached->FrameNumber = GFrameCounter;
+			Cached->UpdateSerial = UpdateSerial;
 		}
-#endif
 
-		return Rotation;
+		return Cached->Snapshot;
 	}
 
-	float FOculusHandTracking::GetHandScale(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
+	void FOculusHandTracking::CaptureHandSnapshot(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, FOculusXRHandSnapshot& OutSnapshot)
 	{
-#if OCULUS_INPUT_SUPPORTED_PLATFORMS
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
-		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
-			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							return HandPair.HandControllerStates[Hand].HandScale;
-						}
-					}
-				}
-			}
-		}
-		else if (OculusXR::IsOpenXRSystem())
+		OutSnapshot = FOculusXRHandSnapshot();
+		if (DeviceHand == EOculusXRHandType::None)
 		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				return HandState.HandScale;
-			}
+			return;
 		}
-#endif
-		return 1.0f;
-	}
 
-	EOculusXRTrackingConfidence FOculusHandTracking::GetTrackingConfidence(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
-	{
 #if OCULUS_INPUT_SUPPORTED_PLATFORMS
 		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
 		{
 			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
 			if (OculusXRInputModule.IsValid())
 			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
+				const FOculusHandControllerState* HandState = FindHandState(OculusXRInputModule->ControllerPairs, GetDeviceID(ControllerIndex), DeviceHand);
+				if (HandState != nullptr)
 				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							return HandPair.HandControllerStates[Hand].TrackingConfidence;
-						}
-					}
+					CopyHandState(*HandState, OutSnapshot);
 				}
 			}
 		}
 		else if (OculusXR::IsOpenXRSystem())
 		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				return HandState.TrackingConfidence;
-			}
+			const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
+			CopyHandState(InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand], OutSnapshot);
 		}
 #endif
-		return EOculusXRTrackingConfidence::Low;
 	}
 
-	EOculusXRTrackingConfidence FOculusHandTracking::GetFingerTrackingConfidence(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const EOculusHandAxes Finger)
+	void FOculusHandTracking::CopyHandState(const FOculusHandControllerState& HandState, FOculusXRHandSnapshot& OutSnapshot)
 	{
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
+		OutSnapshot.bIsValid = true;
+		OutSnapshot.bIsPositionValid = HandState.bIsPositionValid;
+		OutSnapshot.bIsPointerPoseValid = HandState.bIsPointerPoseValid;
+		OutSnapshot.bIsDominantHand = HandState.bIsDominantHand;
+		OutSnapshot.HandScale = HandState.HandScale;
+		OutSnapshot.TrackingConfidence = HandState.TrackingConfidence;
+		OutSnapshot.PointerPose = HandState.PointerPose;
+
+		for (int32 Finger = 0; Finger < (int32)EOculusHandAxes::TotalAxisCount; Finger++)
 		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
-			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							return HandPair.HandControllerStates[Hand].FingerConfidences[(int)Finger];
-						}
-					}
-				}
-			}
+			OutSnapshot.FingerConfidences[Finger] = HandState.FingerConfidences[Finger];
 		}
-		else if (OculusXR::IsOpenXRSystem())
+
+		// Both runtimes store the bones in EOculusXRBone order, see ToOvrBone() and ToHandBone()
+		for (int32 Bone = 0; Bone < (int32)EOculusXRBone::Bone_Max; Bone++)
 		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				return HandState.FingerConfidences[(int)Finger];
-			}
+			OutSnapshot.BoneRotations[Bone] = HandState.BoneRotations[Bone];
 		}
-		return EOculusXRTrackingConfidence::Low;
 	}
 
-	FTransform FOculusHandTracking::GetPointerPose(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const float WorldToMeters)
+	const FOculusHandControllerState* FOculusHandTracking::FindHandState(const TArray<FOculusControllerPair>& ControllerPairs, const FInputDeviceId DeviceId, const EOculusXRHandType DeviceHand)
 	{
-#if OCULUS_INPUT_SUPPORTED_PLATFORMS
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
+		if (DeviceHand == EOculusXRHandType::None)
 		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
-			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							FTransform PoseTransform = HandPair.HandControllerStates[Hand].PointerPose;
-							PoseTransform.SetLocation(PoseTransform.GetLocation() * WorldToMeters);
-							return PoseTransform;
-						}
-					}
-				}
-			}
+			return nullptr;
 		}
-		else if (OculusXR::IsOpenXRSystem())
+
+		for (const FOculusControllerPair& HandPair : ControllerPairs)
 		{
-			if (DeviceHand != EOculusXRHandType::None)
+			if (HandPair.DeviceId == DeviceId)
 			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				FTransform PoseTransform = HandState.PointerPose;
-				PoseTransform.SetLocation(PoseTransform.GetLocation() * WorldToMeters);
-				return PoseTransform;
+				ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
+				return &HandPair.HandControllerStates[Hand];
 			}
 		}
-#endif
 
-		return FTransform();
+		return nullptr;
 	}
 
-	bool FOculusHandTracking::IsPointerPoseValid(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
+	void FOculusHandTracking::OnHandStatesUpdated()
 	{
-#if OCULUS_INPUT_SUPPORTED_PLATFORMS
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
+		HandStateUpdateSerial.fetch_add(1, std::memory_order_release);
+	}
+
+	FQuat FOculusHandTracking::GetBoneRotation(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const EOculusXRBone BoneId)
+	{
+		if (BoneId >= EOculusXRBone::Bone_Max)
 		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
-			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							return HandPair.HandControllerStates[Hand].bIsPointerPoseValid;
-						}
-					}
-				}
-			}
+			return FQuat::Identity;
 		}
-		else if (OculusXR::IsOpenXRSystem())
+
+		return GetHandSnapshot(ControllerIndex, DeviceHand).BoneRotations[(int32)BoneId];
+	}
+
+	float FOculusHandTracking::GetHandScale(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
+	{
+		return GetHandSnapshot(ControllerIndex, DeviceHand).HandScale;
+	}
+
+	EOculusXRTrackingConfidence FOculusHandTracking::GetTrackingConfidence(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
+	{
+		return GetHandSnapshot(ControllerIndex, DeviceHand).TrackingConfidence;
+	}
+
+	EOculusXRTrackingConfidence FOculusHandTracking::GetFingerTrackingConfidence(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const EOculusHandAxes Finger)
+	{
+		return GetHandSnapshot(ControllerIndex, DeviceHand).FingerConfidences[(int)Finger];
+	}
+
+	FTransform FOculusHandTracking::GetPointerPose(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const float WorldToMeters)
+	{
+		const FOculusXRHandSnapshot& Snapshot = GetHandSnapshot(ControllerIndex, DeviceHand);
+		if (!Snapshot.bIsValid)
 		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				return HandState.bIsPointerPoseValid;
-			}
+			return FTransform();
 		}
-#endif
 
-		return false;
+		FTransform PoseTransform = Snapshot.PointerPose;
+		PoseTransform.SetLocation(PoseTransform.GetLocation() * WorldToMeters);
+		return PoseTransform;
+	}
+
+	bool FOculusHandTracking::IsPointerPoseValid(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
+	{
+		return GetHandSnapshot(ControllerIndex, DeviceHand).bIsPointerPoseValid;
 	}
 
 	bool FOculusHandTracking::IsHandTrackingEnabled()
@@ -296,74 +235,12 @@ namespace OculusXRInput
 
 	bool FOculusHandTracking::IsHandDominant(const int32 ControllerIndex, const EOculusXRHandType DeviceHand)
 	{
-#if OCULUS_INPUT_SUPPORTED_PLATFORMS
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
-		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
-			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							return HandPair.HandControllerStates[Hand].bIsDominantHand;
-						}
-					}
-				}
-			}
-		}
-		else if (OculusXR::IsOpenXRSystem())
-		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				return HandState.bIsDominantHand;
-			}
-		}
-#endif
-
-		return false;
+		return GetHandSnapshot(ControllerIndex, DeviceHand).bIsDominantHand;
 	}
 
 	bool FOculusHandTracking::IsHandPositionValid(int32 ControllerIndex, EOculusXRHandType DeviceHand)
 	{
-		if (OculusXRHMD::FOculusXRHMD::GetOculusXRHMD() != nullptr)
-		{
-			TSharedPtr<FOculusXRInput> OculusXRInputModule = StaticCastSharedPtr<FOculusXRInput>(IOculusXRInputModule::Get().GetInputDevice());
-			if (OculusXRInputModule.IsValid())
-			{
-				const FInputDeviceId InDeviceId = GetDeviceID(ControllerIndex);
-				TArray<FOculusControllerPair> ControllerPairs = OculusXRInputModule.Get()->ControllerPairs;
-				for (const FOculusControllerPair& HandPair : ControllerPairs)
-				{
-					if (HandPair.DeviceId == InDeviceId)
-					{
-						if (DeviceHand != EOculusXRHandType::None)
-						{
-							ovrpHand Hand = DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right;
-							return HandPair.HandControllerStates[Hand].bIsPositionValid;
-						}
-					}
-				}
-			}
-		}
-		else if (OculusXR::IsOpenXRSystem())
-		{
-			if (DeviceHand != EOculusXRHandType::None)
-			{
-				const FOculusXRInputModule* InputModule = static_cast<FOculusXRInputModule*>(&FOculusXRInputModule::Get());
-				const FOculusHandControllerState& HandState = InputModule->GetHandTrackingOpenXRExtension()->HandControllerStates[DeviceHand];
-				return HandState.bIsPositionValid;
-			}
-		}
-
-		return false;
+		return GetHandSnapshot(ControllerIndex, DeviceHand).bIsPositionValid;
 	}
 
 	bool FOculusHandTracking::GetHandSkeletalMesh(USkeletalMesh* HandSkeletalMesh, const EOculusXRHandType SkeletonType, const EOculusXRHandType MeshType, const float WorldToMeters)
@@ -19,9 +19,46 @@ DEFINE_LOG_CATEGORY_STATIC(LogOcHandTracking, Log, All);
 //-------------------------------------------------------------------------------------------------
 namespace OculusXRInput
 {
+	// Everything tracked about one hand, captured once per input update. Reading a whole hand from a snapshot looks the
+	// hand up once instead of once per bone.
+	struct FOculusXRHandSnapshot
+	{
+		// False if no hand state matched the request, all other members then keep their defaults
+		bool bIsValid = false;
+		bool bIsPositionValid = false;
+		bool bIsPointerPoseValid = false;
+		bool bIsDominantHand = false;
+		float HandScale = 1.0f;
+		EOculusXRTrackingConfidence TrackingConfidence = EOculusXRTrackingConfidence::Low;
+		EOculusXRTrackingConfidence FingerConfidences[(int32)EOculusHandAxes::TotalAxisCount] = {};
+
+		// In meters, like the runtime reports it
+		FTransform PointerPose = FTransform::Identity;
+
+		// Indexed by EOculusXRBone
+		FQuat BoneRotations[(int32)EOculusXRBone::Bone_Max];
+
+		FOculusXRHandSnapshot()
+		{
+			for (FQuat& BoneRotation : BoneRotations)
+			{
+				BoneRotation = FQuat::Identity;
+			}
+		}
+	};
+
 	class FOculusHandTracking
 	{
 	public:
+		// Snapshot of the hand, cached until the next frame or input update. Copy it to keep it longer.
+		static const FOculusXRHandSnapshot& GetHandSnapshot(const int32 ControllerIndex, const EOculusXRHandType DeviceHand);
+		static void CaptureHandSnapshot(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, FOculusXRHandSnapshot& OutSnapshot);
+		static void CopyHandState(const FOculusHandControllerState& HandState, FOculusXRHandSnapshot& OutSnapshot);
+		static const FOculusHandControllerState* FindHandState(const TArray<FOculusControllerPair>& ControllerPairs, const FInputDeviceId DeviceId, const EOculusXRHandType DeviceHand);
+
+		// Called by the input devices after they wrote new hand states, drops the cached snapshots
+		static void OnHandStatesUpdated();
+
 		// Oculus Hand Tracking
 		static FQuat GetBoneRotation(const int32 ControllerIndex, const EOculusXRHandType DeviceHand, const EOculusXRBone BoneId);
 		static float GetHandScale(const int32 ControllerIndex, const EOculusXRHandType DeviceHand);
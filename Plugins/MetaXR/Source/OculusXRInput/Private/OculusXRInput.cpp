@@ -903,6 +903,8 @@ namespace OculusXRInput
 					}
 				}
 			}
+
+			FOculusHandTracking::OnHandStatesUpdated();
 		}
 		UE_CLOG(OVR_DEBUG_LOGGING, LogOcInput, Log, TEXT(""));
 	}
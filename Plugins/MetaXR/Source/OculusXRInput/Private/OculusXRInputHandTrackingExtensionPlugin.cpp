@@ -1,6 +1,7 @@
 // Copyright (c) Meta Platforms, Inc. and affiliates.
 
 #include "OculusXRInputHandTrackingExtensionPlugin.h"
+#include "OculusXRHandTracking.h"
 #include "OculusXRHMDRuntimeSettings.h"
 #include "IOpenXRHMDModule.h"
 #include "OpenXRCore.h"
@@ -628,6 +629,8 @@ namespace OculusXRInput
 				}
 			}
 		}
+
+		FOculusHandTracking::OnHandStatesUpdated();
 	}
 
 	bool FHandTrackingExtensionPlugin::IsHandTrackingEnabled()
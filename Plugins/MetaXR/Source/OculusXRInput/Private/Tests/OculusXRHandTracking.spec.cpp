@@ -0,0 +1,166 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "Misc/AutomationTest.h"
+#include "IOculusXRInputModule.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+#if OCULUS_INPUT_SUPPORTED_PLATFORMS
+
+#include "OculusXRHandTracking.h"
+
+namespace
+{
+	OculusXRInput::FOculusControllerPair MakeHandTrackingTestPair(int32 InternalId)
+	{
+		OculusXRInput::FOculusControllerPair Pair;
+		Pair.DeviceId = FInputDeviceId::CreateFromInternalId(InternalId);
+
+		for (int32 HandIndex = 0; HandIndex < UE_ARRAY_COUNT(Pair.HandControllerStates); ++HandIndex)
+		{
+			OculusXRInput::FOculusHandControllerState& HandState = Pair.HandControllerStates[HandIndex];
+			HandState.HandScale = 1.0f + InternalId + HandIndex * 0.5f;
+			HandState.TrackingConfidence = EOculusXRTrackingConfidence::High;
+			HandState.bIsPointerPoseValid = true;
+			HandState.bIsDominantHand = HandIndex == 1;
+			HandState.bIsPositionValid = true;
+			HandState.PointerPose = FTransform(FVector(InternalId, HandIndex, 1.0));
+			HandState.FingerConfidences[(int32)OculusXRInput::EOculusHandAxes::Index] = EOculusXRTrackingConfidence::High;
+			for (int32 Bone = 0; Bone < (int32)EOculusXRBone::Bone_Max; ++Bone)
+			{
+				HandState.BoneRotations[Bone] = FQuat(FVector::UpVector, Bone * 0.1f + HandIndex);
+			}
+		}
+
+		return Pair;
+	}
+
+	// Reads a whole hand the way the getters did before snapshots: every read copies the controller pairs and scans them
+	float ReadHandByCopy(const TArray<OculusXRInput::FOculusControllerPair>& LiveControllerPairs, FInputDeviceId DeviceId, EOculusXRHandType DeviceHand)
+	{
+		float Sum = 0.0f;
+		auto ReadHandState = [&](TFunctionRef<float(const OculusXRInput::FOculusHandControllerState&)> Read) {
+			TArray<OculusXRInput::FOculusControllerPair> ControllerPairs = LiveControllerPairs;
+			for (const OculusXRInput::FOculusControllerPair& HandPair : ControllerPairs)
+			{
+				if (HandPair.DeviceId == DeviceId)
+				{
+					Sum += Read(HandPair.HandControllerStates[DeviceHand == EOculusXRHandType::HandLeft ? ovrpHand_Left : ovrpHand_Right]);
+					break;
+				}
+			}
+		};
+
+		for (int32 Bone = 0; Bone < (int32)EOculusXRBone::Bone_Max; ++Bone)
+		{
+			ReadHandState([Bone](const OculusXRInput::FOculusHandControllerState& HandState) { return HandState.BoneRotations[Bone].W; });
+		}
+		ReadHandState([](const OculusXRInput::FOculusHandControllerState& HandState) { return HandState.HandScale; });
+		ReadHandState([](const OculusXRInput::FOculusHandControllerState& HandState) { return (float)HandState.TrackingConfidence; });
+		ReadHandState([](const OculusXRInput::FOculusHandControllerState& HandState) { return (float)HandState.PointerPose.GetLocation().X; });
+		return Sum;
+	}
+
+	float ReadHandBySnapshot(const TArray<OculusXRInput::FOculusControllerPair>& LiveControllerPairs, FInputDeviceId DeviceId, EOculusXRHandType DeviceHand, OculusXRInput::FOculusXRHandSnapshot& Snapshot)
+	{
+		Snapshot = OculusXRInput::FOculusXRHandSnapshot();
+		if (const OculusXRInput::FOculusHandControllerState* HandState = OculusXRInput::FOculusHandTracking::FindHandState(LiveControllerPairs, DeviceId, DeviceHand))
+		{
+			OculusXRInput::FOculusHandTracking::CopyHandState(*HandState, Snapshot);
+		}
+
+		float Sum = 0.0f;
+		for (int32 Bone = 0; Bone < (int32)EOculusXRBone::Bone_Max; ++Bone)
+		{
+			Sum += Snapshot.BoneRotations[Bone].W;
+		}
+		Sum += Snapshot.HandScale;
+		Sum += (float)Snapshot.TrackingConfidence;
+		Sum += (float)Snapshot.PointerPose.GetLocation().X;
+		return Sum;
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRHandTrackingSpec, TEXT("OculusXR.Input.HandTracking"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TArray<OculusXRInput::FOculusControllerPair> ControllerPairs;
+END_DEFINE_SPEC(FOculusXRHandTrackingSpec)
+
+void FOculusXRHandTrackingSpec::Define()
+{
+	BeforeEach([this]() {
+		ControllerPairs.Reset();
+		ControllerPairs.Add(MakeHandTrackingTestPair(0));
+		ControllerPairs.Add(MakeHandTrackingTestPair(1));
+	});
+
+	Describe(TEXT("FindHandState"), [this]() {
+		It(TEXT("Finds the hand of the matching device without copying the pairs"), [this] {
+			const OculusXRInput::FOculusHandControllerState* HandState = OculusXRInput::FOculusHandTracking::FindHandState(ControllerPairs, FInputDeviceId::CreateFromInternalId(1), EOculusXRHandType::HandRight);
+			TestTrue(TEXT("Right hand of the second pair"), HandState == &ControllerPairs[1].HandControllerStates[ovrpHand_Right]);
+		});
+
+		It(TEXT("Returns nothing for unknown devices and no hand"), [this] {
+			TestNull(TEXT("Unknown device"), OculusXRInput::FOculusHandTracking::FindHandState(ControllerPairs, FInputDeviceId::CreateFromInternalId(7), EOculusXRHandType::HandLeft));
+			TestNull(TEXT("No hand"), OculusXRInput::FOculusHandTracking::FindHandState(ControllerPairs, FInputDeviceId::CreateFromInternalId(0), EOculusXRHandType::None));
+		});
+	});
+
+	Describe(TEXT("CopyHandState"), [this]() {
+		It(TEXT("Captures every tracked value of the hand"), [this] {
+			const OculusXRInput::FOculusHandControllerState& HandState = ControllerPairs[1].HandControllerStates[ovrpHand_Right];
+			OculusXRInput::FOculusXRHandSnapshot Snapshot;
+			OculusXRInput::FOculusHandTracking::CopyHandState(HandState, Snapshot);
+
+			TestTrue(TEXT("Valid"), Snapshot.bIsValid);
+			TestEqual(TEXT("Hand scale"), Snapshot.HandScale, HandState.HandScale);
+			TestTrue(TEXT("Tracking confidence"), Snapshot.TrackingConfidence == EOculusXRTrackingConfidence::High);
+			TestTrue(TEXT("Finger confidence"), Snapshot.FingerConfidences[(int32)OculusXRInput::EOculusHandAxes::Index] == EOculusXRTrackingConfidence::High);
+			TestTrue(TEXT("Dominant hand"), Snapshot.bIsDominantHand);
+			TestTrue(TEXT("Pointer pose valid"), Snapshot.bIsPointerPoseValid);
+			TestTrue(TEXT("Position valid"), Snapshot.bIsPositionValid);
+			TestTrue(TEXT("Pointer pose"), Snapshot.PointerPose.Equals(HandState.PointerPose));
+			for (int32 Bone = 0; Bone < (int32)EOculusXRBone::Bone_Max; ++Bone)
+			{
+				TestTrue(FString::Printf(TEXT("Bone %d"), Bone), Snapshot.BoneRotations[Bone].Equals(HandState.BoneRotations[Bone]));
+			}
+		});
+
+		It(TEXT("Leaves the defaults of the getters in an empty snapshot"), [this] {
+			const OculusXRInput::FOculusXRHandSnapshot Snapshot;
+			TestFalse(TEXT("Not valid"), Snapshot.bIsValid);
+			TestEqual(TEXT("Hand scale"), Snapshot.HandScale, 1.0f);
+			TestTrue(TEXT("Tracking confidence"), Snapshot.TrackingConfidence == EOculusXRTrackingConfidence::Low);
+			TestTrue(TEXT("Wrist rotation"), Snapshot.BoneRotations[(int32)EOculusXRBone::Wrist_Root].Equals(FQuat::Identity));
+		});
+	});
+
+	Describe(TEXT("Benchmark"), [this]() {
+		It(TEXT("Reads a whole hand from a snapshot instead of copying the pairs per read"), [this] {
+			constexpr int32 NumReads = 10000;
+			const FInputDeviceId DeviceId = FInputDeviceId::CreateFromInternalId(1);
+
+			double StartTime = FPlatformTime::Seconds();
+			float CopySum = 0.0f;
+			for (int32 Read = 0; Read < NumReads; ++Read)
+			{
+				CopySum += ReadHandByCopy(ControllerPairs, DeviceId, EOculusXRHandType::HandLeft);
+			}
+			const double CopySeconds = FPlatformTime::Seconds() - StartTime;
+
+			OculusXRInput::FOculusXRHandSnapshot Snapshot;
+			StartTime = FPlatformTime::Seconds();
+			float SnapshotSum = 0.0f;
+			for (int32 Read = 0; Read < NumReads; ++Read)
+			{
+				SnapshotSum += ReadHandBySnapshot(ControllerPairs, DeviceId, EOculusXRHandType::HandLeft, Snapshot);
+			}
+			const double SnapshotSeconds = FPlatformTime::Seconds() - StartTime;
+
+			AddInfo(FString::Printf(TEXT("%d full hand reads: %.3f ms copying the pairs per read, %.3f ms through a snapshot"),
+				NumReads, CopySeconds * 1000.0, SnapshotSeconds * 1000.0));
+			TestEqual(TEXT("Both read the same values"), SnapshotSum, CopySum);
+		});
+	});
+}
+
+#endif // OCULUS_INPUT_SUPPORTED_PLATFORMS
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,88 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "OculusXRBodyPoseBatch.h"
+
+void FOculusXRBodyPoseBatch::Begin(TArray<FTransform>& InBoneSpaceTransforms, const TArray<int32>& InParentIndices)
+{
+	check(InBoneSpaceTransforms.Num() == InParentIndices.Num());
+
+	BoneSpaceTransforms = &InBoneSpaceTransforms;
+	ParentIndices = &InParentIndices;
+
+	const int32 NumBones = InBoneSpaceTransforms.Num();
+	ComponentSpaceTransforms.SetNumUninitialized(NumBones, EAllowShrinking::No);
+	ComponentSpaceValid.Init(false, NumBones);
+}
+
+const FTransform& FOculusXRBodyPoseBatch::GetComponentSpaceTransform(int32 BoneIndex)
+{
+	check(IsActive());
+
+	if (!ComponentSpaceValid[BoneIndex])
+	{
+		// Walk up to the closest bone with a known transform, then compose the chain back down
+		TArray<int32, TInlineAllocator<32>> Chain;
+		for (int32 ChainIndex = BoneIndex; ChainIndex != INDEX_NONE && !ComponentSpaceValid[ChainIndex]; ChainIndex = (*ParentIndices)[ChainIndex])
+		{
+			Chain.Add(ChainIndex);
+		}
+
+		for (int32 Index = Chain.Num() - 1; Index >= 0; --Index)
+		{
+			const int32 ChainBone = Chain[Index];
+			const int32 ParentIndex = (*ParentIndices)[ChainBone];
+			if (ParentIndex == INDEX_NONE)
+			{
+				ComponentSpaceTransforms[ChainBone] = (*BoneSpaceTransforms)[ChainBone];
+			}
+			else
+			{
+				// Same composition as FA2CSPose, so the result matches the per-bone setters exactly
+				ComponentSpaceTransforms[ChainBone] = (*BoneSpaceTransforms)[ChainBone] * ComponentSpaceTransforms[ParentIndex];
+				ComponentSpaceTransforms[ChainBone].NormalizeRotation();
+			}
+			ComponentSpaceValid[ChainBone] = true;
+		}
+	}
+
+	return ComponentSpaceTransforms[BoneIndex];
+}
+
+void FOculusXRBodyPoseBatch::SetComponentSpaceTransform(int32 BoneIndex, const FTransform& Transform)
+{
+	check(IsActive());
+
+	FTransform& LocalTransform = (*BoneSpaceTransforms)[BoneIndex];
+	LocalTransform = Transform;
+
+	const int32 ParentIndex = (*ParentIndices)[BoneIndex];
+	if (ParentIndex != INDEX_NONE)
+	{
+		LocalTransform.SetToRelativeTransform(GetComponentSpaceTransform(ParentIndex));
+	}
+
+	// Children always come after their parents, so one pass drops everything below the bone. A bone can only have a
+	// known transform while its parent has one.
+	ComponentSpaceValid[BoneIndex] = false;
+	for (int32 Index = BoneIndex + 1; Index < ComponentSpaceValid.Num(); ++Index)
+	{
+		const int32 ParentOfIndex = (*ParentIndices)[Index];
+		if (ComponentSpaceValid[Index] && ParentOfIndex != INDEX_NONE && !ComponentSpaceValid[ParentOfIndex])
+		{
+			ComponentSpaceValid[Index] = false;
+		}
+	}
+}
+
+void FOculusXRBodyPoseBatch::SetComponentSpaceRotation(int32 BoneIndex, const FQuat& Rotation)
+{
+	FTransform Transform = GetComponentSpaceTransform(BoneIndex);
+	Transform.SetRotation(Rotation);
+	SetComponentSpaceTransform(BoneIndex, Transform);
+}
+
+void FOculusXRBodyPoseBatch::End()
+{
+	BoneSpaceTransforms = nullptr;
+	ParentIndices = nullptr;
+}
@@ -24,6 +24,7 @@ int UOculusXRBodyTrackingComponent::TrackingInstanceCount = 0;
 UOculusXRBodyTrackingComponent::UOculusXRBodyTrackingComponent()
 	: BodyTrackingMode(EOculusXRBodyTrackingMode::PositionAndRotation)
 	, ConfidenceThreshold(0.f)
+	, bUpdateJointBuffer(false)
 	, WorldToMeters(100.f)
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -171,10 +172,29 @@ void UOculusXRBodyTrackingComponent::TickComponent(float DeltaTime, enum ELevelT
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	if (GetSkinnedAsset() != MappedSkinnedAsset.Get())
+	{
+		// The mesh changed since the joints were mapped
+		InitializeBodyBones();
+	}
+
 	if (UOculusXRMovementFunctionLibrary::TryGetBodyState(BodyState, WorldToMeters))
 	{
 		if (BodyState.IsActive && BodyState.Confidence > ConfidenceThreshold)
 		{
+			if (bUpdateJointBuffer)
+			{
+				UpdateJointBuffer();
+			}
+
+			// All joints are written through one batch, which keeps the component space pose between joints
+			const bool bApplyPose = BodyTrackingMode != EOculusXRBodyTrackingMode::NoTracking && CanApplyBodyPose();
+			if (bApplyPose)
+			{
+				PoseBatch.Begin(BoneSpaceTransforms, BoneParentIndices);
+			}
+
+			bool bPoseChanged = false;
 			for (int i = 0; i < BodyState.Joints.Num(); ++i)
 			{
 				const FOculusXRBodyJoint& Joint = BodyState.Joints[i];
@@ -200,22 +220,35 @@ void UOculusXRBodyTrackingComponent::TickComponent(float DeltaTime, enum ELevelT
 				}
 #endif
 
-				int32* BoneIndex = MappedBoneIndices.Find(static_cast<EOculusXRBoneID>(i));
-				if (BoneIndex != nullptr)
+				const int32 BoneIndex = JointBoneIndices.IsValidIndex(i) ? JointBoneIndices[i] : INDEX_NONE;
+				if (bApplyPose && BoneIndex != INDEX_NONE)
 				{
 					switch (BodyTrackingMode)
 					{
 						case EOculusXRBodyTrackingMode::PositionAndRotation:
-							SetBoneTransformByName(BoneNames[static_cast<EOculusXRBoneID>(i)], FTransform(Orientation, Position), EBoneSpaces::ComponentSpace);
+							PoseBatch.SetComponentSpaceTransform(BoneIndex, FTransform(Orientation, Position));
+							bPoseChanged = true;
 							break;
 						case EOculusXRBodyTrackingMode::RotationOnly:
-							SetBoneRotationByName(BoneNames[static_cast<EOculusXRBoneID>(i)], Orientation, EBoneSpaces::ComponentSpace);
+							PoseBatch.SetComponentSpaceRotation(BoneIndex, Orientation.Quaternion());
+							bPoseChanged = true;
 							break;
 						case EOculusXRBodyTrackingMode::NoTracking:
 							break;
 					}
 				}
 			}
+
+			if (bApplyPose)
+			{
+				PoseBatch.End();
+			}
+
+			if (bPoseChanged)
+			{
+				// Need to send new state to render thread
+				MarkRenderDynamicDataDirty();
+			}
 		}
 	}
 	else
@@ -228,8 +261,7 @@ void UOculusXRBodyTrackingComponent::ResetAllBoneTransforms()
 {
 	for (int i = 0; i < BodyState.Joints.Num(); ++i)
 	{
-		int32* BoneIndex = MappedBoneIndices.Find(static_cast<EOculusXRBoneID>(i));
-		if (BoneIndex != nullptr)
+		if (JointBoneIndices.IsValidIndex(i) && JointBoneIndices[i] != INDEX_NONE)
 		{
 			ResetBoneTransformByName(BoneNames[static_cast<EOculusXRBoneID>(i)]);
 		}
@@ -238,13 +270,18 @@ void UOculusXRBodyTrackingComponent::ResetAllBoneTransforms()
 
 bool UOculusXRBodyTrackingComponent::InitializeBodyBones()
 {
+	JointBoneIndices.Reset();
+	BoneParentIndices.Reset();
+
 	USkeletalMesh* BodyMesh = Cast<USkeletalMesh>(GetSkinnedAsset());
+	MappedSkinnedAsset = GetSkinnedAsset();
 	if (BodyMesh == nullptr)
 	{
 		UE_LOG(LogOculusXRMovement, Display, TEXT("No SkeletalMesh in this component."));
 		return false;
 	}
 
+	JointBoneIndices.Init(INDEX_NONE, static_cast<int32>(EOculusXRBoneID::COUNT));
 	for (const auto& it : BoneNames)
 	{
 		int32 BoneIndex = GetBoneIndex(it.Value);
@@ -253,11 +290,40 @@ bool UOculusXRBodyTrackingComponent::InitializeBodyBones()
 		{
 			UE_LOG(LogOculusXRMovement, Display, TEXT("Could not find bone %s in skeletal mesh %s"), *StaticEnum<EOculusXRBoneID>()->GetValueAsString(it.Key), *BodyMesh->GetName());
 		}
-		else
+		else if (JointBoneIndices.IsValidIndex(static_cast<int32>(it.Key)))
 		{
-			MappedBoneIndices.Add(it.Key, BoneIndex);
+			JointBoneIndices[static_cast<int32>(it.Key)] = BoneIndex;
 		}
 	}
 
+	const FReferenceSkeleton& RefSkeleton = BodyMesh->GetRefSkeleton();
+	BoneParentIndices.SetNumUninitialized(RefSkeleton.GetNum());
+	for (int32 BoneIndex = 0; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
+	{
+		BoneParentIndices[BoneIndex] = RefSkeleton.GetParentIndex(BoneIndex);
+	}
+
 	return true;
 }
+
+bool UOculusXRBodyTrackingComponent::CanApplyBodyPose() const
+{
+	// Same conditions as the per-bone setters of UPoseableMeshComponent
+	return GetSkinnedAsset() != nullptr && RequiredBones.IsValid() && BoneSpaceTransforms.Num() == BoneParentIndices.Num();
+}
+
+void UOculusXRBodyTrackingComponent::UpdateJointBuffer()
+{
+	const int32 NumJoints = BodyState.Joints.Num();
+	JointBuffer.Positions.SetNumUninitialized(NumJoints, EAllowShrinking::No);
+	JointBuffer.Orientations.SetNumUninitialized(NumJoints, EAllowShrinking::No);
+	JointBuffer.ValidJoints.Init(false, NumJoints);
+
+	for (int32 JointIndex = 0; JointIndex < NumJoints; ++JointIndex)
+	{
+		const FOculusXRBodyJoint& Joint = BodyState.Joints[JointIndex];
+		JointBuffer.Positions[JointIndex] = Joint.Position;
+		JointBuffer.Orientations[JointIndex] = Joint.Orientation.Quaternion();
+		JointBuffer.ValidJoints[JointIndex] = Joint.bIsValid;
+	}
+}
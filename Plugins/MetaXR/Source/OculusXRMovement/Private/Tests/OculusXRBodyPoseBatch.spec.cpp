@@ -0,0 +1,200 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#include "Misc/AutomationTest.h"
+#include "OculusXRBodyPoseBatch.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FTransform MakeBodyPoseTestTransform(FRandomStream& Random)
+	{
+		const FRotator Rotation(Random.FRandRange(-180.0, 180.0), Random.FRandRange(-180.0, 180.0), Random.FRandRange(-180.0, 180.0));
+		return FTransform(Rotation, Random.GetUnitVector() * Random.FRandRange(1.0, 20.0));
+	}
+
+	// The component space transform of a bone computed from the whole local space pose, like FA2CSPose does for every
+	// call of UPoseableMeshComponent::SetBoneTransformByName()
+	FTransform ComputeBodyPoseTestComponentSpace(const TArray<FTransform>& BoneSpaceTransforms, const TArray<int32>& ParentIndices, int32 BoneIndex)
+	{
+		TArray<FTransform> ComponentSpaceTransforms = BoneSpaceTransforms;
+		for (int32 Index = 0; Index <= BoneIndex; ++Index)
+		{
+			if (ParentIndices[Index] != INDEX_NONE)
+			{
+				ComponentSpaceTransforms[Index] = BoneSpaceTransforms[Index] * ComponentSpaceTransforms[ParentIndices[Index]];
+				ComponentSpaceTransforms[Index].NormalizeRotation();
+			}
+		}
+		return ComponentSpaceTransforms[BoneIndex];
+	}
+
+	void SetBodyPoseTestBone(TArray<FTransform>& BoneSpaceTransforms, const TArray<int32>& ParentIndices, int32 BoneIndex, const FTransform& Transform)
+	{
+		BoneSpaceTransforms[BoneIndex] = Transform;
+		if (ParentIndices[BoneIndex] != INDEX_NONE)
+		{
+			BoneSpaceTransforms[BoneIndex].SetToRelativeTransform(ComputeBodyPoseTestComponentSpace(BoneSpaceTransforms, ParentIndices, ParentIndices[BoneIndex]));
+		}
+	}
+} // namespace
+
+BEGIN_DEFINE_SPEC(FOculusXRBodyPoseBatchSpec, TEXT("OculusXR.Movement.BodyPoseBatch"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+// A synthetic skeleton the size of the full body skeleton and the joints driven on it
+TArray<int32> ParentIndices;
+TArray<FTransform> RefPose;
+TArray<int32> JointBones;
+TArray<FTransform> JointTargets;
+FOculusXRBodyPoseBatch Batch;
+
+void TestSamePose(const TArray<FTransform>& Expected, const TArray<FTransform>& Actual);
+END_DEFINE_SPEC(FOculusXRBodyPoseBatchSpec)
+
+void FOculusXRBodyPoseBatchSpec::TestSamePose(const TArray<FTransform>& Expected, const TArray<FTransform>& Actual)
+{
+	TestEqual(TEXT("Bone count"), Actual.Num(), Expected.Num());
+	for (int32 BoneIndex = 0; BoneIndex < Expected.Num() && BoneIndex < Actual.Num(); ++BoneIndex)
+	{
+		TestTrue(FString::Printf(TEXT("Bone %d"), BoneIndex), Actual[BoneIndex].Equals(Expected[BoneIndex], UE_KINDA_SMALL_NUMBER));
+	}
+}
+
+void FOculusXRBodyPoseBatchSpec::Define()
+{
+	BeforeEach([this]() {
+		constexpr int32 NumBones = 84;
+		constexpr int32 NumJoints = 70;
+
+		FRandomStream Random(1234);
+		ParentIndices.Reset();
+		RefPose.Reset();
+		for (int32 BoneIndex = 0; BoneIndex < NumBones; ++BoneIndex)
+		{
+			// Mostly chains, with a branch now and then like limbs and fingers
+			const int32 ParentIndex = BoneIndex == 0 ? INDEX_NONE : (Random.FRand() < 0.7f ? BoneIndex - 1 : Random.RandHelper(BoneIndex));
+			ParentIndices.Add(ParentIndex);
+			RefPose.Add(MakeBodyPoseTestTransform(Random));
+		}
+
+		JointBones.Reset();
+		JointTargets.Reset();
+		for (int32 JointIndex = 0; JointIndex < NumJoints; ++JointIndex)
+		{
+			JointBones.Add(JointIndex + (NumBones - NumJoints) / 2);
+			JointTargets.Add(MakeBodyPoseTestTransform(Random));
+		}
+	});
+
+	Describe(TEXT("SetComponentSpaceTransform"), [this]() {
+		It(TEXT("Matches setting the bones one by one when parents come first"), [this] {
+			TArray<FTransform> Expected = RefPose;
+			for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+			{
+				SetBodyPoseTestBone(Expected, ParentIndices, JointBones[JointIndex], JointTargets[JointIndex]);
+			}
+
+			TArray<FTransform> Actual = RefPose;
+			Batch.Begin(Actual, ParentIndices);
+			for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+			{
+				Batch.SetComponentSpaceTransform(JointBones[JointIndex], JointTargets[JointIndex]);
+			}
+			Batch.End();
+
+			TestSamePose(Expected, Actual);
+		});
+
+		It(TEXT("Matches setting the bones one by one when children come first"), [this] {
+			TArray<FTransform> Expected = RefPose;
+			for (int32 JointIndex = JointBones.Num() - 1; JointIndex >= 0; --JointIndex)
+			{
+				SetBodyPoseTestBone(Expected, ParentIndices, JointBones[JointIndex], JointTargets[JointIndex]);
+			}
+
+			TArray<FTransform> Actual = RefPose;
+			Batch.Begin(Actual, ParentIndices);
+			for (int32 JointIndex = JointBones.Num() - 1; JointIndex >= 0; --JointIndex)
+			{
+				Batch.SetComponentSpaceTransform(JointBones[JointIndex], JointTargets[JointIndex]);
+			}
+			Batch.End();
+
+			TestSamePose(Expected, Actual);
+		});
+
+		It(TEXT("Places every bone at its target when parents come first"), [this] {
+			TArray<FTransform> Actual = RefPose;
+			Batch.Begin(Actual, ParentIndices);
+			for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+			{
+				Batch.SetComponentSpaceTransform(JointBones[JointIndex], JointTargets[JointIndex]);
+			}
+			Batch.End();
+
+			for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+			{
+				const FTransform ComponentSpace = ComputeBodyPoseTestComponentSpace(Actual, ParentIndices, JointBones[JointIndex]);
+				TestTrue(FString::Printf(TEXT("Joint %d"), JointIndex), ComponentSpace.Equals(JointTargets[JointIndex], UE_KINDA_SMALL_NUMBER));
+			}
+		});
+	});
+
+	Describe(TEXT("SetComponentSpaceRotation"), [this]() {
+		It(TEXT("Matches setting the bone rotations one by one"), [this] {
+			TArray<FTransform> Expected = RefPose;
+			for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+			{
+				const int32 BoneIndex = JointBones[JointIndex];
+				FTransform Target = ComputeBodyPoseTestComponentSpace(Expected, ParentIndices, BoneIndex);
+				Target.SetRotation(JointTargets[JointIndex].GetRotation());
+				SetBodyPoseTestBone(Expected, ParentIndices, BoneIndex, Target);
+			}
+
+			TArray<FTransform> Actual = RefPose;
+			Batch.Begin(Actual, ParentIndices);
+			for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+			{
+				Batch.SetComponentSpaceRotation(JointBones[JointIndex], JointTargets[JointIndex].GetRotation());
+			}
+			Batch.End();
+
+			TestSamePose(Expected, Actual);
+		});
+	});
+
+	Describe(TEXT("Benchmark"), [this]() {
+		It(TEXT("Applies a body pose faster than setting the bones one by one"), [this] {
+			constexpr int32 NumFrames = 200;
+
+			TArray<FTransform> Expected = RefPose;
+			double StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+				{
+					SetBodyPoseTestBone(Expected, ParentIndices, JointBones[JointIndex], JointTargets[JointIndex]);
+				}
+			}
+			const double PerBoneSeconds = FPlatformTime::Seconds() - StartTime;
+
+			TArray<FTransform> Actual = RefPose;
+			StartTime = FPlatformTime::Seconds();
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				Batch.Begin(Actual, ParentIndices);
+				for (int32 JointIndex = 0; JointIndex < JointBones.Num(); ++JointIndex)
+				{
+					Batch.SetComponentSpaceTransform(JointBones[JointIndex], JointTargets[JointIndex]);
+				}
+				Batch.End();
+			}
+			const double BatchSeconds = FPlatformTime::Seconds() - StartTime;
+
+			AddInfo(FString::Printf(TEXT("%d frames of %d joints: %.3f ms setting bones one by one, %.3f ms batched"),
+				NumFrames, JointBones.Num(), PerBoneSeconds * 1000.0, BatchSeconds * 1000.0));
+			TestSamePose(Expected, Actual);
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,35 @@
+// Copyright (c) Meta Platforms, Inc. and affiliates.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Writes component space transforms of many bones into a local space pose. The result is the same as calling
+// UPoseableMeshComponent::SetBoneTransformByName() in component space for every bone in turn, but the component space
+// transforms of the parents are computed once and kept until a bone above them changes, instead of being rebuilt from
+// the whole local space pose for every bone.
+class OCULUSXRMOVEMENT_API FOculusXRBodyPoseBatch
+{
+public:
+	// Start writing to a local space pose. ParentIndices holds the parent of every bone, INDEX_NONE for roots, and
+	// parents must come before their children like in a reference skeleton. Both arrays must outlive the batch.
+	void Begin(TArray<FTransform>& InBoneSpaceTransforms, const TArray<int32>& InParentIndices);
+
+	const FTransform& GetComponentSpaceTransform(int32 BoneIndex);
+	void SetComponentSpaceTransform(int32 BoneIndex, const FTransform& Transform);
+
+	// Keep only the component space rotation, like UPoseableMeshComponent::SetBoneRotationByName()
+	void SetComponentSpaceRotation(int32 BoneIndex, const FQuat& Rotation);
+
+	void End();
+
+	bool IsActive() const { return BoneSpaceTransforms != nullptr; }
+
+private:
+	TArray<FTransform>* BoneSpaceTransforms = nullptr;
+	const TArray<int32>* ParentIndices = nullptr;
+
+	// Kept between batches so a frame doesn't allocate
+	TArray<FTransform> ComponentSpaceTransforms;
+	TBitArray<> ComponentSpaceValid;
+};
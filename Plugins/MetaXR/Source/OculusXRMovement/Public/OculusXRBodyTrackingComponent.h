@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/PoseableMeshComponent.h"
 
+#include "OculusXRBodyPoseBatch.h"
 #include "OculusXRMovementTypes.h"
 
 #include "OculusXRBodyTrackingComponent.generated.h"
@@ -17,6 +18,15 @@ enum class EOculusXRBodyTrackingMode : uint8
 	NoTracking
 };
 
+// The joints of the last applied body state as separate arrays, indexed by EOculusXRBoneID. Positions and orientations are in
+// the space of the component, like the transforms applied to the bones.
+struct FOculusXRBodyJointBuffer
+{
+	TArray<FVector> Positions;
+	TArray<FQuat> Orientations;
+	TBitArray<> ValidJoints;
+};
+
 UCLASS(Blueprintable, meta = (BlueprintSpawnableComponent, DisplayName = "OculusXR Body Tracking Component"), ClassGroup = OculusXRHMD)
 class OCULUSXRMOVEMENT_API UOculusXRBodyTrackingComponent : public UPoseableMeshComponent
 {
@@ -52,14 +62,36 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement", meta = (ClampMin = "0", ClampMax = "1", UIMin = "0", UIMax = "1"))
 	float ConfidenceThreshold;
 
+	/**
+	 * Fill the joint buffer with the joints of every applied body state.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Movement")
+	bool bUpdateJointBuffer;
+
+	/**
+	 * The joints of the last applied body state, only filled while bUpdateJointBuffer is set.
+	 */
+	const FOculusXRBodyJointBuffer& GetJointBuffer() const { return JointBuffer; }
+
 private:
 	bool InitializeBodyBones();
+	bool CanApplyBodyPose() const;
+	void UpdateJointBuffer();
 
 	// One meter in unreal world units.
 	float WorldToMeters;
 
-	// The index of each mapped bone after the discovery and association of bone names.
-	TMap<EOculusXRBoneID, int32> MappedBoneIndices;
+	// The bone index of each joint, indexed by EOculusXRBoneID. INDEX_NONE for joints without a bone.
+	TArray<int32> JointBoneIndices;
+
+	// The parent of each bone of the mesh the joints were mapped to.
+	TArray<int32> BoneParentIndices;
+
+	// The mesh the joints were mapped to.
+	TWeakObjectPtr<USkinnedAsset> MappedSkinnedAsset;
+
+	FOculusXRBodyPoseBatch PoseBatch;
+	FOculusXRBodyJointBuffer JointBuffer;
 
 	// Saved body state.
 	FOculusXRBodyState BodyState;
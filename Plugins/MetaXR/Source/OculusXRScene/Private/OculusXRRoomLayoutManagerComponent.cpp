@@ -6,6 +6,9 @@
 #include "OculusXRSceneDelegates.h"
 #include "OculusXRSceneFunctionLibrary.h"
 #include "ProceduralMeshComponent.h"
+#include "Containers/Ticker.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Engine/World.h"
 
 UOculusXRRoomLayoutManagerComponent::UOculusXRRoomLayoutManagerComponent(const FObjectInitializer& ObjectInitializer)
 {
@@ -71,12 +74,133 @@ bool UOculusXRRoomLayoutManagerComponent::LoadTriangleMesh(FOculusXRUInt64 Space
 		return false;
 	}
 
-	// Mesh->bUseAsyncCooking = true;
+	CreateTriangleMeshSections(Mesh, Vertices, Triangles, CreateCollision);
+
+	return true;
+}
+
+void UOculusXRRoomLayoutManagerComponent::CreateTriangleMeshSections(UProceduralMeshComponent* Mesh, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, bool CreateCollision) const
+{
 	TArray<FVector> EmptyNormals;
 	TArray<FVector2D> EmptyUV;
 	TArray<FColor> EmptyVertexColors;
 	TArray<FProcMeshTangent> EmptyTangents;
-	Mesh->CreateMeshSection(0, Vertices, Triangles, EmptyNormals, EmptyUV, EmptyVertexColors, EmptyTangents, CreateCollision);
 
-	return true;
+	// Every section update cooks the collision of the whole mesh again, only the last one may go to the background
+	Mesh->bUseAsyncCooking = false;
+	if (CreateCollision && bSimplifiedCollision)
+	{
+		TArray<FVector> CollisionVertices;
+		TArray<int32> CollisionTriangles;
+		SimplifyTriangleMesh(Vertices, Triangles, SimplifiedCollisionCellSize, CollisionVertices, CollisionTriangles);
+		UE_LOG(LogOculusXRScene, Verbose, TEXT("Simplified collision of triangle mesh from %d to %d triangles"), Triangles.Num() / 3, CollisionTriangles.Num() / 3);
+
+		Mesh->CreateMeshSection(0, Vertices, Triangles, EmptyNormals, EmptyUV, EmptyVertexColors, EmptyTangents, false);
+		Mesh->bUseAsyncCooking = bAsyncCollisionCooking;
+		Mesh->CreateMeshSection(1, CollisionVertices, CollisionTriangles, EmptyNormals, EmptyUV, EmptyVertexColors, EmptyTangents, true);
+		Mesh->SetMeshSectionVisible(1, false);
+	}
+	else
+	{
+		Mesh->bUseAsyncCooking = CreateCollision && bAsyncCollisionCooking;
+		Mesh->CreateMeshSection(0, Vertices, Triangles, EmptyNormals, EmptyUV, EmptyVertexColors, EmptyTangents, CreateCollision);
+	}
+
+	if (!CreateCollision)
+	{
+		return;
+	}
+	// Same condition as UProceduralMeshComponent::UpdateCollision(), outside of game worlds the collision is cooked right away
+	const UWorld* World = Mesh->GetWorld();
+	if (Mesh->bUseAsyncCooking && World && World->IsGameWorld())
+	{
+		BroadcastWhenCollisionCooked(Mesh);
+	}
+	else
+	{
+		OculusXRTriangleMeshCollisionReady.Broadcast(Mesh, true);
+		OculusXRTriangleMeshCollisionReadyNative.Broadcast(Mesh, true);
+	}
+}
+
+void UOculusXRRoomLayoutManagerComponent::BroadcastWhenCollisionCooked(UProceduralMeshComponent* Mesh) const
+{
+	// The procedural mesh swaps in a new body setup once the async cook has finished. It doesn't tell anyone, so poll for it.
+	constexpr double CookTimeoutSeconds = 30.0;
+	const UBodySetup* PendingBodySetup = Mesh->GetBodySetup();
+	const double Deadline = FPlatformTime::Seconds() + CookTimeoutSeconds;
+	TWeakObjectPtr<const UOculusXRRoomLayoutManagerComponent> WeakThis(this);
+	TWeakObjectPtr<UProceduralMeshComponent> WeakMesh(Mesh);
+	FTSTicker::GetCoreTicker().AddTicker(TEXT("OculusXRTriangleMeshCollision"), 0.0f, [WeakThis, WeakMesh, PendingBodySetup, Deadline](float) {
+		const UOculusXRRoomLayoutManagerComponent* This = WeakThis.Get();
+		UProceduralMeshComponent* Mesh = WeakMesh.Get();
+		if (!This || !Mesh)
+		{
+			return false;
+		}
+		const bool bCooked = Mesh->GetBodySetup() != PendingBodySetup;
+		if (!bCooked && FPlatformTime::Seconds() < Deadline)
+		{
+			return true;
+		}
+		if (!bCooked)
+		{
+			UE_LOG(LogOculusXRScene, Warning, TEXT("Collision of triangle mesh %s was not cooked within %.0f seconds"), *Mesh->GetName(), CookTimeoutSeconds);
+		}
+		This->OculusXRTriangleMeshCollisionReady.Broadcast(Mesh, bCooked);
+		This->OculusXRTriangleMeshCollisionReadyNative.Broadcast(Mesh, bCooked);
+		return false;
+	});
+}
+
+void UOculusXRRoomLayoutManagerComponent::SimplifyTriangleMesh(const TArray<FVector>& Vertices, const TArray<int32>& Triangles, double CellSize, TArray<FVector>& OutVertices, TArray<int32>& OutTriangles)
+{
+	OutVertices.Reset();
+	OutTriangles.Reset();
+
+	// Each cell becomes one vertex at the average position of the vertices in it
+	TMap<FIntVector, int32> Cells;
+	TArray<int32> VertexRemap;
+	TArray<int32> CellCounts;
+	VertexRemap.SetNumUninitialized(Vertices.Num());
+	for (int32 i = 0; i < Vertices.Num(); ++i)
+	{
+		const FVector& Vertex = Vertices[i];
+		const FIntVector Cell(FMath::FloorToInt32(Vertex.X / CellSize), FMath::FloorToInt32(Vertex.Y / CellSize), FMath::FloorToInt32(Vertex.Z / CellSize));
+		int32& Index = Cells.FindOrAdd(Cell, INDEX_NONE);
+		if (Index == INDEX_NONE)
+		{
+			Index = OutVertices.Add(FVector::ZeroVector);
+			CellCounts.Add(0);
+		}
+		OutVertices[Index] += Vertex;
+		++CellCounts[Index];
+		VertexRemap[i] = Index;
+	}
+	for (int32 i = 0; i < OutVertices.Num(); ++i)
+	{
+		OutVertices[i] /= CellCounts[i];
+	}
+
+	TSet<FIntVector> UniqueTriangles;
+	OutTriangles.Reserve(Triangles.Num());
+	for (int32 i = 0; i + 2 < Triangles.Num(); i += 3)
+	{
+		const int32 A = VertexRemap[Triangles[i]];
+		const int32 B = VertexRemap[Triangles[i + 1]];
+		const int32 C = VertexRemap[Triangles[i + 2]];
+		if (A == B || B == C || A == C)
+		{
+			continue;
+		}
+		// Triangles with the same vertices in any order are duplicates for collision
+		const int32 Min = FMath::Min3(A, B, C);
+		const int32 Max = FMath::Max3(A, B, C);
+		bool bAlreadyInSet = false;
+		UniqueTriangles.Add(FIntVector(Min, A + B + C - Min - Max, Max), &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			OutTriangles.Append({ A, B, C });
+		}
+	}
 }
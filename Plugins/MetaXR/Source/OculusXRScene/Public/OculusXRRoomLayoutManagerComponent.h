@@ -7,6 +7,8 @@
 #include "OculusXRAnchorBPFunctionLibrary.h"
 #include "OculusXRRoomLayoutManagerComponent.generated.h"
 
+class UProceduralMeshComponent;
+
 UCLASS(meta = (DisplayName = "OculusXR Room Layout Manager Component", BlueprintSpawnableComponent))
 class OCULUSXRSCENE_API UOculusXRRoomLayoutManagerComponent : public UActorComponent
 {
@@ -31,6 +33,31 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "OculusXR|Room Layout Manager")
 	FOculusXRRoomLayoutSceneCaptureCompleteDelegate OculusXRRoomLayoutSceneCaptureComplete;
 
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOculusXRTriangleMeshCollisionReadyDelegate,
+		UProceduralMeshComponent*, Mesh,
+		bool, result);
+
+	DECLARE_MULTICAST_DELEGATE_TwoParams(FOculusXRTriangleMeshCollisionReadyNativeDelegate, UProceduralMeshComponent* /*Mesh*/, bool /*success*/);
+	FOculusXRTriangleMeshCollisionReadyNativeDelegate OculusXRTriangleMeshCollisionReadyNative;
+
+	// Called once the collision of a mesh loaded with LoadTriangleMesh() is available. With async cooking this happens a few frames
+	// after loading, otherwise right away. Not called for meshes that were loaded without collision.
+	UPROPERTY(BlueprintAssignable, Category = "OculusXR|Room Layout Manager")
+	FOculusXRTriangleMeshCollisionReadyDelegate OculusXRTriangleMeshCollisionReady;
+
+	// Cook the collision of triangle meshes on a background thread instead of stalling the frame in which the mesh is loaded
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Room Layout Manager")
+	bool bAsyncCollisionCooking = false;
+
+	// Use a simplified collision-only copy of triangle meshes for collision. The mesh itself is only used for rendering.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Room Layout Manager")
+	bool bSimplifiedCollision = false;
+
+	// Vertices of the simplified collision mesh within a grid cell of this size get merged. In the units of the mesh data,
+	// which is meters for meshes loaded from the device.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "OculusXR|Room Layout Manager", meta = (EditCondition = "bSimplifiedCollision", ClampMin = "0.001"))
+	float SimplifiedCollisionCellSize = 0.05f;
+
 	// Requests to launch Capture Flow
 	UFUNCTION(BlueprintCallable, Category = "OculusXR|Room Layout Manager")
 	bool LaunchCaptureFlow();
@@ -43,6 +70,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "OculusXR|Room Layout Manager")
 	bool LoadTriangleMesh(FOculusXRUInt64 Space, class UProceduralMeshComponent* Mesh, bool CreateCollision) const;
 
+	// Creates the mesh sections and the collision for the given triangle mesh like LoadTriangleMesh() does for the mesh of a space
+	void CreateTriangleMeshSections(UProceduralMeshComponent* Mesh, const TArray<FVector>& Vertices, const TArray<int32>& Triangles, bool CreateCollision) const;
+
+	// Merges all vertices within a cell of the given size and drops the triangles that collapse or become duplicates
+	static void SimplifyTriangleMesh(const TArray<FVector>& Vertices, const TArray<int32>& Triangles, double CellSize, TArray<FVector>& OutVertices, TArray<int32>& OutTriangles);
+
 protected:
 	UPROPERTY(Transient)
 	TSet<uint64> EntityRequestList;
@@ -51,6 +84,8 @@ protected:
 	TMap<FOculusXRUInt64, FOculusXRRoomLayout> RoomLayouts;
 
 private:
+	void BroadcastWhenCollisionCooked(UProceduralMeshComponent* Mesh) const;
+
 	UFUNCTION()
 	void OculusRoomLayoutSceneCaptureComplete_Handler(FOculusXRUInt64 RequestId, bool bSuccess)
 	{
@@ -22,6 +22,7 @@
 
 #include "IsdkChecks.h"
 #include "StructTypesPrivate.h"
+#include "HandPoseDetection/IsdkHandPoseRecognizerScheduler.h"
 
 using isdk::api::DigitRecognizer;
 
@@ -35,17 +36,55 @@ void UIsdkHandDigitRecognizer::UpdateState(float DeltaTime)
       return;
     }
 
-    ApiDigitRecognizer = CreateDigitRecognizer();
-    if (!ApiDigitRecognizer)
+    if (!CreateApiDigitRecognizer())
     {
-      // Creation failed. This can happen if dependencies (such as HandMesh) were invalid.
       return;
     }
   }
 
+  if (IsValid(HandMesh))
+  {
+    LastFrameVersion = HandMesh->GetHandPositionFrameVersion();
+  }
   return ApiDigitRecognizer->update(DeltaTime);
 }
 
+bool UIsdkHandDigitRecognizer::UpdateScheduledState(
+    const FIsdkHandPoseRecognizerInputs& Inputs,
+    float DeltaTime)
+{
+  if (!ApiDigitRecognizer && (!Inputs.bApiInstanceValid || !CreateApiDigitRecognizer()))
+  {
+    return false;
+  }
+
+  // The recognizer already saw this joint data, and without a transition time it decides on the
+  // joint data alone
+  if (!bTransitionsOverTime && LastFrameVersion == Inputs.FrameVersion)
+  {
+    return false;
+  }
+
+  LastFrameVersion = Inputs.FrameVersion;
+  ApiDigitRecognizer->update(DeltaTime);
+  return true;
+}
+
+bool UIsdkHandDigitRecognizer::CreateApiDigitRecognizer()
+{
+  ApiDigitRecognizer = CreateDigitRecognizer();
+  if (!ApiDigitRecognizer)
+  {
+    // Creation failed. This can happen if dependencies (such as HandMesh) were invalid.
+    return false;
+  }
+
+  // The API instance keeps the range parameters it was created with
+  bTransitionsOverTime = RangeParameters.MinTimeToTransition > 0.f;
+  LastFrameVersion = MAX_uint64;
+  return true;
+}
+
 bool UIsdkHandDigitRecognizer::IsActive()
 {
   if (ApiDigitRecognizer)
@@ -25,6 +25,7 @@
 #include "IsdkHandMeshComponent.h"
 #include "StructTypesPrivate.h"
 #include "IsdkFunctionLibrary.h"
+#include "HandPoseDetection/IsdkHandPoseRecognizerScheduler.h"
 
 using isdk::api::FingerPinchGrabRecognizer;
 using isdk::api::FingerPinchGrabRecognizerPtr;
@@ -71,6 +72,23 @@ void UIsdkHandFingerPinchGrabRecognizer::BeginDestroy()
   FingerPinchGrabRecognizerImpl.Reset();
 }
 
+void UIsdkHandFingerPinchGrabRecognizer::UpdateForwardsFromDataSources()
+{
+  if (IsValid(WristRootPose.GetObject()))
+  {
+    const FTransform WristPose = IIsdkIRootPose::Execute_GetRootPose(WristRootPose.GetObject());
+    CurrentWristForward = WristPose.GetRotation().GetForwardVector();
+  }
+
+  if (IsValid(HmdDataSource.GetObject()))
+  {
+    FTransform HmdPose;
+    bool bIsTracked;
+    IIsdkIHmdDataSource::Execute_GetHmdPose(HmdDataSource.GetObject(), HmdPose, bIsTracked);
+    CurrentHMDForward = HmdPose.GetRotation().GetForwardVector();
+  }
+}
+
 void UIsdkHandFingerPinchGrabRecognizer::UpdatePinchConfidence()
 {
   if (CurrentWristForward.IsZero() || CurrentHMDForward.IsZero())
@@ -104,16 +122,39 @@ void UIsdkHandFingerPinchGrabRecognizer::UpdateState(float DeltaTime)
     return;
   }
 
+  UpdateStateWithJointData(
+      DeltaTime,
+      IIsdkIHandJoints::Execute_IsHandJointDataValid(
+          HandVisual->GetJointsDataSource().GetObject()));
+}
+
+bool UIsdkHandFingerPinchGrabRecognizer::UpdateScheduledState(
+    const FIsdkHandPoseRecognizerInputs& Inputs,
+    float DeltaTime)
+{
+  if (!Inputs.HandPositionFrame)
+  {
+    return false;
+  }
+
+  UpdateStateWithJointData(DeltaTime, Inputs.bJointDataValid);
+  return true;
+}
+
+void UIsdkHandFingerPinchGrabRecognizer::UpdateStateWithJointData(
+    float DeltaTime,
+    bool bJointDataValid)
+{
   FingerPinchGrabRecognizer* Recognizer = FingerPinchGrabRecognizerImpl->GetOrCreateInstance();
   if (ensureMsgf(
           Recognizer != nullptr,
           TEXT("%s: Failed to create FingerPinchGrabRecognizerImpl"),
           *GetFullName()))
   {
+    UpdateForwardsFromDataSources();
     UpdatePinchConfidence();
 
-    if (IIsdkIHandJoints::Execute_IsHandJointDataValid(
-            HandVisual->GetJointsDataSource().GetObject()))
+    if (bJointDataValid)
     {
       const bool bWasActive = !!Recognizer->isActive();
       Recognizer->update(DeltaTime);
@@ -24,6 +24,7 @@
 #include "IsdkChecks.h"
 #include "IsdkHandMeshComponent.h"
 #include "StructTypesPrivate.h"
+#include "HandPoseDetection/IsdkHandPoseRecognizerScheduler.h"
 
 using isdk::api::PalmGrabRecognizer;
 using isdk::api::PalmGrabRecognizerPtr;
@@ -84,6 +85,27 @@ void UIsdkHandPalmGrabRecognizer::UpdateState(float DeltaTime)
     return;
   }
 
+  UpdateStateWithJointData(
+      DeltaTime,
+      IIsdkIHandJoints::Execute_IsHandJointDataValid(
+          HandVisual->GetJointsDataSource().GetObject()));
+}
+
+bool UIsdkHandPalmGrabRecognizer::UpdateScheduledState(
+    const FIsdkHandPoseRecognizerInputs& Inputs,
+    float DeltaTime)
+{
+  if (!Inputs.bApiInstanceValid)
+  {
+    return false;
+  }
+
+  UpdateStateWithJointData(DeltaTime, Inputs.bJointDataValid);
+  return true;
+}
+
+void UIsdkHandPalmGrabRecognizer::UpdateStateWithJointData(float DeltaTime, bool bJointDataValid)
+{
   if (!Recognizer)
   {
     Recognizer = PalmGrabRecognizerImpl->GetOrCreateInstance();
@@ -95,10 +117,8 @@ void UIsdkHandPalmGrabRecognizer::UpdateState(float DeltaTime)
     return;
   }
 
-  const auto JointsDataSource =
-      IIsdkIHandJoints::Execute_IsHandJointDataValid(HandVisual->GetJointsDataSource().GetObject());
   if (!ensureMsgf(
-          JointsDataSource,
+          bJointDataValid,
           TEXT("%s: No joints data source to drive grab recognition"),
           *GetFullName()))
   {
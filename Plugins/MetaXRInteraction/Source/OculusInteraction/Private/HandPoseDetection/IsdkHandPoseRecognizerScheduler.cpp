@@ -0,0 +1,188 @@
+﻿/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "HandPoseDetection/IsdkHandPoseRecognizerScheduler.h"
+
+#include "IsdkHandMeshComponent.h"
+#include "OculusInteractionLog.h"
+#include "HandPoseDetection/IsdkHandDigitRecognizer.h"
+#include "HandPoseDetection/IsdkHandFingerPinchGrabRecognizer.h"
+#include "HandPoseDetection/IsdkHandPalmGrabRecognizer.h"
+
+namespace
+{
+template <typename TRecognizer>
+bool AddScheduledRecognizer(
+    TArray<TWeakObjectPtr<TRecognizer>>& Recognizers,
+    TRecognizer* Recognizer,
+    const UIsdkHandMeshComponent* RecognizerHand,
+    const UIsdkHandMeshComponent& Hand)
+{
+  if (RecognizerHand != &Hand)
+  {
+    UE_LOG(
+        LogOculusInteraction,
+        Warning,
+        TEXT("%s: Can't be updated by %s, it recognizes a different hand."),
+        *Recognizer->GetFullName(),
+        *Hand.GetFullName());
+    return false;
+  }
+
+  Recognizers.AddUnique(Recognizer);
+  return true;
+}
+
+template <typename TRecognizer>
+void RemoveScheduledRecognizer(
+    TArray<TWeakObjectPtr<TRecognizer>>& Recognizers,
+    TRecognizer* Recognizer,
+    bool bUpdating)
+{
+  if (!Recognizer)
+  {
+    return;
+  }
+
+  if (bUpdating)
+  {
+    // Only clear the entry, the update in progress drops it
+    const int32 Index = Recognizers.IndexOfByKey(Recognizer);
+    if (Index != INDEX_NONE)
+    {
+      Recognizers[Index].Reset();
+    }
+  }
+  else
+  {
+    Recognizers.Remove(Recognizer);
+  }
+}
+
+// Drops recognizers that were destroyed or moved to a different hand, then calls UpdateFn on the
+// rest in the order they were registered
+template <typename TRecognizer, typename TGetHandFn, typename TUpdateFn>
+int32 UpdateScheduledRecognizers(
+    TArray<TWeakObjectPtr<TRecognizer>>& Recognizers,
+    const UIsdkHandMeshComponent& Hand,
+    TGetHandFn GetHandFn,
+    TUpdateFn UpdateFn)
+{
+  int32 NumUpdated = 0;
+  for (int32 Index = 0; Index < Recognizers.Num();)
+  {
+    TRecognizer* Recognizer = Recognizers[Index].Get();
+    if (!IsValid(Recognizer) || GetHandFn(*Recognizer) != &Hand)
+    {
+      Recognizers.RemoveAt(Index);
+      continue;
+    }
+
+    if (UpdateFn(*Recognizer))
+    {
+      ++NumUpdated;
+    }
+    ++Index;
+  }
+  return NumUpdated;
+}
+} // namespace
+
+FIsdkHandPoseRecognizerInputs FIsdkHandPoseRecognizerInputs::Read(UIsdkHandMeshComponent& Hand)
+{
+  FIsdkHandPoseRecognizerInputs Inputs;
+  Inputs.HandPositionFrame = Hand.TryGetApiIHandPositionFrame();
+  Inputs.bApiInstanceValid = Hand.IsApiInstanceValid();
+  Inputs.bJointDataValid = Hand.IsDataSourceJointsValid();
+  Inputs.FrameVersion = Hand.GetHandPositionFrameVersion();
+  return Inputs;
+}
+
+bool FIsdkHandPoseRecognizerScheduler::Register(
+    const UIsdkHandMeshComponent& Hand,
+    UObject* Recognizer)
+{
+  if (auto* DigitRecognizer = Cast<UIsdkHandDigitRecognizer>(Recognizer))
+  {
+    return AddScheduledRecognizer(
+        DigitRecognizers, DigitRecognizer, DigitRecognizer->HandMesh, Hand);
+  }
+  if (auto* PinchGrabRecognizer = Cast<UIsdkHandFingerPinchGrabRecognizer>(Recognizer))
+  {
+    return AddScheduledRecognizer(
+        PinchGrabRecognizers, PinchGrabRecognizer, PinchGrabRecognizer->HandVisual, Hand);
+  }
+  if (auto* PalmGrabRecognizer = Cast<UIsdkHandPalmGrabRecognizer>(Recognizer))
+  {
+    return AddScheduledRecognizer(
+        PalmGrabRecognizers, PalmGrabRecognizer, PalmGrabRecognizer->HandVisual, Hand);
+  }
+
+  UE_LOG(
+      LogOculusInteraction,
+      Warning,
+      TEXT("%s: Not a hand pose recognizer, it can't be updated by %s."),
+      *GetFullNameSafe(Recognizer),
+      *Hand.GetFullName());
+  return false;
+}
+
+void FIsdkHandPoseRecognizerScheduler::Unregister(UObject* Recognizer)
+{
+  // Recognizers can be unregistered by their own delegates, while they're being updated
+  RemoveScheduledRecognizer(
+      DigitRecognizers, Cast<UIsdkHandDigitRecognizer>(Recognizer), bUpdating);
+  RemoveScheduledRecognizer(
+      PinchGrabRecognizers, Cast<UIsdkHandFingerPinchGrabRecognizer>(Recognizer), bUpdating);
+  RemoveScheduledRecognizer(
+      PalmGrabRecognizers, Cast<UIsdkHandPalmGrabRecognizer>(Recognizer), bUpdating);
+}
+
+int32 FIsdkHandPoseRecognizerScheduler::Update(UIsdkHandMeshComponent& Hand, float DeltaTime)
+{
+  if (IsEmpty())
+  {
+    return 0;
+  }
+
+  const FIsdkHandPoseRecognizerInputs Inputs = FIsdkHandPoseRecognizerInputs::Read(Hand);
+  TGuardValue<bool> UpdatingGuard(bUpdating, true);
+
+  int32 NumUpdated = 0;
+  NumUpdated += UpdateScheduledRecognizers(
+      DigitRecognizers,
+      Hand,
+      [](const UIsdkHandDigitRecognizer& Recognizer) { return Recognizer.HandMesh; },
+      [&Inputs, DeltaTime](UIsdkHandDigitRecognizer& Recognizer)
+      { return Recognizer.UpdateScheduledState(Inputs, DeltaTime); });
+  NumUpdated += UpdateScheduledRecognizers(
+      PinchGrabRecognizers,
+      Hand,
+      [](const UIsdkHandFingerPinchGrabRecognizer& Recognizer) { return Recognizer.HandVisual; },
+      [&Inputs, DeltaTime](UIsdkHandFingerPinchGrabRecognizer& Recognizer)
+      { return Recognizer.UpdateScheduledState(Inputs, DeltaTime); });
+  NumUpdated += UpdateScheduledRecognizers(
+      PalmGrabRecognizers,
+      Hand,
+      [](const UIsdkHandPalmGrabRecognizer& Recognizer) { return Recognizer.HandVisual; },
+      [&Inputs, DeltaTime](UIsdkHandPalmGrabRecognizer& Recognizer)
+      { return Recognizer.UpdateScheduledState(Inputs, DeltaTime); });
+  return NumUpdated;
+}
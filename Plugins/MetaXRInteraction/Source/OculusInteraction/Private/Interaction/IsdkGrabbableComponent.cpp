@@ -110,6 +110,29 @@ void UIsdkGrabbableComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
   Super::EndPlay(EndPlayReason);
 }
 
+void UIsdkGrabbableComponent::OnRegister()
+{
+  Super::OnRegister();
+
+  // Registered along with the component rather than in BeginPlay, so that grabbers resolve the
+  // overlaps a newly spawned actor generates before it begins play
+  UIsdkWorldSubsystem* WorldSubsystem = UIsdkWorldSubsystem::TryGet(GetWorld());
+  if (WorldSubsystem && IsValid(GetOwner()))
+  {
+    WorldSubsystem->RegisterGrabbable(this);
+  }
+}
+
+void UIsdkGrabbableComponent::OnUnregister()
+{
+  if (UIsdkWorldSubsystem* WorldSubsystem = UIsdkWorldSubsystem::TryGet(GetWorld()))
+  {
+    WorldSubsystem->UnregisterGrabbable(this);
+  }
+
+  Super::OnUnregister();
+}
+
 void UIsdkGrabbableComponent::TickComponent(
     float DeltaTime,
     ELevelTick TickType,
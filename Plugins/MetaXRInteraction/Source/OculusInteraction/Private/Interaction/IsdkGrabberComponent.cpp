@@ -54,45 +54,64 @@ void UIsdkGrabberComponent::ComputeBestGrabbableColliderForGrabType(
     UPrimitiveComponent*& GrabbableCollider,
     UIsdkGrabbableComponent*& Grabbable)
 {
-  UPrimitiveComponent* Best = nullptr;
-  UIsdkGrabbableComponent* BestGrabbable = nullptr;
-  UPrimitiveComponent* MyBestCollider = nullptr;
-  float BestDist = FLT_MAX;
-  TArray<UPrimitiveComponent*> MyColliders;
-  GetCollidersByType(Type, MyColliders);
-  for (const auto ACollider : MyColliders)
-  {
-    FIsdkColliderInfo Info;
-    GetColliderInfo(ACollider, Type, Info);
-    for (const TTuple<UPrimitiveComponent*, UIsdkGrabbableComponent*> HoverObject :
-         Info.HoverObjects)
+  FGrabCandidate& Best = GetCachedCandidate(Type);
+  if (!Best.bIsValid || Best.Frame != GFrameCounter)
+  {
+    Best = FGrabCandidate{};
+    for (const auto& ColliderEntry : CollidersByType[Type])
     {
-      const auto ThisHoverCollider = HoverObject.Key;
-      if (!Best)
+      UPrimitiveComponent* ACollider = ColliderEntry.Key;
+      const FVector ColliderLocation = ACollider->GetComponentLocation();
+      for (const auto& HoverObject : ColliderEntry.Value.HoverObjects)
       {
-        Best = ThisHoverCollider;
-        BestGrabbable = HoverObject.Value;
-        MyBestCollider = ACollider;
-      }
-      else
-      {
-        const float dist =
-            (ACollider->GetComponentLocation() - ThisHoverCollider->GetComponentLocation())
-                .SizeSquared();
-        if (dist < BestDist)
+        UPrimitiveComponent* ThisHoverCollider = HoverObject.Key;
+        if (!IsValid(ThisHoverCollider))
         {
-          BestDist = dist;
-          Best = ThisHoverCollider;
-          BestGrabbable = HoverObject.Value;
-          MyBestCollider = ACollider;
+          continue;
+        }
+
+        const double Dist =
+            FVector::DistSquared(ColliderLocation, ThisHoverCollider->GetComponentLocation());
+        if (!Best.GrabbableCollider || Dist < Best.DistanceSquared)
+        {
+          Best.MyCollider = ACollider;
+          Best.GrabbableCollider = ThisHoverCollider;
+          Best.Grabbable = HoverObject.Value;
+          Best.DistanceSquared = Dist;
         }
       }
     }
+    Best.Frame = GFrameCounter;
+    Best.bIsValid = true;
+  }
+
+  MyCollider = Best.MyCollider;
+  GrabbableCollider = Best.GrabbableCollider;
+  Grabbable = Best.Grabbable;
+}
+
+void UIsdkGrabberComponent::OfferCandidate(
+    EIsdkGrabColliderType Type,
+    UPrimitiveComponent* MyCollider,
+    UPrimitiveComponent* GrabbableCollider,
+    UIsdkGrabbableComponent* Grabbable)
+{
+  // A stale candidate is rescored from scratch when it is next asked for
+  FGrabCandidate& Best = GetCachedCandidate(Type);
+  if (!Best.bIsValid || Best.Frame != GFrameCounter)
+  {
+    return;
   }
 
-  MyCollider = MyBestCollider;
-  GrabbableCollider = Best;
-  Grabbable = BestGrabbable;
+  const double Dist = FVector::DistSquared(
+      MyCollider->GetComponentLocation(), GrabbableCollider->GetComponentLocation());
+  if (!Best.GrabbableCollider || Dist < Best.DistanceSquared)
+  {
+    Best.MyCollider = MyCollider;
+    Best.GrabbableCollider = GrabbableCollider;
+    Best.Grabbable = Grabbable;
+    Best.DistanceSquared = Dist;
+  }
 }
 
 void UIsdkGrabberComponent::BeginPlay()
@@ -183,7 +202,7 @@ bool UIsdkGrabberComponent::HasSelectedInteractable() const
   return State == EIsdkInteractorState::Select;
 }
 
-UIsdkGrabbableComponent* FindGrabbableInActor(AActor* Actor)
+static UIsdkGrabbableComponent* FindGrabbableInActor(AActor* Actor)
 {
   if (auto* Grabbable = Actor->GetComponentByClass(UIsdkGrabbableComponent::StaticClass()))
   {
@@ -193,6 +212,38 @@ UIsdkGrabbableComponent* FindGrabbableInActor(AActor* Actor)
   return nullptr;
 }
 
+UIsdkGrabbableComponent* UIsdkGrabberComponent::FindGrabbableInOwner(
+    UPrimitiveComponent* OtherComp) const
+{
+  AActor* OtherActor = OtherComp->GetOwner();
+  if (!OtherActor)
+  {
+    return nullptr;
+  }
+
+  // Grabbables register with the world subsystem along with their component, which saves searching
+  // the components of every actor we overlap
+  if (UWorld* World = GetWorld())
+  {
+    if (const UIsdkWorldSubsystem* WorldSubsystem = UIsdkWorldSubsystem::TryGet(World))
+    {
+      return WorldSubsystem->LookupGrabbable(OtherActor);
+    }
+  }
+  return FindGrabbableInActor(OtherActor);
+}
+
+UIsdkGrabbableComponent* UIsdkGrabberComponent::FindGrabbableForGrabCollider(
+    UPrimitiveComponent* OtherComp) const
+{
+  UIsdkGrabbableComponent* Grabbable = FindGrabbableInOwner(OtherComp);
+  if (Grabbable && OtherComp == Grabbable->GetCollider(true)) // Use grab collider
+  {
+    return Grabbable;
+  }
+  return nullptr;
+}
+
 void UIsdkGrabberComponent::BeginOverlap(
     UPrimitiveComponent* OverlappedComponent,
     AActor* OtherActor,
@@ -201,56 +252,53 @@ void UIsdkGrabberComponent::BeginOverlap(
     bool bFromSweep,
     const FHitResult& SweepResult)
 {
-  FIsdkColliderInfo Info;
-
-  auto Type = FindColliderType(OverlappedComponent);
+  EIsdkGrabColliderType Type;
+  FIsdkColliderInfo* Info = FindColliderInfoAndType(OverlappedComponent, Type);
   // first make sure it's one of the collider components we care about and we've got a legit other
   // component
-  if (IsValid(OtherComp) && GetColliderInfo(OverlappedComponent, Type, Info))
+  if (!Info || !IsValid(OtherComp))
   {
-    if (UIsdkGrabbableComponent* Grabbable = FindGrabbableInActor(OtherComp->GetOwner()))
-    {
-      if (OtherComp == Grabbable->GetCollider(true)) // Use grab collider
-      {
-        if (!Grabbable->AllowsGrabType(Type))
-        {
-          return;
-        }
-
-        if (Type == EIsdkGrabColliderType::Palm && !bAllowPalmGrab)
-        {
-          return;
-        }
+    return;
+  }
 
-        if (Type == EIsdkGrabColliderType::Pinch && !bAllowPinchGrab)
-        {
-          return;
-        }
+  UIsdkGrabbableComponent* Grabbable = FindGrabbableForGrabCollider(OtherComp);
+  if (!Grabbable || !Grabbable->AllowsGrabType(Type))
+  {
+    return;
+  }
 
-        if (!Info.HoverObjects.Contains(OtherComp))
-        {
-          Info.HoverObjects.Add(OtherComp, Grabbable);
-        }
-        Info.RankIndex = NextRankIndex++;
-        if (Info.State == EIsdkInteractorState::Normal)
-        {
-          Info.State = EIsdkInteractorState::Hover;
-        }
-        SetColliderInfo(OverlappedComponent, Type, Info);
-        PostEvent(EIsdkPointerEventType::Hover, Grabbable);
+  if (Type == EIsdkGrabColliderType::Palm && !bAllowPalmGrab)
+  {
+    return;
+  }
 
-        UPrimitiveComponent* MyCollider;
-        UPrimitiveComponent* BestCollider;
-        UIsdkGrabbableComponent* BestGrabbable;
-        ComputeBestGrabbableColliderForGrabType(Type, MyCollider, BestCollider, BestGrabbable);
-        CandidateGrabbable = BestGrabbable;
+  if (Type == EIsdkGrabColliderType::Pinch && !bAllowPinchGrab)
+  {
+    return;
+  }
 
-        UpdateState();
-      }
-    }
+  if (!Info->HoverObjects.Contains(OtherComp))
+  {
+    Info->HoverObjects.Add(OtherComp, Grabbable);
+    AddOverlapReference(Grabbable);
+    OfferCandidate(Type, OverlappedComponent, OtherComp, Grabbable);
+  }
+  Info->RankIndex = NextRankIndex++;
+  if (Info->State == EIsdkInteractorState::Normal)
+  {
+    Info->State = EIsdkInteractorState::Hover;
   }
 
-  UpdateOverlappedSet();
+  // Listeners may add or remove colliders, Info must not be used past this point
+  PostEvent(EIsdkPointerEventType::Hover, Grabbable);
+
+  UPrimitiveComponent* MyCollider;
+  UPrimitiveComponent* BestCollider;
+  UIsdkGrabbableComponent* BestGrabbable;
+  ComputeBestGrabbableColliderForGrabType(Type, MyCollider, BestCollider, BestGrabbable);
+  CandidateGrabbable = BestGrabbable;
+
+  UpdateState();
 }
 
 void UIsdkGrabberComponent::EndOverlap(
@@ -259,87 +307,125 @@ void UIsdkGrabberComponent::EndOverlap(
     UPrimitiveComponent* OtherComp,
     int32 OtherBodyIndex)
 {
-  FIsdkColliderInfo Info;
-
-  auto Type = FindColliderType(OverlappedComponent);
+  EIsdkGrabColliderType Type;
+  FIsdkColliderInfo* Info = FindColliderInfoAndType(OverlappedComponent, Type);
   // first make sure it's one of the collider components we care about
-  if (!GetColliderInfo(OverlappedComponent, Type, Info))
+  if (!Info)
   {
     return;
   }
 
   // have we already started tracking this particular component of the grabbable's?
-  if (UIsdkGrabbableComponent** Grabbable = Info.HoverObjects.Find(OtherComp))
+  bool bWasHovered = false;
+  UIsdkGrabbableComponent* UnhoveredGrabbable = nullptr;
+  if (UIsdkGrabbableComponent** HoveredGrabbable = Info->HoverObjects.Find(OtherComp))
   {
-    if (IsValid(*Grabbable))
+    bWasHovered = true;
+    UnhoveredGrabbable = *HoveredGrabbable;
+    if (IsValid(UnhoveredGrabbable))
+    {
+      PostEvent(EIsdkPointerEventType::Unhover, UnhoveredGrabbable);
+    }
+
+    // Listeners may have added or removed colliders
+    Info = FindColliderInfoAndType(OverlappedComponent, Type);
+    if (!Info)
     {
-      PostEvent(EIsdkPointerEventType::Unhover, *Grabbable);
+      UpdateState();
+      return;
     }
-    Info.HoverObjects.Remove(OtherComp);
-    if (Info.HoverObjects.IsEmpty() && Info.State != EIsdkInteractorState::Select)
+
+    if (Info->HoverObjects.Remove(OtherComp) > 0)
+    {
+      RemoveOverlapReference(UnhoveredGrabbable);
+    }
+    if (Info->HoverObjects.IsEmpty() && Info->State != EIsdkInteractorState::Select)
+    {
+      Info->State = EIsdkInteractorState::Normal;
+    }
+
+    // Losing any other hover leaves the nearest one as it is
+    const FGrabCandidate& Best = GetCachedCandidate(Type);
+    if (Best.MyCollider == OverlappedComponent && Best.GrabbableCollider == OtherComp)
     {
-      Info.State = EIsdkInteractorState::Normal;
+      InvalidateCachedCandidate(Type);
     }
-    SetColliderInfo(OverlappedComponent, Type, Info);
   }
 
-  if (IsValid(OtherComp))
+  // Nothing below applies unless this collider hovered, selected or proposed the other component
+  if (!IsValid(OtherComp) ||
+      (!bWasHovered && !IsValid(Info->SelectObject) && !IsValid(CandidateGrabbable)))
   {
-    UIsdkGrabbableComponent* Grabbable = FindGrabbableInActor(OtherComp->GetOwner());
-    if (Grabbable)
-    {
-      // if hand moves too fast it can move outside the currently grabbed object, so check here to
-      // see if we're currently grabbing something
-      if (State != EIsdkInteractorState::Select)
-      {
-        if (Grabbable == Info.SelectObject)
-        {
-          Info.SelectObject = nullptr;
-          SetColliderInfo(OverlappedComponent, Type, Info);
-        }
-      }
+    return;
+  }
 
-      if (CandidateGrabbable == Grabbable)
+  // A hovered component already names its grabbable, which may have unregistered by now if its
+  // actor is being destroyed
+  UIsdkGrabbableComponent* Grabbable =
+      IsValid(UnhoveredGrabbable) ? UnhoveredGrabbable : FindGrabbableInOwner(OtherComp);
+  if (Grabbable)
+  {
+    // if hand moves too fast it can move outside the currently grabbed object, so check here to
+    // see if we're currently grabbing something
+    if (State != EIsdkInteractorState::Select)
+    {
+      if (Grabbable == Info->SelectObject)
       {
-        UPrimitiveComponent* BestCollider;
-        UIsdkGrabbableComponent* BestGrabbable;
-        UPrimitiveComponent* MyCollider;
-        ComputeBestGrabbableColliderForGrabType(Type, MyCollider, BestCollider, BestGrabbable);
-        CandidateGrabbable = BestGrabbable;
+        RemoveOverlapReference(Info->SelectObject);
+        Info->SelectObject = nullptr;
       }
+    }
 
-      UpdateState();
+    if (CandidateGrabbable == Grabbable)
+    {
+      UPrimitiveComponent* BestCollider;
+      UIsdkGrabbableComponent* BestGrabbable;
+      UPrimitiveComponent* MyCollider;
+      ComputeBestGrabbableColliderForGrabType(Type, MyCollider, BestCollider, BestGrabbable);
+      CandidateGrabbable = BestGrabbable;
     }
   }
 
-  UpdateOverlappedSet();
+  if (Grabbable || bWasHovered)
+  {
+    UpdateState();
+  }
 }
 
-void UIsdkGrabberComponent::UpdateOverlappedSet()
+void UIsdkGrabberComponent::AddOverlapReference(UIsdkGrabbableComponent* Grabbable)
 {
-  OverlappedGrabbables.Empty();
+  if (Grabbable && OverlapReferenceCounts.FindOrAdd(Grabbable)++ == 0)
+  {
+    OverlappedGrabbables.Add(Grabbable);
+  }
+}
 
-  for (const TTuple<EIsdkGrabColliderType, PrimitiveComponentToColliderInfoMap>&
-           ColliderTypeInfoMapPair : CollidersByType)
+void UIsdkGrabberComponent::RemoveOverlapReference(UIsdkGrabbableComponent* Grabbable)
+{
+  int32* ReferenceCount = Grabbable ? OverlapReferenceCounts.Find(Grabbable) : nullptr;
+  if (ReferenceCount && --(*ReferenceCount) == 0)
   {
-    for (const TTuple<UPrimitiveComponent*, FIsdkColliderInfo>& ColliderEntry :
-         ColliderTypeInfoMapPair.Value)
-    {
-      for (const TTuple<UPrimitiveComponent*, UIsdkGrabbableComponent*>& HoverObject :
-           ColliderEntry.Value.HoverObjects)
-      {
-        UIsdkGrabbableComponent* HoveredGrabbable = HoverObject.Value;
-        if (IsValid(HoveredGrabbable))
-        {
-          OverlappedGrabbables.FindOrAdd(HoveredGrabbable);
-        }
-      }
-      if (IsValid(ColliderEntry.Value.SelectObject))
-      {
-        OverlappedGrabbables.FindOrAdd(ColliderEntry.Value.SelectObject);
-      }
-    }
+    OverlapReferenceCounts.Remove(Grabbable);
+    OverlappedGrabbables.Remove(Grabbable);
+  }
+}
+
+void UIsdkGrabberComponent::AddOverlapReferences(const FIsdkColliderInfo& Info)
+{
+  for (const auto& HoverObject : Info.HoverObjects)
+  {
+    AddOverlapReference(HoverObject.Value);
+  }
+  AddOverlapReference(Info.SelectObject);
+}
+
+void UIsdkGrabberComponent::RemoveOverlapReferences(const FIsdkColliderInfo& Info)
+{
+  for (const auto& HoverObject : Info.HoverObjects)
+  {
+    RemoveOverlapReference(HoverObject.Value);
   }
+  RemoveOverlapReference(Info.SelectObject);
 }
 
 void UIsdkGrabberComponent::UpdateState()
@@ -420,12 +506,15 @@ void UIsdkGrabberComponent::SelectByGrabType(EIsdkGrabColliderType Type)
   {
     SelectingCollider = MyCollider;
     SelectingColliderType = Type;
-    FIsdkColliderInfo Info;
-    if (GetColliderInfo(SelectingCollider, Type, Info))
+    if (FIsdkColliderInfo* Info = FindColliderInfo(SelectingCollider, Type))
     {
-      Info.State = EIsdkInteractorState::Select;
-      Info.SelectObject = BestGrabbable;
-      SetColliderInfo(SelectingCollider, Type, Info);
+      Info->State = EIsdkInteractorState::Select;
+      if (Info->SelectObject != BestGrabbable)
+      {
+        RemoveOverlapReference(Info->SelectObject);
+        Info->SelectObject = BestGrabbable;
+        AddOverlapReference(BestGrabbable);
+      }
       GrabbedComponent = BestGrabbable;
       bIsGrabbing = true;
       UpdateState();
@@ -440,7 +529,7 @@ void UIsdkGrabberComponent::SelectByGrabType(EIsdkGrabColliderType Type)
             this, &UIsdkGrabberComponent::HandleGrabbableCancelEvent);
       }
 
-      PostEvent(EIsdkPointerEventType::Select, Info.SelectObject);
+      PostEvent(EIsdkPointerEventType::Select, BestGrabbable);
     }
   }
 }
@@ -449,22 +538,24 @@ void UIsdkGrabberComponent::UnselectByGrabType(EIsdkGrabColliderType Type)
 {
   if (SelectingCollider && SelectingColliderType == Type)
   {
-    FIsdkColliderInfo Info;
-    if (GetColliderInfo(SelectingCollider, Type, Info))
+    if (const FIsdkColliderInfo* SelectingInfo = FindColliderInfo(SelectingCollider, Type))
     {
-      if (Info.SelectObject)
+      if (SelectingInfo->SelectObject)
       {
-        PostEvent(EIsdkPointerEventType::Unselect, Info.SelectObject);
+        PostEvent(EIsdkPointerEventType::Unselect, SelectingInfo->SelectObject);
       }
-      if (!Info.HoverObjects.IsEmpty())
+    }
+    // Listeners may have added or removed colliders
+    if (FIsdkColliderInfo* Info = FindColliderInfo(SelectingCollider, Type))
+    {
+      if (!Info->HoverObjects.IsEmpty())
       {
-        Info.State = EIsdkInteractorState::Hover;
+        Info->State = EIsdkInteractorState::Hover;
       }
       else
       {
-        Info.State = EIsdkInteractorState::Normal;
+        Info->State = EIsdkInteractorState::Normal;
       }
-      SetColliderInfo(SelectingCollider, Type, Info);
     }
     SelectingCollider = nullptr;
 
@@ -556,10 +647,10 @@ void UIsdkGrabberComponent::TickComponent(
   {
     if (SelectingCollider)
     {
-      FIsdkColliderInfo Info;
-      if (GetColliderInfo(SelectingCollider, SelectingColliderType, Info))
+      if (const FIsdkColliderInfo* Info =
+              FindColliderInfo(SelectingCollider, SelectingColliderType))
       {
-        PostEvent(EIsdkPointerEventType::Move, Info.SelectObject);
+        PostEvent(EIsdkPointerEventType::Move, Info->SelectObject);
       }
     }
   }
@@ -574,6 +665,7 @@ void UIsdkGrabberComponent::AddCollider(UPrimitiveComponent* Collider, EIsdkGrab
     {
       FIsdkColliderInfo Info;
       CollidersOfType.Emplace(Collider, Info);
+      InvalidateCachedCandidate(Type);
       Collider->OnComponentBeginOverlap.AddDynamic(this, &UIsdkGrabberComponent::BeginOverlap);
       Collider->OnComponentEndOverlap.AddDynamic(this, &UIsdkGrabberComponent::EndOverlap);
     }
@@ -592,22 +684,56 @@ void UIsdkGrabberComponent::UnregisterCollider(
       Collider->OnComponentBeginOverlap.RemoveDynamic(this, &UIsdkGrabberComponent::BeginOverlap);
       Collider->OnComponentEndOverlap.RemoveDynamic(this, &UIsdkGrabberComponent::EndOverlap);
     }
+    RemoveCollider(Collider, Type);
+  }
+}
+
+void UIsdkGrabberComponent::RemoveCollider(
+    UPrimitiveComponent* Collider,
+    EIsdkGrabColliderType Type)
+{
+  auto& CollidersOfType = CollidersByType[Type];
+  if (const FIsdkColliderInfo* Info = CollidersOfType.Find(Collider))
+  {
+    RemoveOverlapReferences(*Info);
     CollidersOfType.Remove(Collider);
+    InvalidateCachedCandidate(Type);
   }
 }
 
-EIsdkGrabColliderType UIsdkGrabberComponent::FindColliderType(UPrimitiveComponent* Collider) const
+void UIsdkGrabberComponent::SetColliderInfo(
+    UPrimitiveComponent* Collider,
+    EIsdkGrabColliderType Type,
+    const FIsdkColliderInfo& ColliderInfo)
 {
-  for (const auto& TypeIT : CollidersByType)
+  if (CollidersByType.Contains(Type))
   {
-    auto Type = TypeIT.Key;
-    if (TypeIT.Value.Contains(Collider))
+    auto& CollidersOfType = CollidersByType[Type];
+    if (const FIsdkColliderInfo* PreviousInfo = CollidersOfType.Find(Collider))
     {
-      return Type;
+      RemoveOverlapReferences(*PreviousInfo);
     }
+    AddOverlapReferences(ColliderInfo);
+    CollidersOfType.Emplace(Collider, ColliderInfo);
+    InvalidateCachedCandidate(Type);
   }
+}
 
-  return EIsdkGrabColliderType::Unknown;
+FIsdkColliderInfo* UIsdkGrabberComponent::FindColliderInfoAndType(
+    UPrimitiveComponent* Collider,
+    EIsdkGrabColliderType& OutType)
+{
+  for (auto& TypeIT : CollidersByType)
+  {
+    if (FIsdkColliderInfo* Info = TypeIT.Value.Find(Collider))
+    {
+      OutType = TypeIT.Key;
+      return Info;
+    }
+  }
+
+  OutType = EIsdkGrabColliderType::Unknown;
+  return nullptr;
 }
 
 FVector UIsdkGrabberComponent::GetSelectingColliderPosition()
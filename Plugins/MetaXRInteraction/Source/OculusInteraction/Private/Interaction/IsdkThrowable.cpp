@@ -29,23 +29,27 @@ UIsdkThrowable::UIsdkThrowable()
 
 void UIsdkThrowable::SetSamplePositions(TArray<TPair<FVector, float>>& Positions)
 {
-  LastNPositions = Positions;
+  PositionHistory.Init(FMath::Max(Settings.SampleSize, Positions.Num()));
+  for (const TPair<FVector, float>& PositionTimestampPair : Positions)
+  {
+    PositionHistory.Add(PositionTimestampPair.Key, PositionTimestampPair.Value);
+  }
 }
 
 void UIsdkThrowable::SetSampleRotations(TArray<TPair<FQuat, float>>& Rotations)
 {
-  LastNRotations = Rotations;
+  RotationHistory.Init(FMath::Max(Settings.SampleSize, Rotations.Num()));
+  for (const TPair<FQuat, float>& RotationTimestampPair : Rotations)
+  {
+    RotationHistory.Add(RotationTimestampPair.Key, RotationTimestampPair.Value);
+  }
 }
 
 void UIsdkThrowable::BeginPlay()
 {
   Super::BeginPlay();
   IsFirstFrame = true;
-  LastNPositions.Init(TPair<FVector, float>(FVector::ZeroVector, 0.0f), Settings.SampleSize);
-  LastNRotations.Init(TPair<FQuat, float>(FQuat::Identity, 0.0f), Settings.SampleSize);
-  CurrentPositionIndex = 0;
-  CurrentRotationIndex = 0;
-  PreviousPositionIndex = 0;
+  InitSampleHistories();
 
   ResetKalmanFilter();
 
@@ -55,6 +59,14 @@ void UIsdkThrowable::BeginPlay()
   Settings.LastTime = GetWorld()->GetTimeSeconds();
 }
 
+void UIsdkThrowable::InitSampleHistories()
+{
+  PositionHistory.Init(Settings.SampleSize);
+  RotationHistory.Init(Settings.SampleSize);
+  WindowPositions.Reserve(Settings.SampleSize);
+  WindowTimes.Reserve(Settings.SampleSize);
+}
+
 // Called every frame
 void UIsdkThrowable::TickComponent(
     float DeltaTime,
@@ -76,79 +88,40 @@ void UIsdkThrowable::TickComponent(
     ProcessKalmanFilter();
   }
 
-  // Store the current position and timestamp
-  LastNPositions[CurrentPositionIndex] =
-      TPair<FVector, float>(TrackedComponent->GetComponentLocation(), GetWorld()->GetTimeSeconds());
-  PreviousPositionIndex = CurrentPositionIndex;
-  CurrentPositionIndex = (CurrentPositionIndex + 1) % Settings.SampleSize;
-  LastNRotations[CurrentRotationIndex] =
-      TPair<FQuat, float>(TrackedComponent->GetComponentQuat(), GetWorld()->GetTimeSeconds());
-  CurrentRotationIndex = (CurrentRotationIndex + 1) % Settings.SampleSize;
-}
-
-void UIsdkThrowable::GetLastNPositions(int32 N, TArray<TPair<FVector, float>>& OutPositions)
-{
-  OutPositions.Empty();
-
-  for (int32 i = 0; i < N; i++)
-  {
-    const int32 Index = (CurrentPositionIndex - i - 1 + Settings.SampleSize) % Settings.SampleSize;
-    TPair<FVector, float> PositionTimestampPair = LastNPositions[Index];
-
-    // Add initialized positions only
-    if (PositionTimestampPair.Key != FVector::ZeroVector)
-    {
-      OutPositions.Insert(PositionTimestampPair, 0);
-    }
-  }
+  // Store the current position, rotation and timestamp
+  const float Time = GetWorld()->GetTimeSeconds();
+  PositionHistory.Add(TrackedComponent->GetComponentLocation(), Time);
+  RotationHistory.Add(TrackedComponent->GetComponentQuat(), Time);
 }
 
 FVector UIsdkThrowable::GetVelocity()
 {
-  TArray<TPair<FVector, float>> Positions;
-  GetLastNPositions(LastNPositions.Num(), Positions);
-
-  int32 numPositions = Positions.Num();
+  const int32 NumPositions =
+      PositionHistory.CopyNewest(PositionHistory.Num(), WindowPositions, WindowTimes);
 
   // Check if there are enough tracked positions
-  if (numPositions <= 1)
+  if (NumPositions <= 1)
   {
     return FVector::ZeroVector;
   }
 
-  TArray<FVector> PositionValues;
-  for (const TPair<FVector, float>& PositionTimestampPair : Positions)
-  {
-    PositionValues.Add(PositionTimestampPair.Key);
-  }
-
-  const FVector Mean = FIsdkMathUtils::GetMean(PositionValues);
-  const FVector StandardDeviation = FIsdkMathUtils::GetStandardDeviation(PositionValues, Mean);
-
   // Filter out positions that are more than a certain number of standard deviations away from the
   // mean
-  TArray<TPair<FVector, float>> FilteredPositions;
-  FilteredPositions.Reserve(numPositions);
+  FIsdkMathUtils::FilterByZScore(WindowPositions, WindowTimes, Settings.Z_Score_Threshold);
 
-  for (const TPair<FVector, float>& PositionTimestampPair : Positions)
-  {
-    FVector Position = PositionTimestampPair.Key;
-    FVector ZScore = (Position - Mean) / StandardDeviation;
-    if (ZScore.GetMax() <= Settings.Z_Score_Threshold)
-    {
-      FilteredPositions.Add(PositionTimestampPair);
-    }
-  }
-
-  LastNPositions.Init(TPair<FVector, float>(FVector::ZeroVector, 0.0f), Settings.SampleSize);
+  PositionHistory.Reset();
 
   switch (Settings.VelocityEstimationMethod)
   {
     case EIsdkVelocityEstimationMethod::VE_LeastSquares:
-      return FIsdkMathUtils::LeastSquares(FilteredPositions)
+      return FIsdkMathUtils::LeastSquares(WindowPositions, WindowTimes)
           .GetClampedToSize(MinVelocity, MaxVelocity);
     case EIsdkVelocityEstimationMethod::VE_RANSAC:
-      return FIsdkMathUtils::Ransac(FilteredPositions, Ransac_Iterations, Ransac_Score_Threshold);
+    {
+      FRandomStream Random(Settings.RansacSeed);
+      return FIsdkMathUtils::Ransac(
+          WindowPositions, WindowTimes, Ransac_Iterations, Ransac_Score_Threshold, Random);
+    }
     case EIsdkVelocityEstimationMethod::VE_KalmanFilter:
       return KalmanParams.V;
     default:
@@ -158,27 +131,31 @@ FVector UIsdkThrowable::GetVelocity()
 
 FQuat UIsdkThrowable::GetAngularVelocity()
 {
+  const int32 NumRotations = RotationHistory.Num();
   FVector SumAngularVelocity = FVector::ZeroVector;
-  for (int i = 0; i < LastNRotations.Num() - 1; i++)
+  for (int i = 0; i < NumRotations - 1; i++)
   {
-    const FQuat CurrentRotation = LastNRotations[i].Key;
-    const FQuat NextRotation = LastNRotations[i + 1].Key;
-    const FQuat RotationDifference = FQuat::Slerp(
-        CurrentRotation,
-        NextRotation,
-        (LastNRotations[i + 1].Value - LastNRotations[i].Value) / Settings.SampleSize);
+    const FQuat CurrentRotation = RotationHistory.GetSample(i);
+    const FQuat NextRotation = RotationHistory.GetSample(i + 1);
+    const float TimeDelta = RotationHistory.GetTime(i + 1) - RotationHistory.GetTime(i);
+    const FQuat RotationDifference =
+        FQuat::Slerp(CurrentRotation, NextRotation, TimeDelta / Settings.SampleSize);
     FVector Axis;
     float Angle;
     RotationDifference.ToAxisAndAngle(Axis, Angle);
     Angle = FMath::Fmod(Angle, 2 * PI);
-    const FVector AngularVelocity =
-        Axis * Angle / (LastNRotations[i + 1].Value - LastNRotations[i].Value);
+    const FVector AngularVelocity = Axis * Angle / TimeDelta;
     SumAngularVelocity += AngularVelocity;
   }
 
-  LastNRotations.Init(TPair<FQuat, float>(FQuat::Identity, 0.0f), Settings.SampleSize);
+  RotationHistory.Reset();
+
+  if (NumRotations <= 1)
+  {
+    return FQuat::Identity;
+  }
 
-  const FVector AverageAngularVelocity = SumAngularVelocity / (LastNRotations.Num() - 1);
+  const FVector AverageAngularVelocity = SumAngularVelocity / (NumRotations - 1);
   FMath::Clamp(AverageAngularVelocity.X, -MaxAngularSpeed, MaxAngularSpeed);
   FMath::Clamp(AverageAngularVelocity.Y, -MaxAngularSpeed, MaxAngularSpeed);
   FMath::Clamp(AverageAngularVelocity.Z, -MaxAngularSpeed, MaxAngularSpeed);
@@ -217,9 +194,7 @@ void UIsdkThrowable::ProcessKalmanFilter()
 
   FIsdkMathUtils::UpdateKalmanFilter(KalmanParams, Z, DT);
 
-  KalmanParams.V.X = FMath::Clamp(KalmanParams.V.X, MinVelocity, MaxVelocity);
-  KalmanParams.V.Y = FMath::Clamp(KalmanParams.V.Y, MinVelocity, MaxVelocity);
-  KalmanParams.V.Z = FMath::Clamp(KalmanParams.V.Z, MinVelocity, MaxVelocity);
+  KalmanParams.V = KalmanParams.V.BoundToBox(FVector(MinVelocity), FVector(MaxVelocity));
 
   Settings.LastTime = GetWorld()->GetTimeSeconds();
 }
@@ -228,15 +203,15 @@ bool UIsdkThrowable::CheckPositionConstraints()
 {
   if (!IsFirstFrame)
   {
-    if (LastNPositions[PreviousPositionIndex].Key != FVector::ZeroVector)
+    if (!PositionHistory.IsEmpty())
     {
       // Check for erratic movement and lack of movement
       if (auto Distance = FVector::Dist(
-              LastNPositions[PreviousPositionIndex].Key, TrackedComponent->GetComponentLocation());
+              PositionHistory.GetNewestSample(), TrackedComponent->GetComponentLocation());
           Distance < MinPositionThreshold || Distance > MaxPositionThreshold)
       {
         ResetKalmanFilter();
-        LastNPositions.Init(TPair<FVector, float>(FVector::ZeroVector, 0.0f), Settings.SampleSize);
+        PositionHistory.Reset();
 
         return false;
       }
@@ -54,6 +54,9 @@ TAutoConsoleVariable<bool> CVar_Meta_InteractionSDK_DebugHandVisuals(
 
 namespace isdk::api::helper
 {
+// Shared by all hands, so a version never repeats even if a recognizer moves to another hand
+static uint64 GIsdkHandPositionFrameVersion = 0;
+
 class FExternalHandPositionFrameImpl
     : public FApiImpl<ExternalHandPositionFrame, ExternalHandPositionFramePtr>
 {
@@ -64,6 +67,10 @@ class FExternalHandPositionFrameImpl
   }
 
   std::array<ovrpVector3f, UIsdkHandMeshComponent::MappedBoneCount> WristSpaceJointLocations{};
+  ovrpVector3f WristLocation{};
+
+  // Version of the joint data last written to the instance, 0 before the first write
+  uint64 FrameVersion = 0;
 };
 } // namespace isdk::api::helper
 
@@ -144,6 +151,8 @@ UIsdkHandMeshComponent::UIsdkHandMeshComponent()
               return nullptr;
             }
 
+            // A new instance has no joint data yet, whatever was written before
+            ExternalHandPositionFrameImpl->FrameVersion = 0;
             if (MappingState == EIsdkSkeletonMappingState::Valid)
             {
               UpdateApiHandPositionFrame(Instance.Get());
@@ -185,6 +194,21 @@ isdk::api::IHandPositionFrame* UIsdkHandMeshComponent::TryGetApiIHandPositionFra
   return nullptr;
 }
 
+uint64 UIsdkHandMeshComponent::GetHandPositionFrameVersion() const
+{
+  return ExternalHandPositionFrameImpl->FrameVersion;
+}
+
+bool UIsdkHandMeshComponent::RegisterHandPoseRecognizer(UObject* Recognizer)
+{
+  return HandPoseRecognizers.Register(*this, Recognizer);
+}
+
+void UIsdkHandMeshComponent::UnregisterHandPoseRecognizer(UObject* Recognizer)
+{
+  HandPoseRecognizers.Unregister(Recognizer);
+}
+
 UObject* UIsdkHandMeshComponent::GetSkeletalMesh() const
 {
 #if defined(ENGINE_MAJOR_VERSION) && ENGINE_MAJOR_VERSION == 4
@@ -213,6 +237,21 @@ void UIsdkHandMeshComponent::InitializeSkeleton()
     }
     MappedBoneIndices[BoneNameIndex] = BoneIndex;
   }
+
+#if defined(ENGINE_MAJOR_VERSION) && ENGINE_MAJOR_VERSION == 4
+  auto SkinnedMesh = SkeletalMesh;
+#else
+  auto SkinnedMesh = GetSkinnedAsset();
+#endif
+  const FReferenceSkeleton& RefSkeleton = SkinnedMesh->GetRefSkeleton();
+  TArray<int32> ParentIndices;
+  ParentIndices.SetNumUninitialized(RefSkeleton.GetNum());
+  for (int32 BoneIndex = 0; BoneIndex < RefSkeleton.GetNum(); ++BoneIndex)
+  {
+    ParentIndices[BoneIndex] = RefSkeleton.GetParentIndex(BoneIndex);
+  }
+  PoseBatch.Initialize(ParentIndices);
+
   SetValidMappingState(GetSkeletalMesh());
 }
 
@@ -282,6 +321,12 @@ void UIsdkHandMeshComponent::TickComponent(
     UpdateApiHandPositionFrame(ExternalHandPositionFrameImpl->GetInstanceChecked());
   }
 
+  // Recognizers read the hand position frame, so they run once it has this tick's joints
+  if (!HandPoseRecognizers.IsEmpty())
+  {
+    HandPoseRecognizers.Update(*this, DeltaTime);
+  }
+
   // Enable this to see debug visuals for the skeleton in world space based on the HandJoints data
   if (isdk::CVar_Meta_InteractionSDK_DebugHandVisuals.GetValueOnAnyThread())
   {
@@ -404,44 +449,33 @@ void UIsdkHandMeshComponent::UpdateSkeleton()
   {
     TArray<FTransform>& SourcePoses = HandDataSource->GetJointPoses();
     const bool bHandPoseOverrideValid = bHandPoseOverridden && IsValid(HandDataOverride);
-    TArray<FTransform> OverridePoses = {};
+    TConstArrayView<FTransform> OverridePoses;
 
     // Check if we're overriding the pose
     if (bHandPoseOverrideValid)
     {
-      OverridePoses = HandDataOverride->GetJointPoses();
       // If we're not lerping, use the override pose array
       if (HandPoseLerpState == EIsdkLerpState::Inactive)
       {
         SourcePoses = HandDataOverride->GetJointPoses();
       }
-    }
-
-    constexpr auto WristSpace = EBoneSpaces::Type::ComponentSpace;
-    const int BoneCount = UIsdkHandData::GetNumJoints();
-    for (int BoneId = 0; BoneId < BoneCount; BoneId++)
-    {
-      const FName BoneName = MappedBoneNames[BoneId];
-
-      FTransform BoneTransform = GetBoneTransformByName(BoneName, WristSpace);
-      if ((uint8)HandPoseLerpState > 0)
-      {
-        BoneTransform.SetLocation(FMath::Lerp(
-            SourcePoses[BoneId].GetLocation(),
-            OverridePoses[BoneId].GetLocation(),
-            HandPoseLerpAlpha));
-        BoneTransform.SetRotation(FMath::Lerp(
-            SourcePoses[BoneId].GetRotation(),
-            OverridePoses[BoneId].GetRotation(),
-            HandPoseLerpAlpha));
-      }
       else
       {
-        BoneTransform.SetLocation(SourcePoses[BoneId].GetLocation());
-        BoneTransform.SetRotation(SourcePoses[BoneId].GetRotation());
+        OverridePoses = HandDataOverride->GetJointPoses();
       }
+    }
 
-      SetBoneTransformByName(BoneName, BoneTransform, WristSpace);
+    if (CanApplyPose())
+    {
+      const int BoneCount = UIsdkHandData::GetNumJoints();
+      PoseBatch.Begin(BoneSpaceTransforms);
+      ApplyJointPoses(
+          PoseBatch,
+          MakeArrayView(MappedBoneIndices, BoneCount),
+          SourcePoses,
+          OverridePoses,
+          HandPoseLerpAlpha);
+      PoseBatch.End();
     }
 
     // Check if we're done lerping in
@@ -462,15 +496,62 @@ void UIsdkHandMeshComponent::UpdateSkeleton()
   }
 }
 
+bool UIsdkHandMeshComponent::CanApplyPose() const
+{
+  // Same conditions as the per-bone setters of UPoseableMeshComponent
+  return IsValid(GetSkeletalMesh()) && RequiredBones.IsValid() &&
+      BoneSpaceTransforms.Num() == PoseBatch.GetNumBones();
+}
+
+void UIsdkHandMeshComponent::ApplyJointPoses(
+    FIsdkSkeletonPoseBatch& Batch,
+    TConstArrayView<int32> JointBoneIndices,
+    TConstArrayView<FTransform> SourcePoses,
+    TConstArrayView<FTransform> OverridePoses,
+    float OverrideAlpha)
+{
+  const bool bBlend = !OverridePoses.IsEmpty();
+  for (int JointId = 0; JointId < JointBoneIndices.Num(); JointId++)
+  {
+    const int32 BoneIndex = JointBoneIndices[JointId];
+    const FTransform& SourcePose = SourcePoses[JointId];
+
+    FTransform BoneTransform = Batch.GetComponentSpaceTransform(BoneIndex);
+    if (bBlend)
+    {
+      const FTransform& OverridePose = OverridePoses[JointId];
+      BoneTransform.SetLocation(
+          FMath::Lerp(SourcePose.GetLocation(), OverridePose.GetLocation(), OverrideAlpha));
+      // Slerp takes the shortest path and returns a normalized rotation
+      BoneTransform.SetRotation(
+          FQuat::Slerp(SourcePose.GetRotation(), OverridePose.GetRotation(), OverrideAlpha));
+    }
+    else
+    {
+      BoneTransform.SetLocation(SourcePose.GetLocation());
+      BoneTransform.SetRotation(SourcePose.GetRotation());
+    }
+
+    Batch.SetComponentSpaceTransform(BoneIndex, BoneTransform);
+  }
+}
+
 void UIsdkHandMeshComponent::UpdateApiHandPositionFrame(
     ExternalHandPositionFrame& ApiHandPositionFrame) const
 {
+  const auto IsSameLocation = [](const ovrpVector3f& A, const ovrpVector3f& B)
+  { return A.x == B.x && A.y == B.y && A.z == B.z; };
+  auto& FrameImpl = *ExternalHandPositionFrameImpl;
+  bool bFrameChanged = FrameImpl.FrameVersion == 0;
+
   // Set Wrist Position
   const auto ApiWristPosition = StructTypesUtils::Convert(GetComponentLocation());
   ApiHandPositionFrame.setWristData(&ApiWristPosition);
+  bFrameChanged |= !IsSameLocation(FrameImpl.WristLocation, ApiWristPosition);
+  FrameImpl.WristLocation = ApiWristPosition;
 
   // Set Joint Positions
-  auto& ApiJointLocations = ExternalHandPositionFrameImpl->WristSpaceJointLocations;
+  auto& ApiJointLocations = FrameImpl.WristSpaceJointLocations;
 
   FA2CSPose CSPose;
   CSPose.AllocateLocalPoses(RequiredBones, GetBoneSpaceTransforms());
@@ -479,10 +560,17 @@ void UIsdkHandMeshComponent::UpdateApiHandPositionFrame(
     const int BoneIndex = MappedBoneIndices[BoneId];
     const auto WristSpaceTransform = CSPose.GetComponentSpaceTransform(BoneIndex);
 
-    ApiJointLocations[BoneId] = StructTypesUtils::Convert(WristSpaceTransform.GetLocation());
+    const auto ApiJointLocation = StructTypesUtils::Convert(WristSpaceTransform.GetLocation());
+    bFrameChanged |= !IsSameLocation(ApiJointLocations[BoneId], ApiJointLocation);
+    ApiJointLocations[BoneId] = ApiJointLocation;
   }
 
   ApiHandPositionFrame.setJointData(ApiJointLocations.data(), ApiJointLocations.size());
+
+  if (bFrameChanged)
+  {
+    FrameImpl.FrameVersion = ++isdk::api::helper::GIsdkHandPositionFrameVersion;
+  }
 }
 
 bool UIsdkHandMeshComponent::IsDataSourceRootPoseValid() const
@@ -0,0 +1,260 @@
+﻿/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/PimplPtr.h"
+#include "IsdkEventQueueImpl.h"
+
+namespace isdk::api::helper
+{
+/**
+ * Event handler subscriptions of one queue type. Subscriptions live in one array, in the order they
+ * were registered, and are looked up by token only when registering or unregistering.
+ * Removals are deferred to the start of the next frame so that handlers may unsubscribe while
+ * events are dispatched.
+ */
+template <class TQueueImpl>
+class TIsdkEventSubscriptions
+{
+ public:
+  using FToken = int64;
+  using QueueUniquePtr = TPimplPtr<TQueueImpl>;
+
+  explicit TIsdkEventSubscriptions(const TCHAR* InName) : Name(InName) {}
+
+  void BeginFrame()
+  {
+    for (const FToken Token : PendingCreate)
+    {
+      TQueueImpl& Queue = *Subscriptions[SubscriptionIndices.FindChecked(Token)].Queue;
+      Queue.CreateInstanceIfNotExists();
+    }
+    PendingCreate.Reset();
+
+    // If anything unsubscribed during a callback, now is when we process those removals.
+    ProcessPendingDeletes();
+  }
+
+  FToken RegisterEventHandler(QueueUniquePtr&& EventQueueImpl)
+  {
+    const FToken Token = NextToken++;
+    SubscriptionIndices.Add(Token, Subscriptions.Num());
+    Subscriptions.Add({Token, MoveTemp(EventQueueImpl)});
+    PendingCreate.Add(Token);
+    return Token;
+  }
+
+  void UnregisterEventHandler(const FToken Token)
+  {
+    if (Token != 0)
+    {
+      if (ensureMsgf(
+              SubscriptionIndices.Contains(Token),
+              TEXT(
+                  "UIsdkWorldSubsystem::%s: Attempted to unregister an EventHandler that is not registered."),
+              Name))
+      {
+        PendingCreate.Remove(Token);
+        PendingDelete.AddUnique(Token);
+      }
+    }
+  }
+
+  void ProcessPendingDeletes()
+  {
+    if (PendingDelete.IsEmpty())
+    {
+      return;
+    }
+
+    for (const FToken Token : PendingDelete)
+    {
+      Subscriptions[SubscriptionIndices.FindAndRemoveChecked(Token)].Queue.Reset();
+    }
+    PendingDelete.Reset();
+
+    // Compact in place, keeping the registration order, and re-index what moved
+    Subscriptions.RemoveAll([](const FSubscription& Subscription)
+                            { return !Subscription.Queue.IsValid(); });
+    for (int32 Index = 0; Index < Subscriptions.Num(); ++Index)
+    {
+      SubscriptionIndices.FindChecked(Subscriptions[Index].Token) = Index;
+    }
+  }
+
+  void Reset()
+  {
+    PendingCreate.Empty();
+    ProcessPendingDeletes();
+
+    checkf(
+        Subscriptions.Num() == 0,
+        TEXT(
+            "UIsdkWorldSubsystem::%s: %d remaining, At least one ISDK object failed to call UnregisterPointerEventHandler"),
+        Name,
+        Subscriptions.Num());
+
+    Subscriptions.Empty();
+    SubscriptionIndices.Empty();
+  }
+
+  int32 Num() const
+  {
+    return Subscriptions.Num();
+  }
+
+  TQueueImpl& GetQueue(const int32 Index)
+  {
+    return *Subscriptions[Index].Queue;
+  }
+
+ private:
+  struct FSubscription
+  {
+    FToken Token{};
+    QueueUniquePtr Queue{};
+  };
+
+  TArray<FSubscription> Subscriptions{};
+  TMap<FToken, int32> SubscriptionIndices{};
+  TArray<FToken> PendingCreate{};
+  TArray<FToken> PendingDelete{};
+  FToken NextToken{1};
+  const TCHAR* Name{};
+};
+
+/**
+ * Subscriptions of one event queue type, plus the contiguous array their native events are drained
+ * into. Draining records which slice of the array belongs to which subscription, dispatching then
+ * walks that table and hands each subscription its slice in one call.
+ */
+template <class TQueueImpl>
+class TIsdkEventChannel : public TIsdkEventSubscriptions<TQueueImpl>
+{
+  using TBase = TIsdkEventSubscriptions<TQueueImpl>;
+
+ public:
+  using FApiEvent = typename TQueueImpl::FApiEvent;
+
+  explicit TIsdkEventChannel(const TCHAR* InName) : TBase(InName) {}
+
+  /** Pops the pending events of every subscription. Returns the number of events drained. */
+  int32 DrainEvents()
+  {
+    Events.Reset();
+    DispatchTable.Reset();
+
+    for (int32 Index = 0; Index < TBase::Num(); ++Index)
+    {
+      const int32 FirstEvent = Events.Num();
+      const int32 NumEvents = TBase::GetQueue(Index).DrainEvents(Events);
+      if (NumEvents > 0)
+      {
+        DispatchTable.Add({Index, FirstEvent, NumEvents});
+      }
+    }
+    return Events.Num();
+  }
+
+  /**
+   * Forwards the drained events to their subscriptions. Handlers may register and unregister
+   * subscriptions meanwhile: new ones are appended and removals are deferred, so the recorded
+   * indices stay valid.
+   */
+  void DispatchEvents()
+  {
+    for (const FDispatchRange& Range : DispatchTable)
+    {
+      TBase::GetQueue(Range.Subscription)
+          .DispatchEvents(MakeArrayView(Events.GetData() + Range.FirstEvent, Range.NumEvents));
+    }
+  }
+
+  int32 NumDrainedEvents() const
+  {
+    return Events.Num();
+  }
+
+ private:
+  struct FDispatchRange
+  {
+    int32 Subscription{};
+    int32 FirstEvent{};
+    int32 NumEvents{};
+  };
+
+  TArray<FApiEvent> Events{};
+  TArray<FDispatchRange> DispatchTable{};
+};
+
+/**
+ * All event subscriptions of a world. The subsystem drives it once per frame: updates run first,
+ * then the event queues of every type are drained before any handler is invoked. Events raised by
+ * a handler are therefore delivered on the next frame.
+ */
+class FIsdkEventBus
+{
+ public:
+  void BeginFrame()
+  {
+    PointerEvents.BeginFrame();
+    InteractableStateEvents.BeginFrame();
+    InteractorStateEvents.BeginFrame();
+    UpdateEvents.BeginFrame();
+  }
+
+  /** Interactors will 'drive' inside the IUpdate event */
+  void RunUpdates()
+  {
+    for (int32 Index = 0; Index < UpdateEvents.Num(); ++Index)
+    {
+      UpdateEvents.GetQueue(Index).TryHandleEvents();
+    }
+  }
+
+  void DrainAndDispatchEvents()
+  {
+    PointerEvents.DrainEvents();
+    InteractableStateEvents.DrainEvents();
+    InteractorStateEvents.DrainEvents();
+
+    PointerEvents.DispatchEvents();
+    InteractableStateEvents.DispatchEvents();
+    InteractorStateEvents.DispatchEvents();
+  }
+
+  void Reset()
+  {
+    PointerEvents.Reset();
+    InteractableStateEvents.Reset();
+    InteractorStateEvents.Reset();
+    UpdateEvents.Reset();
+  }
+
+  TIsdkEventChannel<FPointerEventQueueImpl> PointerEvents{TEXT("PointerEventSubscriptions")};
+  TIsdkEventChannel<FInteractableStateEventQueueImpl> InteractableStateEvents{
+      TEXT("InteractableStateEventSubscriptions")};
+  TIsdkEventChannel<FInteractorStateEventQueueImpl> InteractorStateEvents{
+      TEXT("InteractorStateEventSubscriptions")};
+  TIsdkEventSubscriptions<FUpdateEventQueueImpl> UpdateEvents{TEXT("UpdateEventSubscriptions")};
+};
+} // namespace isdk::api::helper
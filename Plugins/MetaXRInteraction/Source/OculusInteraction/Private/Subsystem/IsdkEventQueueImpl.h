@@ -27,21 +27,41 @@
 #include "Interaction/IsdkInteractableComponent.h"
 #include "Interaction/IsdkInteractorComponent.h"
 #include "OculusInteractionLog.h"
+#include "Subsystem/IsdkWorldSubsystem.h"
 
 namespace isdk::api::helper
 {
-inline auto CreatePointerEventConverter(
-    UIsdkInteractableComponent* SrcInteractable,
-    std::function<UIsdkInteractorComponent*(const isdk_IPayload*)>&& PayloadLookup)
+/**
+ * Converts the native pointer events of one interactable. The interactor is resolved from the
+ * event payload through the subsystem that registered it, if there is one.
+ */
+struct FPointerEventConverter
 {
-  return [WeakInteractable = TWeakObjectPtr<UIsdkInteractableComponent>(SrcInteractable),
-          PayloadLookup](const isdk_PointerEvent& ApiEvent)
+  TWeakObjectPtr<UIsdkInteractableComponent> Interactable;
+  TWeakObjectPtr<UIsdkWorldSubsystem> PayloadSource;
+
+  void Broadcast(
+      TConstArrayView<isdk_PointerEvent> ApiEvents,
+      const FIsdkInteractionPointerEventDelegate& Delegate) const
   {
-    auto PointerEvent =
-        FIsdkInteractionPointerEvent::CreateFromPointerEvent(ApiEvent, WeakInteractable.Get());
-    PointerEvent.Interactor = PayloadLookup(ApiEvent.payload);
-    return PointerEvent;
-  };
+    for (const isdk_PointerEvent& ApiEvent : ApiEvents)
+    {
+      // Both are resolved per event, a listener may destroy either of them
+      auto PointerEvent =
+          FIsdkInteractionPointerEvent::CreateFromPointerEvent(ApiEvent, Interactable.Get());
+      UIsdkWorldSubsystem* Subsystem = PayloadSource.Get();
+      PointerEvent.Interactor =
+          Subsystem ? Subsystem->LookupInteractorFromPayload(ApiEvent.payload) : nullptr;
+      Delegate.Broadcast(PointerEvent);
+    }
+  }
+};
+
+inline FPointerEventConverter CreatePointerEventConverter(
+    UIsdkInteractableComponent* SrcInteractable,
+    UIsdkWorldSubsystem* PayloadSource)
+{
+  return FPointerEventConverter{SrcInteractable, PayloadSource};
 }
 
 class IEventQueueWrapper
@@ -54,7 +74,7 @@ class IEventQueueWrapper
 
 template <
     typename TForwardingDelegate,
-    typename TForwardingDelegateArg0,
+    typename TEventConverter,
     typename TTargetApiType,
     typename TTargetApiHandleType,
     typename TQueueApiType,
@@ -66,12 +86,12 @@ class FEventQueueApiImpl : public FApiImpl<TQueueApiType, TQueueApiTypePtr>,
   using TBase = FApiImpl<TQueueApiType, TQueueApiTypePtr>;
 
  public:
-  using CreateEventFn = std::function<TForwardingDelegateArg0(const TQueueApiEventType&)>;
+  using FApiEvent = TQueueApiEventType;
 
   FEventQueueApiImpl(
       std::function<TTargetApiType*()> GetTargetFn,
       TTargetApiHandleType* (TTargetApiType::*PGetHandleFun)() const,
-      CreateEventFn&& CreateEvent,
+      TEventConverter&& InEventConverter,
       const TForwardingDelegate& ForwardingDelegate)
       : TBase(
             [this, GetTargetFn, PGetHandleFun]() -> TQueueApiTypePtr
@@ -95,43 +115,65 @@ class FEventQueueApiImpl : public FApiImpl<TQueueApiType, TQueueApiTypePtr>,
               return ApiQueueInstance;
             }),
         ForwardingDelegate(ForwardingDelegate),
-        CreateEvent(CreateEvent)
+        EventConverter(MoveTemp(InEventConverter))
   {
   }
 
   virtual void TryHandleEvents() override
+  {
+    TArray<FApiEvent> ApiEvents;
+    DrainEvents(ApiEvents);
+    DispatchEvents(ApiEvents);
+  }
+
+  /**
+   * Pops every pending native event and appends it to OutEvents. The queue is cleared instead if
+   * nobody listens. Returns the number of events appended.
+   */
+  int32 DrainEvents(TArray<FApiEvent>& OutEvents)
   {
     const auto EventQueue = static_cast<TBase*>(this)->GetOrCreateInstance();
     if (!EventQueue)
     {
-      return;
+      return 0;
     }
 
-    // Handle the events
-    if (ForwardingDelegate.IsBound())
+    const int32 EventCount = static_cast<int32>(EventQueue->getCount());
+    if (EventCount == 0)
     {
-      // Process each pointer event
-      while (!EventQueue->isEmpty())
-      {
-        const TQueueApiEventType ApiEvent{EventQueue->pop()};
-        // Let 'em know!
-        TForwardingDelegateArg0 Event = CreateEvent(ApiEvent);
-        ForwardingDelegate.Broadcast(Event);
-      }
+      return 0;
     }
-    else
+
+    // If no listeners, just clear out the events
+    if (!ForwardingDelegate.IsBound())
     {
-      // If no listeners, just clear out the pointer events
-      auto EventCount = EventQueue->getCount();
-      if (EventCount > 0)
-      {
-        UE_LOG(
-            LogOculusInteraction,
-            VeryVerbose,
-            TEXT("Ignoring %d events, there are no subscribers"),
-            EventCount);
-        EventQueue->clear();
-      }
+      UE_LOG(
+          LogOculusInteraction,
+          VeryVerbose,
+          TEXT("Ignoring %d events, there are no subscribers"),
+          EventCount);
+      EventQueue->clear();
+      return 0;
+    }
+
+    // OutEvents is shared by every queue of this type and keeps its capacity between frames, so
+    // appending does not reallocate once the event volume has settled
+    int32 NumDrained = 0;
+    while (!EventQueue->isEmpty())
+    {
+      OutEvents.Emplace(EventQueue->pop());
+      ++NumDrained;
+    }
+    return NumDrained;
+  }
+
+  /** Converts drained events and forwards them to the delegate, in order. */
+  void DispatchEvents(TConstArrayView<FApiEvent> ApiEvents) const
+  {
+    if (ApiEvents.Num() > 0)
+    {
+      // Let 'em know!
+      EventConverter.Broadcast(ApiEvents, ForwardingDelegate);
     }
   }
 
@@ -142,12 +184,12 @@ class FEventQueueApiImpl : public FApiImpl<TQueueApiType, TQueueApiTypePtr>,
 
  private:
   const TForwardingDelegate& ForwardingDelegate;
-  CreateEventFn CreateEvent;
+  TEventConverter EventConverter;
 };
 
 class FPointerEventQueueImpl : public FEventQueueApiImpl<
                                    FIsdkInteractionPointerEventDelegate,
-                                   FIsdkInteractionPointerEvent,
+                                   FPointerEventConverter,
                                    IPointable,
                                    isdk_IPointable,
                                    PointerEventQueue,
@@ -158,27 +200,39 @@ class FPointerEventQueueImpl : public FEventQueueApiImpl<
   FPointerEventQueueImpl(
       std::function<IPointable*()> GetTargetFn,
       isdk_IPointable* (IPointable::*PGetHandleFun)() const,
-      CreateEventFn&& CreateEvent,
+      FPointerEventConverter&& EventConverter,
       const FIsdkInteractionPointerEventDelegate& ForwardingDelegate)
-      : FEventQueueApiImpl(GetTargetFn, PGetHandleFun, CopyTemp(CreateEvent), ForwardingDelegate)
+      : FEventQueueApiImpl(GetTargetFn, PGetHandleFun, MoveTemp(EventConverter), ForwardingDelegate)
   {
   }
 };
 
-inline auto CreateInteractorStateEventConverter(UObject* Interactor)
+/** Converts the native state events of one interactor. */
+struct FInteractorStateEventConverter
 {
-  return
-      [WeakInteractor = TWeakObjectPtr(Interactor)](const isdk_InteractorStateChangeArgs& ApiEvent)
+  TWeakObjectPtr<UObject> Interactor;
+
+  void Broadcast(
+      TConstArrayView<isdk_InteractorStateChangeArgs> ApiEvents,
+      const FIsdkInteractorStateChanged& Delegate) const
   {
-    FIsdkInteractorStateEvent Event{WeakInteractor.Get(), {}};
-    StructTypesUtils::Copy(ApiEvent, Event.Args);
-    return Event;
-  };
+    for (const isdk_InteractorStateChangeArgs& ApiEvent : ApiEvents)
+    {
+      FIsdkInteractorStateEvent Event{Interactor.Get(), {}};
+      StructTypesUtils::Copy(ApiEvent, Event.Args);
+      Delegate.Broadcast(Event);
+    }
+  }
+};
+
+inline FInteractorStateEventConverter CreateInteractorStateEventConverter(UObject* Interactor)
+{
+  return FInteractorStateEventConverter{Interactor};
 }
 
 class FInteractorStateEventQueueImpl : public FEventQueueApiImpl<
                                            FIsdkInteractorStateChanged,
-                                           FIsdkInteractorStateEvent,
+                                           FInteractorStateEventConverter,
                                            IInteractor,
                                            isdk_IInteractor,
                                            InteractorStateEventQueue,
@@ -189,10 +243,11 @@ class FInteractorStateEventQueueImpl : public FEventQueueApiImpl<
   FInteractorStateEventQueueImpl(
       std::function<IInteractor*()> GetTargetFn,
       isdk_IInteractor* (IInteractor::*PGetHandleFun)() const,
-      CreateEventFn&& CreateEvent,
+      FInteractorStateEventConverter&& EventConverter,
       const TCHAR* InInteractorTypeHint,
       const FIsdkInteractorStateChanged& ForwardingDelegate)
-      : FEventQueueApiImpl(GetTargetFn, PGetHandleFun, CopyTemp(CreateEvent), ForwardingDelegate),
+      : FEventQueueApiImpl(
+            GetTargetFn, PGetHandleFun, MoveTemp(EventConverter), ForwardingDelegate),
         InteractorTypeHint(InInteractorTypeHint)
   {
   }
@@ -206,20 +261,33 @@ class FInteractorStateEventQueueImpl : public FEventQueueApiImpl<
   FString InteractorTypeHint;
 };
 
-inline auto CreateInteractableStateEventConverter(UObject* Interactable)
+/** Converts the native state events of one interactable. */
+struct FInteractableStateEventConverter
 {
-  return [WeakInteractable =
-              TWeakObjectPtr(Interactable)](const isdk_InteractableStateChangeArgs& ApiEvent)
+  TWeakObjectPtr<UObject> Interactable;
+
+  void Broadcast(
+      TConstArrayView<isdk_InteractableStateChangeArgs> ApiEvents,
+      const FIsdkInteractableStateChanged& Delegate) const
   {
-    FIsdkInteractableStateEvent Event{WeakInteractable.Get(), {}};
-    StructTypesUtils::Copy(ApiEvent, Event.Args);
-    return Event;
-  };
+    for (const isdk_InteractableStateChangeArgs& ApiEvent : ApiEvents)
+    {
+      FIsdkInteractableStateEvent Event{Interactable.Get(), {}};
+      StructTypesUtils::Copy(ApiEvent, Event.Args);
+      Delegate.Broadcast(Event);
+    }
+  }
+};
+
+inline FInteractableStateEventConverter CreateInteractableStateEventConverter(
+    UObject* Interactable)
+{
+  return FInteractableStateEventConverter{Interactable};
 }
 
 class FInteractableStateEventQueueImpl : public FEventQueueApiImpl<
                                              FIsdkInteractableStateChanged,
-                                             FIsdkInteractableStateEvent,
+                                             FInteractableStateEventConverter,
                                              IInteractable,
                                              isdk_IInteractable,
                                              InteractableStateEventQueue,
@@ -230,9 +298,9 @@ class FInteractableStateEventQueueImpl : public FEventQueueApiImpl<
   FInteractableStateEventQueueImpl(
       std::function<IInteractable*()> GetTargetFn,
       isdk_IInteractable* (IInteractable::*PGetHandleFun)() const,
-      CreateEventFn&& CreateEvent,
+      FInteractableStateEventConverter&& EventConverter,
       const FIsdkInteractableStateChanged& ForwardingDelegate)
-      : FEventQueueApiImpl(GetTargetFn, PGetHandleFun, CopyTemp(CreateEvent), ForwardingDelegate)
+      : FEventQueueApiImpl(GetTargetFn, PGetHandleFun, MoveTemp(EventConverter), ForwardingDelegate)
   {
   }
 };
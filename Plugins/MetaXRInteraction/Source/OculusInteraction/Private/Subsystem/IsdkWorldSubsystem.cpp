@@ -20,7 +20,9 @@
 
 #include "Subsystem/IsdkWorldSubsystem.h"
 #include "Interaction/IsdkInteractorComponent.h"
+#include "Interaction/IsdkGrabbableComponent.h"
 
+#include "IsdkEventBus.h"
 #include "IsdkEventQueueImpl.h"
 #include "StructTypesPrivate.h"
 
@@ -40,6 +42,7 @@ UIsdkWorldSubsystem::UIsdkWorldSubsystem()
 {
   IsdkScaledTimeProviderImpl = MakePimpl<isdk::api::FIsdkScaledTimeProviderImpl>(
       [] { return isdk::api::ScaledTimeProvider::create(); });
+  EventBus = MakePimpl<isdk::api::helper::FIsdkEventBus>();
 }
 
 void UIsdkWorldSubsystem::BeginDestroy()
@@ -57,10 +60,7 @@ void UIsdkWorldSubsystem::Deinitialize()
 {
   Super::Deinitialize();
 
-  PointerEventSubscriptions.Reset();
-  InteractableStateEventSubscriptions.Reset();
-  InteractorStateEventSubscriptions.Reset();
-  UpdateEventSubscriptions.Reset();
+  EventBus->Reset();
 }
 
 void UIsdkWorldSubsystem::Tick(float DeltaTime)
@@ -80,22 +80,17 @@ void UIsdkWorldSubsystem::Tick(float DeltaTime)
   }
 
   // [BeginFrame]: Resolve any native object lazy creation. This is important for event subscribers
-  // so that they exist when the events are fired from the UpdateEventSubscriptions step.
-  PointerEventSubscriptions.BeginFrame();
-  InteractableStateEventSubscriptions.BeginFrame();
-  InteractorStateEventSubscriptions.BeginFrame();
-  UpdateEventSubscriptions.BeginFrame();
+  // so that they exist when the events are fired from the update step.
+  EventBus->BeginFrame();
 
   // [BeginFrame]: Prepare the Payload lookup cache, if it is stale.
   UpdateInteractorPayloadLookup();
 
   // [BeginFrame]: Interactors will 'drive' inside the IUpdate event
-  UpdateEventSubscriptions.TryHandleEvents();
+  EventBus->RunUpdates();
 
-  // [PopEvent]: Read output events
-  PointerEventSubscriptions.TryHandleEvents();
-  InteractableStateEventSubscriptions.TryHandleEvents();
-  InteractorStateEventSubscriptions.TryHandleEvents();
+  // [PopEvent]: Read output events, all queues are drained before any handler runs
+  EventBus->DrainAndDispatchEvents();
 
   // [EndFrame]
   if (FrameFinishedEventDelegate.IsBound())
@@ -119,19 +114,17 @@ UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterPointerEvent
     const FIsdkInteractionPointerEventDelegate& PointerEventDelegate,
     UIsdkInteractableComponent* SrcInteractable)
 {
-  auto Lookup = [WkThis = TWeakObjectPtr<UIsdkWorldSubsystem>(this)](const isdk_IPayload* InPayload)
-  { return LookupInteractorFromPayload(WkThis, InPayload); };
   auto EventQueue = MakePimpl<isdk::api::helper::FPointerEventQueueImpl>(
       MoveTemp(InApiPointerEventTargetFn),
       &isdk::api::IPointable::getIPointableHandle,
-      isdk::api::helper::CreatePointerEventConverter(SrcInteractable, MoveTemp(Lookup)),
+      isdk::api::helper::CreatePointerEventConverter(SrcInteractable, this),
       PointerEventDelegate);
-  return PointerEventSubscriptions.RegisterEventHandler(MoveTemp(EventQueue));
+  return EventBus->PointerEvents.RegisterEventHandler(MoveTemp(EventQueue));
 }
 
 void UIsdkWorldSubsystem::UnregisterPointerEventHandler(EventHandlerToken Token)
 {
-  PointerEventSubscriptions.UnregisterEventHandler(Token);
+  EventBus->PointerEvents.UnregisterEventHandler(Token);
 }
 
 void UIsdkWorldSubsystem::RegisterInteractorPayload(UIsdkInteractorComponent* InInteractor)
@@ -224,6 +217,64 @@ void UIsdkWorldSubsystem::UnregisterInteractable(UIsdkInteractableComponent* InI
   RegisteredInteractables.Remove(InInteractable);
 }
 
+void UIsdkWorldSubsystem::RegisterGrabbable(UIsdkGrabbableComponent* InGrabbable)
+{
+  if (!ensureMsgf(
+          IsValid(InGrabbable) && IsValid(InGrabbable->GetOwner()),
+          TEXT("UIsdkWorldSubsystem::RegisterGrabbable - InGrabbable '%s' is null or has no owner"),
+          *GetFullNameSafe(InGrabbable)))
+  {
+    return;
+  }
+
+  // Like GetComponentByClass, the first grabbable of an actor is the one overlaps resolve to
+  TWeakObjectPtr<UIsdkGrabbableComponent>& Registered =
+      RegisteredGrabbablesLookup.FindOrAdd(InGrabbable->GetOwner());
+  if (!Registered.IsValid())
+  {
+    Registered = InGrabbable;
+  }
+}
+
+void UIsdkWorldSubsystem::UnregisterGrabbable(UIsdkGrabbableComponent* InGrabbable)
+{
+  if (!IsValid(InGrabbable))
+  {
+    return;
+  }
+
+  const AActor* Owner = InGrabbable->GetOwner();
+  const auto FoundGrabbable = RegisteredGrabbablesLookup.Find(Owner);
+  if (!FoundGrabbable || FoundGrabbable->Get() != InGrabbable)
+  {
+    return;
+  }
+
+  // Hand the actor over to its next registered grabbable, if it has one
+  UIsdkGrabbableComponent* NextGrabbable = nullptr;
+  if (IsValid(Owner))
+  {
+    Owner->ForEachComponent<UIsdkGrabbableComponent>(
+        false,
+        [InGrabbable, &NextGrabbable](UIsdkGrabbableComponent* Grabbable)
+        {
+          if (!NextGrabbable && Grabbable != InGrabbable && Grabbable->IsRegistered())
+          {
+            NextGrabbable = Grabbable;
+          }
+        });
+  }
+
+  if (NextGrabbable)
+  {
+    *FoundGrabbable = NextGrabbable;
+  }
+  else
+  {
+    RegisteredGrabbablesLookup.Remove(Owner);
+  }
+}
+
 UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterInteractableStateEventHandler(
     UObject* Interactor,
     ApiInteractableEventTargetFn&& InApiInteractableStateEventTargetFn,
@@ -241,12 +292,12 @@ UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterInteractable
       &isdk::api::IInteractable::getIInteractableHandle,
       isdk::api::helper::CreateInteractableStateEventConverter(Interactor),
       InteractableStateEventDelegate);
-  return InteractableStateEventSubscriptions.RegisterEventHandler(MoveTemp(EventQueue));
+  return EventBus->InteractableStateEvents.RegisterEventHandler(MoveTemp(EventQueue));
 }
 
 void UIsdkWorldSubsystem::UnregisterInteractableStateEventHandler(EventHandlerToken Token)
 {
-  InteractableStateEventSubscriptions.UnregisterEventHandler(Token);
+  EventBus->InteractableStateEvents.UnregisterEventHandler(Token);
 }
 
 UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterInteractorStateEventHandler(
@@ -268,12 +319,12 @@ UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterInteractorSt
       isdk::api::helper::CreateInteractorStateEventConverter(Interactor),
       InteractorTypeHint,
       InteractorStateEventDelegate);
-  return InteractorStateEventSubscriptions.RegisterEventHandler(MoveTemp(EventQueue));
+  return EventBus->InteractorStateEvents.RegisterEventHandler(MoveTemp(EventQueue));
 }
 
 void UIsdkWorldSubsystem::UnregisterInteractorStateEventHandler(EventHandlerToken Token)
 {
-  InteractorStateEventSubscriptions.UnregisterEventHandler(Token);
+  EventBus->InteractorStateEvents.UnregisterEventHandler(Token);
 }
 
 UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterUpdateEventHandler(
@@ -282,12 +333,12 @@ UIsdkWorldSubsystem::EventHandlerToken UIsdkWorldSubsystem::RegisterUpdateEventH
 {
   auto EventQueue = MakePimpl<isdk::api::helper::FUpdateEventQueueImpl>(
       MoveTemp(InApiUpdateEventTargetFn), UpdateEventDelegate);
-  return UpdateEventSubscriptions.RegisterEventHandler(MoveTemp(EventQueue));
+  return EventBus->UpdateEvents.RegisterEventHandler(MoveTemp(EventQueue));
 }
 
 void UIsdkWorldSubsystem::UnregisterUpdateEventHandler(EventHandlerToken Token)
 {
-  UpdateEventSubscriptions.UnregisterEventHandler(Token);
+  EventBus->UpdateEvents.UnregisterEventHandler(Token);
 }
 
 void UIsdkWorldSubsystem::UpdateInteractorPayloadLookup()
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Misc/AutomationTest.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Interaction/IsdkGrabbableComponent.h"
+#include "Interaction/IsdkGrabberComponent.h"
+#include "Subsystem/IsdkWorldSubsystem.h"
+
+/**
+ * Grabbers and grabbables in a world that never ticks. Overlap events are broadcast by hand, so
+ * no physics scene is involved.
+ */
+struct FIsdkGrabberTestScene
+{
+  UWorld* World = nullptr;
+  TArray<UIsdkGrabbableComponent*> Grabbables;
+  TArray<USphereComponent*> GrabColliders;
+  TArray<USphereComponent*> OtherColliders;
+  TArray<UIsdkGrabberComponent*> Grabbers;
+  TArray<USphereComponent*> PinchColliders;
+
+  bool SetUp(const int32 NumGrabbables, const int32 NumGrabbers, const int32 NumOthers)
+  {
+    World = UWorld::CreateWorld(EWorldType::Game, false);
+    UIsdkWorldSubsystem* WorldSubsystem = UIsdkWorldSubsystem::TryGet(World);
+    if (!IsValid(WorldSubsystem))
+    {
+      return false;
+    }
+
+    FRandomStream Random(1234);
+    for (int32 Index = 0; Index < NumGrabbables; ++Index)
+    {
+      AActor* Actor = World->SpawnActor<AActor>();
+      USphereComponent* Collider = NewObject<USphereComponent>(Actor);
+      Actor->SetRootComponent(Collider);
+      Collider->SetWorldLocation(Random.GetUnitVector() * Random.FRandRange(0.0f, 50.0f));
+
+      UIsdkGrabbableComponent* Grabbable = NewObject<UIsdkGrabbableComponent>(Actor);
+      Grabbable->SetGrabCollider(Collider);
+      WorldSubsystem->RegisterGrabbable(Grabbable);
+
+      Grabbables.Add(Grabbable);
+      GrabColliders.Add(Collider);
+    }
+
+    // Scenery without a grabbable, which every hand overlaps as well
+    for (int32 Index = 0; Index < NumOthers; ++Index)
+    {
+      AActor* Actor = World->SpawnActor<AActor>();
+      USphereComponent* Collider = NewObject<USphereComponent>(Actor);
+      Actor->SetRootComponent(Collider);
+      OtherColliders.Add(Collider);
+    }
+
+    for (int32 Index = 0; Index < NumGrabbers; ++Index)
+    {
+      AActor* Actor = World->SpawnActor<AActor>();
+      USphereComponent* Collider = NewObject<USphereComponent>(Actor);
+      Actor->SetRootComponent(Collider);
+      Collider->SetWorldLocation(Random.GetUnitVector() * Random.FRandRange(0.0f, 50.0f));
+
+      UIsdkGrabberComponent* Grabber = NewObject<UIsdkGrabberComponent>(Actor);
+      Grabber->AddCollider(Collider, EIsdkGrabColliderType::Pinch);
+
+      Grabbers.Add(Grabber);
+      PinchColliders.Add(Collider);
+    }
+    return true;
+  }
+
+  void TearDown()
+  {
+    if (World)
+    {
+      World->DestroyWorld(false);
+      World->MarkAsGarbage();
+      World = nullptr;
+    }
+  }
+
+  void BeginOverlap(const int32 Grabber, USphereComponent* Other) const
+  {
+    PinchColliders[Grabber]->OnComponentBeginOverlap.Broadcast(
+        PinchColliders[Grabber], Other->GetOwner(), Other, 0, false, FHitResult());
+  }
+
+  void EndOverlap(const int32 Grabber, USphereComponent* Other) const
+  {
+    PinchColliders[Grabber]->OnComponentEndOverlap.Broadcast(
+        PinchColliders[Grabber], Other->GetOwner(), Other, 0);
+  }
+
+  UIsdkGrabbableComponent* GetBestGrabbable(const int32 Grabber) const
+  {
+    UPrimitiveComponent* MyCollider;
+    UPrimitiveComponent* GrabbableCollider;
+    UIsdkGrabbableComponent* Grabbable;
+    Grabbers[Grabber]->ComputeBestGrabbableColliderForGrabType(
+        EIsdkGrabColliderType::Pinch, MyCollider, GrabbableCollider, Grabbable);
+    return Grabbable;
+  }
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkGrabberCandidatesTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkGrabberTest.Candidates",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkGrabberCandidatesTest::RunTest(const FString& Parameters)
+{
+  constexpr int32 NumGrabbables = 200;
+  constexpr int32 NumGrabbers = 2;
+  constexpr int32 NumSteps = 2000;
+
+  FIsdkGrabberTestScene Scene;
+  if (!TestTrue(
+          TEXT("Created a world with an ISDK subsystem"),
+          Scene.SetUp(NumGrabbables, NumGrabbers, 1)))
+  {
+    Scene.TearDown();
+    return false;
+  }
+
+  // Overlaps with something that isn't a grabbable are ignored
+  Scene.BeginOverlap(0, Scene.OtherColliders[0]);
+  bool bPassed = TestEqual(
+      TEXT("Overlapping scenery hovers nothing"),
+      Scene.Grabbers[0]->GetInteractorStateRelationshipCounts().NumHover,
+      0);
+
+  // Begin and end overlaps at random, and compare against a brute force search each step
+  FRandomStream Random(42);
+  TArray<TSet<int32>> Overlapped;
+  Overlapped.SetNum(NumGrabbers);
+  for (int32 Step = 0; bPassed && Step < NumSteps; ++Step)
+  {
+    const int32 Grabber = Random.RandHelper(NumGrabbers);
+    const int32 Grabbable = Random.RandHelper(NumGrabbables);
+    if (Overlapped[Grabber].Remove(Grabbable) > 0)
+    {
+      Scene.EndOverlap(Grabber, Scene.GrabColliders[Grabbable]);
+    }
+    else
+    {
+      Overlapped[Grabber].Add(Grabbable);
+      Scene.BeginOverlap(Grabber, Scene.GrabColliders[Grabbable]);
+    }
+
+    const FVector GrabberLocation = Scene.PinchColliders[Grabber]->GetComponentLocation();
+    UIsdkGrabbableComponent* Expected = nullptr;
+    double ExpectedDistance = TNumericLimits<double>::Max();
+    for (const int32 Candidate : Overlapped[Grabber])
+    {
+      const double Distance = FVector::DistSquared(
+          GrabberLocation, Scene.GrabColliders[Candidate]->GetComponentLocation());
+      if (Distance < ExpectedDistance)
+      {
+        ExpectedDistance = Distance;
+        Expected = Scene.Grabbables[Candidate];
+      }
+    }
+
+    bPassed = TestEqual(
+                  TEXT("Best candidate is the nearest hovered grabbable"),
+                  Scene.GetBestGrabbable(Grabber),
+                  Expected) &&
+        TestEqual(
+                  TEXT("Hover count follows the overlaps"),
+                  Scene.Grabbers[Grabber]->GetInteractorStateRelationshipCounts().NumHover,
+                  Overlapped[Grabber].Num());
+  }
+
+  // Selecting keeps the grabbed component among the overlapped grabbables
+  if (bPassed && Overlapped[0].Num() > 0)
+  {
+    Scene.Grabbers[0]->SelectByGrabType(EIsdkGrabColliderType::Pinch);
+    const FIsdkInteractionRelationshipCounts Counts =
+        Scene.Grabbers[0]->GetInteractorStateRelationshipCounts();
+    bPassed = TestEqual(TEXT("Selected count"), Counts.NumSelect, 1) &&
+        TestEqual(
+               TEXT("Hover count while selecting"), Counts.NumHover, Overlapped[0].Num() - 1);
+    Scene.Grabbers[0]->UnselectByGrabType(EIsdkGrabColliderType::Pinch);
+  }
+
+  Scene.TearDown();
+  return bPassed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkGrabberBenchmarkTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkGrabberTest.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkGrabberBenchmarkTest::RunTest(const FString& Parameters)
+{
+  // Two hands with a set of grabbers each, sweeping through a shelf of grabbables
+  constexpr int32 NumHands = 2;
+  constexpr int32 GrabbersPerHand = 8;
+  constexpr int32 NumGrabbables = 1000;
+  constexpr int32 NumOthers = 20;
+  constexpr int32 OverlapsPerGrabber = 30;
+  constexpr int32 NumFrames = 100;
+
+  FIsdkGrabberTestScene Scene;
+  if (!TestTrue(
+          TEXT("Created a world with an ISDK subsystem"),
+          Scene.SetUp(NumGrabbables, NumHands * GrabbersPerHand, NumOthers)))
+  {
+    Scene.TearDown();
+    return false;
+  }
+
+  uint64 FrameCycles = 0;
+  for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+  {
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    for (int32 Grabber = 0; Grabber < Scene.Grabbers.Num(); ++Grabber)
+    {
+      const int32 FirstGrabbable =
+          (Frame * 7 + Grabber * 31) % (NumGrabbables - OverlapsPerGrabber);
+      for (USphereComponent* Other : Scene.OtherColliders)
+      {
+        Scene.BeginOverlap(Grabber, Other);
+      }
+      for (int32 Index = 0; Index < OverlapsPerGrabber; ++Index)
+      {
+        Scene.BeginOverlap(Grabber, Scene.GrabColliders[FirstGrabbable + Index]);
+      }
+
+      Scene.Grabbers[Grabber]->SelectByGrabType(EIsdkGrabColliderType::Pinch);
+      Scene.Grabbers[Grabber]->UnselectByGrabType(EIsdkGrabColliderType::Pinch);
+
+      for (int32 Index = 0; Index < OverlapsPerGrabber; ++Index)
+      {
+        Scene.EndOverlap(Grabber, Scene.GrabColliders[FirstGrabbable + Index]);
+      }
+      for (USphereComponent* Other : Scene.OtherColliders)
+      {
+        Scene.EndOverlap(Grabber, Other);
+      }
+    }
+    FrameCycles += FPlatformTime::Cycles64() - StartCycles;
+  }
+
+  AddInfo(FString::Printf(
+      TEXT("%.2f us per frame: %d grabbers, %d grabbables, %d overlaps per grabber"),
+      FPlatformTime::ToMilliseconds64(FrameCycles) * 1000.0 / NumFrames,
+      Scene.Grabbers.Num(),
+      NumGrabbables,
+      OverlapsPerGrabber + NumOthers));
+
+  bool bPassed = true;
+  for (const UIsdkGrabberComponent* Grabber : Scene.Grabbers)
+  {
+    bPassed &= TestEqual(
+        TEXT("Every overlap ended"), Grabber->GetInteractorStateRelationshipCounts().NumHover, 0);
+  }
+
+  Scene.TearDown();
+  return bPassed;
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Misc/AutomationTest.h"
+#include "IsdkHandMeshComponent.h"
+#include "Utilities/IsdkSkeletonPoseBatch.h"
+
+/**
+ * A synthetic hand skeleton laid out like the XRHand meshes: a root, the wrist, and the palm and
+ * every finger chain below the wrist. Joints are mapped in EIsdkHandBones order, so the palm is
+ * written before its parent wrist, like on a real hand mesh.
+ */
+struct FIsdkHandMeshPoseTestSkeleton
+{
+  TArray<int32> ParentIndices;
+  TArray<FTransform> RefPose;
+  TArray<int32> JointBoneIndices;
+
+  static FTransform MakeRandomTransform(FRandomStream& Random)
+  {
+    const FRotator Rotation(
+        Random.FRandRange(-180.0, 180.0),
+        Random.FRandRange(-180.0, 180.0),
+        Random.FRandRange(-180.0, 180.0));
+    return FTransform(
+        Rotation,
+        Random.GetUnitVector() * Random.FRandRange(1.0, 10.0),
+        FVector(Random.FRandRange(0.5, 1.5)));
+  }
+
+  void SetUp(FRandomStream& Random)
+  {
+    constexpr int32 RootBone = 0;
+    constexpr int32 WristBone = 1;
+    constexpr int32 PalmBone = 2;
+    ParentIndices = {INDEX_NONE, RootBone, WristBone};
+
+    // Thumb has 4 joints, the other fingers 5
+    const int32 FingerJointCounts[] = {4, 5, 5, 5, 5};
+    for (const int32 FingerJointCount : FingerJointCounts)
+    {
+      ParentIndices.Add(WristBone);
+      for (int32 Joint = 1; Joint < FingerJointCount; ++Joint)
+      {
+        ParentIndices.Add(ParentIndices.Num() - 1);
+      }
+    }
+
+    RefPose.Reset();
+    for (int32 BoneIndex = 0; BoneIndex < ParentIndices.Num(); ++BoneIndex)
+    {
+      RefPose.Add(MakeRandomTransform(Random));
+    }
+
+    JointBoneIndices = {PalmBone, WristBone};
+    for (int32 BoneIndex = PalmBone + 1; BoneIndex < ParentIndices.Num(); ++BoneIndex)
+    {
+      JointBoneIndices.Add(BoneIndex);
+    }
+    check(JointBoneIndices.Num() == UIsdkHandData::GetNumJoints());
+  }
+
+  TArray<FTransform> MakeRandomJointPoses(FRandomStream& Random) const
+  {
+    TArray<FTransform> Poses;
+    for (int32 Joint = 0; Joint < JointBoneIndices.Num(); ++Joint)
+    {
+      Poses.Add(MakeRandomTransform(Random));
+    }
+    return Poses;
+  }
+
+  // The component space transform of a bone computed from the whole local space pose, like the
+  // FA2CSPose built by every UPoseableMeshComponent::GetBoneTransformByName call
+  FTransform ComputeComponentSpace(const TArray<FTransform>& BoneSpaceTransforms, int32 BoneIndex)
+      const
+  {
+    TArray<FTransform> ComponentSpaceTransforms = BoneSpaceTransforms;
+    for (int32 Index = 0; Index <= BoneIndex; ++Index)
+    {
+      if (ParentIndices[Index] != INDEX_NONE)
+      {
+        ComponentSpaceTransforms[Index] =
+            BoneSpaceTransforms[Index] * ComponentSpaceTransforms[ParentIndices[Index]];
+        ComponentSpaceTransforms[Index].NormalizeRotation();
+      }
+    }
+    return ComponentSpaceTransforms[BoneIndex];
+  }
+
+  // The previous skeleton update: a component space get and set for every joint
+  void ApplyJointPosesByBone(
+      TArray<FTransform>& BoneSpaceTransforms,
+      const TArray<FTransform>& SourcePoses,
+      const TArray<FTransform>* OverridePoses,
+      float OverrideAlpha) const
+  {
+    for (int32 Joint = 0; Joint < JointBoneIndices.Num(); ++Joint)
+    {
+      const int32 BoneIndex = JointBoneIndices[Joint];
+      FTransform BoneTransform = ComputeComponentSpace(BoneSpaceTransforms, BoneIndex);
+      if (OverridePoses)
+      {
+        const FTransform& OverridePose = (*OverridePoses)[Joint];
+        BoneTransform.SetLocation(FMath::Lerp(
+            SourcePoses[Joint].GetLocation(), OverridePose.GetLocation(), OverrideAlpha));
+        BoneTransform.SetRotation(FQuat::Slerp(
+            SourcePoses[Joint].GetRotation(), OverridePose.GetRotation(), OverrideAlpha));
+      }
+      else
+      {
+        BoneTransform.SetLocation(SourcePoses[Joint].GetLocation());
+        BoneTransform.SetRotation(SourcePoses[Joint].GetRotation());
+      }
+
+      BoneSpaceTransforms[BoneIndex] = BoneTransform;
+      if (ParentIndices[BoneIndex] != INDEX_NONE)
+      {
+        BoneSpaceTransforms[BoneIndex].SetToRelativeTransform(
+            ComputeComponentSpace(BoneSpaceTransforms, ParentIndices[BoneIndex]));
+      }
+    }
+  }
+
+  void ApplyJointPosesBatched(
+      FIsdkSkeletonPoseBatch& Batch,
+      TArray<FTransform>& BoneSpaceTransforms,
+      const TArray<FTransform>& SourcePoses,
+      const TArray<FTransform>* OverridePoses,
+      float OverrideAlpha) const
+  {
+    Batch.Begin(BoneSpaceTransforms);
+    UIsdkHandMeshComponent::ApplyJointPoses(
+        Batch,
+        JointBoneIndices,
+        SourcePoses,
+        OverridePoses ? TConstArrayView<FTransform>(*OverridePoses) : TConstArrayView<FTransform>(),
+        OverrideAlpha);
+    Batch.End();
+  }
+};
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkHandMeshPoseTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkHandMeshPoseTest.ApplyJointPoses",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkHandMeshPoseTest::RunTest(const FString& Parameters)
+{
+  FRandomStream Random(1234);
+  FIsdkHandMeshPoseTestSkeleton Skeleton;
+  Skeleton.SetUp(Random);
+
+  FIsdkSkeletonPoseBatch Batch;
+  Batch.Initialize(Skeleton.ParentIndices);
+
+  const auto TestSamePose = [this](
+                                const TCHAR* What,
+                                const TArray<FTransform>& Expected,
+                                const TArray<FTransform>& Actual)
+  {
+    for (int32 BoneIndex = 0; BoneIndex < Expected.Num(); ++BoneIndex)
+    {
+      TestTrue(
+          FString::Printf(TEXT("%s: bone %d"), What, BoneIndex),
+          Actual[BoneIndex].Equals(Expected[BoneIndex], UE_KINDA_SMALL_NUMBER));
+    }
+  };
+
+  // Several frames in a row, so later frames start from a pose the update wrote itself
+  TArray<FTransform> Expected = Skeleton.RefPose;
+  TArray<FTransform> Actual = Skeleton.RefPose;
+  for (int32 Frame = 0; Frame < 3; ++Frame)
+  {
+    const TArray<FTransform> SourcePoses = Skeleton.MakeRandomJointPoses(Random);
+    Skeleton.ApplyJointPosesByBone(Expected, SourcePoses, nullptr, 0.0f);
+    Skeleton.ApplyJointPosesBatched(Batch, Actual, SourcePoses, nullptr, 0.0f);
+    TestSamePose(TEXT("Source pose"), Expected, Actual);
+  }
+
+  // Blending towards an override
+  {
+    const TArray<FTransform> SourcePoses = Skeleton.MakeRandomJointPoses(Random);
+    const TArray<FTransform> OverridePoses = Skeleton.MakeRandomJointPoses(Random);
+    Skeleton.ApplyJointPosesByBone(Expected, SourcePoses, &OverridePoses, 0.3f);
+    Skeleton.ApplyJointPosesBatched(Batch, Actual, SourcePoses, &OverridePoses, 0.3f);
+    TestSamePose(TEXT("Blended pose"), Expected, Actual);
+
+    // A full blend ends on the override
+    TArray<FTransform> FullyBlended = Actual;
+    TArray<FTransform> Overridden = Actual;
+    Skeleton.ApplyJointPosesBatched(Batch, FullyBlended, SourcePoses, &OverridePoses, 1.0f);
+    Skeleton.ApplyJointPosesBatched(Batch, Overridden, OverridePoses, nullptr, 0.0f);
+    TestSamePose(TEXT("Fully blended pose"), Overridden, FullyBlended);
+  }
+
+  // Every joint ends up at its pose in component space, keeping the scale of its bone
+  {
+    const TArray<FTransform> SourcePoses = Skeleton.MakeRandomJointPoses(Random);
+    Skeleton.ApplyJointPosesBatched(Batch, Actual, SourcePoses, nullptr, 0.0f);
+
+    // The palm is set before the wrist moved, so it is only expected to follow the wrist
+    for (int32 Joint = 1; Joint < Skeleton.JointBoneIndices.Num(); ++Joint)
+    {
+      const FTransform ComponentSpace =
+          Skeleton.ComputeComponentSpace(Actual, Skeleton.JointBoneIndices[Joint]);
+      TestTrue(
+          FString::Printf(TEXT("Joint %d location"), Joint),
+          ComponentSpace.GetLocation().Equals(SourcePoses[Joint].GetLocation(), 1e-3));
+      TestTrue(
+          FString::Printf(TEXT("Joint %d rotation"), Joint),
+          ComponentSpace.GetRotation().Equals(SourcePoses[Joint].GetRotation(), 1e-4));
+    }
+  }
+
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkHandMeshPoseBenchmarkTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkHandMeshPoseTest.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkHandMeshPoseBenchmarkTest::RunTest(const FString& Parameters)
+{
+  constexpr int32 NumUpdates = 10000;
+
+  FRandomStream Random(1234);
+  FIsdkHandMeshPoseTestSkeleton Skeleton;
+  Skeleton.SetUp(Random);
+
+  FIsdkSkeletonPoseBatch Batch;
+  Batch.Initialize(Skeleton.ParentIndices);
+
+  const TArray<FTransform> SourcePoses = Skeleton.MakeRandomJointPoses(Random);
+  const TArray<FTransform> OverridePoses = Skeleton.MakeRandomJointPoses(Random);
+
+  TArray<FTransform> ByBonePose = Skeleton.RefPose;
+  uint64 StartCycles = FPlatformTime::Cycles64();
+  for (int32 Update = 0; Update < NumUpdates; ++Update)
+  {
+    Skeleton.ApplyJointPosesByBone(ByBonePose, SourcePoses, &OverridePoses, 0.5f);
+  }
+  const uint64 ByBoneCycles = FPlatformTime::Cycles64() - StartCycles;
+
+  TArray<FTransform> BatchedPose = Skeleton.RefPose;
+  StartCycles = FPlatformTime::Cycles64();
+  for (int32 Update = 0; Update < NumUpdates; ++Update)
+  {
+    Skeleton.ApplyJointPosesBatched(Batch, BatchedPose, SourcePoses, &OverridePoses, 0.5f);
+  }
+  const uint64 BatchedCycles = FPlatformTime::Cycles64() - StartCycles;
+
+  AddInfo(FString::Printf(
+      TEXT("Hand skeleton update (%d bones): by bone %.3f us, batched %.3f us per hand"),
+      Skeleton.ParentIndices.Num(),
+      FPlatformTime::ToMilliseconds64(ByBoneCycles) * 1000.0 / NumUpdates,
+      FPlatformTime::ToMilliseconds64(BatchedCycles) * 1000.0 / NumUpdates));
+
+  // The benchmark doubles as a check that many updates in a row stay equivalent
+  for (int32 BoneIndex = 0; BoneIndex < BatchedPose.Num(); ++BoneIndex)
+  {
+    TestTrue(
+        FString::Printf(TEXT("Bone %d"), BoneIndex),
+        BatchedPose[BoneIndex].Equals(ByBonePose[BoneIndex], UE_KINDA_SMALL_NUMBER));
+  }
+
+  return true;
+}
@@ -103,6 +103,9 @@ class OCULUSINTERACTION_API UIsdkTestRayFixture : public UObject
   FIsdkInteractableStateChanged InteractableStateChanged;
   FIsdkInteractionPointerEventDelegate InteractablePointed;
 
+  // Invoked after every handled pointer event, lets a test act from inside a dispatch
+  TFunction<void(const FIsdkInteractionPointerEvent&)> OnPointerEvent;
+
  private:
   UFUNCTION()
   void HandleInteractorStateEvent(const FIsdkInteractorStateEvent& Event)
@@ -120,5 +123,9 @@ class OCULUSINTERACTION_API UIsdkTestRayFixture : public UObject
   void HandlePointerEvent(const FIsdkInteractionPointerEvent& PointerEvent)
   {
     HandledPointerEvents.Add(PointerEvent);
+    if (OnPointerEvent)
+    {
+      OnPointerEvent(PointerEvent);
+    }
   }
 };
@@ -19,7 +19,9 @@
  */
 
 #include "IsdkTestRayFixtures.h"
+#include "IsdkMockInteractable.h"
 #include "Misc/AutomationTest.h"
+#include "Subsystem/IsdkEventBus.h"
 #include "Subsystem/IsdkEventQueueImpl.h"
 #include "Subsystem/IsdkWorldSubsystem.h"
 
@@ -84,11 +86,10 @@ bool FIsdkSubsystemEventQueueImplTest::RunTest(const FString& Parameters)
       &isdk::api::IInteractable::getIInteractableHandle,
       isdk::api::helper::CreateInteractableStateEventConverter(RayTest),
       RayTest->InteractableStateChanged);
-  auto PayloadLookup = [](const isdk_IPayload*) -> UIsdkInteractorComponent* { return nullptr; };
   isdk::api::helper::FPointerEventQueueImpl PointerEventQueue(
       [&RayTest]() -> isdk::api::IPointable* { return &RayTest->RayInteractable.Get(); },
       &isdk::api::IPointable::getIPointableHandle,
-      isdk::api::helper::CreatePointerEventConverter(RayTest->MockInteractable, PayloadLookup),
+      isdk::api::helper::CreatePointerEventConverter(RayTest->MockInteractable, nullptr),
       RayTest->InteractablePointed);
 
   // SetUp after we create the queues to test that adding delegate listeners after queue creation
@@ -177,3 +178,237 @@ bool FIsdkSubsystemTickTest::RunTest(const FString& Parameters)
 
   return bPassed;
 }
+
+/** Subscribes a ray fixture to the event bus, the way the subsystem registers a ray interactable. */
+static int64 RegisterEventBusTestFixture(
+    isdk::api::helper::FIsdkEventBus& EventBus,
+    UIsdkTestRayFixture* RayTest)
+{
+  return EventBus.PointerEvents.RegisterEventHandler(
+      MakePimpl<isdk::api::helper::FPointerEventQueueImpl>(
+          [RayTest]() -> isdk::api::IPointable* { return &RayTest->RayInteractable.Get(); },
+          &isdk::api::IPointable::getIPointableHandle,
+          isdk::api::helper::CreatePointerEventConverter(RayTest->MockInteractable, nullptr),
+          RayTest->InteractablePointed));
+}
+
+/** Checks that every pointer event a fixture handled came from its own interactable. */
+static bool VerifyEventBusTestFixture(UIsdkTestRayFixture* RayTest, FAutomationTestBase* TestBase)
+{
+  for (const FIsdkInteractionPointerEvent& PointerEvent : RayTest->HandledPointerEvents)
+  {
+    if (PointerEvent.Interactable.GetObject() != RayTest->MockInteractable)
+    {
+      return TestBase->TestEqual(
+          TEXT("Pointer events are dispatched to their interactable"),
+          PointerEvent.Interactable.GetObject(),
+          static_cast<UObject*>(RayTest->MockInteractable));
+    }
+  }
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkSubsystemEventBusThroughputTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.Subsystem.EventBusThroughput",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FIsdkSubsystemEventBusThroughputTest::RunTest(const FString& Parameters)
+{
+  constexpr int32 NumInteractables = 100;
+  constexpr int32 DrivesPerFrame = 10000;
+  constexpr int32 DrivesPerInteractable = DrivesPerFrame / NumInteractables;
+  constexpr int32 NumFrames = 20;
+
+  // One ray interactor and interactable per fixture, subscribed to the bus like the subsystem does
+  isdk::api::helper::FIsdkEventBus EventBus;
+  TArray<UIsdkTestRayFixture*> RayTests;
+  TArray<int64> UpdateTokens;
+  TArray<int64> PointerTokens;
+  for (int32 Index = 0; Index < NumInteractables; ++Index)
+  {
+    UIsdkTestRayFixture* RayTest = NewObject<UIsdkTestRayFixture>();
+    RayTest->SetUp();
+    RayTest->HandledPointerEvents.Reserve(DrivesPerInteractable * 2);
+    UpdateTokens.Add(EventBus.UpdateEvents.RegisterEventHandler(
+        MakePimpl<isdk::api::helper::FUpdateEventQueueImpl>(
+            [RayTest]() -> isdk::api::IUpdate* { return &RayTest->RayInteractor.Get(); },
+            RayTest->Updated)));
+    PointerTokens.Add(RegisterEventBusTestFixture(EventBus, RayTest));
+    RayTests.Add(RayTest);
+  }
+
+  bool bPassed = true;
+  int64 NumDispatchedEvents = 0;
+  uint64 DispatchCycles = 0;
+  for (int32 Frame = 0; bPassed && Frame < NumFrames; ++Frame)
+  {
+    for (UIsdkTestRayFixture* RayTest : RayTests)
+    {
+      RayTest->HandledPointerEvents.Reset();
+    }
+
+    // The native queues are created at the start of the frame, the interactors are driven once by
+    // the bus updates and the remaining times here, before anything is drained
+    EventBus.BeginFrame();
+    for (UIsdkTestRayFixture* RayTest : RayTests)
+    {
+      for (int32 Drive = 1; Drive < DrivesPerInteractable; ++Drive)
+      {
+        RayTest->RayInteractor->drive();
+      }
+    }
+    EventBus.RunUpdates();
+
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+    EventBus.DrainAndDispatchEvents();
+    DispatchCycles += FPlatformTime::Cycles64() - StartCycles;
+
+    const int32 NumDrained = EventBus.PointerEvents.NumDrainedEvents();
+    NumDispatchedEvents += NumDrained;
+    int32 NumHandled = 0;
+    for (UIsdkTestRayFixture* RayTest : RayTests)
+    {
+      NumHandled += RayTest->HandledPointerEvents.Num();
+      bPassed = bPassed && VerifyEventBusTestFixture(RayTest, this);
+    }
+    bPassed = bPassed &&
+        TestEqual(TEXT("Every drained pointer event is dispatched"), NumHandled, NumDrained);
+
+    if (Frame == 0)
+    {
+      for (int32 Index = 0; bPassed && Index < NumInteractables; ++Index)
+      {
+        bPassed = TestTrue(
+                      TEXT("Pointer events handled on the first frame"),
+                      RayTests[Index]->HandledPointerEvents.Num() > 0) &&
+            TestEqual(
+                      TEXT("Pointer events keep their order"),
+                      RayTests[Index]->HandledPointerEvents[0].Type,
+                      EIsdkPointerEventType::Hover);
+      }
+    }
+  }
+
+  AddInfo(FString::Printf(
+      TEXT("Event bus: %.3f ms per frame to drain and dispatch %.0f pointer events of %d interactables"),
+      FPlatformTime::ToMilliseconds64(DispatchCycles) / NumFrames,
+      static_cast<double>(NumDispatchedEvents) / NumFrames,
+      NumInteractables));
+
+  // Cleanup
+  for (int32 Index = 0; Index < NumInteractables; ++Index)
+  {
+    EventBus.UpdateEvents.UnregisterEventHandler(UpdateTokens[Index]);
+    EventBus.PointerEvents.UnregisterEventHandler(PointerTokens[Index]);
+  }
+  EventBus.Reset();
+  for (UIsdkTestRayFixture* RayTest : RayTests)
+  {
+    RayTest->TearDown();
+    RayTest->MarkAsGarbage();
+  }
+
+  return bPassed;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkSubsystemEventBusUnregisterDuringDispatchTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.Subsystem.EventBusUnregisterDuringDispatch",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FIsdkSubsystemEventBusUnregisterDuringDispatchTest::RunTest(const FString& Parameters)
+{
+  constexpr int32 NumInteractables = 3;
+
+  isdk::api::helper::FIsdkEventBus EventBus;
+  TArray<UIsdkTestRayFixture*> RayTests;
+  TArray<int64> Tokens;
+  for (int32 Index = 0; Index < NumInteractables; ++Index)
+  {
+    UIsdkTestRayFixture* RayTest = NewObject<UIsdkTestRayFixture>();
+    RayTest->SetUp();
+    Tokens.Add(RegisterEventBusTestFixture(EventBus, RayTest));
+    RayTests.Add(RayTest);
+  }
+
+  // The first subscription drops the second one while its own events are dispatched
+  bool bUnregistered = false;
+  RayTests[0]->OnPointerEvent =
+      [&EventBus, &Tokens, &bUnregistered](const FIsdkInteractionPointerEvent&)
+  {
+    if (!bUnregistered)
+    {
+      EventBus.PointerEvents.UnregisterEventHandler(Tokens[1]);
+      bUnregistered = true;
+    }
+  };
+
+  // First frame: only the first two interactors are driven. The removal is deferred, so the second
+  // subscription still receives the events drained along with the first one.
+  EventBus.BeginFrame();
+  RayTests[0]->RayInteractor->drive();
+  RayTests[1]->RayInteractor->drive();
+  EventBus.DrainAndDispatchEvents();
+
+  bool bPassed = TestTrue(TEXT("Unregistered during dispatch"), bUnregistered) &&
+      TestEqual(
+          TEXT("Subscriptions until the next frame"),
+          EventBus.PointerEvents.Num(),
+          NumInteractables) &&
+      TestTrue(
+          TEXT("Pointer events of the unregistering subscription"),
+          RayTests[0]->HandledPointerEvents.Num() > 0) &&
+      TestTrue(
+          TEXT("Pointer events of the subscription removed during dispatch"),
+          RayTests[1]->HandledPointerEvents.Num() > 0) &&
+      TestEqual(
+          TEXT("Pointer events of the idle subscription"),
+          RayTests[2]->HandledPointerEvents.Num(),
+          0) &&
+      VerifyEventBusTestFixture(RayTests[0], this) &&
+      VerifyEventBusTestFixture(RayTests[1], this);
+
+  // Second frame: the removal is processed and the third subscription moves into the freed slot.
+  // Its interactor raises its first events now, they must reach its own interactable.
+  for (UIsdkTestRayFixture* RayTest : RayTests)
+  {
+    RayTest->HandledPointerEvents.Reset();
+  }
+  EventBus.BeginFrame();
+  bPassed = bPassed &&
+      TestEqual(
+          TEXT("Subscriptions after the removal"),
+          EventBus.PointerEvents.Num(),
+          NumInteractables - 1);
+  RayTests[1]->RayInteractor->drive();
+  RayTests[2]->RayInteractor->drive();
+  EventBus.DrainAndDispatchEvents();
+
+  bPassed = bPassed &&
+      TestEqual(
+          TEXT("Pointer events of the removed subscription"),
+          RayTests[1]->HandledPointerEvents.Num(),
+          0) &&
+      TestTrue(
+          TEXT("Pointer events of the moved subscription"),
+          RayTests[2]->HandledPointerEvents.Num() > 0) &&
+      VerifyEventBusTestFixture(RayTests[2], this) &&
+      TestEqual(
+          TEXT("Pointer event [0] of the moved subscription"),
+          RayTests[2]->HandledPointerEvents[0].Type,
+          EIsdkPointerEventType::Hover);
+
+  // Cleanup, the moved subscription must be found at its new index
+  RayTests[0]->OnPointerEvent.Reset();
+  EventBus.PointerEvents.UnregisterEventHandler(Tokens[0]);
+  EventBus.PointerEvents.UnregisterEventHandler(Tokens[2]);
+  EventBus.Reset();
+  for (UIsdkTestRayFixture* RayTest : RayTests)
+  {
+    RayTest->TearDown();
+    RayTest->MarkAsGarbage();
+  }
+
+  return bPassed;
+}
@@ -56,3 +56,141 @@ bool FIsdkThrowableTest::RunTest(const FString& Parameters)
 
   return true;
 }
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkThrowableSampleHistoryTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkThrowableTest.SampleHistory",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkThrowableSampleHistoryTest::RunTest(const FString& Parameters)
+{
+  TIsdkSampleHistory<FVector> History;
+  History.Init(4);
+  TestTrue("Empty after init", History.IsEmpty());
+
+  // Wrap around twice so the oldest sample sits in the middle of the ring
+  for (int32 i = 0; i < 10; i++)
+  {
+    History.Add(FVector(i, 0, 0), i * 0.1f);
+  }
+  TestEqual("Num is capped at the capacity", History.Num(), 4);
+  TestEqual("Oldest sample", History.GetSample(0).X, 6.0);
+  TestEqual("Newest sample", History.GetNewestSample().X, 9.0);
+  TestEqual("Newest time", History.GetTime(3), 0.9f);
+
+  TArray<FVector> Samples;
+  TArray<float> Times;
+  Samples.Reserve(4);
+  Times.Reserve(4);
+  const FVector* const SamplesData = Samples.GetData();
+
+  TestEqual("Window of three", History.CopyNewest(3, Samples, Times), 3);
+  TestEqual("Window starts with the oldest of the three", Samples[0].X, 7.0);
+  TestEqual("Window ends with the newest", Samples[2].X, 9.0);
+  TestEqual("Window times follow the samples", Times[2], 0.9f);
+
+  TestEqual("Window larger than the history", History.CopyNewest(8, Samples, Times), 4);
+  TestEqual("Whole history, oldest first", Samples[0].X, 6.0);
+  TestTrue("Windows reuse their allocation", Samples.GetData() == SamplesData);
+
+  History.Reset();
+  TestEqual("Empty window after reset", History.CopyNewest(4, Samples, Times), 0);
+
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkThrowableGoldenTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkThrowableTest.Golden",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkThrowableGoldenTest::RunTest(const FString& Parameters)
+{
+  // A throw along X at 100 units per second, with one outlier far ahead of the track
+  TArray<TPair<FVector, float>> SamplePositions;
+  for (int32 i = 0; i < 8; i++)
+  {
+    SamplePositions.Add(TPair<FVector, float>(FVector(10.0 * i, 5, 0), 0.1f * i));
+  }
+  SamplePositions[4].Key.X += 1000.0;
+
+  {
+    UIsdkThrowable* Throwable = NewObject<UIsdkThrowable>();
+    Throwable->Settings.SampleSize = 8;
+    Throwable->SetSamplePositions(SamplePositions);
+
+    const FVector Velocity = Throwable->GetVelocity();
+    TestEqual("Least squares ignores the outlier", Velocity.X, 100.0, 0.01);
+    TestEqual("Least squares Y", Velocity.Y, 0.0, 0.001);
+    TestEqual("Least squares Z", Velocity.Z, 0.0, 0.001);
+    TestEqual("Samples are consumed by a release", Throwable->GetVelocity(), FVector::ZeroVector);
+  }
+
+  // Noisy samples, so RANSAC depends on the samples it draws
+  FRandomStream Noise(7);
+  for (TPair<FVector, float>& PositionTimestampPair : SamplePositions)
+  {
+    PositionTimestampPair.Key += Noise.GetUnitVector();
+  }
+
+  auto GetRansacVelocity = [&SamplePositions](int32 Seed)
+  {
+    UIsdkThrowable* Throwable = NewObject<UIsdkThrowable>();
+    Throwable->Settings.SampleSize = 8;
+    Throwable->Settings.RansacSeed = Seed;
+    Throwable->Settings.VelocityEstimationMethod = EIsdkVelocityEstimationMethod::VE_RANSAC;
+    Throwable->SetSamplePositions(SamplePositions);
+    return Throwable->GetVelocity();
+  };
+
+  const FVector RansacVelocity = GetRansacVelocity(42);
+  TestEqual("RANSAC is reproducible with the same seed", GetRansacVelocity(42), RansacVelocity);
+  TestFalse("RANSAC finds a velocity", RansacVelocity.IsNearlyZero());
+
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    FIsdkThrowableBenchmarkTest,
+    "InteractionSDK.OculusInteraction.Source.OculusInteraction.Private.Tests.FIsdkThrowableTest.Benchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FIsdkThrowableBenchmarkTest::RunTest(const FString& Parameters)
+{
+  constexpr int32 SampleSize = 100;
+  constexpr int32 NumReleases = 1000;
+
+  TArray<TPair<FVector, float>> SamplePositions;
+  for (int32 i = 0; i < SampleSize; i++)
+  {
+    SamplePositions.Add(TPair<FVector, float>(FVector(10.0 * i, 0.5 * i, 0), 0.01f * i));
+  }
+
+  const EIsdkVelocityEstimationMethod Methods[] = {
+      EIsdkVelocityEstimationMethod::VE_LeastSquares, EIsdkVelocityEstimationMethod::VE_RANSAC};
+  for (const EIsdkVelocityEstimationMethod Method : Methods)
+  {
+    UIsdkThrowable* Throwable = NewObject<UIsdkThrowable>();
+    Throwable->Settings.SampleSize = SampleSize;
+    Throwable->Settings.VelocityEstimationMethod = Method;
+
+    uint64 ReleaseCycles = 0;
+    for (int32 Release = 0; Release < NumReleases; Release++)
+    {
+      Throwable->SetSamplePositions(SamplePositions);
+      const uint64 StartCycles = FPlatformTime::Cycles64();
+      Throwable->GetVelocity();
+      ReleaseCycles += FPlatformTime::Cycles64() - StartCycles;
+    }
+
+    const double MicrosecondsPerRelease =
+        FPlatformTime::ToMilliseconds64(ReleaseCycles) * 1000.0 / NumReleases;
+    AddInfo(FString::Printf(
+        TEXT("%s: %.2f us per release of %d samples"),
+        *UEnum::GetValueAsString(Method),
+        MicrosecondsPerRelease,
+        SampleSize));
+  }
+
+  return true;
+}
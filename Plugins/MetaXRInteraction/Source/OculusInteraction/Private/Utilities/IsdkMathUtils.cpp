@@ -44,22 +44,49 @@ FVector FIsdkMathUtils::Ransac(
     int32 RansacIterations,
     float RansacScoreThreshold)
 {
+  TArray<FVector> PositionValues;
+  TArray<float> Times;
+  PositionValues.Reserve(Positions.Num());
+  Times.Reserve(Positions.Num());
+  for (const TPair<FVector, float>& PositionTimestampPair : Positions)
+  {
+    PositionValues.Add(PositionTimestampPair.Key);
+    Times.Add(PositionTimestampPair.Value);
+  }
+
+  FRandomStream Random(FMath::Rand());
+  return Ransac(PositionValues, Times, RansacIterations, RansacScoreThreshold, Random);
+}
+
+FVector FIsdkMathUtils::Ransac(
+    TConstArrayView<FVector> Positions,
+    TConstArrayView<float> Times,
+    int32 RansacIterations,
+    float RansacScoreThreshold,
+    FRandomStream& Random)
+{
+  check(Positions.Num() == Times.Num());
+
   FVector BestSample = FVector::ZeroVector;
+  if (Positions.Num() == 0)
+  {
+    return BestSample;
+  }
+
   float BestScore = FLT_MAX;
   for (int32 i = 0; i < RansacIterations; i++)
   {
-    const int32 Idx1 = FMath::RandRange(0, Positions.Num() - 1);
-    const int32 Idx2 = FMath::RandRange(0, Positions.Num() - 1);
+    const int32 Idx1 = Random.RandRange(0, Positions.Num() - 1);
+    const int32 Idx2 = Random.RandRange(0, Positions.Num() - 1);
     // Ensure that the position with the smaller time is used as the start position
-    if (Positions[Idx1].Value < Positions[Idx2].Value)
+    if (Times[Idx1] < Times[Idx2])
     {
-      FVector Sample = VelocityFromSamples(
-          Positions[Idx1].Key, Positions[Idx1].Value, Positions[Idx2].Key, Positions[Idx2].Value);
+      FVector Sample =
+          VelocityFromSamples(Positions[Idx1], Times[Idx1], Positions[Idx2], Times[Idx2]);
       // Calculate the score
       float Score = 0.0f;
-      for (const TPair<FVector, float>& PositionTimestamp : Positions)
+      for (const FVector& Position : Positions)
       {
-        FVector Position = PositionTimestamp.Key;
         Score += FVector::DistSquared(Sample, Position);
       }
 
@@ -80,21 +107,42 @@ FVector FIsdkMathUtils::Ransac(
 
 FVector FIsdkMathUtils::LeastSquares(const TArray<TPair<FVector, float>>& Positions)
 {
+  TArray<FVector> PositionValues;
+  TArray<float> Times;
+  PositionValues.Reserve(Positions.Num());
+  Times.Reserve(Positions.Num());
+  for (const TPair<FVector, float>& PositionTimestampPair : Positions)
+  {
+    PositionValues.Add(PositionTimestampPair.Key);
+    Times.Add(PositionTimestampPair.Value);
+  }
+
+  return LeastSquares(PositionValues, Times);
+}
+
+FVector FIsdkMathUtils::LeastSquares(TConstArrayView<FVector> Positions, TConstArrayView<float> Times)
+{
+  check(Positions.Num() == Times.Num());
+
   const int32 NumPositions = Positions.Num();
+  if (NumPositions == 0)
+  {
+    return FVector::ZeroVector;
+  }
+
   double SumTime = 0.0f;
   double SumTimeSquared = 0.0f;
   FVector SumPosition = FVector::ZeroVector;
   FVector SumTimePosition = FVector::ZeroVector;
 
-  for (const TPair<FVector, float>& PositionTimestampPair : Positions)
+  // Separate arrays keep this a straight accumulation over contiguous memory
+  for (int32 i = 0; i < NumPositions; i++)
   {
-    const float Time = PositionTimestampPair.Value;
-    FVector Position = PositionTimestampPair.Key;
-
+    const float Time = Times[i];
     SumTime += Time;
     SumTimeSquared += Time * Time;
-    SumPosition += Position;
-    SumTimePosition += Time * Position;
+    SumPosition += Positions[i];
+    SumTimePosition += Time * Positions[i];
   }
 
   const double Denominator = NumPositions * (SumTimeSquared - (SumTime * SumTime) / NumPositions);
@@ -109,7 +157,7 @@ FVector FIsdkMathUtils::LeastSquares(const TArray<TPair<FVector, float>>& Positi
   return Velocity;
 }
 
-FVector FIsdkMathUtils::GetMean(const TArray<FVector>& Positions)
+FVector FIsdkMathUtils::GetMean(TConstArrayView<FVector> Positions)
 {
   if (Positions.Num() == 0)
   {
@@ -125,7 +173,7 @@ FVector FIsdkMathUtils::GetMean(const TArray<FVector>& Positions)
   return Mean / Positions.Num();
 }
 
-FVector FIsdkMathUtils::GetStandardDeviation(const TArray<FVector>& Positions, const FVector& Mean)
+FVector FIsdkMathUtils::GetStandardDeviation(TConstArrayView<FVector> Positions, const FVector& Mean)
 {
   if (Positions.Num() <= 1)
   {
@@ -147,6 +195,37 @@ FVector FIsdkMathUtils::GetStandardDeviation(const TArray<FVector>& Positions, c
   return StdDev;
 }
 
+int32 FIsdkMathUtils::FilterByZScore(TArray<FVector>& Positions, TArray<float>& Times, float Threshold)
+{
+  check(Positions.Num() == Times.Num());
+
+  const FVector Mean = GetMean(Positions);
+  const FVector StdDev = GetStandardDeviation(Positions, Mean);
+
+  // Scaling by the inverse deviation keeps the loop free of divisions and branches, an axis
+  // without deviation scales to a z-score of zero instead of dividing zero by zero
+  const FVector InvStdDev(
+      StdDev.X > 0.0 ? 1.0 / StdDev.X : 0.0,
+      StdDev.Y > 0.0 ? 1.0 / StdDev.Y : 0.0,
+      StdDev.Z > 0.0 ? 1.0 / StdDev.Z : 0.0);
+
+  int32 NumKept = 0;
+  for (int32 i = 0; i < Positions.Num(); i++)
+  {
+    const FVector ZScore = (Positions[i] - Mean) * InvStdDev;
+    if (ZScore.GetMax() <= Threshold)
+    {
+      Positions[NumKept] = Positions[i];
+      Times[NumKept] = Times[i];
+      NumKept++;
+    }
+  }
+
+  Positions.SetNum(NumKept, EAllowShrinking::No);
+  Times.SetNum(NumKept, EAllowShrinking::No);
+  return NumKept;
+}
+
 FVector
 FIsdkMathUtils::VelocityFromSamples(FVector Position1, float Time1, FVector Position2, float Time2)
 {
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Utilities/IsdkSkeletonPoseBatch.h"
+
+void FIsdkSkeletonPoseBatch::Initialize(TConstArrayView<int32> InParentIndices)
+{
+  check(!IsActive());
+
+  ParentIndices = InParentIndices;
+  ComponentSpaceTransforms.SetNumUninitialized(ParentIndices.Num());
+  ComponentSpaceValid.Init(false, ParentIndices.Num());
+}
+
+void FIsdkSkeletonPoseBatch::Reset()
+{
+  check(!IsActive());
+
+  ParentIndices.Reset();
+  ComponentSpaceTransforms.Reset();
+  ComponentSpaceValid.Reset();
+}
+
+void FIsdkSkeletonPoseBatch::Begin(TArray<FTransform>& InBoneSpaceTransforms)
+{
+  check(InBoneSpaceTransforms.Num() == ParentIndices.Num());
+
+  BoneSpaceTransforms = &InBoneSpaceTransforms;
+  ComponentSpaceValid.SetRange(0, ComponentSpaceValid.Num(), false);
+}
+
+void FIsdkSkeletonPoseBatch::End()
+{
+  BoneSpaceTransforms = nullptr;
+}
+
+const FTransform& FIsdkSkeletonPoseBatch::GetComponentSpaceTransform(int32 BoneIndex)
+{
+  check(IsActive());
+
+  if (!ComponentSpaceValid[BoneIndex])
+  {
+    // Walk up to the closest bone with a known transform, then compose the chain back down
+    TArray<int32, TInlineAllocator<32>> Chain;
+    for (int32 ChainBone = BoneIndex; ChainBone != INDEX_NONE && !ComponentSpaceValid[ChainBone];
+         ChainBone = ParentIndices[ChainBone])
+    {
+      Chain.Add(ChainBone);
+    }
+
+    for (int32 Index = Chain.Num() - 1; Index >= 0; --Index)
+    {
+      const int32 ChainBone = Chain[Index];
+      const int32 ParentIndex = ParentIndices[ChainBone];
+      if (ParentIndex == INDEX_NONE)
+      {
+        ComponentSpaceTransforms[ChainBone] = (*BoneSpaceTransforms)[ChainBone];
+      }
+      else
+      {
+        // Same composition as FA2CSPose, which the per-bone getters and setters use
+        ComponentSpaceTransforms[ChainBone] =
+            (*BoneSpaceTransforms)[ChainBone] * ComponentSpaceTransforms[ParentIndex];
+        ComponentSpaceTransforms[ChainBone].NormalizeRotation();
+      }
+      ComponentSpaceValid[ChainBone] = true;
+    }
+  }
+
+  return ComponentSpaceTransforms[BoneIndex];
+}
+
+void FIsdkSkeletonPoseBatch::SetComponentSpaceTransform(
+    int32 BoneIndex,
+    const FTransform& Transform)
+{
+  check(IsActive());
+
+  FTransform& LocalTransform = (*BoneSpaceTransforms)[BoneIndex];
+  LocalTransform = Transform;
+
+  const int32 ParentIndex = ParentIndices[BoneIndex];
+  if (ParentIndex != INDEX_NONE)
+  {
+    LocalTransform.SetToRelativeTransform(GetComponentSpaceTransform(ParentIndex));
+  }
+
+  // Children come after their parents, so one pass forward drops every bone below this one
+  ComponentSpaceValid[BoneIndex] = false;
+  for (int32 Index = BoneIndex + 1; Index < ComponentSpaceValid.Num(); ++Index)
+  {
+    const int32 ParentOfIndex = ParentIndices[Index];
+    if (ComponentSpaceValid[Index] && ParentOfIndex != INDEX_NONE &&
+        !ComponentSpaceValid[ParentOfIndex])
+    {
+      ComponentSpaceValid[Index] = false;
+    }
+  }
+}
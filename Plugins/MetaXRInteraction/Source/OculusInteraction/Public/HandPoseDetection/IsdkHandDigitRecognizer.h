@@ -34,6 +34,8 @@ class DigitRecognizer;
 } // namespace isdk::api
 typedef struct isdk_DigitRecognizer_ isdk_DigitRecognizer;
 
+struct FIsdkHandPoseRecognizerInputs;
+
 /**
  * Container for API-driven Digit Recognizer
  */
@@ -56,6 +58,10 @@ class OCULUSINTERACTION_API UIsdkHandDigitRecognizer : public UObject
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
   void UpdateState(float DeltaTime);
 
+  /* Update driven by FIsdkHandPoseRecognizerScheduler, with inputs it read from HandMesh. Returns
+   * false if the recognizer isn't ready, or if it can't change state since its last update. */
+  bool UpdateScheduledState(const FIsdkHandPoseRecognizerInputs& Inputs, float DeltaTime);
+
   isdk::api::DigitRecognizer* GetApiDigitRecognizer() const
   {
     return ApiDigitRecognizer;
@@ -84,4 +90,13 @@ class OCULUSINTERACTION_API UIsdkHandDigitRecognizer : public UObject
       PURE_VIRTUAL(UIsdkDigitRecognizer::CreateDigitRecognizer, return nullptr;);
 
   isdk::api::DigitRecognizer* ApiDigitRecognizer{};
+
+ private:
+  bool CreateApiDigitRecognizer();
+
+  /* HandMesh frame version seen by the last update */
+  uint64 LastFrameVersion = MAX_uint64;
+
+  /* If transitions have a minimum time, updating can change the state without new joint data */
+  bool bTransitionsOverTime = true;
 };
@@ -22,12 +22,15 @@
 
 #include "CoreMinimal.h"
 #include "StructTypes.h"
+#include "DataSources/IsdkIHmdDataSource.h"
+#include "DataSources/IsdkIRootPose.h"
 #include "UObject/Object.h"
 #include "IsdkHandFingerPinchGrabRecognizer.generated.h"
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FIsdkPinchGrabRecognizerEventDelegate);
 
 class UIsdkHandMeshComponent;
+struct FIsdkHandPoseRecognizerInputs;
 
 // Forward declarations of internal types
 namespace isdk::api
@@ -56,6 +59,10 @@ class OCULUSINTERACTION_API UIsdkHandFingerPinchGrabRecognizer : public UObject
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
   void UpdateState(float DeltaTime);
 
+  /* Update driven by FIsdkHandPoseRecognizerScheduler, with inputs it read from HandVisual. Returns
+   * false if the recognizer isn't ready. */
+  bool UpdateScheduledState(const FIsdkHandPoseRecognizerInputs& Inputs, float DeltaTime);
+
   /* Returns if the recognizer is currently active and a pinch grab is detected */
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
   bool IsActive();
@@ -92,11 +99,21 @@ class OCULUSINTERACTION_API UIsdkHandFingerPinchGrabRecognizer : public UObject
   UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = InteractionSDK)
   FVector CurrentHMDForward;
 
+  /* If set, CurrentWristForward is read from this root pose on every update */
+  UPROPERTY(BlueprintReadWrite, Category = InteractionSDK)
+  TScriptInterface<IIsdkIRootPose> WristRootPose;
+
+  /* If set, CurrentHMDForward is read from this HMD data source on every update */
+  UPROPERTY(BlueprintReadWrite, Category = InteractionSDK)
+  TScriptInterface<IIsdkIHmdDataSource> HmdDataSource;
+
   /* Separated into distinct method for easier unit testing */
   void UpdatePinchConfidence();
 
  protected:
   isdk::api::IHandPositionFrame* EnsureHandPositionFrame() const;
+  void UpdateForwardsFromDataSources();
+  void UpdateStateWithJointData(float DeltaTime, bool bJointDataValid);
 
   TPimplPtr<isdk::api::helper::FFingerPinchGrabRecognizerImpl> FingerPinchGrabRecognizerImpl;
 };
@@ -28,6 +28,7 @@
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FIsdkPalmGrabRecognizerEventDelegate);
 
 class UIsdkHandMeshComponent;
+struct FIsdkHandPoseRecognizerInputs;
 
 // Forward declarations of internal types
 namespace isdk::api
@@ -53,6 +54,10 @@ class OCULUSINTERACTION_API UIsdkHandPalmGrabRecognizer : public UObject
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
   void UpdateState(float DeltaTime);
 
+  /* Update driven by FIsdkHandPoseRecognizerScheduler, with inputs it read from HandVisual. Returns
+   * false if the recognizer isn't ready. */
+  bool UpdateScheduledState(const FIsdkHandPoseRecognizerInputs& Inputs, float DeltaTime);
+
   /* Returns if the recognizer is currently active and a palm grab is detected */
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
   bool IsActive();
@@ -95,6 +100,7 @@ class OCULUSINTERACTION_API UIsdkHandPalmGrabRecognizer : public UObject
   int PalmGrabMinFingers{3};
 
   isdk::api::IHandPositionFrame* EnsureHandPositionFrame() const;
+  void UpdateStateWithJointData(float DeltaTime, bool bJointDataValid);
 
   class FPalmGrabRecognizerImpl;
   TPimplPtr<FPalmGrabRecognizerImpl> PalmGrabRecognizerImpl = nullptr;
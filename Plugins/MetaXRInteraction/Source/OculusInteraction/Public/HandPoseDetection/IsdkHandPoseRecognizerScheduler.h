@@ -0,0 +1,86 @@
+﻿/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UIsdkHandMeshComponent;
+class UIsdkHandDigitRecognizer;
+class UIsdkHandFingerPinchGrabRecognizer;
+class UIsdkHandPalmGrabRecognizer;
+
+// Forward declarations of internal types
+namespace isdk::api
+{
+class IHandPositionFrame;
+} // namespace isdk::api
+
+/**
+ * The state of a hand that its recognizers depend on, read once per update for all of them
+ */
+struct OCULUSINTERACTION_API FIsdkHandPoseRecognizerInputs
+{
+  /* Set if the hand position frame can be read, which needs valid joint and root pose data */
+  isdk::api::IHandPositionFrame* HandPositionFrame = nullptr;
+
+  /* Whether the hand position frame instance exists, even if it can't be read this frame */
+  bool bApiInstanceValid = false;
+
+  bool bJointDataValid = false;
+
+  /* Changes whenever new joint positions are written to the hand position frame */
+  uint64 FrameVersion = 0;
+
+  static FIsdkHandPoseRecognizerInputs Read(UIsdkHandMeshComponent& Hand);
+};
+
+/**
+ * Updates all hand pose recognizers registered with one hand, instead of each one being updated
+ * through its own UpdateState call. The hand is read once per update for all of them, and digit
+ * recognizers that can't change state since their last update are skipped.
+ */
+class OCULUSINTERACTION_API FIsdkHandPoseRecognizerScheduler
+{
+ public:
+  /* Accepts digit, pinch grab and palm grab recognizers of the given hand */
+  bool Register(const UIsdkHandMeshComponent& Hand, UObject* Recognizer);
+  void Unregister(UObject* Recognizer);
+
+  int32 Num() const
+  {
+    return DigitRecognizers.Num() + PinchGrabRecognizers.Num() + PalmGrabRecognizers.Num();
+  }
+
+  bool IsEmpty() const
+  {
+    return Num() == 0;
+  }
+
+  /* Updates every registered recognizer of the hand that can change. Returns how many were
+   * updated. */
+  int32 Update(UIsdkHandMeshComponent& Hand, float DeltaTime);
+
+ private:
+  TArray<TWeakObjectPtr<UIsdkHandDigitRecognizer>> DigitRecognizers;
+  TArray<TWeakObjectPtr<UIsdkHandFingerPinchGrabRecognizer>> PinchGrabRecognizers;
+  TArray<TWeakObjectPtr<UIsdkHandPalmGrabRecognizer>> PalmGrabRecognizers;
+  bool bUpdating = false;
+};
@@ -59,6 +59,8 @@ class OCULUSINTERACTION_API UIsdkGrabbableComponent : public UIsdkSceneInteracta
 
   virtual void BeginPlay() override;
   virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+  virtual void OnRegister() override;
+  virtual void OnUnregister() override;
   virtual void
   TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* TickFn) override;
 
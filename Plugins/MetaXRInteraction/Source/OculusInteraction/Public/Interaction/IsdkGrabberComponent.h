@@ -85,14 +85,10 @@ class OCULUSINTERACTION_API UIsdkGrabberComponent : public UIsdkSceneInteractorC
       EIsdkGrabColliderType Type,
       FIsdkColliderInfo& OutColliderInfo)
   {
-    if (CollidersByType.Contains(Type))
+    if (const FIsdkColliderInfo* ColliderInfo = FindColliderInfo(Collider, Type))
     {
-      auto& CollidersOfType = CollidersByType[Type];
-      if (const FIsdkColliderInfo* ColliderInfo = CollidersOfType.Find(Collider))
-      {
-        OutColliderInfo = *ColliderInfo;
-        return true;
-      }
+      OutColliderInfo = *ColliderInfo;
+      return true;
     }
     return false;
   }
@@ -100,29 +96,19 @@ class OCULUSINTERACTION_API UIsdkGrabberComponent : public UIsdkSceneInteractorC
   void SetColliderInfo(
       UPrimitiveComponent* Collider,
       EIsdkGrabColliderType Type,
-      const FIsdkColliderInfo& ColliderInfo)
-  {
-    if (CollidersByType.Contains(Type))
-    {
-      auto& CollidersOfType = CollidersByType[Type];
-      CollidersOfType.Emplace(Collider, ColliderInfo);
-    }
-  }
+      const FIsdkColliderInfo& ColliderInfo);
   /* Adds a PrimitiveComponent of the given IsdkGrabColliderType to this Interactor */
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
   void AddCollider(UPrimitiveComponent* Collider, EIsdkGrabColliderType Type);
 
   /* Removes a PrimitiveComponent of the given IsdkGrabColliderType from this Interactor */
   UFUNCTION(BlueprintCallable, Category = InteractionSDK)
-  void RemoveCollider(UPrimitiveComponent* Collider, EIsdkGrabColliderType Type)
-  {
-    auto& CollidersOfType = CollidersByType[Type];
-    if (CollidersOfType.Contains(Collider))
-    {
-      CollidersOfType.Remove(Collider);
-    }
-  }
+  void RemoveCollider(UPrimitiveComponent* Collider, EIsdkGrabColliderType Type);
 
+  /**
+   * Finds the nearest grabbable collider hovered by a collider of the given type. The result is
+   * cached until the end of the frame and kept up to date as overlaps begin and end.
+   */
   UFUNCTION()
   void ComputeBestGrabbableColliderForGrabType(
       EIsdkGrabColliderType Type,
@@ -218,7 +204,49 @@ class OCULUSINTERACTION_API UIsdkGrabberComponent : public UIsdkSceneInteractorC
       UPrimitiveComponent* OtherComp,
       int32 OtherBodyIndex);
 
-  void UpdateOverlappedSet();
+  FIsdkColliderInfo* FindColliderInfo(UPrimitiveComponent* Collider, EIsdkGrabColliderType Type)
+  {
+    PrimitiveComponentToColliderInfoMap* CollidersOfType = CollidersByType.Find(Type);
+    return CollidersOfType ? CollidersOfType->Find(Collider) : nullptr;
+  }
+  FIsdkColliderInfo* FindColliderInfoAndType(
+      UPrimitiveComponent* Collider,
+      EIsdkGrabColliderType& OutType);
+
+  // Returns the grabbable whose grab collider is OtherComp, or nullptr
+  UIsdkGrabbableComponent* FindGrabbableForGrabCollider(UPrimitiveComponent* OtherComp) const;
+  UIsdkGrabbableComponent* FindGrabbableInOwner(UPrimitiveComponent* OtherComp) const;
+
+  // OverlappedGrabbables holds every grabbable referenced by a collider info, hovered or selected.
+  // References are counted so that the set is maintained as overlaps begin and end.
+  void AddOverlapReference(UIsdkGrabbableComponent* Grabbable);
+  void RemoveOverlapReference(UIsdkGrabbableComponent* Grabbable);
+  void AddOverlapReferences(const FIsdkColliderInfo& Info);
+  void RemoveOverlapReferences(const FIsdkColliderInfo& Info);
+
+  struct FGrabCandidate
+  {
+    UPrimitiveComponent* MyCollider{};
+    UPrimitiveComponent* GrabbableCollider{};
+    UIsdkGrabbableComponent* Grabbable{};
+    double DistanceSquared{TNumericLimits<double>::Max()};
+    uint64 Frame{};
+    bool bIsValid{};
+  };
+
+  FGrabCandidate& GetCachedCandidate(EIsdkGrabColliderType Type)
+  {
+    return CachedCandidates[static_cast<int>(Type)];
+  }
+  void InvalidateCachedCandidate(EIsdkGrabColliderType Type)
+  {
+    GetCachedCandidate(Type).bIsValid = false;
+  }
+  void OfferCandidate(
+      EIsdkGrabColliderType Type,
+      UPrimitiveComponent* MyCollider,
+      UPrimitiveComponent* GrabbableCollider,
+      UIsdkGrabbableComponent* Grabbable);
 
   void PostEvent(EIsdkPointerEventType Type, UIsdkGrabbableComponent* Dest);
   virtual void TickComponent(
@@ -227,8 +255,6 @@ class OCULUSINTERACTION_API UIsdkGrabberComponent : public UIsdkSceneInteractorC
       FActorComponentTickFunction* ThisTickFunction) override;
   void UnregisterCollider(UPrimitiveComponent* Collider, EIsdkGrabColliderType Type);
 
-  EIsdkGrabColliderType FindColliderType(UPrimitiveComponent* Collider) const;
-
   int64 PointerEventToken = 0;
 
   UPROPERTY(Instanced)
@@ -246,6 +272,10 @@ class OCULUSINTERACTION_API UIsdkGrabberComponent : public UIsdkSceneInteractorC
 
   UPROPERTY()
   TSet<UIsdkGrabbableComponent*> OverlappedGrabbables;
+  TMap<UIsdkGrabbableComponent*, int32> OverlapReferenceCounts;
+
+  // Best candidate per grab type, valid for the frame it was scored in
+  FGrabCandidate CachedCandidates[GrabColliderTypeCount + 1];
 
   int NextRankIndex = 0;
   EIsdkGrabColliderType SelectingColliderType = EIsdkGrabColliderType::Unknown;
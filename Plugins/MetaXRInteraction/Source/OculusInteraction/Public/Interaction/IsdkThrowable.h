@@ -24,6 +24,7 @@
 #include "Components/ActorComponent.h"
 #include "Components/SceneComponent.h"
 #include "Utilities/IsdkMathUtils.h"
+#include "Utilities/IsdkSampleHistory.h"
 #include "IsdkThrowable.generated.h"
 
 /* Different methods for estimating the velocity of the object after being thrown */
@@ -77,6 +78,15 @@ struct OCULUSINTERACTION_API FIsdkThrowableSettings
       meta = (ClampMin = "1.0", ClampMax = "5.0", Tooltip = "The scale for the angular velocity."))
   float AngularVelocityScale = 2.0f;
 
+  // The seed of the random sample selection of RANSAC, the same samples always give the same
+  // velocity
+  UPROPERTY(
+      EditAnywhere,
+      BlueprintReadWrite,
+      Category = "InteractionSDK|Throwable",
+      meta = (Tooltip = "The seed for the random sample selection of the RANSAC estimation."))
+  int32 RansacSeed = 0;
+
   float LastTime;
 
   /* The method to use for velocity estimation */
@@ -149,14 +159,14 @@ class OCULUSINTERACTION_API UIsdkThrowable : public USceneComponent
   const int32 Ransac_Iterations = 50;
   const float Ransac_Score_Threshold = 0.01f;
 
-  // Arrays to store the last tracked object positions and rotations
-  TArray<TPair<FVector, float>> LastNPositions;
-  TArray<TPair<FQuat, float>> LastNRotations;
-  void GetLastNPositions(int32 N, TArray<TPair<FVector, float>>& OutPositions);
+  // The last tracked object positions and rotations
+  TIsdkSampleHistory<FVector> PositionHistory;
+  TIsdkSampleHistory<FQuat> RotationHistory;
 
-  int32 CurrentPositionIndex = 0;
-  int32 PreviousPositionIndex = 0;
-  int32 CurrentRotationIndex = 0;
+  // Samples of a velocity estimation, kept so estimating doesn't allocate
+  TArray<FVector> WindowPositions;
+  TArray<float> WindowTimes;
 
+  void InitSampleHistories();
   void ResetKalmanFilter();
 };
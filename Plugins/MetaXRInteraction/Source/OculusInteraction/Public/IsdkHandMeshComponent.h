@@ -25,6 +25,8 @@
 #include "Components/PoseableMeshComponent.h"
 #include "IsdkHandPoseData.h"
 #include "StructTypes.h"
+#include "HandPoseDetection/IsdkHandPoseRecognizerScheduler.h"
+#include "Utilities/IsdkSkeletonPoseBatch.h"
 #include "IsdkHandMeshComponent.generated.h"
 
 class IIsdkIRootPose;
@@ -71,6 +73,19 @@ class OCULUSINTERACTION_API UIsdkHandMeshComponent : public UPoseableMeshCompone
   // instance. Otherwise, return nullptr.
   isdk::api::IHandPositionFrame* TryGetApiIHandPositionFrame() const;
 
+  // Changes whenever different joint positions are written to the native hand position frame
+  uint64 GetHandPositionFrameVersion() const;
+
+  /* Registers a finger, thumb, pinch grab or palm grab recognizer of this hand, to be updated by
+   * this hand every tick right after its joints. Registered recognizers don't need UpdateState to
+   * be called on them. */
+  UFUNCTION(BlueprintCallable, Category = InteractionSDK)
+  bool RegisterHandPoseRecognizer(UObject* Recognizer);
+
+  /* Stops updating a recognizer registered with RegisterHandPoseRecognizer */
+  UFUNCTION(BlueprintCallable, Category = InteractionSDK)
+  void UnregisterHandPoseRecognizer(UObject* Recognizer);
+
   /* Returns the joints data source member variable (IsdkIHandJoints interface) */
   UFUNCTION(BlueprintPure, BlueprintInternalUseOnly, Category = InteractionSDK)
   TScriptInterface<IIsdkIHandJoints> GetJointsDataSource() const
@@ -154,6 +169,7 @@ class OCULUSINTERACTION_API UIsdkHandMeshComponent : public UPoseableMeshCompone
     ResetAllBoneTransforms();
     MappingState = EIsdkSkeletonMappingState::None;
     MappedSkeleton = nullptr;
+    PoseBatch.Reset();
   }
 
   /* Sets an override with a given HandPoseData, will start a lerp in (if enabled on the data) */
@@ -173,6 +189,18 @@ class OCULUSINTERACTION_API UIsdkHandMeshComponent : public UPoseableMeshCompone
   // Returns true if this hand mesh is ignoring root pose hand data
   bool IsRootPoseIgnored() const;
 
+  /**
+   * Writes the joint poses to the bones they are mapped to, in joint order. If override poses are
+   * given, every joint is blended from its source pose towards its override pose by OverrideAlpha.
+   * Bones keep their component space scale.
+   */
+  static void ApplyJointPoses(
+      FIsdkSkeletonPoseBatch& Batch,
+      TConstArrayView<int32> JointBoneIndices,
+      TConstArrayView<FTransform> SourcePoses,
+      TConstArrayView<FTransform> OverridePoses,
+      float OverrideAlpha);
+
  protected:
   /* Hand Pose is currently being overridden */
   UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = InteractionSDK)
@@ -188,6 +216,9 @@ class OCULUSINTERACTION_API UIsdkHandMeshComponent : public UPoseableMeshCompone
  private:
   int MappedBoneIndices[MappedBoneCount];
 
+  // Writes the mapped bones of the skeleton, set up with the mapping
+  FIsdkSkeletonPoseBatch PoseBatch;
+
   UPROPERTY(
       VisibleAnywhere,
       Transient,
@@ -209,6 +240,7 @@ class OCULUSINTERACTION_API UIsdkHandMeshComponent : public UPoseableMeshCompone
     MappedSkeleton = Skeleton;
   }
   void ResetAllBoneTransforms();
+  bool CanApplyPose() const;
 
   // If there are no bones with NAME_None, assume it is valid
   bool AreMappedBoneNamesValid() const
@@ -251,6 +283,8 @@ class OCULUSINTERACTION_API UIsdkHandMeshComponent : public UPoseableMeshCompone
 
   TPimplPtr<isdk::api::helper::FExternalHandPositionFrameImpl> ExternalHandPositionFrameImpl;
 
+  FIsdkHandPoseRecognizerScheduler HandPoseRecognizers;
+
   UPROPERTY()
   UIsdkHandPoseData* HandPoseDataOverride = nullptr;
 
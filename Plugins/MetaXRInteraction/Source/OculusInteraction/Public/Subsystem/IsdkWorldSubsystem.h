@@ -46,17 +46,14 @@ class FIsdkScaledTimeProviderImpl;
 namespace helper
 {
 class IEventQueueWrapper;
-class FUpdateEventQueueImpl;
-class FInteractableStateEventQueueImpl;
-class FInteractorStateEventQueueImpl;
-class FUpdateEventQueueImpl;
-class FPointerEventQueueImpl;
+class FIsdkEventBus;
 } // namespace helper
 } // namespace isdk::api
 typedef struct isdk_IPayload_ isdk_IPayload;
 typedef struct isdk_IInteractable_ isdk_IInteractable;
 
 class UIsdkInteractorComponent;
+class UIsdkGrabbableComponent;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FIsdkWorldFrameEventDelegate);
 
@@ -161,6 +158,18 @@ class OCULUSINTERACTION_API UIsdkWorldSubsystem : public UIsdkWorldSubsystemBase
       const isdk_IInteractable* InApiInteractable);
   void UnregisterInteractable(UIsdkInteractableComponent* InInteractable);
 
+  /**
+   * Grabbables are registered by their owning actor. Grabbers share this lookup to resolve an
+   * overlapped component to its grabbable, without searching the components of the actor.
+   */
+  void RegisterGrabbable(UIsdkGrabbableComponent* InGrabbable);
+  void UnregisterGrabbable(UIsdkGrabbableComponent* InGrabbable);
+  UIsdkGrabbableComponent* LookupGrabbable(const AActor* InActor) const
+  {
+    const auto FoundGrabbable = RegisteredGrabbablesLookup.Find(InActor);
+    return FoundGrabbable ? FoundGrabbable->Get() : nullptr;
+  }
+
   using ApiInteractableEventTargetFn = std::function<isdk::api::IInteractable*()>;
   EventHandlerToken RegisterInteractableStateEventHandler(
       UObject* Interactable,
@@ -205,103 +214,8 @@ class OCULUSINTERACTION_API UIsdkWorldSubsystem : public UIsdkWorldSubsystemBase
   UPROPERTY(BlueprintAssignable, Category = InteractionSDK)
   FIsdkWorldFrameEventDelegate FrameFinishedEventDelegate;
 
-  template <class TQueueImpl, typename TToken = EventHandlerToken>
-  class EventQueueWrapper
-  {
-   public:
-    using QueueUniquePtr = TPimplPtr<TQueueImpl>;
-
-    EventQueueWrapper(const WIDECHAR* InName) : Name(InName) {}
-
-    void BeginFrame()
-    {
-      for (const auto ElementId : PendingCreate)
-      {
-        const auto& Element = EventSubscriptions.FindChecked(ElementId);
-        if (Element.IsValid())
-        {
-          Element->CreateInstanceIfNotExists();
-        }
-      }
-      PendingCreate.Empty();
-
-      // If anything unsubscribed during a callback, now is when we process those removals.
-      ProcessPendingDeletes();
-    }
-
-    TToken RegisterEventHandler(QueueUniquePtr&& EventQueueImpl)
-    {
-      const EventHandlerToken EventId = NextEventId++;
-      EventSubscriptions.Add(EventId, MoveTemp(EventQueueImpl));
-      PendingCreate.Add(EventId);
-      return EventId;
-    }
-
-    void UnregisterEventHandler(const TToken Token)
-    {
-      if (Token != 0)
-      {
-        const QueueUniquePtr& Entry = EventSubscriptions.FindChecked(Token);
-        if (ensureMsgf(
-                Entry.IsValid(),
-                TEXT(
-                    "UIsdkWorldSubsystem::%s: Attempted to unregister an EventHandler that is not registered."),
-                Name))
-        {
-          PendingCreate.Remove(Token);
-          PendingDelete.Add(Token);
-        }
-      }
-    }
-
-    void ProcessPendingDeletes()
-    {
-      for (const auto Element : PendingDelete)
-      {
-        EventSubscriptions.Remove(Element);
-      }
-      PendingDelete.Empty();
-    }
-
-    void TryHandleEvents()
-    {
-      for (const auto& Element : EventSubscriptions)
-      {
-        Element.Value->TryHandleEvents();
-      }
-    }
-
-    void Reset()
-    {
-      PendingCreate.Empty();
-      ProcessPendingDeletes();
-
-      checkf(
-          EventSubscriptions.Num() == 0,
-          TEXT(
-              "UIsdkWorldSubsystem::%s: %d remaining, At least one ISDK object failed to call UnregisterPointerEventHandler"),
-          Name,
-          EventSubscriptions.Num());
-
-      EventSubscriptions.Empty();
-    }
-
-   private:
-    TMap<TToken, QueueUniquePtr> EventSubscriptions{};
-    TArray<TToken> PendingCreate{};
-    TArray<TToken> PendingDelete{};
-    TToken NextEventId{1};
-    const WIDECHAR* Name{};
-  };
-
-  EventQueueWrapper<isdk::api::helper::FPointerEventQueueImpl> PointerEventSubscriptions{
-      TEXT("PointerEventSubscriptions")};
-  EventQueueWrapper<isdk::api::helper::FInteractableStateEventQueueImpl>
-      InteractableStateEventSubscriptions{TEXT("InteractableStateEventSubscriptions")};
-  EventQueueWrapper<isdk::api::helper::FInteractorStateEventQueueImpl>
-      InteractorStateEventSubscriptions{TEXT("InteractorStateEventSubscriptions")};
-  EventQueueWrapper<isdk::api::helper::FUpdateEventQueueImpl> UpdateEventSubscriptions{
-      TEXT("UpdateEventSubscriptions")};
+  // Every event subscription of this world, drained once per frame in Tick
+  TPimplPtr<isdk::api::helper::FIsdkEventBus> EventBus;
 
   std::unordered_map<const isdk_IPayload*, TWeakObjectPtr<UIsdkInteractorComponent>>
       RegisteredInteractorPayloadsLookup{};
@@ -309,6 +223,7 @@ class OCULUSINTERACTION_API UIsdkWorldSubsystem : public UIsdkWorldSubsystemBase
       RegisteredInteractablesLookup{};
   TMap<UIsdkInteractableComponent*, const isdk_IInteractable*>
       RegisteredInteractablesLookupByValue{};
+  TMap<const AActor*, TWeakObjectPtr<UIsdkGrabbableComponent>> RegisteredGrabbablesLookup{};
 
   UPROPERTY()
   TArray<UIsdkInteractorComponent*> RegisteredInteractorPayloads{};
@@ -51,9 +51,20 @@ class OCULUSINTERACTION_API FIsdkMathUtils
       const TArray<TPair<FVector, float>>& Positions,
       int32 RansacIterations,
       float RansacScoreThreshold);
+  /* Ransac drawing its samples from the given stream, so the same seed gives the same result */
+  static FVector Ransac(
+      TConstArrayView<FVector> Positions,
+      TConstArrayView<float> Times,
+      int32 RansacIterations,
+      float RansacScoreThreshold,
+      FRandomStream& Random);
   static FVector LeastSquares(const TArray<TPair<FVector, float>>& Positions);
-  static FVector GetMean(const TArray<FVector>& Positions);
-  static FVector GetStandardDeviation(const TArray<FVector>& Positions, const FVector& Mean);
+  static FVector LeastSquares(TConstArrayView<FVector> Positions, TConstArrayView<float> Times);
+  static FVector GetMean(TConstArrayView<FVector> Positions);
+  static FVector GetStandardDeviation(TConstArrayView<FVector> Positions, const FVector& Mean);
+  /* Remove the samples whose z-score is above the threshold on any axis, keeping the order of the
+   * others. Axes without any deviation have no outliers. Returns the number of samples kept. */
+  static int32 FilterByZScore(TArray<FVector>& Positions, TArray<float>& Times, float Threshold);
   static FVector
   VelocityFromSamples(FVector Position1, float Time1, FVector Position2, float Time2);
   static void UpdateKalmanFilter(
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Fixed capacity history of timestamped samples. Once full, every new sample replaces the oldest
+ * one. Samples and timestamps are kept in separate arrays and neither adding samples nor reading
+ * a window of them allocates. */
+template <typename SampleType>
+class TIsdkSampleHistory
+{
+ public:
+  void Init(int32 InCapacity)
+  {
+    Samples.SetNum(FMath::Max(InCapacity, 0));
+    Times.SetNum(FMath::Max(InCapacity, 0));
+    Reset();
+  }
+
+  void Reset()
+  {
+    Head = 0;
+    Count = 0;
+  }
+
+  void Add(const SampleType& Sample, float Time)
+  {
+    if (Capacity() == 0)
+    {
+      return;
+    }
+
+    Samples[Head] = Sample;
+    Times[Head] = Time;
+    Head = (Head + 1) % Capacity();
+    Count = FMath::Min(Count + 1, Capacity());
+  }
+
+  int32 Num() const
+  {
+    return Count;
+  }
+
+  int32 Capacity() const
+  {
+    return Samples.Num();
+  }
+
+  bool IsEmpty() const
+  {
+    return Count == 0;
+  }
+
+  /* Samples are indexed from the oldest (0) to the newest (Num() - 1) */
+  const SampleType& GetSample(int32 Index) const
+  {
+    check(Index >= 0 && Index < Count);
+    return Samples[ToRingIndex(Index)];
+  }
+
+  float GetTime(int32 Index) const
+  {
+    check(Index >= 0 && Index < Count);
+    return Times[ToRingIndex(Index)];
+  }
+
+  const SampleType& GetNewestSample() const
+  {
+    return GetSample(Count - 1);
+  }
+
+  /* Copy the newest N samples, oldest first. The output arrays keep their allocations, so reusing
+   * them doesn't allocate once they grew to the capacity of the history. */
+  int32 CopyNewest(int32 N, TArray<SampleType>& OutSamples, TArray<float>& OutTimes) const
+  {
+    N = FMath::Clamp(N, 0, Count);
+    OutSamples.SetNumUninitialized(N, EAllowShrinking::No);
+    OutTimes.SetNumUninitialized(N, EAllowShrinking::No);
+    if (N == 0)
+    {
+      return 0;
+    }
+
+    // The window is at most two contiguous runs of the ring
+    const int32 Start = ToRingIndex(Count - N);
+    const int32 FirstRun = FMath::Min(N, Capacity() - Start);
+    for (int32 i = 0; i < FirstRun; i++)
+    {
+      OutSamples[i] = Samples[Start + i];
+      OutTimes[i] = Times[Start + i];
+    }
+    for (int32 i = FirstRun; i < N; i++)
+    {
+      OutSamples[i] = Samples[i - FirstRun];
+      OutTimes[i] = Times[i - FirstRun];
+    }
+    return N;
+  }
+
+ private:
+  int32 ToRingIndex(int32 Index) const
+  {
+    return (Head - Count + Index + Capacity()) % Capacity();
+  }
+
+  TArray<SampleType> Samples;
+  TArray<float> Times;
+  int32 Head = 0;
+  int32 Count = 0;
+};
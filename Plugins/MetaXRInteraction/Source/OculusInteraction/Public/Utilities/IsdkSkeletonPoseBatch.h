@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ * All rights reserved.
+ *
+ * Licensed under the Oculus SDK License Agreement (the "License");
+ * you may not use the Oculus SDK except in compliance with the License,
+ * which is provided at the time of installation or download, or which
+ * otherwise accompanies this software in either electronic or hard copy form.
+ *
+ * You may obtain a copy of the License at
+ *
+ * https://developer.oculus.com/licenses/oculussdk/
+ *
+ * Unless required by applicable law or agreed to in writing, the Oculus SDK
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Writes component space transforms into the local space pose of a skeleton, like
+ * UPoseableMeshComponent::SetBoneTransformByName does for a single bone. Component space
+ * transforms are kept between writes and only the bones below a written one are recomputed, instead
+ * of rebuilding the whole component space pose for every bone. Writing bones in any order gives the
+ * same pose as setting them one by one in that order. */
+class OCULUSINTERACTION_API FIsdkSkeletonPoseBatch
+{
+ public:
+  /* Parent index of every bone (INDEX_NONE for roots). Parents must come before their children,
+   * which is always true for a reference skeleton. */
+  void Initialize(TConstArrayView<int32> InParentIndices);
+  void Reset();
+
+  int32 GetNumBones() const
+  {
+    return ParentIndices.Num();
+  }
+
+  /* Start writing into the given pose, which must stay alive until End() */
+  void Begin(TArray<FTransform>& InBoneSpaceTransforms);
+  void End();
+
+  bool IsActive() const
+  {
+    return BoneSpaceTransforms != nullptr;
+  }
+
+  const FTransform& GetComponentSpaceTransform(int32 BoneIndex);
+  void SetComponentSpaceTransform(int32 BoneIndex, const FTransform& Transform);
+
+ private:
+  TArray<int32> ParentIndices;
+  TArray<FTransform>* BoneSpaceTransforms = nullptr;
+  TArray<FTransform> ComponentSpaceTransforms;
+  TBitArray<> ComponentSpaceValid;
+};
@@ -20,6 +20,9 @@
 
 #include "IsdkTestHandPoseDetection.h"
 #include "IsdkCommonTestCommands.h"
+#include "HandPoseDetection/IsdkHandFingerRecognizer.h"
+#include "HandPoseDetection/IsdkHandPalmGrabRecognizer.h"
+#include "HandPoseDetection/IsdkHandThumbRecognizer.h"
 #include "Misc/AutomationTest.h"
 
 // A generic test step that finds the AIsdkTestHandPoseDetectionActor test object, then passes it
@@ -177,3 +180,274 @@ bool IsdkRigPinchRecognizerTests::RunTest(const FString& Parameters)
 
   return true;
 }
+
+namespace
+{
+// Every finger and thumb calculation of the recognizers, a pinch grab for every finger and a palm
+// grab
+constexpr int32 NumFingerRecognizerConfigs = 16;
+constexpr int32 NumThumbRecognizerConfigs = 2;
+constexpr int32 NumPinchGrabRecognizerConfigs = 4;
+constexpr int32 NumHandPoseRecognizerConfigs =
+    NumFingerRecognizerConfigs + NumThumbRecognizerConfigs + NumPinchGrabRecognizerConfigs + 1;
+
+UObject* CreateHandPoseTestRecognizer(AIsdkTestHandPoseDetectionActor& TestActor, int32 Index)
+{
+  UIsdkHandMeshComponent* Hand = TestActor.TestTrackedHandVisual;
+  int32 Config = Index % NumHandPoseRecognizerConfigs;
+
+  // Every other round of configs has a transition time, so those can't skip unchanged frames
+  const float MinTimeToTransition = (Index / NumHandPoseRecognizerConfigs) % 2 == 0 ? 0.f : 0.1f;
+
+  if (Config < NumFingerRecognizerConfigs)
+  {
+    auto* Recognizer = NewObject<UIsdkHandFingerRecognizer>(&TestActor);
+    Recognizer->HandMesh = Hand;
+    Recognizer->FingerType = static_cast<EIsdkFingerType>(Config / 4);
+    Recognizer->CalcType = static_cast<EIsdkDetection_FingerCalcType>(Config % 4);
+    Recognizer->RangeParameters.MinTimeToTransition = MinTimeToTransition;
+    return Recognizer;
+  }
+  Config -= NumFingerRecognizerConfigs;
+
+  if (Config < NumThumbRecognizerConfigs)
+  {
+    auto* Recognizer = NewObject<UIsdkHandThumbRecognizer>(&TestActor);
+    Recognizer->HandMesh = Hand;
+    Recognizer->CalcType = static_cast<EIsdkDetection_ThumbCalcType>(Config);
+    Recognizer->RangeParameters.MinTimeToTransition = MinTimeToTransition;
+    return Recognizer;
+  }
+  Config -= NumThumbRecognizerConfigs;
+
+  if (Config < NumPinchGrabRecognizerConfigs)
+  {
+    auto* Recognizer = NewObject<UIsdkHandFingerPinchGrabRecognizer>(&TestActor);
+    Recognizer->HandVisual = Hand;
+    Recognizer->FingerType = static_cast<EIsdkFingerType>(Config);
+    return Recognizer;
+  }
+
+  auto* Recognizer = NewObject<UIsdkHandPalmGrabRecognizer>(&TestActor);
+  Recognizer->HandVisual = Hand;
+  return Recognizer;
+}
+
+void AddHandPoseTestRecognizers(AIsdkTestHandPoseDetectionActor& TestActor, int32 Num)
+{
+  for (int32 Index = 0; Index < Num; ++Index)
+  {
+    TestActor.DirectRecognizers.Add(CreateHandPoseTestRecognizer(TestActor, Index));
+
+    UObject* ScheduledRecognizer = CreateHandPoseTestRecognizer(TestActor, Index);
+    TestActor.ScheduledRecognizers.Add(ScheduledRecognizer);
+    TestActor.TestScheduler.Register(*TestActor.TestTrackedHandVisual, ScheduledRecognizer);
+  }
+}
+
+void UpdateHandPoseTestRecognizerDirectly(UObject* Recognizer, float DeltaTime)
+{
+  if (auto* DigitRecognizer = Cast<UIsdkHandDigitRecognizer>(Recognizer))
+  {
+    DigitRecognizer->UpdateState(DeltaTime);
+  }
+  else if (auto* PinchGrabRecognizer = Cast<UIsdkHandFingerPinchGrabRecognizer>(Recognizer))
+  {
+    PinchGrabRecognizer->UpdateState(DeltaTime);
+  }
+  else if (auto* PalmGrabRecognizer = Cast<UIsdkHandPalmGrabRecognizer>(Recognizer))
+  {
+    PalmGrabRecognizer->UpdateState(DeltaTime);
+  }
+}
+
+void UpdateDirectHandPoseTestRecognizers(
+    AIsdkTestHandPoseDetectionActor& TestActor,
+    float DeltaTime)
+{
+  for (UObject* Recognizer : TestActor.DirectRecognizers)
+  {
+    UpdateHandPoseTestRecognizerDirectly(Recognizer, DeltaTime);
+  }
+}
+
+int32 UpdateScheduledHandPoseTestRecognizers(
+    AIsdkTestHandPoseDetectionActor& TestActor,
+    float DeltaTime)
+{
+  return TestActor.TestScheduler.Update(*TestActor.TestTrackedHandVisual, DeltaTime);
+}
+
+void TestSameHandPoseRecognizerStates(
+    FAutomationTestBase* Test,
+    AIsdkTestHandPoseDetectionActor& TestActor,
+    const TCHAR* What)
+{
+  for (int32 Index = 0; Index < TestActor.DirectRecognizers.Num(); ++Index)
+  {
+    UObject* Expected = TestActor.DirectRecognizers[Index];
+    UObject* Actual = TestActor.ScheduledRecognizers[Index];
+    const FString Name = FString::Printf(TEXT("%s: %s"), What, *Expected->GetClass()->GetName());
+
+    if (auto* ExpectedDigit = Cast<UIsdkHandDigitRecognizer>(Expected))
+    {
+      auto* ActualDigit = CastChecked<UIsdkHandDigitRecognizer>(Actual);
+      Test->TestEqual(
+          *(Name + TEXT(" active")), ActualDigit->IsActive(), ExpectedDigit->IsActive());
+      Test->TestEqual(
+          *(Name + TEXT(" raw value")),
+          ActualDigit->GetNormalizedRawValue(),
+          ExpectedDigit->GetNormalizedRawValue(),
+          UE_KINDA_SMALL_NUMBER);
+    }
+    else if (auto* ExpectedPinchGrab = Cast<UIsdkHandFingerPinchGrabRecognizer>(Expected))
+    {
+      auto* ActualPinchGrab = CastChecked<UIsdkHandFingerPinchGrabRecognizer>(Actual);
+      Test->TestEqual(
+          *(Name + TEXT(" active")), ActualPinchGrab->IsActive(), ExpectedPinchGrab->IsActive());
+      Test->TestEqual(
+          *(Name + TEXT(" pinch strength")),
+          ActualPinchGrab->GetPinchStrength(),
+          ExpectedPinchGrab->GetPinchStrength(),
+          UE_KINDA_SMALL_NUMBER);
+    }
+    else if (auto* ExpectedPalmGrab = Cast<UIsdkHandPalmGrabRecognizer>(Expected))
+    {
+      auto* ActualPalmGrab = CastChecked<UIsdkHandPalmGrabRecognizer>(Actual);
+      Test->TestEqual(
+          *(Name + TEXT(" active")), ActualPalmGrab->IsActive(), ExpectedPalmGrab->IsActive());
+    }
+  }
+}
+} // namespace
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    IsdkHandPoseRecognizerSchedulerTests,
+    "InteractionSDK.OculusInteraction.Source.OculusInteractionEditor.Private.Tests.HandPose.IsdkHandPoseRecognizerScheduler",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool IsdkHandPoseRecognizerSchedulerTests::RunTest(const FString& Parameters)
+{
+  isdk::test::AddInitPieTestSteps(this);
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestSpawnHandPoseDetectionActor(this));
+  ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(isdk::test::OneFrameDelay));
+
+  // Each config once without and once with a transition time
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestHandPoseDetectionLambda(
+      this,
+      [](FAutomationTestBase* Test, AIsdkTestHandPoseDetectionActor& TestActor)
+      {
+        Test->TestNotNull(
+            TEXT("HandVisual.GetApiIHandPositionFrame() should succeed."),
+            TestActor.TestTrackedHandVisual->TryGetApiIHandPositionFrame());
+        AddHandPoseTestRecognizers(TestActor, NumHandPoseRecognizerConfigs * 2);
+
+        UpdateDirectHandPoseTestRecognizers(TestActor, 0.1f);
+        UpdateScheduledHandPoseTestRecognizers(TestActor, 0.1f);
+        TestSameHandPoseRecognizerStates(Test, TestActor, TEXT("Neutral pose"));
+      }));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestHandPoseDetectionLambda(
+      this,
+      [](FAutomationTestBase* Test, AIsdkTestHandPoseDetectionActor& TestActor)
+      { TestActor.TestDataSourceExternal->SetHandJointsToPinchPose(); }));
+  ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(isdk::test::OneFrameDelay));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestHandPoseDetectionLambda(
+      this,
+      [](FAutomationTestBase* Test, AIsdkTestHandPoseDetectionActor& TestActor)
+      {
+        UpdateDirectHandPoseTestRecognizers(TestActor, 0.1f);
+        UpdateScheduledHandPoseTestRecognizers(TestActor, 0.1f);
+        TestSameHandPoseRecognizerStates(Test, TestActor, TEXT("Pinch pose"));
+
+        // The hand didn't move since, so recognizers without a transition time are skipped
+        UpdateDirectHandPoseTestRecognizers(TestActor, 0.1f);
+        const int32 NumUpdated = UpdateScheduledHandPoseTestRecognizers(TestActor, 0.1f);
+        TestSameHandPoseRecognizerStates(Test, TestActor, TEXT("Unchanged pinch pose"));
+        Test->TestTrue(
+            TEXT("Recognizers that can't change should be skipped."),
+            NumUpdated < TestActor.TestScheduler.Num());
+        Test->TestTrue(
+            TEXT("Pinch grab recognizers should keep being updated."),
+            NumUpdated >= NumPinchGrabRecognizerConfigs * 2);
+      }));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestHandPoseDetectionLambda(
+      this,
+      [](FAutomationTestBase* Test, AIsdkTestHandPoseDetectionActor& TestActor)
+      { TestActor.TestDataSourceExternal->SetHandJointsToNeutralPose(); }));
+  ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(isdk::test::OneFrameDelay));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestHandPoseDetectionLambda(
+      this,
+      [](FAutomationTestBase* Test, AIsdkTestHandPoseDetectionActor& TestActor)
+      {
+        UpdateDirectHandPoseTestRecognizers(TestActor, 0.1f);
+        UpdateScheduledHandPoseTestRecognizers(TestActor, 0.1f);
+        TestSameHandPoseRecognizerStates(Test, TestActor, TEXT("Back to neutral pose"));
+      }));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand);
+
+  return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+    IsdkHandPoseRecognizerBenchmark,
+    "InteractionSDK.OculusInteraction.Source.OculusInteractionEditor.Private.Tests.HandPose.IsdkHandPoseRecognizerBenchmark",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool IsdkHandPoseRecognizerBenchmark::RunTest(const FString& Parameters)
+{
+  isdk::test::AddInitPieTestSteps(this);
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestSpawnHandPoseDetectionActor(this));
+  ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(isdk::test::OneFrameDelay));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FIsdkTestHandPoseDetectionLambda(
+      this,
+      [](FAutomationTestBase* Test, AIsdkTestHandPoseDetectionActor& TestActor)
+      {
+        constexpr int32 NumRecognizers = 50;
+        constexpr int32 NumUpdates = 1000;
+        constexpr float DeltaTime = 1.f / 72.f;
+
+        TestActor.TestTrackedHandVisual->TryGetApiIHandPositionFrame();
+        AddHandPoseTestRecognizers(TestActor, NumRecognizers);
+
+        // Creates the API instances, so they aren't part of the timings
+        UpdateDirectHandPoseTestRecognizers(TestActor, DeltaTime);
+        UpdateScheduledHandPoseTestRecognizers(TestActor, DeltaTime);
+
+        uint64 StartCycles = FPlatformTime::Cycles64();
+        for (int32 Update = 0; Update < NumUpdates; ++Update)
+        {
+          UpdateDirectHandPoseTestRecognizers(TestActor, DeltaTime);
+        }
+        const uint64 DirectCycles = FPlatformTime::Cycles64() - StartCycles;
+
+        int32 NumUpdated = 0;
+        StartCycles = FPlatformTime::Cycles64();
+        for (int32 Update = 0; Update < NumUpdates; ++Update)
+        {
+          NumUpdated = UpdateScheduledHandPoseTestRecognizers(TestActor, DeltaTime);
+        }
+        const uint64 ScheduledCycles = FPlatformTime::Cycles64() - StartCycles;
+
+        Test->AddInfo(FString::Printf(
+            TEXT("%d recognizers per hand: one by one %.2f us, scheduled %.2f us per update "
+                 "(%d updated, the rest skipped)"),
+            NumRecognizers,
+            FPlatformTime::ToMilliseconds64(DirectCycles) * 1000.0 / NumUpdates,
+            FPlatformTime::ToMilliseconds64(ScheduledCycles) * 1000.0 / NumUpdates,
+            NumUpdated));
+
+        TestSameHandPoseRecognizerStates(Test, TestActor, TEXT("After benchmark"));
+      }));
+
+  ADD_LATENT_AUTOMATION_COMMAND(FEndPlayMapCommand);
+
+  return true;
+}
@@ -27,6 +27,7 @@
 #include "DataSources/IsdkExternalHandDataSource.h"
 #include "DataSources/IsdkOneEuroFilterDataModifier.h"
 #include "HandPoseDetection/IsdkHandFingerPinchGrabRecognizer.h"
+#include "HandPoseDetection/IsdkHandPoseRecognizerScheduler.h"
 
 #include "UObject/ConstructorHelpers.h"
 #include "Engine/SkeletalMesh.h"
@@ -49,6 +50,16 @@ class OCULUSINTERACTIONEDITOR_API AIsdkTestHandPoseDetectionActor : public AActo
   UPROPERTY()
   UIsdkHandFingerPinchGrabRecognizer* TestFingerPinchGrabRecognizer{};
 
+  // Recognizers updated one by one through UpdateState
+  UPROPERTY()
+  TArray<UObject*> DirectRecognizers;
+
+  // The same recognizers as DirectRecognizers, updated through TestScheduler instead
+  UPROPERTY()
+  TArray<UObject*> ScheduledRecognizers;
+
+  FIsdkHandPoseRecognizerScheduler TestScheduler;
+
   AIsdkTestHandPoseDetectionActor()
   {
     const auto Root = CreateDefaultSubobject<USceneComponent>(FName("Root"));
@@ -25,7 +25,6 @@
 #include "Interaction/IsdkGrabberComponent.h"
 #include "HandPoseDetection/IsdkHandFingerPinchGrabRecognizer.h"
 #include "HandPoseDetection/IsdkHandPalmGrabRecognizer.h"
-#include "Kismet/KismetMathLibrary.h"
 
 // Sets default values for this component's properties
 UIsdkGrabInteractionRigComponent::UIsdkGrabInteractionRigComponent()
@@ -58,6 +57,13 @@ void UIsdkGrabInteractionRigComponent::InitializeComponent()
       this, [this](bool bIsEnabled) { HandleIsEnabledConditionalChanged(bIsEnabled); });
 }
 
+void UIsdkGrabInteractionRigComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+  UnregisterGrabRecognizers();
+
+  Super::EndPlay(EndPlayReason);
+}
+
 void UIsdkGrabInteractionRigComponent::TickComponent(
     float DeltaTime,
     ELevelTick TickType,
@@ -65,36 +71,7 @@ void UIsdkGrabInteractionRigComponent::TickComponent(
 {
   Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-  // Tick the pinch grab recognizer
-  if (IsValid(PinchGrabRecognizer))
-  {
-    // Update the pinch grab recognizer's wrist forward vector
-    if (IsValid(HandRootPose.GetObject()))
-    {
-      PinchGrabRecognizer->CurrentWristForward = UKismetMathLibrary::GetForwardVector(
-          IIsdkIRootPose::Execute_GetRootPose(HandRootPose.GetObject()).GetRotation().Rotator());
-    }
-
-    // Update the pinch grab recognizer's hmd forward vector
-    if (IsValid(HmdDataSource.GetObject()))
-    {
-      FTransform HmdPose;
-      bool bIsTracked;
-      IIsdkIHmdDataSource::Execute_GetHmdPose(HmdDataSource.GetObject(), HmdPose, bIsTracked);
-      PinchGrabRecognizer->CurrentHMDForward =
-          UKismetMathLibrary::GetForwardVector(HmdPose.GetRotation().Rotator());
-    }
-
-    PinchGrabRecognizer->UpdateState(DeltaTime);
-  }
-
-  // Tick the palm grab recognizer
-  if (IsValid(PalmGrabRecognizer))
-  {
-    PalmGrabRecognizer->UpdateState(DeltaTime);
-  }
-
-  // Handle changes to grab state
+  // Handle changes to grab state, the grab recognizers were updated by the hand visual before us
   if (Grabber->bIsGrabbing != bLastIsGrabbing)
   {
     UpdatePinchCollidersAttachment();
@@ -138,6 +115,13 @@ void UIsdkGrabInteractionRigComponent::BindDataSources(
   {
     HmdDataSource = HmdDataSourceIn;
   }
+
+  // The pinch grab recognizer reads its wrist and HMD forward vectors whenever it's updated
+  if (ensure(PinchGrabRecognizer))
+  {
+    PinchGrabRecognizer->WristRootPose = HandRootPose;
+    PinchGrabRecognizer->HmdDataSource = HmdDataSource;
+  }
 }
 
 void UIsdkGrabInteractionRigComponent::BindControllerGrabInput(
@@ -188,13 +172,16 @@ void UIsdkGrabInteractionRigComponent::BindHandGrabInput(
     EIsdkFingerType FingerType,
     const FName& InThumbTipSocketName)
 {
+  // The recognizers are updated by the hand they recognize, stop the previous one from doing so
+  UnregisterGrabRecognizers();
+  if (IsValid(SyntheticHandVisual))
+  {
+    AddTickPrerequisiteComponent(SyntheticHandVisual);
+  }
+
   // Bind to grab action
   if (ensure(PinchGrabRecognizer))
   {
-    if (IsValid(SyntheticHandVisual))
-    {
-      AddTickPrerequisiteComponent(SyntheticHandVisual);
-    }
     PinchGrabRecognizer->HandVisual = SyntheticHandVisual;
     PinchGrabRecognizer->FingerType = FingerType;
     PinchGrabRecognizer->PinchGrabStarted.AddUniqueDynamic(
@@ -212,9 +199,27 @@ void UIsdkGrabInteractionRigComponent::BindHandGrabInput(
         Grabber, &UIsdkGrabberComponent::UnselectPalm);
   }
 
+  if (IsValid(SyntheticHandVisual))
+  {
+    SyntheticHandVisual->RegisterHandPoseRecognizer(PinchGrabRecognizer);
+    SyntheticHandVisual->RegisterHandPoseRecognizer(PalmGrabRecognizer);
+  }
+
   UpdatePinchCollidersAttachment();
 }
 
+void UIsdkGrabInteractionRigComponent::UnregisterGrabRecognizers()
+{
+  if (IsValid(PinchGrabRecognizer) && IsValid(PinchGrabRecognizer->HandVisual))
+  {
+    PinchGrabRecognizer->HandVisual->UnregisterHandPoseRecognizer(PinchGrabRecognizer);
+  }
+  if (IsValid(PalmGrabRecognizer) && IsValid(PalmGrabRecognizer->HandVisual))
+  {
+    PalmGrabRecognizer->HandVisual->UnregisterHandPoseRecognizer(PalmGrabRecognizer);
+  }
+}
+
 void UIsdkGrabInteractionRigComponent::UpdateMeshDependencies(
     const FVector& PalmColliderOffset,
     USkinnedMeshComponent* InPinchAttachMesh,
@@ -48,6 +48,7 @@ class OCULUSINTERACTIONPREBUILTS_API UIsdkGrabInteractionRigComponent : public U
   UIsdkGrabInteractionRigComponent();
 
   virtual void InitializeComponent() override;
+  virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
   virtual void TickComponent(
       float DeltaTime,
@@ -119,6 +120,9 @@ class OCULUSINTERACTIONPREBUILTS_API UIsdkGrabInteractionRigComponent : public U
    */
   void UpdatePinchCollidersAttachment();
 
+  // Stops the hand the grab recognizers were bound to from updating them
+  void UnregisterGrabRecognizers();
+
   UFUNCTION()
   void HandleIsEnabledConditionalChanged(bool bIsEnabled);
 
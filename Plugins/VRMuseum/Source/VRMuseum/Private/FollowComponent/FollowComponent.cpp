@@ -6,243 +6,101 @@
 #include "Engine/World.h"
 #include "Kismet/GameplayStatics.h"
 
+#include "FollowComponent/FollowSubsystem.h"
 #include "Utils/VRMuseumFunctionLibrary.h"
 
-namespace
+UFollowComponent::UFollowComponent()
 {
-	float SimplifyAngle(float Angle)
-	{
-		while (Angle > PI)
-		{
-			Angle -= 2 * PI;
-		}
-
-		while (Angle < -PI)
-		{
-			Angle += 2 * PI;
-		}
-
-		return Angle;
-	}
-
-	float AngleBetweenOnPlane(FVector From, FVector To, FVector Normal)
-	{
-		From.Normalize();
-		To.Normalize();
-		Normal.Normalize();
-
-		FVector Right = FVector::CrossProduct(Normal, From);
-		FVector Forward = FVector::CrossProduct(Right, Normal);
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	bAutoActivate = true;
+}
 
-		float Angle = FMath::Atan2(FVector::DotProduct(To, Right), FVector::DotProduct(To, Forward));
+void UFollowComponent::BeginPlay()
+{
+	Super::BeginPlay();
 
-		return SimplifyAngle(Angle);
-	}
+	Recenter();
 
-	float AngleBetweenVectorAndPlane(FVector Vec, FVector Normal)
-	{
-		Vec.Normalize();
-		Normal.Normalize();
-		return (PI / 2) - FMath::Acos(FVector::DotProduct(Vec, Normal));
-	}
+	FollowState.WorkingTransform = GetOwner() ? GetOwner()->GetTransform() : FTransform::Identity;
 
-	bool AngularClamp(
-		FTransform FollowTransform, bool bIgnoreVertical, float MaxHorizontalDegrees, float MaxVerticalDegrees, FVector& CurrentToTarget)
+	if (bAutoActivate)
 	{
-		if (CurrentToTarget.Size() <= 0)
-		{
-			// No need to clamp
-			return false;
-		}
-
-		// This is the meat of the leashing algorithm. The goal is to ensure that the reference's forward
-		// vector remains within the bounds set by the leashing parameters. To do this, determine the angles
-		// between toTarget and the leashing bounds about the global Z axis and the reference's X axis.
-		// If toTarget falls within the leashing bounds, then we don't have to modify it.
-		// Otherwise, we apply a correction rotation to bring it within bounds.
-
-		FVector FollowForward = FollowTransform.GetUnitAxis(EAxis::X);
-		FVector FollowRight = FollowTransform.GetUnitAxis(EAxis::Y);
-
-		bool bAngularClamped = false;
-
-		// X-axis leashing
-		// Leashing around the reference's X axis only makes sense if the reference isn't gravity aligned.
-		if (bIgnoreVertical)
-		{
-			float Angle = AngleBetweenOnPlane(CurrentToTarget, FollowForward, FollowRight);
-			CurrentToTarget = FQuat(FollowRight, Angle) * CurrentToTarget;
-		}
-		else
-		{
-			// These are negated because Unreal is left-handed
-			float Angle = -AngleBetweenOnPlane(CurrentToTarget, FollowForward, FollowRight);
-			float MinMaxAngle = FMath::DegreesToRadians(MaxVerticalDegrees) * 0.5f;
-
-			if (Angle < -MinMaxAngle)
-			{
-				CurrentToTarget = FQuat(FollowRight, -MinMaxAngle - Angle) * CurrentToTarget;
-				bAngularClamped = true;
-			}
-			else if (Angle > MinMaxAngle)
-			{
-				CurrentToTarget = FQuat(FollowRight, MinMaxAngle - Angle) * CurrentToTarget;
-				bAngularClamped = true;
-			}
-		}
-
-		// Z-axis leashing
-		{
-			float Angle = AngleBetweenVectorAndPlane(CurrentToTarget, FollowRight);
-			float MinMaxAngle = FMath::DegreesToRadians(MaxHorizontalDegrees) * 0.5f;
-
-			if (Angle < -MinMaxAngle)
-			{
-				CurrentToTarget = FQuat(FVector::UpVector, -MinMaxAngle - Angle) * CurrentToTarget;
-				bAngularClamped = true;
-			}
-			else if (Angle > MinMaxAngle)
-			{
-				CurrentToTarget = FQuat(FVector::UpVector, MinMaxAngle - Angle) * CurrentToTarget;
-				bAngularClamped = true;
-			}
-		}
-
-		return bAngularClamped;
+		UpdateLeashing();
+		UpdateTransformToGoal(true);
 	}
 
-	bool DistanceClamp(
-		FTransform FollowTransform, bool bMoveToDefault, bool bIgnorePitch, float MinDistance, float DefaultDistance, float MaxDistance,
-		FVector& CurrentToTarget)
+	if (bBatchedUpdate)
 	{
-		FVector GoalDirection = CurrentToTarget;
-		GoalDirection.Normalize();
-
-		float CurrentDistance = CurrentToTarget.Size();
-
-		if (bIgnorePitch)
+		if (UFollowSubsystem* FollowSubsystem = GetWorld()->GetSubsystem<UFollowSubsystem>())
 		{
-			// If we don't account for pitch offset, the casted object will float up/down as the reference
-			// gets closer to it because we will still be casting in the direction of the pitched offset.
-			// To fix this, only modify the XZ position of the object.
-
-			MinDistance = GoalDirection.Size2D() * MinDistance;
-			MaxDistance = GoalDirection.Size2D() * MaxDistance;
-
-			float CurrentDistance2D = CurrentToTarget.Size2D();
-
-			// scale goal direction so scalar multiplication works with 2D distances
-			GoalDirection *= (CurrentDistance / CurrentDistance2D);
-
-			CurrentDistance = CurrentDistance2D;
-		}
-
-		float ClampedDistance = CurrentDistance;
-
-		if (bMoveToDefault)
-		{
-			if (CurrentDistance < MinDistance || CurrentDistance > MaxDistance)
-			{
-				ClampedDistance = DefaultDistance;
-			}
+			SetComponentTickEnabled(false);
+			FollowSubsystem->Register(this);
 		}
 		else
 		{
-			ClampedDistance = FMath::Clamp(CurrentDistance, MinDistance, MaxDistance);
-		}
-
-		CurrentToTarget = GoalDirection * ClampedDistance;
-
-		return CurrentDistance != ClampedDistance;
-	}
-
-	void ApplyVerticalClamp(float MaxVerticalDistance, FVector& CurrentToTarget)
-	{
-		if (MaxVerticalDistance != 0)
-		{
-			CurrentToTarget.Z = FMath::Clamp(CurrentToTarget.Z, -MaxVerticalDistance, MaxVerticalDistance);
+			bBatchedUpdate = false;
 		}
 	}
+}
 
-	void ComputeOrientation(
-		EFollowOrientBehavior OrientationType, FVector FollowPosition, FVector CurrentToTarget, FQuat& CurrentRotation)
+void UFollowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
 	{
-		switch (OrientationType)
+		if (UFollowSubsystem* FollowSubsystem = World->GetSubsystem<UFollowSubsystem>())
 		{
-		case EFollowOrientBehavior::FaceCamera:
-			CurrentRotation = (-CurrentToTarget).ToOrientationQuat();
-			break;
-		default:
-			break;
+			FollowSubsystem->Unregister(this);
 		}
 	}
 
-	void ApplyPitchOffset(const float PitchOffset, FTransform& FollowTransform)
-	{
-		FVector Forward = FollowTransform.GetUnitAxis(EAxis::X);
-		Forward.Z = 0;
-		FVector Left = FollowTransform.GetUnitAxis(EAxis::Y);
-		Forward = FQuat(Left, FMath::DegreesToRadians(PitchOffset)) * Forward;
-		FollowTransform.SetRotation(Forward.ToOrientationQuat());
-	}
-
-	FVector SmoothTo(FVector Source, FVector Goal, float DeltaTime, float LerpTime)
-	{
-		return UVRMuseumFunctionLibrary::Slerp(Source, Goal, LerpTime == 0.0f ? 1.0f : DeltaTime / LerpTime);
-	}
-
-	FQuat SmoothTo(FQuat Source, FQuat Goal, float DeltaTime, float LerpTime)
-	{
-		return FQuat::Slerp(Source, Goal, LerpTime == 0.0f ? 1.0f : DeltaTime / LerpTime);
-	}
-
-	bool PassedOrientationDeadzone(FVector CurrentToTarget, FQuat CurrentRotation, FVector FollowPosition, float DeadzoneDegrees)
-	{
-		// We don't flip the actor to face the user so the BackwardVector is the one that is facing the user.
-		FVector LeashForward = CurrentRotation * FVector::BackwardVector;
-
-		FVector LeashToFollow = CurrentToTarget;
-		LeashToFollow.Normalize();
-
-		float Angle = FMath::Abs(AngleBetweenOnPlane(LeashForward, LeashToFollow, FVector::UpVector));
-
-		return FMath::RadiansToDegrees(Angle) > DeadzoneDegrees;
-	}
-} // namespace
-
-UFollowComponent::UFollowComponent()
-{
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = false;
-	bAutoActivate = true;
+	Super::EndPlay(EndPlayReason);
 }
 
-void UFollowComponent::BeginPlay()
+void UFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
-	Super::BeginPlay();
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	Recenter();
+	UpdateLeashing();
+	UpdateTransformToGoal(!bInterpolatePose, DeltaTime);
+}
 
-	WorkingTransform = GetOwner() ? GetOwner()->GetTransform() : FTransform::Identity;
+void UFollowComponent::Activate(bool bReset)
+{
+	Super::Activate(bReset);
 
-	if (bAutoActivate)
+	// Activating enables the tick, but batched components are updated by the follow subsystem
+	if (bBatchedUpdate && HasBegunPlay())
 	{
-		UpdateLeashing();
-		UpdateTransformToGoal(true);
+		SetComponentTickEnabled(false);
 	}
 }
 
-void UFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UFollowComponent::Recenter()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	UpdateLeashing();
-	UpdateTransformToGoal(!bInterpolatePose, DeltaTime);
+	FollowState.bRecenterNextUpdate = true;
 }
 
-void UFollowComponent::Recenter()
+FollowMath::FFollowSettings UFollowComponent::MakeFollowSettings() const
 {
-	bRecenterNextUpdate = true;
+	FollowMath::FFollowSettings Settings;
+	Settings.bFaceCamera = OrientationType == EFollowOrientBehavior::FaceCamera;
+	Settings.OrientToCameraDeadzoneDegrees = OrientToCameraDeadzoneDegrees;
+	Settings.bIgnoreDistanceClamp = bIgnoreDistanceClamp;
+	Settings.MinimumDistance = MinimumDistance;
+	Settings.MaximumDistance = MaximumDistance;
+	Settings.DefaultDistance = DefaultDistance;
+	Settings.VerticalMaxDistance = VerticalMaxDistance;
+	Settings.bUseFixedVerticalOffset = bUseFixedVerticalOffset;
+	Settings.FixedVerticalOffset = FixedVerticalOffset;
+	Settings.bIgnoreAngleClamp = bIgnoreAngleClamp;
+	Settings.MaxViewHorizontalDegrees = MaxViewHorizontalDegrees;
+	Settings.MaxViewVerticalDegrees = MaxViewVerticalDegrees;
+	Settings.bIgnoreCameraPitchAndRoll = bIgnoreCameraPitchAndRoll;
+	Settings.PitchOffset = PitchOffset;
+	Settings.bInterpolatePose = bInterpolatePose;
+	Settings.LerpTime = LerpTime;
+	return Settings;
 }
 
 FTransform UFollowComponent::GetFollowTransform()
@@ -257,87 +115,16 @@ FTransform UFollowComponent::GetFollowTransform()
 
 void UFollowComponent::UpdateLeashing()
 {
-	FTransform FollowTransform = GetFollowTransform();
-
-	FVector FollowPosition = FollowTransform.GetLocation();
-
-	if (bIgnoreCameraPitchAndRoll && !bUseFixedVerticalOffset)
-	{
-		ApplyPitchOffset(PitchOffset, FollowTransform);
-	}
-
-	// Update starting goal leash values
-	ToTarget = WorkingTransform.GetLocation() - FollowTransform.GetLocation();
-	TargetRotation = WorkingTransform.GetRotation();
-
-	// Determine the current position of the element
-	bool bAngularClamped = false;
-	if (bRecenterNextUpdate)
-	{
-		ToTarget = FollowTransform.GetUnitAxis(EAxis::X) * DefaultDistance;
-		bRecenterNextUpdate = false;
-	}
-	// Angularly clamp to determine goal direction to place the element
-	else
-	{
-		if (bIgnoreAngleClamp)
-		{
-			float CurrentDistance = ToTarget.Size();
-			ToTarget = FollowTransform.GetUnitAxis(EAxis::X) * CurrentDistance;
-		}
-		else
-		{
-			bAngularClamped =
-				AngularClamp(FollowTransform, bIgnoreCameraPitchAndRoll, MaxViewHorizontalDegrees, MaxViewVerticalDegrees, ToTarget);
-		}
-	}
-
-	// Distance clamp to determine goal position to place the element
-	bool bDistanceClamped = false;
-	if (!bIgnoreDistanceClamp)
-	{
-		bDistanceClamped = DistanceClamp(
-			FollowTransform, bAngularClamped, bIgnoreCameraPitchAndRoll, MinimumDistance, DefaultDistance, MaximumDistance, ToTarget);
-		ApplyVerticalClamp(VerticalMaxDistance, ToTarget);
-	}
-
-	if (bUseFixedVerticalOffset)
-	{
-		ToTarget.Z = (FollowPosition.Z + FixedVerticalOffset) - WorkingTransform.GetLocation().Z;
-	}
-
-	// Figure out goal rotation of the element based on orientation setting
-	FQuat NewGoalRotation = FQuat::Identity;
-	EFollowOrientBehavior OrientationBehavior = OrientationType;
-	if (bAngularClamped || bDistanceClamped || OrientationType == EFollowOrientBehavior::FaceCamera ||
-		PassedOrientationDeadzone(ToTarget, TargetRotation, FollowTransform.GetLocation(), OrientToCameraDeadzoneDegrees))
-	{
-		OrientationBehavior = EFollowOrientBehavior::FaceCamera;
-	}
-
-	ComputeOrientation(OrientationBehavior, FollowTransform.GetLocation(), ToTarget, TargetRotation);
+	FollowMath::UpdateLeashing(MakeFollowSettings(), GetFollowTransform(), FollowState);
 }
 
 void UFollowComponent::UpdateTransformToGoal(bool bSkipInterpolation, float DeltaTime)
 {
 	if (GetOwner())
 	{
-		FVector FollowPosition = GetFollowTransform().GetLocation();
-
-		if (bSkipInterpolation)
-		{
-			WorkingTransform.SetLocation(FollowPosition + ToTarget);
-			WorkingTransform.SetRotation(TargetRotation);
-		}
-		else
-		{
-			FVector CurrentPosition = GetOwner()->GetTransform().GetLocation();
-			FVector CurrentDirection = CurrentPosition - FollowPosition;
-			FQuat CurrentRotation = GetOwner()->GetTransform().GetRotation();
-			WorkingTransform.SetLocation(FollowPosition + SmoothTo(CurrentDirection, ToTarget, DeltaTime, LerpTime));
-			WorkingTransform.SetRotation(SmoothTo(CurrentRotation, TargetRotation, DeltaTime, LerpTime));
-		}
+		FollowMath::UpdateTransformToGoal(
+			MakeFollowSettings(), GetFollowTransform().GetLocation(), GetOwner()->GetTransform(), bSkipInterpolation, DeltaTime, FollowState);
 
-		GetOwner()->SetActorTransform(WorkingTransform, false);
+		GetOwner()->SetActorTransform(FollowState.WorkingTransform, false);
 	}
 }
@@ -0,0 +1,313 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FollowComponent/FollowMath.h"
+
+namespace
+{
+	float SimplifyAngle(float Angle)
+	{
+		// Only called with results of Atan2, which are at most one turn away from the range
+		if (Angle > PI)
+		{
+			return Angle - 2 * PI;
+		}
+		if (Angle < -PI)
+		{
+			return Angle + 2 * PI;
+		}
+		return Angle;
+	}
+
+	float AngleBetweenOnPlane(FVector From, FVector To, FVector Normal)
+	{
+		From.Normalize();
+		To.Normalize();
+		Normal.Normalize();
+
+		FVector Right = FVector::CrossProduct(Normal, From);
+		FVector Forward = FVector::CrossProduct(Right, Normal);
+
+		float Angle = FMath::Atan2(FVector::DotProduct(To, Right), FVector::DotProduct(To, Forward));
+
+		return SimplifyAngle(Angle);
+	}
+
+	float AngleBetweenVectorAndPlane(FVector Vec, FVector Normal)
+	{
+		Vec.Normalize();
+		Normal.Normalize();
+		return (PI / 2) - FMath::Acos(FVector::DotProduct(Vec, Normal));
+	}
+
+	bool AngularClamp(
+		const FTransform& FollowTransform, bool bIgnoreVertical, float MaxHorizontalDegrees, float MaxVerticalDegrees, FVector& CurrentToTarget)
+	{
+		if (CurrentToTarget.Size() <= 0)
+		{
+			// No need to clamp
+			return false;
+		}
+
+		// This is the meat of the leashing algorithm. The goal is to ensure that the reference's forward
+		// vector remains within the bounds set by the leashing parameters. To do this, determine the angles
+		// between toTarget and the leashing bounds about the global Z axis and the reference's X axis.
+		// If toTarget falls within the leashing bounds, then we don't have to modify it.
+		// Otherwise, we apply a correction rotation to bring it within bounds.
+
+		FVector FollowForward = FollowTransform.GetUnitAxis(EAxis::X);
+		FVector FollowRight = FollowTransform.GetUnitAxis(EAxis::Y);
+
+		bool bAngularClamped = false;
+
+		// X-axis leashing
+		// Leashing around the reference's X axis only makes sense if the reference isn't gravity aligned.
+		if (bIgnoreVertical)
+		{
+			float Angle = AngleBetweenOnPlane(CurrentToTarget, FollowForward, FollowRight);
+			CurrentToTarget = FQuat(FollowRight, Angle) * CurrentToTarget;
+		}
+		else
+		{
+			// These are negated because Unreal is left-handed
+			float Angle = -AngleBetweenOnPlane(CurrentToTarget, FollowForward, FollowRight);
+			float MinMaxAngle = FMath::DegreesToRadians(MaxVerticalDegrees) * 0.5f;
+
+			if (Angle < -MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FollowRight, -MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+			else if (Angle > MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FollowRight, MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+		}
+
+		// Z-axis leashing
+		{
+			float Angle = AngleBetweenVectorAndPlane(CurrentToTarget, FollowRight);
+			float MinMaxAngle = FMath::DegreesToRadians(MaxHorizontalDegrees) * 0.5f;
+
+			if (Angle < -MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FVector::UpVector, -MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+			else if (Angle > MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FVector::UpVector, MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+		}
+
+		return bAngularClamped;
+	}
+
+	bool DistanceClamp(
+		bool bMoveToDefault, bool bIgnorePitch, float MinDistance, float DefaultDistance, float MaxDistance, FVector& CurrentToTarget)
+	{
+		FVector GoalDirection = CurrentToTarget;
+		GoalDirection.Normalize();
+
+		float CurrentDistance = CurrentToTarget.Size();
+
+		if (bIgnorePitch)
+		{
+			// If we don't account for pitch offset, the casted object will float up/down as the reference
+			// gets closer to it because we will still be casting in the direction of the pitched offset.
+			// To fix this, only modify the XZ position of the object.
+
+			MinDistance = GoalDirection.Size2D() * MinDistance;
+			MaxDistance = GoalDirection.Size2D() * MaxDistance;
+
+			float CurrentDistance2D = CurrentToTarget.Size2D();
+
+			// scale goal direction so scalar multiplication works with 2D distances
+			GoalDirection *= (CurrentDistance / CurrentDistance2D);
+
+			CurrentDistance = CurrentDistance2D;
+		}
+
+		float ClampedDistance = CurrentDistance;
+
+		if (bMoveToDefault)
+		{
+			if (CurrentDistance < MinDistance || CurrentDistance > MaxDistance)
+			{
+				ClampedDistance = DefaultDistance;
+			}
+		}
+		else
+		{
+			ClampedDistance = FMath::Clamp(CurrentDistance, MinDistance, MaxDistance);
+		}
+
+		CurrentToTarget = GoalDirection * ClampedDistance;
+
+		return CurrentDistance != ClampedDistance;
+	}
+
+	void ApplyVerticalClamp(float MaxVerticalDistance, FVector& CurrentToTarget)
+	{
+		if (MaxVerticalDistance != 0)
+		{
+			CurrentToTarget.Z = FMath::Clamp(CurrentToTarget.Z, -MaxVerticalDistance, MaxVerticalDistance);
+		}
+	}
+
+	void ApplyPitchOffset(const float PitchOffset, FTransform& FollowTransform)
+	{
+		FVector Forward = FollowTransform.GetUnitAxis(EAxis::X);
+		Forward.Z = 0;
+		FVector Left = FollowTransform.GetUnitAxis(EAxis::Y);
+		Forward = FQuat(Left, FMath::DegreesToRadians(PitchOffset)) * Forward;
+		FollowTransform.SetRotation(Forward.ToOrientationQuat());
+	}
+
+	FVector SmoothTo(FVector Source, FVector Goal, float DeltaTime, float LerpTime)
+	{
+		return FollowMath::Slerp(Source, Goal, LerpTime == 0.0f ? 1.0f : DeltaTime / LerpTime);
+	}
+
+	FQuat SmoothTo(FQuat Source, FQuat Goal, float DeltaTime, float LerpTime)
+	{
+		return FQuat::Slerp(Source, Goal, LerpTime == 0.0f ? 1.0f : DeltaTime / LerpTime);
+	}
+
+	bool PassedOrientationDeadzone(FVector CurrentToTarget, FQuat CurrentRotation, float DeadzoneDegrees)
+	{
+		// We don't flip the actor to face the user so the BackwardVector is the one that is facing the user.
+		FVector LeashForward = CurrentRotation * FVector::BackwardVector;
+
+		FVector LeashToFollow = CurrentToTarget;
+		LeashToFollow.Normalize();
+
+		float Angle = FMath::Abs(AngleBetweenOnPlane(LeashForward, LeashToFollow, FVector::UpVector));
+
+		return FMath::RadiansToDegrees(Angle) > DeadzoneDegrees;
+	}
+} // namespace
+
+namespace FollowMath
+{
+	FVector Slerp(const FVector& Vector1, const FVector& Vector2, const float Slerp)
+	{
+		FVector Vector1Dir, Vector2Dir;
+		float Vector1Size, Vector2Size;
+		Vector1.ToDirectionAndLength(Vector1Dir, Vector1Size);
+		Vector2.ToDirectionAndLength(Vector2Dir, Vector2Size);
+		float Dot = FVector::DotProduct(Vector1Dir, Vector2Dir);
+
+		float Scale1, Scale2;
+		if (Dot < 0.9999f)
+		{
+			const float Omega = FMath::Acos(Dot);
+			const float InvSin = 1.f / FMath::Sin(Omega);
+			Scale1 = FMath::Sin((1.f - Slerp) * Omega) * InvSin;
+			Scale2 = FMath::Sin(Slerp * Omega) * InvSin;
+		}
+		else
+		{
+			// Use linear interpolation.
+			Scale1 = 1.0f - Slerp;
+			Scale2 = Slerp;
+		}
+
+		FVector ResultDir = Vector1Dir * Scale1 + Vector2Dir * Scale2;
+		float ResultSize = FMath::Lerp(Vector1Size, Vector2Size, Slerp);
+
+		return ResultDir * ResultSize;
+	}
+
+	void UpdateLeashing(const FFollowSettings& Settings, const FTransform& InFollowTransform, FFollowState& State)
+	{
+		FTransform FollowTransform = InFollowTransform;
+
+		FVector FollowPosition = FollowTransform.GetLocation();
+
+		if (Settings.bIgnoreCameraPitchAndRoll && !Settings.bUseFixedVerticalOffset)
+		{
+			ApplyPitchOffset(Settings.PitchOffset, FollowTransform);
+		}
+
+		// Update starting goal leash values
+		State.ToTarget = State.WorkingTransform.GetLocation() - FollowTransform.GetLocation();
+		State.TargetRotation = State.WorkingTransform.GetRotation();
+
+		// Determine the current position of the element
+		bool bAngularClamped = false;
+		if (State.bRecenterNextUpdate)
+		{
+			State.ToTarget = FollowTransform.GetUnitAxis(EAxis::X) * Settings.DefaultDistance;
+			State.bRecenterNextUpdate = false;
+		}
+		// Angularly clamp to determine goal direction to place the element
+		else
+		{
+			if (Settings.bIgnoreAngleClamp)
+			{
+				float CurrentDistance = State.ToTarget.Size();
+				State.ToTarget = FollowTransform.GetUnitAxis(EAxis::X) * CurrentDistance;
+			}
+			else
+			{
+				bAngularClamped = AngularClamp(FollowTransform, Settings.bIgnoreCameraPitchAndRoll, Settings.MaxViewHorizontalDegrees,
+					Settings.MaxViewVerticalDegrees, State.ToTarget);
+			}
+		}
+
+		// Distance clamp to determine goal position to place the element
+		bool bDistanceClamped = false;
+		if (!Settings.bIgnoreDistanceClamp)
+		{
+			bDistanceClamped = DistanceClamp(bAngularClamped, Settings.bIgnoreCameraPitchAndRoll, Settings.MinimumDistance, Settings.DefaultDistance,
+				Settings.MaximumDistance, State.ToTarget);
+			ApplyVerticalClamp(Settings.VerticalMaxDistance, State.ToTarget);
+		}
+
+		if (Settings.bUseFixedVerticalOffset)
+		{
+			State.ToTarget.Z = (FollowPosition.Z + Settings.FixedVerticalOffset) - State.WorkingTransform.GetLocation().Z;
+		}
+
+		// Figure out goal rotation of the element based on orientation setting
+		if (bAngularClamped || bDistanceClamped || Settings.bFaceCamera ||
+			PassedOrientationDeadzone(State.ToTarget, State.TargetRotation, Settings.OrientToCameraDeadzoneDegrees))
+		{
+			State.TargetRotation = (-State.ToTarget).ToOrientationQuat();
+		}
+	}
+
+	void UpdateTransformToGoal(const FFollowSettings& Settings, const FVector& FollowPosition, const FTransform& OwnerTransform,
+		bool bSkipInterpolation, float DeltaTime, FFollowState& State)
+	{
+		if (bSkipInterpolation)
+		{
+			State.WorkingTransform.SetLocation(FollowPosition + State.ToTarget);
+			State.WorkingTransform.SetRotation(State.TargetRotation);
+		}
+		else
+		{
+			FVector CurrentPosition = OwnerTransform.GetLocation();
+			FVector CurrentDirection = CurrentPosition - FollowPosition;
+			FQuat CurrentRotation = OwnerTransform.GetRotation();
+			State.WorkingTransform.SetLocation(FollowPosition + SmoothTo(CurrentDirection, State.ToTarget, DeltaTime, Settings.LerpTime));
+			State.WorkingTransform.SetRotation(SmoothTo(CurrentRotation, State.TargetRotation, DeltaTime, Settings.LerpTime));
+		}
+	}
+
+	void UpdateFollowers(TConstArrayView<FFollowSettings> Settings, TConstArrayView<FTransform> FollowTransforms,
+		TConstArrayView<FTransform> OwnerTransforms, float DeltaTime, TArrayView<FFollowState> States)
+	{
+		check(Settings.Num() == States.Num() && FollowTransforms.Num() == States.Num() && OwnerTransforms.Num() == States.Num());
+
+		for (int32 Index = 0; Index < States.Num(); ++Index)
+		{
+			UpdateLeashing(Settings[Index], FollowTransforms[Index], States[Index]);
+			UpdateTransformToGoal(Settings[Index], FollowTransforms[Index].GetLocation(), OwnerTransforms[Index], !Settings[Index].bInterpolatePose,
+				DeltaTime, States[Index]);
+		}
+	}
+} // namespace FollowMath
@@ -0,0 +1,380 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FollowComponent/FollowMath.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The per-component leashing as it was before it moved into FollowMath. The batched path has to reproduce it exactly.
+namespace FollowMathReference
+{
+	float SimplifyAngle(float Angle)
+	{
+		while (Angle > PI)
+		{
+			Angle -= 2 * PI;
+		}
+
+		while (Angle < -PI)
+		{
+			Angle += 2 * PI;
+		}
+
+		return Angle;
+	}
+
+	float AngleBetweenOnPlane(FVector From, FVector To, FVector Normal)
+	{
+		From.Normalize();
+		To.Normalize();
+		Normal.Normalize();
+
+		FVector Right = FVector::CrossProduct(Normal, From);
+		FVector Forward = FVector::CrossProduct(Right, Normal);
+
+		float Angle = FMath::Atan2(FVector::DotProduct(To, Right), FVector::DotProduct(To, Forward));
+
+		return SimplifyAngle(Angle);
+	}
+
+	float AngleBetweenVectorAndPlane(FVector Vec, FVector Normal)
+	{
+		Vec.Normalize();
+		Normal.Normalize();
+		return (PI / 2) - FMath::Acos(FVector::DotProduct(Vec, Normal));
+	}
+
+	bool AngularClamp(
+		FTransform FollowTransform, bool bIgnoreVertical, float MaxHorizontalDegrees, float MaxVerticalDegrees, FVector& CurrentToTarget)
+	{
+		if (CurrentToTarget.Size() <= 0)
+		{
+			return false;
+		}
+
+		FVector FollowForward = FollowTransform.GetUnitAxis(EAxis::X);
+		FVector FollowRight = FollowTransform.GetUnitAxis(EAxis::Y);
+
+		bool bAngularClamped = false;
+
+		if (bIgnoreVertical)
+		{
+			float Angle = AngleBetweenOnPlane(CurrentToTarget, FollowForward, FollowRight);
+			CurrentToTarget = FQuat(FollowRight, Angle) * CurrentToTarget;
+		}
+		else
+		{
+			float Angle = -AngleBetweenOnPlane(CurrentToTarget, FollowForward, FollowRight);
+			float MinMaxAngle = FMath::DegreesToRadians(MaxVerticalDegrees) * 0.5f;
+
+			if (Angle < -MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FollowRight, -MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+			else if (Angle > MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FollowRight, MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+		}
+
+		{
+			float Angle = AngleBetweenVectorAndPlane(CurrentToTarget, FollowRight);
+			float MinMaxAngle = FMath::DegreesToRadians(MaxHorizontalDegrees) * 0.5f;
+
+			if (Angle < -MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FVector::UpVector, -MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+			else if (Angle > MinMaxAngle)
+			{
+				CurrentToTarget = FQuat(FVector::UpVector, MinMaxAngle - Angle) * CurrentToTarget;
+				bAngularClamped = true;
+			}
+		}
+
+		return bAngularClamped;
+	}
+
+	bool DistanceClamp(bool bMoveToDefault, bool bIgnorePitch, float MinDistance, float DefaultDistance, float MaxDistance, FVector& CurrentToTarget)
+	{
+		FVector GoalDirection = CurrentToTarget;
+		GoalDirection.Normalize();
+
+		float CurrentDistance = CurrentToTarget.Size();
+
+		if (bIgnorePitch)
+		{
+			MinDistance = GoalDirection.Size2D() * MinDistance;
+			MaxDistance = GoalDirection.Size2D() * MaxDistance;
+
+			float CurrentDistance2D = CurrentToTarget.Size2D();
+			GoalDirection *= (CurrentDistance / CurrentDistance2D);
+			CurrentDistance = CurrentDistance2D;
+		}
+
+		float ClampedDistance = CurrentDistance;
+
+		if (bMoveToDefault)
+		{
+			if (CurrentDistance < MinDistance || CurrentDistance > MaxDistance)
+			{
+				ClampedDistance = DefaultDistance;
+			}
+		}
+		else
+		{
+			ClampedDistance = FMath::Clamp(CurrentDistance, MinDistance, MaxDistance);
+		}
+
+		CurrentToTarget = GoalDirection * ClampedDistance;
+
+		return CurrentDistance != ClampedDistance;
+	}
+
+	bool PassedOrientationDeadzone(FVector CurrentToTarget, FQuat CurrentRotation, float DeadzoneDegrees)
+	{
+		FVector LeashForward = CurrentRotation * FVector::BackwardVector;
+
+		FVector LeashToFollow = CurrentToTarget;
+		LeashToFollow.Normalize();
+
+		float Angle = FMath::Abs(AngleBetweenOnPlane(LeashForward, LeashToFollow, FVector::UpVector));
+
+		return FMath::RadiansToDegrees(Angle) > DeadzoneDegrees;
+	}
+
+	void UpdateLeashing(const FollowMath::FFollowSettings& Settings, FTransform FollowTransform, FollowMath::FFollowState& State)
+	{
+		FVector FollowPosition = FollowTransform.GetLocation();
+
+		if (Settings.bIgnoreCameraPitchAndRoll && !Settings.bUseFixedVerticalOffset)
+		{
+			FVector Forward = FollowTransform.GetUnitAxis(EAxis::X);
+			Forward.Z = 0;
+			FVector Left = FollowTransform.GetUnitAxis(EAxis::Y);
+			Forward = FQuat(Left, FMath::DegreesToRadians(Settings.PitchOffset)) * Forward;
+			FollowTransform.SetRotation(Forward.ToOrientationQuat());
+		}
+
+		State.ToTarget = State.WorkingTransform.GetLocation() - FollowTransform.GetLocation();
+		State.TargetRotation = State.WorkingTransform.GetRotation();
+
+		bool bAngularClamped = false;
+		if (State.bRecenterNextUpdate)
+		{
+			State.ToTarget = FollowTransform.GetUnitAxis(EAxis::X) * Settings.DefaultDistance;
+			State.bRecenterNextUpdate = false;
+		}
+		else if (Settings.bIgnoreAngleClamp)
+		{
+			float CurrentDistance = State.ToTarget.Size();
+			State.ToTarget = FollowTransform.GetUnitAxis(EAxis::X) * CurrentDistance;
+		}
+		else
+		{
+			bAngularClamped = AngularClamp(FollowTransform, Settings.bIgnoreCameraPitchAndRoll, Settings.MaxViewHorizontalDegrees,
+				Settings.MaxViewVerticalDegrees, State.ToTarget);
+		}
+
+		bool bDistanceClamped = false;
+		if (!Settings.bIgnoreDistanceClamp)
+		{
+			bDistanceClamped = DistanceClamp(bAngularClamped, Settings.bIgnoreCameraPitchAndRoll, Settings.MinimumDistance, Settings.DefaultDistance,
+				Settings.MaximumDistance, State.ToTarget);
+			if (Settings.VerticalMaxDistance != 0)
+			{
+				State.ToTarget.Z = FMath::Clamp(State.ToTarget.Z, -Settings.VerticalMaxDistance, Settings.VerticalMaxDistance);
+			}
+		}
+
+		if (Settings.bUseFixedVerticalOffset)
+		{
+			State.ToTarget.Z = (FollowPosition.Z + Settings.FixedVerticalOffset) - State.WorkingTransform.GetLocation().Z;
+		}
+
+		if (bAngularClamped || bDistanceClamped || Settings.bFaceCamera ||
+			PassedOrientationDeadzone(State.ToTarget, State.TargetRotation, Settings.OrientToCameraDeadzoneDegrees))
+		{
+			State.TargetRotation = (-State.ToTarget).ToOrientationQuat();
+		}
+	}
+
+	void UpdateTransformToGoal(const FollowMath::FFollowSettings& Settings, const FVector& FollowPosition, const FTransform& OwnerTransform,
+		bool bSkipInterpolation, float DeltaTime, FollowMath::FFollowState& State)
+	{
+		if (bSkipInterpolation)
+		{
+			State.WorkingTransform.SetLocation(FollowPosition + State.ToTarget);
+			State.WorkingTransform.SetRotation(State.TargetRotation);
+		}
+		else
+		{
+			const float Alpha = Settings.LerpTime == 0.0f ? 1.0f : DeltaTime / Settings.LerpTime;
+			FVector CurrentDirection = OwnerTransform.GetLocation() - FollowPosition;
+			State.WorkingTransform.SetLocation(FollowPosition + FollowMath::Slerp(CurrentDirection, State.ToTarget, Alpha));
+			State.WorkingTransform.SetRotation(FQuat::Slerp(OwnerTransform.GetRotation(), State.TargetRotation, Alpha));
+		}
+	}
+} // namespace FollowMathReference
+
+BEGIN_DEFINE_SPEC(FFollowMathSpec, TEXT("VRMuseum.FollowMath"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+TArray<FollowMath::FFollowSettings> MakeSettingsVariants() const;
+FTransform HeadPoseAt(int32 Frame) const;
+END_DEFINE_SPEC(FFollowMathSpec)
+
+TArray<FollowMath::FFollowSettings> FFollowMathSpec::MakeSettingsVariants() const
+{
+	TArray<FollowMath::FFollowSettings> Variants;
+
+	FollowMath::FFollowSettings Default;
+	Variants.Add(Default);
+
+	FollowMath::FFollowSettings FaceCamera;
+	FaceCamera.bFaceCamera = true;
+	FaceCamera.VerticalMaxDistance = 20.0f;
+	Variants.Add(FaceCamera);
+
+	FollowMath::FFollowSettings IgnorePitch;
+	IgnorePitch.bIgnoreCameraPitchAndRoll = true;
+	IgnorePitch.PitchOffset = -15.0f;
+	Variants.Add(IgnorePitch);
+
+	FollowMath::FFollowSettings FixedVertical;
+	FixedVertical.bUseFixedVerticalOffset = true;
+	FixedVertical.FixedVerticalOffset = -30.0f;
+	FixedVertical.bIgnoreAngleClamp = true;
+	Variants.Add(FixedVertical);
+
+	FollowMath::FFollowSettings NoClamps;
+	NoClamps.bIgnoreDistanceClamp = true;
+	NoClamps.bIgnoreAngleClamp = true;
+	NoClamps.LerpTime = 0.0f;
+	Variants.Add(NoClamps);
+
+	FollowMath::FFollowSettings NoInterpolation;
+	NoInterpolation.bInterpolatePose = false;
+	NoInterpolation.MaxViewHorizontalDegrees = 10.0f;
+	NoInterpolation.MaxViewVerticalDegrees = 5.0f;
+	Variants.Add(NoInterpolation);
+
+	return Variants;
+}
+
+FTransform FFollowMathSpec::HeadPoseAt(int32 Frame) const
+{
+	// A head that looks around, nods and walks back and forth, with sudden turns every few seconds
+	const float Time = Frame / 72.0f;
+	const float Yaw = 70.0f * FMath::Sin(Time * 0.9f) + ((Frame / 216) % 2 == 0 ? 0.0f : 120.0f);
+	const float Pitch = 25.0f * FMath::Sin(Time * 1.7f);
+	const float Roll = 10.0f * FMath::Sin(Time * 0.5f);
+	const FVector Location(40.0f * FMath::Sin(Time * 0.3f), 25.0f * FMath::Cos(Time * 0.4f), 160.0f + 10.0f * FMath::Sin(Time * 1.1f));
+	return FTransform(FRotator(Pitch, Yaw, Roll), Location);
+}
+
+void FFollowMathSpec::Define()
+{
+	Describe(TEXT("Batched update"), [this] {
+		It(TEXT("Matches the per-component trajectory frame by frame"), [this] {
+			const TArray<FollowMath::FFollowSettings> Variants = MakeSettingsVariants();
+			const int32 NumFollowers = Variants.Num() * 50;
+			const int32 NumFrames = 1000;
+			const float DeltaTime = 1.0f / 72.0f;
+
+			TArray<FollowMath::FFollowSettings> Settings;
+			TArray<FollowMath::FFollowState> States;
+			TArray<FollowMath::FFollowState> ReferenceStates;
+			TArray<FTransform> FollowTransforms;
+			TArray<FTransform> OwnerTransforms;
+			TArray<FTransform> ReferenceOwnerTransforms;
+			FRandomStream RandomStream(5);
+			for (int32 Index = 0; Index < NumFollowers; ++Index)
+			{
+				FollowMath::FFollowSettings FollowerSettings = Variants[Index % Variants.Num()];
+				FollowerSettings.DefaultDistance += RandomStream.FRandRange(-20.0f, 20.0f);
+				Settings.Add(FollowerSettings);
+
+				const FTransform Start(FRotator(0.0f, RandomStream.FRandRange(-180.0f, 180.0f), 0.0f), RandomStream.GetUnitVector() * 200.0f);
+				FollowMath::FFollowState State;
+				State.WorkingTransform = Start;
+				States.Add(State);
+				ReferenceStates.Add(State);
+				OwnerTransforms.Add(Start);
+				ReferenceOwnerTransforms.Add(Start);
+			}
+			FollowTransforms.Init(FTransform::Identity, NumFollowers);
+
+			double BatchedSeconds = 0.0;
+			double ReferenceSeconds = 0.0;
+			for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+			{
+				const FTransform HeadPose = HeadPoseAt(Frame);
+				if (Frame % 300 == 0)
+				{
+					for (int32 Index = 0; Index < NumFollowers; Index += 7)
+					{
+						States[Index].bRecenterNextUpdate = true;
+						ReferenceStates[Index].bRecenterNextUpdate = true;
+					}
+				}
+
+				double StartTime = FPlatformTime::Seconds();
+				for (FTransform& FollowTransform : FollowTransforms)
+				{
+					FollowTransform = HeadPose;
+				}
+				FollowMath::UpdateFollowers(Settings, FollowTransforms, OwnerTransforms, DeltaTime, States);
+				for (int32 Index = 0; Index < NumFollowers; ++Index)
+				{
+					OwnerTransforms[Index] = States[Index].WorkingTransform;
+				}
+				BatchedSeconds += FPlatformTime::Seconds() - StartTime;
+
+				StartTime = FPlatformTime::Seconds();
+				for (int32 Index = 0; Index < NumFollowers; ++Index)
+				{
+					FollowMathReference::UpdateLeashing(Settings[Index], HeadPose, ReferenceStates[Index]);
+					FollowMathReference::UpdateTransformToGoal(Settings[Index], HeadPose.GetLocation(), ReferenceOwnerTransforms[Index],
+						!Settings[Index].bInterpolatePose, DeltaTime, ReferenceStates[Index]);
+					ReferenceOwnerTransforms[Index] = ReferenceStates[Index].WorkingTransform;
+				}
+				ReferenceSeconds += FPlatformTime::Seconds() - StartTime;
+
+				for (int32 Index = 0; Index < NumFollowers; ++Index)
+				{
+					if (!OwnerTransforms[Index].Equals(ReferenceOwnerTransforms[Index], 0.0))
+					{
+						TestTrue(FString::Printf(TEXT("Follower %d matches the per-component path in frame %d"), Index, Frame), false);
+						return;
+					}
+				}
+			}
+
+			AddInfo(FString::Printf(TEXT("%d followers over %d frames: batched %.4f ms per frame, per-component %.4f ms per frame"), NumFollowers,
+				NumFrames, BatchedSeconds * 1000.0 / NumFrames, ReferenceSeconds * 1000.0 / NumFrames));
+		});
+
+		It(TEXT("Recenters in front of the followed transform"), [this] {
+			FollowMath::FFollowSettings Settings;
+			Settings.bInterpolatePose = false;
+			FollowMath::FFollowState State;
+			State.WorkingTransform = FTransform(FVector(-500.0, 0.0, 0.0));
+
+			const FTransform FollowTransform(FRotator(0.0, 90.0, 0.0), FVector(10.0, 20.0, 150.0));
+			FollowMath::UpdateLeashing(Settings, FollowTransform, State);
+			FollowMath::UpdateTransformToGoal(Settings, FollowTransform.GetLocation(), State.WorkingTransform, true, 0.0f, State);
+
+			TestFalse(TEXT("Recentering is only done once"), State.bRecenterNextUpdate);
+			TestTrue(TEXT("Owner is placed at the default distance in front"),
+				State.WorkingTransform.GetLocation().Equals(FVector(10.0, 20.0 + Settings.DefaultDistance, 150.0), 1e-3));
+			TestTrue(TEXT("Owner faces back at the followed transform"),
+				(State.WorkingTransform.GetRotation() * FVector::BackwardVector).Equals(FVector(0.0, 1.0, 0.0), 1e-3));
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
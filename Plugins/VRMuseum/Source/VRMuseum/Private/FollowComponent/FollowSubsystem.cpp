@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "FollowComponent/FollowSubsystem.h"
+
+#include "FollowComponent/FollowComponent.h"
+#include "Utils/VRMuseumFunctionLibrary.h"
+
+DECLARE_CYCLE_STAT(TEXT("VRMuseum Update Followers"), STAT_VRMuseumUpdateFollowers, STATGROUP_Game);
+
+void UFollowSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (Followers.IsEmpty())
+	{
+		return;
+	}
+
+	// The head pose is only needed by components that don't follow an actor
+	bool bNeedsHeadPose = false;
+	for (const UFollowComponent* Component : Followers)
+	{
+		if (Component && !Component->ActorToFollow)
+		{
+			bNeedsHeadPose = true;
+			break;
+		}
+	}
+
+	UpdateFollowers(bNeedsHeadPose ? UVRMuseumFunctionLibrary::GetHeadPose(GetWorld()) : FTransform::Identity, DeltaTime);
+}
+
+TStatId UFollowSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFollowSubsystem, STATGROUP_Tickables);
+}
+
+void UFollowSubsystem::Register(UFollowComponent* Component)
+{
+	if (Component)
+	{
+		Followers.AddUnique(Component);
+	}
+}
+
+void UFollowSubsystem::Unregister(UFollowComponent* Component)
+{
+	Followers.Remove(Component);
+}
+
+void UFollowSubsystem::UpdateFollowers(const FTransform& HeadPose, float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_VRMuseumUpdateFollowers);
+
+	BatchComponents.Reset();
+	BatchSettings.Reset();
+	BatchFollowTransforms.Reset();
+	BatchOwnerTransforms.Reset();
+	BatchStates.Reset();
+
+	// Gather everything the math needs into contiguous arrays
+	for (UFollowComponent* Component : Followers)
+	{
+		if (!Component || !Component->IsActive() || !Component->GetOwner())
+		{
+			continue;
+		}
+
+		BatchComponents.Add(Component);
+		BatchSettings.Add(Component->MakeFollowSettings());
+		BatchFollowTransforms.Add(Component->ActorToFollow ? Component->ActorToFollow->GetTransform() : HeadPose);
+		BatchOwnerTransforms.Add(Component->GetOwner()->GetTransform());
+		BatchStates.Add(Component->FollowState);
+	}
+
+	FollowMath::UpdateFollowers(BatchSettings, BatchFollowTransforms, BatchOwnerTransforms, DeltaTime, BatchStates);
+
+	// Moving the owners can trigger overlap events that register or unregister components, which is why this
+	// happens on the gathered arrays only
+	for (int32 Index = 0; Index < BatchComponents.Num(); ++Index)
+	{
+		UFollowComponent* Component = BatchComponents[Index];
+		Component->FollowState = BatchStates[Index];
+		if (AActor* Owner = Component->GetOwner())
+		{
+			Owner->SetActorTransform(Component->FollowState.WorkingTransform, false);
+		}
+	}
+}
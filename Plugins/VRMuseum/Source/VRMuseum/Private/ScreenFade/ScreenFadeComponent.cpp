@@ -11,12 +11,20 @@
 
 #include "Kismet/KismetMathLibrary.h"
 
+#include "Curves/CurveFloat.h"
+
 #include "Engine/World.h"
 
+namespace
+{
+	const FName ScreenFadeOpacityParameterName(TEXT("Opacity"));
+} // namespace
+
 UScreenFadeComponent::UScreenFadeComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	// Only the timeline driven fade ticks all the time, BeginPlay enables it for that
+	PrimaryComponentTick.bStartWithTickEnabled = false;
 
 	FadeTimeline = CreateDefaultSubobject<UTimelineComponent>(TEXT("FadeTimeline"));
 
@@ -39,6 +47,20 @@ void UScreenFadeComponent::BeginPlay()
 		ScreenFadeSphere->SetOnlyOwnerSee(true);
 	}
 
+	if (bEventDrivenFade)
+	{
+		// Start out with whatever the material has, which also hides the sphere in case it is transparent
+		float Opacity = 1.f;
+		if (DynamicScreenFadeMaterial)
+		{
+			DynamicScreenFadeMaterial->GetScalarParameterValue(FHashedMaterialParameterInfo(ScreenFadeOpacityParameterName), Opacity);
+		}
+		SetOpacity(Opacity);
+		return;
+	}
+
+	SetComponentTickEnabled(true);
+
 	if (FadeTimeline)
 	{
 		FadeTimeline->PrimaryComponentTick.TickInterval = FADE_TIMELINE_TICK;
@@ -47,7 +69,11 @@ void UScreenFadeComponent::BeginPlay()
 		FOnTimelineFloat FadeTimelineProgress;
 		FadeTimelineProgress.BindUFunction(this, FName("HandleFadeTimelineProgress"));
 
+		FOnTimelineEvent FadeTimelineFinished;
+		FadeTimelineFinished.BindUFunction(this, FName("HandleFadeTimelineFinished"));
+
 		FadeTimeline->AddInterpFloat(TimelineFloatCurve, FadeTimelineProgress);
+		FadeTimeline->SetTimelineFinishedFunc(FadeTimelineFinished);
 		FadeTimeline->SetLooping(false);
 
 		FadeTimeline->RegisterComponent();
@@ -69,15 +95,49 @@ void UScreenFadeComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	if (FadeTimeline)
-		FadeTimeline->TickComponent(DeltaTime, LEVELTICK_TimeOnly, nullptr);
+	if (!bEventDrivenFade)
+	{
+		if (FadeTimeline)
+			FadeTimeline->TickComponent(DeltaTime, LEVELTICK_TimeOnly, nullptr);
+		return;
+	}
+
+	if (!bFading)
+	{
+		SetComponentTickEnabled(false);
+		return;
+	}
+
+	FadeProgress = FadeDuration > 0.f ? FMath::Min(FadeProgress + DeltaTime / FadeDuration, 1.f) : 1.f;
+	SetOpacity(EvaluateFadeCurve(bFadingIn ? FadeProgress : 1.f - FadeProgress));
+
+	if (FadeProgress >= 1.f)
+	{
+		bFading = false;
+		SetComponentTickEnabled(false);
+		OnFadeFinished.Broadcast(bFadingIn);
+	}
 }
 
 void UScreenFadeComponent::FadeScreen(bool bFadeIn)
 {
+	if (bEventDrivenFade)
+	{
+		bFadingIn = bFadeIn;
+		FadeDuration = bFadeIn ? FadeInDuration : FadeOutDuration;
+		FadeProgress = 0.f;
+		bFading = true;
+
+		SetOpacity(EvaluateFadeCurve(bFadeIn ? 0.f : 1.f));
+		SetComponentTickEnabled(true);
+		return;
+	}
+
 	if (FadeTimeline == nullptr)
 		return;
 
+	bFadingIn = bFadeIn;
+
 	if (bFadeIn)
 	{
 		SetFadeTimelineDuration(FadeInDuration);
@@ -98,10 +158,61 @@ void UScreenFadeComponent::SetFadeDurations(float NewFadeInDuration, float NewFa
 	FadeOutDuration = NewFadeOutDuration;
 }
 
+bool UScreenFadeComponent::IsFading() const
+{
+	if (bEventDrivenFade)
+		return bFading;
+
+	return FadeTimeline && FadeTimeline->IsPlaying();
+}
+
 void UScreenFadeComponent::HandleFadeTimelineProgress(float Value)
 {
-	if (ScreenFadeSphere)
-		ScreenFadeSphere->SetScalarParameterValueOnMaterials(FName("Opacity"), Value);
+	SetOpacity(Value);
+}
+
+void UScreenFadeComponent::HandleFadeTimelineFinished()
+{
+	OnFadeFinished.Broadcast(bFadingIn);
+}
+
+void UScreenFadeComponent::SetOpacity(float Opacity)
+{
+	CurrentOpacity = Opacity;
+
+	if (DynamicScreenFadeMaterial)
+	{
+		// Looking the parameter up by name on every change is what makes setting it expensive, so remember its index
+		if (OpacityParameterIndex == INDEX_NONE)
+			DynamicScreenFadeMaterial->InitializeScalarParameterAndGetIndex(ScreenFadeOpacityParameterName, Opacity, OpacityParameterIndex);
+		else
+			DynamicScreenFadeMaterial->SetScalarParameterByIndex(OpacityParameterIndex, Opacity);
+	}
+	else if (ScreenFadeSphere)
+	{
+		ScreenFadeSphere->SetScalarParameterValueOnMaterials(ScreenFadeOpacityParameterName, Opacity);
+	}
+
+	// A transparent sphere doesn't need to be rendered, and must not hide anything behind it
+	const bool bVisible = Opacity > 0.f;
+	if (bEventDrivenFade && ScreenFadeSphere && ScreenFadeSphere->GetVisibleFlag() != bVisible)
+	{
+		ScreenFadeSphere->bUseAsOccluder = bVisible;
+		ScreenFadeSphere->SetVisibility(bVisible);
+	}
+}
+
+float UScreenFadeComponent::EvaluateFadeCurve(float Progress) const
+{
+	if (TimelineFloatCurve == nullptr)
+		return Progress;
+
+	// Sample the curve over the same range the timeline plays it in
+	float MinTime = 0.f;
+	float MaxTime = 0.f;
+	TimelineFloatCurve->GetTimeRange(MinTime, MaxTime);
+	const float Length = FadeTimeline ? FadeTimeline->GetTimelineLength() : MaxTime;
+	return TimelineFloatCurve->GetFloatValue(Progress * Length);
 }
 
 void UScreenFadeComponent::SetFadeTimelineDuration(float NewDuration)
@@ -113,4 +224,3 @@ void UScreenFadeComponent::SetFadeTimelineDuration(float NewDuration)
 
 	FadeTimeline->SetPlayRate(NewPlayRate);
 }
-
@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ScreenFade/ScreenFadeComponent.h"
+
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/Material.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FScreenFadeComponentSpec, TEXT("VRMuseum.ScreenFade"), EAutomationTestFlags::ProductFilter | EAutomationTestFlags::ApplicationContextMask)
+UWorld* World;
+UScreenFadeComponent* ScreenFade;
+
+void TickWorld(int32 NumFrames, float DeltaTime);
+END_DEFINE_SPEC(FScreenFadeComponentSpec)
+
+void FScreenFadeComponentSpec::TickWorld(int32 NumFrames, float DeltaTime)
+{
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		World->Tick(LEVELTICK_All, DeltaTime);
+	}
+}
+
+void FScreenFadeComponentSpec::Define()
+{
+	Describe(TEXT("Event driven fade"), [this] {
+		BeforeEach([this]() {
+			// A bare game world is enough, the fade doesn't need a map or a play session
+			World = UWorld::CreateWorld(EWorldType::Game, false);
+			FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+			WorldContext.SetCurrentWorld(World);
+			World->InitializeActorsForPlay(FURL());
+			World->BeginPlay();
+
+			AActor* Owner = World->SpawnActor<AActor>();
+			ScreenFade = NewObject<UScreenFadeComponent>(Owner);
+			ScreenFade->OriginalScreenFadeMaterial = UMaterial::GetDefaultMaterial(MD_Surface);
+			ScreenFade->SetFadeDurations(0.5f, 0.25f);
+			ScreenFade->RegisterComponent();
+		});
+
+		It(TEXT("Does not tick while idle"), [this] {
+			TestTrue(TEXT("Component has begun play"), ScreenFade->HasBegunPlay());
+			TestFalse(TEXT("Tick is disabled after begin play"), ScreenFade->IsComponentTickEnabled());
+
+			const double StartTime = FPlatformTime::Seconds();
+			TickWorld(1000, 1.f / 72.f);
+			const double IdleSeconds = FPlatformTime::Seconds() - StartTime;
+
+			TestFalse(TEXT("Tick stays disabled while idle"), ScreenFade->IsComponentTickEnabled());
+			TestFalse(TEXT("Not fading"), ScreenFade->IsFading());
+			AddInfo(FString::Printf(TEXT("1000 idle frames with a screen fade component took %.3f ms in total"), IdleSeconds * 1000.0));
+		});
+
+		It(TEXT("Ticks only while fading and hides the sphere when transparent"), [this] {
+			ScreenFade->FadeScreen(false);
+			TestTrue(TEXT("Fading out"), ScreenFade->IsFading());
+			TestTrue(TEXT("Tick is enabled while fading"), ScreenFade->IsComponentTickEnabled());
+
+			TickWorld(30, 1.f / 60.f);
+			TestFalse(TEXT("Fade out has finished"), ScreenFade->IsFading());
+			TestFalse(TEXT("Tick is disabled after the fade"), ScreenFade->IsComponentTickEnabled());
+			TestEqual(TEXT("Fully transparent"), ScreenFade->CurrentOpacity, 0.f);
+			TestFalse(TEXT("Sphere is hidden"), ScreenFade->ScreenFadeSphere->GetVisibleFlag());
+			TestFalse(TEXT("Sphere doesn't occlude"), ScreenFade->ScreenFadeSphere->bUseAsOccluder);
+
+			ScreenFade->FadeScreen(true);
+			TickWorld(15, 1.f / 60.f);
+			TestTrue(TEXT("Fade in is still in progress halfway"), ScreenFade->IsFading());
+			TestTrue(TEXT("Sphere is visible while fading in"), ScreenFade->ScreenFadeSphere->GetVisibleFlag());
+
+			TickWorld(30, 1.f / 60.f);
+			TestFalse(TEXT("Fade in has finished"), ScreenFade->IsFading());
+			TestFalse(TEXT("Tick is disabled after the fade"), ScreenFade->IsComponentTickEnabled());
+			TestEqual(TEXT("Fully opaque"), ScreenFade->CurrentOpacity, 1.f);
+			TestTrue(TEXT("Sphere occludes again"), ScreenFade->ScreenFadeSphere->bUseAsOccluder);
+		});
+
+		AfterEach([this]() {
+			GEngine->DestroyWorldContext(World);
+			World->DestroyWorld(false);
+			World = nullptr;
+			ScreenFade = nullptr;
+		});
+	});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
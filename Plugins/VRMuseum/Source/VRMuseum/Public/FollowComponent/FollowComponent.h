@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 
+#include "FollowComponent/FollowMath.h"
+
 #include "FollowComponent.generated.h"
 
 UENUM(BlueprintType)
@@ -52,6 +54,7 @@ public:
 	UFollowComponent();
 
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void Activate(bool bReset = false) override;
 
 	/** Force the owner to recenter in the camera's field of view. */
 	UFUNCTION(BlueprintCallable, Category = "FollowComponent")
@@ -128,18 +131,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FollowComponent")
 	float LerpTime = 0.1f;
 
+	/** Let the follow subsystem update this component together with all other follow components instead of ticking it on its own */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "FollowComponent")
+	bool bBatchedUpdate = true;
+
+	/** Settings of the follow math, taken from the properties of this component */
+	FollowMath::FFollowSettings MakeFollowSettings() const;
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+	friend class UFollowSubsystem;
+
 	FTransform GetFollowTransform();
 	void UpdateLeashing();
 	void UpdateTransformToGoal(bool bSkipInterpolation, float DeltaTime = 0);
 
-	FVector ToTarget;
-	FQuat TargetRotation;
-	FTransform WorkingTransform;
-
-	bool bRecenterNextUpdate = true;
+	FollowMath::FFollowState FollowState;
 
 };
@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Leashing math of the follow component. It only works on plain math types, so it can be run for many followers in
+ * one pass and tested without a world.
+ */
+namespace FollowMath
+{
+	/** Settings of a follower, see UFollowComponent for a description of each of them */
+	struct FFollowSettings
+	{
+		bool bFaceCamera = false;
+		float OrientToCameraDeadzoneDegrees = 60.0f;
+		bool bIgnoreDistanceClamp = false;
+		float MinimumDistance = 50.0f;
+		float MaximumDistance = 100.0f;
+		float DefaultDistance = 75.0f;
+		float VerticalMaxDistance = 0.0f;
+		bool bUseFixedVerticalOffset = false;
+		float FixedVerticalOffset = 0.0f;
+		bool bIgnoreAngleClamp = false;
+		float MaxViewHorizontalDegrees = 30.0f;
+		float MaxViewVerticalDegrees = 30.0f;
+		bool bIgnoreCameraPitchAndRoll = false;
+		float PitchOffset = 0.0f;
+		bool bInterpolatePose = true;
+		float LerpTime = 0.1f;
+	};
+
+	/** State of a follower that is carried over from one update to the next */
+	struct FFollowState
+	{
+		FTransform WorkingTransform;
+		FVector ToTarget = FVector::ZeroVector;
+		FQuat TargetRotation = FQuat::Identity;
+		bool bRecenterNextUpdate = true;
+	};
+
+	/** Spherical linear interpolation between two vectors, interpolating their length linearly */
+	VRMUSEUM_API FVector Slerp(const FVector& Vector1, const FVector& Vector2, const float Slerp);
+
+	/** Compute the goal position relative to the followed transform and the goal rotation */
+	VRMUSEUM_API void UpdateLeashing(const FFollowSettings& Settings, const FTransform& FollowTransform, FFollowState& State);
+
+	/** Move the working transform toward the goal. OwnerTransform is the current transform of the follower. */
+	VRMUSEUM_API void UpdateTransformToGoal(const FFollowSettings& Settings, const FVector& FollowPosition, const FTransform& OwnerTransform,
+		bool bSkipInterpolation, float DeltaTime, FFollowState& State);
+
+	/**
+	 * Update many followers at once. All views need to have the same size. The new transforms of the followers are
+	 * the working transforms of the states afterwards.
+	 */
+	VRMUSEUM_API void UpdateFollowers(TConstArrayView<FFollowSettings> Settings, TConstArrayView<FTransform> FollowTransforms,
+		TConstArrayView<FTransform> OwnerTransforms, float DeltaTime, TArrayView<FFollowState> States);
+} // namespace FollowMath
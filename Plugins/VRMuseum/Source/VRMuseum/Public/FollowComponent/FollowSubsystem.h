@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "FollowComponent/FollowMath.h"
+
+#include "FollowSubsystem.generated.h"
+
+class UFollowComponent;
+
+/**
+ * Updates all follow components of a world that use batched updates. The head pose is only read once per frame and
+ * the leashing of all followers is computed in one pass over contiguous arrays before the owners are moved.
+ */
+UCLASS(ClassGroup = VRMuseum)
+class VRMUSEUM_API UFollowSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Start updating the given component every frame */
+	void Register(UFollowComponent* Component);
+
+	/** Stop updating the given component */
+	void Unregister(UFollowComponent* Component);
+
+	/** Update all registered components that are active. HeadPose is used for components that don't follow an actor. */
+	void UpdateFollowers(const FTransform& HeadPose, float DeltaTime);
+
+	/** Number of registered components */
+	int32 GetNumFollowers() const { return Followers.Num(); }
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UFollowComponent>> Followers;
+
+	// Scratch arrays for the batched update, kept around to avoid allocations every frame
+	TArray<UFollowComponent*> BatchComponents;
+	TArray<FollowMath::FFollowSettings> BatchSettings;
+	TArray<FTransform> BatchFollowTransforms;
+	TArray<FTransform> BatchOwnerTransforms;
+	TArray<FollowMath::FFollowState> BatchStates;
+};
@@ -16,6 +16,8 @@ class UTimelineComponent;
 
 #define FADE_TIMELINE_TICK 0.1f;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FScreenFadeFinishedEvent, bool, bFadeIn);
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class VRMUSEUM_API UScreenFadeComponent : public UActorComponent
 {
@@ -35,14 +37,29 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetFadeDurations(float NewFadeInDuration, float NewFadeOutDuration);
 
+	/** Whether a fade is currently in progress */
+	UFUNCTION(BlueprintPure)
+	bool IsFading() const;
+
+	/** Broadcast once a fade has reached its end */
+	UPROPERTY(BlueprintAssignable)
+	FScreenFadeFinishedEvent OnFadeFinished;
+
 protected:
 	virtual void BeginPlay() override;
 
 private:
+	friend class FScreenFadeComponentSpec;
 
 	UFUNCTION()
 	void HandleFadeTimelineProgress(float Value);
 
+	UFUNCTION()
+	void HandleFadeTimelineFinished();
+
+	void SetOpacity(float Opacity);
+	float EvaluateFadeCurve(float Progress) const;
+
 	void SetFadeTimelineDuration(float NewDuration);
 
 	UPROPERTY(EditDefaultsOnly, meta = (AllowPrivateAccess = "true"), Category = "Screen Fade")
@@ -63,7 +80,25 @@ private:
 	UPROPERTY(EditDefaultsOnly, meta = (AllowPrivateAccess = "true"), Category = "Screen Fade")
 	UCurveFloat* TimelineFloatCurve = nullptr;
 
+	/**
+	 * Advance fades in this component and only tick while a fade is in progress instead of ticking the timeline every
+	 * frame. The fade sphere is hidden and doesn't occlude anything while it is fully transparent.
+	 */
+	UPROPERTY(EditDefaultsOnly, meta = (AllowPrivateAccess = "true"), Category = "Screen Fade")
+	bool bEventDrivenFade = true;
+
 	UPROPERTY(VisibleAnywhere)
 	UTimelineComponent* FadeTimeline;
+
+	/** Index of the opacity parameter in the dynamic material, INDEX_NONE until it has been initialized */
+	int32 OpacityParameterIndex = INDEX_NONE;
+
+	float CurrentOpacity = 0.f;
+
+	/** Progress of the event driven fade from 0 to 1 */
+	float FadeProgress = 0.f;
+	float FadeDuration = 0.f;
+	bool bFadingIn = false;
+	bool bFading = false;
 		
 };